@@ -57,6 +57,26 @@ static int create_ui_buffers(Engine2D* ui2d) {
     return 1;
 }
 
+// Internal helper function to intern an SDF style as a material
+static MaterialId intern_sdf_material(Engine2D* ui2d, vec4_t fillColor, vec4_t outlineColor,
+                                      float edgeDistance, float outlineDistance, float smoothing, int hasOutline) {
+    UISDFParams params;
+    memset(&params, 0, sizeof(params));
+    params.fillColor[0] = fillColor.x;
+    params.fillColor[1] = fillColor.y;
+    params.fillColor[2] = fillColor.z;
+    params.fillColor[3] = fillColor.w;
+    params.outlineColor[0] = outlineColor.x;
+    params.outlineColor[1] = outlineColor.y;
+    params.outlineColor[2] = outlineColor.z;
+    params.outlineColor[3] = outlineColor.w;
+    params.edgeDistance = edgeDistance;
+    params.outlineDistance = outlineDistance;
+    params.smoothing = smoothing;
+    params.hasOutline = hasOutline;
+    return material_intern(ui2d->materials, MATERIAL_PIPELINE_UI_SDF, &params, sizeof(params));
+}
+
 // Internal helper function to generate quad vertices
 static void generate_quad_vertices(UI2DVertex* vertices, float x, float y, float width, float height) {
     // Top-left
@@ -136,6 +156,18 @@ Engine2D *engine_2d_init(MetalEngineHandle metalEngine) {
         return NULL;
     }
     
+    // Create material library. Styles past the budget (e.g. colours animated
+    // every frame) fall back to per-draw parameters instead of growing it.
+    MaterialLibraryDesc materialDesc = material_library_desc_default();
+    materialDesc.max_params_bytes = UI_MATERIAL_PARAMS_BUDGET;
+    ui2d->materials = material_library_create(&materialDesc);
+    if (!ui2d->materials) {
+        UI_ERROR("Failed to create UI material library");
+        free(ui2d->elements);
+        free(ui2d);
+        return NULL;
+    }
+    
     UI_INFO("UI 2D system initialized successfully");
     return ui2d;
 }
@@ -151,6 +183,9 @@ void engine_2d_shutdown(Engine2D* ui2d) {
         ui2d->elements = NULL;
     }
     
+    material_library_destroy(ui2d->materials);
+    ui2d->materials = NULL;
+    
     // Note: Metal objects will be released by the Metal engine
     ui2d->vertexBuffer = NULL;
     ui2d->indexBuffer = NULL;
@@ -216,6 +251,7 @@ int engine_2d_draw_image(Engine2D* ui2d, float x, float y, MetalTextureHandle te
     
     // Set as regular texture element
     element->type = UI_ELEMENT_TYPE_TEXTURE;
+    element->material = material_intern(ui2d->materials, MATERIAL_PIPELINE_UI_TEXTURE, NULL, 0);
     element->isAtlas = 0; // Not using atlas coordinates
     
     // Update counts
@@ -273,6 +309,8 @@ int engine_2d_draw_sdf(Engine2D* ui2d, float x, float y, MetalTextureHandle sdfT
     element->outlineDistance = outlineDistance;
     element->smoothing = smoothing;
     element->hasOutline = hasOutline;
+    element->material = intern_sdf_material(ui2d, fillColor, outlineColor, edgeDistance, outlineDistance,
+                                            smoothing, hasOutline);
     element->isAtlas = 0; // Not using atlas coordinates
     
     // Update counts
@@ -337,6 +375,8 @@ int engine_2d_draw_sdf_atlas(Engine2D* ui2d, float x, float y, float width, floa
     element->outlineDistance = outlineDistance;
     element->smoothing = smoothing;
     element->hasOutline = hasOutline;
+    element->material = intern_sdf_material(ui2d, fillColor, outlineColor, edgeDistance, outlineDistance,
+                                            smoothing, hasOutline);
     
     // Store atlas texture coordinates
     element->texCoord = texCoord;
@@ -7,6 +7,7 @@ extern "C" {
 
 #include "engine_metal.h"
 #include "engine_math.h"
+#include "engine_material.h"
 #include <stdint.h>
 
 // ============================================================================
@@ -29,6 +30,17 @@ typedef enum {
     UI_ELEMENT_TYPE_SDF = 1
 } UIElementType;
 
+// SDF material parameters: the same layout as SDFUniforms in ShaderTypes.h,
+// so a block from the material library binds directly as the shader's buffer
+typedef struct {
+    float fillColor[4];
+    float outlineColor[4];
+    float edgeDistance;
+    float outlineDistance;
+    float smoothing;
+    int32_t hasOutline;
+} UISDFParams;
+
 // UI element structure
 typedef struct {
     MetalTextureHandle texture;
@@ -47,6 +59,9 @@ typedef struct {
     float smoothing;            // Anti-aliasing (default: 0.1)
     int hasOutline;             // Enable outline rendering
     
+    // Pipeline plus interned parameters; equal styles share one id
+    MaterialId material;
+    
     // Atlas-specific properties (for font rendering)
     vec2_t texCoord;            // Texture coordinate offset in atlas
     vec2_t texSize;             // Texture coordinate size in atlas
@@ -82,6 +97,9 @@ typedef struct {
     MetalRenderPipelineStateHandle uiPipelineState;
     MetalDepthStencilStateHandle uiDepthState;
     
+    // Materials for UI elements (parameter blocks are shared across frames)
+    MaterialLibrary* materials;
+    
     // Metal engine reference
     MetalEngineHandle metalEngine;
 } Engine2D;
@@ -134,6 +152,7 @@ void engine_2d_render_pass(Engine2D* ui2d, void* renderEncoder, float screenWidt
 #define UI_INDICES_PER_ELEMENT 6
 #define UI_MAX_VERTICES (UI_MAX_ELEMENTS * UI_VERTICES_PER_ELEMENT)
 #define UI_MAX_INDICES (UI_MAX_ELEMENTS * UI_INDICES_PER_ELEMENT)
+#define UI_MATERIAL_PARAMS_BUDGET (64 * 1024)  // Interned SDF styles; the rest are copied per draw
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,469 @@
+#include "engine_animation.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <float.h>
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+#define ANIMATION_MAX_KEY_SPAN 256              // Bounds key reduction cost per segment
+#define SMALLEST_THREE_RANGE 0.707106781187f    // |component| bound of the three smallest
+
+static char* anim_str_dup(const char* s) {
+    if (!s) return NULL;
+    size_t n = strlen(s) + 1;
+    char* out = (char*)malloc(n);
+    if (out) memcpy(out, s, n);
+    return out;
+}
+
+FORCE_INLINE vec3_t vec3_lerp_anim(vec3_t a, vec3_t b, float t) {
+    return vec3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t);
+}
+
+// Normalized lerp along the shorter arc (what the sampler evaluates)
+FORCE_INLINE quat_t quat_nlerp_anim(quat_t a, quat_t b, float t) {
+    if (quat_dot(a, b) < 0.0f) b = quat_neg(b);
+    return quat_normalize(quat(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                               a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t));
+}
+
+FORCE_INLINE float vec3_max_error(vec3_t a, vec3_t b) {
+    float dx = fabsf(a.x - b.x), dy = fabsf(a.y - b.y), dz = fabsf(a.z - b.z);
+    return fmaxf(dx, fmaxf(dy, dz));
+}
+
+// Angle between two unit rotations in radians. Uses the chord |a - b| =
+// 2 sin(angle / 4), which stays precise for tiny angles where acos does not.
+FORCE_INLINE float quat_angle_error(quat_t a, quat_t b) {
+    if (quat_dot(a, b) < 0.0f) b = quat_neg(b);
+    quat_t d = quat_sub(a, b);
+    return 4.0f * asinf(fminf(0.5f * sqrtf(quat_dot(d, d)), 1.0f));
+}
+
+FORCE_INLINE uint16_t quantize_unorm16(float v, float lo, float extent) {
+    if (extent <= 0.0f) return 0;
+    float t = (v - lo) / extent;
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return (uint16_t)(t * 65535.0f + 0.5f);
+}
+
+static void encode_smallest_three(quat_t q, uint16_t* out) {
+    float c[4] = {q.x, q.y, q.z, q.w};
+    float len = sqrtf(c[0] * c[0] + c[1] * c[1] + c[2] * c[2] + c[3] * c[3]);
+    int largest = 0;
+    for (int i = 0; i < 4; i++) {
+        c[i] = len > 0.0f ? c[i] / len : (i == 3 ? 1.0f : 0.0f);
+        if (fabsf(c[i]) > fabsf(c[largest])) largest = i;
+    }
+    // q and -q are the same rotation; make the dropped component positive
+    float sign = c[largest] < 0.0f ? -1.0f : 1.0f;
+    int k = 0;
+    for (int i = 0; i < 4; i++) {
+        if (i == largest) continue;
+        float t = (c[i] * sign + SMALLEST_THREE_RANGE) / (2.0f * SMALLEST_THREE_RANGE);
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        out[k++] = (uint16_t)(t * 32767.0f + 0.5f);
+    }
+    out[0] |= (uint16_t)((largest & 1) << 15);
+    out[1] |= (uint16_t)((largest >> 1) << 15);
+}
+
+FORCE_INLINE quat_t decode_smallest_three(const uint16_t* in) {
+    const float scale = 2.0f * SMALLEST_THREE_RANGE / 32767.0f;
+    int largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+    float a = (float)(in[0] & 0x7FFF) * scale - SMALLEST_THREE_RANGE;
+    float b = (float)(in[1] & 0x7FFF) * scale - SMALLEST_THREE_RANGE;
+    float c = (float)(in[2] & 0x7FFF) * scale - SMALLEST_THREE_RANGE;
+    float d = sqrtf(fmaxf(0.0f, 1.0f - a * a - b * b - c * c));
+    // Table scatter instead of a switch: the largest index is data-dependent
+    static const uint8_t slots[4][4] = {{1, 2, 3, 0}, {0, 2, 3, 1}, {0, 1, 3, 2}, {0, 1, 2, 3}};
+    float q[4];
+    q[slots[largest][0]] = a;
+    q[slots[largest][1]] = b;
+    q[slots[largest][2]] = c;
+    q[slots[largest][3]] = d;
+    return quat(q[0], q[1], q[2], q[3]);
+}
+
+FORCE_INLINE vec3_t decode_vec3(const AnimationTrack* track, const uint16_t* in) {
+    const float inv = 1.0f / 65535.0f;
+    return vec3(track->range_min[0] + (float)in[0] * inv * track->range_extent[0],
+                track->range_min[1] + (float)in[1] * inv * track->range_extent[1],
+                track->range_min[2] + (float)in[2] * inv * track->range_extent[2]);
+}
+
+// Can frames (first, last) be linearly interpolated from the two ends within tolerance?
+static int segment_within_tolerance(const vec3_t* vecs, const quat_t* quats, uint32_t first, uint32_t last, float tolerance) {
+    float inv_span = 1.0f / (float)(last - first);
+    for (uint32_t k = first + 1; k < last; k++) {
+        float t = (float)(k - first) * inv_span;
+        if (quats) {
+            if (quat_angle_error(quat_nlerp_anim(quats[first], quats[last], t), quats[k]) > tolerance) return 0;
+        } else {
+            if (vec3_max_error(vec3_lerp_anim(vecs[first], vecs[last], t), vecs[k]) > tolerance) return 0;
+        }
+    }
+    return 1;
+}
+
+// Greedy error-bounded key reduction: each key is extended to the farthest
+// frame whose linear interpolation still reproduces every skipped frame.
+// Writes kept frame indices to out_frames and returns their count.
+static uint32_t reduce_keys(const vec3_t* vecs, const quat_t* quats, uint32_t frame_count, float tolerance, uint16_t* out_frames) {
+    uint32_t count = 0;
+    out_frames[count++] = 0;
+    uint32_t i = 0;
+    while (i + 1 < frame_count) {
+        uint32_t j = i + 1;
+        while (j + 1 < frame_count && j + 1 - i <= ANIMATION_MAX_KEY_SPAN &&
+               segment_within_tolerance(vecs, quats, i, j + 1, tolerance)) {
+            j++;
+        }
+        out_frames[count++] = (uint16_t)j;
+        i = j;
+    }
+    return count;
+}
+
+// ============================================================================
+// RAW CLIP FUNCTIONS
+// ============================================================================
+
+RawAnimationClip* raw_animation_clip_create(const char* name, uint32_t track_count, uint32_t frame_count, float sample_rate) {
+    if (frame_count == 0 || frame_count > ANIMATION_MAX_FRAMES || sample_rate <= 0.0f) {
+        fprintf(stderr, "Error: Invalid animation clip size (%u frames at %.2f fps)\n", frame_count, sample_rate);
+        return NULL;
+    }
+
+    RawAnimationClip* clip = (RawAnimationClip*)calloc(1, sizeof(RawAnimationClip));
+    if (!clip) {
+        fprintf(stderr, "Error: Failed to allocate memory for animation clip\n");
+        return NULL;
+    }
+    clip->name = anim_str_dup(name ? name : "");
+    clip->sample_rate = sample_rate;
+    clip->frame_count = frame_count;
+    clip->duration = (float)(frame_count - 1) / sample_rate;
+    clip->track_count = track_count;
+    clip->tracks = (RawAnimationTrack*)calloc(track_count ? track_count : 1, sizeof(RawAnimationTrack));
+    if (!clip->tracks) {
+        fprintf(stderr, "Error: Failed to allocate memory for %u animation tracks\n", track_count);
+        raw_animation_clip_destroy(clip);
+        return NULL;
+    }
+
+    for (uint32_t t = 0; t < track_count; t++) {
+        RawAnimationTrack* track = &clip->tracks[t];
+        track->joint = -1;
+        track->translations = (vec3_t*)malloc(frame_count * sizeof(vec3_t));
+        track->rotations = (quat_t*)malloc(frame_count * sizeof(quat_t));
+        track->scales = (vec3_t*)malloc(frame_count * sizeof(vec3_t));
+        if (!track->translations || !track->rotations || !track->scales) {
+            fprintf(stderr, "Error: Failed to allocate animation keys\n");
+            raw_animation_clip_destroy(clip);
+            return NULL;
+        }
+        for (uint32_t f = 0; f < frame_count; f++) {
+            track->translations[f] = vec3_zero();
+            track->rotations[f] = quat_identity();
+            track->scales[f] = vec3(1.0f, 1.0f, 1.0f);
+        }
+    }
+    return clip;
+}
+
+void raw_animation_clip_destroy(RawAnimationClip* clip) {
+    if (!clip) {
+        return;
+    }
+    if (clip->tracks) {
+        for (uint32_t t = 0; t < clip->track_count; t++) {
+            free(clip->tracks[t].joint_name);
+            free(clip->tracks[t].translations);
+            free(clip->tracks[t].rotations);
+            free(clip->tracks[t].scales);
+        }
+    }
+    free(clip->tracks);
+    free(clip->name);
+    free(clip);
+}
+
+uint32_t raw_animation_clip_bind(RawAnimationClip* clip, const Skeleton* skeleton) {
+    if (!clip || !skeleton) {
+        return 0;
+    }
+    uint32_t bound = 0;
+    for (uint32_t t = 0; t < clip->track_count; t++) {
+        clip->tracks[t].joint = skeleton_find_joint(skeleton, clip->tracks[t].joint_name);
+        if (clip->tracks[t].joint >= 0) bound++;
+    }
+    return bound;
+}
+
+void raw_animation_clip_sample(const RawAnimationClip* clip, float time, Pose* pose) {
+    if (!clip || !pose) {
+        return;
+    }
+    float frame = fminf(fmaxf(time, 0.0f), clip->duration) * clip->sample_rate;
+    uint32_t f0 = (uint32_t)frame;
+    if (f0 >= clip->frame_count - 1) f0 = clip->frame_count - 1;
+    uint32_t f1 = f0 + 1 < clip->frame_count ? f0 + 1 : f0;
+    float alpha = frame - (float)f0;
+
+    for (uint32_t t = 0; t < clip->track_count; t++) {
+        const RawAnimationTrack* track = &clip->tracks[t];
+        if (track->joint < 0 || (uint32_t)track->joint >= pose->skeleton->joint_count) continue;
+        pose->translations[track->joint] = vec3_lerp_anim(track->translations[f0], track->translations[f1], alpha);
+        pose->rotations[track->joint] = quat_nlerp_anim(track->rotations[f0], track->rotations[f1], alpha);
+        pose->scales[track->joint] = vec3_lerp_anim(track->scales[f0], track->scales[f1], alpha);
+    }
+}
+
+size_t raw_animation_clip_get_memory_size(const RawAnimationClip* clip) {
+    if (!clip) {
+        return 0;
+    }
+    size_t per_frame = sizeof(vec3_t) + sizeof(quat_t) + sizeof(vec3_t);
+    return sizeof(RawAnimationClip) + clip->track_count * (sizeof(RawAnimationTrack) + clip->frame_count * per_frame);
+}
+
+// ============================================================================
+// COMPRESSED CLIP FUNCTIONS
+// ============================================================================
+
+AnimationCompressionSettings animation_compression_settings_default(void) {
+    AnimationCompressionSettings settings;
+    settings.translation_tolerance = 0.0005f;
+    settings.rotation_tolerance = 0.001f;
+    settings.scale_tolerance = 0.0005f;
+    return settings;
+}
+
+static int compare_track_joint(const void* a, const void* b) {
+    const RawAnimationTrack* ta = *(const RawAnimationTrack* const*)a;
+    const RawAnimationTrack* tb = *(const RawAnimationTrack* const*)b;
+    return (ta->joint > tb->joint) - (ta->joint < tb->joint);
+}
+
+AnimationClip* animation_clip_compress(const RawAnimationClip* raw, const Skeleton* skeleton,
+                                       const AnimationCompressionSettings* settings) {
+    if (!raw || !skeleton) {
+        fprintf(stderr, "Error: Invalid parameters for animation_clip_compress\n");
+        return NULL;
+    }
+    AnimationCompressionSettings defaults = animation_compression_settings_default();
+    if (!settings) settings = &defaults;
+
+    uint32_t n = raw->frame_count;
+    const RawAnimationTrack** order = (const RawAnimationTrack**)malloc((raw->track_count ? raw->track_count : 1) * sizeof(RawAnimationTrack*));
+    uint16_t* frames = (uint16_t*)malloc(n * sizeof(uint16_t));
+    AnimationClip* clip = (AnimationClip*)calloc(1, sizeof(AnimationClip));
+    // Worst case: every bound channel keeps every frame
+    size_t max_keys = (size_t)raw->track_count * 3 * n;
+    if (clip) {
+        clip->tracks = (AnimationTrack*)malloc((raw->track_count ? raw->track_count : 1) * 3 * sizeof(AnimationTrack));
+        clip->key_frames = (uint16_t*)malloc((max_keys ? max_keys : 1) * sizeof(uint16_t));
+        clip->key_values = (uint16_t*)malloc((max_keys ? max_keys : 1) * 3 * sizeof(uint16_t));
+    }
+    if (!order || !frames || !clip || !clip->tracks || !clip->key_frames || !clip->key_values) {
+        fprintf(stderr, "Error: Failed to allocate memory for animation compression\n");
+        free(order);
+        free(frames);
+        animation_clip_destroy(clip);
+        return NULL;
+    }
+
+    clip->name = anim_str_dup(raw->name);
+    clip->duration = raw->duration;
+    clip->sample_rate = raw->sample_rate;
+    clip->frame_count = n;
+
+    uint32_t bound = 0;
+    for (uint32_t t = 0; t < raw->track_count; t++) {
+        int32_t joint = raw->tracks[t].joint;
+        if (joint >= 0 && (uint32_t)joint < skeleton->joint_count) order[bound++] = &raw->tracks[t];
+    }
+    qsort(order, bound, sizeof(*order), compare_track_joint);
+
+    for (uint32_t b = 0; b < bound; b++) {
+        const RawAnimationTrack* src = order[b];
+        uint32_t joint = (uint32_t)src->joint;
+        for (int channel = 0; channel < 3; channel++) {
+            const quat_t* quats = channel == ANIMATION_CHANNEL_ROTATION ? src->rotations : NULL;
+            const vec3_t* vecs = channel == ANIMATION_CHANNEL_TRANSLATION ? src->translations :
+                                 channel == ANIMATION_CHANNEL_SCALE ? src->scales : NULL;
+            float tolerance = channel == ANIMATION_CHANNEL_TRANSLATION ? settings->translation_tolerance :
+                              channel == ANIMATION_CHANNEL_ROTATION ? settings->rotation_tolerance : settings->scale_tolerance;
+
+            // Constant channels collapse to one key, or to nothing at the bind pose
+            int constant = 1;
+            for (uint32_t f = 1; f < n && constant; f++) {
+                constant = quats ? quat_angle_error(quats[f], quats[0]) <= tolerance
+                                 : vec3_max_error(vecs[f], vecs[0]) <= tolerance;
+            }
+            if (constant) {
+                int at_bind = quats ? quat_angle_error(quats[0], skeleton->bind_rotations[joint]) <= tolerance
+                                    : vec3_max_error(vecs[0], channel == ANIMATION_CHANNEL_TRANSLATION ?
+                                                     skeleton->bind_translations[joint] : skeleton->bind_scales[joint]) <= tolerance;
+                if (at_bind) continue;
+            }
+            uint32_t key_count = constant ? 1 : reduce_keys(vecs, quats, n, tolerance, frames);
+            if (constant) frames[0] = 0;
+
+            AnimationTrack* track = &clip->tracks[clip->track_count++];
+            memset(track, 0, sizeof(*track));
+            track->joint = (uint16_t)joint;
+            track->channel = (uint8_t)channel;
+            track->key_count = key_count;
+            track->first_key = clip->key_count;
+
+            if (!quats) {
+                float lo[3] = {FLT_MAX, FLT_MAX, FLT_MAX}, hi[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+                for (uint32_t k = 0; k < key_count; k++) {
+                    const float* v = &vecs[frames[k]].x;
+                    for (int c = 0; c < 3; c++) {
+                        lo[c] = fminf(lo[c], v[c]);
+                        hi[c] = fmaxf(hi[c], v[c]);
+                    }
+                }
+                for (int c = 0; c < 3; c++) {
+                    track->range_min[c] = lo[c];
+                    track->range_extent[c] = hi[c] - lo[c];
+                }
+            }
+
+            for (uint32_t k = 0; k < key_count; k++) {
+                uint32_t key = clip->key_count + k;
+                uint16_t* out = &clip->key_values[key * 3];
+                clip->key_frames[key] = frames[k];
+                if (quats) {
+                    encode_smallest_three(quats[frames[k]], out);
+                } else {
+                    const float* v = &vecs[frames[k]].x;
+                    for (int c = 0; c < 3; c++) {
+                        out[c] = quantize_unorm16(v[c], track->range_min[c], track->range_extent[c]);
+                    }
+                }
+            }
+            clip->key_count += key_count;
+        }
+    }
+
+    free(order);
+    free(frames);
+
+    // Trim the worst-case allocations to the final size
+    if (clip->key_count > 0) {
+        uint16_t* key_frames = (uint16_t*)realloc(clip->key_frames, clip->key_count * sizeof(uint16_t));
+        uint16_t* key_values = (uint16_t*)realloc(clip->key_values, clip->key_count * 3 * sizeof(uint16_t));
+        if (key_frames) clip->key_frames = key_frames;
+        if (key_values) clip->key_values = key_values;
+    }
+    if (clip->track_count > 0) {
+        AnimationTrack* tracks = (AnimationTrack*)realloc(clip->tracks, clip->track_count * sizeof(AnimationTrack));
+        if (tracks) clip->tracks = tracks;
+    }
+
+    // Seek table: last key at or before each bucket's first frame
+    clip->bucket_count = (n - 1) / ANIMATION_BUCKET_FRAMES + 1;
+    clip->bucket_keys = (uint16_t*)malloc(((size_t)clip->bucket_count * clip->track_count + 1) * sizeof(uint16_t));
+    if (!clip->bucket_keys) {
+        fprintf(stderr, "Error: Failed to allocate animation seek table\n");
+        animation_clip_destroy(clip);
+        return NULL;
+    }
+    for (uint32_t t = 0; t < clip->track_count; t++) {
+        const AnimationTrack* track = &clip->tracks[t];
+        const uint16_t* key_frames = &clip->key_frames[track->first_key];
+        uint32_t k = 0;
+        for (uint32_t b = 0; b < clip->bucket_count; b++) {
+            uint32_t frame = b * ANIMATION_BUCKET_FRAMES;
+            while (k + 1 < track->key_count && key_frames[k + 1] <= frame) k++;
+            clip->bucket_keys[(size_t)b * clip->track_count + t] = (uint16_t)k;
+        }
+    }
+    return clip;
+}
+
+void animation_clip_destroy(AnimationClip* clip) {
+    if (!clip) {
+        return;
+    }
+    free(clip->name);
+    free(clip->tracks);
+    free(clip->key_frames);
+    free(clip->key_values);
+    free(clip->bucket_keys);
+    free(clip);
+}
+
+void animation_clip_sample(const AnimationClip* clip, float time, Pose* pose) {
+    if (!clip || !pose) {
+        return;
+    }
+    float frame = fminf(fmaxf(time, 0.0f), clip->duration) * clip->sample_rate;
+    uint32_t joint_count = pose->skeleton->joint_count;
+    uint32_t bucket = (uint32_t)frame / ANIMATION_BUCKET_FRAMES;
+    if (bucket >= clip->bucket_count) bucket = clip->bucket_count - 1;
+    const uint16_t* seek = &clip->bucket_keys[(size_t)bucket * clip->track_count];
+
+    for (uint32_t t = 0; t < clip->track_count; t++) {
+        const AnimationTrack* track = &clip->tracks[t];
+        if (track->joint >= joint_count) continue;
+        const uint16_t* frames = &clip->key_frames[track->first_key];
+        const uint16_t* values = &clip->key_values[(size_t)track->first_key * 3];
+
+        // Last key at or before the frame, scanning forward from the bucket start
+        uint32_t lo = seek[t];
+        while (lo + 1 < track->key_count && (float)frames[lo + 1] <= frame) lo++;
+        uint32_t k1 = lo + 1 < track->key_count ? lo + 1 : lo;
+        float alpha = k1 == lo ? 0.0f : (frame - (float)frames[lo]) / (float)(frames[k1] - frames[lo]);
+
+        if (track->channel == ANIMATION_CHANNEL_ROTATION) {
+            quat_t a = decode_smallest_three(&values[lo * 3]);
+            pose->rotations[track->joint] = k1 == lo ? a : quat_nlerp_anim(a, decode_smallest_three(&values[k1 * 3]), alpha);
+        } else {
+            vec3_t a = decode_vec3(track, &values[lo * 3]);
+            vec3_t v = k1 == lo ? a : vec3_lerp_anim(a, decode_vec3(track, &values[k1 * 3]), alpha);
+            if (track->channel == ANIMATION_CHANNEL_TRANSLATION) {
+                pose->translations[track->joint] = v;
+            } else {
+                pose->scales[track->joint] = v;
+            }
+        }
+    }
+}
+
+size_t animation_clip_get_memory_size(const AnimationClip* clip) {
+    if (!clip) {
+        return 0;
+    }
+    return sizeof(AnimationClip) + clip->track_count * sizeof(AnimationTrack) +
+           clip->key_count * (sizeof(uint16_t) + 3 * sizeof(uint16_t)) +
+           (size_t)clip->bucket_count * clip->track_count * sizeof(uint16_t);
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void animation_clip_print(const char* name, const AnimationClip* clip, const RawAnimationClip* raw) {
+    if (!clip) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s: \"%s\"\n", name, clip->name ? clip->name : "");
+    printf("  Duration: %.3f s (%u frames at %.1f fps)\n", clip->duration, clip->frame_count, clip->sample_rate);
+    printf("  Tracks: %u, keys: %u\n", clip->track_count, clip->key_count);
+    printf("  Memory: %zu bytes\n", animation_clip_get_memory_size(clip));
+    if (raw) {
+        size_t raw_size = raw_animation_clip_get_memory_size(raw);
+        printf("  Raw memory: %zu bytes (%.1fx compression)\n", raw_size,
+               (double)raw_size / (double)animation_clip_get_memory_size(clip));
+    }
+}
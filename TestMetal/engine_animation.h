@@ -0,0 +1,147 @@
+#ifndef ENGINE_ANIMATION_H
+#define ENGINE_ANIMATION_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_skinning.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// ANIMATION CONFIGURATION
+// ============================================================================
+
+#define ANIMATION_DEFAULT_SAMPLE_RATE 30.0f     // Frames per second when resampling imports
+#define ANIMATION_MAX_FRAMES 65535              // Key frames are stored as uint16
+#define ANIMATION_BUCKET_FRAMES 16              // Frames per sampler seek bucket
+
+// Channel of a joint driven by a track
+typedef enum {
+    ANIMATION_CHANNEL_TRANSLATION = 0,
+    ANIMATION_CHANNEL_ROTATION = 1,
+    ANIMATION_CHANNEL_SCALE = 2
+} AnimationChannel;
+
+// ============================================================================
+// RAW CLIPS (uniformly sampled float keys)
+// ============================================================================
+
+// One joint's local transform at every frame of the clip
+typedef struct {
+    char* joint_name;
+    int32_t joint;              // Skeleton index after raw_animation_clip_bind (-1 = unbound)
+    vec3_t* translations;       // frame_count entries each
+    quat_t* rotations;
+    vec3_t* scales;
+} RawAnimationTrack;
+
+// Uncompressed clip: the import format and the reference for compression
+typedef struct {
+    char* name;
+    float duration;             // Seconds
+    float sample_rate;          // Frames per second
+    uint32_t frame_count;       // duration * sample_rate + 1
+    RawAnimationTrack* tracks;
+    uint32_t track_count;
+} RawAnimationClip;
+
+// ============================================================================
+// COMPRESSED CLIPS
+// ============================================================================
+
+// Error bounds for key reduction
+typedef struct {
+    float translation_tolerance;    // Units
+    float rotation_tolerance;       // Radians
+    float scale_tolerance;          // Absolute scale difference
+} AnimationCompressionSettings;
+
+// One reduced, quantized channel. Every key is three uint16 words:
+// translation/scale are 16-bit fractions of [range_min, range_min + range_extent],
+// rotations use smallest-three (15 bits per component, largest index in the
+// top bits of words 0 and 1).
+typedef struct {
+    uint16_t joint;
+    uint8_t channel;            // AnimationChannel
+    uint8_t reserved;
+    uint32_t key_count;
+    uint32_t first_key;         // Offset into key_frames (and key_values / 3)
+    float range_min[3];
+    float range_extent[3];
+} AnimationTrack;
+
+// Compressed clip. Tracks are ordered by joint, then channel, and their keys
+// are packed back to back so sampling walks memory once, front to back.
+// A bucket row per ANIMATION_BUCKET_FRAMES frames holds each track's key
+// at the bucket start, so the sampler seeks without searching.
+// Channels that never leave the bind pose have no track.
+typedef struct {
+    char* name;
+    float duration;
+    float sample_rate;
+    uint32_t frame_count;
+    AnimationTrack* tracks;
+    uint32_t track_count;
+    uint16_t* key_frames;       // Frame index of each key
+    uint16_t* key_values;       // 3 words per key
+    uint32_t key_count;
+    uint16_t* bucket_keys;      // [bucket * track_count + track], relative to first_key
+    uint32_t bucket_count;
+} AnimationClip;
+
+// ============================================================================
+// RAW CLIP FUNCTIONS
+// ============================================================================
+
+// Create a raw clip with track_count tracks of frame_count identity keys
+RawAnimationClip* raw_animation_clip_create(const char* name, uint32_t track_count, uint32_t frame_count, float sample_rate);
+
+// Destroy a raw clip
+void raw_animation_clip_destroy(RawAnimationClip* clip);
+
+// Resolve track joint names against a skeleton. Returns the number of bound tracks.
+uint32_t raw_animation_clip_bind(RawAnimationClip* clip, const Skeleton* skeleton);
+
+// Sample bound tracks at time (seconds, clamped) into the pose's local transforms
+void raw_animation_clip_sample(const RawAnimationClip* clip, float time, Pose* pose);
+
+// Bytes used by the clip's key data
+size_t raw_animation_clip_get_memory_size(const RawAnimationClip* clip);
+
+// ============================================================================
+// COMPRESSED CLIP FUNCTIONS
+// ============================================================================
+
+// Default tolerances (0.5 mm, ~0.06 degrees, 0.0005 scale)
+AnimationCompressionSettings animation_compression_settings_default(void);
+
+// Reduce and quantize a bound raw clip. Bind-pose channels are dropped
+// against the skeleton's rest pose.
+AnimationClip* animation_clip_compress(const RawAnimationClip* raw, const Skeleton* skeleton,
+                                       const AnimationCompressionSettings* settings);
+
+// Destroy a compressed clip
+void animation_clip_destroy(AnimationClip* clip);
+
+// Sample every track at time (seconds, clamped) in one pass. Joints and
+// channels without a track are left untouched, so start from pose_set_bind.
+void animation_clip_sample(const AnimationClip* clip, float time, Pose* pose);
+
+// Bytes used by the clip's tracks and keys
+size_t animation_clip_get_memory_size(const AnimationClip* clip);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print clip statistics and compression ratio against its raw source (raw may be NULL)
+void animation_clip_print(const char* name, const AnimationClip* clip, const RawAnimationClip* raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_ANIMATION_H
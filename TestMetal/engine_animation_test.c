@@ -0,0 +1,351 @@
+#include "engine_animation.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static char* dup_string(const char* s) {
+    char* out = (char*)malloc(strlen(s) + 1);
+    strcpy(out, s);
+    return out;
+}
+
+// Angle between rotations via the chord length (precise for small angles)
+static float rotation_error(quat_t a, quat_t b) {
+    a = quat_normalize(a);
+    b = quat_normalize(b);
+    if (quat_dot(a, b) < 0.0f) b = quat_neg(b);
+    quat_t d = quat_sub(a, b);
+    return 4.0f * asinf(fminf(0.5f * sqrtf(quat_dot(d, d)), 1.0f));
+}
+
+static float translation_error(vec3_t a, vec3_t b) {
+    return fmaxf(fabsf(a.x - b.x), fmaxf(fabsf(a.y - b.y), fabsf(a.z - b.z)));
+}
+
+// Skeleton with joints named "joint0".."jointN-1" in a chain
+static Skeleton* create_named_skeleton(uint32_t joint_count) {
+    Skeleton* skeleton = skeleton_create(joint_count);
+    for (uint32_t j = 0; j < joint_count; j++) {
+        char name[32];
+        snprintf(name, sizeof(name), "joint%u", j);
+        skeleton->names[j] = dup_string(name);
+        skeleton->parents[j] = (int32_t)j - 1;
+    }
+    return skeleton;
+}
+
+// Raw clip with one smoothly animated track per joint
+static RawAnimationClip* create_wave_clip(const Skeleton* skeleton, uint32_t frame_count) {
+    RawAnimationClip* clip = raw_animation_clip_create("wave", skeleton->joint_count, frame_count, 30.0f);
+    for (uint32_t j = 0; j < skeleton->joint_count; j++) {
+        RawAnimationTrack* track = &clip->tracks[j];
+        track->joint_name = dup_string(skeleton->names[j]);
+        for (uint32_t f = 0; f < frame_count; f++) {
+            float t = (float)f / 30.0f;
+            float phase = (float)j * 0.37f;
+            track->translations[f] = vec3(0.1f * sinf(t * 2.0f + phase), 1.0f + 0.05f * cosf(t * 3.0f), 0.0f);
+            vec3_t axis = vec3_normalize(vec3(1.0f, (float)(j % 3), 0.5f));
+            track->rotations[f] = quat_from_axis_angle(axis, 0.8f * sinf(t * 1.5f + phase));
+        }
+    }
+    raw_animation_clip_bind(clip, skeleton);
+    return clip;
+}
+
+// ============================================================================
+// TEST FUNCTIONS
+// ============================================================================
+
+static void test_quantization(void) {
+    printf("\n--- Quantization Tests ---\n");
+
+    Skeleton* skeleton = create_named_skeleton(1);
+    RawAnimationClip* raw = raw_animation_clip_create("noise", 1, 200, 30.0f);
+    raw->tracks[0].joint_name = dup_string("joint0");
+    TEST_ASSERT_EQUAL(1u, raw_animation_clip_bind(raw, skeleton), "Track should bind to the skeleton by name");
+
+    uint32_t rng = 99;
+    for (uint32_t f = 0; f < raw->frame_count; f++) {
+        float c[4];
+        for (int i = 0; i < 4; i++) {
+            rng = rng * 1664525u + 1013904223u;
+            c[i] = (float)(rng >> 8) / 8388608.0f - 1.0f;
+        }
+        raw->tracks[0].rotations[f] = quat_normalize(quat(c[0], c[1], c[2], c[3]));
+        raw->tracks[0].translations[f] = vec3(c[0] * 50.0f, c[1] * 2.0f, c[2] * 0.01f);
+    }
+
+    AnimationCompressionSettings settings = {0.0f, 0.0f, 0.0f};
+    AnimationClip* clip = animation_clip_compress(raw, skeleton, &settings);
+    TEST_ASSERT_NOT_NULL(clip, "Clip should compress");
+
+    Pose* pose = pose_create(skeleton);
+    float max_rot = 0.0f, max_trans = 0.0f;
+    for (uint32_t f = 0; f < raw->frame_count; f++) {
+        animation_clip_sample(clip, (float)f / raw->sample_rate, pose);
+        max_rot = fmaxf(max_rot, rotation_error(pose->rotations[0], raw->tracks[0].rotations[f]));
+        max_trans = fmaxf(max_trans, translation_error(pose->translations[0], raw->tracks[0].translations[f]));
+    }
+    printf("Max quantization error: rotation %.6f rad, translation %.6f (range 100)\n", max_rot, max_trans);
+    TEST_ASSERT(max_rot < 2e-4f, "Smallest-three rotations should be accurate to ~0.01 degrees");
+    TEST_ASSERT(max_trans < 100.0f / 65535.0f, "16-bit translations should be within one step of their range");
+
+    pose_destroy(pose);
+    animation_clip_destroy(clip);
+    raw_animation_clip_destroy(raw);
+    skeleton_destroy(skeleton);
+}
+
+static void test_key_reduction(void) {
+    printf("\n--- Key Reduction Tests ---\n");
+
+    Skeleton* skeleton = create_named_skeleton(3);
+    RawAnimationClip* raw = raw_animation_clip_create("reduce", 3, 61, 30.0f);
+    for (uint32_t j = 0; j < 3; j++) raw->tracks[j].joint_name = dup_string(skeleton->names[j]);
+    raw_animation_clip_bind(raw, skeleton);
+    for (uint32_t f = 0; f < raw->frame_count; f++) {
+        float t = (float)f / 30.0f;
+        raw->tracks[0].translations[f] = vec3(t * 3.0f, 0.0f, 0.0f);            // Linear: two keys
+        raw->tracks[1].translations[f] = vec3(0.0f, sinf(t * 2.0f), 0.0f);      // Curved: reduced
+        raw->tracks[2].scales[f] = vec3(2.0f, 2.0f, 2.0f);                      // Constant, off bind
+    }
+
+    AnimationCompressionSettings settings = animation_compression_settings_default();
+    settings.translation_tolerance = 0.005f;
+    AnimationClip* clip = animation_clip_compress(raw, skeleton, &settings);
+    TEST_ASSERT_EQUAL(3u, clip->track_count, "Only channels that leave the bind pose should get tracks");
+    TEST_ASSERT(clip->tracks[0].joint == 0 && clip->tracks[0].key_count == 2, "Linear motion should reduce to two keys");
+    TEST_ASSERT(clip->tracks[1].joint == 1 && clip->tracks[1].key_count > 2 && clip->tracks[1].key_count < 40,
+                "Curved motion should keep only the keys it needs");
+    TEST_ASSERT(clip->tracks[2].channel == ANIMATION_CHANNEL_SCALE && clip->tracks[2].key_count == 1,
+                "Constant channel should collapse to one key");
+
+    Pose* pose = pose_create(skeleton);
+    float max_error = 0.0f;
+    for (uint32_t f = 0; f < raw->frame_count; f++) {
+        animation_clip_sample(clip, (float)f / 30.0f, pose);
+        max_error = fmaxf(max_error, translation_error(pose->translations[1], raw->tracks[1].translations[f]));
+    }
+    printf("Curved track: %u of %u keys, max error %.6f\n", clip->tracks[1].key_count, raw->frame_count, max_error);
+    TEST_ASSERT(max_error <= settings.translation_tolerance + 2.0f / 65535.0f, "Reduced track should stay within tolerance");
+    TEST_ASSERT(vec3_equal(pose->scales[2], vec3(2.0f, 2.0f, 2.0f)), "Constant scale should be restored exactly");
+
+    animation_clip_sample(clip, 100.0f, pose);
+    TEST_ASSERT(translation_error(pose->translations[0], vec3(6.0f, 0.0f, 0.0f)) < 1e-3f, "Sampling past the end should clamp");
+
+    pose_destroy(pose);
+    animation_clip_destroy(clip);
+    raw_animation_clip_destroy(raw);
+    skeleton_destroy(skeleton);
+}
+
+static const char* ANIMATED_FBX =
+    "; FBX 7.4.0 project file\n"
+    "Objects:  {\n"
+    "\tModel: 200, \"Model::Root\", \"LimbNode\" {\n"
+    "\t}\n"
+    "\tModel: 201, \"Model::Bone\", \"LimbNode\" {\n"
+    "\t\tProperties70:  {\n"
+    "\t\t\tP: \"Lcl Translation\", \"Lcl Translation\", \"\", \"A\",0,1,0\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tAnimationStack: 400, \"AnimStack::Take 001\", \"\" {\n"
+    "\t\tProperties70:  {\n"
+    "\t\t\tP: \"LocalStop\", \"KTime\", \"Time\", \"\",46186158000\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tAnimationLayer: 401, \"AnimLayer::BaseLayer\", \"\" {\n"
+    "\t}\n"
+    "\tAnimationCurveNode: 500, \"AnimCurveNode::T\", \"\" {\n"
+    "\t}\n"
+    "\tAnimationCurveNode: 501, \"AnimCurveNode::R\", \"\" {\n"
+    "\t}\n"
+    "\tAnimationCurve: 600, \"AnimCurve::\", \"\" {\n"
+    "\t\tKeyTime: *2 {\n"
+    "\t\t\ta: 0,46186158000\n"
+    "\t\t}\n"
+    "\t\tKeyValueFloat: *2 {\n"
+    "\t\t\ta: 0,10\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tAnimationCurve: 601, \"AnimCurve::\", \"\" {\n"
+    "\t\tKeyTime: *3 {\n"
+    "\t\t\ta: 0,23093079000,46186158000\n"
+    "\t\t}\n"
+    "\t\tKeyValueFloat: *3 {\n"
+    "\t\t\ta: 0,90,90\n"
+    "\t\t}\n"
+    "\t}\n"
+    "}\n"
+    "Connections:  {\n"
+    "\tC: \"OO\",200,0\n"
+    "\tC: \"OO\",201,200\n"
+    "\tC: \"OO\",401,400\n"
+    "\tC: \"OO\",500,401\n"
+    "\tC: \"OO\",501,401\n"
+    "\tC: \"OP\",500,201, \"Lcl Translation\"\n"
+    "\tC: \"OP\",501,201, \"Lcl Rotation\"\n"
+    "\tC: \"OP\",600,500, \"d|X\"\n"
+    "\tC: \"OP\",601,501, \"d|Z\"\n"
+    "}\n";
+
+static void test_fbx_import(void) {
+    printf("\n--- FBX Animation Import Tests ---\n");
+
+    const char* path = "/tmp/engine_animation_test.fbx";
+    FILE* f = fopen(path, "w");
+    TEST_ASSERT_NOT_NULL(f, "Temporary FBX file should be writable");
+    if (!f) return;
+    fputs(ANIMATED_FBX, f);
+    fclose(f);
+
+    uint32_t clip_count = 0;
+    char* err = NULL;
+    RawAnimationClip** clips = fbx_load_animation_clips(path, &clip_count, &err);
+    TEST_ASSERT_NOT_NULL(clips, "Animated FBX should load");
+    if (!clips) {
+        printf("  error: %s\n", err ? err : "(none)");
+        fbx_free_error(err);
+        return;
+    }
+    TEST_ASSERT_EQUAL(1u, clip_count, "One clip per animation stack");
+    RawAnimationClip* raw = clips[0];
+    TEST_ASSERT(strcmp(raw->name, "Take 001") == 0, "Clip should be named after its stack");
+    TEST_ASSERT(raw->frame_count == 31 && fabsf(raw->duration - 1.0f) < 1e-6f, "One second at 30 fps should be 31 frames");
+    TEST_ASSERT(raw->track_count == 1 && strcmp(raw->tracks[0].joint_name, "Bone") == 0, "Only the animated model should get a track");
+
+    Skeleton* skeleton = skeleton_create(2);
+    skeleton->names[0] = dup_string("Root");
+    skeleton->names[1] = dup_string("Bone");
+    skeleton->parents[1] = 0;
+    skeleton->bind_translations[1] = vec3(0.0f, 1.0f, 0.0f);
+    TEST_ASSERT_EQUAL(1u, raw_animation_clip_bind(raw, skeleton), "Clip should bind by joint name");
+
+    AnimationClip* clip = animation_clip_compress(raw, skeleton, NULL);
+    Pose* pose = pose_create(skeleton);
+    animation_clip_sample(clip, 0.25f, pose);
+    quat_t expected = quat_from_axis_angle(vec3(0.0f, 0.0f, 1.0f), 0.25f * 3.14159265f);
+    TEST_ASSERT(translation_error(pose->translations[1], vec3(2.5f, 1.0f, 0.0f)) < 1e-3f, "Curve X should drive translation; Lcl fills Y");
+    printf("Rotation error at 0.25 s: %.6f rad\n", rotation_error(pose->rotations[1], expected));
+    TEST_ASSERT(rotation_error(pose->rotations[1], expected) < 2e-3f, "Rotation curve (degrees, Z) should drive rotation");
+    animation_clip_print("Imported clip", clip, raw);
+
+    pose_destroy(pose);
+    animation_clip_destroy(clip);
+    skeleton_destroy(skeleton);
+    fbx_free_animation_clips(clips, clip_count);
+    remove(path);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t joint_count = 64;
+    const uint32_t frame_count = 301;       // 10 s at 30 fps
+    const int samples = 20000;
+
+    Skeleton* skeleton = create_named_skeleton(joint_count);
+    RawAnimationClip* raw = create_wave_clip(skeleton, frame_count);
+
+    double start = now_ms();
+    AnimationClip* clip = animation_clip_compress(raw, skeleton, NULL);
+    double compress_ms = now_ms() - start;
+
+    size_t raw_size = raw_animation_clip_get_memory_size(raw);
+    size_t clip_size = animation_clip_get_memory_size(clip);
+    printf("Compression: %.2f ms, %u tracks, %u keys (of %u raw channel frames)\n",
+           compress_ms, clip->track_count, clip->key_count, joint_count * 2 * frame_count);
+    printf("Memory: raw %zu bytes, compressed %zu bytes (%.1fx)\n", raw_size, clip_size, (double)raw_size / (double)clip_size);
+    TEST_ASSERT(clip_size * 4 < raw_size, "Compressed clip should be at least 4x smaller than raw keys");
+
+    Pose* pose = pose_create(skeleton);
+    Pose* reference = pose_create(skeleton);
+    float max_rot = 0.0f, max_trans = 0.0f;
+    for (uint32_t f = 0; f < frame_count * 2; f++) {
+        float t = (float)f / 60.0f;
+        animation_clip_sample(clip, t, pose);
+        raw_animation_clip_sample(raw, t, reference);
+        for (uint32_t j = 0; j < joint_count; j++) {
+            max_rot = fmaxf(max_rot, rotation_error(pose->rotations[j], reference->rotations[j]));
+            max_trans = fmaxf(max_trans, translation_error(pose->translations[j], reference->translations[j]));
+        }
+    }
+    printf("Max error vs raw: rotation %.6f rad, translation %.6f\n", max_rot, max_trans);
+    AnimationCompressionSettings settings = animation_compression_settings_default();
+    TEST_ASSERT(max_rot <= settings.rotation_tolerance + 2e-4f && max_trans <= settings.translation_tolerance + 1e-5f,
+                "Compressed sampling should stay within tolerance plus quantization");
+
+    for (int pass = 0; pass < 2; pass++) {
+        start = now_ms();
+        for (int s = 0; s < samples; s++) {
+            float t = (float)(s % 600) / 60.0f;
+            if (pass == 0) raw_animation_clip_sample(raw, t, pose);
+            else animation_clip_sample(clip, t, pose);
+        }
+        double elapsed = now_ms() - start;
+        printf("%s sampling: %.3f us/clip, %.0f joints/ms\n", pass == 0 ? "Raw" : "Compressed",
+               elapsed * 1000.0 / samples, (double)samples * joint_count / elapsed);
+    }
+
+    pose_destroy(pose);
+    pose_destroy(reference);
+    animation_clip_destroy(clip);
+    raw_animation_clip_destroy(raw);
+    skeleton_destroy(skeleton);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Animation Unit Tests\n");
+    printf("===================================\n");
+
+    test_quantization();
+    test_key_reduction();
+    test_fbx_import();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
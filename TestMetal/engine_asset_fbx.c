@@ -253,7 +253,9 @@ static int parse_fbx_ascii(const char* text, FBXParseData* out, char** out_error
     return 1;
 }
 
-static Model3D* build_model_from_parsed(const FBXParseData* d) {
+// out_control_points (optional) receives, per output vertex, the FBX control point
+// (position index) it was built from; used to map cluster weights onto vertices.
+static Model3D* build_model_from_parsed(const FBXParseData* d, uint32_t** out_control_points) {
     // Triangulate polygon indices. FBX uses negative index to mark end-of-polygon, and indices refer to position list.
     // We'll generate a triangle list via fan triangulation per polygon.
     // Also, normals/uvs mapping in FBX can be complex; for this minimal loader, we will duplicate vertices per polygon vertex if needed.
@@ -347,11 +349,23 @@ static Model3D* build_model_from_parsed(const FBXParseData* d) {
     if (!alloc_mesh) { 
         fprintf(stderr, "Failed to allocate mesh\n");
         model3d_free(model); 
+        free(model);
         return NULL; 
     }
     *mesh = *alloc_mesh;
     fprintf(stderr, "Allocated mesh with %u vertices and %u indices\n", out_vertex_count, out_index_count);
 
+    uint32_t* control_points = NULL;
+    if (out_control_points) {
+        control_points = (uint32_t*)calloc(out_vertex_count, sizeof(uint32_t));
+        if (!control_points) {
+            fprintf(stderr, "Failed to allocate control point map\n");
+            model3d_free(model);
+            free(model);
+            return NULL;
+        }
+    }
+
     // Second pass: fill vertices and indices
     uint32_t out_vi = 0;
     uint32_t out_ii = 0;
@@ -375,6 +389,10 @@ static Model3D* build_model_from_parsed(const FBXParseData* d) {
                     int i0 = poly_pos_idx[poly_start_vi + 0];
                     int i1 = poly_pos_idx[poly_start_vi + k];
                     int i2 = poly_pos_idx[poly_start_vi + k + 1];
+                    int pos_count = (int)(d->positions_count / 3);
+                    if (i0 >= pos_count || i1 >= pos_count || i2 >= pos_count) {
+                        continue; // Skip triangles referencing missing control points
+                    }
 
                     // positions
                     float px0 = d->positions[i0 * 3 + 0];
@@ -394,6 +412,11 @@ static Model3D* build_model_from_parsed(const FBXParseData* d) {
                     mesh->indices[out_ii + 0] = out_vi + 0;
                     mesh->indices[out_ii + 1] = out_vi + 1;
                     mesh->indices[out_ii + 2] = out_vi + 2;
+                    if (control_points) {
+                        control_points[out_vi + 0] = (uint32_t)i0;
+                        control_points[out_vi + 1] = (uint32_t)i1;
+                        control_points[out_vi + 2] = (uint32_t)i2;
+                    }
                     out_vi += 3;
                     out_ii += 3;
                 }
@@ -426,6 +449,7 @@ static Model3D* build_model_from_parsed(const FBXParseData* d) {
                 float v = (py + 1.0f) * 0.5f; // Map from [-1,1] to [0,1]
                 
                 mesh->vertices[out_vi] = vertex_create_components(px, py, pz, u, v, 0.0f, 0.0f, 1.0f);
+                if (control_points) control_points[out_vi] = i;
                 out_vi++;
             }
         }
@@ -446,6 +470,11 @@ static Model3D* build_model_from_parsed(const FBXParseData* d) {
     }
 
     fprintf(stderr, "Generated %u vertices and %u indices\n", out_vi, out_ii);
+    if (has_negative_indices) {
+        mesh->vertex_count = out_vi;
+        mesh->index_count = out_ii;
+        mesh->triangle_count = out_ii / 3;
+    }
     
     model3d_calculate_bounds(model);
     model3d_calculate_center_and_radius(model);
@@ -457,13 +486,12 @@ static Model3D* build_model_from_parsed(const FBXParseData* d) {
             model->center.x, model->center.y, model->center.z, model->radius);
     fprintf(stderr, "Model bounds calculated successfully\n");
     fprintf(stderr, "=== BUILD MODEL FROM PARSED END ===\n");
+    if (out_control_points) *out_control_points = control_points;
     return model;
 }
 
-Model3D* fbx_load_model(const char* filepath, char** out_error) {
-    fprintf(stderr, "=== FBX LOAD MODEL START ===\n");
-    fprintf(stderr, "Loading FBX file: %s\n", filepath);
-    
+// Open an FBX file and read it as NUL-terminated ASCII text. Binary files are rejected.
+static char* fbx_read_ascii_file(const char* filepath, char** out_error) {
     if (out_error) *out_error = NULL;
     FILE* f = fopen(filepath, "rb");
     if (!f) {
@@ -478,7 +506,6 @@ Model3D* fbx_load_model(const char* filepath, char** out_error) {
     }
     fprintf(stderr, "File opened successfully\n");
     
-    Model3D* model = NULL;
     if (is_binary_fbx(f)) {
         // For now, return error for binary; extend later with a real parser
         fprintf(stderr, "Binary FBX detected, not supported yet\n");
@@ -502,9 +529,20 @@ Model3D* fbx_load_model(const char* filepath, char** out_error) {
         return NULL; 
     }
     size_t bytes_read = fread(buf, 1, (size_t)sz, f);
-    buf[sz] = '\0';
+    buf[bytes_read] = '\0';
     fclose(f);
     fprintf(stderr, "Read %zu bytes from file\n", bytes_read);
+    return buf;
+}
+
+Model3D* fbx_load_model(const char* filepath, char** out_error) {
+    fprintf(stderr, "=== FBX LOAD MODEL START ===\n");
+    fprintf(stderr, "Loading FBX file: %s\n", filepath);
+    
+    char* buf = fbx_read_ascii_file(filepath, out_error);
+    if (!buf) {
+        return NULL;
+    }
 
     FBXParseData parsed; memset(&parsed, 0, sizeof(parsed));
     if (!parse_fbx_ascii(buf, &parsed, out_error)) {
@@ -516,7 +554,7 @@ Model3D* fbx_load_model(const char* filepath, char** out_error) {
     fprintf(stderr, "FBX ASCII parsing succeeded\n");
     free(buf);
 
-    model = build_model_from_parsed(&parsed);
+    Model3D* model = build_model_from_parsed(&parsed, NULL);
     fbx_parse_data_free(&parsed);
     if (!model && out_error && !*out_error) {
         fprintf(stderr, "Failed to build model from parsed data\n");
@@ -529,6 +567,738 @@ Model3D* fbx_load_model(const char* filepath, char** out_error) {
     return model;
 }
 
+// ============================================================================
+// SCENE OBJECTS (Model, Deformer Skin/Cluster, Animation*, Connections)
+// ============================================================================
+
+#define FBX_MAX_CONTROL_POINT_INFLUENCES 8
+#define FBX_TICKS_PER_SECOND 46186158000.0
+
+typedef struct {
+    long long id;
+    char* name;
+    int is_limb;
+    double lcl[9];          // Translation, rotation (degrees, XYZ), scaling
+    long long parent_id;    // 0 if not connected to another model
+    int32_t joint;          // Skeleton index, -1 if not a joint
+} FBXModelNode;
+
+typedef struct {
+    long long id;
+    long long model_id;     // Joint driven by this cluster
+    int* indexes;           // Control points
+    double* weights;
+    uint32_t count;
+    double transform[16];   // Mesh global at bind time
+    double link[16];        // Joint global at bind time
+    int has_transform;
+    int has_link;
+} FBXCluster;
+
+typedef struct {
+    long long id;
+    char* name;
+    double start;           // Seconds (LocalStart)
+    double stop;            // Seconds (LocalStop), 0 if absent
+} FBXAnimStack;
+
+typedef struct {
+    long long id;
+    long long stack_id;
+} FBXAnimLayer;
+
+// Animates one Lcl property of a model; one curve per axis
+typedef struct {
+    long long id;
+    long long layer_id;
+    long long model_id;
+    int channel;            // AnimationChannel, -1 if not bound to a Lcl property
+    long long curves[3];
+} FBXAnimCurveNode;
+
+typedef struct {
+    long long id;
+    double* times;          // Seconds
+    double* values;
+    uint32_t count;
+} FBXAnimCurve;
+
+typedef struct {
+    FBXModelNode* models;
+    uint32_t model_count, model_capacity;
+    FBXCluster* clusters;
+    uint32_t cluster_count, cluster_capacity;
+    FBXAnimStack* stacks;
+    uint32_t stack_count, stack_capacity;
+    FBXAnimLayer* layers;
+    uint32_t layer_count, layer_capacity;
+    FBXAnimCurveNode* curve_nodes;
+    uint32_t curve_node_count, curve_node_capacity;
+    FBXAnimCurve* curves;
+    uint32_t curve_count, curve_capacity;
+} FBXSceneParse;
+
+static void fbx_scene_parse_free(FBXSceneParse* d) {
+    for (uint32_t i = 0; i < d->model_count; i++) free(d->models[i].name);
+    for (uint32_t i = 0; i < d->cluster_count; i++) {
+        free(d->clusters[i].indexes);
+        free(d->clusters[i].weights);
+    }
+    for (uint32_t i = 0; i < d->stack_count; i++) free(d->stacks[i].name);
+    for (uint32_t i = 0; i < d->curve_count; i++) {
+        free(d->curves[i].times);
+        free(d->curves[i].values);
+    }
+    free(d->models);
+    free(d->clusters);
+    free(d->stacks);
+    free(d->layers);
+    free(d->curve_nodes);
+    free(d->curves);
+    memset(d, 0, sizeof(*d));
+}
+
+// Append a zeroed element to a growable array; returns it or NULL on failure
+static void* fbx_array_push(void** array, uint32_t* count, uint32_t* capacity, size_t elem_size) {
+    if (*count == *capacity) {
+        uint32_t grown_capacity = *capacity ? *capacity * 2 : 16;
+        void* grown = realloc(*array, grown_capacity * elem_size);
+        if (!grown) return NULL;
+        *array = grown;
+        *capacity = grown_capacity;
+    }
+    char* elem = (char*)*array + (size_t)(*count)++ * elem_size;
+    memset(elem, 0, elem_size);
+    return elem;
+}
+
+// Matching '}' for the '{' at open, or NULL
+static const char* fbx_block_end(const char* open) {
+    int depth = 0;
+    for (const char* c = open; *c; c++) {
+        if (*c == '{') depth++;
+        else if (*c == '}' && --depth == 0) return c;
+    }
+    return NULL;
+}
+
+// Find token inside [begin, end)
+static const char* fbx_find_in_block(const char* begin, const char* end, const char* token) {
+    const char* pos = strstr(begin, token);
+    return (pos && pos < end) ? pos : NULL;
+}
+
+// Parse the "a: v0,v1,..." array following key (within the block). Returns a
+// heap array of doubles and its length, or NULL if the key is absent.
+static double* fbx_parse_array(const char* begin, const char* end, const char* key, uint32_t* out_count) {
+    *out_count = 0;
+    const char* k = fbx_find_in_block(begin, end, key);
+    if (!k) return NULL;
+    const char* a = fbx_find_in_block(k, end, "a:");
+    if (!a) return NULL;
+    a += 2;
+    const char* stop = strchr(a, '}');
+    if (!stop || stop > end) stop = end;
+
+    uint32_t count = 0, capacity = 64;
+    double* values = (double*)malloc(capacity * sizeof(double));
+    const char* t = a;
+    while (values && t < stop) {
+        char* e; double v = strtod(t, &e);
+        if (e == t) break;
+        if (count == capacity) {
+            capacity *= 2;
+            double* grown = (double*)realloc(values, capacity * sizeof(double));
+            if (!grown) { free(values); return NULL; }
+            values = grown;
+        }
+        values[count++] = v; t = e;
+        while (t < stop && (*t == ',' || isspace((unsigned char)*t))) t++;
+    }
+    *out_count = count;
+    return values;
+}
+
+// Last count numbers of a 'P: "<name>", ... ,x,y,z' property line
+static int fbx_parse_property(const char* begin, const char* end, const char* name, double* out, int count) {
+    const char* p = fbx_find_in_block(begin, end, name);
+    if (!p) return 0;
+    const char* line_end = strchr(p, '\n');
+    if (!line_end || line_end > end) line_end = end;
+    const char* c = line_end;
+    int commas = 0;
+    while (c > p && commas < count) {
+        c--;
+        if (*c == ',') commas++;
+    }
+    if (commas < count) return 0;
+    for (int i = 0; i < count; i++) {
+        char* e; out[i] = strtod(c + 1, &e);
+        if (e == c + 1) return 0;
+        c = e;
+    }
+    return 1;
+}
+
+// Object name without the "Class::" prefix, from the quoted string at q
+static char* fbx_object_name(const char* q) {
+    const char* open = strchr(q, '"');
+    if (!open) return str_dup("");
+    const char* close = strchr(open + 1, '"');
+    if (!close) return str_dup("");
+    const char* start = open + 1;
+    for (const char* c = start; c + 1 < close; c++) {
+        if (c[0] == ':' && c[1] == ':') { start = c + 2; break; }
+    }
+    size_t n = (size_t)(close - start);
+    char* out = (char*)malloc(n + 1);
+    if (out) { memcpy(out, start, n); out[n] = '\0'; }
+    return out;
+}
+
+static FBXModelNode* fbx_find_model(FBXSceneParse* d, long long id) {
+    for (uint32_t i = 0; i < d->model_count; i++) {
+        if (d->models[i].id == id) return &d->models[i];
+    }
+    return NULL;
+}
+
+static FBXCluster* fbx_find_cluster(FBXSceneParse* d, long long id) {
+    for (uint32_t i = 0; i < d->cluster_count; i++) {
+        if (d->clusters[i].id == id) return &d->clusters[i];
+    }
+    return NULL;
+}
+
+static FBXAnimCurveNode* fbx_find_curve_node(FBXSceneParse* d, long long id) {
+    for (uint32_t i = 0; i < d->curve_node_count; i++) {
+        if (d->curve_nodes[i].id == id) return &d->curve_nodes[i];
+    }
+    return NULL;
+}
+
+static FBXAnimLayer* fbx_find_layer(FBXSceneParse* d, long long id) {
+    for (uint32_t i = 0; i < d->layer_count; i++) {
+        if (d->layers[i].id == id) return &d->layers[i];
+    }
+    return NULL;
+}
+
+static int fbx_is_curve(FBXSceneParse* d, long long id) {
+    for (uint32_t i = 0; i < d->curve_count; i++) {
+        if (d->curves[i].id == id) return 1;
+    }
+    return 0;
+}
+
+// Resolve one 'C: "OO",child,parent' or 'C: "OP",child,parent,"property"' line
+static void fbx_parse_connection(FBXSceneParse* d, const char* s, const char* line_end) {
+    int is_op = fbx_find_in_block(s, line_end, "\"OP\"") != NULL;
+    const char* c = strchr(s, ',');
+    if (!c || c > line_end) return;
+    char* e; long long child = strtoll(c + 1, &e, 10);
+    c = e; while (*c == ',' || *c == ' ') c++;
+    long long parent = strtoll(c, &e, 10);
+
+    if (is_op) {
+        FBXAnimCurveNode* node = fbx_find_curve_node(d, child);
+        if (node && fbx_find_model(d, parent)) {
+            // Curve node -> model property
+            node->model_id = parent;
+            if (fbx_find_in_block(e, line_end, "Lcl Translation")) node->channel = ANIMATION_CHANNEL_TRANSLATION;
+            else if (fbx_find_in_block(e, line_end, "Lcl Rotation")) node->channel = ANIMATION_CHANNEL_ROTATION;
+            else if (fbx_find_in_block(e, line_end, "Lcl Scaling")) node->channel = ANIMATION_CHANNEL_SCALE;
+            return;
+        }
+        node = fbx_find_curve_node(d, parent);
+        if (node && fbx_is_curve(d, child)) {
+            // Curve -> curve node axis
+            if (fbx_find_in_block(e, line_end, "d|X")) node->curves[0] = child;
+            else if (fbx_find_in_block(e, line_end, "d|Y")) node->curves[1] = child;
+            else if (fbx_find_in_block(e, line_end, "d|Z")) node->curves[2] = child;
+        }
+        return;
+    }
+
+    FBXModelNode* child_model = fbx_find_model(d, child);
+    FBXCluster* parent_cluster = fbx_find_cluster(d, parent);
+    FBXAnimCurveNode* child_node;
+    FBXAnimLayer* child_layer;
+    if (child_model && parent_cluster) {
+        parent_cluster->model_id = child;
+    } else if (child_model && fbx_find_model(d, parent)) {
+        child_model->parent_id = parent;
+    } else if ((child_node = fbx_find_curve_node(d, child)) && fbx_find_layer(d, parent)) {
+        child_node->layer_id = parent;
+    } else if ((child_layer = fbx_find_layer(d, child))) {
+        child_layer->stack_id = parent;
+    }
+}
+
+static int parse_fbx_scene(const char* text, FBXSceneParse* out) {
+    memset(out, 0, sizeof(*out));
+    static const char* kinds[] = {"Model:", "Deformer:", "AnimationStack:", "AnimationLayer:",
+                                  "AnimationCurveNode:", "AnimationCurve:"};
+    enum { KIND_MODEL, KIND_DEFORMER, KIND_STACK, KIND_LAYER, KIND_CURVE_NODE, KIND_CURVE, KIND_COUNT };
+
+    const char* p = text;
+    while (*p) {
+        const char* nl = strchr(p, '\n');
+        const char* s = p;
+        while (*s == ' ' || *s == '\t') s++;
+
+        int kind = 0;
+        while (kind < KIND_COUNT && strncmp(s, kinds[kind], strlen(kinds[kind])) != 0) kind++;
+        if (kind < KIND_COUNT) {
+            const char* id_start = s + strlen(kinds[kind]);
+            char* e; long long id = strtoll(id_start, &e, 10);
+            const char* open = strchr(e, '{');
+            const char* close = open ? fbx_block_end(open) : NULL;
+            if (e != id_start && open && close && (!nl || open < nl)) {
+                // Object type is the last quoted string before the '{'
+                const char* type = open;
+                while (type > e && *type != ',') type--;
+                int is_cluster = kind == KIND_DEFORMER && fbx_find_in_block(type, open, "\"Cluster\"") != NULL;
+
+                if (kind == KIND_MODEL) {
+                    FBXModelNode* m = (FBXModelNode*)fbx_array_push((void**)&out->models, &out->model_count,
+                                                                    &out->model_capacity, sizeof(FBXModelNode));
+                    if (!m) return 0;
+                    m->id = id;
+                    m->name = fbx_object_name(e);
+                    m->is_limb = fbx_find_in_block(type, open, "\"LimbNode\"") != NULL;
+                    m->lcl[6] = m->lcl[7] = m->lcl[8] = 1.0;
+                    m->joint = -1;
+                    fbx_parse_property(open, close, "\"Lcl Translation\"", &m->lcl[0], 3);
+                    fbx_parse_property(open, close, "\"Lcl Rotation\"", &m->lcl[3], 3);
+                    fbx_parse_property(open, close, "\"Lcl Scaling\"", &m->lcl[6], 3);
+                } else if (is_cluster) {
+                    FBXCluster* c = (FBXCluster*)fbx_array_push((void**)&out->clusters, &out->cluster_count,
+                                                                &out->cluster_capacity, sizeof(FBXCluster));
+                    if (!c) return 0;
+                    c->id = id;
+
+                    uint32_t index_count = 0, weight_count = 0, n = 0;
+                    double* indexes = fbx_parse_array(open, close, "Indexes:", &index_count);
+                    c->weights = fbx_parse_array(open, close, "Weights:", &weight_count);
+                    c->count = index_count < weight_count ? index_count : weight_count;
+                    c->indexes = (int*)malloc((c->count ? c->count : 1) * sizeof(int));
+                    for (uint32_t i = 0; c->indexes && i < c->count; i++) c->indexes[i] = (int)indexes[i];
+                    free(indexes);
+
+                    double* m = fbx_parse_array(open, close, "Transform:", &n);
+                    if (m && n == 16) { memcpy(c->transform, m, sizeof(c->transform)); c->has_transform = 1; }
+                    free(m);
+                    m = fbx_parse_array(open, close, "TransformLink:", &n);
+                    if (m && n == 16) { memcpy(c->link, m, sizeof(c->link)); c->has_link = 1; }
+                    free(m);
+                } else if (kind == KIND_STACK) {
+                    FBXAnimStack* stack = (FBXAnimStack*)fbx_array_push((void**)&out->stacks, &out->stack_count,
+                                                                        &out->stack_capacity, sizeof(FBXAnimStack));
+                    if (!stack) return 0;
+                    double ticks = 0.0;
+                    stack->id = id;
+                    stack->name = fbx_object_name(e);
+                    if (fbx_parse_property(open, close, "\"LocalStart\"", &ticks, 1)) stack->start = ticks / FBX_TICKS_PER_SECOND;
+                    if (fbx_parse_property(open, close, "\"LocalStop\"", &ticks, 1)) stack->stop = ticks / FBX_TICKS_PER_SECOND;
+                } else if (kind == KIND_LAYER) {
+                    FBXAnimLayer* layer = (FBXAnimLayer*)fbx_array_push((void**)&out->layers, &out->layer_count,
+                                                                        &out->layer_capacity, sizeof(FBXAnimLayer));
+                    if (!layer) return 0;
+                    layer->id = id;
+                } else if (kind == KIND_CURVE_NODE) {
+                    FBXAnimCurveNode* node = (FBXAnimCurveNode*)fbx_array_push((void**)&out->curve_nodes, &out->curve_node_count,
+                                                                               &out->curve_node_capacity, sizeof(FBXAnimCurveNode));
+                    if (!node) return 0;
+                    node->id = id;
+                    node->channel = -1;
+                } else if (kind == KIND_CURVE) {
+                    FBXAnimCurve* curve = (FBXAnimCurve*)fbx_array_push((void**)&out->curves, &out->curve_count,
+                                                                        &out->curve_capacity, sizeof(FBXAnimCurve));
+                    if (!curve) return 0;
+                    uint32_t time_count = 0, value_count = 0;
+                    curve->id = id;
+                    curve->times = fbx_parse_array(open, close, "KeyTime:", &time_count);
+                    curve->values = fbx_parse_array(open, close, "KeyValueFloat:", &value_count);
+                    curve->count = time_count < value_count ? time_count : value_count;
+                    for (uint32_t i = 0; i < curve->count; i++) curve->times[i] /= FBX_TICKS_PER_SECOND;
+                }
+                // Skip the object body; nothing nested is parsed separately
+                nl = strchr(close, '\n');
+            }
+        } else if (strncmp(s, "C:", 2) == 0) {
+            fbx_parse_connection(out, s, nl ? nl : s + strlen(s));
+        }
+
+        if (!nl) break;
+        p = nl + 1;
+    }
+    return 1;
+}
+
+// Row-vector FBX matrix (translation in elements 12..14) as an engine mat4
+static mat4_t fbx_matrix(const double* m) {
+    return mat4_from_vec4(vec4((float)m[0], (float)m[1], (float)m[2], (float)m[3]),
+                          vec4((float)m[4], (float)m[5], (float)m[6], (float)m[7]),
+                          vec4((float)m[8], (float)m[9], (float)m[10], (float)m[11]),
+                          vec4((float)m[12], (float)m[13], (float)m[14], (float)m[15]));
+}
+
+// Scale * rotation * translation from Lcl properties (pivots and pre-rotation are ignored)
+static mat4_t fbx_local_matrix(const FBXModelNode* m) {
+    const float deg = 3.14159265358979f / 180.0f;
+    quat_t r = quat_from_euler((float)m->lcl[3] * deg, (float)m->lcl[4] * deg, (float)m->lcl[5] * deg);
+    mat4_t local = mat4_mul_mat4(mat4_scale(vec3((float)m->lcl[6], (float)m->lcl[7], (float)m->lcl[8])), quat_to_mat4(r));
+    local.w = vec4((float)m->lcl[0], (float)m->lcl[1], (float)m->lcl[2], 1.0f);
+    return local;
+}
+
+static Skeleton* build_skeleton_from_parsed(FBXSceneParse* d, char** out_error) {
+    // Joints: LimbNode models plus any model driven by a cluster
+    for (uint32_t i = 0; i < d->cluster_count; i++) {
+        FBXModelNode* m = fbx_find_model(d, d->clusters[i].model_id);
+        if (m) m->is_limb = 1;
+    }
+
+    // Order joints so that parents precede children
+    uint32_t joint_count = 0;
+    for (uint32_t i = 0; i < d->model_count; i++) {
+        if (d->models[i].is_limb) joint_count++;
+    }
+    if (joint_count == 0 || joint_count > SKIN_MAX_JOINTS) {
+        if (out_error) *out_error = str_dup(joint_count ? "FBX skeleton has too many joints" : "FBX file has no skeleton joints");
+        return NULL;
+    }
+
+    FBXModelNode** order = (FBXModelNode**)malloc(joint_count * sizeof(FBXModelNode*));
+    if (!order) {
+        if (out_error) *out_error = str_dup("Out of memory");
+        return NULL;
+    }
+    uint32_t placed = 0;
+    while (placed < joint_count) {
+        uint32_t before = placed;
+        for (uint32_t i = 0; i < d->model_count; i++) {
+            FBXModelNode* m = &d->models[i];
+            if (!m->is_limb || m->joint >= 0) continue;
+            FBXModelNode* parent = fbx_find_model(d, m->parent_id);
+            if (parent && parent->is_limb && parent->joint < 0) continue;
+            m->joint = (int32_t)placed;
+            order[placed++] = m;
+        }
+        if (placed == before) {
+            free(order);
+            if (out_error) *out_error = str_dup("FBX joint hierarchy contains a cycle");
+            return NULL;
+        }
+    }
+
+    Skeleton* skeleton = skeleton_create(joint_count);
+    mat4_t* global = (mat4_t*)malloc(joint_count * sizeof(mat4_t));
+    if (!skeleton || !global) {
+        skeleton_destroy(skeleton);
+        free(global);
+        free(order);
+        if (out_error) *out_error = str_dup("Out of memory");
+        return NULL;
+    }
+
+    for (uint32_t j = 0; j < joint_count; j++) {
+        FBXModelNode* m = order[j];
+        FBXModelNode* parent = fbx_find_model(d, m->parent_id);
+        skeleton->names[j] = str_dup(m->name);
+        skeleton->parents[j] = (parent && parent->is_limb) ? parent->joint : -1;
+
+        global[j] = fbx_local_matrix(m);
+        if (skeleton->parents[j] >= 0) {
+            global[j] = mat4_mul_mat4(global[j], global[skeleton->parents[j]]);
+        }
+        // The cluster's TransformLink is authoritative for the bind pose
+        for (uint32_t c = 0; c < d->cluster_count; c++) {
+            if (d->clusters[c].model_id == m->id && d->clusters[c].has_link) {
+                global[j] = fbx_matrix(d->clusters[c].link);
+                break;
+            }
+        }
+    }
+    skeleton_set_bind_matrices(skeleton, global);
+
+    // Mesh space -> joint space: Transform (mesh to world) * inverse(TransformLink)
+    for (uint32_t c = 0; c < d->cluster_count; c++) {
+        FBXCluster* cluster = &d->clusters[c];
+        FBXModelNode* m = fbx_find_model(d, cluster->model_id);
+        if (!m || !cluster->has_transform) continue;
+        skeleton->inverse_bind[m->joint] = mat4_mul_mat4(fbx_matrix(cluster->transform), mat4_inverse(global[m->joint]));
+    }
+
+    free(global);
+    free(order);
+    return skeleton;
+}
+
+static SkinData* build_skin_from_parsed(const FBXSceneParse* d, const uint32_t* control_points, uint32_t vertex_count,
+                                        uint32_t control_point_count, const Skeleton* skeleton) {
+    uint32_t* joints = (uint32_t*)calloc((size_t)control_point_count * FBX_MAX_CONTROL_POINT_INFLUENCES, sizeof(uint32_t));
+    float* weights = (float*)calloc((size_t)control_point_count * FBX_MAX_CONTROL_POINT_INFLUENCES, sizeof(float));
+    SkinData* skin = skin_data_create(vertex_count);
+    if (!joints || !weights || !skin) {
+        free(joints);
+        free(weights);
+        skin_data_destroy(skin);
+        return NULL;
+    }
+
+    // Gather influences per control point, keeping the strongest when full
+    for (uint32_t c = 0; c < d->cluster_count; c++) {
+        const FBXCluster* cluster = &d->clusters[c];
+        int32_t joint = -1;
+        for (uint32_t i = 0; i < d->model_count; i++) {
+            if (d->models[i].id == cluster->model_id) { joint = d->models[i].joint; break; }
+        }
+        if (joint < 0 || (uint32_t)joint >= skeleton->joint_count) continue;
+
+        for (uint32_t i = 0; i < cluster->count; i++) {
+            int cp = cluster->indexes[i];
+            float w = (float)cluster->weights[i];
+            if (cp < 0 || (uint32_t)cp >= control_point_count || !(w > 0.0f)) continue;
+            uint32_t* cj = &joints[(size_t)cp * FBX_MAX_CONTROL_POINT_INFLUENCES];
+            float* cw = &weights[(size_t)cp * FBX_MAX_CONTROL_POINT_INFLUENCES];
+            int weakest = 0;
+            for (int k = 1; k < FBX_MAX_CONTROL_POINT_INFLUENCES; k++) {
+                if (cw[k] < cw[weakest]) weakest = k;
+            }
+            if (w > cw[weakest]) { cw[weakest] = w; cj[weakest] = (uint32_t)joint; }
+        }
+    }
+
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        uint32_t cp = control_points[v];
+        if (cp >= control_point_count) continue;
+        skin_data_set_vertex(skin, v, &joints[(size_t)cp * FBX_MAX_CONTROL_POINT_INFLUENCES],
+                             &weights[(size_t)cp * FBX_MAX_CONTROL_POINT_INFLUENCES], FBX_MAX_CONTROL_POINT_INFLUENCES);
+    }
+
+    free(joints);
+    free(weights);
+    return skin;
+}
+
+Model3D* fbx_load_skinned_model(const char* filepath, Skeleton** out_skeleton, SkinData** out_skin, char** out_error) {
+    fprintf(stderr, "=== FBX LOAD SKINNED MODEL START ===\n");
+    fprintf(stderr, "Loading FBX file: %s\n", filepath);
+    if (out_skeleton) *out_skeleton = NULL;
+    if (out_skin) *out_skin = NULL;
+    if (!out_skeleton || !out_skin) {
+        if (out_error) *out_error = str_dup("fbx_load_skinned_model requires skeleton and skin outputs");
+        return NULL;
+    }
+
+    char* buf = fbx_read_ascii_file(filepath, out_error);
+    if (!buf) {
+        return NULL;
+    }
+
+    FBXParseData parsed; memset(&parsed, 0, sizeof(parsed));
+    FBXSceneParse skin_parsed; memset(&skin_parsed, 0, sizeof(skin_parsed));
+    if (!parse_fbx_ascii(buf, &parsed, out_error)) {
+        free(buf);
+        fbx_parse_data_free(&parsed);
+        return NULL;
+    }
+    if (!parse_fbx_scene(buf, &skin_parsed) || skin_parsed.cluster_count == 0) {
+        if (out_error && !*out_error) *out_error = str_dup("FBX file has no skin clusters");
+        free(buf);
+        fbx_parse_data_free(&parsed);
+        fbx_scene_parse_free(&skin_parsed);
+        return NULL;
+    }
+    free(buf);
+    fprintf(stderr, "Found %u models and %u skin clusters\n", skin_parsed.model_count, skin_parsed.cluster_count);
+
+    uint32_t* control_points = NULL;
+    Model3D* model = build_model_from_parsed(&parsed, &control_points);
+    Skeleton* skeleton = model ? build_skeleton_from_parsed(&skin_parsed, out_error) : NULL;
+    SkinData* skin = NULL;
+    if (skeleton) {
+        skin = build_skin_from_parsed(&skin_parsed, control_points, model->meshes[0].vertex_count,
+                                      parsed.positions_count / 3, skeleton);
+    }
+    free(control_points);
+    fbx_parse_data_free(&parsed);
+    fbx_scene_parse_free(&skin_parsed);
+
+    if (!model || !skeleton || !skin) {
+        if (out_error && !*out_error) *out_error = str_dup("Failed to build skinned model from parsed data");
+        model3d_free(model);
+        free(model);
+        skeleton_destroy(skeleton);
+        skin_data_destroy(skin);
+        return NULL;
+    }
+
+    fprintf(stderr, "Skinned model: %u vertices, %u joints\n", skin->vertex_count, skeleton->joint_count);
+    fprintf(stderr, "=== FBX LOAD SKINNED MODEL END ===\n");
+    *out_skeleton = skeleton;
+    *out_skin = skin;
+    return model;
+}
+
+// ============================================================================
+// ANIMATION CLIPS (AnimationStack / AnimationLayer / AnimationCurveNode / AnimationCurve)
+// ============================================================================
+
+// Linear evaluation of a curve at time (seconds), clamped to its end keys.
+// Keys are resampled densely afterwards, so cubic tangents are not evaluated.
+static double fbx_evaluate_curve(const FBXAnimCurve* curve, double time, double fallback) {
+    if (!curve || curve->count == 0) return fallback;
+    if (time <= curve->times[0]) return curve->values[0];
+    if (time >= curve->times[curve->count - 1]) return curve->values[curve->count - 1];
+    uint32_t lo = 0, hi = curve->count - 1;
+    while (hi - lo > 1) {
+        uint32_t mid = (lo + hi) / 2;
+        if (curve->times[mid] <= time) lo = mid; else hi = mid;
+    }
+    double span = curve->times[hi] - curve->times[lo];
+    double t = span > 0.0 ? (time - curve->times[lo]) / span : 0.0;
+    return curve->values[lo] + (curve->values[hi] - curve->values[lo]) * t;
+}
+
+static const FBXAnimCurve* fbx_get_curve(const FBXSceneParse* d, long long id) {
+    if (id == 0) return NULL;
+    for (uint32_t i = 0; i < d->curve_count; i++) {
+        if (d->curves[i].id == id) return &d->curves[i];
+    }
+    return NULL;
+}
+
+// Resample the base layer of a stack into a raw clip with one track per animated model
+static RawAnimationClip* build_clip_from_stack(const FBXSceneParse* d, const FBXAnimStack* stack, float sample_rate) {
+    const FBXAnimLayer* layer = NULL;
+    for (uint32_t i = 0; i < d->layer_count && !layer; i++) {
+        if (d->layers[i].stack_id == stack->id) layer = &d->layers[i];
+    }
+    if (!layer) return NULL;
+
+    // Animated models of this layer and the time span their curves cover
+    uint32_t* model_indices = (uint32_t*)malloc((d->model_count ? d->model_count : 1) * sizeof(uint32_t));
+    uint32_t track_count = 0;
+    double max_time = 0.0;
+    for (uint32_t m = 0; model_indices && m < d->model_count; m++) {
+        int animated = 0;
+        for (uint32_t n = 0; n < d->curve_node_count; n++) {
+            const FBXAnimCurveNode* node = &d->curve_nodes[n];
+            if (node->layer_id != layer->id || node->model_id != d->models[m].id || node->channel < 0) continue;
+            animated = 1;
+            for (int axis = 0; axis < 3; axis++) {
+                const FBXAnimCurve* curve = fbx_get_curve(d, node->curves[axis]);
+                if (curve && curve->count > 0 && curve->times[curve->count - 1] > max_time) {
+                    max_time = curve->times[curve->count - 1];
+                }
+            }
+        }
+        if (animated) model_indices[track_count++] = m;
+    }
+    if (!model_indices || track_count == 0) {
+        free(model_indices);
+        return NULL;
+    }
+
+    double start = stack->start;
+    double duration = (stack->stop > stack->start ? stack->stop : max_time) - start;
+    if (duration < 0.0) duration = 0.0;
+    double frames = duration * sample_rate + 1.5;
+    uint32_t frame_count = frames > (double)ANIMATION_MAX_FRAMES ? ANIMATION_MAX_FRAMES : (uint32_t)frames;
+
+    RawAnimationClip* clip = raw_animation_clip_create(stack->name, track_count, frame_count, sample_rate);
+    if (!clip) {
+        free(model_indices);
+        return NULL;
+    }
+
+    const double deg = 3.14159265358979323846 / 180.0;
+    for (uint32_t t = 0; t < track_count; t++) {
+        const FBXModelNode* model = &d->models[model_indices[t]];
+        RawAnimationTrack* track = &clip->tracks[t];
+        track->joint_name = str_dup(model->name);
+
+        // Curves per channel/axis; missing axes hold the model's Lcl value
+        const FBXAnimCurve* curves[3][3] = {{NULL}};
+        for (uint32_t n = 0; n < d->curve_node_count; n++) {
+            const FBXAnimCurveNode* node = &d->curve_nodes[n];
+            if (node->layer_id != layer->id || node->model_id != model->id || node->channel < 0) continue;
+            for (int axis = 0; axis < 3; axis++) curves[node->channel][axis] = fbx_get_curve(d, node->curves[axis]);
+        }
+
+        for (uint32_t f = 0; f < frame_count; f++) {
+            double time = start + (double)f / sample_rate;
+            double v[3][3];
+            for (int channel = 0; channel < 3; channel++) {
+                for (int axis = 0; axis < 3; axis++) {
+                    v[channel][axis] = fbx_evaluate_curve(curves[channel][axis], time, model->lcl[channel * 3 + axis]);
+                }
+            }
+            track->translations[f] = vec3((float)v[0][0], (float)v[0][1], (float)v[0][2]);
+            quat_t r = quat_from_euler((float)(v[1][0] * deg), (float)(v[1][1] * deg), (float)(v[1][2] * deg));
+            // Keep consecutive keys in the same hemisphere so interpolation takes the short arc
+            if (f > 0 && quat_dot(r, track->rotations[f - 1]) < 0.0f) r = quat_neg(r);
+            track->rotations[f] = r;
+            track->scales[f] = vec3((float)v[2][0], (float)v[2][1], (float)v[2][2]);
+        }
+    }
+
+    free(model_indices);
+    return clip;
+}
+
+RawAnimationClip** fbx_load_animation_clips(const char* filepath, uint32_t* out_count, char** out_error) {
+    fprintf(stderr, "=== FBX LOAD ANIMATION CLIPS START ===\n");
+    fprintf(stderr, "Loading FBX file: %s\n", filepath);
+    if (out_count) *out_count = 0;
+
+    char* buf = fbx_read_ascii_file(filepath, out_error);
+    if (!buf) {
+        return NULL;
+    }
+
+    FBXSceneParse scene;
+    int parsed = parse_fbx_scene(buf, &scene);
+    free(buf);
+    if (!parsed || scene.stack_count == 0) {
+        if (out_error) *out_error = str_dup(parsed ? "FBX file has no animation stacks" : "Out of memory");
+        fbx_scene_parse_free(&scene);
+        return NULL;
+    }
+    fprintf(stderr, "Found %u stacks, %u layers, %u curve nodes, %u curves\n",
+            scene.stack_count, scene.layer_count, scene.curve_node_count, scene.curve_count);
+
+    RawAnimationClip** clips = (RawAnimationClip**)calloc(scene.stack_count, sizeof(RawAnimationClip*));
+    uint32_t count = 0;
+    for (uint32_t i = 0; clips && i < scene.stack_count; i++) {
+        RawAnimationClip* clip = build_clip_from_stack(&scene, &scene.stacks[i], ANIMATION_DEFAULT_SAMPLE_RATE);
+        if (clip) {
+            fprintf(stderr, "Clip \"%s\": %u tracks, %u frames\n", clip->name, clip->track_count, clip->frame_count);
+            clips[count++] = clip;
+        }
+    }
+    fbx_scene_parse_free(&scene);
+
+    if (count == 0) {
+        if (out_error) *out_error = str_dup("FBX animation stacks contain no animated models");
+        free(clips);
+        return NULL;
+    }
+
+    fprintf(stderr, "=== FBX LOAD ANIMATION CLIPS END ===\n");
+    if (out_count) *out_count = count;
+    return clips;
+}
+
+void fbx_free_animation_clips(RawAnimationClip** clips, uint32_t count) {
+    if (!clips) return;
+    for (uint32_t i = 0; i < count; i++) raw_animation_clip_destroy(clips[i]);
+    free(clips);
+}
+
 void fbx_free_error(char* err) { if (err) free(err); }
 
 
@@ -7,12 +7,28 @@ extern "C" {
 
 #include <stdint.h>
 #include "engine_model.h"
+#include "engine_skinning.h"
+#include "engine_animation.h"
 
 // Load an FBX file (ASCII or Binary) into a Model3D.
 // Returns a heap-allocated Model3D* on success; NULL on failure.
 // On failure, if out_error is non-NULL, it will receive a heap-allocated error message that the caller must free.
 Model3D* fbx_load_model(const char* filepath, char** out_error);
 
+// Load an ASCII FBX mesh together with its skin: LimbNode models become the
+// Skeleton (bind pose from each Cluster's TransformLink) and Cluster
+// Indexes/Weights become per-vertex SkinData (top 4, quantized).
+// On success *out_skeleton and *out_skin are heap-allocated and owned by the caller.
+Model3D* fbx_load_skinned_model(const char* filepath, Skeleton** out_skeleton, SkinData** out_skin, char** out_error);
+
+// Load every AnimationStack of an ASCII FBX as a raw clip resampled at
+// ANIMATION_DEFAULT_SAMPLE_RATE (base layer only; one track per animated
+// model, named after it). Returns a heap array of *out_count clips.
+RawAnimationClip** fbx_load_animation_clips(const char* filepath, uint32_t* out_count, char** out_error);
+
+// Free clips returned by fbx_load_animation_clips
+void fbx_free_animation_clips(RawAnimationClip** clips, uint32_t count);
+
 // Convenience: free error strings returned by fbx_load_model
 void fbx_free_error(char* err);
 
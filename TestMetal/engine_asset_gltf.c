@@ -0,0 +1,1061 @@
+#include "engine_asset_gltf.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <float.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define GLTF_NONE 0xFFFFFFFFu
+
+// ============================================================================
+// JSON TOKENIZER
+// ============================================================================
+
+// Append a token (or just count it when tokens is NULL)
+static int gltf_json_push(GltfJsonToken* tokens, uint32_t max_tokens, uint32_t* count, uint32_t type,
+                          uint32_t start, uint32_t end) {
+    if (tokens) {
+        if (*count >= max_tokens) {
+            return 0;
+        }
+        GltfJsonToken* token = &tokens[*count];
+        token->type = type;
+        token->start = start;
+        token->end = end;
+        token->size = 0;
+        token->next = *count + 1;
+    }
+    (*count)++;
+    return 1;
+}
+
+int32_t gltf_json_tokenize(const char* json, size_t length, GltfJsonToken* tokens, uint32_t max_tokens) {
+    uint32_t stack[GLTF_JSON_MAX_DEPTH];        // Open containers: token index
+    uint8_t stack_type[GLTF_JSON_MAX_DEPTH];
+    uint32_t depth = 0;
+    uint32_t count = 0;
+    int expect_key = 0;                         // Next string in the open object is a member name
+    int expect_value = 0;                       // A member name was read, its value was not
+
+    if (!json || length >= 0x7FFFFFFFu) {
+        return GLTF_JSON_ERROR_INVALID;
+    }
+
+    for (uint32_t i = 0; i < (uint32_t)length; i++) {
+        char c = json[i];
+        uint32_t parent = depth > 0 ? stack[depth - 1] : GLTF_NONE;
+        uint8_t parent_type = depth > 0 ? stack_type[depth - 1] : 0;
+
+        switch (c) {
+        case ' ': case '\t': case '\r': case '\n':
+            break;
+
+        case '{': case '[': {
+            if (depth >= GLTF_JSON_MAX_DEPTH || expect_key) {
+                return GLTF_JSON_ERROR_INVALID;
+            }
+            uint32_t type = c == '{' ? GLTF_JSON_OBJECT : GLTF_JSON_ARRAY;
+            if (!gltf_json_push(tokens, max_tokens, &count, type, i, i)) {
+                return GLTF_JSON_ERROR_NO_MEMORY;
+            }
+            if (tokens && parent_type == GLTF_JSON_ARRAY) {
+                tokens[parent].size++;
+            }
+            stack[depth] = count - 1;
+            stack_type[depth] = (uint8_t)type;
+            depth++;
+            expect_key = type == GLTF_JSON_OBJECT;
+            expect_value = 0;
+            break;
+        }
+
+        case '}': case ']': {
+            uint8_t type = c == '}' ? GLTF_JSON_OBJECT : GLTF_JSON_ARRAY;
+            if (depth == 0 || parent_type != type || expect_value) {
+                return GLTF_JSON_ERROR_INVALID;
+            }
+            if (tokens) {
+                tokens[parent].end = i + 1;
+                tokens[parent].next = count;
+            }
+            depth--;
+            expect_key = 0;
+            break;
+        }
+
+        case ':':
+            if (parent_type != GLTF_JSON_OBJECT) {
+                return GLTF_JSON_ERROR_INVALID;
+            }
+            break;
+
+        case ',':
+            if (depth == 0 || expect_value) {
+                return GLTF_JSON_ERROR_INVALID;
+            }
+            expect_key = parent_type == GLTF_JSON_OBJECT;
+            break;
+
+        case '"': {
+            uint32_t start = i + 1;
+            for (i = start; i < (uint32_t)length && json[i] != '"'; i++) {
+                if (json[i] == '\\') {
+                    i++;                        // Skip the escaped character
+                }
+            }
+            if (i >= (uint32_t)length) {
+                return GLTF_JSON_ERROR_INVALID;
+            }
+            if (!gltf_json_push(tokens, max_tokens, &count, GLTF_JSON_STRING, start, i)) {
+                return GLTF_JSON_ERROR_NO_MEMORY;
+            }
+            if (tokens && (parent_type == GLTF_JSON_ARRAY || expect_key)) {
+                tokens[parent].size++;
+            }
+            expect_value = expect_key;
+            expect_key = 0;
+            break;
+        }
+
+        default: {
+            if (expect_key) {
+                return GLTF_JSON_ERROR_INVALID;
+            }
+            uint32_t start = i;
+            while (i < (uint32_t)length && json[i] != ',' && json[i] != ']' && json[i] != '}' && json[i] != ':' &&
+                   json[i] != ' ' && json[i] != '\t' && json[i] != '\r' && json[i] != '\n') {
+                if ((unsigned char)json[i] < 32 || json[i] == '"' || json[i] == '{' || json[i] == '[') {
+                    return GLTF_JSON_ERROR_INVALID;
+                }
+                i++;
+            }
+            if (!gltf_json_push(tokens, max_tokens, &count, GLTF_JSON_PRIMITIVE, start, i)) {
+                return GLTF_JSON_ERROR_NO_MEMORY;
+            }
+            if (tokens && parent_type == GLTF_JSON_ARRAY) {
+                tokens[parent].size++;
+            }
+            expect_value = 0;
+            i--;                                // Reprocess the delimiter
+            break;
+        }
+        }
+    }
+
+    return depth == 0 ? (int32_t)count : GLTF_JSON_ERROR_INVALID;
+}
+
+// ============================================================================
+// JSON ACCESS
+// ============================================================================
+
+typedef struct {
+    const char* text;
+    const GltfJsonToken* tokens;
+    uint32_t count;
+} GltfJson;
+
+static int gltf_json_equals(const GltfJson* json, uint32_t token, const char* s) {
+    const GltfJsonToken* t = &json->tokens[token];
+    size_t n = strlen(s);
+    return t->type == GLTF_JSON_STRING && t->end - t->start == n && memcmp(json->text + t->start, s, n) == 0;
+}
+
+// Value of an object member, or GLTF_NONE
+static uint32_t gltf_json_member(const GltfJson* json, uint32_t object, const char* key) {
+    if (object == GLTF_NONE || json->tokens[object].type != GLTF_JSON_OBJECT) {
+        return GLTF_NONE;
+    }
+    uint32_t token = object + 1;
+    for (uint32_t m = 0; m < json->tokens[object].size && token + 1 < json->count; m++) {
+        if (gltf_json_equals(json, token, key)) {
+            return token + 1;
+        }
+        token = json->tokens[token + 1].next;
+    }
+    return GLTF_NONE;
+}
+
+// First element of an array; step with tokens[element].next
+static uint32_t gltf_json_first(const GltfJson* json, uint32_t array) {
+    return array != GLTF_NONE && json->tokens[array].type == GLTF_JSON_ARRAY && json->tokens[array].size > 0 ?
+           array + 1 : GLTF_NONE;
+}
+
+static uint32_t gltf_json_array_size(const GltfJson* json, uint32_t array) {
+    return array != GLTF_NONE && json->tokens[array].type == GLTF_JSON_ARRAY ? json->tokens[array].size : 0;
+}
+
+static double gltf_json_number(const GltfJson* json, uint32_t token, double fallback) {
+    if (token == GLTF_NONE || json->tokens[token].type != GLTF_JSON_PRIMITIVE) {
+        return fallback;
+    }
+    // Tokens are not NUL-terminated (the GLB JSON chunk is not a C string)
+    char buffer[64];
+    uint32_t length = json->tokens[token].end - json->tokens[token].start;
+    if (length == 0 || length >= sizeof(buffer)) {
+        return fallback;
+    }
+    memcpy(buffer, json->text + json->tokens[token].start, length);
+    buffer[length] = '\0';
+    char* end;
+    double value = strtod(buffer, &end);
+    return end == buffer + length ? value : fallback;
+}
+
+static uint64_t gltf_json_member_uint(const GltfJson* json, uint32_t object, const char* key, uint64_t fallback) {
+    double value = gltf_json_number(json, gltf_json_member(json, object, key), -1.0);
+    return value >= 0.0 && value < 1.8e19 ? (uint64_t)value : fallback;
+}
+
+// Array index or enum value, GLTF_NONE unless the number is an integer in
+// [0, GLTF_NONE) (range-checked before the cast, which is undefined otherwise)
+static uint32_t gltf_json_index(const GltfJson* json, uint32_t token) {
+    double value = gltf_json_number(json, token, -1.0);
+    if (!(value >= 0.0 && value < (double)GLTF_NONE)) {
+        return GLTF_NONE;
+    }
+    uint32_t index = (uint32_t)value;
+    return (double)index == value ? index : GLTF_NONE;
+}
+
+static uint32_t gltf_json_member_index(const GltfJson* json, uint32_t object, const char* key) {
+    return gltf_json_index(json, gltf_json_member(json, object, key));
+}
+
+// ============================================================================
+// ERRORS
+// ============================================================================
+
+static void gltf_error(char** out_error, const char* format, ...) {
+    char message[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    fprintf(stderr, "Error: %s\n", message);
+    if (out_error && !*out_error) {
+        size_t n = strlen(message) + 1;
+        *out_error = (char*)malloc(n);
+        if (*out_error) {
+            memcpy(*out_error, message, n);
+        }
+    }
+}
+
+void gltf_free_error(char* err) {
+    free(err);
+}
+
+// ============================================================================
+// SOURCE DATA
+// ============================================================================
+
+// A mapped file or a decoded buffer that meshes may point into
+typedef struct {
+    void* data;
+    size_t size;
+    int mapped;
+} GltfBlock;
+
+// Everything a loaded model may borrow from, released by model3d_free
+typedef struct {
+    GltfBlock* blocks;
+    uint32_t count;
+    uint32_t capacity;
+} GltfSource;
+
+static void gltf_source_release(void* source) {
+    GltfSource* s = (GltfSource*)source;
+    if (!s) {
+        return;
+    }
+    for (uint32_t i = 0; i < s->count; i++) {
+        if (s->blocks[i].mapped) {
+            munmap(s->blocks[i].data, s->blocks[i].size);
+        } else {
+            free(s->blocks[i].data);
+        }
+    }
+    free(s->blocks);
+    free(s);
+}
+
+static GltfBlock* gltf_source_add(GltfSource* source) {
+    if (source->count == source->capacity) {
+        uint32_t capacity = source->capacity ? source->capacity * 2 : 4;
+        GltfBlock* blocks = (GltfBlock*)realloc(source->blocks, capacity * sizeof(GltfBlock));
+        if (!blocks) {
+            return NULL;
+        }
+        source->blocks = blocks;
+        source->capacity = capacity;
+    }
+    GltfBlock* block = &source->blocks[source->count++];
+    memset(block, 0, sizeof(*block));
+    return block;
+}
+
+// Map a whole file copy-on-write, so callers may still edit borrowed vertices
+static const uint8_t* gltf_map_file(GltfSource* source, const char* path, size_t* out_size, char** out_error) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        gltf_error(out_error, "Failed to open glTF file: %s", path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        gltf_error(out_error, "Empty or unreadable glTF file: %s", path);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        gltf_error(out_error, "Failed to map glTF file: %s", path);
+        return NULL;
+    }
+
+    GltfBlock* block = gltf_source_add(source);
+    if (!block) {
+        munmap(mapping, size);
+        gltf_error(out_error, "Failed to allocate memory for glTF source");
+        return NULL;
+    }
+    block->data = mapping;
+    block->size = size;
+    block->mapped = 1;
+    *out_size = size;
+    return (const uint8_t*)mapping;
+}
+
+static int gltf_base64_value(char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+// Decode base64 text into a new block; stops at padding
+static const uint8_t* gltf_decode_base64(GltfSource* source, const char* text, uint32_t length, size_t* out_size) {
+    uint8_t* data = (uint8_t*)malloc(length / 4 * 3 + 3);
+    GltfBlock* block = data ? gltf_source_add(source) : NULL;
+    if (!block) {
+        free(data);
+        return NULL;
+    }
+
+    size_t size = 0;
+    uint32_t bits = 0;
+    uint32_t bit_count = 0;
+    for (uint32_t i = 0; i < length && text[i] != '='; i++) {
+        int value = gltf_base64_value(text[i]);
+        if (value < 0) {
+            continue;
+        }
+        bits = (bits << 6) | (uint32_t)value;
+        bit_count += 6;
+        if (bit_count >= 8) {
+            bit_count -= 8;
+            data[size++] = (uint8_t)(bits >> bit_count);
+        }
+    }
+    block->data = data;
+    block->size = size;
+    *out_size = size;
+    return data;
+}
+
+// ============================================================================
+// DOCUMENT
+// ============================================================================
+
+typedef struct {
+    const uint8_t* data;
+    uint64_t size;
+} GltfBuffer;
+
+typedef struct {
+    uint32_t buffer;
+    uint64_t offset;
+    uint64_t length;
+    uint32_t stride;                // 0: tightly packed
+} GltfBufferView;
+
+typedef struct {
+    uint32_t view;                  // GLTF_NONE: all zeros
+    uint64_t offset;
+    uint32_t component_type;
+    uint32_t component_size;
+    uint32_t components;            // 0 for matrix types
+    uint32_t count;
+    int normalized;
+    int sparse;
+} GltfAccessor;
+
+typedef struct {
+    GltfJson json;
+    uint32_t root;
+    GltfBuffer* buffers;
+    uint32_t buffer_count;
+    GltfBufferView* views;
+    uint32_t view_count;
+    GltfAccessor* accessors;
+    uint32_t accessor_count;
+    GltfSource* source;
+    GltfLoadStats stats;
+} GltfDocument;
+
+static uint32_t gltf_component_size(uint32_t component_type) {
+    switch (component_type) {
+    case GLTF_COMPONENT_BYTE:
+    case GLTF_COMPONENT_UNSIGNED_BYTE: return 1;
+    case GLTF_COMPONENT_SHORT:
+    case GLTF_COMPONENT_UNSIGNED_SHORT: return 2;
+    case GLTF_COMPONENT_UNSIGNED_INT:
+    case GLTF_COMPONENT_FLOAT: return 4;
+    default: return 0;
+    }
+}
+
+static uint32_t gltf_type_components(const GltfJson* json, uint32_t token) {
+    if (token == GLTF_NONE) return 0;
+    if (gltf_json_equals(json, token, "SCALAR")) return 1;
+    if (gltf_json_equals(json, token, "VEC2")) return 2;
+    if (gltf_json_equals(json, token, "VEC3")) return 3;
+    if (gltf_json_equals(json, token, "VEC4")) return 4;
+    return 0;
+}
+
+static int gltf_parse_buffers(GltfDocument* doc, const char* directory, const uint8_t* glb_bin, uint64_t glb_bin_size,
+                              char** out_error) {
+    const GltfJson* json = &doc->json;
+    uint32_t array = gltf_json_member(json, doc->root, "buffers");
+    doc->buffer_count = gltf_json_array_size(json, array);
+    doc->buffers = (GltfBuffer*)calloc(doc->buffer_count ? doc->buffer_count : 1, sizeof(GltfBuffer));
+    if (!doc->buffers) {
+        gltf_error(out_error, "Failed to allocate memory for glTF buffers");
+        return 0;
+    }
+
+    uint32_t object = gltf_json_first(json, array);
+    for (uint32_t i = 0; i < doc->buffer_count; i++, object = json->tokens[object].next) {
+        uint64_t length = gltf_json_member_uint(json, object, "byteLength", 0);
+        uint32_t uri = gltf_json_member(json, object, "uri");
+        const uint8_t* data = NULL;
+        size_t size = 0;
+
+        if (uri == GLTF_NONE) {
+            if (i != 0 || !glb_bin) {
+                gltf_error(out_error, "glTF buffer %u has no uri and no GLB binary chunk", i);
+                return 0;
+            }
+            data = glb_bin;
+            size = glb_bin_size;
+        } else if (json->tokens[uri].type == GLTF_JSON_STRING) {
+            const char* text = json->text + json->tokens[uri].start;
+            uint32_t text_length = json->tokens[uri].end - json->tokens[uri].start;
+            const char* comma = (const char*)memchr(text, ',', text_length);
+            if (text_length > 5 && memcmp(text, "data:", 5) == 0) {
+                if (!comma || comma - text < 7 || memcmp(comma - 7, ";base64", 7) != 0) {
+                    gltf_error(out_error, "glTF buffer %u: only base64 data URIs are supported", i);
+                    return 0;
+                }
+                uint32_t offset = (uint32_t)(comma + 1 - text);
+                data = gltf_decode_base64(doc->source, comma + 1, text_length - offset, &size);
+                if (!data) {
+                    gltf_error(out_error, "Failed to allocate memory for glTF buffer %u", i);
+                    return 0;
+                }
+            } else {
+                char path[1024];
+                int n = snprintf(path, sizeof(path), "%s%.*s", directory, (int)text_length, text);
+                if (n < 0 || (size_t)n >= sizeof(path)) {
+                    gltf_error(out_error, "glTF buffer %u: path too long", i);
+                    return 0;
+                }
+                data = gltf_map_file(doc->source, path, &size, out_error);
+                if (!data) {
+                    return 0;
+                }
+                doc->stats.file_bytes += size;
+            }
+        }
+
+        if (!data || length > size) {
+            gltf_error(out_error, "glTF buffer %u is shorter than its byteLength %llu", i, (unsigned long long)length);
+            return 0;
+        }
+        doc->buffers[i].data = data;
+        doc->buffers[i].size = length;
+    }
+    return 1;
+}
+
+static int gltf_parse_views(GltfDocument* doc, char** out_error) {
+    const GltfJson* json = &doc->json;
+    uint32_t array = gltf_json_member(json, doc->root, "bufferViews");
+    doc->view_count = gltf_json_array_size(json, array);
+    doc->views = (GltfBufferView*)calloc(doc->view_count ? doc->view_count : 1, sizeof(GltfBufferView));
+    if (!doc->views) {
+        gltf_error(out_error, "Failed to allocate memory for glTF buffer views");
+        return 0;
+    }
+
+    uint32_t object = gltf_json_first(json, array);
+    for (uint32_t i = 0; i < doc->view_count; i++, object = json->tokens[object].next) {
+        GltfBufferView* view = &doc->views[i];
+        view->buffer = gltf_json_member_index(json, object, "buffer");
+        view->offset = gltf_json_member_uint(json, object, "byteOffset", 0);
+        view->length = gltf_json_member_uint(json, object, "byteLength", 0);
+        view->stride = 0;
+        if (gltf_json_member(json, object, "byteStride") != GLTF_NONE) {
+            // The spec allows 4..252 in steps of 4
+            uint64_t stride = gltf_json_member_uint(json, object, "byteStride", 0);
+            if (stride < 4 || stride > 252 || stride % 4 != 0) {
+                gltf_error(out_error, "glTF buffer view %u has an invalid byteStride", i);
+                return 0;
+            }
+            view->stride = (uint32_t)stride;
+        }
+        if (view->buffer >= doc->buffer_count || view->offset > doc->buffers[view->buffer].size ||
+            view->length > doc->buffers[view->buffer].size - view->offset) {
+            gltf_error(out_error, "glTF buffer view %u is outside its buffer", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int gltf_parse_accessors(GltfDocument* doc, char** out_error) {
+    const GltfJson* json = &doc->json;
+    uint32_t array = gltf_json_member(json, doc->root, "accessors");
+    doc->accessor_count = gltf_json_array_size(json, array);
+    doc->accessors = (GltfAccessor*)calloc(doc->accessor_count ? doc->accessor_count : 1, sizeof(GltfAccessor));
+    if (!doc->accessors) {
+        gltf_error(out_error, "Failed to allocate memory for glTF accessors");
+        return 0;
+    }
+
+    uint32_t object = gltf_json_first(json, array);
+    for (uint32_t i = 0; i < doc->accessor_count; i++, object = json->tokens[object].next) {
+        GltfAccessor* accessor = &doc->accessors[i];
+        accessor->view = gltf_json_member_index(json, object, "bufferView");
+        accessor->offset = gltf_json_member_uint(json, object, "byteOffset", 0);
+        accessor->component_type = gltf_json_member_index(json, object, "componentType");
+        accessor->component_size = gltf_component_size(accessor->component_type);
+        accessor->components = gltf_type_components(json, gltf_json_member(json, object, "type"));
+        uint64_t count = gltf_json_member_uint(json, object, "count", 0);
+        uint32_t normalized = gltf_json_member(json, object, "normalized");
+        accessor->normalized = normalized != GLTF_NONE && json->tokens[normalized].end > json->tokens[normalized].start &&
+                               json->text[json->tokens[normalized].start] == 't';
+        accessor->sparse = gltf_json_member(json, object, "sparse") != GLTF_NONE;
+
+        if (accessor->component_size == 0 || count == 0 || count > 0xFFFFFFFFull) {
+            gltf_error(out_error, "glTF accessor %u has an invalid componentType or count", i);
+            return 0;
+        }
+        accessor->count = (uint32_t)count;
+
+        // Every element must lie inside the view. Offsets are compared before
+        // anything is subtracted and the count is divided out, so no term wraps.
+        if (accessor->view != GLTF_NONE && accessor->components > 0) {
+            if (accessor->view >= doc->view_count) {
+                gltf_error(out_error, "glTF accessor %u references a missing buffer view", i);
+                return 0;
+            }
+            const GltfBufferView* view = &doc->views[accessor->view];
+            uint64_t element = (uint64_t)accessor->component_size * accessor->components;
+            uint64_t stride = view->stride ? view->stride : element;
+            if (stride < element || accessor->offset % accessor->component_size != 0 ||
+                accessor->offset > view->length || element > view->length - accessor->offset ||
+                count - 1 > (view->length - accessor->offset - element) / stride) {
+                gltf_error(out_error, "glTF accessor %u is outside its buffer view", i);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// First element and stride of an accessor (NULL when it has no view)
+static const uint8_t* gltf_accessor_data(const GltfDocument* doc, const GltfAccessor* accessor, uint32_t* out_stride) {
+    *out_stride = accessor->component_size * accessor->components;
+    if (accessor->view == GLTF_NONE) {
+        return NULL;
+    }
+    const GltfBufferView* view = &doc->views[accessor->view];
+    if (view->stride) {
+        *out_stride = view->stride;
+    }
+    return doc->buffers[view->buffer].data + view->offset + accessor->offset;
+}
+
+// ============================================================================
+// ACCESSOR CONVERSION
+// ============================================================================
+
+// Convert one integer type with a constant component count: each element
+// becomes four int lanes, one vector convert and scale to float, then a
+// clamp for signed normalized values
+#define GLTF_CONVERT_LOOP(type, n)                                                  \
+    for (uint32_t i = 0; i < count; i++) {                                          \
+        type c[4] = {0, 0, 0, 0};                                                   \
+        memcpy(c, src + (size_t)i * src_stride, (n) * sizeof(type));                \
+        simd4i_t v = {(int32_t)c[0], (int32_t)c[1], (int32_t)c[2], (int32_t)c[3]};  \
+        simd4f_t f = simd4f_max(__builtin_convertvector(v, simd4f_t) * scale, lower); \
+        memcpy(dst + (size_t)i * dst_stride, &f, (n) * sizeof(float));              \
+    }
+
+// Vertex fields have 2 or 3 components
+#define GLTF_CONVERT_INTEGERS(type)                                                 \
+    if (components == 2) {                                                          \
+        GLTF_CONVERT_LOOP(type, 2)                                                  \
+    } else {                                                                        \
+        GLTF_CONVERT_LOOP(type, 3)                                                  \
+    }
+
+// Strided copy of an accessor into float fields dst_stride bytes apart
+static void gltf_convert_accessor(const GltfAccessor* accessor, const uint8_t* src, uint32_t src_stride, uint8_t* dst,
+                                  uint32_t dst_stride) {
+    uint32_t count = accessor->count;
+    uint32_t components = accessor->components;
+
+    if (!src) {
+        for (uint32_t i = 0; i < count; i++) {
+            memset(dst + (size_t)i * dst_stride, 0, components * sizeof(float));
+        }
+        return;
+    }
+
+    if (accessor->component_type == GLTF_COMPONENT_FLOAT) {
+        size_t bytes = components == 2 ? 2 * sizeof(float) : 3 * sizeof(float);
+        for (uint32_t i = 0; i < count; i++) {
+            memcpy(dst + (size_t)i * dst_stride, src + (size_t)i * src_stride, bytes);
+        }
+        return;
+    }
+
+    // KHR_mesh_quantization: normalized integers map to [0, 1] or [-1, 1]
+    float range = 1.0f;
+    int is_signed = accessor->component_type == GLTF_COMPONENT_BYTE || accessor->component_type == GLTF_COMPONENT_SHORT;
+    if (accessor->normalized) {
+        switch (accessor->component_type) {
+        case GLTF_COMPONENT_BYTE: range = 127.0f; break;
+        case GLTF_COMPONENT_UNSIGNED_BYTE: range = 255.0f; break;
+        case GLTF_COMPONENT_SHORT: range = 32767.0f; break;
+        case GLTF_COMPONENT_UNSIGNED_SHORT: range = 65535.0f; break;
+        default: break;
+        }
+    }
+    simd4f_t scale = simd4f_splat(1.0f / range);
+    simd4f_t lower = simd4f_splat(accessor->normalized && is_signed ? -1.0f : -FLT_MAX);
+
+    switch (accessor->component_type) {
+    case GLTF_COMPONENT_BYTE: GLTF_CONVERT_INTEGERS(int8_t) break;
+    case GLTF_COMPONENT_UNSIGNED_BYTE: GLTF_CONVERT_INTEGERS(uint8_t) break;
+    case GLTF_COMPONENT_SHORT: GLTF_CONVERT_INTEGERS(int16_t) break;
+    case GLTF_COMPONENT_UNSIGNED_SHORT: GLTF_CONVERT_INTEGERS(uint16_t) break;
+    default: break;
+    }
+}
+
+#undef GLTF_CONVERT_INTEGERS
+#undef GLTF_CONVERT_LOOP
+
+// Widen 8/16/32-bit indices into dst
+static void gltf_read_indices(const GltfAccessor* accessor, const uint8_t* src, uint32_t src_stride, uint32_t* dst) {
+    if (!src) {
+        memset(dst, 0, (size_t)accessor->count * sizeof(uint32_t));
+        return;
+    }
+    for (uint32_t i = 0; i < accessor->count; i++) {
+        const uint8_t* p = src + (size_t)i * src_stride;
+        if (accessor->component_type == GLTF_COMPONENT_UNSIGNED_BYTE) {
+            dst[i] = p[0];
+        } else if (accessor->component_type == GLTF_COMPONENT_UNSIGNED_SHORT) {
+            uint16_t v;
+            memcpy(&v, p, sizeof(v));
+            dst[i] = v;
+        } else {
+            memcpy(&dst[i], p, sizeof(uint32_t));
+        }
+    }
+}
+
+// Area-weighted vertex normals for primitives without a NORMAL attribute
+static void gltf_generate_normals(Mesh* mesh) {
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        mesh->vertices[i].normal = vec3_zero();
+    }
+    for (uint32_t t = 0; t + 2 < mesh->index_count; t += 3) {
+        Vertex* a = &mesh->vertices[mesh->indices[t]];
+        Vertex* b = &mesh->vertices[mesh->indices[t + 1]];
+        Vertex* c = &mesh->vertices[mesh->indices[t + 2]];
+        vec3_t n = vec3_cross(vec3_sub(b->position, a->position), vec3_sub(c->position, a->position));
+        a->normal = vec3_add(a->normal, n);
+        b->normal = vec3_add(b->normal, n);
+        c->normal = vec3_add(c->normal, n);
+    }
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        float length = vec3_length(mesh->vertices[i].normal);
+        mesh->vertices[i].normal = length > 0.0f ? vec3_scale(mesh->vertices[i].normal, 1.0f / length) : vec3_unit_z();
+    }
+}
+
+// ============================================================================
+// MESHES
+// ============================================================================
+
+// Accessor of an attribute (*out is NULL when absent). Returns 0 when the
+// accessor cannot become a float Vertex field.
+static int gltf_attribute(const GltfDocument* doc, uint32_t attributes, const char* name, uint32_t components,
+                          const GltfAccessor** out, char** out_error) {
+    *out = NULL;
+    uint32_t token = gltf_json_member(&doc->json, attributes, name);
+    if (token == GLTF_NONE) {
+        return 1;
+    }
+    uint32_t index = gltf_json_index(&doc->json, token);
+    if (index >= doc->accessor_count || doc->accessors[index].components != components ||
+        doc->accessors[index].component_type == GLTF_COMPONENT_UNSIGNED_INT || doc->accessors[index].sparse) {
+        gltf_error(out_error, "glTF attribute %s uses an unsupported accessor", name);
+        return 0;
+    }
+    *out = &doc->accessors[index];
+    return 1;
+}
+
+// True when position, texcoord and normal are the interleaved floats of a
+// Vertex array, so the mesh can point straight at them
+static const uint8_t* gltf_vertex_view(const GltfDocument* doc, const GltfAccessor* position,
+                                       const GltfAccessor* texcoord, const GltfAccessor* normal) {
+    if (!texcoord || !normal || position->view == GLTF_NONE || position->view != texcoord->view ||
+        position->view != normal->view || position->component_type != GLTF_COMPONENT_FLOAT ||
+        texcoord->component_type != GLTF_COMPONENT_FLOAT || normal->component_type != GLTF_COMPONENT_FLOAT ||
+        texcoord->count != position->count || normal->count != position->count) {
+        return NULL;
+    }
+    uint32_t stride;
+    const uint8_t* base = gltf_accessor_data(doc, position, &stride);
+    if (stride != sizeof(Vertex) || ((uintptr_t)base & 3) != 0 ||
+        texcoord->offset != position->offset + offsetof(Vertex, texcoord) ||
+        normal->offset != position->offset + offsetof(Vertex, normal)) {
+        return NULL;
+    }
+    return base;
+}
+
+static int gltf_build_mesh(GltfDocument* doc, uint32_t primitive, Mesh* mesh, char** out_error) {
+    const GltfJson* json = &doc->json;
+    uint32_t attributes = gltf_json_member(json, primitive, "attributes");
+    const GltfAccessor* position;
+    const GltfAccessor* texcoord;
+    const GltfAccessor* normal;
+    if (!gltf_attribute(doc, attributes, "POSITION", 3, &position, out_error) ||
+        !gltf_attribute(doc, attributes, "TEXCOORD_0", 2, &texcoord, out_error) ||
+        !gltf_attribute(doc, attributes, "NORMAL", 3, &normal, out_error)) {
+        return 0;
+    }
+    if (!position) {
+        gltf_error(out_error, "glTF primitive has no POSITION attribute");
+        return 0;
+    }
+    if ((texcoord && texcoord->count != position->count) || (normal && normal->count != position->count)) {
+        gltf_error(out_error, "glTF primitive attributes have different counts");
+        return 0;
+    }
+    *mesh = mesh_create();
+    mesh->vertex_count = position->count;
+
+    // Vertices: borrow when interleaved exactly like Vertex, otherwise convert
+    const uint8_t* interleaved = gltf_vertex_view(doc, position, texcoord, normal);
+    if (interleaved) {
+        mesh->vertices = (Vertex*)interleaved;
+        mesh->borrowed |= MESH_BORROWED_VERTICES;
+        doc->stats.borrowed_vertex_arrays++;
+    } else {
+        mesh->vertices = (Vertex*)calloc(position->count, sizeof(Vertex));
+        if (!mesh->vertices) {
+            gltf_error(out_error, "Failed to allocate memory for glTF vertices");
+            return 0;
+        }
+        const GltfAccessor* sources[3] = {position, texcoord, normal};
+        const size_t fields[3] = {offsetof(Vertex, position), offsetof(Vertex, texcoord), offsetof(Vertex, normal)};
+        for (uint32_t a = 0; a < 3; a++) {
+            if (!sources[a]) {
+                continue;
+            }
+            uint32_t stride;
+            const uint8_t* src = gltf_accessor_data(doc, sources[a], &stride);
+            gltf_convert_accessor(sources[a], src, stride, (uint8_t*)mesh->vertices + fields[a], sizeof(Vertex));
+            doc->stats.converted_accessors++;
+        }
+    }
+
+    // Indices: borrow packed 32-bit ones, widen the rest, generate if absent
+    uint32_t index_token = gltf_json_member(json, primitive, "indices");
+    if (index_token != GLTF_NONE) {
+        uint32_t index = gltf_json_index(json, index_token);
+        if (index >= doc->accessor_count || doc->accessors[index].components != 1 || doc->accessors[index].sparse ||
+            (doc->accessors[index].component_type != GLTF_COMPONENT_UNSIGNED_BYTE &&
+             doc->accessors[index].component_type != GLTF_COMPONENT_UNSIGNED_SHORT &&
+             doc->accessors[index].component_type != GLTF_COMPONENT_UNSIGNED_INT)) {
+            gltf_error(out_error, "glTF primitive uses an unsupported index accessor");
+            return 0;
+        }
+        const GltfAccessor* accessor = &doc->accessors[index];
+        uint32_t stride;
+        const uint8_t* src = gltf_accessor_data(doc, accessor, &stride);
+        mesh->index_count = accessor->count;
+        if (src && accessor->component_type == GLTF_COMPONENT_UNSIGNED_INT && stride == sizeof(uint32_t) &&
+            ((uintptr_t)src & 3) == 0) {
+            mesh->indices = (uint32_t*)src;
+            mesh->borrowed |= MESH_BORROWED_INDICES;
+            doc->stats.borrowed_index_arrays++;
+        } else {
+            mesh->indices = (uint32_t*)malloc((size_t)accessor->count * sizeof(uint32_t));
+            if (!mesh->indices) {
+                gltf_error(out_error, "Failed to allocate memory for glTF indices");
+                return 0;
+            }
+            gltf_read_indices(accessor, src, stride, mesh->indices);
+            doc->stats.converted_accessors++;
+        }
+    } else {
+        mesh->index_count = mesh->vertex_count;
+        mesh->indices = (uint32_t*)malloc((size_t)mesh->index_count * sizeof(uint32_t));
+        if (!mesh->indices) {
+            gltf_error(out_error, "Failed to allocate memory for glTF indices");
+            return 0;
+        }
+        for (uint32_t i = 0; i < mesh->index_count; i++) {
+            mesh->indices[i] = i;
+        }
+    }
+
+    if (mesh->index_count % 3 != 0) {
+        gltf_error(out_error, "glTF triangle primitive has %u indices", mesh->index_count);
+        return 0;
+    }
+    for (uint32_t i = 0; i < mesh->index_count; i++) {
+        if (mesh->indices[i] >= mesh->vertex_count) {
+            gltf_error(out_error, "glTF index %u is out of range (%u vertices)", mesh->indices[i], mesh->vertex_count);
+            return 0;
+        }
+    }
+    mesh->triangle_count = mesh_calculate_triangle_count(mesh->index_count);
+
+    if (!normal) {
+        gltf_generate_normals(mesh);
+    }
+    return 1;
+}
+
+static int gltf_is_triangles(const GltfJson* json, uint32_t primitive) {
+    return gltf_json_member_uint(json, primitive, "mode", GLTF_MODE_TRIANGLES) == GLTF_MODE_TRIANGLES;
+}
+
+static Model3D* gltf_build_model(GltfDocument* doc, const char* filepath, char** out_error) {
+    const GltfJson* json = &doc->json;
+    uint32_t meshes = gltf_json_member(json, doc->root, "meshes");
+    uint32_t mesh_count = gltf_json_array_size(json, meshes);
+
+    uint32_t triangle_primitives = 0;
+    uint32_t mesh = gltf_json_first(json, meshes);
+    for (uint32_t m = 0; m < mesh_count; m++, mesh = json->tokens[mesh].next) {
+        uint32_t primitives = gltf_json_member(json, mesh, "primitives");
+        uint32_t primitive = gltf_json_first(json, primitives);
+        for (uint32_t p = 0; p < gltf_json_array_size(json, primitives); p++, primitive = json->tokens[primitive].next) {
+            if (gltf_is_triangles(json, primitive)) {
+                triangle_primitives++;
+            } else {
+                doc->stats.skipped_primitives++;
+            }
+        }
+    }
+    if (triangle_primitives == 0) {
+        gltf_error(out_error, "glTF file has no triangle meshes: %s", filepath);
+        return NULL;
+    }
+
+    Model3D* model = model3d_allocate(triangle_primitives);
+    if (!model) {
+        gltf_error(out_error, "Failed to allocate memory for glTF model");
+        return NULL;
+    }
+
+    uint32_t out = 0;
+    mesh = gltf_json_first(json, meshes);
+    for (uint32_t m = 0; m < mesh_count; m++, mesh = json->tokens[mesh].next) {
+        uint32_t primitives = gltf_json_member(json, mesh, "primitives");
+        uint32_t primitive = gltf_json_first(json, primitives);
+        for (uint32_t p = 0; p < gltf_json_array_size(json, primitives); p++, primitive = json->tokens[primitive].next) {
+            if (!gltf_is_triangles(json, primitive)) {
+                continue;
+            }
+            if (!gltf_build_mesh(doc, primitive, &model->meshes[out], out_error)) {
+                model3d_free(model);
+                free(model);
+                return NULL;
+            }
+            out++;
+        }
+    }
+    doc->stats.mesh_count = out;
+
+    // Name after the first named mesh, else the file
+    uint32_t name = gltf_json_member(json, gltf_json_first(json, meshes), "name");
+    const char* base = strrchr(filepath, '/');
+    base = base ? base + 1 : filepath;
+    const char* text = name != GLTF_NONE ? json->text + json->tokens[name].start : base;
+    size_t length = name != GLTF_NONE ? json->tokens[name].end - json->tokens[name].start : strlen(base);
+    model->name = (char*)malloc(length + 1);
+    if (model->name) {
+        memcpy(model->name, text, length);
+        model->name[length] = '\0';
+    }
+
+    model3d_calculate_bounds(model);
+    model3d_calculate_center_and_radius(model);
+    return model;
+}
+
+// ============================================================================
+// LOADING
+// ============================================================================
+
+// Split a GLB into its JSON and BIN chunks
+static int gltf_parse_glb(const uint8_t* data, size_t size, const char** out_json, uint32_t* out_json_length,
+                          const uint8_t** out_bin, uint64_t* out_bin_size, char** out_error) {
+    uint32_t header[3];
+    if (size < 20) {
+        gltf_error(out_error, "GLB file is too small");
+        return 0;
+    }
+    memcpy(header, data, sizeof(header));
+    if (header[0] != GLTF_GLB_MAGIC || header[1] != GLTF_GLB_VERSION || header[2] > size) {
+        gltf_error(out_error, "Not a glTF 2.0 GLB file");
+        return 0;
+    }
+
+    *out_json = NULL;
+    *out_bin = NULL;
+    *out_bin_size = 0;
+    size_t offset = 12;
+    while (offset + 8 <= header[2]) {
+        uint32_t chunk[2];
+        memcpy(chunk, data + offset, sizeof(chunk));
+        offset += 8;
+        if (chunk[0] > header[2] - offset) {
+            gltf_error(out_error, "GLB chunk runs past the end of the file");
+            return 0;
+        }
+        if (chunk[1] == GLTF_GLB_CHUNK_JSON && !*out_json) {
+            *out_json = (const char*)(data + offset);
+            *out_json_length = chunk[0];
+        } else if (chunk[1] == GLTF_GLB_CHUNK_BIN && !*out_bin) {
+            *out_bin = data + offset;
+            *out_bin_size = chunk[0];
+        }
+        offset += (chunk[0] + 3) & ~3u;
+    }
+    if (!*out_json) {
+        gltf_error(out_error, "GLB file has no JSON chunk");
+        return 0;
+    }
+    return 1;
+}
+
+Model3D* gltf_load_model(const char* filepath, GltfLoadStats* out_stats, char** out_error) {
+    if (!filepath) {
+        gltf_error(out_error, "No glTF file path");
+        return NULL;
+    }
+
+    GltfDocument doc;
+    memset(&doc, 0, sizeof(doc));
+    doc.source = (GltfSource*)calloc(1, sizeof(GltfSource));
+    if (!doc.source) {
+        gltf_error(out_error, "Failed to allocate memory for glTF source");
+        return NULL;
+    }
+
+    Model3D* model = NULL;
+    GltfJsonToken* tokens = NULL;
+    size_t size = 0;
+    const uint8_t* file = gltf_map_file(doc.source, filepath, &size, out_error);
+    if (!file) {
+        goto done;
+    }
+    doc.stats.file_bytes += size;
+
+    // GLB: JSON chunk plus an embedded binary buffer. Otherwise the file is JSON.
+    const char* text = (const char*)file;
+    uint32_t text_length = (uint32_t)size;
+    const uint8_t* bin = NULL;
+    uint64_t bin_size = 0;
+    if (size >= 4 && memcmp(file, "glTF", 4) == 0 &&
+        !gltf_parse_glb(file, size, &text, &text_length, &bin, &bin_size, out_error)) {
+        goto done;
+    }
+
+    int32_t token_count = gltf_json_tokenize(text, text_length, NULL, 0);
+    if (token_count <= 0) {
+        gltf_error(out_error, "Invalid glTF JSON: %s", filepath);
+        goto done;
+    }
+    tokens = (GltfJsonToken*)malloc((size_t)token_count * sizeof(GltfJsonToken));
+    if (!tokens) {
+        gltf_error(out_error, "Failed to allocate memory for glTF JSON");
+        goto done;
+    }
+    gltf_json_tokenize(text, text_length, tokens, (uint32_t)token_count);
+    doc.json.text = text;
+    doc.json.tokens = tokens;
+    doc.json.count = (uint32_t)token_count;
+    doc.root = 0;
+    if (tokens[0].type != GLTF_JSON_OBJECT) {
+        gltf_error(out_error, "glTF JSON root is not an object: %s", filepath);
+        goto done;
+    }
+
+    // External buffers are relative to the .gltf
+    char directory[1024] = "";
+    const char* slash = strrchr(filepath, '/');
+    if (slash && (size_t)(slash - filepath + 1) < sizeof(directory)) {
+        memcpy(directory, filepath, (size_t)(slash - filepath + 1));
+        directory[slash - filepath + 1] = '\0';
+    }
+
+    if (!gltf_parse_buffers(&doc, directory, bin, bin_size, out_error) || !gltf_parse_views(&doc, out_error) ||
+        !gltf_parse_accessors(&doc, out_error)) {
+        goto done;
+    }
+    model = gltf_build_model(&doc, filepath, out_error);
+
+done:
+    // Keep the source alive only while a mesh points into it
+    if (model && (doc.stats.borrowed_vertex_arrays > 0 || doc.stats.borrowed_index_arrays > 0)) {
+        model->source = doc.source;
+        model->source_release = gltf_source_release;
+    } else {
+        gltf_source_release(doc.source);
+    }
+    if (out_stats) {
+        *out_stats = doc.stats;
+    }
+    free(tokens);
+    free(doc.buffers);
+    free(doc.views);
+    free(doc.accessors);
+    return model;
+}
@@ -0,0 +1,99 @@
+#ifndef ENGINE_ASSET_GLTF_H
+#define ENGINE_ASSET_GLTF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include "engine_model.h"
+
+// ============================================================================
+// GLTF CONFIGURATION
+// ============================================================================
+
+#define GLTF_GLB_MAGIC 0x46546C67u              // "glTF"
+#define GLTF_GLB_VERSION 2
+#define GLTF_GLB_CHUNK_JSON 0x4E4F534Au         // "JSON"
+#define GLTF_GLB_CHUNK_BIN 0x004E4942u          // "BIN\0"
+
+#define GLTF_JSON_MAX_DEPTH 64
+#define GLTF_JSON_ERROR_INVALID -1              // Malformed JSON
+#define GLTF_JSON_ERROR_NO_MEMORY -2            // More tokens than max_tokens
+
+// Accessor component types (GL enums, as stored in the file)
+#define GLTF_COMPONENT_BYTE 5120
+#define GLTF_COMPONENT_UNSIGNED_BYTE 5121
+#define GLTF_COMPONENT_SHORT 5122
+#define GLTF_COMPONENT_UNSIGNED_SHORT 5123
+#define GLTF_COMPONENT_UNSIGNED_INT 5125
+#define GLTF_COMPONENT_FLOAT 5126
+
+#define GLTF_MODE_TRIANGLES 4
+
+// ============================================================================
+// JSON TOKENIZER
+// ============================================================================
+
+typedef enum {
+    GLTF_JSON_OBJECT = 1,
+    GLTF_JSON_ARRAY,
+    GLTF_JSON_STRING,
+    GLTF_JSON_PRIMITIVE             // Number, true, false or null
+} GltfJsonType;
+
+// One JSON value or object key. Tokens are in document order, so a
+// container's children follow it and end at token `next`.
+typedef struct {
+    uint32_t type;                  // GltfJsonType
+    uint32_t start;                 // Byte range in the text (strings exclude the quotes)
+    uint32_t end;
+    uint32_t size;                  // Object members or array elements
+    uint32_t next;                  // Index of the first token after this value
+} GltfJsonToken;
+
+// ============================================================================
+// LOAD STATISTICS
+// ============================================================================
+
+typedef struct {
+    uint64_t file_bytes;            // The .glb, or the .gltf plus its buffers
+    uint32_t mesh_count;            // One Mesh per triangle primitive
+    uint32_t skipped_primitives;    // Points, lines and strips
+    uint32_t borrowed_vertex_arrays;  // Meshes whose vertices point into the file
+    uint32_t borrowed_index_arrays;
+    uint32_t converted_accessors;   // Accessors copied with a format conversion
+} GltfLoadStats;
+
+// ============================================================================
+// GLTF FUNCTIONS
+// ============================================================================
+
+// Tokenize JSON without allocating. Returns the token count, or a
+// GLTF_JSON_ERROR_* code. With tokens == NULL only counts, so a caller can
+// size the array exactly.
+int32_t gltf_json_tokenize(const char* json, size_t length, GltfJsonToken* tokens, uint32_t max_tokens);
+
+// Load a .gltf or .glb file into a Model3D, one Mesh per triangle primitive
+// of every mesh. Node transforms are not applied (Model3D has no hierarchy).
+//
+// Buffers are memory-mapped copy-on-write. When POSITION, TEXCOORD_0 and
+// NORMAL are interleaved floats laid out exactly like Vertex, or indices are
+// 32-bit, the Mesh arrays point into the mapping (MESH_BORROWED_*) and
+// model3d_free unmaps it. Other accessors, including KHR_mesh_quantization
+// integer ones, are converted. Missing normals are generated.
+//
+// Returns a heap-allocated Model3D* on success; NULL on failure.
+// On failure, if out_error is non-NULL, it will receive a heap-allocated error message that the caller must free.
+// out_stats may be NULL.
+Model3D* gltf_load_model(const char* filepath, GltfLoadStats* out_stats, char** out_error);
+
+// Convenience: free error strings returned by gltf_load_model
+void gltf_free_error(char* err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_ASSET_GLTF_H
@@ -0,0 +1,698 @@
+#include "engine_asset_gltf.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* GLB_PATH = "/tmp/engine_gltf_test.glb";
+static const char* GLTF_PATH = "/tmp/engine_gltf_test.gltf";
+static const char* BIN_PATH = "/tmp/engine_gltf_test.bin";
+static const char* BENCH_PATH = "/tmp/engine_gltf_bench.glb";
+
+static void free_model(Model3D* model) {
+    if (model) {
+        model3d_free(model);
+        free(model);
+    }
+}
+
+static int write_file(const char* path, const void* data, size_t size) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return 0;
+    }
+    size_t written = fwrite(data, 1, size, f);
+    fclose(f);
+    return written == size;
+}
+
+// GLB container: header, JSON chunk padded with spaces, BIN chunk padded with zeros
+static int write_glb(const char* path, const char* json, const void* bin, uint32_t bin_size) {
+    uint32_t json_length = (uint32_t)strlen(json);
+    uint32_t json_padded = (json_length + 3) & ~3u;
+    uint32_t bin_padded = (bin_size + 3) & ~3u;
+    uint32_t total = 12 + 8 + json_padded + (bin ? 8 + bin_padded : 0);
+
+    uint8_t* file = (uint8_t*)calloc(1, total);
+    if (!file) {
+        return 0;
+    }
+    uint32_t header[5] = {GLTF_GLB_MAGIC, GLTF_GLB_VERSION, total, json_padded, GLTF_GLB_CHUNK_JSON};
+    memcpy(file, header, sizeof(header));
+    memset(file + 20, ' ', json_padded);
+    memcpy(file + 20, json, json_length);
+    if (bin) {
+        uint32_t chunk[2] = {bin_padded, GLTF_GLB_CHUNK_BIN};
+        memcpy(file + 20 + json_padded, chunk, sizeof(chunk));
+        memcpy(file + 28 + json_padded, bin, bin_size);
+    }
+    int ok = write_file(path, file, total);
+    free(file);
+    return ok;
+}
+
+static void base64_encode(const uint8_t* data, size_t size, char* out) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < size; i += 3) {
+        uint32_t v = (uint32_t)data[i] << 16;
+        if (i + 1 < size) v |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < size) v |= data[i + 2];
+        out[o++] = alphabet[(v >> 18) & 63];
+        out[o++] = alphabet[(v >> 12) & 63];
+        out[o++] = i + 1 < size ? alphabet[(v >> 6) & 63] : '=';
+        out[o++] = i + 2 < size ? alphabet[v & 63] : '=';
+    }
+    out[o] = '\0';
+}
+
+static const Vertex QUAD_VERTICES[4] = {
+    {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{1.0f, -1.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+    {{1.0f, 1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 0.0f, 1.0f}},
+    {{-1.0f, 1.0f, 0.0f}, {0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}},
+};
+static const uint32_t QUAD_INDICES[6] = {0, 1, 2, 0, 2, 3};
+
+static int vertices_match(const Vertex* a, const Vertex* b, uint32_t count, float tolerance) {
+    for (uint32_t i = 0; i < count; i++) {
+        const float* fa = (const float*)&a[i];
+        const float* fb = (const float*)&b[i];
+        for (uint32_t f = 0; f < sizeof(Vertex) / sizeof(float); f++) {
+            if (fabsf(fa[f] - fb[f]) > tolerance) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// One mesh as a GLB: interleaved float vertices laid out like Vertex, or
+// KHR_mesh_quantization streams (normalized short positions in [-1, 1],
+// byte normals, unsigned short texcoords). Indices are 32-bit.
+static int write_mesh_glb(const char* path, const Vertex* vertices, uint32_t vertex_count, const uint32_t* indices,
+                          uint32_t index_count, int quantized) {
+    size_t vertex_bytes = (size_t)vertex_count * (quantized ? 8 + 4 + 4 : sizeof(Vertex));
+    size_t bin_size = vertex_bytes + (size_t)index_count * sizeof(uint32_t);
+    uint8_t* bin = (uint8_t*)malloc(bin_size);
+    char json[2048];
+    if (!bin) {
+        return 0;
+    }
+
+    if (!quantized) {
+        memcpy(bin, vertices, vertex_bytes);
+        snprintf(json, sizeof(json),
+            "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":%zu}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteLength\":%zu,\"byteStride\":32},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}],"
+            "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"},"
+            "{\"bufferView\":0,\"byteOffset\":12,\"componentType\":5126,\"count\":%u,\"type\":\"VEC2\"},"
+            "{\"bufferView\":0,\"byteOffset\":20,\"componentType\":5126,\"count\":%u,\"type\":\"VEC3\"},"
+            "{\"bufferView\":1,\"componentType\":5125,\"count\":%u,\"type\":\"SCALAR\"}],"
+            "\"meshes\":[{\"name\":\"mesh\",\"primitives\":[{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":1,"
+            "\"NORMAL\":2},\"indices\":3}]}]}",
+            bin_size, vertex_bytes, vertex_bytes, (size_t)index_count * 4, vertex_count, vertex_count, vertex_count,
+            index_count);
+    } else {
+        int16_t* positions = (int16_t*)bin;
+        int8_t* normals = (int8_t*)(bin + (size_t)vertex_count * 8);
+        uint16_t* texcoords = (uint16_t*)(bin + (size_t)vertex_count * 12);
+        for (uint32_t i = 0; i < vertex_count; i++) {
+            const Vertex* v = &vertices[i];
+            positions[i * 4 + 0] = (int16_t)lrintf(v->position.x * 32767.0f);
+            positions[i * 4 + 1] = (int16_t)lrintf(v->position.y * 32767.0f);
+            positions[i * 4 + 2] = (int16_t)lrintf(v->position.z * 32767.0f);
+            positions[i * 4 + 3] = 0;
+            normals[i * 4 + 0] = (int8_t)lrintf(v->normal.x * 127.0f);
+            normals[i * 4 + 1] = (int8_t)lrintf(v->normal.y * 127.0f);
+            normals[i * 4 + 2] = (int8_t)lrintf(v->normal.z * 127.0f);
+            normals[i * 4 + 3] = 0;
+            texcoords[i * 2 + 0] = (uint16_t)lrintf(v->texcoord.x * 65535.0f);
+            texcoords[i * 2 + 1] = (uint16_t)lrintf(v->texcoord.y * 65535.0f);
+        }
+        snprintf(json, sizeof(json),
+            "{\"asset\":{\"version\":\"2.0\"},\"extensionsUsed\":[\"KHR_mesh_quantization\"],"
+            "\"buffers\":[{\"byteLength\":%zu}],"
+            "\"bufferViews\":[{\"buffer\":0,\"byteLength\":%zu,\"byteStride\":8},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu,\"byteStride\":4},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu},"
+            "{\"buffer\":0,\"byteOffset\":%zu,\"byteLength\":%zu}],"
+            "\"accessors\":[{\"bufferView\":0,\"componentType\":5122,\"normalized\":true,\"count\":%u,\"type\":\"VEC3\"},"
+            "{\"bufferView\":1,\"componentType\":5120,\"normalized\":true,\"count\":%u,\"type\":\"VEC3\"},"
+            "{\"bufferView\":2,\"componentType\":5123,\"normalized\":true,\"count\":%u,\"type\":\"VEC2\"},"
+            "{\"bufferView\":3,\"componentType\":5125,\"count\":%u,\"type\":\"SCALAR\"}],"
+            "\"meshes\":[{\"name\":\"mesh\",\"primitives\":[{\"attributes\":{\"POSITION\":0,\"NORMAL\":1,"
+            "\"TEXCOORD_0\":2},\"indices\":3}]}]}",
+            bin_size, (size_t)vertex_count * 8, (size_t)vertex_count * 8, (size_t)vertex_count * 4,
+            (size_t)vertex_count * 12, (size_t)vertex_count * 4, vertex_bytes, (size_t)index_count * 4,
+            vertex_count, vertex_count, vertex_count, index_count);
+    }
+    memcpy(bin + vertex_bytes, indices, (size_t)index_count * sizeof(uint32_t));
+
+    int ok = write_glb(path, json, bin, (uint32_t)bin_size);
+    free(bin);
+    return ok;
+}
+
+// ============================================================================
+// JSON TOKENIZER TESTS
+// ============================================================================
+
+static void test_json(void) {
+    printf("\n--- JSON Tokenizer Tests ---\n");
+
+    const char* json = "{\"a\": [1, -2.5e3, {\"b\": \"x\\\"y\"}], \"c\": true}";
+    GltfJsonToken tokens[16];
+    int32_t count = gltf_json_tokenize(json, strlen(json), tokens, 16);
+    TEST_ASSERT_EQUAL(10, count, "Object, keys, array, values and nested object tokenized");
+    TEST_ASSERT_EQUAL(count, gltf_json_tokenize(json, strlen(json), NULL, 0), "Counting pass agrees");
+    TEST_ASSERT(tokens[0].type == GLTF_JSON_OBJECT && tokens[0].size == 2 && tokens[0].next == 10,
+                "Root object has two members and spans every token");
+    TEST_ASSERT(tokens[2].type == GLTF_JSON_ARRAY && tokens[2].size == 3 && tokens[2].next == 8,
+                "Array has three elements and next skips its children");
+    TEST_ASSERT(tokens[4].type == GLTF_JSON_PRIMITIVE && tokens[4].end - tokens[4].start == 6,
+                "Number token covers its text");
+    TEST_ASSERT(tokens[7].type == GLTF_JSON_STRING && memcmp(json + tokens[7].start, "x\\\"y", 4) == 0,
+                "Escaped quote stays inside the string");
+
+    TEST_ASSERT_EQUAL(GLTF_JSON_ERROR_NO_MEMORY, gltf_json_tokenize(json, strlen(json), tokens, 3),
+                      "Too few tokens is reported");
+    TEST_ASSERT_EQUAL(GLTF_JSON_ERROR_INVALID, gltf_json_tokenize("[1, 2", 5, NULL, 0), "Unclosed array is invalid");
+    TEST_ASSERT_EQUAL(GLTF_JSON_ERROR_INVALID, gltf_json_tokenize("[1, 2}", 6, NULL, 0), "Mismatched bracket is invalid");
+    TEST_ASSERT_EQUAL(GLTF_JSON_ERROR_INVALID, gltf_json_tokenize("{\"a\":}", 6, NULL, 0), "Member without a value is invalid");
+    TEST_ASSERT_EQUAL(GLTF_JSON_ERROR_INVALID, gltf_json_tokenize("{1: 2}", 6, NULL, 0), "Non-string key is invalid");
+    TEST_ASSERT_EQUAL(GLTF_JSON_ERROR_INVALID, gltf_json_tokenize("\"abc", 4, NULL, 0), "Unterminated string is invalid");
+
+    // Only `length` bytes are read: the GLB JSON chunk is not NUL-terminated
+    const char padded[] = "[7]]]]";
+    TEST_ASSERT_EQUAL(2, gltf_json_tokenize(padded, 3, tokens, 16), "Tokenizer stops at length");
+}
+
+// ============================================================================
+// LOADER TESTS
+// ============================================================================
+
+static void test_interleaved_glb(void) {
+    printf("\n--- Interleaved GLB Tests ---\n");
+
+    TEST_ASSERT(write_mesh_glb(GLB_PATH, QUAD_VERTICES, 4, QUAD_INDICES, 6, 0), "Quad GLB written");
+
+    GltfLoadStats stats;
+    char* err = NULL;
+    Model3D* model = gltf_load_model(GLB_PATH, &stats, &err);
+    TEST_ASSERT_NOT_NULL(model, "Quad GLB loaded");
+    if (!model) {
+        gltf_free_error(err);
+        return;
+    }
+
+    Mesh* mesh = &model->meshes[0];
+    TEST_ASSERT(model->mesh_count == 1 && mesh->vertex_count == 4 && mesh->index_count == 6 &&
+                mesh->triangle_count == 2, "One mesh with 4 vertices and 2 triangles");
+    TEST_ASSERT_EQUAL((uint32_t)(MESH_BORROWED_VERTICES | MESH_BORROWED_INDICES), mesh->borrowed,
+                      "Vertices and indices point into the file");
+    TEST_ASSERT(stats.borrowed_vertex_arrays == 1 && stats.borrowed_index_arrays == 1 &&
+                stats.converted_accessors == 0, "Stats report zero-copy arrays");
+    TEST_ASSERT(model->source != NULL && model->source_release != NULL, "Model keeps the mapping alive");
+    TEST_ASSERT(vertices_match(mesh->vertices, QUAD_VERTICES, 4, 0.0f) &&
+                memcmp(mesh->indices, QUAD_INDICES, sizeof(QUAD_INDICES)) == 0, "Data matches the source");
+    TEST_ASSERT(model->bounding_min.x == -1.0f && model->bounding_max.y == 1.0f, "Bounds computed");
+    TEST_ASSERT(model->name && strcmp(model->name, "mesh") == 0, "Named after the first mesh");
+
+    // Mapping is copy-on-write: editing the mesh never touches the file
+    mesh->vertices[0].position.x = 42.0f;
+    free_model(model);
+    model = gltf_load_model(GLB_PATH, NULL, NULL);
+    TEST_ASSERT(model && model->meshes[0].vertices[0].position.x == -1.0f, "Edits do not reach the file");
+    free_model(model);
+    unlink(GLB_PATH);
+}
+
+static void test_quantized(void) {
+    printf("\n--- Quantized Accessor Tests ---\n");
+
+    Vertex vertices[4];
+    memcpy(vertices, QUAD_VERTICES, sizeof(vertices));
+    vertices[2].position = vec3(0.25f, -0.5f, 0.125f);
+    vertices[3].normal = vec3(0.0f, -1.0f, 0.0f);
+    vertices[1].texcoord = vec2(0.3f, 0.7f);
+    TEST_ASSERT(write_mesh_glb(GLB_PATH, vertices, 4, QUAD_INDICES, 6, 1), "Quantized GLB written");
+
+    GltfLoadStats stats;
+    Model3D* model = gltf_load_model(GLB_PATH, &stats, NULL);
+    TEST_ASSERT_NOT_NULL(model, "Quantized GLB loaded");
+    if (!model) return;
+
+    Mesh* mesh = &model->meshes[0];
+    TEST_ASSERT_EQUAL((uint32_t)MESH_BORROWED_INDICES, mesh->borrowed, "Only the 32-bit indices are borrowed");
+    TEST_ASSERT_EQUAL(3u, stats.converted_accessors, "Three attributes converted");
+    TEST_ASSERT(vertices_match(mesh->vertices, vertices, 4, 1.0f / 127.0f), "Dequantized within one step");
+    TEST_ASSERT(fabsf(mesh->vertices[2].position.z - 0.125f) < 1.0f / 32767.0f &&
+                fabsf(mesh->vertices[1].texcoord.x - 0.3f) < 1.0f / 65535.0f, "Short precision is preserved");
+    TEST_ASSERT(mesh->vertices[0].position.x == -1.0f && mesh->vertices[3].normal.y == -1.0f,
+                "Signed normalized values reach -1");
+    free_model(model);
+
+    // Hand-written: byte indices, unnormalized unsigned byte texcoords and
+    // -32768, which the spec clamps to -1
+    uint8_t bin[36];
+    memset(bin, 0, sizeof(bin));
+    int16_t positions[12] = {-32768, 0, 0, 0, 32767, 0, 0, 0, 0, 32767, 0, 0};
+    uint8_t uvs[6] = {0, 1, 2, 3, 4, 5};
+    uint8_t byte_indices[3] = {0, 1, 2};
+    memcpy(bin, positions, sizeof(positions));
+    memcpy(bin + 24, uvs, sizeof(uvs));
+    memcpy(bin + 32, byte_indices, sizeof(byte_indices));
+    const char* json =
+        "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":36}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":24,\"byteStride\":8},{\"buffer\":0,\"byteOffset\":24,\"byteLength\":6},"
+        "{\"buffer\":0,\"byteOffset\":32,\"byteLength\":3}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5122,\"normalized\":true,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"componentType\":5121,\"count\":3,\"type\":\"VEC2\"},"
+        "{\"bufferView\":2,\"componentType\":5121,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,\"TEXCOORD_0\":1},\"indices\":2}]}]}";
+    TEST_ASSERT(write_glb(GLB_PATH, json, bin, sizeof(bin)), "Hand-written GLB written");
+    model = gltf_load_model(GLB_PATH, NULL, NULL);
+    TEST_ASSERT_NOT_NULL(model, "Hand-written GLB loaded");
+    if (model) {
+        mesh = &model->meshes[0];
+        TEST_ASSERT_EQUAL(-1.0f, mesh->vertices[0].position.x, "-32768 clamps to -1");
+        TEST_ASSERT(mesh->vertices[1].texcoord.x == 2.0f && mesh->vertices[2].texcoord.y == 5.0f,
+                    "Unnormalized integers keep their value");
+        TEST_ASSERT(mesh->indices[0] == 0 && mesh->indices[2] == 2 && mesh->borrowed == 0, "Byte indices widened");
+        TEST_ASSERT(fabsf(mesh->vertices[0].normal.z - 1.0f) < 1e-5f, "Missing normals are generated");
+        TEST_ASSERT(model->source == NULL, "Nothing borrowed, so the file is already unmapped");
+        TEST_ASSERT(model->name && strcmp(model->name, "engine_gltf_test.glb") == 0, "Unnamed mesh takes the file name");
+    }
+    free_model(model);
+    unlink(GLB_PATH);
+}
+
+static void test_multiple_primitives(void) {
+    printf("\n--- Multiple Mesh Tests ---\n");
+
+    // Two meshes: the first has two triangle primitives, the second a
+    // triangle primitive and a line primitive. Non-indexed primitives use
+    // vertices in order.
+    float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    uint16_t indices[3] = {2, 1, 0};
+    uint8_t bin[44];
+    memset(bin, 0, sizeof(bin));
+    memcpy(bin, positions, sizeof(positions));
+    memcpy(bin + 36, indices, sizeof(indices));
+    const char* json =
+        "{\"asset\":{\"version\":\"2.0\"},\"buffers\":[{\"byteLength\":44}],"
+        "\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},{\"buffer\":0,\"byteOffset\":36,\"byteLength\":6}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"componentType\":5123,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"meshes\":["
+        "{\"name\":\"first\",\"primitives\":[{\"attributes\":{\"POSITION\":0}},{\"attributes\":{\"POSITION\":0},\"indices\":1,\"mode\":4}]},"
+        "{\"name\":\"second\",\"primitives\":[{\"attributes\":{\"POSITION\":0},\"mode\":1},{\"attributes\":{\"POSITION\":0},\"indices\":1}]}"
+        "]}";
+    TEST_ASSERT(write_glb(GLB_PATH, json, bin, sizeof(bin)), "Multi-mesh GLB written");
+
+    GltfLoadStats stats;
+    Model3D* model = gltf_load_model(GLB_PATH, &stats, NULL);
+    TEST_ASSERT_NOT_NULL(model, "Multi-mesh GLB loaded");
+    if (!model) return;
+
+    TEST_ASSERT_EQUAL(3u, model->mesh_count, "One Mesh per triangle primitive");
+    TEST_ASSERT_EQUAL(1u, stats.skipped_primitives, "Line primitive skipped");
+    TEST_ASSERT(model->meshes[0].indices[0] == 0 && model->meshes[0].indices[2] == 2, "Non-indexed primitive in order");
+    TEST_ASSERT(model->meshes[1].indices[0] == 2 && model->meshes[2].indices[0] == 2, "Short indices widened");
+    TEST_ASSERT(fabsf(model->meshes[0].vertices[0].normal.z - 1.0f) < 1e-5f &&
+                fabsf(model->meshes[1].vertices[0].normal.z + 1.0f) < 1e-5f, "Generated normals follow the winding");
+    TEST_ASSERT(model->name && strcmp(model->name, "first") == 0, "Named after the first mesh");
+    free_model(model);
+    unlink(GLB_PATH);
+}
+
+static void test_gltf_with_buffers(void) {
+    printf("\n--- glTF External Buffer Tests ---\n");
+
+    // Positions in an external .bin, texcoords and indices in a data URI
+    float positions[12] = {-1, -1, 0, 1, -1, 0, 1, 1, 0, -1, 1, 0};
+    TEST_ASSERT(write_file(BIN_PATH, positions, sizeof(positions)), "External buffer written");
+
+    uint8_t embedded[32 + 12];
+    float uvs[8] = {0, 0, 1, 0, 1, 1, 0, 1};
+    uint16_t indices[6] = {0, 1, 2, 0, 2, 3};
+    memcpy(embedded, uvs, sizeof(uvs));
+    memcpy(embedded + 32, indices, sizeof(indices));
+    char base64[128];
+    base64_encode(embedded, sizeof(embedded), base64);
+
+    char json[1024];
+    snprintf(json, sizeof(json),
+        "{\n  \"asset\": {\"version\": \"2.0\"},\n"
+        "  \"buffers\": [{\"uri\": \"engine_gltf_test.bin\", \"byteLength\": 48},\n"
+        "              {\"uri\": \"data:application/octet-stream;base64,%s\", \"byteLength\": 44}],\n"
+        "  \"bufferViews\": [{\"buffer\": 0, \"byteLength\": 48}, {\"buffer\": 1, \"byteLength\": 32},\n"
+        "                  {\"buffer\": 1, \"byteOffset\": 32, \"byteLength\": 12}],\n"
+        "  \"accessors\": [{\"bufferView\": 0, \"componentType\": 5126, \"count\": 4, \"type\": \"VEC3\"},\n"
+        "                {\"bufferView\": 1, \"componentType\": 5126, \"count\": 4, \"type\": \"VEC2\"},\n"
+        "                {\"bufferView\": 2, \"componentType\": 5123, \"count\": 6, \"type\": \"SCALAR\"}],\n"
+        "  \"meshes\": [{\"primitives\": [{\"attributes\": {\"POSITION\": 0, \"TEXCOORD_0\": 1}, \"indices\": 2}]}]\n"
+        "}\n", base64);
+    TEST_ASSERT(write_file(GLTF_PATH, json, strlen(json)), "glTF JSON written");
+
+    GltfLoadStats stats;
+    char* err = NULL;
+    Model3D* model = gltf_load_model(GLTF_PATH, &stats, &err);
+    TEST_ASSERT_NOT_NULL(model, "glTF with external and embedded buffers loaded");
+    if (!model) {
+        gltf_free_error(err);
+        return;
+    }
+
+    Mesh* mesh = &model->meshes[0];
+    int positions_ok = 1;
+    int uvs_ok = 1;
+    for (uint32_t i = 0; i < 4; i++) {
+        positions_ok &= mesh->vertices[i].position.x == QUAD_VERTICES[i].position.x &&
+                        mesh->vertices[i].position.y == QUAD_VERTICES[i].position.y;
+        uvs_ok &= mesh->vertices[i].texcoord.x == QUAD_VERTICES[i].texcoord.x &&
+                  mesh->vertices[i].texcoord.y == QUAD_VERTICES[i].texcoord.y;
+    }
+    TEST_ASSERT(positions_ok, "Positions read from the external file");
+    TEST_ASSERT(uvs_ok && memcmp(mesh->indices, QUAD_INDICES, sizeof(QUAD_INDICES)) == 0,
+                "Texcoords and indices decoded from base64");
+    TEST_ASSERT_EQUAL((uint64_t)(strlen(json) + sizeof(positions)), stats.file_bytes, "File bytes include the .bin");
+    free_model(model);
+
+    unlink(BIN_PATH);
+    model = gltf_load_model(GLTF_PATH, NULL, &err);
+    TEST_ASSERT(model == NULL && err != NULL, "Missing external buffer is an error");
+    gltf_free_error(err);
+    unlink(GLTF_PATH);
+}
+
+static void test_errors(void) {
+    printf("\n--- Error Handling Tests ---\n");
+
+    char* err = NULL;
+    TEST_ASSERT(gltf_load_model("/tmp/engine_gltf_missing.glb", NULL, &err) == NULL && err != NULL,
+                "Missing file is an error");
+    gltf_free_error(err);
+    err = NULL;
+
+    uint32_t bad_header[5] = {GLTF_GLB_MAGIC, 1, 20, 0, GLTF_GLB_CHUNK_JSON};
+    write_file(GLB_PATH, bad_header, sizeof(bad_header));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "GLB version 1 is rejected");
+
+    const char* not_json = "{\"asset\": [}";
+    write_file(GLTF_PATH, not_json, strlen(not_json));
+    TEST_ASSERT(gltf_load_model(GLTF_PATH, NULL, NULL) == NULL, "Malformed JSON is rejected");
+
+    float positions[9] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    uint32_t indices[3] = {0, 1, 3};
+    uint8_t bin[48];
+    memcpy(bin, positions, sizeof(positions));
+    memcpy(bin + 36, indices, sizeof(indices));
+
+    const char* out_of_view =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}]}";
+    write_glb(GLB_PATH, out_of_view, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, &err) == NULL && err && strstr(err, "accessor 0"),
+                "Accessor past its view is rejected");
+    gltf_free_error(err);
+    err = NULL;
+
+    const char* view_past_buffer =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteOffset\":40,\"byteLength\":36}],"
+        "\"accessors\":[],\"meshes\":[]}";
+    write_glb(GLB_PATH, view_past_buffer, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "Buffer view past its buffer is rejected");
+
+    const char* bad_index =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},"
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":12}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"componentType\":5125,\"count\":3,\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}]}";
+    write_glb(GLB_PATH, bad_index, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, &err) == NULL && err && strstr(err, "out of range"),
+                "Out-of-range index is rejected");
+    gltf_free_error(err);
+    err = NULL;
+
+    // Stride, offset and count chosen so the old offset + stride * (count - 1)
+    // bound wrapped around and the index read went through a wild pointer
+    const char* hostile_stride =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},"
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":12,\"byteStride\":2147483648}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"byteOffset\":17995772507629551616,\"componentType\":5125,\"count\":210000001,"
+        "\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}]}";
+    write_glb(GLB_PATH, hostile_stride, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, &err) == NULL && err && strstr(err, "byteStride"),
+                "Out-of-spec byteStride is rejected");
+    gltf_free_error(err);
+    err = NULL;
+
+    const char* hostile_offset =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36},"
+        "{\"buffer\":0,\"byteOffset\":36,\"byteLength\":12,\"byteStride\":252}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"},"
+        "{\"bufferView\":1,\"byteOffset\":17995772507629551616,\"componentType\":5125,\"count\":210000001,"
+        "\"type\":\"SCALAR\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"indices\":1}]}]}";
+    write_glb(GLB_PATH, hostile_offset, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, &err) == NULL && err && strstr(err, "accessor 1"),
+                "Accessor offset past its view is rejected");
+    gltf_free_error(err);
+    err = NULL;
+
+    const char* odd_stride =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36,\"byteStride\":14}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}]}";
+    write_glb(GLB_PATH, odd_stride, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "byteStride not a multiple of 4 is rejected");
+
+    const char* negative_index =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":-1}}]}]}";
+    write_glb(GLB_PATH, negative_index, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "Negative accessor index is rejected");
+
+    const char* fractional_index =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0.5,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0.25}}]}]}";
+    write_glb(GLB_PATH, fractional_index, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "Fractional indices are rejected");
+
+    const char* no_position =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"NORMAL\":0}}]}]}";
+    write_glb(GLB_PATH, no_position, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "Primitive without POSITION is rejected");
+
+    const char* wrong_type =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":4,\"type\":\"VEC2\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}]}";
+    write_glb(GLB_PATH, wrong_type, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "VEC2 positions are rejected");
+
+    const char* points_only =
+        "{\"buffers\":[{\"byteLength\":48}],\"bufferViews\":[{\"buffer\":0,\"byteLength\":36}],"
+        "\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+        "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0},\"mode\":0}]}]}";
+    write_glb(GLB_PATH, points_only, bin, sizeof(bin));
+    TEST_ASSERT(gltf_load_model(GLB_PATH, NULL, NULL) == NULL, "File without triangles is rejected");
+
+    TEST_ASSERT(gltf_load_model(NULL, NULL, NULL) == NULL, "NULL path is rejected");
+    unlink(GLB_PATH);
+    unlink(GLTF_PATH);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void build_grid(uint32_t n, Vertex* vertices, uint32_t* indices) {
+    for (uint32_t y = 0; y < n; y++) {
+        for (uint32_t x = 0; x < n; x++) {
+            float u = (float)x / (float)(n - 1);
+            float v = (float)y / (float)(n - 1);
+            float h = 0.25f * sinf(u * 12.0f) * cosf(v * 9.0f);
+            vec3_t normal = vec3_normalize(vec3(-3.0f * cosf(u * 12.0f) * cosf(v * 9.0f), 1.0f,
+                                                2.25f * sinf(u * 12.0f) * sinf(v * 9.0f) * 0.1f));
+            vertices[y * n + x] = vertex_create(vec3(u * 2.0f - 1.0f, h, v * 2.0f - 1.0f), vec2(u, v), normal);
+        }
+    }
+    uint32_t k = 0;
+    for (uint32_t y = 0; y + 1 < n; y++) {
+        for (uint32_t x = 0; x + 1 < n; x++) {
+            uint32_t i = y * n + x;
+            indices[k++] = i;
+            indices[k++] = i + n;
+            indices[k++] = i + 1;
+            indices[k++] = i + 1;
+            indices[k++] = i + n;
+            indices[k++] = i + n + 1;
+        }
+    }
+}
+
+static double bench_gltf(const char* path, uint32_t runs, uint64_t* out_bytes) {
+    double start = now_ms();
+    for (uint32_t r = 0; r < runs; r++) {
+        GltfLoadStats stats;
+        Model3D* model = gltf_load_model(path, &stats, NULL);
+        *out_bytes = stats.file_bytes;
+        free_model(model);
+    }
+    return (now_ms() - start) / runs;
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    // Same geometry as the FBX path: load the sphere asset, write it as GLB
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", "assets", "UnitSphere.fbx");
+    FILE* f = fopen(path, "rb");
+    long fbx_bytes = 0;
+    if (f) {
+        fseek(f, 0, SEEK_END);
+        fbx_bytes = ftell(f);
+        fclose(f);
+    }
+    if (fbx_bytes > 0) {
+        enum { FBX_RUNS = 5, GLB_RUNS = 200 };
+        char* err = NULL;
+        Model3D* fbx = NULL;
+        double start = now_ms();
+        for (uint32_t r = 0; r < FBX_RUNS; r++) {
+            free_model(fbx);
+            fbx = fbx_load_model(path, &err);
+        }
+        double fbx_ms = (now_ms() - start) / FBX_RUNS;
+        TEST_ASSERT_NOT_NULL(fbx, "FBX sphere loaded");
+        fbx_free_error(err);
+
+        if (fbx) {
+            const Mesh* source = &fbx->meshes[0];
+            TEST_ASSERT(write_mesh_glb(BENCH_PATH, source->vertices, source->vertex_count, source->indices,
+                                       source->index_count, 0), "Sphere written as GLB");
+            uint64_t glb_bytes = 0;
+            double glb_ms = bench_gltf(BENCH_PATH, GLB_RUNS, &glb_bytes);
+            Model3D* glb = gltf_load_model(BENCH_PATH, NULL, NULL);
+            TEST_ASSERT(glb && glb->meshes[0].vertex_count == source->vertex_count &&
+                        vertices_match(glb->meshes[0].vertices, source->vertices, source->vertex_count, 0.0f),
+                        "GLB sphere matches the FBX sphere");
+            free_model(glb);
+
+            double fbx_mbs = fbx_bytes / (fbx_ms * 1000.0);
+            double glb_mbs = glb_bytes / (glb_ms * 1000.0);
+            printf("  Sphere (%u vertices): FBX %ld bytes in %.3f ms (%.1f MB/s), GLB %llu bytes in %.3f ms (%.1f MB/s)\n",
+                   source->vertex_count, fbx_bytes, fbx_ms, fbx_mbs, (unsigned long long)glb_bytes, glb_ms, glb_mbs);
+            printf("  GLB loads the same mesh %.0fx faster\n", fbx_ms / glb_ms);
+            TEST_ASSERT(glb_ms < fbx_ms, "GLB loads faster than FBX");
+            unlink(BENCH_PATH);
+        }
+        free_model(fbx);
+    } else {
+        printf("  %s not found, skipping the FBX comparison\n", path);
+    }
+
+    // A 512x512 grid: zero-copy interleaved floats vs quantized streams
+    enum { GRID = 512, RUNS = 10 };
+    uint32_t vertex_count = GRID * GRID;
+    uint32_t index_count = (GRID - 1) * (GRID - 1) * 6;
+    Vertex* vertices = (Vertex*)malloc(vertex_count * sizeof(Vertex));
+    uint32_t* indices = (uint32_t*)malloc(index_count * sizeof(uint32_t));
+    TEST_ASSERT(vertices && indices, "Grid allocated");
+    if (!vertices || !indices) {
+        free(vertices);
+        free(indices);
+        return;
+    }
+    build_grid(GRID, vertices, indices);
+
+    uint64_t bytes = 0;
+    TEST_ASSERT(write_mesh_glb(BENCH_PATH, vertices, vertex_count, indices, index_count, 0), "Float grid written");
+    double float_ms = bench_gltf(BENCH_PATH, RUNS, &bytes);
+    printf("  Float grid (%u vertices): %.2f MB in %.3f ms (%.0f MB/s, zero-copy)\n", vertex_count,
+           bytes / (1024.0 * 1024.0), float_ms, bytes / (float_ms * 1000.0));
+
+    TEST_ASSERT(write_mesh_glb(BENCH_PATH, vertices, vertex_count, indices, index_count, 1), "Quantized grid written");
+    double quantized_ms = bench_gltf(BENCH_PATH, RUNS, &bytes);
+    printf("  Quantized grid: %.2f MB in %.3f ms (%.0f MB/s, %.0f M vertices/s converted)\n",
+           bytes / (1024.0 * 1024.0), quantized_ms, bytes / (quantized_ms * 1000.0),
+           vertex_count / (quantized_ms * 1000.0));
+
+    Model3D* model = gltf_load_model(BENCH_PATH, NULL, NULL);
+    TEST_ASSERT(model && vertices_match(model->meshes[0].vertices, vertices, vertex_count, 1.0f / 127.0f),
+                "Quantized grid round-trips within one normal step");
+    free_model(model);
+
+    unlink(BENCH_PATH);
+    free(vertices);
+    free(indices);
+}
+
+int main(void) {
+    printf("Starting glTF Loader Unit Tests\n");
+    printf("===============================\n");
+
+    test_json();
+    test_interleaved_glb();
+    test_quantized();
+    test_multiple_primitives();
+    test_gltf_with_buffers();
+    test_errors();
+    test_performance();
+
+    printf("\n===============================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
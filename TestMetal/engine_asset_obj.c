@@ -0,0 +1,842 @@
+#include "engine_asset_obj.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define OBJ_NONE 0xFFFFFFFFu
+#define OBJ_WELD_BLOCK 16384                    // Corners per weld work item
+#define OBJ_FIRST_USE 0x80000000u               // Corner that defines its welded vertex
+
+// Attribute kinds, in face corner order (v/vt/vn)
+#define OBJ_POSITION 0
+#define OBJ_TEXCOORD 1
+#define OBJ_NORMAL 2
+
+static const uint32_t obj_attribute_floats[3] = {3, 2, 3};
+
+// ============================================================================
+// ERRORS
+// ============================================================================
+
+static void obj_error(char** out_error, const char* format, ...) {
+    char message[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    fprintf(stderr, "Error: %s\n", message);
+    if (out_error && !*out_error) {
+        size_t n = strlen(message) + 1;
+        *out_error = (char*)malloc(n);
+        if (*out_error) {
+            memcpy(*out_error, message, n);
+        }
+    }
+}
+
+void obj_free_error(char* err) {
+    free(err);
+}
+
+ObjLoadDesc obj_load_desc_default(void) {
+    ObjLoadDesc desc;
+    desc.jobs = NULL;
+    desc.chunk_bytes = OBJ_DEFAULT_CHUNK_BYTES;
+    desc.weld = 1;
+    return desc;
+}
+
+// ============================================================================
+// CHUNKS
+// ============================================================================
+
+// One polygon corner as parsed. Positive indices are final (0-based).
+// Negative ones are stored relative to the chunk's first element of that
+// kind, because a chunk does not know how many came before it in the file.
+typedef struct {
+    int32_t index[3];               // v, vt, vn
+    uint32_t flags;                 // OBJ_CORNER_PRESENT(k) | OBJ_CORNER_RELATIVE(k)
+} ObjCorner;
+
+#define OBJ_CORNER_PRESENT(k) (1u << (k))
+#define OBJ_CORNER_RELATIVE(k) (8u << (k))
+
+typedef enum {
+    OBJ_CHUNK_OK = 0,
+    OBJ_CHUNK_MALFORMED,
+    OBJ_CHUNK_NO_MEMORY,
+    OBJ_CHUNK_BAD_INDEX
+} ObjChunkError;
+
+// A line-aligned slice of the file and everything parsed from it
+typedef struct {
+    const char* begin;
+    const char* end;
+    float* attributes[3];           // Positions (xyz), texcoords (uv), normals (xyz)
+    uint32_t attribute_count[3];
+    uint32_t attribute_capacity[3];
+    ObjCorner* corners;             // Three per triangle
+    uint32_t corner_count;
+    uint32_t corner_capacity;
+    ObjCorner* polygon;             // Scratch for the face being read
+    uint32_t polygon_capacity;
+    uint32_t face_count;
+    uint32_t skipped_faces;
+    uint32_t attribute_base[3];     // Elements of each kind in earlier chunks
+    uint32_t corner_base;
+    uint32_t missing_normals;       // Some corner has no vn
+    uint32_t error;                 // ObjChunkError
+    const char* error_at;           // Start of the offending line
+} ObjChunk;
+
+static void obj_chunk_free(ObjChunk* chunk) {
+    for (uint32_t k = 0; k < 3; k++) {
+        free(chunk->attributes[k]);
+        chunk->attributes[k] = NULL;
+    }
+    free(chunk->corners);
+    free(chunk->polygon);
+    chunk->corners = NULL;
+    chunk->polygon = NULL;
+}
+
+// Grow *data to hold `needed` elements
+static int obj_reserve(void** data, uint32_t* capacity, uint64_t needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 1;
+    }
+    if (needed > OBJ_MAX_CORNERS) {
+        return 0;
+    }
+    uint64_t grown = *capacity ? *capacity : 256;
+    while (grown < needed) {
+        grown *= 2;
+    }
+    void* memory = realloc(*data, (size_t)grown * element_size);
+    if (!memory) {
+        return 0;
+    }
+    *data = memory;
+    *capacity = (uint32_t)grown;
+    return 1;
+}
+
+// ============================================================================
+// PARSING
+// ============================================================================
+
+static const double obj_pow10[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline int obj_is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// True at the end of a token: blank, end of line or end of chunk
+static inline int obj_token_end(const char* p, const char* end) {
+    return p >= end || obj_is_blank(*p) || *p == '\n';
+}
+
+static inline const char* obj_skip_blanks(const char* p, const char* end) {
+    while (p < end && obj_is_blank(*p)) {
+        p++;
+    }
+    return p;
+}
+
+static inline const char* obj_next_line(const char* p, const char* end) {
+    const char* newline = (const char*)memchr(p, '\n', (size_t)(end - p));
+    return newline ? newline + 1 : end;
+}
+
+// Locale-independent decimal float. strtod is the bottleneck of naive OBJ
+// readers; 19 significant digits and a power-of-ten table are plenty here.
+static const char* obj_parse_float(const char* p, const char* end, float* out) {
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int significant = 0;
+    int exponent = 0;
+    int digits = 0;
+    for (; p < end && (unsigned)(*p - '0') < 10u; p++, digits++) {
+        if (significant < 19) {
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+            significant += mantissa != 0;
+        } else {
+            exponent++;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && (unsigned)(*p - '0') < 10u; p++, digits++) {
+            if (significant < 19) {
+                mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+                significant += mantissa != 0;
+                exponent--;
+            }
+        }
+    }
+    if (digits == 0) {
+        return NULL;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        int exponent_negative = 0;
+        if (p < end && (*p == '-' || *p == '+')) {
+            exponent_negative = *p == '-';
+            p++;
+        }
+        if (p >= end || (unsigned)(*p - '0') >= 10u) {
+            return NULL;
+        }
+        int value = 0;
+        for (; p < end && (unsigned)(*p - '0') < 10u; p++) {
+            if (value < 10000) {
+                value = value * 10 + (*p - '0');
+            }
+        }
+        exponent += exponent_negative ? -value : value;
+    }
+
+    double value = (double)mantissa;
+    if (exponent < 0) {
+        value = -exponent <= 22 ? value / obj_pow10[-exponent] : value * pow(10.0, exponent);
+    } else if (exponent > 0) {
+        value = exponent <= 22 ? value * obj_pow10[exponent] : value * pow(10.0, exponent);
+    }
+    *out = (float)(negative ? -value : value);
+    return p;
+}
+
+// Signed decimal integer, saturated well outside the int32 range
+static const char* obj_parse_int(const char* p, const char* end, int64_t* out) {
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (p >= end || (unsigned)(*p - '0') >= 10u) {
+        return NULL;
+    }
+    int64_t value = 0;
+    for (; p < end && (unsigned)(*p - '0') < 10u; p++) {
+        if (value < ((int64_t)1 << 40)) {
+            value = value * 10 + (*p - '0');
+        }
+    }
+    *out = negative ? -value : value;
+    return p;
+}
+
+static const char* obj_chunk_fail(ObjChunk* chunk, uint32_t error) {
+    chunk->error = error;
+    return NULL;
+}
+
+// v x y z [w], vt u [v [w]], vn x y z. Extra components (w, vertex
+// colours) are ignored.
+static const char* obj_parse_attribute(ObjChunk* chunk, uint32_t kind, const char* p, const char* end) {
+    uint32_t floats = obj_attribute_floats[kind];
+    if (!obj_reserve((void**)&chunk->attributes[kind], &chunk->attribute_capacity[kind],
+                     (uint64_t)chunk->attribute_count[kind] + 1, floats * sizeof(float))) {
+        return obj_chunk_fail(chunk, OBJ_CHUNK_NO_MEMORY);
+    }
+    float* dst = chunk->attributes[kind] + (size_t)chunk->attribute_count[kind] * floats;
+    uint32_t required = kind == OBJ_TEXCOORD ? 1 : 3;
+    for (uint32_t i = 0; i < floats; i++) {
+        p = obj_skip_blanks(p, end);
+        if (p >= end || *p == '\n' || *p == '#') {
+            if (i < required) {
+                return obj_chunk_fail(chunk, OBJ_CHUNK_MALFORMED);
+            }
+            dst[i] = 0.0f;
+            continue;
+        }
+        p = obj_parse_float(p, end, &dst[i]);
+        if (!p || !obj_token_end(p, end)) {
+            return obj_chunk_fail(chunk, OBJ_CHUNK_MALFORMED);
+        }
+    }
+    chunk->attribute_count[kind]++;
+    return obj_next_line(p, end);
+}
+
+// f v[/[vt][/vn]] ... with three or more corners, fan-triangulated
+static const char* obj_parse_face(ObjChunk* chunk, const char* p, const char* end) {
+    uint32_t n = 0;
+    for (;;) {
+        p = obj_skip_blanks(p, end);
+        if (p >= end || *p == '\n' || *p == '#') {
+            break;
+        }
+        if (!obj_reserve((void**)&chunk->polygon, &chunk->polygon_capacity, (uint64_t)n + 1, sizeof(ObjCorner))) {
+            return obj_chunk_fail(chunk, OBJ_CHUNK_NO_MEMORY);
+        }
+        ObjCorner* corner = &chunk->polygon[n];
+        memset(corner, 0, sizeof(*corner));
+        for (uint32_t k = 0; k < 3; k++) {
+            if (k > 0) {
+                if (p >= end || *p != '/') {
+                    break;
+                }
+                p++;
+            }
+            int64_t value;
+            const char* next = obj_parse_int(p, end, &value);
+            if (!next) {
+                if (k == OBJ_POSITION) {
+                    return obj_chunk_fail(chunk, OBJ_CHUNK_MALFORMED);
+                }
+                continue;                       // Empty vt in v//vn, or a trailing slash
+            }
+            p = next;
+            if (value == 0 || value > INT32_MAX) {
+                return obj_chunk_fail(chunk, OBJ_CHUNK_MALFORMED);
+            }
+            corner->flags |= OBJ_CORNER_PRESENT(k);
+            if (value > 0) {
+                corner->index[k] = (int32_t)(value - 1);
+            } else {
+                // -1 is the latest element read so far
+                int64_t relative = (int64_t)chunk->attribute_count[k] + value;
+                if (relative < INT32_MIN) {
+                    return obj_chunk_fail(chunk, OBJ_CHUNK_MALFORMED);
+                }
+                corner->index[k] = (int32_t)relative;
+                corner->flags |= OBJ_CORNER_RELATIVE(k);
+            }
+        }
+        if (!obj_token_end(p, end)) {
+            return obj_chunk_fail(chunk, OBJ_CHUNK_MALFORMED);
+        }
+        n++;
+    }
+
+    if (n < 3) {
+        chunk->skipped_faces++;
+        return obj_next_line(p, end);
+    }
+    uint64_t needed = (uint64_t)chunk->corner_count + (uint64_t)(n - 2) * 3;
+    if (!obj_reserve((void**)&chunk->corners, &chunk->corner_capacity, needed, sizeof(ObjCorner))) {
+        return obj_chunk_fail(chunk, OBJ_CHUNK_NO_MEMORY);
+    }
+    ObjCorner* dst = chunk->corners + chunk->corner_count;
+    for (uint32_t i = 1; i + 1 < n; i++) {
+        *dst++ = chunk->polygon[0];
+        *dst++ = chunk->polygon[i];
+        *dst++ = chunk->polygon[i + 1];
+    }
+    chunk->corner_count = (uint32_t)needed;
+    chunk->face_count++;
+    return obj_next_line(p, end);
+}
+
+static void obj_parse_chunk(ObjChunk* chunk) {
+    const char* p = chunk->begin;
+    const char* end = chunk->end;
+    while (p < end) {
+        p = obj_skip_blanks(p, end);
+        if (p >= end) {
+            break;
+        }
+        const char* line = p;
+        if (p[0] == 'v' && p + 1 < end) {
+            if (obj_is_blank(p[1])) {
+                p = obj_parse_attribute(chunk, OBJ_POSITION, p + 1, end);
+            } else if (p[1] == 't' && p + 2 < end && obj_is_blank(p[2])) {
+                p = obj_parse_attribute(chunk, OBJ_TEXCOORD, p + 2, end);
+            } else if (p[1] == 'n' && p + 2 < end && obj_is_blank(p[2])) {
+                p = obj_parse_attribute(chunk, OBJ_NORMAL, p + 2, end);
+            } else {
+                p = obj_next_line(p, end);
+            }
+        } else if (p[0] == 'f' && p + 1 < end && obj_is_blank(p[1])) {
+            p = obj_parse_face(chunk, p + 1, end);
+        } else {
+            p = obj_next_line(p, end);          // Comments, groups, materials, lines, ...
+        }
+        if (!p) {
+            chunk->error_at = line;
+            break;
+        }
+    }
+    free(chunk->polygon);
+    chunk->polygon = NULL;
+}
+
+static void obj_parse_chunks_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjChunk* chunks = (ObjChunk*)user_data;
+    (void)worker_index;
+    for (uint32_t i = begin; i < end; i++) {
+        obj_parse_chunk(&chunks[i]);
+    }
+}
+
+// ============================================================================
+// MERGING
+// ============================================================================
+
+typedef struct {
+    ObjChunk* chunks;
+    float* attributes[3];           // Whole-file arrays
+    uint32_t attribute_total[3];
+    uint32_t* keys;                 // Absolute v, vt, vn per corner (OBJ_NONE when absent)
+} ObjMergeJob;
+
+// Copy a chunk's attributes to its prefix-summed offset and resolve its
+// corners to absolute indices
+static void obj_merge_chunks_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjMergeJob* job = (ObjMergeJob*)user_data;
+    (void)worker_index;
+    for (uint32_t i = begin; i < end; i++) {
+        ObjChunk* chunk = &job->chunks[i];
+        for (uint32_t k = 0; k < 3; k++) {
+            uint32_t floats = obj_attribute_floats[k];
+            if (chunk->attribute_count[k] > 0) {
+                memcpy(job->attributes[k] + (size_t)chunk->attribute_base[k] * floats, chunk->attributes[k],
+                       (size_t)chunk->attribute_count[k] * floats * sizeof(float));
+            }
+            free(chunk->attributes[k]);
+            chunk->attributes[k] = NULL;
+        }
+
+        uint32_t* keys = job->keys + (size_t)chunk->corner_base * 3;
+        for (uint32_t c = 0; c < chunk->corner_count; c++) {
+            const ObjCorner* corner = &chunk->corners[c];
+            for (uint32_t k = 0; k < 3; k++) {
+                if (!(corner->flags & OBJ_CORNER_PRESENT(k))) {
+                    keys[c * 3 + k] = OBJ_NONE;
+                    continue;
+                }
+                int64_t index = corner->index[k];
+                if (corner->flags & OBJ_CORNER_RELATIVE(k)) {
+                    index += chunk->attribute_base[k];
+                }
+                if (index < 0 || index >= (int64_t)job->attribute_total[k]) {
+                    chunk->error = OBJ_CHUNK_BAD_INDEX;
+                    index = 0;
+                }
+                keys[c * 3 + k] = (uint32_t)index;
+            }
+            chunk->missing_normals |= keys[c * 3 + OBJ_NORMAL] == OBJ_NONE;
+        }
+        free(chunk->corners);
+        chunk->corners = NULL;
+    }
+}
+
+// ============================================================================
+// WELDING
+// ============================================================================
+
+typedef struct {
+    const uint32_t* keys;
+    uint32_t corner_count;
+    uint32_t* slots;                // Open-addressed: owning corner, then vertex index
+    uint32_t mask;
+    uint32_t* corner_slot;          // Slot per corner; becomes the index buffer
+    uint32_t* block_vertices;       // First uses per block, then their prefix sum
+    const float* attributes[3];
+    Vertex* vertices;
+} ObjWeldJob;
+
+static inline uint32_t obj_hash(const uint32_t* key) {
+    uint32_t h = key[0] * 0x9E3779B1u;
+    h ^= key[1] * 0x85EBCA77u + (h << 6) + (h >> 2);
+    h ^= key[2] * 0xC2B2AE3Du + (h << 6) + (h >> 2);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    return h;
+}
+
+static inline int obj_key_equal(const uint32_t* a, const uint32_t* b) {
+    return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+static void obj_build_vertex(const ObjWeldJob* job, const uint32_t* key, Vertex* vertex) {
+    const float* p = job->attributes[OBJ_POSITION] + (size_t)key[0] * 3;
+    vertex->position = vec3(p[0], p[1], p[2]);
+    if (key[1] != OBJ_NONE) {
+        const float* t = job->attributes[OBJ_TEXCOORD] + (size_t)key[1] * 2;
+        vertex->texcoord = vec2(t[0], 1.0f - t[1]);     // OBJ v runs bottom-up
+    } else {
+        vertex->texcoord = vec2_zero();
+    }
+    if (key[2] != OBJ_NONE) {
+        const float* n = job->attributes[OBJ_NORMAL] + (size_t)key[2] * 3;
+        vertex->normal = vec3(n[0], n[1], n[2]);
+    } else {
+        vertex->normal = vec3_zero();
+    }
+}
+
+// Claim a slot per distinct key. Equal keys race for the same slot and the
+// lowest corner index wins, so ownership is independent of scheduling.
+static void obj_weld_insert_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjWeldJob* job = (ObjWeldJob*)user_data;
+    (void)worker_index;
+    uint32_t first = begin * OBJ_WELD_BLOCK;
+    uint32_t last = end * OBJ_WELD_BLOCK < job->corner_count ? end * OBJ_WELD_BLOCK : job->corner_count;
+    for (uint32_t c = first; c < last; c++) {
+        const uint32_t* key = job->keys + (size_t)c * 3;
+        uint32_t slot = obj_hash(key) & job->mask;
+        for (;;) {
+            uint32_t owner = __atomic_load_n(&job->slots[slot], __ATOMIC_RELAXED);
+            if (owner == OBJ_NONE) {
+                owner = __sync_val_compare_and_swap(&job->slots[slot], OBJ_NONE, c);
+                if (owner == OBJ_NONE) {
+                    break;
+                }
+            }
+            if (obj_key_equal(job->keys + (size_t)owner * 3, key)) {
+                while (c < owner) {
+                    uint32_t seen = __sync_val_compare_and_swap(&job->slots[slot], owner, c);
+                    if (seen == owner) {
+                        break;
+                    }
+                    owner = seen;
+                }
+                break;
+            }
+            slot = (slot + 1) & job->mask;
+        }
+        job->corner_slot[c] = slot;
+    }
+}
+
+// Flag the corners that own their slot and count them per block
+static void obj_weld_count_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjWeldJob* job = (ObjWeldJob*)user_data;
+    (void)worker_index;
+    for (uint32_t b = begin; b < end; b++) {
+        uint32_t first = b * OBJ_WELD_BLOCK;
+        uint32_t last = first + OBJ_WELD_BLOCK < job->corner_count ? first + OBJ_WELD_BLOCK : job->corner_count;
+        uint32_t count = 0;
+        for (uint32_t c = first; c < last; c++) {
+            if (job->slots[job->corner_slot[c]] == c) {
+                job->corner_slot[c] |= OBJ_FIRST_USE;
+                count++;
+            }
+        }
+        job->block_vertices[b] = count;
+    }
+}
+
+// Number first uses in corner order, write their vertices and leave the
+// vertex index in the slot
+static void obj_weld_assign_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjWeldJob* job = (ObjWeldJob*)user_data;
+    (void)worker_index;
+    for (uint32_t b = begin; b < end; b++) {
+        uint32_t first = b * OBJ_WELD_BLOCK;
+        uint32_t last = first + OBJ_WELD_BLOCK < job->corner_count ? first + OBJ_WELD_BLOCK : job->corner_count;
+        uint32_t vertex = job->block_vertices[b];
+        for (uint32_t c = first; c < last; c++) {
+            if (job->corner_slot[c] & OBJ_FIRST_USE) {
+                job->slots[job->corner_slot[c] & ~OBJ_FIRST_USE] = vertex;
+                obj_build_vertex(job, job->keys + (size_t)c * 3, &job->vertices[vertex]);
+                vertex++;
+            }
+        }
+    }
+}
+
+static void obj_weld_index_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjWeldJob* job = (ObjWeldJob*)user_data;
+    (void)worker_index;
+    uint32_t first = begin * OBJ_WELD_BLOCK;
+    uint32_t last = end * OBJ_WELD_BLOCK < job->corner_count ? end * OBJ_WELD_BLOCK : job->corner_count;
+    for (uint32_t c = first; c < last; c++) {
+        job->corner_slot[c] = job->slots[job->corner_slot[c] & ~OBJ_FIRST_USE];
+    }
+}
+
+// Without welding every corner is its own vertex
+static void obj_unwelded_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ObjWeldJob* job = (ObjWeldJob*)user_data;
+    (void)worker_index;
+    uint32_t first = begin * OBJ_WELD_BLOCK;
+    uint32_t last = end * OBJ_WELD_BLOCK < job->corner_count ? end * OBJ_WELD_BLOCK : job->corner_count;
+    for (uint32_t c = first; c < last; c++) {
+        obj_build_vertex(job, job->keys + (size_t)c * 3, &job->vertices[c]);
+        job->corner_slot[c] = c;
+    }
+}
+
+// Returns the vertex count, or 0 when out of memory
+static uint32_t obj_weld(ObjWeldJob* job, JobSystemHandle jobs, int weld) {
+    uint32_t blocks = (job->corner_count + OBJ_WELD_BLOCK - 1) / OBJ_WELD_BLOCK;
+    if (!weld) {
+        job->vertices = (Vertex*)malloc((size_t)job->corner_count * sizeof(Vertex));
+        if (!job->vertices) {
+            return 0;
+        }
+        job_system_parallel_for(jobs, blocks, 1, obj_unwelded_range, job);
+        return job->corner_count;
+    }
+
+    // Load factor at most 2/3
+    uint32_t capacity = 64;
+    while (capacity < job->corner_count + job->corner_count / 2) {
+        capacity *= 2;
+    }
+    job->slots = (uint32_t*)malloc((size_t)capacity * sizeof(uint32_t));
+    job->block_vertices = (uint32_t*)malloc((size_t)blocks * sizeof(uint32_t));
+    if (!job->slots || !job->block_vertices) {
+        return 0;
+    }
+    memset(job->slots, 0xFF, (size_t)capacity * sizeof(uint32_t));
+    job->mask = capacity - 1;
+
+    job_system_parallel_for(jobs, blocks, 1, obj_weld_insert_range, job);
+    job_system_parallel_for(jobs, blocks, 1, obj_weld_count_range, job);
+    uint32_t vertex_count = 0;
+    for (uint32_t b = 0; b < blocks; b++) {
+        uint32_t count = job->block_vertices[b];
+        job->block_vertices[b] = vertex_count;
+        vertex_count += count;
+    }
+    job->vertices = (Vertex*)malloc((size_t)vertex_count * sizeof(Vertex));
+    if (!job->vertices) {
+        return 0;
+    }
+    job_system_parallel_for(jobs, blocks, 1, obj_weld_assign_range, job);
+    job_system_parallel_for(jobs, blocks, 1, obj_weld_index_range, job);
+    return vertex_count;
+}
+
+// Area-weighted vertex normals, for files that leave out vn
+static void obj_generate_normals(Mesh* mesh) {
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        mesh->vertices[i].normal = vec3_zero();
+    }
+    for (uint32_t t = 0; t + 2 < mesh->index_count; t += 3) {
+        Vertex* a = &mesh->vertices[mesh->indices[t]];
+        Vertex* b = &mesh->vertices[mesh->indices[t + 1]];
+        Vertex* c = &mesh->vertices[mesh->indices[t + 2]];
+        vec3_t n = vec3_cross(vec3_sub(b->position, a->position), vec3_sub(c->position, a->position));
+        a->normal = vec3_add(a->normal, n);
+        b->normal = vec3_add(b->normal, n);
+        c->normal = vec3_add(c->normal, n);
+    }
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        float length = vec3_length(mesh->vertices[i].normal);
+        mesh->vertices[i].normal = length > 0.0f ? vec3_scale(mesh->vertices[i].normal, 1.0f / length) : vec3_unit_z();
+    }
+}
+
+// ============================================================================
+// LOADING
+// ============================================================================
+
+// 1-based line number of a pointer into the file (error reporting only)
+static uint32_t obj_line_number(const char* text, const char* at) {
+    uint32_t line = 1;
+    for (const char* p = text; p < at; p++) {
+        const char* newline = (const char*)memchr(p, '\n', (size_t)(at - p));
+        if (!newline) {
+            break;
+        }
+        line++;
+        p = newline;
+    }
+    return line;
+}
+
+Model3D* obj_load_model(const char* filepath, const ObjLoadDesc* desc, ObjLoadStats* out_stats, char** out_error) {
+    ObjLoadDesc d = desc ? *desc : obj_load_desc_default();
+    if (d.chunk_bytes < OBJ_MIN_CHUNK_BYTES) {
+        d.chunk_bytes = OBJ_MIN_CHUNK_BYTES;
+    }
+    ObjLoadStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (out_stats) {
+        *out_stats = stats;
+    }
+    if (!filepath) {
+        obj_error(out_error, "No OBJ file path");
+        return NULL;
+    }
+
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) {
+        obj_error(out_error, "Failed to open OBJ file: %s", filepath);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        obj_error(out_error, "Empty or unreadable OBJ file: %s", filepath);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        obj_error(out_error, "Failed to map OBJ file: %s", filepath);
+        return NULL;
+    }
+    madvise(mapping, size, MADV_WILLNEED);
+    const char* text = (const char*)mapping;
+    const char* text_end = text + size;
+    stats.file_bytes = size;
+
+    Model3D* model = NULL;
+    ObjMergeJob merge;
+    ObjWeldJob weld;
+    memset(&merge, 0, sizeof(merge));
+    memset(&weld, 0, sizeof(weld));
+
+    // Line-aligned chunks of at least chunk_bytes (except the last)
+    uint32_t chunk_count = 0;
+    ObjChunk* chunks = (ObjChunk*)calloc(size / d.chunk_bytes + 1, sizeof(ObjChunk));
+    if (!chunks) {
+        obj_error(out_error, "Failed to allocate memory for OBJ chunks");
+        goto done;
+    }
+    for (const char* p = text; p < text_end; chunk_count++) {
+        const char* stop = (size_t)(text_end - p) > d.chunk_bytes ? p + d.chunk_bytes : text_end;
+        if (stop < text_end) {
+            const char* newline = (const char*)memchr(stop, '\n', (size_t)(text_end - stop));
+            stop = newline ? newline + 1 : text_end;
+        }
+        chunks[chunk_count].begin = p;
+        chunks[chunk_count].end = stop;
+        p = stop;
+    }
+    stats.chunk_count = chunk_count;
+
+    job_system_parallel_for(d.jobs, chunk_count, 1, obj_parse_chunks_range, chunks);
+
+    // Prefix sums give every chunk its place in the merged arrays
+    uint64_t totals[3] = {0, 0, 0};
+    uint64_t corner_total = 0;
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        ObjChunk* chunk = &chunks[i];
+        if (chunk->error == OBJ_CHUNK_NO_MEMORY) {
+            obj_error(out_error, "Failed to allocate memory for OBJ data");
+            goto done;
+        }
+        if (chunk->error != OBJ_CHUNK_OK) {
+            obj_error(out_error, "Malformed OBJ line %u: %s", obj_line_number(text, chunk->error_at), filepath);
+            goto done;
+        }
+        for (uint32_t k = 0; k < 3; k++) {
+            chunk->attribute_base[k] = (uint32_t)totals[k];
+            totals[k] += chunk->attribute_count[k];
+        }
+        chunk->corner_base = (uint32_t)corner_total;
+        corner_total += chunk->corner_count;
+        stats.face_count += chunk->face_count;
+        stats.skipped_faces += chunk->skipped_faces;
+        if (corner_total > OBJ_MAX_CORNERS || totals[0] > OBJ_MAX_CORNERS || totals[1] > OBJ_MAX_CORNERS ||
+            totals[2] > OBJ_MAX_CORNERS) {
+            obj_error(out_error, "OBJ file is too large: %s", filepath);
+            goto done;
+        }
+    }
+    stats.position_count = (uint32_t)totals[OBJ_POSITION];
+    stats.texcoord_count = (uint32_t)totals[OBJ_TEXCOORD];
+    stats.normal_count = (uint32_t)totals[OBJ_NORMAL];
+    stats.triangle_count = (uint32_t)(corner_total / 3);
+    if (corner_total == 0) {
+        obj_error(out_error, "OBJ file has no faces: %s", filepath);
+        goto done;
+    }
+
+    merge.chunks = chunks;
+    for (uint32_t k = 0; k < 3; k++) {
+        merge.attribute_total[k] = (uint32_t)totals[k];
+        merge.attributes[k] = (float*)malloc((size_t)(totals[k] ? totals[k] : 1) * obj_attribute_floats[k] * sizeof(float));
+    }
+    merge.keys = (uint32_t*)malloc((size_t)corner_total * 3 * sizeof(uint32_t));
+    if (!merge.attributes[0] || !merge.attributes[1] || !merge.attributes[2] || !merge.keys) {
+        obj_error(out_error, "Failed to allocate memory for OBJ data");
+        goto done;
+    }
+    job_system_parallel_for(d.jobs, chunk_count, 1, obj_merge_chunks_range, &merge);
+
+    for (uint32_t i = 0; i < chunk_count; i++) {
+        if (chunks[i].error == OBJ_CHUNK_BAD_INDEX) {
+            obj_error(out_error, "OBJ face index out of range: %s", filepath);
+            goto done;
+        }
+        stats.generated_normals |= chunks[i].missing_normals;
+    }
+
+    weld.keys = merge.keys;
+    weld.corner_count = (uint32_t)corner_total;
+    for (uint32_t k = 0; k < 3; k++) {
+        weld.attributes[k] = merge.attributes[k];
+    }
+    weld.corner_slot = (uint32_t*)malloc((size_t)corner_total * sizeof(uint32_t));
+    uint32_t vertex_count = weld.corner_slot ? obj_weld(&weld, d.jobs, d.weld) : 0;
+    if (vertex_count == 0) {
+        obj_error(out_error, "Failed to allocate memory for OBJ vertices");
+        goto done;
+    }
+    stats.vertex_count = vertex_count;
+
+    model = model3d_allocate(1);
+    if (!model) {
+        obj_error(out_error, "Failed to allocate memory for OBJ model");
+        goto done;
+    }
+    Mesh* mesh = &model->meshes[0];
+    *mesh = mesh_create();
+    mesh->vertices = weld.vertices;
+    mesh->vertex_count = vertex_count;
+    mesh->indices = weld.corner_slot;
+    mesh->index_count = (uint32_t)corner_total;
+    mesh->triangle_count = mesh_calculate_triangle_count(mesh->index_count);
+    weld.vertices = NULL;
+    weld.corner_slot = NULL;
+    if (stats.generated_normals) {
+        obj_generate_normals(mesh);
+    }
+
+    const char* base = strrchr(filepath, '/');
+    base = base ? base + 1 : filepath;
+    size_t length = strlen(base);
+    model->name = (char*)malloc(length + 1);
+    if (model->name) {
+        memcpy(model->name, base, length + 1);
+    }
+    model3d_calculate_bounds(model);
+    model3d_calculate_center_and_radius(model);
+
+done:
+    if (out_stats) {
+        *out_stats = stats;
+    }
+    if (chunks) {
+        for (uint32_t i = 0; i < chunk_count; i++) {
+            obj_chunk_free(&chunks[i]);
+        }
+        free(chunks);
+    }
+    for (uint32_t k = 0; k < 3; k++) {
+        free(merge.attributes[k]);
+    }
+    free(merge.keys);
+    free(weld.slots);
+    free(weld.block_vertices);
+    free(weld.vertices);
+    free(weld.corner_slot);
+    munmap(mapping, size);
+    return model;
+}
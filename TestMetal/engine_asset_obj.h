@@ -0,0 +1,78 @@
+#ifndef ENGINE_ASSET_OBJ_H
+#define ENGINE_ASSET_OBJ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include "engine_model.h"
+#include "engine_jobs.h"
+
+// ============================================================================
+// OBJ CONFIGURATION
+// ============================================================================
+
+#define OBJ_DEFAULT_CHUNK_BYTES (1u << 20)      // Parse work item: ~1 MB of lines
+#define OBJ_MIN_CHUNK_BYTES 256
+#define OBJ_MAX_CORNERS (1u << 30)              // Triangle corners per file (weld table bound)
+
+// ============================================================================
+// LOAD DESCRIPTION
+// ============================================================================
+
+typedef struct {
+    JobSystemHandle jobs;           // Worker pool for parsing and welding (NULL: serial)
+    uint32_t chunk_bytes;           // Target bytes per parse chunk (line aligned)
+    int weld;                       // Share vertices between corners with equal v/vt/vn
+} ObjLoadDesc;
+
+// ============================================================================
+// LOAD STATISTICS
+// ============================================================================
+
+typedef struct {
+    uint64_t file_bytes;
+    uint32_t chunk_count;           // Line-aligned chunks parsed in parallel
+    uint32_t position_count;        // v lines
+    uint32_t texcoord_count;        // vt lines
+    uint32_t normal_count;          // vn lines
+    uint32_t face_count;            // f lines with at least three corners
+    uint32_t skipped_faces;         // f lines with fewer than three corners
+    uint32_t triangle_count;        // After fan triangulation
+    uint32_t vertex_count;          // After welding
+    uint32_t generated_normals;     // 1 when some corner had no vn
+} ObjLoadStats;
+
+// ============================================================================
+// OBJ FUNCTIONS
+// ============================================================================
+
+// Defaults: serial, OBJ_DEFAULT_CHUNK_BYTES, welding on
+ObjLoadDesc obj_load_desc_default(void);
+
+// Load a Wavefront .obj file into a Model3D with a single Mesh. Groups,
+// objects and materials are ignored; polygons are fan-triangulated and
+// negative (relative) indices are resolved.
+//
+// The file is memory-mapped and split into line-aligned chunks that are
+// parsed in parallel on desc->jobs. Chunk results are merged with prefix
+// sums, then corners are welded into vertices through a shared lock-free
+// hash table. Vertex order is the order of first use, so the result does
+// not depend on the worker count. Texture v is flipped to the top-left
+// origin used by glTF and Metal. When any corner lacks a normal, smooth
+// normals are generated for the whole mesh.
+//
+// Returns a heap-allocated Model3D* on success; NULL on failure.
+// On failure, if out_error is non-NULL, it will receive a heap-allocated error message that the caller must free.
+// desc and out_stats may be NULL.
+Model3D* obj_load_model(const char* filepath, const ObjLoadDesc* desc, ObjLoadStats* out_stats, char** out_error);
+
+// Convenience: free error strings returned by obj_load_model
+void obj_free_error(char* err);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_ASSET_OBJ_H
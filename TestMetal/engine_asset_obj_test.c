@@ -0,0 +1,452 @@
+#include "engine_asset_obj.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* OBJ_PATH = "/tmp/engine_obj_test.obj";
+static const char* BENCH_PATH = "/tmp/engine_obj_bench.obj";
+
+static void free_model(Model3D* model) {
+    if (model) {
+        model3d_free(model);
+        free(model);
+    }
+}
+
+static int write_text(const char* path, const char* text) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return 0;
+    }
+    size_t length = strlen(text);
+    size_t written = fwrite(text, 1, length, f);
+    fclose(f);
+    return written == length;
+}
+
+static Model3D* load_text(const char* text, const ObjLoadDesc* desc, ObjLoadStats* stats, char** err) {
+    if (!write_text(OBJ_PATH, text)) {
+        return NULL;
+    }
+    return obj_load_model(OBJ_PATH, desc, stats, err);
+}
+
+static int near(float a, float b) {
+    return fabsf(a - b) < 1e-5f;
+}
+
+static int meshes_identical(const Mesh* a, const Mesh* b) {
+    return a->vertex_count == b->vertex_count && a->index_count == b->index_count &&
+           memcmp(a->vertices, b->vertices, a->vertex_count * sizeof(Vertex)) == 0 &&
+           memcmp(a->indices, b->indices, a->index_count * sizeof(uint32_t)) == 0;
+}
+
+// Unit cube: 8 positions, 4 texcoords, 6 normals, 6 quads
+static const char* CUBE_OBJ =
+    "# cube\n"
+    "mtllib cube.mtl\n"
+    "o Cube\n"
+    "v -1 -1  1\nv  1 -1  1\nv  1  1  1\nv -1  1  1\n"
+    "v -1 -1 -1\nv  1 -1 -1\nv  1  1 -1\nv -1  1 -1\n"
+    "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+    "vn 0 0 1\nvn 0 0 -1\nvn 1 0 0\nvn -1 0 0\nvn 0 1 0\nvn 0 -1 0\n"
+    "usemtl white\n"
+    "s off\n"
+    "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+    "f 6/1/2 5/2/2 8/3/2 7/4/2\n"
+    "f 2/1/3 6/2/3 7/3/3 3/4/3\n"
+    "f 5/1/4 1/2/4 4/3/4 8/4/4\n"
+    "f 4/1/5 3/2/5 7/3/5 8/4/5\n"
+    "f 5/1/6 6/2/6 2/3/6 1/4/6\n";
+
+// ============================================================================
+// PARSING TESTS
+// ============================================================================
+
+static void test_cube(void) {
+    printf("\n--- Cube Tests ---\n");
+
+    ObjLoadStats stats;
+    char* err = NULL;
+    Model3D* model = load_text(CUBE_OBJ, NULL, &stats, &err);
+    TEST_ASSERT_NOT_NULL(model, "Cube loads");
+    TEST_ASSERT(err == NULL, "No error string on success");
+    if (!model) {
+        obj_free_error(err);
+        return;
+    }
+    const Mesh* mesh = &model->meshes[0];
+    TEST_ASSERT_EQUAL(1u, model->mesh_count, "One mesh");
+    TEST_ASSERT_EQUAL(8u, stats.position_count, "8 positions");
+    TEST_ASSERT_EQUAL(4u, stats.texcoord_count, "4 texcoords");
+    TEST_ASSERT_EQUAL(6u, stats.normal_count, "6 normals");
+    TEST_ASSERT_EQUAL(6u, stats.face_count, "6 faces");
+    TEST_ASSERT_EQUAL(12u, stats.triangle_count, "Quads become 12 triangles");
+    TEST_ASSERT_EQUAL(36u, mesh->index_count, "36 indices");
+    TEST_ASSERT_EQUAL(24u, mesh->vertex_count, "Welded to 24 vertices (4 per face)");
+    TEST_ASSERT_EQUAL(24u, stats.vertex_count, "Stats report the welded count");
+    TEST_ASSERT_EQUAL(0u, stats.generated_normals, "Normals come from the file");
+    TEST_ASSERT(strcmp(model->name, "engine_obj_test.obj") == 0, "Model named after the file");
+
+    // First face: vertices in order of first use, v flipped
+    const Vertex* v = mesh->vertices;
+    TEST_ASSERT(near(v[0].position.x, -1.0f) && near(v[0].position.y, -1.0f) && near(v[0].position.z, 1.0f),
+                "First vertex position");
+    TEST_ASSERT(near(v[0].texcoord.x, 0.0f) && near(v[0].texcoord.y, 1.0f), "Texcoord v is flipped");
+    TEST_ASSERT(near(v[2].texcoord.x, 1.0f) && near(v[2].texcoord.y, 0.0f), "Top-right texcoord flipped to v=0");
+    TEST_ASSERT(near(v[0].normal.z, 1.0f), "First vertex normal");
+    uint32_t expected[6] = {0, 1, 2, 0, 2, 3};
+    TEST_ASSERT(memcmp(mesh->indices, expected, sizeof(expected)) == 0, "Quad fan indices 0 1 2 0 2 3");
+
+    int in_range = 1;
+    for (uint32_t i = 0; i < mesh->index_count; i++) {
+        in_range &= mesh->indices[i] < mesh->vertex_count;
+    }
+    TEST_ASSERT(in_range, "All indices in range");
+    TEST_ASSERT(near(model->bounding_min.x, -1.0f) && near(model->bounding_max.y, 1.0f), "Bounds computed");
+    free_model(model);
+
+    // Welding off: every corner is a vertex
+    ObjLoadDesc desc = obj_load_desc_default();
+    desc.weld = 0;
+    model = load_text(CUBE_OBJ, &desc, &stats, NULL);
+    TEST_ASSERT(model && model->meshes[0].vertex_count == 36, "Without welding every corner is a vertex");
+    TEST_ASSERT(model && model->meshes[0].indices[35] == 35, "Without welding indices are sequential");
+    free_model(model);
+    unlink(OBJ_PATH);
+}
+
+static void test_negative_indices(void) {
+    printf("\n--- Negative Index Tests ---\n");
+
+    const char* absolute =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 0\nvt 1 0\nvt 1 1\nvn 0 0 1\n"
+        "f 1/1/1 2/2/1 3/3/1\n"
+        "v 2 0 0\nv 2 1 0\n"
+        "f 2/2/1 4/1/1 5/3/1\n";
+    const char* relative =
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nvt 0 0\nvt 1 0\nvt 1 1\nvn 0 0 1\n"
+        "f -3/-3/-1 -2/-2/-1 -1/-1/-1\n"
+        "v 2 0 0\nv 2 1 0\n"
+        "f -4/-2/-1 -2/-3/-1 -1/-1/-1\n";
+
+    Model3D* a = load_text(absolute, NULL, NULL, NULL);
+    Model3D* b = load_text(relative, NULL, NULL, NULL);
+    TEST_ASSERT(a && b, "Absolute and relative files load");
+    TEST_ASSERT(a && b && meshes_identical(&a->meshes[0], &b->meshes[0]), "Negative indices resolve like absolute ones");
+    TEST_ASSERT(b && b->meshes[0].vertex_count == 5, "Shared corner welded across faces");
+    TEST_ASSERT(b && near(b->meshes[0].vertices[4].position.x, 2.0f) && near(b->meshes[0].vertices[4].position.y, 1.0f),
+                "-1 after new vertices is the latest one");
+    free_model(a);
+    free_model(b);
+
+    // The same file cut into tiny chunks: relative indices reach into earlier chunks
+    char text[8192];
+    size_t length = 0;
+    for (int i = 0; i < 64; i++) {
+        length += (size_t)snprintf(text + length, sizeof(text) - length, "v %d 0 0\nv %d 1 0\nv %d.5 2 0\n", i, i, i);
+        length += (size_t)snprintf(text + length, sizeof(text) - length, "f -3 -2 -1\n");
+        if (i > 0) {
+            length += (size_t)snprintf(text + length, sizeof(text) - length, "f -6 -3 -5\n");
+        }
+    }
+    ObjLoadDesc desc = obj_load_desc_default();
+    ObjLoadStats whole_stats;
+    ObjLoadStats chunked_stats;
+    Model3D* whole = load_text(text, &desc, &whole_stats, NULL);
+    desc.chunk_bytes = OBJ_MIN_CHUNK_BYTES;
+    Model3D* chunked = load_text(text, &desc, &chunked_stats, NULL);
+    TEST_ASSERT(whole && chunked, "Strip loads whole and chunked");
+    TEST_ASSERT_EQUAL(1u, whole_stats.chunk_count, "Small file is one chunk by default");
+    TEST_ASSERT(chunked_stats.chunk_count > 4, "Minimum chunk size splits the file");
+    TEST_ASSERT(whole && chunked && meshes_identical(&whole->meshes[0], &chunked->meshes[0]),
+                "Chunked parse matches the single-chunk parse");
+    TEST_ASSERT_EQUAL(127u, chunked_stats.triangle_count, "All triangles across chunk boundaries");
+    TEST_ASSERT_EQUAL(1u, chunked_stats.generated_normals, "Missing normals are generated");
+    free_model(whole);
+    free_model(chunked);
+    unlink(OBJ_PATH);
+}
+
+static void test_polygons(void) {
+    printf("\n--- Polygon Tests ---\n");
+
+    // Pentagon, fan around the first corner
+    const char* pentagon =
+        "v 0 0 0\nv 2 0 0\nv 3 1 0\nv 1 2 0\nv -1 1 0\n"
+        "f 1 2 3 4 5\n";
+    ObjLoadStats stats;
+    Model3D* model = load_text(pentagon, NULL, &stats, NULL);
+    TEST_ASSERT_NOT_NULL(model, "Pentagon loads");
+    if (model) {
+        const Mesh* mesh = &model->meshes[0];
+        uint32_t expected[9] = {0, 1, 2, 0, 2, 3, 0, 3, 4};
+        TEST_ASSERT_EQUAL(3u, mesh->triangle_count, "Pentagon becomes 3 triangles");
+        TEST_ASSERT(mesh->index_count == 9 && memcmp(mesh->indices, expected, sizeof(expected)) == 0,
+                    "Fan triangulation order");
+        TEST_ASSERT_EQUAL(1u, stats.generated_normals, "Generated normals flagged");
+        TEST_ASSERT(near(mesh->vertices[0].normal.z, 1.0f), "Generated normal faces +Z for CCW winding");
+        TEST_ASSERT(near(mesh->vertices[0].texcoord.x, 0.0f) && near(mesh->vertices[0].texcoord.y, 0.0f),
+                    "Missing texcoords are zero");
+    }
+    free_model(model);
+
+    // Corner forms, CRLF, tabs, comments, extra components, no final newline
+    const char* mixed =
+        "# header\r\n"
+        "v 0 0 0 1.0\r\n"
+        "v\t1.0e0 0 0 0.5 0.5 0.5\r\n"
+        "v 1 1 0\r\n"
+        "v 0 1 0\r\n"
+        "vt 0.25\r\n"
+        "vt 0.5 0.5 0\r\n"
+        "vn 0 0 1\r\n"
+        "g group\r\n"
+        "l 1 2\r\n"
+        "f 1//1 2//1 3//1 # comment\r\n"
+        "f 1/1 3/2 4/2\r\n"
+        "f 1/ 2/ 3/\r\n"
+        "f 1 2\r\n"
+        "f\t+1 +3 4";
+    model = load_text(mixed, NULL, &stats, NULL);
+    TEST_ASSERT_NOT_NULL(model, "Mixed corner forms load");
+    if (model) {
+        const Mesh* mesh = &model->meshes[0];
+        TEST_ASSERT_EQUAL(4u, stats.face_count, "Four triangles read");
+        TEST_ASSERT_EQUAL(1u, stats.skipped_faces, "Two-corner face skipped");
+        TEST_ASSERT_EQUAL(2u, stats.texcoord_count, "vt with only u accepted");
+        TEST_ASSERT(near(mesh->vertices[1].position.x, 1.0f) && near(mesh->vertices[1].position.z, 0.0f),
+                    "Vertex colours after xyz ignored");
+        TEST_ASSERT_EQUAL(12u, mesh->index_count, "12 indices");
+        TEST_ASSERT(mesh->indices[9] == mesh->indices[6] && mesh->indices[9] != mesh->indices[0],
+                    "Corners weld only when v, vt and vn all match");
+    }
+    free_model(model);
+    unlink(OBJ_PATH);
+}
+
+static void test_parse_floats(void) {
+    printf("\n--- Number Parsing Tests ---\n");
+
+    const char* numbers =
+        "v 3.14159265 -2.5e3 1e-7\n"
+        "v .5 -0.000125 123456789012345678901234\n"
+        "v 1E+2 -0 7.\n"
+        "f 1 2 3\n";
+    Model3D* model = load_text(numbers, NULL, NULL, NULL);
+    TEST_ASSERT_NOT_NULL(model, "Number formats load");
+    if (model) {
+        const Vertex* v = model->meshes[0].vertices;
+        TEST_ASSERT(fabsf(v[0].position.x - 3.14159265f) < 1e-6f, "Decimal fraction");
+        TEST_ASSERT(near(v[0].position.y, -2500.0f), "Negative exponent form");
+        TEST_ASSERT(fabsf(v[0].position.z - 1e-7f) < 1e-12f, "Small exponent");
+        TEST_ASSERT(near(v[1].position.x, 0.5f), "Leading dot");
+        TEST_ASSERT(fabsf(v[1].position.y + 0.000125f) < 1e-10f, "Leading zeros in the fraction");
+        TEST_ASSERT(fabsf(v[1].position.z - 1.23456789e23f) / 1.23456789e23f < 1e-6f, "More than 19 digits");
+        TEST_ASSERT(near(v[2].position.x, 100.0f), "Upper-case exponent with sign");
+        TEST_ASSERT(near(v[2].position.z, 7.0f), "Trailing dot");
+    }
+    free_model(model);
+    unlink(OBJ_PATH);
+}
+
+static void test_errors(void) {
+    printf("\n--- Error Tests ---\n");
+
+    char* err = NULL;
+    Model3D* model = obj_load_model("/tmp/engine_obj_missing.obj", NULL, NULL, &err);
+    TEST_ASSERT(model == NULL && err != NULL, "Missing file reports an error");
+    obj_free_error(err);
+
+    err = NULL;
+    model = obj_load_model(NULL, NULL, NULL, &err);
+    TEST_ASSERT(model == NULL && err != NULL, "NULL path reports an error");
+    obj_free_error(err);
+
+    struct {
+        const char* text;
+        const char* message;
+        const char* expect;
+    } cases[] = {
+        {"", "Empty file rejected", "Empty"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\n", "File without faces rejected", "no faces"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n", "Index past the end rejected", "out of range"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\nf -4 -3 -2\n", "Negative index before the start rejected", "out of range"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1/1 2/1 3/1\n", "Missing texcoord rejected", "out of range"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 0 1 2\n", "Index 0 rejected", "line 4"},
+        {"v 0 0 0\nv 1 zero 0\nv 0 1 0\nf 1 2 3\n", "Bad float rejected with its line", "line 2"},
+        {"v 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n", "Short position rejected", "line 1"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2x 3\n", "Bad corner rejected", "line 4"},
+        {"v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 1 0\nf 1 2 3\n", "Short normal rejected", "line 4"},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        err = NULL;
+        model = load_text(cases[i].text, NULL, NULL, &err);
+        TEST_ASSERT(model == NULL && err != NULL && strstr(err, cases[i].expect) != NULL, cases[i].message);
+        free_model(model);
+        obj_free_error(err);
+    }
+
+    // Errors in a later chunk still report the right line
+    char text[4096];
+    size_t length = 0;
+    for (int i = 0; i < 100; i++) {
+        length += (size_t)snprintf(text + length, sizeof(text) - length, "v %d 0 0\n", i);
+    }
+    length += (size_t)snprintf(text + length, sizeof(text) - length, "f 1 2 bad\n");
+    ObjLoadDesc desc = obj_load_desc_default();
+    desc.chunk_bytes = OBJ_MIN_CHUNK_BYTES;
+    err = NULL;
+    model = load_text(text, &desc, NULL, &err);
+    TEST_ASSERT(model == NULL && err != NULL && strstr(err, "line 101") != NULL, "Chunked error reports line 101");
+    obj_free_error(err);
+    unlink(OBJ_PATH);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+// Photogrammetry-style grid: every vertex has its own texcoord and normal
+static int write_grid(const char* path, uint32_t n, uint64_t* out_bytes) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return 0;
+    }
+    setvbuf(f, NULL, _IOFBF, 1 << 20);
+    uint32_t rng = 0x12345u;
+    for (uint32_t y = 0; y < n; y++) {
+        for (uint32_t x = 0; x < n; x++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            fprintf(f, "v %.6f %.6f %.6f\n", x * 0.01f, (rng & 0xFFFF) / 65536.0f, y * 0.01f);
+        }
+    }
+    for (uint32_t y = 0; y < n; y++) {
+        for (uint32_t x = 0; x < n; x++) {
+            fprintf(f, "vt %.6f %.6f\n", x / (float)(n - 1), y / (float)(n - 1));
+        }
+    }
+    for (uint32_t i = 0; i < n * n; i++) {
+        fprintf(f, "vn 0 1 0\n");
+    }
+    for (uint32_t y = 0; y + 1 < n; y++) {
+        for (uint32_t x = 0; x + 1 < n; x++) {
+            uint32_t a = y * n + x + 1;
+            uint32_t b = a + 1;
+            uint32_t c = a + n + 1;
+            uint32_t d = a + n;
+            fprintf(f, "f %u/%u/%u %u/%u/%u %u/%u/%u %u/%u/%u\n", a, a, a, b, b, b, c, c, c, d, d, d);
+        }
+    }
+    *out_bytes = (uint64_t)ftell(f);
+    fclose(f);
+    return 1;
+}
+
+static double bench_obj(const ObjLoadDesc* desc, uint32_t runs, Model3D** out_model) {
+    Model3D* model = NULL;
+    double best = 1e30;
+    for (uint32_t r = 0; r < runs; r++) {
+        free_model(model);
+        double start = now_ms();
+        model = obj_load_model(BENCH_PATH, desc, NULL, NULL);
+        double ms = now_ms() - start;
+        best = ms < best ? ms : best;
+    }
+    *out_model = model;
+    return best;
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    enum { GRID = 512, RUNS = 3 };
+    uint64_t bytes = 0;
+    TEST_ASSERT(write_grid(BENCH_PATH, GRID, &bytes), "Grid OBJ written");
+
+    ObjLoadDesc desc = obj_load_desc_default();
+    Model3D* serial = NULL;
+    double serial_ms = bench_obj(&desc, RUNS, &serial);
+    TEST_ASSERT(serial && serial->meshes[0].vertex_count == GRID * GRID, "Grid welds back to one vertex per v");
+    TEST_ASSERT(serial && serial->meshes[0].triangle_count == (GRID - 1) * (GRID - 1) * 2, "Grid triangle count");
+    printf("  Grid (%u vertices): %.1f MB in %.1f ms serial (%.0f MB/s)\n", GRID * GRID, bytes / (1024.0 * 1024.0),
+           serial_ms, bytes / (serial_ms * 1000.0));
+
+    uint32_t cores = job_system_cpu_count();
+    uint32_t workers = cores < 4 ? 4 : cores;
+    JobSystemHandle jobs = job_system_create(workers);
+    desc.jobs = jobs;
+    Model3D* parallel = NULL;
+    double parallel_ms = bench_obj(&desc, RUNS, &parallel);
+    TEST_ASSERT(serial && parallel && meshes_identical(&serial->meshes[0], &parallel->meshes[0]),
+                "Parallel load is identical to the serial load");
+    printf("  %u workers on %u cores: %.1f ms (%.0f MB/s, %.2fx)\n", workers, cores, parallel_ms,
+           bytes / (parallel_ms * 1000.0), serial_ms / parallel_ms);
+    if (cores >= 4) {
+        TEST_ASSERT(parallel_ms * 1.5 < serial_ms, "Parsing scales with cores");
+    } else {
+        printf("  Fewer than 4 cores, skipping the scaling check\n");
+    }
+
+    free_model(serial);
+    free_model(parallel);
+    job_system_destroy(jobs);
+    unlink(BENCH_PATH);
+}
+
+int main(void) {
+    printf("Starting OBJ Loader Unit Tests\n");
+    printf("==============================\n");
+
+    test_cube();
+    test_negative_indices();
+    test_polygons();
+    test_parse_floats();
+    test_errors();
+    test_performance();
+
+    printf("\n==============================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
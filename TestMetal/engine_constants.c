@@ -0,0 +1,111 @@
+#include "engine_constants.h"
+#include <string.h>
+
+// The shader structs in Shaders.metal depend on these sizes
+typedef char frame_constants_size_check[(sizeof(FrameConstants) == 16) ? 1 : -1];
+typedef char view_constants_size_check[(sizeof(ViewConstants) == 208) ? 1 : -1];
+typedef char draw_constants_size_check[(sizeof(DrawConstants) == 96) ? 1 : -1];
+
+// ============================================================================
+// LAYOUT
+// ============================================================================
+
+static size_t constants_align(size_t value) {
+    return (value + CONSTANTS_BLOCK_ALIGNMENT - 1) & ~(size_t)(CONSTANTS_BLOCK_ALIGNMENT - 1);
+}
+
+ConstantsLayout constants_layout(uint32_t draw_capacity) {
+    ConstantsLayout layout;
+    layout.frame_offset = 0;
+    layout.view_offset = constants_align(sizeof(FrameConstants));
+    layout.draw_offset = constants_align(layout.view_offset + sizeof(ViewConstants));
+    layout.size = constants_align(layout.draw_offset + (size_t)draw_capacity * sizeof(DrawConstants));
+    layout.draw_capacity = draw_capacity;
+    return layout;
+}
+
+// ============================================================================
+// PACKING
+// ============================================================================
+
+void constants_pack_frame(FrameConstants* out, float time, float delta_time, uint32_t frame_index) {
+    out->time = time;
+    out->delta_time = delta_time;
+    out->frame_index = frame_index;
+    out->padding = 0;
+}
+
+void constants_pack_view(ViewConstants* out, mat4_t view, mat4_t projection, vec3_t camera_position) {
+    out->view = view;
+    out->projection = projection;
+    out->view_projection = mat4_mul_mat4(view, projection);
+    out->camera_position = vec4(camera_position.x, camera_position.y, camera_position.z, 1.0f);
+}
+
+// The inverse transpose of the linear part is its cofactor matrix over the
+// determinant, and the cofactor rows are cross products of the other rows
+void constants_pack_draw(DrawConstants* out, mat34_t model) {
+    vec3_t r0 = vec3(model.x.x, model.x.y, model.x.z);
+    vec3_t r1 = vec3(model.y.x, model.y.y, model.y.z);
+    vec3_t r2 = vec3(model.z.x, model.z.y, model.z.z);
+    vec3_t n0 = vec3_cross(r1, r2);
+    vec3_t n1 = vec3_cross(r2, r0);
+    vec3_t n2 = vec3_cross(r0, r1);
+    float det = vec3_dot(r0, n0);
+    float inv_det = fabsf(det) < 1e-12f ? 1.0f : 1.0f / det;
+
+    out->model = model;
+    out->normal.x = vec4(n0.x * inv_det, n0.y * inv_det, n0.z * inv_det, 0.0f);
+    out->normal.y = vec4(n1.x * inv_det, n1.y * inv_det, n1.z * inv_det, 0.0f);
+    out->normal.z = vec4(n2.x * inv_det, n2.y * inv_det, n2.z * inv_det, 0.0f);
+}
+
+void constants_pack_draws(DrawConstants* out, const mat34_t* models, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        constants_pack_draw(&out[i], models[i]);
+    }
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+void constants_writer_begin(ConstantsWriter* writer, void* base, ConstantsLayout layout) {
+    writer->base = (uint8_t*)base;
+    writer->layout = layout;
+    writer->draw_count = 0;
+    writer->bytes_written = 0;
+}
+
+void constants_writer_set_frame(ConstantsWriter* writer, float time, float delta_time, uint32_t frame_index) {
+    FrameConstants frame;
+    constants_pack_frame(&frame, time, delta_time, frame_index);
+    memcpy(writer->base + writer->layout.frame_offset, &frame, sizeof(frame));
+    writer->bytes_written += sizeof(frame);
+}
+
+void constants_writer_set_view(ConstantsWriter* writer, mat4_t view, mat4_t projection, vec3_t camera_position) {
+    ViewConstants constants;
+    constants_pack_view(&constants, view, projection, camera_position);
+    memcpy(writer->base + writer->layout.view_offset, &constants, sizeof(constants));
+    writer->bytes_written += sizeof(constants);
+}
+
+uint32_t constants_writer_push_draw(ConstantsWriter* writer, mat34_t model) {
+    if (writer->draw_count >= writer->layout.draw_capacity) {
+        return CONSTANTS_INVALID_DRAW;
+    }
+
+    // Packed on the stack and copied once so the shared buffer is only
+    // ever written, never read back
+    DrawConstants draw;
+    constants_pack_draw(&draw, model);
+    uint32_t index = writer->draw_count++;
+    memcpy(writer->base + constants_writer_draw_offset(writer, index), &draw, sizeof(draw));
+    writer->bytes_written += sizeof(draw);
+    return index;
+}
+
+size_t constants_writer_draw_offset(const ConstantsWriter* writer, uint32_t draw) {
+    return writer->layout.draw_offset + (size_t)draw * sizeof(DrawConstants);
+}
@@ -0,0 +1,96 @@
+#ifndef ENGINE_CONSTANTS_H
+#define ENGINE_CONSTANTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================================
+// CONSTANTS CONFIGURATION
+// ============================================================================
+
+// Offset alignment for blocks bound in the constant address space (macOS)
+#define CONSTANTS_BLOCK_ALIGNMENT 256
+#define CONSTANTS_INVALID_DRAW 0xFFFFFFFFu
+
+// ============================================================================
+// CONSTANTS DATA STRUCTURES
+// ============================================================================
+
+// Written once per frame. 16 bytes.
+typedef struct {
+    float time;
+    float delta_time;
+    uint32_t frame_index;
+    uint32_t padding;
+} FrameConstants;
+
+// Written once per camera. Row-vector matrices, which Metal reads as the
+// column-major float4x4 that maps a column vector the same way. 208 bytes.
+typedef struct {
+    mat4_t view;
+    mat4_t projection;
+    mat4_t view_projection;     // view, then projection
+    vec4_t camera_position;     // w = 1
+} ViewConstants;
+
+// Written once per draw, packed back to back. Both transforms are float3x4
+// in the shader (float4(p, 1) * model). 96 bytes.
+typedef struct {
+    mat34_t model;
+    mat34_t normal;             // Inverse transpose of the linear part, w = 0
+} DrawConstants;
+
+// Where each block sits in one in-flight copy of the constant buffer:
+// [frame][view][draw 0][draw 1]...
+typedef struct {
+    size_t frame_offset;
+    size_t view_offset;
+    size_t draw_offset;
+    size_t size;
+    uint32_t draw_capacity;
+} ConstantsLayout;
+
+// Fills one in-flight copy and counts the bytes it writes
+typedef struct {
+    uint8_t* base;
+    ConstantsLayout layout;
+    uint32_t draw_count;
+    uint64_t bytes_written;
+} ConstantsWriter;
+
+// ============================================================================
+// CONSTANTS FUNCTIONS
+// ============================================================================
+
+ConstantsLayout constants_layout(uint32_t draw_capacity);
+
+// Per-block packing
+void constants_pack_frame(FrameConstants* out, float time, float delta_time, uint32_t frame_index);
+void constants_pack_view(ViewConstants* out, mat4_t view, mat4_t projection, vec3_t camera_position);
+void constants_pack_draw(DrawConstants* out, mat34_t model);
+
+// Contiguous draw array from an array of world transforms
+void constants_pack_draws(DrawConstants* out, const mat34_t* models, uint32_t count);
+
+// Writer over a buffer of at least layout.size bytes; begin resets the draw
+// count and byte counter for a new frame
+void constants_writer_begin(ConstantsWriter* writer, void* base, ConstantsLayout layout);
+void constants_writer_set_frame(ConstantsWriter* writer, float time, float delta_time, uint32_t frame_index);
+void constants_writer_set_view(ConstantsWriter* writer, mat4_t view, mat4_t projection, vec3_t camera_position);
+
+// Appends a draw and returns its index (CONSTANTS_INVALID_DRAW when full)
+uint32_t constants_writer_push_draw(ConstantsWriter* writer, mat34_t model);
+
+// Byte offset of a draw from the start of the buffer, for binding
+size_t constants_writer_draw_offset(const ConstantsWriter* writer, uint32_t draw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_CONSTANTS_H
@@ -0,0 +1,293 @@
+#include "engine_constants.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int near(float a, float b) {
+    return fabsf(a - b) < 1e-4f;
+}
+
+static int mat4_near(mat4_t a, mat4_t b) {
+    const float* pa = (const float*)&a;
+    const float* pb = (const float*)&b;
+    for (int i = 0; i < 16; i++) {
+        if (!near(pa[i], pb[i])) return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// LEGACY UNIFORMS
+// ============================================================================
+
+// The single MetalUniforms block engine_metal.m used to rebuild for every
+// draw, padded to kAlignedUniformsSize
+typedef struct {
+    float projectionMatrix[16];
+    float modelViewMatrix[16];
+    float modelMatrix[16];
+    float viewMatrix[16];
+    float normalMatrix[16];
+    float cameraPosition[3];
+    float time;
+} LegacyUniforms;
+
+static const size_t kLegacyAlignedSize = (sizeof(LegacyUniforms) & ~0xFF) + 0x100;
+
+// What the old per-entity path wrote: the whole block, with the model-view
+// and normal matrices recomputed from full 4x4 matrices
+static uint64_t legacy_write_frame(uint8_t* buffer, const mat4_t* models, uint32_t count, mat4_t view,
+                                   mat4_t projection, vec3_t camera, float time) {
+    uint64_t bytes = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        LegacyUniforms uniforms;
+        mat4_t model_view = mat4_mul_mat4(models[i], view);
+        mat4_t normal = mat4_transpose(mat4_inverse(model_view));
+        memcpy(uniforms.projectionMatrix, &projection, sizeof(mat4_t));
+        memcpy(uniforms.modelViewMatrix, &model_view, sizeof(mat4_t));
+        memcpy(uniforms.modelMatrix, &models[i], sizeof(mat4_t));
+        memcpy(uniforms.viewMatrix, &view, sizeof(mat4_t));
+        memcpy(uniforms.normalMatrix, &normal, sizeof(mat4_t));
+        uniforms.cameraPosition[0] = camera.x;
+        uniforms.cameraPosition[1] = camera.y;
+        uniforms.cameraPosition[2] = camera.z;
+        uniforms.time = time;
+        memcpy(buffer + (size_t)i * kLegacyAlignedSize, &uniforms, sizeof(uniforms));
+        bytes += sizeof(uniforms);
+    }
+    return bytes;
+}
+
+// ============================================================================
+// LAYOUT AND PACKING TESTS
+// ============================================================================
+
+static void test_layout(void) {
+    printf("\n--- Layout Tests ---\n");
+
+    TEST_ASSERT_EQUAL((size_t)16, sizeof(FrameConstants), "FrameConstants is 16 bytes");
+    TEST_ASSERT_EQUAL((size_t)208, sizeof(ViewConstants), "ViewConstants is 208 bytes");
+    TEST_ASSERT_EQUAL((size_t)96, sizeof(DrawConstants), "DrawConstants is 96 bytes");
+
+    ConstantsLayout layout = constants_layout(10);
+    TEST_ASSERT(layout.frame_offset % CONSTANTS_BLOCK_ALIGNMENT == 0 &&
+                layout.view_offset % CONSTANTS_BLOCK_ALIGNMENT == 0 &&
+                layout.draw_offset % CONSTANTS_BLOCK_ALIGNMENT == 0, "Blocks start on the constant alignment");
+    TEST_ASSERT(layout.view_offset >= sizeof(FrameConstants) &&
+                layout.draw_offset >= layout.view_offset + sizeof(ViewConstants), "Blocks do not overlap");
+    TEST_ASSERT(layout.size >= layout.draw_offset + 10 * sizeof(DrawConstants) &&
+                layout.size % CONSTANTS_BLOCK_ALIGNMENT == 0, "Size covers the draws and stays aligned");
+    TEST_ASSERT_EQUAL(10u, layout.draw_capacity, "Capacity recorded");
+}
+
+static void test_packing(void) {
+    printf("\n--- Packing Tests ---\n");
+
+    mat4_t view = mat4_look_at(vec3(0.0f, 2.0f, 8.0f), vec3(0.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f));
+    mat4_t projection = mat4_perspective(1.1f, 16.0f / 9.0f, 0.1f, 100.0f);
+    ViewConstants view_constants;
+    constants_pack_view(&view_constants, view, projection, vec3(0.0f, 2.0f, 8.0f));
+    TEST_ASSERT(mat4_near(view_constants.view_projection, mat4_mul_mat4(view, projection)),
+                "View-projection is view then projection");
+    TEST_ASSERT(near(view_constants.camera_position.y, 2.0f) && near(view_constants.camera_position.w, 1.0f),
+                "Camera position stored with w = 1");
+
+    FrameConstants frame;
+    constants_pack_frame(&frame, 1.5f, 0.016f, 42);
+    TEST_ASSERT(near(frame.time, 1.5f) && frame.frame_index == 42 && frame.padding == 0, "Frame constants packed");
+
+    // Rotation: the normal matrix is the rotation itself
+    mat34_t rotation = mat34_from_trs(vec3(1.0f, 2.0f, 3.0f), quat_from_axis_angle(vec3(0.0f, 1.0f, 0.0f), 0.7f),
+                                      vec3(1.0f, 1.0f, 1.0f));
+    DrawConstants draw;
+    constants_pack_draw(&draw, rotation);
+    TEST_ASSERT(memcmp(&draw.model, &rotation, sizeof(mat34_t)) == 0, "Model transform stored unchanged");
+    TEST_ASSERT(near(draw.normal.x.x, rotation.x.x) && near(draw.normal.x.z, rotation.x.z) &&
+                near(draw.normal.z.x, rotation.z.x) && draw.normal.x.w == 0.0f,
+                "Rigid transform: normal matrix equals the rotation");
+
+    // Non-uniform scale: normals must stay perpendicular to transformed tangents
+    mat34_t skewed = mat34_from_trs(vec3(0.0f, 0.0f, 0.0f), quat_from_axis_angle(vec3_normalize(vec3(1.0f, 1.0f, 0.0f)), 0.4f),
+                                    vec3(3.0f, 0.5f, 1.0f));
+    constants_pack_draw(&draw, skewed);
+    vec3_t n = vec3_normalize(vec3(1.0f, 2.0f, -1.0f));
+    vec3_t t = vec3_normalize(vec3_cross(n, vec3(0.0f, 0.0f, 1.0f)));
+    vec3_t world_n = mat34_transform_vector(draw.normal, n);
+    vec3_t world_t = mat34_transform_vector(skewed, t);
+    TEST_ASSERT(fabsf(vec3_dot(world_n, world_t)) < 1e-4f, "Scaled transform: normal stays perpendicular to surface");
+
+    // Mirrored transform keeps the normal facing out
+    mat34_t mirrored = mat34_from_trs(vec3(0.0f, 0.0f, 0.0f), quat_identity(), vec3(-1.0f, 1.0f, 1.0f));
+    constants_pack_draw(&draw, mirrored);
+    vec3_t mirrored_n = mat34_transform_vector(draw.normal, vec3(1.0f, 0.0f, 0.0f));
+    TEST_ASSERT(near(mirrored_n.x, -1.0f), "Mirrored transform: normal follows the mirror");
+
+    mat34_t models[3] = {rotation, skewed, mirrored};
+    DrawConstants draws[3];
+    constants_pack_draws(draws, models, 3);
+    constants_pack_draw(&draw, skewed);
+    TEST_ASSERT(memcmp(&draws[1], &draw, sizeof(draw)) == 0, "Batch packing matches single packing");
+}
+
+static void test_writer(void) {
+    printf("\n--- Writer Tests ---\n");
+
+    ConstantsLayout layout = constants_layout(4);
+    uint8_t* buffer = (uint8_t*)calloc(1, layout.size);
+    TEST_ASSERT_NOT_NULL(buffer, "Buffer allocated");
+
+    ConstantsWriter writer;
+    constants_writer_begin(&writer, buffer, layout);
+    constants_writer_set_frame(&writer, 2.0f, 0.01f, 7);
+    constants_writer_set_view(&writer, mat4_identity(), mat4_identity(), vec3(0.0f, 0.0f, 5.0f));
+
+    uint32_t indices[5];
+    for (uint32_t i = 0; i < 5; i++) {
+        indices[i] = constants_writer_push_draw(&writer, mat34_from_trs(vec3((float)i, 0.0f, 0.0f), quat_identity(),
+                                                                         vec3(1.0f, 1.0f, 1.0f)));
+    }
+    TEST_ASSERT(indices[0] == 0 && indices[3] == 3, "Draws get consecutive indices");
+    TEST_ASSERT_EQUAL(CONSTANTS_INVALID_DRAW, indices[4], "Draw past capacity is refused");
+    TEST_ASSERT_EQUAL(4u, writer.draw_count, "Refused draw is not counted");
+    TEST_ASSERT_EQUAL((uint64_t)(sizeof(FrameConstants) + sizeof(ViewConstants) + 4 * sizeof(DrawConstants)),
+                      writer.bytes_written, "Bytes written counts each block once");
+    TEST_ASSERT_EQUAL(constants_writer_draw_offset(&writer, 0) + 2 * sizeof(DrawConstants),
+                      constants_writer_draw_offset(&writer, 2), "Draws are contiguous");
+
+    const FrameConstants* frame = (const FrameConstants*)(buffer + layout.frame_offset);
+    const ViewConstants* view = (const ViewConstants*)(buffer + layout.view_offset);
+    const DrawConstants* draws = (const DrawConstants*)(buffer + layout.draw_offset);
+    TEST_ASSERT(frame->frame_index == 7 && near(view->camera_position.z, 5.0f), "Frame and view blocks in place");
+    TEST_ASSERT(near(draws[3].model.x.w, 3.0f), "Draw block holds the model translation");
+
+    constants_writer_begin(&writer, buffer, layout);
+    TEST_ASSERT(writer.draw_count == 0 && writer.bytes_written == 0, "Begin resets the writer");
+
+    free(buffer);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t count = 10000;
+    const int frames = 20;
+    mat34_t* affine = (mat34_t*)malloc(count * sizeof(mat34_t));
+    mat4_t* models = (mat4_t*)malloc(count * sizeof(mat4_t));
+    uint8_t* legacy = (uint8_t*)malloc(count * kLegacyAlignedSize);
+    ConstantsLayout layout = constants_layout(count);
+    uint8_t* split = (uint8_t*)malloc(layout.size);
+    TEST_ASSERT(affine && models && legacy && split, "10k-entity scene allocated");
+
+    for (uint32_t i = 0; i < count; i++) {
+        vec3_t position = vec3((float)(i % 100) * 2.0f, (float)(i / 100 % 10), (float)(i / 1000) * 2.0f);
+        quat_t rotation = quat_from_axis_angle(vec3(0.0f, 1.0f, 0.0f), (float)i * 0.01f);
+        affine[i] = mat34_from_trs(position, rotation, vec3(1.0f, 1.0f + (float)(i % 3) * 0.5f, 1.0f));
+        models[i] = mat34_to_mat4(affine[i]);
+    }
+    mat4_t view = mat4_look_at(vec3(100.0f, 20.0f, -30.0f), vec3(100.0f, 0.0f, 10.0f), vec3(0.0f, 1.0f, 0.0f));
+    mat4_t projection = mat4_perspective(1.1f, 16.0f / 9.0f, 0.1f, 500.0f);
+    vec3_t camera = vec3(100.0f, 20.0f, -30.0f);
+
+    uint64_t legacy_bytes = 0;
+    double start = now_ms();
+    for (int frame = 0; frame < frames; frame++) {
+        legacy_bytes = legacy_write_frame(legacy, models, count, view, projection, camera, (float)frame);
+    }
+    double legacy_ms = (now_ms() - start) / frames;
+
+    ConstantsWriter writer;
+    start = now_ms();
+    for (int frame = 0; frame < frames; frame++) {
+        constants_writer_begin(&writer, split, layout);
+        constants_writer_set_frame(&writer, (float)frame, 1.0f / 60.0f, (uint32_t)frame);
+        constants_writer_set_view(&writer, view, projection, camera);
+        for (uint32_t i = 0; i < count; i++) {
+            constants_writer_push_draw(&writer, affine[i]);
+        }
+    }
+    double split_ms = (now_ms() - start) / frames;
+
+    printf("  Per-draw uniforms: %llu bytes/frame written (%zu-byte blocks, %zu-byte slots, %zu bytes of buffer), %.3f ms\n",
+           (unsigned long long)legacy_bytes, sizeof(LegacyUniforms), kLegacyAlignedSize,
+           (size_t)count * kLegacyAlignedSize, legacy_ms);
+    printf("  Split constants:   %llu bytes/frame written (%zu + %zu + %u x %zu, %zu bytes of buffer), %.3f ms\n",
+           (unsigned long long)writer.bytes_written, sizeof(FrameConstants), sizeof(ViewConstants), count,
+           sizeof(DrawConstants), layout.size, split_ms);
+    printf("  Reduction: %.1fx bytes written, %.1fx buffer footprint\n",
+           (double)legacy_bytes / (double)writer.bytes_written,
+           (double)(count * kLegacyAlignedSize) / (double)layout.size);
+
+    TEST_ASSERT(writer.bytes_written * 3 < legacy_bytes, "Split constants write under a third of the bytes");
+
+    // Both paths must still agree on where vertices land
+    const DrawConstants* draws = (const DrawConstants*)(split + layout.draw_offset);
+    const LegacyUniforms* last = (const LegacyUniforms*)(legacy + (size_t)(count - 1) * kLegacyAlignedSize);
+    vec3_t p = vec3(0.5f, -0.25f, 1.0f);
+    vec3_t world = mat34_transform_point(draws[count - 1].model, p);
+    mat4_t legacy_model;
+    memcpy(&legacy_model, last->modelMatrix, sizeof(mat4_t));
+    vec4_t legacy_world = vec4_add(vec4_add(vec4_scale(legacy_model.x, p.x), vec4_scale(legacy_model.y, p.y)),
+                                   vec4_add(vec4_scale(legacy_model.z, p.z), legacy_model.w));
+    TEST_ASSERT(near(world.x, legacy_world.x) && near(world.y, legacy_world.y) && near(world.z, legacy_world.z),
+                "Split and legacy model transforms agree");
+
+    free(affine);
+    free(models);
+    free(legacy);
+    free(split);
+}
+
+int main(void) {
+    printf("Starting Shader Constants Unit Tests\n");
+    printf("====================================\n");
+
+    test_layout();
+    test_packing();
+    test_writer();
+    test_performance();
+
+    printf("\n====================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,406 @@
+#include "engine_frame_graph.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// RESOURCE SIZES
+// ============================================================================
+
+uint32_t frame_graph_format_bytes(FrameGraphFormat format) {
+    static const uint32_t bytes[FRAME_GRAPH_FORMAT_COUNT] = {
+        1,  // R8
+        4,  // RGBA8
+        4,  // RG16F
+        4,  // R32F
+        8,  // RGBA16F
+        16, // RGBA32F
+        4,  // DEPTH32F
+        8,  // DEPTH32F_STENCIL8 (stencil padded to a separate 32-bit plane)
+    };
+    return (uint32_t)format < FRAME_GRAPH_FORMAT_COUNT ? bytes[format] : 0;
+}
+
+uint64_t frame_graph_resource_size(const FrameGraphResourceDesc* desc) {
+    uint64_t texel_bytes = frame_graph_format_bytes(desc->format);
+    uint32_t mips = desc->mip_levels ? desc->mip_levels : 1;
+    uint64_t layers = desc->array_layers ? desc->array_layers : 1;
+    uint64_t samples = desc->samples ? desc->samples : 1;
+
+    uint64_t bytes = 0;
+    uint32_t width = desc->width;
+    uint32_t height = desc->height;
+    for (uint32_t mip = 0; mip < mips; mip++) {
+        bytes += (uint64_t)width * height * texel_bytes;
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes * layers * samples;
+}
+
+static uint64_t frame_graph_align(uint64_t size) {
+    return (size + FRAME_GRAPH_PLACEMENT_ALIGNMENT - 1) & ~(uint64_t)(FRAME_GRAPH_PLACEMENT_ALIGNMENT - 1);
+}
+
+// ============================================================================
+// GRAPH CONSTRUCTION
+// ============================================================================
+
+FrameGraph* frame_graph_create(void) {
+    FrameGraph* graph = (FrameGraph*)calloc(1, sizeof(FrameGraph));
+    if (!graph) {
+        fprintf(stderr, "Error: Failed to allocate memory for frame graph\n");
+    }
+    return graph;
+}
+
+void frame_graph_destroy(FrameGraph* graph) {
+    free(graph);
+}
+
+void frame_graph_reset(FrameGraph* graph) {
+    if (!graph) {
+        return;
+    }
+    graph->pass_count = 0;
+    graph->resource_count = 0;
+    graph->heap_count = 0;
+    memset(&graph->stats, 0, sizeof(graph->stats));
+    graph->compiled = 0;
+}
+
+static uint32_t frame_graph_add_resource(FrameGraph* graph, const char* name, const FrameGraphResourceDesc* desc,
+                                         int imported) {
+    if (!graph || !desc || frame_graph_format_bytes(desc->format) == 0 || desc->width == 0 || desc->height == 0) {
+        fprintf(stderr, "Error: Invalid frame graph resource '%s'\n", name ? name : "");
+        return FRAME_GRAPH_INVALID;
+    }
+    if (graph->resource_count >= FRAME_GRAPH_MAX_RESOURCES) {
+        fprintf(stderr, "Error: Frame graph resource limit reached (%d)\n", FRAME_GRAPH_MAX_RESOURCES);
+        return FRAME_GRAPH_INVALID;
+    }
+
+    uint32_t handle = graph->resource_count++;
+    FrameGraphResource* resource = &graph->resources[handle];
+    memset(resource, 0, sizeof(*resource));
+    snprintf(resource->name, sizeof(resource->name), "%s", name ? name : "");
+    resource->desc = *desc;
+    resource->imported = imported;
+    resource->size = imported ? 0 : frame_graph_align(frame_graph_resource_size(desc));
+    resource->first_pass = FRAME_GRAPH_INVALID;
+    resource->last_pass = FRAME_GRAPH_INVALID;
+    resource->heap = FRAME_GRAPH_INVALID;
+    resource->aliases = FRAME_GRAPH_INVALID;
+    graph->compiled = 0;
+    return handle;
+}
+
+uint32_t frame_graph_create_resource(FrameGraph* graph, const char* name, const FrameGraphResourceDesc* desc) {
+    return frame_graph_add_resource(graph, name, desc, 0);
+}
+
+uint32_t frame_graph_import_resource(FrameGraph* graph, const char* name, const FrameGraphResourceDesc* desc) {
+    return frame_graph_add_resource(graph, name, desc, 1);
+}
+
+uint32_t frame_graph_add_pass(FrameGraph* graph, const char* name, int side_effect) {
+    if (!graph) {
+        return FRAME_GRAPH_INVALID;
+    }
+    if (graph->pass_count >= FRAME_GRAPH_MAX_PASSES) {
+        fprintf(stderr, "Error: Frame graph pass limit reached (%d)\n", FRAME_GRAPH_MAX_PASSES);
+        return FRAME_GRAPH_INVALID;
+    }
+
+    uint32_t handle = graph->pass_count++;
+    FrameGraphPass* pass = &graph->passes[handle];
+    memset(pass, 0, sizeof(*pass));
+    snprintf(pass->name, sizeof(pass->name), "%s", name ? name : "");
+    pass->side_effect = side_effect;
+    graph->compiled = 0;
+    return handle;
+}
+
+static int frame_graph_add_access(FrameGraph* graph, uint32_t pass, uint32_t resource, int write) {
+    if (!graph || pass >= graph->pass_count || resource >= graph->resource_count) {
+        fprintf(stderr, "Error: Invalid frame graph pass %u or resource %u\n", pass, resource);
+        return 0;
+    }
+
+    FrameGraphPass* p = &graph->passes[pass];
+    uint32_t* list = write ? p->writes : p->reads;
+    uint32_t* count = write ? &p->write_count : &p->read_count;
+    for (uint32_t i = 0; i < *count; i++) {
+        if (list[i] == resource) {
+            return 1;
+        }
+    }
+    if (*count >= FRAME_GRAPH_MAX_PASS_RESOURCES) {
+        fprintf(stderr, "Error: Pass '%s' uses more than %d resources\n", p->name, FRAME_GRAPH_MAX_PASS_RESOURCES);
+        return 0;
+    }
+    list[(*count)++] = resource;
+    graph->compiled = 0;
+    return 1;
+}
+
+int frame_graph_pass_read(FrameGraph* graph, uint32_t pass, uint32_t resource) {
+    return frame_graph_add_access(graph, pass, resource, 0);
+}
+
+int frame_graph_pass_write(FrameGraph* graph, uint32_t pass, uint32_t resource) {
+    return frame_graph_add_access(graph, pass, resource, 1);
+}
+
+// ============================================================================
+// COMPILATION
+// ============================================================================
+
+// Every read of a transient resource needs an earlier write
+static int frame_graph_validate(const FrameGraph* graph) {
+    uint8_t written[FRAME_GRAPH_MAX_RESOURCES];
+    memset(written, 0, sizeof(written));
+
+    for (uint32_t p = 0; p < graph->pass_count; p++) {
+        const FrameGraphPass* pass = &graph->passes[p];
+        for (uint32_t i = 0; i < pass->read_count; i++) {
+            const FrameGraphResource* resource = &graph->resources[pass->reads[i]];
+            if (!resource->imported && !written[pass->reads[i]]) {
+                fprintf(stderr, "Error: Pass '%s' reads '%s' before any pass writes it\n", pass->name,
+                        resource->name);
+                return 0;
+            }
+        }
+        for (uint32_t i = 0; i < pass->write_count; i++) {
+            written[pass->writes[i]] = 1;
+        }
+    }
+    return 1;
+}
+
+// Reference-count culling: a pass survives if something reads what it
+// writes, it writes an imported resource, or it has side effects
+static void frame_graph_cull(FrameGraph* graph) {
+    uint32_t stack[FRAME_GRAPH_MAX_RESOURCES];
+    uint32_t stack_size = 0;
+
+    for (uint32_t r = 0; r < graph->resource_count; r++) {
+        graph->resources[r].ref_count = 0;
+    }
+    for (uint32_t p = 0; p < graph->pass_count; p++) {
+        FrameGraphPass* pass = &graph->passes[p];
+        pass->culled = 0;
+        pass->ref_count = pass->write_count;
+        int keep = pass->side_effect;
+        for (uint32_t i = 0; i < pass->write_count; i++) {
+            keep |= graph->resources[pass->writes[i]].imported;
+        }
+        if (keep) {
+            pass->ref_count++; // Never drops to zero
+        }
+        for (uint32_t i = 0; i < pass->read_count; i++) {
+            graph->resources[pass->reads[i]].ref_count++;
+        }
+    }
+
+    for (uint32_t r = 0; r < graph->resource_count; r++) {
+        if (graph->resources[r].ref_count == 0 && !graph->resources[r].imported) {
+            stack[stack_size++] = r;
+        }
+    }
+
+    while (stack_size > 0) {
+        uint32_t r = stack[--stack_size];
+        for (uint32_t p = 0; p < graph->pass_count; p++) {
+            FrameGraphPass* pass = &graph->passes[p];
+            if (pass->culled) {
+                continue;
+            }
+            for (uint32_t i = 0; i < pass->write_count; i++) {
+                if (pass->writes[i] != r) {
+                    continue;
+                }
+                if (--pass->ref_count == 0) {
+                    pass->culled = 1;
+                    for (uint32_t j = 0; j < pass->read_count; j++) {
+                        FrameGraphResource* input = &graph->resources[pass->reads[j]];
+                        if (--input->ref_count == 0 && !input->imported) {
+                            stack[stack_size++] = pass->reads[j];
+                        }
+                    }
+                }
+                break;
+            }
+        }
+    }
+}
+
+static void frame_graph_extend_lifetime(FrameGraphResource* resource, uint32_t pass) {
+    if (resource->first_pass == FRAME_GRAPH_INVALID) {
+        resource->first_pass = pass;
+    }
+    resource->last_pass = pass;
+}
+
+static int compare_lifetimes(const void* a, const void* b, const FrameGraph* graph) {
+    const FrameGraphResource* ra = &graph->resources[*(const uint32_t*)a];
+    const FrameGraphResource* rb = &graph->resources[*(const uint32_t*)b];
+    if (ra->first_pass != rb->first_pass) {
+        return ra->first_pass < rb->first_pass ? -1 : 1;
+    }
+    if (ra->size != rb->size) {
+        return ra->size > rb->size ? -1 : 1; // Larger first, so small ones fill in behind them
+    }
+    return (*(const uint32_t*)a > *(const uint32_t*)b) - (*(const uint32_t*)a < *(const uint32_t*)b);
+}
+
+// Insertion sort: qsort has no context pointer in C99, and the lists are short
+static void sort_by_lifetime(uint32_t* order, uint32_t count, const FrameGraph* graph) {
+    for (uint32_t i = 1; i < count; i++) {
+        uint32_t value = order[i];
+        uint32_t j = i;
+        while (j > 0 && compare_lifetimes(&value, &order[j - 1], graph) < 0) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = value;
+    }
+}
+
+// Interval-graph coloring: in start order, each resource goes to a heap
+// whose previous occupant is already dead. Among those, take the smallest
+// heap that fits it, else the largest (so it grows the least); open a new
+// heap only when every heap is still in use.
+static void frame_graph_assign_heaps(FrameGraph* graph) {
+    uint32_t order[FRAME_GRAPH_MAX_RESOURCES];
+    uint32_t count = 0;
+    for (uint32_t r = 0; r < graph->resource_count; r++) {
+        const FrameGraphResource* resource = &graph->resources[r];
+        if (!resource->imported && resource->first_pass != FRAME_GRAPH_INVALID) {
+            order[count++] = r;
+        }
+    }
+    sort_by_lifetime(order, count, graph);
+
+    graph->heap_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        FrameGraphResource* resource = &graph->resources[order[i]];
+        uint32_t fit = FRAME_GRAPH_INVALID;
+        uint32_t largest = FRAME_GRAPH_INVALID;
+        for (uint32_t h = 0; h < graph->heap_count; h++) {
+            const FrameGraphHeap* heap = &graph->heaps[h];
+            if (heap->last_pass >= resource->first_pass) {
+                continue;
+            }
+            if (heap->size >= resource->size && (fit == FRAME_GRAPH_INVALID || heap->size < graph->heaps[fit].size)) {
+                fit = h;
+            }
+            if (largest == FRAME_GRAPH_INVALID || heap->size > graph->heaps[largest].size) {
+                largest = h;
+            }
+        }
+
+        uint32_t h = fit != FRAME_GRAPH_INVALID ? fit : largest;
+        if (h == FRAME_GRAPH_INVALID) {
+            h = graph->heap_count++;
+            memset(&graph->heaps[h], 0, sizeof(FrameGraphHeap));
+            graph->heaps[h].last_resource = FRAME_GRAPH_INVALID;
+        }
+
+        FrameGraphHeap* heap = &graph->heaps[h];
+        if (heap->size < resource->size) {
+            heap->size = resource->size;
+        }
+        resource->heap = h;
+        resource->aliases = heap->last_resource;
+        heap->last_pass = resource->last_pass;
+        heap->last_resource = order[i];
+        heap->resource_count++;
+    }
+}
+
+int frame_graph_compile(FrameGraph* graph) {
+    if (!graph) {
+        return 0;
+    }
+    graph->compiled = 0;
+    memset(&graph->stats, 0, sizeof(graph->stats));
+    if (!frame_graph_validate(graph)) {
+        return 0;
+    }
+
+    frame_graph_cull(graph);
+
+    for (uint32_t r = 0; r < graph->resource_count; r++) {
+        FrameGraphResource* resource = &graph->resources[r];
+        resource->first_pass = FRAME_GRAPH_INVALID;
+        resource->last_pass = FRAME_GRAPH_INVALID;
+        resource->heap = FRAME_GRAPH_INVALID;
+        resource->aliases = FRAME_GRAPH_INVALID;
+    }
+    for (uint32_t p = 0; p < graph->pass_count; p++) {
+        const FrameGraphPass* pass = &graph->passes[p];
+        if (pass->culled) {
+            graph->stats.culled_passes++;
+            continue;
+        }
+        for (uint32_t i = 0; i < pass->read_count; i++) {
+            frame_graph_extend_lifetime(&graph->resources[pass->reads[i]], p);
+        }
+        for (uint32_t i = 0; i < pass->write_count; i++) {
+            frame_graph_extend_lifetime(&graph->resources[pass->writes[i]], p);
+        }
+    }
+
+    frame_graph_assign_heaps(graph);
+
+    // Statistics, including the live transient bytes at each surviving pass
+    FrameGraphStats* stats = &graph->stats;
+    stats->pass_count = graph->pass_count;
+    stats->heap_count = graph->heap_count;
+    for (uint32_t h = 0; h < graph->heap_count; h++) {
+        stats->aliased_bytes += graph->heaps[h].size;
+    }
+    for (uint32_t r = 0; r < graph->resource_count; r++) {
+        const FrameGraphResource* resource = &graph->resources[r];
+        if (!resource->imported && resource->first_pass != FRAME_GRAPH_INVALID) {
+            stats->transient_count++;
+            stats->unaliased_bytes += resource->size;
+        }
+    }
+    for (uint32_t p = 0; p < graph->pass_count; p++) {
+        if (graph->passes[p].culled) {
+            continue;
+        }
+        uint64_t live = 0;
+        for (uint32_t r = 0; r < graph->resource_count; r++) {
+            const FrameGraphResource* resource = &graph->resources[r];
+            if (!resource->imported && resource->first_pass != FRAME_GRAPH_INVALID &&
+                resource->first_pass <= p && resource->last_pass >= p) {
+                live += resource->size;
+            }
+        }
+        if (live > stats->peak_bytes) {
+            stats->peak_bytes = live;
+            stats->peak_pass = p;
+        }
+    }
+
+    graph->compiled = 1;
+    return 1;
+}
+
+void frame_graph_print(const char* name, const FrameGraph* graph) {
+    if (!graph) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    const FrameGraphStats* stats = &graph->stats;
+    printf("%s: %u passes (%u culled), %u transient resources in %u heaps\n", name, stats->pass_count,
+           stats->culled_passes, stats->transient_count, stats->heap_count);
+    printf("  %.2f MB aliased vs %.2f MB unaliased, peak %.2f MB live at '%s'\n",
+           stats->aliased_bytes / (1024.0 * 1024.0), stats->unaliased_bytes / (1024.0 * 1024.0),
+           stats->peak_bytes / (1024.0 * 1024.0),
+           stats->pass_count > 0 ? graph->passes[stats->peak_pass].name : "");
+}
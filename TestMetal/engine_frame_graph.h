@@ -0,0 +1,138 @@
+#ifndef ENGINE_FRAME_GRAPH_H
+#define ENGINE_FRAME_GRAPH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// ============================================================================
+// FRAME GRAPH CONFIGURATION
+// ============================================================================
+
+#define FRAME_GRAPH_MAX_PASSES 256
+#define FRAME_GRAPH_MAX_RESOURCES 512
+#define FRAME_GRAPH_MAX_PASS_RESOURCES 16       // Reads and writes, each, per pass
+#define FRAME_GRAPH_NAME_LENGTH 32
+#define FRAME_GRAPH_PLACEMENT_ALIGNMENT 65536   // Render-target placement in a heap
+#define FRAME_GRAPH_INVALID 0xFFFFFFFFu         // Invalid handle
+
+typedef enum {
+    FRAME_GRAPH_FORMAT_R8 = 0,
+    FRAME_GRAPH_FORMAT_RGBA8,
+    FRAME_GRAPH_FORMAT_RG16F,
+    FRAME_GRAPH_FORMAT_R32F,
+    FRAME_GRAPH_FORMAT_RGBA16F,
+    FRAME_GRAPH_FORMAT_RGBA32F,
+    FRAME_GRAPH_FORMAT_DEPTH32F,
+    FRAME_GRAPH_FORMAT_DEPTH32F_STENCIL8,
+    FRAME_GRAPH_FORMAT_COUNT
+} FrameGraphFormat;
+
+// A transient texture, alive only between the first and last pass using it
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    FrameGraphFormat format;
+    uint32_t mip_levels;        // 0 or 1 = no mips
+    uint32_t array_layers;      // 0 or 1 = single layer (cascades use one per cascade)
+    uint32_t samples;           // 0 or 1 = no MSAA
+} FrameGraphResourceDesc;
+
+// ============================================================================
+// FRAME GRAPH DATA STRUCTURES
+// ============================================================================
+
+typedef struct {
+    char name[FRAME_GRAPH_NAME_LENGTH];
+    FrameGraphResourceDesc desc;
+    int imported;               // Owned outside the graph (e.g. the drawable); never aliased
+    uint64_t size;              // Bytes, rounded up to FRAME_GRAPH_PLACEMENT_ALIGNMENT
+
+    // Filled in by frame_graph_compile
+    uint32_t ref_count;         // Reads by passes that survive culling
+    uint32_t first_pass;        // Lifetime in pass order (FRAME_GRAPH_INVALID if unused)
+    uint32_t last_pass;
+    uint32_t heap;              // Shared heap it is placed in (transient resources only)
+    uint32_t aliases;           // Previous resource in the same heap, or FRAME_GRAPH_INVALID
+} FrameGraphResource;
+
+typedef struct {
+    char name[FRAME_GRAPH_NAME_LENGTH];
+    uint32_t reads[FRAME_GRAPH_MAX_PASS_RESOURCES];
+    uint32_t read_count;
+    uint32_t writes[FRAME_GRAPH_MAX_PASS_RESOURCES];
+    uint32_t write_count;
+    int side_effect;            // Never culled (readbacks, presents)
+
+    // Filled in by frame_graph_compile
+    uint32_t ref_count;
+    int culled;
+} FrameGraphPass;
+
+// Resources in one heap never live at the same time, so they share its memory
+typedef struct {
+    uint64_t size;              // Largest resource placed in it
+    uint32_t last_pass;         // Last pass using the most recent resource
+    uint32_t last_resource;
+    uint32_t resource_count;
+} FrameGraphHeap;
+
+typedef struct {
+    uint32_t pass_count;
+    uint32_t culled_passes;
+    uint32_t transient_count;   // Transient resources that are actually used
+    uint32_t heap_count;
+    uint64_t unaliased_bytes;   // Every transient resource in its own allocation
+    uint64_t aliased_bytes;     // Sum of heap sizes: what the frame allocates
+    uint64_t peak_bytes;        // Most transient bytes alive during any one pass
+    uint32_t peak_pass;
+} FrameGraphStats;
+
+typedef struct {
+    FrameGraphPass passes[FRAME_GRAPH_MAX_PASSES];
+    uint32_t pass_count;
+    FrameGraphResource resources[FRAME_GRAPH_MAX_RESOURCES];
+    uint32_t resource_count;
+    FrameGraphHeap heaps[FRAME_GRAPH_MAX_RESOURCES];
+    uint32_t heap_count;
+    FrameGraphStats stats;
+    int compiled;
+} FrameGraph;
+
+// ============================================================================
+// FRAME GRAPH FUNCTIONS
+// ============================================================================
+
+FrameGraph* frame_graph_create(void);
+void frame_graph_destroy(FrameGraph* graph);
+
+// Drop every pass and resource (graphs are rebuilt each frame)
+void frame_graph_reset(FrameGraph* graph);
+
+// Declare resources; handles are valid until the next reset
+uint32_t frame_graph_create_resource(FrameGraph* graph, const char* name, const FrameGraphResourceDesc* desc);
+uint32_t frame_graph_import_resource(FrameGraph* graph, const char* name, const FrameGraphResourceDesc* desc);
+
+// Declare passes in execution order, then what each reads and writes
+uint32_t frame_graph_add_pass(FrameGraph* graph, const char* name, int side_effect);
+int frame_graph_pass_read(FrameGraph* graph, uint32_t pass, uint32_t resource);
+int frame_graph_pass_write(FrameGraph* graph, uint32_t pass, uint32_t resource);
+
+// Cull passes whose outputs are never consumed, compute lifetimes, and
+// place transient resources into shared heaps. Returns 0 if a pass reads a
+// transient resource that no earlier pass writes.
+int frame_graph_compile(FrameGraph* graph);
+
+// Bytes for a texture of this description (all mips, layers and samples)
+uint64_t frame_graph_resource_size(const FrameGraphResourceDesc* desc);
+uint32_t frame_graph_format_bytes(FrameGraphFormat format);
+
+void frame_graph_print(const char* name, const FrameGraph* graph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_FRAME_GRAPH_H
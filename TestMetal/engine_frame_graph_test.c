@@ -0,0 +1,506 @@
+#include "engine_frame_graph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static uint32_t rng_state = 0x12345678u;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static FrameGraphResourceDesc texture(uint32_t width, uint32_t height, FrameGraphFormat format) {
+    FrameGraphResourceDesc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.width = width;
+    desc.height = height;
+    desc.format = format;
+    return desc;
+}
+
+// Brute force: no two resources in one heap are alive during the same pass,
+// and every heap is big enough for each resource placed in it
+static int heaps_are_valid(const FrameGraph* graph) {
+    for (uint32_t a = 0; a < graph->resource_count; a++) {
+        const FrameGraphResource* ra = &graph->resources[a];
+        if (ra->heap == FRAME_GRAPH_INVALID) {
+            continue;
+        }
+        if (ra->heap >= graph->heap_count || graph->heaps[ra->heap].size < ra->size) {
+            return 0;
+        }
+        for (uint32_t b = a + 1; b < graph->resource_count; b++) {
+            const FrameGraphResource* rb = &graph->resources[b];
+            if (rb->heap == ra->heap && ra->first_pass <= rb->last_pass && rb->first_pass <= ra->last_pass) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ============================================================================
+// SIZE TESTS
+// ============================================================================
+
+static void test_sizes(void) {
+    printf("\n--- Resource Size Tests ---\n");
+
+    FrameGraphResourceDesc desc = texture(1920, 1080, FRAME_GRAPH_FORMAT_RGBA16F);
+    TEST_ASSERT_EQUAL(1920ull * 1080 * 8, frame_graph_resource_size(&desc), "RGBA16F target size");
+
+    desc = texture(256, 256, FRAME_GRAPH_FORMAT_RGBA8);
+    desc.mip_levels = 9;
+    uint64_t mips = 0;
+    for (uint32_t s = 256; s >= 1; s /= 2) {
+        mips += (uint64_t)s * s * 4;
+    }
+    TEST_ASSERT_EQUAL(mips, frame_graph_resource_size(&desc), "Mip chain sums every level");
+
+    desc = texture(2048, 2048, FRAME_GRAPH_FORMAT_DEPTH32F);
+    desc.array_layers = 4;
+    TEST_ASSERT_EQUAL(2048ull * 2048 * 4 * 4, frame_graph_resource_size(&desc), "Array layers multiply the size");
+
+    desc = texture(1280, 720, FRAME_GRAPH_FORMAT_RGBA8);
+    desc.samples = 4;
+    TEST_ASSERT_EQUAL(1280ull * 720 * 4 * 4, frame_graph_resource_size(&desc), "MSAA samples multiply the size");
+    TEST_ASSERT_EQUAL(0u, frame_graph_format_bytes(FRAME_GRAPH_FORMAT_COUNT), "Unknown format has no size");
+}
+
+// ============================================================================
+// ALIASING TESTS
+// ============================================================================
+
+static void test_linear_chain(void) {
+    printf("\n--- Linear Chain Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    // A -> r0 -> B -> r1 -> C -> r2 -> D -> backbuffer
+    FrameGraphResourceDesc desc = texture(1024, 1024, FRAME_GRAPH_FORMAT_RGBA8);
+    uint32_t r0 = frame_graph_create_resource(graph, "r0", &desc);
+    uint32_t r1 = frame_graph_create_resource(graph, "r1", &desc);
+    uint32_t r2 = frame_graph_create_resource(graph, "r2", &desc);
+    uint32_t backbuffer = frame_graph_import_resource(graph, "backbuffer", &desc);
+
+    uint32_t a = frame_graph_add_pass(graph, "A", 0);
+    uint32_t b = frame_graph_add_pass(graph, "B", 0);
+    uint32_t c = frame_graph_add_pass(graph, "C", 0);
+    uint32_t d = frame_graph_add_pass(graph, "D", 0);
+    frame_graph_pass_write(graph, a, r0);
+    frame_graph_pass_read(graph, b, r0);
+    frame_graph_pass_write(graph, b, r1);
+    frame_graph_pass_read(graph, c, r1);
+    frame_graph_pass_write(graph, c, r2);
+    frame_graph_pass_read(graph, d, r2);
+    frame_graph_pass_write(graph, d, backbuffer);
+
+    TEST_ASSERT(frame_graph_compile(graph), "Chain compiles");
+    TEST_ASSERT_EQUAL(0u, graph->stats.culled_passes, "No pass culled");
+    TEST_ASSERT(graph->resources[r0].first_pass == a && graph->resources[r0].last_pass == b, "r0 lives from A to B");
+    TEST_ASSERT_EQUAL(2u, graph->heap_count, "Only neighbours overlap, so the chain needs two heaps");
+    TEST_ASSERT_EQUAL(graph->resources[r0].heap, graph->resources[r2].heap, "r2 reuses r0's heap");
+    TEST_ASSERT_EQUAL(r0, graph->resources[r2].aliases, "r2 aliases r0");
+    TEST_ASSERT_EQUAL(FRAME_GRAPH_INVALID, graph->resources[backbuffer].heap, "Imported target is not placed");
+    TEST_ASSERT_EQUAL(graph->resources[r0].size * 2, graph->stats.aliased_bytes, "Two targets' worth allocated");
+    TEST_ASSERT_EQUAL(graph->stats.aliased_bytes, graph->stats.peak_bytes, "Chain allocation equals its peak");
+    TEST_ASSERT(heaps_are_valid(graph), "No lifetimes overlap within a heap");
+
+    frame_graph_destroy(graph);
+}
+
+static void test_mixed_sizes(void) {
+    printf("\n--- Mixed Size Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    // A big target dies, then a small one and a big one start together: the
+    // big one should take the big heap rather than growing a small heap
+    FrameGraphResourceDesc big_desc = texture(2048, 2048, FRAME_GRAPH_FORMAT_RGBA16F);
+    FrameGraphResourceDesc small_desc = texture(256, 256, FRAME_GRAPH_FORMAT_RGBA8);
+    FrameGraphResourceDesc out_desc = texture(64, 64, FRAME_GRAPH_FORMAT_RGBA8);
+    uint32_t big0 = frame_graph_create_resource(graph, "big0", &big_desc);
+    uint32_t small0 = frame_graph_create_resource(graph, "small0", &small_desc);
+    uint32_t small1 = frame_graph_create_resource(graph, "small1", &small_desc);
+    uint32_t big1 = frame_graph_create_resource(graph, "big1", &big_desc);
+    uint32_t out = frame_graph_import_resource(graph, "out", &out_desc);
+
+    uint32_t p0 = frame_graph_add_pass(graph, "p0", 0);
+    uint32_t p1 = frame_graph_add_pass(graph, "p1", 0);
+    uint32_t p2 = frame_graph_add_pass(graph, "p2", 0);
+    uint32_t p3 = frame_graph_add_pass(graph, "p3", 0);
+    frame_graph_pass_write(graph, p0, big0);
+    frame_graph_pass_write(graph, p0, small0);
+    frame_graph_pass_read(graph, p1, big0);
+    frame_graph_pass_read(graph, p1, small0);
+    frame_graph_pass_write(graph, p1, out);
+    frame_graph_pass_write(graph, p2, small1);
+    frame_graph_pass_write(graph, p2, big1);
+    frame_graph_pass_read(graph, p3, small1);
+    frame_graph_pass_read(graph, p3, big1);
+    frame_graph_pass_write(graph, p3, out);
+
+    TEST_ASSERT(frame_graph_compile(graph), "Graph compiles");
+    TEST_ASSERT_EQUAL(2u, graph->heap_count, "Two heaps");
+    TEST_ASSERT_EQUAL(graph->resources[big0].heap, graph->resources[big1].heap, "Big targets share a heap");
+    TEST_ASSERT_EQUAL(graph->resources[small0].heap, graph->resources[small1].heap, "Small targets share a heap");
+    TEST_ASSERT_EQUAL(graph->stats.peak_bytes, graph->stats.aliased_bytes, "No heap grew past the peak");
+    TEST_ASSERT(heaps_are_valid(graph), "No lifetimes overlap within a heap");
+
+    frame_graph_destroy(graph);
+}
+
+// ============================================================================
+// CULLING AND VALIDATION TESTS
+// ============================================================================
+
+static void test_culling(void) {
+    printf("\n--- Culling Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    FrameGraphResourceDesc desc = texture(512, 512, FRAME_GRAPH_FORMAT_RGBA8);
+    uint32_t used = frame_graph_create_resource(graph, "used", &desc);
+    uint32_t debug_input = frame_graph_create_resource(graph, "debug_input", &desc);
+    uint32_t debug_view = frame_graph_create_resource(graph, "debug_view", &desc);
+    uint32_t readback = frame_graph_create_resource(graph, "readback", &desc);
+    uint32_t backbuffer = frame_graph_import_resource(graph, "backbuffer", &desc);
+
+    uint32_t scene = frame_graph_add_pass(graph, "scene", 0);
+    uint32_t debug_prep = frame_graph_add_pass(graph, "debug_prep", 0);
+    uint32_t debug = frame_graph_add_pass(graph, "debug", 0);
+    uint32_t capture = frame_graph_add_pass(graph, "capture", 1);
+    uint32_t present = frame_graph_add_pass(graph, "present", 0);
+    frame_graph_pass_write(graph, scene, used);
+    frame_graph_pass_write(graph, debug_prep, debug_input);
+    frame_graph_pass_read(graph, debug, debug_input);
+    frame_graph_pass_write(graph, debug, debug_view);     // Nobody reads this
+    frame_graph_pass_read(graph, capture, used);
+    frame_graph_pass_write(graph, capture, readback);
+    frame_graph_pass_read(graph, present, used);
+    frame_graph_pass_write(graph, present, backbuffer);
+
+    TEST_ASSERT(frame_graph_compile(graph), "Graph compiles");
+    TEST_ASSERT(graph->passes[debug].culled, "Pass with an unread output is culled");
+    TEST_ASSERT(graph->passes[debug_prep].culled, "Pass feeding only a culled pass is culled");
+    TEST_ASSERT(!graph->passes[capture].culled, "Side-effect pass is kept");
+    TEST_ASSERT(!graph->passes[present].culled && !graph->passes[scene].culled, "Passes reaching the output are kept");
+    TEST_ASSERT_EQUAL(0, graph->passes[present].side_effect, "Caller's side-effect flag is untouched");
+    TEST_ASSERT_EQUAL(2u, graph->stats.culled_passes, "Two passes culled");
+    TEST_ASSERT(graph->resources[debug_input].heap == FRAME_GRAPH_INVALID &&
+                graph->resources[debug_view].heap == FRAME_GRAPH_INVALID, "Culled resources get no memory");
+    TEST_ASSERT_EQUAL(2u, graph->stats.transient_count, "Only used transients are counted");
+
+    // Compiling again gives the same answer
+    uint64_t aliased = graph->stats.aliased_bytes;
+    TEST_ASSERT(frame_graph_compile(graph) && graph->stats.aliased_bytes == aliased &&
+                graph->stats.culled_passes == 2, "Recompile is idempotent");
+
+    frame_graph_destroy(graph);
+}
+
+static void test_validation(void) {
+    printf("\n--- Validation Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    FrameGraphResourceDesc desc = texture(64, 64, FRAME_GRAPH_FORMAT_R8);
+    uint32_t t = frame_graph_create_resource(graph, "t", &desc);
+    uint32_t history = frame_graph_import_resource(graph, "history", &desc);
+    uint32_t reader = frame_graph_add_pass(graph, "reader", 1);
+    uint32_t writer = frame_graph_add_pass(graph, "writer", 0);
+    frame_graph_pass_read(graph, reader, t);
+    frame_graph_pass_read(graph, reader, history);
+    frame_graph_pass_write(graph, writer, t);
+
+    TEST_ASSERT(!frame_graph_compile(graph), "Read before write is rejected");
+    TEST_ASSERT(!graph->compiled, "Graph is not marked compiled");
+
+    frame_graph_reset(graph);
+    TEST_ASSERT(graph->pass_count == 0 && graph->resource_count == 0, "Reset drops passes and resources");
+
+    FrameGraphResourceDesc bad = texture(0, 64, FRAME_GRAPH_FORMAT_R8);
+    TEST_ASSERT_EQUAL(FRAME_GRAPH_INVALID, frame_graph_create_resource(graph, "bad", &bad), "Zero width is rejected");
+    bad = texture(64, 64, FRAME_GRAPH_FORMAT_COUNT);
+    TEST_ASSERT_EQUAL(FRAME_GRAPH_INVALID, frame_graph_create_resource(graph, "bad", &bad), "Unknown format is rejected");
+    TEST_ASSERT(!frame_graph_pass_read(graph, 0, 0), "Access to an unknown pass is rejected");
+
+    uint32_t pass = frame_graph_add_pass(graph, "wide", 1);
+    int ok = 1;
+    for (uint32_t i = 0; i < FRAME_GRAPH_MAX_PASS_RESOURCES; i++) {
+        uint32_t r = frame_graph_create_resource(graph, "w", &desc);
+        ok &= frame_graph_pass_write(graph, pass, r);
+        ok &= frame_graph_pass_write(graph, pass, r); // Duplicates are folded
+    }
+    TEST_ASSERT(ok && graph->passes[pass].write_count == FRAME_GRAPH_MAX_PASS_RESOURCES, "Duplicate writes are folded");
+    uint32_t extra = frame_graph_create_resource(graph, "extra", &desc);
+    TEST_ASSERT(!frame_graph_pass_write(graph, pass, extra), "Per-pass resource limit is enforced");
+    TEST_ASSERT(frame_graph_compile(graph), "Valid graph compiles after reset");
+
+    frame_graph_destroy(graph);
+}
+
+// ============================================================================
+// PIPELINE TESTS
+// ============================================================================
+
+// A deferred frame: shadow cascades, depth prepass, G-buffer, lighting,
+// bloom down/up chain and tonemap into the drawable
+static void build_deferred_frame(FrameGraph* graph, uint32_t width, uint32_t height) {
+    FrameGraphResourceDesc desc = texture(2048, 2048, FRAME_GRAPH_FORMAT_DEPTH32F);
+    desc.array_layers = 4;
+    uint32_t shadows = frame_graph_create_resource(graph, "shadow_cascades", &desc);
+    uint32_t depth = frame_graph_create_resource(graph, "depth",
+                                                 &(FrameGraphResourceDesc){width, height, FRAME_GRAPH_FORMAT_DEPTH32F_STENCIL8, 1, 1, 1});
+    uint32_t albedo = frame_graph_create_resource(graph, "gbuffer_albedo",
+                                                  &(FrameGraphResourceDesc){width, height, FRAME_GRAPH_FORMAT_RGBA8, 1, 1, 1});
+    uint32_t normals = frame_graph_create_resource(graph, "gbuffer_normals",
+                                                   &(FrameGraphResourceDesc){width, height, FRAME_GRAPH_FORMAT_RGBA16F, 1, 1, 1});
+    uint32_t material = frame_graph_create_resource(graph, "gbuffer_material",
+                                                    &(FrameGraphResourceDesc){width, height, FRAME_GRAPH_FORMAT_RGBA8, 1, 1, 1});
+    uint32_t ao = frame_graph_create_resource(graph, "ssao",
+                                              &(FrameGraphResourceDesc){width / 2, height / 2, FRAME_GRAPH_FORMAT_R8, 1, 1, 1});
+    uint32_t hdr = frame_graph_create_resource(graph, "hdr",
+                                               &(FrameGraphResourceDesc){width, height, FRAME_GRAPH_FORMAT_RGBA16F, 1, 1, 1});
+    uint32_t drawable = frame_graph_import_resource(graph, "drawable",
+                                                    &(FrameGraphResourceDesc){width, height, FRAME_GRAPH_FORMAT_RGBA8, 1, 1, 1});
+
+    uint32_t pass = frame_graph_add_pass(graph, "shadows", 0);
+    frame_graph_pass_write(graph, pass, shadows);
+
+    pass = frame_graph_add_pass(graph, "depth_prepass", 0);
+    frame_graph_pass_write(graph, pass, depth);
+
+    pass = frame_graph_add_pass(graph, "gbuffer", 0);
+    frame_graph_pass_read(graph, pass, depth);
+    frame_graph_pass_write(graph, pass, albedo);
+    frame_graph_pass_write(graph, pass, normals);
+    frame_graph_pass_write(graph, pass, material);
+
+    pass = frame_graph_add_pass(graph, "ssao", 0);
+    frame_graph_pass_read(graph, pass, depth);
+    frame_graph_pass_read(graph, pass, normals);
+    frame_graph_pass_write(graph, pass, ao);
+
+    pass = frame_graph_add_pass(graph, "lighting", 0);
+    frame_graph_pass_read(graph, pass, shadows);
+    frame_graph_pass_read(graph, pass, depth);
+    frame_graph_pass_read(graph, pass, albedo);
+    frame_graph_pass_read(graph, pass, normals);
+    frame_graph_pass_read(graph, pass, material);
+    frame_graph_pass_read(graph, pass, ao);
+    frame_graph_pass_write(graph, pass, hdr);
+
+    // Bloom: 5 downsample levels, then upsample back, each its own target
+    enum { BLOOM_LEVELS = 5 };
+    uint32_t down[BLOOM_LEVELS];
+    uint32_t up[BLOOM_LEVELS];
+    uint32_t source = hdr;
+    for (uint32_t i = 0; i < BLOOM_LEVELS; i++) {
+        char name[FRAME_GRAPH_NAME_LENGTH];
+        snprintf(name, sizeof(name), "bloom_down%u", i);
+        down[i] = frame_graph_create_resource(graph, name,
+                                              &(FrameGraphResourceDesc){width >> (i + 1), height >> (i + 1),
+                                                                        FRAME_GRAPH_FORMAT_RGBA16F, 1, 1, 1});
+        pass = frame_graph_add_pass(graph, name, 0);
+        frame_graph_pass_read(graph, pass, source);
+        frame_graph_pass_write(graph, pass, down[i]);
+        source = down[i];
+    }
+    for (int i = BLOOM_LEVELS - 2; i >= 0; i--) {
+        char name[FRAME_GRAPH_NAME_LENGTH];
+        snprintf(name, sizeof(name), "bloom_up%d", i);
+        up[i] = frame_graph_create_resource(graph, name,
+                                            &(FrameGraphResourceDesc){width >> (i + 1), height >> (i + 1),
+                                                                      FRAME_GRAPH_FORMAT_RGBA16F, 1, 1, 1});
+        pass = frame_graph_add_pass(graph, name, 0);
+        frame_graph_pass_read(graph, pass, source);
+        frame_graph_pass_read(graph, pass, down[i]);
+        frame_graph_pass_write(graph, pass, up[i]);
+        source = up[i];
+    }
+
+    pass = frame_graph_add_pass(graph, "tonemap", 0);
+    frame_graph_pass_read(graph, pass, hdr);
+    frame_graph_pass_read(graph, pass, source);
+    frame_graph_pass_write(graph, pass, drawable);
+}
+
+static void test_deferred_pipeline(void) {
+    printf("\n--- Deferred Pipeline Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    build_deferred_frame(graph, 1920, 1080);
+    TEST_ASSERT(frame_graph_compile(graph), "Deferred frame compiles");
+    TEST_ASSERT_EQUAL(0u, graph->stats.culled_passes, "Every pass contributes to the drawable");
+    TEST_ASSERT(graph->stats.aliased_bytes < graph->stats.unaliased_bytes, "Aliasing saves memory");
+    TEST_ASSERT(graph->stats.aliased_bytes >= graph->stats.peak_bytes, "Heaps cover the peak");
+    TEST_ASSERT(graph->stats.heap_count < graph->stats.transient_count, "Fewer heaps than transients");
+    TEST_ASSERT(heaps_are_valid(graph), "No lifetimes overlap within a heap");
+
+    printf("  Transient memory: %.2f MB unaliased, %.2f MB aliased, %.2f MB peak (%.0f%% saved)\n",
+           graph->stats.unaliased_bytes / (1024.0 * 1024.0), graph->stats.aliased_bytes / (1024.0 * 1024.0),
+           graph->stats.peak_bytes / (1024.0 * 1024.0),
+           100.0 * (1.0 - (double)graph->stats.aliased_bytes / (double)graph->stats.unaliased_bytes));
+    frame_graph_print("Deferred frame", graph);
+
+    frame_graph_destroy(graph);
+}
+
+// ============================================================================
+// STRESS AND PERFORMANCE TESTS
+// ============================================================================
+
+// Random DAG in pass order: each pass writes 1-3 new targets and reads up to
+// 4 earlier ones; the last pass writes the drawable
+static void build_random_graph(FrameGraph* graph, uint32_t pass_count, uint32_t max_resources) {
+    static const FrameGraphFormat formats[] = {
+        FRAME_GRAPH_FORMAT_R8, FRAME_GRAPH_FORMAT_RGBA8, FRAME_GRAPH_FORMAT_RGBA16F, FRAME_GRAPH_FORMAT_DEPTH32F,
+    };
+    uint32_t drawable = frame_graph_import_resource(graph, "drawable",
+                                                    &(FrameGraphResourceDesc){1920, 1080, FRAME_GRAPH_FORMAT_RGBA8, 1, 1, 1});
+    for (uint32_t p = 0; p < pass_count; p++) {
+        uint32_t pass = frame_graph_add_pass(graph, "random", rng_next() % 16 == 0);
+        uint32_t written = graph->resource_count;
+        for (uint32_t i = 1; i < written && i <= 4; i++) {
+            frame_graph_pass_read(graph, pass, 1 + rng_next() % (written - 1));
+        }
+        uint32_t outputs = 1 + rng_next() % 3;
+        for (uint32_t i = 0; i < outputs && graph->resource_count < max_resources; i++) {
+            uint32_t size = 64u << (rng_next() % 6);
+            FrameGraphResourceDesc desc = texture(size, size, formats[rng_next() % 4]);
+            frame_graph_pass_write(graph, pass, frame_graph_create_resource(graph, "t", &desc));
+        }
+        if (p == pass_count - 1) {
+            frame_graph_pass_write(graph, pass, drawable);
+        }
+    }
+}
+
+static void test_random_graphs(void) {
+    printf("\n--- Random Graph Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    int compiled = 1;
+    int valid = 1;
+    int bounded = 1;
+    for (uint32_t round = 0; round < 200; round++) {
+        frame_graph_reset(graph);
+        build_random_graph(graph, 4 + rng_next() % 60, FRAME_GRAPH_MAX_RESOURCES);
+        if (!frame_graph_compile(graph)) {
+            compiled = 0;
+            continue;
+        }
+        valid &= heaps_are_valid(graph);
+        bounded &= graph->stats.aliased_bytes >= graph->stats.peak_bytes &&
+                   graph->stats.aliased_bytes <= graph->stats.unaliased_bytes;
+    }
+    TEST_ASSERT(compiled, "200 random graphs compile");
+    TEST_ASSERT(valid, "No lifetimes overlap within a heap in any graph");
+    TEST_ASSERT(bounded, "Allocation is between the peak and the unaliased total");
+
+    frame_graph_destroy(graph);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    FrameGraph* graph = frame_graph_create();
+    TEST_ASSERT_NOT_NULL(graph, "Frame graph created");
+    if (!graph) return;
+
+    enum { FRAMES = 100 };
+    double build_ms = 0.0;
+    double compile_ms = 0.0;
+    int ok = 1;
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        double start = now_ms();
+        frame_graph_reset(graph);
+        build_random_graph(graph, FRAME_GRAPH_MAX_PASSES, FRAME_GRAPH_MAX_RESOURCES);
+        double built = now_ms();
+        ok &= frame_graph_compile(graph);
+        compile_ms += now_ms() - built;
+        build_ms += built - start;
+    }
+
+    printf("  %u passes, %u resources: build %.3f ms/frame, compile %.3f ms/frame\n", graph->pass_count,
+           graph->resource_count, build_ms / FRAMES, compile_ms / FRAMES);
+    TEST_ASSERT(ok, "Full-size graphs compile");
+    TEST_ASSERT(compile_ms / FRAMES < 16.0, "Compile fits in a frame");
+    TEST_ASSERT(heaps_are_valid(graph), "No lifetimes overlap within a heap");
+    frame_graph_print("Largest graph", graph);
+
+    frame_graph_destroy(graph);
+}
+
+int main(void) {
+    printf("Starting Frame Graph Unit Tests\n");
+    printf("===============================\n");
+
+    test_sizes();
+    test_linear_chain();
+    test_mixed_sizes();
+    test_culling();
+    test_validation();
+    test_deferred_pipeline();
+    test_random_graphs();
+    test_performance();
+
+    printf("\n===============================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+#include "engine_halfedge.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// EDGE HASH
+// ============================================================================
+
+// Open addressing on undirected edges, linear probing. Each entry holds both
+// half-edges (+1, 0 when absent) so twins fall out of one scan of the table;
+// a direction seen twice is EDGE_HASH_REPEATED and the whole edge is
+// non-manifold. Key 0 is empty: a valid edge has lo < hi.
+#define EDGE_HASH_REPEATED (-1)
+
+typedef struct {
+    uint64_t key;               // lo << 32 | hi
+    int32_t forward;            // Half-edge lo -> hi, +1
+    int32_t backward;           // Half-edge hi -> lo, +1
+} EdgeEntry;
+
+typedef struct {
+    EdgeEntry* entries;
+    uint64_t mask;
+    uint32_t shift;             // 64 - log2(capacity): slots come from the top product bits
+} EdgeHash;
+
+static int edge_hash_init(EdgeHash* hash, uint32_t count) {
+    uint64_t capacity = 16;
+    hash->shift = 60;
+    while (capacity < (uint64_t)count + count / 4) {
+        capacity *= 2;
+        hash->shift--;
+    }
+    hash->mask = capacity - 1;
+    // Zeroed pages come lazily from calloc, no clearing pass
+    hash->entries = (EdgeEntry*)calloc(capacity, sizeof(EdgeEntry));
+    return hash->entries != NULL;
+}
+
+static void edge_hash_insert(EdgeHash* hash, uint32_t from, uint32_t to, int32_t halfedge) {
+    uint32_t lo = from < to ? from : to;
+    uint32_t hi = from < to ? to : from;
+    uint64_t key = ((uint64_t)lo << 32) | hi;
+    uint64_t slot = (key * 0x9E3779B97F4A7C15ull) >> hash->shift;
+    while (hash->entries[slot].key != 0 && hash->entries[slot].key != key) {
+        slot = (slot + 1) & hash->mask;
+    }
+
+    EdgeEntry* entry = &hash->entries[slot];
+    int32_t* side = from < to ? &entry->forward : &entry->backward;
+    entry->key = key;
+    *side = *side == 0 ? halfedge + 1 : EDGE_HASH_REPEATED;
+}
+
+// ============================================================================
+// HALF-EDGE FUNCTIONS
+// ============================================================================
+
+HalfEdgeMesh* halfedge_mesh_build_indices(const uint32_t* indices, uint32_t index_count, uint32_t vertex_count) {
+    if (!indices || index_count < 3 || index_count % 3 != 0 || index_count > 0x7FFFFFFFu ||
+        vertex_count > 0x7FFFFFFFu) {
+        fprintf(stderr, "Error: Invalid half-edge mesh parameters\n");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < index_count; i++) {
+        if (indices[i] >= vertex_count) {
+            fprintf(stderr, "Error: Half-edge mesh index %u out of range\n", indices[i]);
+            return NULL;
+        }
+    }
+
+    HalfEdgeMesh* mesh = (HalfEdgeMesh*)calloc(1, sizeof(HalfEdgeMesh));
+    EdgeHash hash = { NULL, 0, 0 };
+    uint32_t* degree = (uint32_t*)calloc(vertex_count, sizeof(uint32_t));
+    if (mesh) {
+        mesh->vertex = (int32_t*)malloc(index_count * sizeof(int32_t));
+        mesh->twin = (int32_t*)malloc(index_count * sizeof(int32_t));
+        mesh->vertex_halfedge = (int32_t*)malloc(vertex_count * sizeof(int32_t));
+        mesh->vertex_flags = (uint8_t*)calloc(vertex_count, 1);
+    }
+    // Closed meshes have index_count / 2 edges, triangle soups index_count
+    if (!mesh || !degree || !mesh->vertex || !mesh->twin || !mesh->vertex_halfedge || !mesh->vertex_flags ||
+        !edge_hash_init(&hash, index_count)) {
+        fprintf(stderr, "Error: Failed to allocate memory for half-edge mesh\n");
+        free(degree);
+        halfedge_mesh_destroy(mesh);
+        return NULL;
+    }
+    mesh->halfedge_count = index_count;
+    mesh->face_count = index_count / 3;
+    mesh->vertex_count = vertex_count;
+    memcpy(mesh->vertex, indices, index_count * sizeof(int32_t));
+    memset(mesh->vertex_halfedge, 0xFF, vertex_count * sizeof(int32_t));
+
+    for (uint32_t f = 0; f < mesh->face_count; f++) {
+        const uint32_t* tri = indices + 3 * f;
+        mesh->twin[3 * f] = mesh->twin[3 * f + 1] = mesh->twin[3 * f + 2] = HALFEDGE_NONMANIFOLD;
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0]) {
+            mesh->degenerate_face_count++;
+            continue;
+        }
+        edge_hash_insert(&hash, tri[0], tri[1], (int32_t)(3 * f));
+        edge_hash_insert(&hash, tri[1], tri[2], (int32_t)(3 * f + 1));
+        edge_hash_insert(&hash, tri[2], tri[0], (int32_t)(3 * f + 2));
+    }
+
+    // Pair twins; repeated directions leave the edge HALFEDGE_NONMANIFOLD
+    for (uint64_t slot = 0; slot <= hash.mask; slot++) {
+        const EdgeEntry* entry = &hash.entries[slot];
+        if (entry->key == 0 || entry->forward == EDGE_HASH_REPEATED || entry->backward == EDGE_HASH_REPEATED) {
+            continue;
+        }
+        int32_t forward = entry->forward - 1;
+        int32_t backward = entry->backward - 1;
+        if (forward >= 0) mesh->twin[forward] = backward >= 0 ? backward : HALFEDGE_BORDER;
+        if (backward >= 0) mesh->twin[backward] = forward >= 0 ? forward : HALFEDGE_BORDER;
+    }
+    free(hash.entries);
+
+    for (uint32_t h = 0; h < index_count; h++) {
+        int32_t twin = mesh->twin[h];
+        uint32_t a = indices[h], b = indices[halfedge_next((int32_t)h)];
+        if (a == b || a == indices[halfedge_prev((int32_t)h)] || b == indices[halfedge_prev((int32_t)h)]) {
+            mesh->nonmanifold_edge_count++;
+            continue;
+        }
+
+        degree[a]++;
+        if (twin == HALFEDGE_BORDER) {
+            mesh->border_edge_count++;
+            mesh->edge_count++;
+            mesh->vertex_flags[a] |= HALFEDGE_VERTEX_BORDER;
+            mesh->vertex_flags[b] |= HALFEDGE_VERTEX_BORDER;
+        } else if (twin == HALFEDGE_NONMANIFOLD) {
+            mesh->nonmanifold_edge_count++;
+            mesh->vertex_flags[a] |= HALFEDGE_VERTEX_NONMANIFOLD;
+            mesh->vertex_flags[b] |= HALFEDGE_VERTEX_NONMANIFOLD;
+        } else if ((uint32_t)twin > h) {
+            mesh->edge_count++;
+        }
+
+        // Prefer a half-edge with nothing across it so rotation covers the fan
+        if (mesh->vertex_halfedge[a] < 0 || twin < 0) {
+            mesh->vertex_halfedge[a] = (int32_t)h;
+        }
+    }
+
+    // A vertex whose fan misses some of its corners is a bowtie
+    for (uint32_t v = 0; v < vertex_count; v++) {
+        int32_t start = mesh->vertex_halfedge[v];
+        if (start < 0) {
+            continue;
+        }
+        uint32_t fan = 0;
+        int32_t h = start;
+        do {
+            fan++;
+            h = halfedge_rotate(mesh, h);
+        } while (h >= 0 && h != start && fan <= degree[v]);
+        if (fan != degree[v]) {
+            mesh->vertex_flags[v] |= HALFEDGE_VERTEX_NONMANIFOLD;
+        }
+        if (mesh->vertex_flags[v] & HALFEDGE_VERTEX_NONMANIFOLD) {
+            mesh->nonmanifold_vertex_count++;
+        }
+    }
+    free(degree);
+    return mesh;
+}
+
+HalfEdgeMesh* halfedge_mesh_build(const Mesh* mesh) {
+    if (!mesh) {
+        fprintf(stderr, "Error: Invalid half-edge mesh parameters\n");
+        return NULL;
+    }
+    return halfedge_mesh_build_indices(mesh->indices, mesh->index_count, mesh->vertex_count);
+}
+
+void halfedge_mesh_destroy(HalfEdgeMesh* mesh) {
+    if (!mesh) {
+        return;
+    }
+    free(mesh->vertex);
+    free(mesh->twin);
+    free(mesh->vertex_halfedge);
+    free(mesh->vertex_flags);
+    free(mesh);
+}
+
+uint32_t halfedge_mesh_one_ring(const HalfEdgeMesh* mesh, uint32_t vertex, uint32_t* out_vertices, uint32_t capacity) {
+    if (!mesh || vertex >= mesh->vertex_count || mesh->vertex_halfedge[vertex] < 0) {
+        return 0;
+    }
+
+    uint32_t count = 0;
+    int32_t start = mesh->vertex_halfedge[vertex];
+    int32_t h = start;
+    while (count < mesh->halfedge_count) {
+        if (count < capacity && out_vertices) out_vertices[count] = (uint32_t)halfedge_target(mesh, h);
+        count++;
+        int32_t next = halfedge_rotate(mesh, h);
+        if (next < 0) {
+            // Open fan: the far end of the last face closes it
+            if (count < capacity && out_vertices) out_vertices[count] = (uint32_t)mesh->vertex[halfedge_prev(h)];
+            count++;
+            break;
+        }
+        if (next == start) {
+            break;
+        }
+        h = next;
+    }
+    return count;
+}
+
+int halfedge_mesh_is_closed_manifold(const HalfEdgeMesh* mesh) {
+    return mesh && mesh->border_edge_count == 0 && mesh->nonmanifold_edge_count == 0 &&
+           mesh->nonmanifold_vertex_count == 0 && mesh->degenerate_face_count == 0;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void halfedge_mesh_print(const char* name, const HalfEdgeMesh* mesh) {
+    if (!mesh) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s: %u vertices, %u faces, %u edges, %u border edges%s\n", name, mesh->vertex_count, mesh->face_count,
+           mesh->edge_count, mesh->border_edge_count, halfedge_mesh_is_closed_manifold(mesh) ? " (closed manifold)" : "");
+    printf("  Non-manifold: %u half-edges, %u vertices; %u degenerate faces\n", mesh->nonmanifold_edge_count,
+           mesh->nonmanifold_vertex_count, mesh->degenerate_face_count);
+}
@@ -0,0 +1,114 @@
+#ifndef ENGINE_HALFEDGE_H
+#define ENGINE_HALFEDGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_model.h"
+#include <stdint.h>
+
+// ============================================================================
+// HALF-EDGE CONFIGURATION
+// ============================================================================
+
+#define HALFEDGE_BORDER (-1)                    // twin: no opposite face
+#define HALFEDGE_NONMANIFOLD (-2)               // twin: edge shared by 3+ faces, inconsistently wound or degenerate
+
+#define HALFEDGE_VERTEX_BORDER 0x01             // vertex_flags bits
+#define HALFEDGE_VERTEX_NONMANIFOLD 0x02        // On a non-manifold edge, or more than one face fan (bowtie)
+
+// ============================================================================
+// HALF-EDGE DATA STRUCTURES
+// ============================================================================
+
+// Corner table over a triangle list: half-edge h is corner h of the index
+// array and runs from vertex[h] to vertex[next(h)] inside face h / 3, so
+// next/prev/face are arithmetic and only twins and one outgoing half-edge
+// per vertex are stored.
+typedef struct {
+    int32_t* vertex;            // Origin vertex per half-edge (copy of the indices)
+    int32_t* twin;              // Opposite half-edge, HALFEDGE_BORDER or HALFEDGE_NONMANIFOLD
+    int32_t* vertex_halfedge;   // Outgoing half-edge per vertex (a border one if any), -1 when unused
+    uint8_t* vertex_flags;
+    uint32_t halfedge_count;
+    uint32_t face_count;
+    uint32_t vertex_count;
+    uint32_t edge_count;                // Undirected manifold and border edges
+    uint32_t border_edge_count;
+    uint32_t nonmanifold_edge_count;    // Half-edges marked HALFEDGE_NONMANIFOLD
+    uint32_t nonmanifold_vertex_count;
+    uint32_t degenerate_face_count;     // Faces repeating a vertex
+} HalfEdgeMesh;
+
+// ============================================================================
+// HALF-EDGE NAVIGATION
+// ============================================================================
+
+FORCE_INLINE int32_t halfedge_next(int32_t h) {
+    return h % 3 == 2 ? h - 2 : h + 1;
+}
+
+FORCE_INLINE int32_t halfedge_prev(int32_t h) {
+    return h % 3 == 0 ? h + 2 : h - 1;
+}
+
+FORCE_INLINE int32_t halfedge_face(int32_t h) {
+    return h / 3;
+}
+
+FORCE_INLINE int32_t halfedge_origin(const HalfEdgeMesh* mesh, int32_t h) {
+    return mesh->vertex[h];
+}
+
+FORCE_INLINE int32_t halfedge_target(const HalfEdgeMesh* mesh, int32_t h) {
+    return mesh->vertex[halfedge_next(h)];
+}
+
+// Face across edge k (0..2) of a face, or -1
+FORCE_INLINE int32_t halfedge_face_neighbor(const HalfEdgeMesh* mesh, int32_t face, int k) {
+    int32_t twin = mesh->twin[3 * face + k];
+    return twin >= 0 ? twin / 3 : -1;
+}
+
+// Next outgoing half-edge of the same origin, rotating across prev(h);
+// negative at a border or non-manifold edge
+FORCE_INLINE int32_t halfedge_rotate(const HalfEdgeMesh* mesh, int32_t h) {
+    return mesh->twin[halfedge_prev(h)];
+}
+
+// ============================================================================
+// HALF-EDGE FUNCTIONS
+// ============================================================================
+
+// Build from a triangle list in linear time (one edge-hash probe per half-edge).
+// Indices must be below vertex_count (at most 2^31 vertices and corners).
+HalfEdgeMesh* halfedge_mesh_build_indices(const uint32_t* indices, uint32_t index_count, uint32_t vertex_count);
+
+// Build from a Mesh
+HalfEdgeMesh* halfedge_mesh_build(const Mesh* mesh);
+
+// Free a half-edge mesh
+void halfedge_mesh_destroy(HalfEdgeMesh* mesh);
+
+// Neighbouring vertices of a manifold vertex in fan order. Returns the
+// neighbour count (which may exceed capacity; only capacity are written).
+uint32_t halfedge_mesh_one_ring(const HalfEdgeMesh* mesh, uint32_t vertex, uint32_t* out_vertices, uint32_t capacity);
+
+// True when every edge has exactly two consistently wound faces and every
+// vertex a single fan
+int halfedge_mesh_is_closed_manifold(const HalfEdgeMesh* mesh);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print element counts, borders and non-manifold elements
+void halfedge_mesh_print(const char* name, const HalfEdgeMesh* mesh);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_HALFEDGE_H
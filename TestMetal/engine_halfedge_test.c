@@ -0,0 +1,314 @@
+#include "engine_halfedge.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* assets_dir = "assets";
+
+// ============================================================================
+// TEST MESHES
+// ============================================================================
+
+// Closed cube: 8 vertices, 12 outward-wound triangles
+static const uint32_t cube_indices[36] = {
+    0, 2, 1, 0, 3, 2,   4, 5, 6, 4, 6, 7,   0, 1, 5, 0, 5, 4,
+    2, 3, 7, 2, 7, 6,   1, 2, 6, 1, 6, 5,   0, 4, 7, 0, 7, 3,
+};
+
+// Grid of size x size quads over (size + 1)^2 vertices
+static uint32_t* make_grid_indices(uint32_t size) {
+    uint32_t* indices = (uint32_t*)malloc((size_t)size * size * 6 * sizeof(uint32_t));
+    uint32_t idx = 0;
+    for (uint32_t y = 0; y < size; y++) {
+        for (uint32_t x = 0; x < size; x++) {
+            uint32_t i0 = y * (size + 1) + x, i1 = i0 + 1, i2 = i0 + size + 1, i3 = i2 + 1;
+            indices[idx++] = i0;
+            indices[idx++] = i2;
+            indices[idx++] = i1;
+            indices[idx++] = i1;
+            indices[idx++] = i2;
+            indices[idx++] = i3;
+        }
+    }
+    return indices;
+}
+
+// Every paired half-edge is the reverse of its twin and pairing is an involution
+static int twins_consistent(const HalfEdgeMesh* mesh) {
+    for (uint32_t h = 0; h < mesh->halfedge_count; h++) {
+        int32_t t = mesh->twin[h];
+        if (t < 0) continue;
+        if (mesh->twin[t] != (int32_t)h) return 0;
+        if (halfedge_origin(mesh, t) != halfedge_target(mesh, (int32_t)h)) return 0;
+        if (halfedge_target(mesh, t) != halfedge_origin(mesh, (int32_t)h)) return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// HALF-EDGE TESTS
+// ============================================================================
+
+static void test_closed_mesh(void) {
+    printf("\n--- Closed Mesh Tests ---\n");
+
+    HalfEdgeMesh* cube = halfedge_mesh_build_indices(cube_indices, 36, 8);
+    TEST_ASSERT_NOT_NULL(cube, "Cube should build");
+    if (!cube) return;
+    halfedge_mesh_print("Cube", cube);
+
+    TEST_ASSERT(halfedge_mesh_is_closed_manifold(cube), "Cube should be a closed manifold");
+    TEST_ASSERT_EQUAL(18u, cube->edge_count, "Cube should have 18 edges");
+    TEST_ASSERT_EQUAL(2, (int)cube->vertex_count - (int)cube->edge_count + (int)cube->face_count, "Euler characteristic should be 2");
+    TEST_ASSERT(twins_consistent(cube), "Twins should be reversed involutions");
+
+    TEST_ASSERT_EQUAL(1, halfedge_next(0), "next(0) should be 1");
+    TEST_ASSERT_EQUAL(3, halfedge_next(5), "next wraps within its face");
+    TEST_ASSERT_EQUAL(5, halfedge_prev(3), "prev wraps within its face");
+    TEST_ASSERT_EQUAL(4, halfedge_face(14), "Half-edge 14 should lie in face 4");
+
+    int neighbors_ok = 1;
+    for (int32_t f = 0; f < 12; f++) {
+        for (int k = 0; k < 3; k++) {
+            int32_t g = halfedge_face_neighbor(cube, f, k);
+            neighbors_ok &= g >= 0 && g != f;
+        }
+    }
+    TEST_ASSERT(neighbors_ok, "Every cube face should have three neighbours");
+
+    // Vertex 0's neighbours straight from the triangle list
+    int adjacent[8] = { 0 };
+    uint32_t adjacent_count = 0;
+    for (uint32_t i = 0; i < 36; i++) {
+        if (cube_indices[i] != 0) continue;
+        uint32_t base = i - i % 3;
+        for (uint32_t k = 0; k < 3; k++) {
+            uint32_t v = cube_indices[base + k];
+            if (v != 0 && !adjacent[v]) {
+                adjacent[v] = 1;
+                adjacent_count++;
+            }
+        }
+    }
+
+    uint32_t ring[16];
+    uint32_t count = halfedge_mesh_one_ring(cube, 0, ring, 16);
+    int ring_ok = count == adjacent_count;
+    for (uint32_t i = 0; i < count && i < 16; i++) {
+        ring_ok &= ring[i] < 8 && adjacent[ring[i]];
+        if (ring[i] < 8) adjacent[ring[i]] = 0;
+    }
+    TEST_ASSERT(ring_ok, "Cube corner one-ring should hold its edge neighbours");
+
+    // Rotation visits every outgoing half-edge of a vertex exactly once
+    uint32_t visits = 0;
+    int32_t start = cube->vertex_halfedge[6], h = start;
+    do {
+        visits++;
+        h = halfedge_rotate(cube, h);
+    } while (h >= 0 && h != start && visits < 32);
+    uint32_t degree = 0;
+    for (uint32_t c = 0; c < 36; c++) degree += cube_indices[c] == 6;
+    TEST_ASSERT(h == start && visits == degree, "Rotation should cycle once around a closed vertex");
+    halfedge_mesh_destroy(cube);
+}
+
+static void test_open_mesh(void) {
+    printf("\n--- Open Mesh Tests ---\n");
+
+    const uint32_t size = 8;
+    uint32_t* indices = make_grid_indices(size);
+    HalfEdgeMesh* grid = halfedge_mesh_build_indices(indices, size * size * 6, (size + 1) * (size + 1));
+    TEST_ASSERT_NOT_NULL(grid, "Grid should build");
+    if (grid) {
+        halfedge_mesh_print("Grid", grid);
+        TEST_ASSERT_EQUAL(4 * size, grid->border_edge_count, "Grid border should have 4 * size edges");
+        TEST_ASSERT(!halfedge_mesh_is_closed_manifold(grid) && grid->nonmanifold_vertex_count == 0,
+                    "Grid should be an open manifold");
+        TEST_ASSERT(twins_consistent(grid), "Grid twins should be consistent");
+        TEST_ASSERT_EQUAL(1, (int)grid->vertex_count - (int)grid->edge_count + (int)grid->face_count,
+                          "Disc Euler characteristic should be 1");
+
+        uint32_t interior = 4 * (size + 1) + 4;
+        uint32_t ring[16];
+        TEST_ASSERT_EQUAL(6u, halfedge_mesh_one_ring(grid, interior, ring, 16), "Interior grid vertices should have six neighbours");
+        TEST_ASSERT(!(grid->vertex_flags[interior] & HALFEDGE_VERTEX_BORDER) && (grid->vertex_flags[0] & HALFEDGE_VERTEX_BORDER),
+                    "Border flags should mark only border vertices");
+        uint32_t edge_vertex = 4;
+        uint32_t n = halfedge_mesh_one_ring(grid, edge_vertex, ring, 16);
+        int has_left = 0, has_right = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            has_left |= ring[i] == edge_vertex - 1;
+            has_right |= ring[i] == edge_vertex + 1;
+        }
+        TEST_ASSERT(n == 4 && has_left && has_right, "Border one-rings should run from border to border");
+        TEST_ASSERT_EQUAL(4u, halfedge_mesh_one_ring(grid, edge_vertex, ring, 2), "One-ring should count past its capacity");
+    }
+    halfedge_mesh_destroy(grid);
+    free(indices);
+}
+
+static void test_nonmanifold(void) {
+    printf("\n--- Non-Manifold Detection Tests ---\n");
+
+    // Three triangles on edge 0-1
+    const uint32_t fin[9] = { 0, 1, 2, 1, 0, 3, 0, 1, 4 };
+    HalfEdgeMesh* mesh = halfedge_mesh_build_indices(fin, 9, 5);
+    TEST_ASSERT(mesh && mesh->nonmanifold_edge_count == 3 && (mesh->vertex_flags[0] & HALFEDGE_VERTEX_NONMANIFOLD) &&
+                (mesh->vertex_flags[1] & HALFEDGE_VERTEX_NONMANIFOLD) && !(mesh->vertex_flags[2] & HALFEDGE_VERTEX_NONMANIFOLD),
+                "An edge with three faces should be non-manifold");
+    halfedge_mesh_destroy(mesh);
+
+    // Two fans meeting at vertex 0
+    const uint32_t bowtie[6] = { 0, 1, 2, 0, 3, 4 };
+    mesh = halfedge_mesh_build_indices(bowtie, 6, 5);
+    TEST_ASSERT(mesh && mesh->nonmanifold_edge_count == 0 && mesh->nonmanifold_vertex_count == 1 &&
+                (mesh->vertex_flags[0] & HALFEDGE_VERTEX_NONMANIFOLD), "A bowtie vertex should be non-manifold");
+    halfedge_mesh_destroy(mesh);
+
+    // Second triangle wound against the first
+    const uint32_t flipped[6] = { 0, 1, 2, 0, 1, 3 };
+    mesh = halfedge_mesh_build_indices(flipped, 6, 4);
+    TEST_ASSERT(mesh && mesh->twin[0] == HALFEDGE_NONMANIFOLD && mesh->twin[3] == HALFEDGE_NONMANIFOLD,
+                "Inconsistently wound shared edges should be flagged");
+    halfedge_mesh_destroy(mesh);
+
+    const uint32_t degenerate[6] = { 0, 1, 2, 2, 1, 1 };
+    mesh = halfedge_mesh_build_indices(degenerate, 6, 3);
+    TEST_ASSERT(mesh && mesh->degenerate_face_count == 1 && mesh->border_edge_count == 3 &&
+                mesh->twin[3] == HALFEDGE_NONMANIFOLD, "Degenerate faces should be counted and left unpaired");
+    halfedge_mesh_destroy(mesh);
+
+    const uint32_t bad[3] = { 0, 1, 7 };
+    TEST_ASSERT(halfedge_mesh_build_indices(bad, 3, 3) == NULL, "Out-of-range indices should be rejected");
+    TEST_ASSERT(halfedge_mesh_build_indices(bad, 2, 8) == NULL, "Partial triangles should be rejected");
+    TEST_ASSERT(halfedge_mesh_build(NULL) == NULL, "NULL meshes should be rejected");
+}
+
+static void test_assets(void) {
+    printf("\n--- Asset Tests ---\n");
+
+    const char* names[2] = { "UnitBox.fbx", "UnitSphere.fbx" };
+    for (uint32_t n = 0; n < 2; n++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", assets_dir, names[n]);
+        char* err = NULL;
+        Model3D* model = fbx_load_model(path, &err);
+        if (!model) {
+            printf("  %s unavailable: %s\n", names[n], err ? err : "(no error)");
+            fbx_free_error(err);
+            TEST_ASSERT(0, "Sample asset should load");
+            continue;
+        }
+        int ok = 1;
+        for (uint32_t m = 0; m < model->mesh_count; m++) {
+            HalfEdgeMesh* mesh = halfedge_mesh_build(&model->meshes[m]);
+            halfedge_mesh_print(names[n], mesh);
+            ok &= mesh && twins_consistent(mesh);
+            halfedge_mesh_destroy(mesh);
+        }
+        TEST_ASSERT(ok, "Sample asset should build with consistent twins");
+        model3d_free(model);
+        free(model);
+    }
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t size = 708;  // ~1M triangles
+    uint32_t* indices = make_grid_indices(size);
+    uint32_t index_count = size * size * 6, vertex_count = (size + 1) * (size + 1);
+
+    double best_ms = 1.0e9;
+    HalfEdgeMesh* mesh = NULL;
+    for (int r = 0; r < 3; r++) {
+        double start = now_ms();
+        HalfEdgeMesh* built = halfedge_mesh_build_indices(indices, index_count, vertex_count);
+        double t = now_ms() - start;
+        best_ms = t < best_ms ? t : best_ms;
+        halfedge_mesh_destroy(mesh);
+        mesh = built;
+    }
+    double per_million = best_ms * 1.0e6 / (index_count / 3);
+    printf("  %u triangles: build %.2f ms (%.1f ms per million triangles)\n", index_count / 3, best_ms, per_million);
+
+    uint64_t checksum = 0;
+    uint32_t ring[32];
+    double start = now_ms();
+    for (uint32_t v = 0; mesh && v < vertex_count; v++) {
+        uint32_t count = halfedge_mesh_one_ring(mesh, v, ring, 32);
+        checksum += count;
+    }
+    double ring_ms = now_ms() - start;
+    printf("  One-ring of every vertex: %.2f ms (%.1f ns/vertex, checksum %llu)\n", ring_ms,
+           ring_ms * 1.0e6 / vertex_count, (unsigned long long)checksum);
+
+    TEST_ASSERT(mesh && mesh->border_edge_count == 4 * size, "Million-triangle grid should build correctly");
+    TEST_ASSERT(per_million < 1000.0, "Construction should take under a second per million triangles");
+
+    halfedge_mesh_destroy(mesh);
+    free(indices);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Half-Edge Unit Tests\n");
+    printf("===================================\n");
+
+    test_closed_mesh();
+    test_open_mesh();
+    test_nonmanifold();
+    test_assets();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
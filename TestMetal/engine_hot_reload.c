@@ -0,0 +1,451 @@
+#include "engine_hot_reload.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#define HOT_RELOAD_HAS_INOTIFY 1
+#else
+#define HOT_RELOAD_HAS_INOTIFY 0
+#endif
+
+#ifdef __APPLE__
+#define HOT_RELOAD_MTIME(st) ((int64_t)(st).st_mtimespec.tv_sec * 1000000000 + (st).st_mtimespec.tv_nsec)
+#else
+#define HOT_RELOAD_MTIME(st) ((int64_t)(st).st_mtim.tv_sec * 1000000000 + (st).st_mtim.tv_nsec)
+#endif
+
+// ============================================================================
+// INTERNAL STRUCTURES
+// ============================================================================
+
+typedef struct {
+    char name[HOT_RELOAD_NAME_MAX];
+    char path[HOT_RELOAD_PATH_MAX + HOT_RELOAD_NAME_MAX];
+    uint32_t directory;                 // Index into HotReloader.directories
+    HotReloadHandler handler;
+    int64_t mtime_ns;                   // Last seen by the polling backend
+    int64_t size;
+    double due_ms;                      // Re-import time after the last change (0: none)
+    void* ready;                        // Finished import waiting for hot_reload_apply
+} HotReloadAsset;
+
+typedef struct {
+    char name[HOT_RELOAD_NAME_MAX];     // Relative, with a trailing '/' ("" for the root)
+    int wd;                             // inotify watch descriptor
+} HotReloadDirectory;
+
+typedef struct HotReloader {
+    HotReloadDesc desc;
+    char root[HOT_RELOAD_PATH_MAX];
+    HotReloadAsset assets[HOT_RELOAD_MAX_ASSETS];
+    uint32_t asset_count;
+    HotReloadDirectory directories[HOT_RELOAD_MAX_DIRECTORIES];
+    uint32_t directory_count;
+    int inotify_fd;                     // -1 when polling
+    int wake_pipe[2];                   // Wakes the thread for shutdown
+    int stop;
+    double next_poll_ms;
+    HotReloadStats stats;
+    pthread_t thread;
+    pthread_mutex_t mutex;              // Guards assets, directories, stop and stats
+} HotReloader;
+
+static double hot_reload_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Snapshot for the polling backend. Returns 0 when the file is missing,
+// e.g. between an editor's delete and rename.
+static int hot_reload_stat(const char* path, int64_t* mtime_ns, int64_t* size) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        return 0;
+    }
+    *mtime_ns = HOT_RELOAD_MTIME(st);
+    *size = (int64_t)st.st_size;
+    return 1;
+}
+
+// Called with the mutex held
+static void hot_reload_mark_changed(HotReloader* reloader, HotReloadAsset* asset, double now) {
+    asset->due_ms = now + reloader->desc.settle_ms;
+    if (asset->due_ms <= 0.0) {
+        asset->due_ms = 1e-3;
+    }
+    reloader->stats.changes++;
+}
+
+// ============================================================================
+// CHANGE DETECTION
+// ============================================================================
+
+#if HOT_RELOAD_HAS_INOTIFY
+// Drain pending inotify events and mark the watched files they name
+static void hot_reload_read_events(HotReloader* reloader) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    for (;;) {
+        ssize_t length = read(reloader->inotify_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            return;
+        }
+        double now = hot_reload_now_ms();
+        pthread_mutex_lock(&reloader->mutex);
+        for (char* p = buffer; p < buffer + length;) {
+            const struct inotify_event* event = (const struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + event->len;
+
+            // Dropped events: anything may have changed
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (uint32_t i = 0; i < reloader->asset_count; i++) {
+                    hot_reload_mark_changed(reloader, &reloader->assets[i], now);
+                }
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+            uint32_t directory = 0;
+            while (directory < reloader->directory_count && reloader->directories[directory].wd != event->wd) {
+                directory++;
+            }
+            if (directory == reloader->directory_count) {
+                continue;
+            }
+            size_t prefix = strlen(reloader->directories[directory].name);
+            for (uint32_t i = 0; i < reloader->asset_count; i++) {
+                HotReloadAsset* asset = &reloader->assets[i];
+                if (asset->directory == directory && strcmp(asset->name + prefix, event->name) == 0) {
+                    hot_reload_mark_changed(reloader, asset, now);
+                }
+            }
+        }
+        pthread_mutex_unlock(&reloader->mutex);
+    }
+}
+#endif
+
+// Compare every watched file with its last snapshot
+static void hot_reload_poll_files(HotReloader* reloader) {
+    pthread_mutex_lock(&reloader->mutex);
+    double now = hot_reload_now_ms();
+    for (uint32_t i = 0; i < reloader->asset_count; i++) {
+        HotReloadAsset* asset = &reloader->assets[i];
+        int64_t mtime_ns;
+        int64_t size;
+        if (hot_reload_stat(asset->path, &mtime_ns, &size) && (mtime_ns != asset->mtime_ns || size != asset->size)) {
+            asset->mtime_ns = mtime_ns;
+            asset->size = size;
+            hot_reload_mark_changed(reloader, asset, now);
+        }
+    }
+    pthread_mutex_unlock(&reloader->mutex);
+}
+
+// ============================================================================
+// IMPORTING
+// ============================================================================
+
+// Import every asset whose settle time has passed. Imports run unlocked, so
+// the render thread can keep applying while a large file loads.
+static void hot_reload_run_imports(HotReloader* reloader) {
+    double now = hot_reload_now_ms();
+    pthread_mutex_lock(&reloader->mutex);
+    for (uint32_t i = 0; i < reloader->asset_count && !reloader->stop; i++) {
+        HotReloadAsset* asset = &reloader->assets[i];
+        if (asset->due_ms == 0.0 || asset->due_ms > now) {
+            continue;
+        }
+        asset->due_ms = 0.0;
+        HotReloadHandler handler = asset->handler;
+        pthread_mutex_unlock(&reloader->mutex);
+
+        void* imported = handler.import(handler.user_data, asset->path);
+
+        pthread_mutex_lock(&reloader->mutex);
+        void* superseded = NULL;
+        if (!imported) {
+            reloader->stats.import_failures++;
+        } else {
+            reloader->stats.imports++;
+            superseded = asset->ready;
+            asset->ready = imported;
+            if (superseded) {
+                reloader->stats.superseded++;
+            }
+        }
+        if (superseded && handler.discard) {
+            pthread_mutex_unlock(&reloader->mutex);
+            handler.discard(handler.user_data, superseded);
+            pthread_mutex_lock(&reloader->mutex);
+        }
+    }
+    pthread_mutex_unlock(&reloader->mutex);
+}
+
+static void* hot_reload_main(void* arg) {
+    HotReloader* reloader = (HotReloader*)arg;
+    for (;;) {
+        // Sleep until an event, the next poll or the earliest pending import
+        pthread_mutex_lock(&reloader->mutex);
+        if (reloader->stop) {
+            pthread_mutex_unlock(&reloader->mutex);
+            break;
+        }
+        double now = hot_reload_now_ms();
+        double wake = reloader->inotify_fd >= 0 ? now + 1000.0 : reloader->next_poll_ms;
+        for (uint32_t i = 0; i < reloader->asset_count; i++) {
+            double due = reloader->assets[i].due_ms;
+            if (due != 0.0 && due < wake) {
+                wake = due;
+            }
+        }
+        pthread_mutex_unlock(&reloader->mutex);
+
+        struct pollfd fds[2];
+        fds[0].fd = reloader->wake_pipe[0];
+        fds[0].events = POLLIN;
+        fds[1].fd = reloader->inotify_fd;
+        fds[1].events = POLLIN;
+        int timeout = wake > now ? (int)(wake - now) + 1 : 0;
+        poll(fds, reloader->inotify_fd >= 0 ? 2 : 1, timeout);
+
+#if HOT_RELOAD_HAS_INOTIFY
+        if (reloader->inotify_fd >= 0) {
+            hot_reload_read_events(reloader);
+        }
+#endif
+        if (reloader->inotify_fd < 0 && hot_reload_now_ms() >= reloader->next_poll_ms) {
+            hot_reload_poll_files(reloader);
+            reloader->next_poll_ms = hot_reload_now_ms() + reloader->desc.poll_interval_ms;
+        }
+        hot_reload_run_imports(reloader);
+    }
+    return NULL;
+}
+
+// ============================================================================
+// PUBLIC API IMPLEMENTATION
+// ============================================================================
+
+HotReloadDesc hot_reload_desc_default(const char* root) {
+    HotReloadDesc desc;
+    desc.root = root;
+    desc.poll_interval_ms = HOT_RELOAD_DEFAULT_POLL_MS;
+    desc.settle_ms = HOT_RELOAD_DEFAULT_SETTLE_MS;
+    desc.force_polling = 0;
+    return desc;
+}
+
+HotReloaderHandle hot_reload_create(const HotReloadDesc* desc) {
+    if (!desc || !desc->root || strlen(desc->root) + 2 >= HOT_RELOAD_PATH_MAX) {
+        fprintf(stderr, "Error: Invalid hot reload root\n");
+        return NULL;
+    }
+    struct stat st;
+    if (stat(desc->root, &st) != 0 || !S_ISDIR(st.st_mode)) {
+        fprintf(stderr, "Error: Hot reload root is not a directory: %s\n", desc->root);
+        return NULL;
+    }
+
+    HotReloader* reloader = (HotReloader*)calloc(1, sizeof(HotReloader));
+    if (!reloader) {
+        fprintf(stderr, "Error: Failed to allocate memory for hot reloader\n");
+        return NULL;
+    }
+    reloader->desc = *desc;
+    if (reloader->desc.poll_interval_ms == 0) {
+        reloader->desc.poll_interval_ms = HOT_RELOAD_DEFAULT_POLL_MS;
+    }
+    snprintf(reloader->root, sizeof(reloader->root), "%s", desc->root);
+    size_t root_length = strlen(reloader->root);
+    if (root_length > 1 && reloader->root[root_length - 1] == '/') {
+        reloader->root[root_length - 1] = '\0';
+    }
+    reloader->desc.root = reloader->root;
+
+    reloader->inotify_fd = -1;
+#if HOT_RELOAD_HAS_INOTIFY
+    if (!desc->force_polling) {
+        reloader->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    }
+#endif
+    reloader->stats.backend = reloader->inotify_fd >= 0 ? HOT_RELOAD_BACKEND_INOTIFY : HOT_RELOAD_BACKEND_POLL;
+    reloader->next_poll_ms = hot_reload_now_ms() + reloader->desc.poll_interval_ms;
+
+    if (pipe(reloader->wake_pipe) != 0) {
+        fprintf(stderr, "Error: Failed to create hot reload wake pipe\n");
+        if (reloader->inotify_fd >= 0) {
+            close(reloader->inotify_fd);
+        }
+        free(reloader);
+        return NULL;
+    }
+    pthread_mutex_init(&reloader->mutex, NULL);
+    if (pthread_create(&reloader->thread, NULL, hot_reload_main, reloader) != 0) {
+        fprintf(stderr, "Error: Failed to start hot reload thread\n");
+        pthread_mutex_destroy(&reloader->mutex);
+        close(reloader->wake_pipe[0]);
+        close(reloader->wake_pipe[1]);
+        if (reloader->inotify_fd >= 0) {
+            close(reloader->inotify_fd);
+        }
+        free(reloader);
+        return NULL;
+    }
+    return reloader;
+}
+
+void hot_reload_destroy(HotReloaderHandle reloader) {
+    if (!reloader) {
+        return;
+    }
+    pthread_mutex_lock(&reloader->mutex);
+    reloader->stop = 1;
+    pthread_mutex_unlock(&reloader->mutex);
+    ssize_t written = write(reloader->wake_pipe[1], "x", 1);
+    (void)written;
+    pthread_join(reloader->thread, NULL);
+
+    for (uint32_t i = 0; i < reloader->asset_count; i++) {
+        HotReloadAsset* asset = &reloader->assets[i];
+        if (asset->ready && asset->handler.discard) {
+            asset->handler.discard(asset->handler.user_data, asset->ready);
+        }
+    }
+    if (reloader->inotify_fd >= 0) {
+        close(reloader->inotify_fd);
+    }
+    close(reloader->wake_pipe[0]);
+    close(reloader->wake_pipe[1]);
+    pthread_mutex_destroy(&reloader->mutex);
+    free(reloader);
+}
+
+int hot_reload_watch(HotReloaderHandle reloader, const char* name, const HotReloadHandler* handler) {
+    if (!reloader || !name || !handler || !handler->import || !handler->apply) {
+        return 0;
+    }
+    size_t length = strlen(name);
+    if (length == 0 || length >= HOT_RELOAD_NAME_MAX || name[0] == '/' || strstr(name, "..")) {
+        fprintf(stderr, "Error: Invalid hot reload asset name: %s\n", name);
+        return 0;
+    }
+
+    pthread_mutex_lock(&reloader->mutex);
+    int ok = reloader->asset_count < HOT_RELOAD_MAX_ASSETS;
+    for (uint32_t i = 0; ok && i < reloader->asset_count; i++) {
+        ok = strcmp(reloader->assets[i].name, name) != 0;
+    }
+    if (!ok) {
+        pthread_mutex_unlock(&reloader->mutex);
+        return 0;
+    }
+
+    // Watches are per directory: editors often save by renaming a new file
+    // over the old one, which a watch on the file itself would miss
+    const char* slash = strrchr(name, '/');
+    size_t prefix = slash ? (size_t)(slash - name + 1) : 0;
+    uint32_t directory = 0;
+    while (directory < reloader->directory_count &&
+           (strlen(reloader->directories[directory].name) != prefix ||
+            strncmp(reloader->directories[directory].name, name, prefix) != 0)) {
+        directory++;
+    }
+    if (directory == reloader->directory_count) {
+        if (directory == HOT_RELOAD_MAX_DIRECTORIES) {
+            pthread_mutex_unlock(&reloader->mutex);
+            fprintf(stderr, "Error: Too many hot reload directories\n");
+            return 0;
+        }
+        HotReloadDirectory* entry = &reloader->directories[directory];
+        memcpy(entry->name, name, prefix);
+        entry->name[prefix] = '\0';
+        entry->wd = -1;
+        char path[HOT_RELOAD_PATH_MAX + HOT_RELOAD_NAME_MAX];
+        snprintf(path, sizeof(path), "%s/%s", reloader->root, entry->name);
+        struct stat st;
+        int valid = stat(path, &st) == 0 && S_ISDIR(st.st_mode);
+#if HOT_RELOAD_HAS_INOTIFY
+        if (valid && reloader->inotify_fd >= 0) {
+            entry->wd = inotify_add_watch(reloader->inotify_fd, path, IN_CLOSE_WRITE | IN_MOVED_TO);
+            valid = entry->wd >= 0;
+        }
+#endif
+        if (!valid) {
+            pthread_mutex_unlock(&reloader->mutex);
+            fprintf(stderr, "Error: Failed to watch directory: %s\n", path);
+            return 0;
+        }
+        reloader->directory_count++;
+    }
+
+    HotReloadAsset* asset = &reloader->assets[reloader->asset_count];
+    memset(asset, 0, sizeof(*asset));
+    memcpy(asset->name, name, length + 1);
+    snprintf(asset->path, sizeof(asset->path), "%s/%s", reloader->root, name);
+    asset->directory = directory;
+    asset->handler = *handler;
+    hot_reload_stat(asset->path, &asset->mtime_ns, &asset->size);
+    reloader->asset_count++;
+    reloader->stats.watched = reloader->asset_count;
+    pthread_mutex_unlock(&reloader->mutex);
+    return 1;
+}
+
+uint32_t hot_reload_apply(HotReloaderHandle reloader) {
+    if (!reloader) {
+        return 0;
+    }
+    uint32_t indices[HOT_RELOAD_MAX_ASSETS];
+    void* imports[HOT_RELOAD_MAX_ASSETS];
+    uint32_t count = 0;
+    pthread_mutex_lock(&reloader->mutex);
+    for (uint32_t i = 0; i < reloader->asset_count; i++) {
+        if (reloader->assets[i].ready) {
+            indices[count] = i;
+            imports[count++] = reloader->assets[i].ready;
+            reloader->assets[i].ready = NULL;
+        }
+    }
+    reloader->stats.applied += count;
+    pthread_mutex_unlock(&reloader->mutex);
+
+    // Name and handler never change once watched, so read them unlocked
+    for (uint32_t i = 0; i < count; i++) {
+        const HotReloadAsset* asset = &reloader->assets[indices[i]];
+        asset->handler.apply(asset->handler.user_data, asset->name, imports[i]);
+    }
+    return count;
+}
+
+void hot_reload_get_stats(HotReloaderHandle reloader, HotReloadStats* stats) {
+    if (!reloader || !stats) {
+        return;
+    }
+    pthread_mutex_lock(&reloader->mutex);
+    *stats = reloader->stats;
+    pthread_mutex_unlock(&reloader->mutex);
+}
+
+void hot_reload_print(const char* name, HotReloaderHandle reloader) {
+    if (!reloader) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+    HotReloadStats stats;
+    hot_reload_get_stats(reloader, &stats);
+    printf("%s: %s, %u files under %s\n", name,
+           stats.backend == HOT_RELOAD_BACKEND_INOTIFY ? "inotify" : "polling", stats.watched, reloader->root);
+    printf("  %u changes, %u imports, %u failures, %u superseded, %u applied\n",
+           stats.changes, stats.imports, stats.import_failures, stats.superseded, stats.applied);
+}
@@ -0,0 +1,99 @@
+#ifndef ENGINE_HOT_RELOAD_H
+#define ENGINE_HOT_RELOAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// ============================================================================
+// HOT RELOAD CONFIGURATION
+// ============================================================================
+
+#define HOT_RELOAD_MAX_ASSETS 256               // Watched files per reloader
+#define HOT_RELOAD_MAX_DIRECTORIES 32           // Distinct directories among them
+#define HOT_RELOAD_NAME_MAX 256                 // Asset name, relative to the root
+#define HOT_RELOAD_PATH_MAX 1024
+
+#define HOT_RELOAD_DEFAULT_POLL_MS 250
+#define HOT_RELOAD_DEFAULT_SETTLE_MS 50
+
+// ============================================================================
+// HOT RELOAD TYPES
+// ============================================================================
+
+typedef enum {
+    HOT_RELOAD_BACKEND_INOTIFY = 0,             // Directory watches (Linux)
+    HOT_RELOAD_BACKEND_POLL                     // stat() every poll interval
+} HotReloadBackend;
+
+// import runs on the reloader thread with the full path and returns the new
+// asset (NULL keeps the current one, e.g. for a half-written file). apply
+// runs inside hot_reload_apply and takes ownership of the import, swapping
+// it in behind the handles the engine already gave out. discard frees an
+// import that is superseded or never applied and may be NULL.
+typedef void* (*HotReloadImportFunc)(void* user_data, const char* path);
+typedef void (*HotReloadApplyFunc)(void* user_data, const char* name, void* imported);
+typedef void (*HotReloadDiscardFunc)(void* user_data, void* imported);
+
+typedef struct {
+    HotReloadImportFunc import;
+    HotReloadApplyFunc apply;
+    HotReloadDiscardFunc discard;
+    void* user_data;
+} HotReloadHandler;
+
+typedef struct {
+    const char* root;               // Directory asset names are relative to
+    uint32_t poll_interval_ms;      // Stat period for the polling backend
+    uint32_t settle_ms;             // Quiet time after the last change before importing
+    int force_polling;              // Skip inotify even where it is available
+} HotReloadDesc;
+
+// Counters accumulate over the reloader's lifetime
+typedef struct {
+    uint32_t backend;               // HotReloadBackend in use
+    uint32_t watched;
+    uint32_t changes;               // Change notifications for watched files
+    uint32_t imports;               // Successful imports
+    uint32_t import_failures;       // Imports that returned NULL
+    uint32_t superseded;            // Imports replaced by a newer one before applying
+    uint32_t applied;
+} HotReloadStats;
+
+// Opaque reloader handle (owns the watcher thread)
+typedef struct HotReloader* HotReloaderHandle;
+
+// ============================================================================
+// HOT RELOAD FUNCTIONS
+// ============================================================================
+
+// Defaults: HOT_RELOAD_DEFAULT_POLL_MS, HOT_RELOAD_DEFAULT_SETTLE_MS, inotify when available
+HotReloadDesc hot_reload_desc_default(const char* root);
+
+// Start watching desc->root. Falls back to polling when inotify is
+// unavailable. Returns NULL on failure.
+HotReloaderHandle hot_reload_create(const HotReloadDesc* desc);
+
+// Stop the thread and discard imports that were never applied
+void hot_reload_destroy(HotReloaderHandle reloader);
+
+// Watch one file (name relative to the root; subdirectories allowed). A
+// change re-imports only this file. Returns 0 when full or already watched.
+int hot_reload_watch(HotReloaderHandle reloader, const char* name, const HotReloadHandler* handler);
+
+// Swap in every finished import, in watch order. Call at a frame boundary on
+// the thread that owns the assets. Returns the number applied.
+uint32_t hot_reload_apply(HotReloaderHandle reloader);
+
+void hot_reload_get_stats(HotReloaderHandle reloader, HotReloadStats* stats);
+
+// Print reloader state
+void hot_reload_print(const char* name, HotReloaderHandle reloader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_HOT_RELOAD_H
@@ -0,0 +1,335 @@
+#include "engine_hot_reload.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* ROOT = "/tmp/engine_hot_reload_test";
+
+// A stand-in for an engine asset: handles point at the slot, reloads
+// replace its contents
+typedef struct {
+    char* text;
+    uint32_t imports;               // Written by the reloader thread
+    uint32_t applies;
+    uint32_t discards;
+    int imported_off_thread;
+    int applied_on_thread;
+    pthread_t owner;
+} TextAsset;
+
+static void* text_import(void* user_data, const char* path) {
+    TextAsset* asset = (TextAsset*)user_data;
+    __sync_fetch_and_add(&asset->imports, 1);
+    asset->imported_off_thread = !pthread_equal(pthread_self(), asset->owner);
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    char* text = (char*)calloc(1, 256);
+    size_t length = text ? fread(text, 1, 255, f) : 0;
+    fclose(f);
+    if (text && (length == 0 || strncmp(text, "bad", 3) == 0)) {
+        free(text);                     // Simulated parse error
+        return NULL;
+    }
+    return text;
+}
+
+static void text_apply(void* user_data, const char* name, void* imported) {
+    TextAsset* asset = (TextAsset*)user_data;
+    (void)name;
+    free(asset->text);
+    asset->text = (char*)imported;
+    asset->applies++;
+    asset->applied_on_thread = pthread_equal(pthread_self(), asset->owner);
+}
+
+static void text_discard(void* user_data, void* imported) {
+    TextAsset* asset = (TextAsset*)user_data;
+    __sync_fetch_and_add(&asset->discards, 1);
+    free(imported);
+}
+
+static HotReloadHandler text_handler(TextAsset* asset) {
+    memset(asset, 0, sizeof(*asset));
+    asset->owner = pthread_self();
+    HotReloadHandler handler;
+    handler.import = text_import;
+    handler.apply = text_apply;
+    handler.discard = text_discard;
+    handler.user_data = asset;
+    return handler;
+}
+
+static void write_asset(const char* name, const char* text) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", ROOT, name);
+    FILE* f = fopen(path, "wb");
+    if (f) {
+        fputs(text, f);
+        fclose(f);
+    }
+}
+
+// Save the way many editors do: write a temporary file, rename it over the asset
+static void replace_asset(const char* name, const char* text) {
+    char path[512];
+    char temp[512];
+    snprintf(path, sizeof(path), "%s/%s", ROOT, name);
+    snprintf(temp, sizeof(temp), "%s/%s.tmp", ROOT, name);
+    FILE* f = fopen(temp, "wb");
+    if (f) {
+        fputs(text, f);
+        fclose(f);
+        rename(temp, path);
+    }
+}
+
+// Run frames (hot_reload_apply) until the asset has been applied `applies` times
+static int wait_applied(HotReloaderHandle reloader, const TextAsset* asset, uint32_t applies, double timeout_ms) {
+    double start = now_ms();
+    while (now_ms() - start < timeout_ms) {
+        hot_reload_apply(reloader);
+        if (asset->applies >= applies) {
+            return 1;
+        }
+        usleep(1000);
+    }
+    return 0;
+}
+
+static uint32_t import_count(TextAsset* asset) {
+    return __sync_fetch_and_add(&asset->imports, 0);
+}
+
+// Wait for the reloader thread without applying
+static int wait_imports(TextAsset* asset, uint32_t imports, double timeout_ms) {
+    double start = now_ms();
+    while (now_ms() - start < timeout_ms) {
+        if (import_count(asset) >= imports) {
+            return 1;
+        }
+        usleep(1000);
+    }
+    return 0;
+}
+
+static void setup_root(void) {
+    char path[512];
+    mkdir(ROOT, 0755);
+    snprintf(path, sizeof(path), "%s/textures", ROOT);
+    mkdir(path, 0755);
+    write_asset("model.fbx", "model v1");
+    write_asset("font.ttf", "font v1");
+    write_asset("textures/wood.png", "wood v1");
+}
+
+static void cleanup_root(void) {
+    char path[512];
+    const char* files[] = {"model.fbx", "font.ttf", "textures/wood.png", "model.fbx.tmp"};
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        snprintf(path, sizeof(path), "%s/%s", ROOT, files[i]);
+        unlink(path);
+    }
+    snprintf(path, sizeof(path), "%s/textures", ROOT);
+    rmdir(path);
+    rmdir(ROOT);
+}
+
+// ============================================================================
+// HOT RELOAD TESTS
+// ============================================================================
+
+static void test_creation(void) {
+    printf("\n--- Creation Tests ---\n");
+
+    HotReloadDesc desc = hot_reload_desc_default("/tmp/engine_hot_reload_missing");
+    TEST_ASSERT(hot_reload_create(&desc) == NULL, "Missing root rejected");
+    TEST_ASSERT(hot_reload_create(NULL) == NULL, "NULL desc rejected");
+
+    desc = hot_reload_desc_default(ROOT);
+    HotReloaderHandle reloader = hot_reload_create(&desc);
+    TEST_ASSERT_NOT_NULL(reloader, "Reloader created");
+    if (!reloader) {
+        return;
+    }
+
+    TextAsset asset;
+    HotReloadHandler handler = text_handler(&asset);
+    TEST_ASSERT(hot_reload_watch(reloader, "model.fbx", &handler), "File watched");
+    TEST_ASSERT(!hot_reload_watch(reloader, "model.fbx", &handler), "Duplicate watch rejected");
+    TEST_ASSERT(!hot_reload_watch(reloader, "/etc/passwd", &handler), "Absolute name rejected");
+    TEST_ASSERT(!hot_reload_watch(reloader, "../escape.png", &handler), "Parent directory rejected");
+    TEST_ASSERT(!hot_reload_watch(reloader, "missing/dir.png", &handler), "File in a missing directory rejected");
+    HotReloadHandler incomplete = handler;
+    incomplete.apply = NULL;
+    TEST_ASSERT(!hot_reload_watch(reloader, "font.ttf", &incomplete), "Handler without apply rejected");
+
+    HotReloadStats stats;
+    hot_reload_get_stats(reloader, &stats);
+    TEST_ASSERT_EQUAL(1u, stats.watched, "One file watched");
+    TEST_ASSERT_EQUAL(0u, hot_reload_apply(reloader), "Nothing to apply before a change");
+    hot_reload_print("Reloader", reloader);
+    hot_reload_destroy(reloader);
+    TEST_ASSERT_EQUAL(0u, asset.imports, "No import without a change");
+    hot_reload_destroy(NULL);
+}
+
+static void test_reload(const char* label, int force_polling) {
+    printf("\n--- %s Reload Tests ---\n", label);
+
+    setup_root();
+    HotReloadDesc desc = hot_reload_desc_default(ROOT);
+    desc.force_polling = force_polling;
+    desc.poll_interval_ms = 20;
+    desc.settle_ms = 10;
+    HotReloaderHandle reloader = hot_reload_create(&desc);
+    TEST_ASSERT_NOT_NULL(reloader, "Reloader created");
+    if (!reloader) {
+        cleanup_root();
+        return;
+    }
+
+    HotReloadStats stats;
+    hot_reload_get_stats(reloader, &stats);
+#ifdef __linux__
+    TEST_ASSERT_EQUAL(force_polling ? (uint32_t)HOT_RELOAD_BACKEND_POLL : (uint32_t)HOT_RELOAD_BACKEND_INOTIFY,
+                      stats.backend, "Expected backend selected");
+#endif
+
+    TextAsset model;
+    TextAsset font;
+    TextAsset wood;
+    HotReloadHandler model_handler = text_handler(&model);
+    HotReloadHandler font_handler = text_handler(&font);
+    HotReloadHandler wood_handler = text_handler(&wood);
+    TEST_ASSERT(hot_reload_watch(reloader, "model.fbx", &model_handler) &&
+                hot_reload_watch(reloader, "font.ttf", &font_handler) &&
+                hot_reload_watch(reloader, "textures/wood.png", &wood_handler), "Three files watched");
+
+    // Polling needs the mtime or size to differ from the snapshot
+    usleep(20000);
+
+    // A plain write reloads just that file
+    double start = now_ms();
+    write_asset("model.fbx", "model v2!");
+    TEST_ASSERT(wait_applied(reloader, &model, 1, 3000.0), "Changed file reloaded");
+    printf("  Save to swap: %.1f ms\n", now_ms() - start);
+    TEST_ASSERT(model.text && strcmp(model.text, "model v2!") == 0, "New contents swapped in");
+    TEST_ASSERT(model.imported_off_thread, "Import ran on the reloader thread");
+    TEST_ASSERT(model.applied_on_thread, "Swap ran on the frame thread");
+    TEST_ASSERT(import_count(&font) == 0 && import_count(&wood) == 0, "Unchanged files not re-imported");
+
+    // Subdirectory
+    write_asset("textures/wood.png", "wood v2");
+    TEST_ASSERT(wait_applied(reloader, &wood, 1, 3000.0), "File in a subdirectory reloaded");
+    TEST_ASSERT(wood.text && strcmp(wood.text, "wood v2") == 0, "Subdirectory contents swapped in");
+
+    // Rename-over save
+    replace_asset("model.fbx", "model v3, renamed");
+    TEST_ASSERT(wait_applied(reloader, &model, 2, 3000.0), "Rename-over save reloaded");
+    TEST_ASSERT(model.text && strcmp(model.text, "model v3, renamed") == 0, "Renamed contents swapped in");
+
+    // Imports wait for the frame boundary
+    uint32_t imports = import_count(&model);
+    write_asset("model.fbx", "model v4 pending");
+    TEST_ASSERT(wait_imports(&model, imports + 1, 3000.0), "Import finished in the background");
+    usleep(5000);
+    TEST_ASSERT(model.applies == 2 && strcmp(model.text, "model v3, renamed") == 0,
+                "Old asset kept until hot_reload_apply");
+    TEST_ASSERT_EQUAL(1u, hot_reload_apply(reloader), "One import applied at the frame boundary");
+    TEST_ASSERT(strcmp(model.text, "model v4 pending") == 0, "Pending import swapped in");
+
+    // Two saves before a frame: only the newest is applied
+    imports = import_count(&model);
+    write_asset("model.fbx", "model v5 first");
+    TEST_ASSERT(wait_imports(&model, imports + 1, 3000.0), "First save imported");
+    write_asset("model.fbx", "model v6 second!");
+    TEST_ASSERT(wait_imports(&model, imports + 2, 3000.0), "Second save imported");
+    usleep(5000);
+    TEST_ASSERT_EQUAL(1u, hot_reload_apply(reloader), "Superseded import applied once");
+    TEST_ASSERT(strcmp(model.text, "model v6 second!") == 0, "Newest contents win");
+    TEST_ASSERT_EQUAL(1u, model.discards, "Superseded import discarded");
+
+    // A failed import keeps the current asset
+    imports = import_count(&font);
+    write_asset("font.ttf", "bad font");
+    TEST_ASSERT(wait_imports(&font, imports + 1, 3000.0), "Broken file imported");
+    usleep(5000);
+    hot_reload_apply(reloader);
+    TEST_ASSERT(font.applies == 0 && font.text == NULL, "Failed import leaves the asset alone");
+
+    hot_reload_get_stats(reloader, &stats);
+    TEST_ASSERT(stats.import_failures >= 1, "Failure counted");
+    TEST_ASSERT(stats.superseded >= 1, "Superseded import counted");
+    TEST_ASSERT_EQUAL(model.applies + wood.applies, stats.applied, "Applied count matches");
+
+    // Imports never applied are discarded on shutdown
+    imports = import_count(&wood);
+    write_asset("textures/wood.png", "wood v3 unapplied");
+    TEST_ASSERT(wait_imports(&wood, imports + 1, 3000.0), "Import pending at shutdown");
+    usleep(5000);
+    hot_reload_print("Reloader", reloader);
+    hot_reload_destroy(reloader);
+    TEST_ASSERT_EQUAL(1u, wood.discards, "Pending import discarded on destroy");
+
+    free(model.text);
+    free(font.text);
+    free(wood.text);
+    cleanup_root();
+}
+
+int main(void) {
+    printf("Starting Hot Reload Unit Tests\n");
+    printf("==============================\n");
+
+    setup_root();
+    test_creation();
+    cleanup_root();
+    test_reload("inotify", 0);
+    test_reload("Polling", 1);
+
+    printf("\n==============================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,985 @@
+#include "engine_hull.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+
+#define HULL_NONE 0xFFFFFFFFu
+
+// ============================================================================
+// DOUBLE PRECISION HELPERS
+// ============================================================================
+
+// Hull construction runs in double so the float input is exact and the
+// tolerance only has to absorb the input's own rounding
+typedef struct {
+    double x, y, z;
+} HullPoint;
+
+static HullPoint hp_sub(HullPoint a, HullPoint b) {
+    HullPoint r = { a.x - b.x, a.y - b.y, a.z - b.z };
+    return r;
+}
+
+static double hp_dot(HullPoint a, HullPoint b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+static HullPoint hp_cross(HullPoint a, HullPoint b) {
+    HullPoint r = { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    return r;
+}
+
+static double hp_length(HullPoint a) {
+    return sqrt(hp_dot(a, a));
+}
+
+static int grow_array(void** data, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 1;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 64;
+    while (new_capacity < needed) new_capacity *= 2;
+    void* grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) {
+        return 0;
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+// ============================================================================
+// QUICKHULL
+// ============================================================================
+
+// Triangles live in a half-edge mesh: face f owns edges 3f..3f+2, edge
+// 3f+k runs from the head of its previous edge to heads[3f+k]
+typedef struct {
+    HullPoint normal;
+    double offset;              // dot(normal, p) = offset on the plane
+    uint32_t outside;           // Head of the list of points in front of the face
+    uint32_t far_point;
+    double far_distance;
+    uint8_t alive;
+    uint8_t visible;
+} QhFace;
+
+typedef struct {
+    HullPoint* points;
+    uint32_t point_count;
+    uint32_t* next_outside;     // Per point: next point in the same outside list
+    QhFace* faces;
+    uint32_t* heads;
+    uint32_t* twins;
+    uint32_t face_count;
+    uint32_t face_capacity;
+    uint32_t* visible;
+    uint32_t visible_count;
+    uint32_t visible_capacity;
+    uint32_t* horizon;
+    uint32_t horizon_count;
+    uint32_t horizon_capacity;
+    double tolerance;
+    int out_of_memory;
+} Quickhull;
+
+static uint32_t edge_next(uint32_t edge) {
+    return edge - edge % 3 + (edge % 3 + 1) % 3;
+}
+
+static uint32_t edge_prev(uint32_t edge) {
+    return edge - edge % 3 + (edge % 3 + 2) % 3;
+}
+
+static uint32_t edge_tail(const Quickhull* q, uint32_t edge) {
+    return q->heads[edge_prev(edge)];
+}
+
+static double face_distance(const Quickhull* q, uint32_t face, HullPoint p) {
+    return hp_dot(q->faces[face].normal, p) - q->faces[face].offset;
+}
+
+static uint32_t qh_add_face(Quickhull* q, uint32_t a, uint32_t b, uint32_t c) {
+    if (q->face_count == q->face_capacity) {
+        uint32_t capacity = q->face_capacity ? q->face_capacity * 2 : 64;
+        QhFace* faces = (QhFace*)realloc(q->faces, capacity * sizeof(QhFace));
+        if (faces) q->faces = faces;
+        uint32_t* heads = (uint32_t*)realloc(q->heads, capacity * 3 * sizeof(uint32_t));
+        if (heads) q->heads = heads;
+        uint32_t* twins = (uint32_t*)realloc(q->twins, capacity * 3 * sizeof(uint32_t));
+        if (twins) q->twins = twins;
+        if (!faces || !heads || !twins) {
+            q->out_of_memory = 1;
+            return HULL_NONE;
+        }
+        q->face_capacity = capacity;
+    }
+
+    uint32_t f = q->face_count++;
+    q->heads[3 * f + 0] = b;
+    q->heads[3 * f + 1] = c;
+    q->heads[3 * f + 2] = a;
+    q->twins[3 * f + 0] = q->twins[3 * f + 1] = q->twins[3 * f + 2] = HULL_NONE;
+
+    QhFace* face = &q->faces[f];
+    HullPoint pa = q->points[a], pb = q->points[b], pc = q->points[c];
+    HullPoint normal = hp_cross(hp_sub(pb, pa), hp_sub(pc, pa));
+    double length = hp_length(normal);
+    if (length > 0.0) {
+        normal.x /= length;
+        normal.y /= length;
+        normal.z /= length;
+    }
+    HullPoint centre = { (pa.x + pb.x + pc.x) / 3.0, (pa.y + pb.y + pc.y) / 3.0, (pa.z + pb.z + pc.z) / 3.0 };
+    face->normal = normal;
+    face->offset = hp_dot(normal, centre);
+    face->outside = HULL_NONE;
+    face->far_point = HULL_NONE;
+    face->far_distance = 0.0;
+    face->alive = 1;
+    face->visible = 0;
+    return f;
+}
+
+static void qh_add_outside(Quickhull* q, uint32_t face, uint32_t point, double distance) {
+    QhFace* f = &q->faces[face];
+    q->next_outside[point] = f->outside;
+    f->outside = point;
+    if (distance > f->far_distance) {
+        f->far_distance = distance;
+        f->far_point = point;
+    }
+}
+
+// Give a point to the face it is farthest in front of, if any
+static void qh_assign_point(Quickhull* q, uint32_t first_face, uint32_t face_end, uint32_t point) {
+    double best = q->tolerance;
+    uint32_t best_face = HULL_NONE;
+    for (uint32_t f = first_face; f < face_end; f++) {
+        if (!q->faces[f].alive) continue;
+        double distance = face_distance(q, f, q->points[point]);
+        if (distance > best) {
+            best = distance;
+            best_face = f;
+        }
+    }
+    if (best_face != HULL_NONE) {
+        qh_add_outside(q, best_face, point, best);
+    }
+}
+
+// Depth-first walk over the faces the eye can see. Horizon edges (visible
+// face on this side, hidden face across) come out as one closed
+// counter-clockwise loop.
+static void qh_compute_horizon(Quickhull* q, uint32_t face, uint32_t crossed_edge, HullPoint eye) {
+    q->faces[face].visible = 1;
+    if (!grow_array((void**)&q->visible, &q->visible_capacity, q->visible_count + 1, sizeof(uint32_t))) {
+        q->out_of_memory = 1;
+        return;
+    }
+    q->visible[q->visible_count++] = face;
+
+    uint32_t start = crossed_edge == HULL_NONE ? 3 * face : edge_next(crossed_edge);
+    uint32_t stop = crossed_edge == HULL_NONE ? start : crossed_edge;
+    uint32_t edge = start;
+    do {
+        uint32_t twin = q->twins[edge];
+        uint32_t neighbour = twin / 3;
+        if (!q->faces[neighbour].visible) {
+            if (face_distance(q, neighbour, eye) > q->tolerance) {
+                qh_compute_horizon(q, neighbour, twin, eye);
+            } else {
+                if (!grow_array((void**)&q->horizon, &q->horizon_capacity, q->horizon_count + 1, sizeof(uint32_t))) {
+                    q->out_of_memory = 1;
+                    return;
+                }
+                q->horizon[q->horizon_count++] = edge;
+            }
+        }
+        edge = edge_next(edge);
+    } while (edge != stop && !q->out_of_memory);
+}
+
+static void quickhull_free(Quickhull* q) {
+    free(q->points);
+    free(q->next_outside);
+    free(q->faces);
+    free(q->heads);
+    free(q->twins);
+    free(q->visible);
+    free(q->horizon);
+}
+
+// Run quickhull; returns an error message or NULL
+static const char* quickhull_run(Quickhull* q, uint32_t max_vertices) {
+    const HullPoint* p = q->points;
+    uint32_t count = q->point_count;
+
+    // Initial tetrahedron: widest axis extremes, then the farthest point
+    // from their line, then the farthest point from that plane
+    uint32_t min_index[3] = { 0, 0, 0 }, max_index[3] = { 0, 0, 0 };
+    for (uint32_t i = 1; i < count; i++) {
+        if (p[i].x < p[min_index[0]].x) min_index[0] = i;
+        if (p[i].y < p[min_index[1]].y) min_index[1] = i;
+        if (p[i].z < p[min_index[2]].z) min_index[2] = i;
+        if (p[i].x > p[max_index[0]].x) max_index[0] = i;
+        if (p[i].y > p[max_index[1]].y) max_index[1] = i;
+        if (p[i].z > p[max_index[2]].z) max_index[2] = i;
+    }
+    double spans[3] = { p[max_index[0]].x - p[min_index[0]].x, p[max_index[1]].y - p[min_index[1]].y,
+                        p[max_index[2]].z - p[min_index[2]].z };
+    int axis = spans[1] > spans[0] ? 1 : 0;
+    if (spans[2] > spans[axis]) axis = 2;
+    uint32_t a = min_index[axis], b = max_index[axis];
+    if (spans[axis] <= q->tolerance) {
+        return "Convex hull input is degenerate (coincident points)";
+    }
+
+    HullPoint ab = hp_sub(p[b], p[a]);
+    double best = 0.0;
+    uint32_t c = HULL_NONE;
+    for (uint32_t i = 0; i < count; i++) {
+        double distance = hp_length(hp_cross(hp_sub(p[i], p[a]), ab));
+        if (distance > best) {
+            best = distance;
+            c = i;
+        }
+    }
+    if (c == HULL_NONE || best / hp_length(ab) <= q->tolerance) {
+        return "Convex hull input is degenerate (collinear points)";
+    }
+
+    HullPoint normal = hp_cross(ab, hp_sub(p[c], p[a]));
+    normal = (HullPoint){ normal.x / hp_length(normal), normal.y / hp_length(normal), normal.z / hp_length(normal) };
+    best = 0.0;
+    uint32_t d = HULL_NONE;
+    for (uint32_t i = 0; i < count; i++) {
+        double distance = fabs(hp_dot(normal, hp_sub(p[i], p[a])));
+        if (distance > best) {
+            best = distance;
+            d = i;
+        }
+    }
+    if (d == HULL_NONE || best <= q->tolerance) {
+        return "Convex hull input is degenerate (coplanar points)";
+    }
+
+    // Base (a, b, c) faces away from d; each side face shares a base edge
+    // reversed
+    if (hp_dot(normal, hp_sub(p[d], p[a])) > 0.0) {
+        uint32_t swap = b;
+        b = c;
+        c = swap;
+    }
+    qh_add_face(q, a, b, c);
+    qh_add_face(q, b, a, d);
+    qh_add_face(q, c, b, d);
+    qh_add_face(q, a, c, d);
+    if (q->out_of_memory) {
+        return "Failed to allocate memory for convex hull";
+    }
+    for (uint32_t e = 0; e < 12; e++) {
+        for (uint32_t o = 0; o < 12; o++) {
+            if (edge_tail(q, e) == q->heads[o] && q->heads[e] == edge_tail(q, o)) {
+                q->twins[e] = o;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (i != a && i != b && i != c && i != d) {
+            qh_assign_point(q, 0, 4, i);
+        }
+    }
+
+    uint32_t vertex_count = 4;
+    while (vertex_count < max_vertices) {
+        // Farthest outside point over all faces, so a vertex limit keeps
+        // the most significant extreme points
+        uint32_t eye_face = HULL_NONE;
+        double eye_distance = 0.0;
+        for (uint32_t f = 0; f < q->face_count; f++) {
+            if (q->faces[f].alive && q->faces[f].outside != HULL_NONE && q->faces[f].far_distance > eye_distance) {
+                eye_distance = q->faces[f].far_distance;
+                eye_face = f;
+            }
+        }
+        if (eye_face == HULL_NONE) {
+            break;
+        }
+        uint32_t eye = q->faces[eye_face].far_point;
+        HullPoint eye_point = p[eye];
+
+        q->visible_count = 0;
+        q->horizon_count = 0;
+        qh_compute_horizon(q, eye_face, HULL_NONE, eye_point);
+        if (q->out_of_memory) {
+            return "Failed to allocate memory for convex hull";
+        }
+
+        // Fan of new faces from the horizon to the eye
+        uint32_t first_new = q->face_count;
+        for (uint32_t h = 0; h < q->horizon_count; h++) {
+            uint32_t edge = q->horizon[h];
+            uint32_t tail = edge_tail(q, edge), head = q->heads[edge];
+            uint32_t hidden_edge = q->twins[edge];
+            uint32_t f = qh_add_face(q, tail, head, eye);
+            if (f == HULL_NONE) {
+                return "Failed to allocate memory for convex hull";
+            }
+            q->twins[3 * f] = hidden_edge;
+            q->twins[hidden_edge] = 3 * f;
+        }
+        for (uint32_t h = 0; h < q->horizon_count; h++) {
+            uint32_t f = first_new + h;
+            uint32_t next = first_new + (h + 1) % q->horizon_count;
+            if (q->heads[3 * f] != edge_tail(q, 3 * next)) {
+                return "Convex hull construction failed (open horizon)";
+            }
+            q->twins[3 * f + 1] = 3 * next + 2;
+            q->twins[3 * next + 2] = 3 * f + 1;
+        }
+
+        // Orphaned points move to the new faces or fall inside
+        for (uint32_t v = 0; v < q->visible_count; v++) {
+            QhFace* face = &q->faces[q->visible[v]];
+            face->alive = 0;
+            uint32_t point = face->outside;
+            face->outside = HULL_NONE;
+            while (point != HULL_NONE) {
+                uint32_t next = q->next_outside[point];
+                if (point != eye) {
+                    qh_assign_point(q, first_new, q->face_count, point);
+                }
+                point = next;
+            }
+        }
+        vertex_count++;
+    }
+    return NULL;
+}
+
+// ============================================================================
+// HULL EXTRACTION
+// ============================================================================
+
+static uint32_t find_root(uint32_t* parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+// Scratch polygons: point indices per face plus the face plane
+typedef struct {
+    uint32_t* first;
+    uint32_t* indices;
+    HullPoint* normals;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t index_count;
+    uint32_t index_capacity;
+} PolygonList;
+
+static int polygon_add(PolygonList* list, const uint32_t* indices, uint32_t count, HullPoint normal) {
+    if (!grow_array((void**)&list->indices, &list->index_capacity, list->index_count + count, sizeof(uint32_t))) {
+        return 0;
+    }
+    if (list->count + 2 > list->capacity) {
+        uint32_t capacity = list->capacity;
+        if (!grow_array((void**)&list->first, &capacity, list->count + 2, sizeof(uint32_t))) return 0;
+        capacity = list->capacity;
+        if (!grow_array((void**)&list->normals, &capacity, list->count + 2, sizeof(HullPoint))) return 0;
+        list->capacity = capacity;
+    }
+    list->first[list->count] = list->index_count;
+    list->normals[list->count] = normal;
+    memcpy(list->indices + list->index_count, indices, count * sizeof(uint32_t));
+    list->index_count += count;
+    list->count++;
+    list->first[list->count] = list->index_count;
+    return 1;
+}
+
+// Drop polygon vertices lying on the segment between their neighbours
+static uint32_t remove_collinear(const Quickhull* q, uint32_t* loop, uint32_t count, uint32_t* kept) {
+    if (count <= 3) {
+        return count;
+    }
+    uint32_t kept_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        HullPoint prev = q->points[loop[(i + count - 1) % count]];
+        HullPoint next = q->points[loop[(i + 1) % count]];
+        HullPoint span = hp_sub(next, prev);
+        double length = hp_length(span);
+        double distance = length > 0.0 ? hp_length(hp_cross(hp_sub(q->points[loop[i]], prev), span)) / length : 0.0;
+        if (distance > q->tolerance) {
+            kept[kept_count++] = loop[i];
+        }
+    }
+    if (kept_count < 3) {
+        return count;
+    }
+    memcpy(loop, kept, kept_count * sizeof(uint32_t));
+    return kept_count;
+}
+
+// Merge coplanar triangles into polygons and pack the result
+static ConvexHull* quickhull_extract(Quickhull* q) {
+    uint32_t face_count = q->face_count;
+    uint32_t* parent = (uint32_t*)malloc(face_count * sizeof(uint32_t));
+    uint32_t* order = (uint32_t*)malloc(face_count * sizeof(uint32_t));
+    uint32_t* group_start = (uint32_t*)calloc(face_count + 1, sizeof(uint32_t));
+    uint32_t* out_edge = (uint32_t*)malloc(q->point_count * sizeof(uint32_t));
+    uint32_t* loop = (uint32_t*)malloc(6 * face_count * sizeof(uint32_t));    // Loop + scratch
+    uint32_t* remap = (uint32_t*)malloc(q->point_count * sizeof(uint32_t));
+    PolygonList polygons;
+    memset(&polygons, 0, sizeof(polygons));
+    ConvexHull* hull = NULL;
+    uint64_t* edge_keys = NULL;
+    int ok = parent && order && group_start && out_edge && loop && remap;
+    if (!ok) goto cleanup;
+
+    // Union faces whose shared edge is flat (or concave) within tolerance
+    for (uint32_t f = 0; f < face_count; f++) parent[f] = f;
+    for (uint32_t f = 0; f < face_count; f++) {
+        if (!q->faces[f].alive) continue;
+        for (uint32_t e = 3 * f; e < 3 * f + 3; e++) {
+            uint32_t twin = q->twins[e];
+            uint32_t g = twin / 3;
+            if (g < f) continue;
+            HullPoint opposite_f = q->points[q->heads[edge_next(e)]];
+            HullPoint opposite_g = q->points[q->heads[edge_next(twin)]];
+            if (face_distance(q, f, opposite_g) > -q->tolerance && face_distance(q, g, opposite_f) > -q->tolerance) {
+                uint32_t rf = find_root(parent, f), rg = find_root(parent, g);
+                if (rf != rg) parent[rg] = rf;
+            }
+        }
+    }
+
+    // Bucket alive faces by group root
+    for (uint32_t f = 0; f < face_count; f++) {
+        if (q->faces[f].alive) group_start[find_root(parent, f) + 1]++;
+    }
+    for (uint32_t g = 0; g < face_count; g++) group_start[g + 1] += group_start[g];
+    {
+        uint32_t* cursor = (uint32_t*)malloc(face_count * sizeof(uint32_t));
+        if (!cursor) {
+            ok = 0;
+            goto cleanup;
+        }
+        memcpy(cursor, group_start, face_count * sizeof(uint32_t));
+        for (uint32_t f = 0; f < face_count; f++) {
+            if (q->faces[f].alive) order[cursor[find_root(parent, f)]++] = f;
+        }
+        free(cursor);
+    }
+
+    for (uint32_t i = 0; i < q->point_count; i++) out_edge[i] = HULL_NONE;
+    for (uint32_t g = 0; ok && g < face_count; g++) {
+        uint32_t begin = group_start[g], end = group_start[g + 1];
+        if (begin == end) continue;
+
+        // Area-weighted normal and the boundary of the merged group
+        HullPoint normal = { 0.0, 0.0, 0.0 };
+        uint32_t boundary_count = 0, first_edge = HULL_NONE;
+        for (uint32_t i = begin; i < end; i++) {
+            uint32_t f = order[i];
+            HullPoint pa = q->points[q->heads[3 * f + 2]];
+            HullPoint area = hp_cross(hp_sub(q->points[q->heads[3 * f]], pa), hp_sub(q->points[q->heads[3 * f + 1]], pa));
+            normal.x += area.x;
+            normal.y += area.y;
+            normal.z += area.z;
+            for (uint32_t e = 3 * f; e < 3 * f + 3; e++) {
+                if (find_root(parent, q->twins[e] / 3) != g) {
+                    out_edge[edge_tail(q, e)] = e;
+                    boundary_count++;
+                    first_edge = e;
+                }
+            }
+        }
+        double length = hp_length(normal);
+        if (length > 0.0) {
+            normal.x /= length;
+            normal.y /= length;
+            normal.z /= length;
+        }
+
+        uint32_t loop_count = 0, edge = first_edge;
+        while (edge != HULL_NONE && loop_count < boundary_count) {
+            loop[loop_count++] = edge_tail(q, edge);
+            edge = out_edge[q->heads[edge]];
+            if (edge == first_edge) break;
+        }
+        int closed = edge == first_edge && loop_count == boundary_count;
+        for (uint32_t i = begin; i < end; i++) {
+            uint32_t f = order[i];
+            for (uint32_t e = 3 * f; e < 3 * f + 3; e++) out_edge[edge_tail(q, e)] = HULL_NONE;
+        }
+
+        if (closed) {
+            loop_count = remove_collinear(q, loop, loop_count, loop + 3 * face_count);
+            ok = polygon_add(&polygons, loop, loop_count, normal);
+        } else {
+            // A group that is not a disc keeps its triangles
+            for (uint32_t i = begin; ok && i < end; i++) {
+                uint32_t f = order[i];
+                uint32_t triangle[3] = { q->heads[3 * f + 2], q->heads[3 * f], q->heads[3 * f + 1] };
+                ok = polygon_add(&polygons, triangle, 3, q->faces[f].normal);
+            }
+        }
+    }
+    if (!ok) goto cleanup;
+
+    // Compact the vertices that survived and collect unique edges
+    uint32_t vertex_count = 0;
+    for (uint32_t i = 0; i < q->point_count; i++) remap[i] = HULL_NONE;
+    for (uint32_t i = 0; i < polygons.index_count; i++) {
+        if (remap[polygons.indices[i]] == HULL_NONE) remap[polygons.indices[i]] = vertex_count++;
+    }
+    edge_keys = (uint64_t*)malloc((polygons.index_count ? polygons.index_count : 1) * sizeof(uint64_t));
+    hull = (ConvexHull*)calloc(1, sizeof(ConvexHull));
+    if (!edge_keys || !hull) {
+        ok = 0;
+        goto cleanup;
+    }
+    for (uint32_t f = 0; f < polygons.count; f++) {
+        uint32_t first = polygons.first[f], count = polygons.first[f + 1] - first;
+        for (uint32_t i = 0; i < count; i++) {
+            uint64_t u = remap[polygons.indices[first + i]], v = remap[polygons.indices[first + (i + 1) % count]];
+            edge_keys[first + i] = u < v ? (u << 32) | v : (v << 32) | u;
+        }
+    }
+    qsort(edge_keys, polygons.index_count, sizeof(uint64_t), compare_u64);
+    uint32_t edge_count = 0;
+    for (uint32_t i = 0; i < polygons.index_count; i++) {
+        if (i == 0 || edge_keys[i] != edge_keys[i - 1]) edge_keys[edge_count++] = edge_keys[i];
+    }
+
+    hull->vertex_count = vertex_count;
+    hull->face_count = polygons.count;
+    hull->edge_count = edge_count;
+    hull->face_index_count = polygons.index_count;
+    hull->vertices = (vec3_t*)malloc(vertex_count * sizeof(vec3_t));
+    hull->planes = (vec4_t*)malloc(polygons.count * sizeof(vec4_t));
+    hull->face_first = (uint32_t*)malloc((polygons.count + 1) * sizeof(uint32_t));
+    hull->face_indices = (uint32_t*)malloc(polygons.index_count * sizeof(uint32_t));
+    hull->edges = (uint32_t*)malloc(2 * edge_count * sizeof(uint32_t));
+    if (!hull->vertices || !hull->planes || !hull->face_first || !hull->face_indices || !hull->edges) {
+        ok = 0;
+        goto cleanup;
+    }
+
+    HullPoint reference = { 0.0, 0.0, 0.0 };
+    for (uint32_t i = 0; i < q->point_count; i++) {
+        if (remap[i] == HULL_NONE) continue;
+        const HullPoint* point = &q->points[i];
+        hull->vertices[remap[i]] = vec3((float)point->x, (float)point->y, (float)point->z);
+        reference.x += point->x / vertex_count;
+        reference.y += point->y / vertex_count;
+        reference.z += point->z / vertex_count;
+    }
+    hull->bounds_min = hull->bounds_max = hull->vertices[0];
+    for (uint32_t i = 1; i < vertex_count; i++) {
+        vec3_t v = hull->vertices[i];
+        hull->bounds_min = vec3(fminf(hull->bounds_min.x, v.x), fminf(hull->bounds_min.y, v.y), fminf(hull->bounds_min.z, v.z));
+        hull->bounds_max = vec3(fmaxf(hull->bounds_max.x, v.x), fmaxf(hull->bounds_max.y, v.y), fmaxf(hull->bounds_max.z, v.z));
+    }
+
+    // Planes enclose every face vertex; mass properties from a tetrahedron
+    // fan around the vertex average
+    double volume6 = 0.0;
+    HullPoint moment = { 0.0, 0.0, 0.0 };
+    for (uint32_t f = 0; f < polygons.count; f++) {
+        uint32_t first = polygons.first[f], count = polygons.first[f + 1] - first;
+        HullPoint n = polygons.normals[f];
+        double offset = -DBL_MAX;
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t index = polygons.indices[first + i];
+            double distance = hp_dot(n, q->points[index]);
+            if (distance > offset) offset = distance;
+            hull->face_indices[first + i] = remap[index];
+        }
+        hull->face_first[f] = first;
+        hull->planes[f] = vec4((float)n.x, (float)n.y, (float)n.z, (float)offset);
+
+        HullPoint p0 = hp_sub(q->points[polygons.indices[first]], reference);
+        for (uint32_t i = 1; i + 1 < count; i++) {
+            HullPoint p1 = hp_sub(q->points[polygons.indices[first + i]], reference);
+            HullPoint p2 = hp_sub(q->points[polygons.indices[first + i + 1]], reference);
+            double tet6 = hp_dot(p0, hp_cross(p1, p2));
+            volume6 += tet6;
+            moment.x += tet6 * (p0.x + p1.x + p2.x) / 4.0;
+            moment.y += tet6 * (p0.y + p1.y + p2.y) / 4.0;
+            moment.z += tet6 * (p0.z + p1.z + p2.z) / 4.0;
+        }
+    }
+    hull->face_first[polygons.count] = polygons.index_count;
+    for (uint32_t i = 0; i < edge_count; i++) {
+        hull->edges[2 * i] = (uint32_t)(edge_keys[i] >> 32);
+        hull->edges[2 * i + 1] = (uint32_t)(edge_keys[i] & 0xFFFFFFFFu);
+    }
+    hull->volume = (float)(volume6 / 6.0);
+    hull->centroid = volume6 > 0.0 ?
+        vec3((float)(reference.x + moment.x / volume6), (float)(reference.y + moment.y / volume6),
+             (float)(reference.z + moment.z / volume6)) :
+        vec3((float)reference.x, (float)reference.y, (float)reference.z);
+
+cleanup:
+    if (!ok) {
+        convex_hull_destroy(hull);
+        hull = NULL;
+    }
+    free(parent);
+    free(order);
+    free(group_start);
+    free(out_edge);
+    free(loop);
+    free(remap);
+    free(edge_keys);
+    free(polygons.first);
+    free(polygons.indices);
+    free(polygons.normals);
+    return hull;
+}
+
+// Build without logging; decomposition probes many (often flat) parts
+static ConvexHull* hull_build(const vec3_t* points, uint32_t point_count, const ConvexHullDesc* desc,
+                              const char** out_error) {
+    *out_error = NULL;
+    if (point_count < 4) {
+        *out_error = "Convex hull needs at least 4 points";
+        return NULL;
+    }
+
+    Quickhull q;
+    memset(&q, 0, sizeof(q));
+    q.point_count = point_count;
+    q.points = (HullPoint*)malloc(point_count * sizeof(HullPoint));
+    q.next_outside = (uint32_t*)malloc(point_count * sizeof(uint32_t));
+    if (!q.points || !q.next_outside) {
+        quickhull_free(&q);
+        *out_error = "Failed to allocate memory for convex hull";
+        return NULL;
+    }
+
+    double max_x = 0.0, max_y = 0.0, max_z = 0.0;
+    for (uint32_t i = 0; i < point_count; i++) {
+        q.points[i] = (HullPoint){ points[i].x, points[i].y, points[i].z };
+        max_x = fmax(max_x, fabs(points[i].x));
+        max_y = fmax(max_y, fabs(points[i].y));
+        max_z = fmax(max_z, fabs(points[i].z));
+    }
+    // Float input (often rotated or offset) is a few ulps off its true planes
+    q.tolerance = desc->tolerance > 0.0f ? desc->tolerance : 10.0 * FLT_EPSILON * (max_x + max_y + max_z);
+
+    uint32_t max_vertices = desc->max_vertices < 4 ? 4 : desc->max_vertices;
+    *out_error = quickhull_run(&q, max_vertices);
+    ConvexHull* hull = NULL;
+    if (!*out_error) {
+        hull = quickhull_extract(&q);
+        if (!hull) *out_error = "Failed to allocate memory for convex hull";
+    }
+    quickhull_free(&q);
+    return hull;
+}
+
+// ============================================================================
+// CONVEX HULL FUNCTIONS
+// ============================================================================
+
+ConvexHullDesc convex_hull_desc_default(void) {
+    ConvexHullDesc desc;
+    desc.max_vertices = HULL_DEFAULT_MAX_VERTICES;
+    desc.tolerance = 0.0f;
+    return desc;
+}
+
+ConvexHull* convex_hull_build(const vec3_t* points, uint32_t point_count, const ConvexHullDesc* desc) {
+    if (!points) {
+        fprintf(stderr, "Error: Invalid convex hull parameters\n");
+        return NULL;
+    }
+    ConvexHullDesc defaults = convex_hull_desc_default();
+    const char* error = NULL;
+    ConvexHull* hull = hull_build(points, point_count, desc ? desc : &defaults, &error);
+    if (!hull) {
+        fprintf(stderr, "Error: %s\n", error);
+    }
+    return hull;
+}
+
+ConvexHull* convex_hull_from_mesh(const Mesh* mesh, const ConvexHullDesc* desc) {
+    if (!mesh || !mesh->vertices) {
+        fprintf(stderr, "Error: Invalid convex hull parameters\n");
+        return NULL;
+    }
+    vec3_t* points = (vec3_t*)malloc((mesh->vertex_count ? mesh->vertex_count : 1) * sizeof(vec3_t));
+    if (!points) {
+        fprintf(stderr, "Error: Failed to allocate memory for convex hull\n");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < mesh->vertex_count; i++) {
+        points[i] = mesh->vertices[i].position;
+    }
+    ConvexHull* hull = convex_hull_build(points, mesh->vertex_count, desc);
+    free(points);
+    return hull;
+}
+
+void convex_hull_destroy(ConvexHull* hull) {
+    if (!hull) {
+        return;
+    }
+    free(hull->vertices);
+    free(hull->planes);
+    free(hull->face_first);
+    free(hull->face_indices);
+    free(hull->edges);
+    free(hull);
+}
+
+vec3_t convex_hull_support(const ConvexHull* hull, vec3_t direction) {
+    uint32_t best_index = 0;
+    float best = -FLT_MAX;
+    for (uint32_t i = 0; i < hull->vertex_count; i++) {
+        float distance = vec3_dot(hull->vertices[i], direction);
+        if (distance > best) {
+            best = distance;
+            best_index = i;
+        }
+    }
+    return hull->vertices[best_index];
+}
+
+float convex_hull_distance(const ConvexHull* hull, vec3_t point) {
+    float distance = -FLT_MAX;
+    for (uint32_t f = 0; f < hull->face_count; f++) {
+        vec4_t plane = hull->planes[f];
+        float d = plane.x * point.x + plane.y * point.y + plane.z * point.z - plane.w;
+        if (d > distance) distance = d;
+    }
+    return distance;
+}
+
+// ============================================================================
+// CONVEX DECOMPOSITION
+// ============================================================================
+
+// A part is a triangle soup: three points per triangle
+typedef struct {
+    vec3_t* points;
+    uint32_t triangle_count;
+    uint32_t capacity;          // In triangles
+    uint32_t depth;
+} HullPart;
+
+static float axis_value(vec3_t v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static int part_add_triangle(HullPart* part, vec3_t a, vec3_t b, vec3_t c) {
+    if (part->triangle_count == part->capacity) {
+        uint32_t capacity = part->capacity ? part->capacity * 2 : 64;
+        vec3_t* points = (vec3_t*)realloc(part->points, (size_t)capacity * 3 * sizeof(vec3_t));
+        if (!points) {
+            return 0;
+        }
+        part->points = points;
+        part->capacity = capacity;
+    }
+    vec3_t* dst = &part->points[3 * part->triangle_count++];
+    dst[0] = a;
+    dst[1] = b;
+    dst[2] = c;
+    return 1;
+}
+
+// Keep the side of the plane where sign * (coordinate - position) >= 0
+static int clip_triangle(HullPart* part, const vec3_t* triangle, int axis, float position, float sign) {
+    vec3_t polygon[4];
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+        vec3_t a = triangle[i], b = triangle[(i + 1) % 3];
+        float da = sign * (axis_value(a, axis) - position);
+        float db = sign * (axis_value(b, axis) - position);
+        if (da >= 0.0f) polygon[count++] = a;
+        if ((da > 0.0f && db < 0.0f) || (da < 0.0f && db > 0.0f)) {
+            polygon[count++] = vec3_add(a, vec3_scale(vec3_sub(b, a), da / (da - db)));
+        }
+    }
+    for (uint32_t i = 1; i + 1 < count; i++) {
+        if (!part_add_triangle(part, polygon[0], polygon[i], polygon[i + 1])) return 0;
+    }
+    return 1;
+}
+
+// Deepest mesh point (vertex or triangle centre) inside the part's hull
+static float part_concavity(const HullPart* part, const ConvexHull* hull) {
+    float worst = 0.0f;
+    for (uint32_t t = 0; t < part->triangle_count; t++) {
+        const vec3_t* triangle = &part->points[3 * t];
+        vec3_t samples[4] = { triangle[0], triangle[1], triangle[2],
+                              vec3_scale(vec3_add(vec3_add(triangle[0], triangle[1]), triangle[2]), 1.0f / 3.0f) };
+        for (uint32_t s = 0; s < 4; s++) {
+            float depth = -convex_hull_distance(hull, samples[s]);
+            if (depth > worst) worst = depth;
+        }
+    }
+    return worst;
+}
+
+static void part_free(HullPart* part) {
+    free(part->points);
+    part->points = NULL;
+    part->triangle_count = part->capacity = 0;
+}
+
+ConvexDecompositionDesc convex_decomposition_desc_default(void) {
+    ConvexDecompositionDesc desc;
+    desc.hull = convex_hull_desc_default();
+    desc.max_hulls = HULL_DEFAULT_MAX_HULLS;
+    desc.max_depth = HULL_DEFAULT_MAX_DEPTH;
+    desc.concavity = HULL_DEFAULT_CONCAVITY;
+    desc.split_candidates = HULL_DEFAULT_SPLIT_CANDIDATES;
+    return desc;
+}
+
+ConvexDecomposition* convex_decompose_mesh(const Mesh* mesh, const ConvexDecompositionDesc* desc) {
+    if (!mesh || !mesh->vertices || !mesh->indices || mesh->index_count < 3) {
+        fprintf(stderr, "Error: Invalid convex decomposition parameters\n");
+        return NULL;
+    }
+    ConvexDecompositionDesc defaults = convex_decomposition_desc_default();
+    if (!desc) desc = &defaults;
+    uint32_t max_hulls = desc->max_hulls ? desc->max_hulls : 1;
+
+    ConvexDecomposition* result = (ConvexDecomposition*)calloc(1, sizeof(ConvexDecomposition));
+    HullPart* stack = (HullPart*)calloc(max_hulls + 1, sizeof(HullPart));
+    if (result) result->hulls = (ConvexHull**)calloc(max_hulls, sizeof(ConvexHull*));
+    if (!result || !stack || !result->hulls) {
+        fprintf(stderr, "Error: Failed to allocate memory for convex decomposition\n");
+        if (result) free(result->hulls);
+        free(result);
+        free(stack);
+        return NULL;
+    }
+
+    vec3_t bounds_min, bounds_max;
+    mesh_calculate_bounds((Mesh*)mesh, &bounds_min, &bounds_max);
+    float threshold = desc->concavity * vec3_distance(bounds_min, bounds_max);
+
+    uint32_t stack_count = 1;
+    int ok = 1;
+    for (uint32_t t = 0; ok && t + 2 < mesh->index_count; t += 3) {
+        uint32_t i0 = mesh->indices[t], i1 = mesh->indices[t + 1], i2 = mesh->indices[t + 2];
+        if (i0 >= mesh->vertex_count || i1 >= mesh->vertex_count || i2 >= mesh->vertex_count) continue;
+        ok = part_add_triangle(&stack[0], mesh->vertices[i0].position, mesh->vertices[i1].position,
+                               mesh->vertices[i2].position);
+    }
+
+    const char* error = NULL;
+    while (ok && stack_count > 0) {
+        HullPart part = stack[--stack_count];
+        ConvexHull* hull = hull_build(part.points, 3 * part.triangle_count, &desc->hull, &error);
+        if (!hull) {
+            // Flat or empty pieces have no volume to collide with
+            part_free(&part);
+            continue;
+        }
+
+        int split = part.depth < desc->max_depth && result->hull_count + stack_count + 2 <= max_hulls &&
+                    part_concavity(&part, hull) > threshold;
+        HullPart best_left = { NULL, 0, 0, 0 }, best_right = { NULL, 0, 0, 0 };
+        float best_score = FLT_MAX, best_volume = FLT_MAX;
+        for (int axis = 0; split && ok && axis < 3; axis++) {
+            float low = axis_value(hull->bounds_min, axis), high = axis_value(hull->bounds_max, axis);
+            for (uint32_t k = 1; ok && k <= desc->split_candidates; k++) {
+                float position = low + (high - low) * (float)k / (float)(desc->split_candidates + 1);
+                HullPart left = { NULL, 0, 0, part.depth + 1 }, right = { NULL, 0, 0, part.depth + 1 };
+                for (uint32_t t = 0; ok && t < part.triangle_count; t++) {
+                    ok = clip_triangle(&left, &part.points[3 * t], axis, position, -1.0f) &&
+                         clip_triangle(&right, &part.points[3 * t], axis, position, 1.0f);
+                }
+                ConvexHull* left_hull = ok ? hull_build(left.points, 3 * left.triangle_count, &desc->hull, &error) : NULL;
+                ConvexHull* right_hull = ok ? hull_build(right.points, 3 * right.triangle_count, &desc->hull, &error) : NULL;
+                if (left_hull && right_hull) {
+                    float score = part_concavity(&left, left_hull) + part_concavity(&right, right_hull);
+                    float volume = left_hull->volume + right_hull->volume;
+                    float epsilon = 1.0e-4f * hull->volume;
+                    if (volume < best_volume - epsilon || (volume <= best_volume + epsilon && score < best_score)) {
+                        part_free(&best_left);
+                        part_free(&best_right);
+                        best_left = left;
+                        best_right = right;
+                        best_score = score;
+                        best_volume = volume;
+                        left.points = right.points = NULL;
+                    }
+                }
+                convex_hull_destroy(left_hull);
+                convex_hull_destroy(right_hull);
+                part_free(&left);
+                part_free(&right);
+            }
+        }
+
+        if (ok && best_left.points) {
+            convex_hull_destroy(hull);
+            stack[stack_count++] = best_left;
+            stack[stack_count++] = best_right;
+        } else {
+            result->hulls[result->hull_count++] = hull;
+            part_free(&best_left);
+            part_free(&best_right);
+        }
+        part_free(&part);
+    }
+
+    for (uint32_t i = 0; i < stack_count; i++) part_free(&stack[i]);
+    free(stack);
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for convex decomposition\n");
+        convex_decomposition_destroy(result);
+        return NULL;
+    }
+
+    fprintf(stderr, "Decomposed %u triangles into %u convex hulls\n", mesh->index_count / 3, result->hull_count);
+    return result;
+}
+
+void convex_decomposition_destroy(ConvexDecomposition* decomposition) {
+    if (!decomposition) {
+        return;
+    }
+    for (uint32_t i = 0; i < decomposition->hull_count; i++) {
+        convex_hull_destroy(decomposition->hulls[i]);
+    }
+    free(decomposition->hulls);
+    free(decomposition);
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void convex_hull_print(const char* name, const ConvexHull* hull) {
+    if (!hull) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s: %u vertices, %u faces, %u edges, volume %.4f\n", name,
+           hull->vertex_count, hull->face_count, hull->edge_count, hull->volume);
+    printf("  Bounds: (%.3f, %.3f, %.3f) - (%.3f, %.3f, %.3f)\n",
+           hull->bounds_min.x, hull->bounds_min.y, hull->bounds_min.z,
+           hull->bounds_max.x, hull->bounds_max.y, hull->bounds_max.z);
+    printf("  Centroid: (%.3f, %.3f, %.3f)\n", hull->centroid.x, hull->centroid.y, hull->centroid.z);
+}
@@ -0,0 +1,115 @@
+#ifndef ENGINE_HULL_H
+#define ENGINE_HULL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_model.h"
+#include <stdint.h>
+
+// ============================================================================
+// CONVEX HULL CONFIGURATION
+// ============================================================================
+
+#define HULL_DEFAULT_MAX_VERTICES 64
+#define HULL_DEFAULT_MAX_HULLS 16
+#define HULL_DEFAULT_MAX_DEPTH 6
+#define HULL_DEFAULT_CONCAVITY 0.02f            // Fraction of the mesh diagonal
+#define HULL_DEFAULT_SPLIT_CANDIDATES 5         // Cutting planes tried per axis
+
+// ============================================================================
+// CONVEX HULL TYPES
+// ============================================================================
+
+// Compact convex polyhedron for collision (GJK support queries, SAT over
+// face normals and edge pairs). Coplanar triangles are merged into
+// polygon faces, so a box has 6 faces, 8 vertices and 12 edges.
+typedef struct {
+    vec3_t* vertices;
+    vec4_t* planes;             // Outward unit normal (xyz) and offset (w): dot(n, p) <= w inside
+    uint32_t* face_first;       // Face f is face_indices[face_first[f] .. face_first[f + 1])
+    uint32_t* face_indices;     // Vertex indices, counter-clockwise around the normal
+    uint32_t* edges;            // Unique edges as vertex index pairs
+    uint32_t vertex_count;
+    uint32_t face_count;
+    uint32_t edge_count;
+    uint32_t face_index_count;
+    vec3_t bounds_min;
+    vec3_t bounds_max;
+    vec3_t centroid;            // Centre of mass (uniform density)
+    float volume;
+} ConvexHull;
+
+typedef struct {
+    uint32_t max_vertices;      // Extreme points kept, farthest first (>= 4)
+    float tolerance;            // Coplanarity distance; 0 derives it from the input extent
+} ConvexHullDesc;
+
+typedef struct {
+    ConvexHullDesc hull;        // Applied to every part
+    uint32_t max_hulls;
+    uint32_t max_depth;         // Recursive splits per part
+    float concavity;            // Accepted depth of mesh points inside a part's hull, as a fraction of the mesh diagonal
+    uint32_t split_candidates;  // Axis-aligned cutting planes tried per axis
+} ConvexDecompositionDesc;
+
+typedef struct {
+    ConvexHull** hulls;
+    uint32_t hull_count;
+} ConvexDecomposition;
+
+// ============================================================================
+// CONVEX HULL FUNCTIONS
+// ============================================================================
+
+// Default: 64 vertices, automatic tolerance
+ConvexHullDesc convex_hull_desc_default(void);
+
+// Quickhull over a point cloud. Points within the tolerance of a face are
+// treated as coplanar and never become vertices. When max_vertices is
+// reached the hull of the points found so far is returned, which may leave
+// some input points outside. Returns NULL for flat or degenerate input.
+ConvexHull* convex_hull_build(const vec3_t* points, uint32_t point_count, const ConvexHullDesc* desc);
+
+// Hull of a mesh's vertex positions
+ConvexHull* convex_hull_from_mesh(const Mesh* mesh, const ConvexHullDesc* desc);
+
+// Free a hull
+void convex_hull_destroy(ConvexHull* hull);
+
+// Vertex farthest along a direction (GJK support mapping)
+vec3_t convex_hull_support(const ConvexHull* hull, vec3_t direction);
+
+// Largest plane distance: negative inside, zero on the boundary, and a
+// lower bound of the true distance outside
+float convex_hull_distance(const ConvexHull* hull, vec3_t point);
+
+// ============================================================================
+// CONVEX DECOMPOSITION FUNCTIONS
+// ============================================================================
+
+// Default: 16 hulls, 6 levels, 2% concavity, 5 candidates per axis
+ConvexDecompositionDesc convex_decomposition_desc_default(void);
+
+// Approximate convex decomposition: a part whose mesh points lie deeper
+// inside its hull than the concavity limit is cut by the axis-aligned
+// plane that minimises the hull volume of the two halves, recursively
+ConvexDecomposition* convex_decompose_mesh(const Mesh* mesh, const ConvexDecompositionDesc* desc);
+
+// Free a decomposition and its hulls
+void convex_decomposition_destroy(ConvexDecomposition* decomposition);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print hull counts, bounds and volume
+void convex_hull_print(const char* name, const ConvexHull* hull);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_HULL_H
@@ -0,0 +1,557 @@
+#include "engine_hull.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* assets_dir = "assets";
+
+static uint32_t rng_state = 12345u;
+
+static float random_float(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float)(rng_state >> 8) / 16777216.0f;
+}
+
+static vec3_t random_unit_vector(void) {
+    for (;;) {
+        vec3_t v = vec3(random_float() * 2.0f - 1.0f, random_float() * 2.0f - 1.0f, random_float() * 2.0f - 1.0f);
+        float length = vec3_length(v);
+        if (length > 0.1f && length <= 1.0f) return vec3_scale(v, 1.0f / length);
+    }
+}
+
+// ============================================================================
+// GENERATED PRIMITIVES
+// ============================================================================
+
+// Axis-aligned box with every face split into an n x n grid of quads
+static Mesh* make_box_mesh(vec3_t lo, vec3_t hi, uint32_t n) {
+    Mesh* mesh = mesh_allocate(6 * (n + 1) * (n + 1), 6 * n * n * 6);
+    if (!mesh) return NULL;
+    uint32_t v = 0, idx = 0;
+    for (uint32_t face = 0; face < 6; face++) {
+        int axis = face / 2, side = face % 2;
+        int u_axis = (axis + 1) % 3, w_axis = (axis + 2) % 3;
+        uint32_t base = v;
+        for (uint32_t j = 0; j <= n; j++) {
+            for (uint32_t i = 0; i <= n; i++) {
+                float c[3];
+                float lo_c[3] = { lo.x, lo.y, lo.z }, hi_c[3] = { hi.x, hi.y, hi.z };
+                c[axis] = side ? hi_c[axis] : lo_c[axis];
+                c[u_axis] = lo_c[u_axis] + (hi_c[u_axis] - lo_c[u_axis]) * (float)i / (float)n;
+                c[w_axis] = lo_c[w_axis] + (hi_c[w_axis] - lo_c[w_axis]) * (float)j / (float)n;
+                mesh->vertices[v++] = vertex_create_components(c[0], c[1], c[2], 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+            }
+        }
+        for (uint32_t j = 0; j < n; j++) {
+            for (uint32_t i = 0; i < n; i++) {
+                uint32_t a = base + j * (n + 1) + i, b = a + 1, c = a + n + 1, d = c + 1;
+                // Outward winding: u x w points along +axis
+                uint32_t quad[6] = { a, b, d, a, d, c };
+                if (!side) {
+                    quad[1] = d;
+                    quad[2] = b;
+                    quad[4] = c;
+                    quad[5] = d;
+                }
+                for (uint32_t k = 0; k < 6; k++) mesh->indices[idx++] = quad[k];
+            }
+        }
+    }
+    return mesh;
+}
+
+static Mesh* make_sphere_mesh(float radius, uint32_t rings, uint32_t segments) {
+    Mesh* mesh = mesh_allocate((rings + 1) * (segments + 1), rings * segments * 6);
+    if (!mesh) return NULL;
+    uint32_t v = 0, idx = 0;
+    for (uint32_t r = 0; r <= rings; r++) {
+        float phi = 3.14159265f * (float)r / (float)rings;
+        for (uint32_t s = 0; s <= segments; s++) {
+            float theta = 6.2831853f * (float)s / (float)segments;
+            mesh->vertices[v++] = vertex_create_components(radius * sinf(phi) * cosf(theta), radius * cosf(phi),
+                                                           radius * sinf(phi) * sinf(theta), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s, b = a + 1, c = a + segments + 1, d = c + 1;
+            uint32_t quad[6] = { a, b, d, a, d, c };
+            for (uint32_t k = 0; k < 6; k++) mesh->indices[idx++] = quad[k];
+        }
+    }
+    return mesh;
+}
+
+static Mesh* make_torus_mesh(float major, float minor, uint32_t rings, uint32_t sides) {
+    Mesh* mesh = mesh_allocate(rings * sides, rings * sides * 6);
+    if (!mesh) return NULL;
+    for (uint32_t r = 0; r < rings; r++) {
+        float theta = 6.2831853f * (float)r / (float)rings;
+        for (uint32_t s = 0; s < sides; s++) {
+            float phi = 6.2831853f * (float)s / (float)sides;
+            float radial = major + minor * cosf(phi);
+            mesh->vertices[r * sides + s] = vertex_create_components(radial * cosf(theta), minor * sinf(phi),
+                                                                     radial * sinf(theta), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    uint32_t idx = 0;
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < sides; s++) {
+            uint32_t a = r * sides + s, b = r * sides + (s + 1) % sides;
+            uint32_t c = ((r + 1) % rings) * sides + s, d = ((r + 1) % rings) * sides + (s + 1) % sides;
+            uint32_t quad[6] = { a, b, d, a, d, c };
+            for (uint32_t k = 0; k < 6; k++) mesh->indices[idx++] = quad[k];
+        }
+    }
+    return mesh;
+}
+
+// Concatenate two meshes (the L-shape is two boxes)
+static Mesh* merge_meshes(const Mesh* a, const Mesh* b) {
+    Mesh* mesh = mesh_allocate(a->vertex_count + b->vertex_count, a->index_count + b->index_count);
+    if (!mesh) return NULL;
+    memcpy(mesh->vertices, a->vertices, a->vertex_count * sizeof(Vertex));
+    memcpy(mesh->vertices + a->vertex_count, b->vertices, b->vertex_count * sizeof(Vertex));
+    memcpy(mesh->indices, a->indices, a->index_count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < b->index_count; i++) {
+        mesh->indices[a->index_count + i] = b->indices[i] + a->vertex_count;
+    }
+    return mesh;
+}
+
+// mesh_free releases the arrays; generated meshes also own the struct
+static void release_mesh(Mesh* mesh) {
+    mesh_free(mesh);
+    free(mesh);
+}
+
+static vec3_t* mesh_positions(const Mesh* mesh) {
+    vec3_t* points = (vec3_t*)malloc(mesh->vertex_count * sizeof(vec3_t));
+    for (uint32_t i = 0; points && i < mesh->vertex_count; i++) points[i] = mesh->vertices[i].position;
+    return points;
+}
+
+// Largest distance of any point outside the hull (0 when all inside)
+static float max_outside(const ConvexHull* hull, const vec3_t* points, uint32_t count) {
+    float worst = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        float d = convex_hull_distance(hull, points[i]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+// Faces wind counter-clockwise around their plane normal and every
+// vertex lies on or behind every plane
+static int hull_is_consistent(const ConvexHull* hull, float tolerance) {
+    for (uint32_t f = 0; f < hull->face_count; f++) {
+        uint32_t first = hull->face_first[f], count = hull->face_first[f + 1] - first;
+        if (count < 3) return 0;
+        vec3_t newell = vec3_zero();
+        for (uint32_t i = 0; i < count; i++) {
+            vec3_t a = hull->vertices[hull->face_indices[first + i]];
+            vec3_t b = hull->vertices[hull->face_indices[first + (i + 1) % count]];
+            newell = vec3_add(newell, vec3_cross(a, b));
+        }
+        vec4_t plane = hull->planes[f];
+        if (vec3_dot(newell, vec3(plane.x, plane.y, plane.z)) <= 0.0f) return 0;
+    }
+    return max_outside(hull, hull->vertices, hull->vertex_count) <= tolerance;
+}
+
+static float total_volume(const ConvexDecomposition* decomposition) {
+    float volume = 0.0f;
+    for (uint32_t i = 0; i < decomposition->hull_count; i++) volume += decomposition->hulls[i]->volume;
+    return volume;
+}
+
+// Largest distance of a mesh vertex outside every hull of a decomposition
+static float decomposition_coverage(const ConvexDecomposition* decomposition, const Mesh* mesh) {
+    float worst = 0.0f;
+    for (uint32_t v = 0; v < mesh->vertex_count; v++) {
+        float best = 1.0e30f;
+        for (uint32_t h = 0; h < decomposition->hull_count; h++) {
+            float d = convex_hull_distance(decomposition->hulls[h], mesh->vertices[v].position);
+            if (d < best) best = d;
+        }
+        if (best > worst) worst = best;
+    }
+    return worst;
+}
+
+// ============================================================================
+// CONVEX HULL TESTS
+// ============================================================================
+
+static void test_box_hulls(void) {
+    printf("\n--- Box Hull Tests ---\n");
+
+    Mesh* box = make_box_mesh(vec3(-0.5f, -0.5f, -0.5f), vec3(0.5f, 0.5f, 0.5f), 8);
+    ConvexHull* hull = convex_hull_from_mesh(box, NULL);
+    TEST_ASSERT_NOT_NULL(hull, "Box hull should build");
+    if (hull) {
+        TEST_ASSERT(hull->vertex_count == 8 && hull->face_count == 6 && hull->edge_count == 12,
+                    "Coplanar grid points should collapse to 8 vertices, 6 faces, 12 edges");
+        int quads = 1, axis_aligned = 1;
+        for (uint32_t f = 0; f < hull->face_count; f++) {
+            quads &= hull->face_first[f + 1] - hull->face_first[f] == 4;
+            vec4_t p = hull->planes[f];
+            axis_aligned &= fabsf(fabsf(p.x) + fabsf(p.y) + fabsf(p.z) - 1.0f) < 1.0e-5f && fabsf(p.w - 0.5f) < 1.0e-5f;
+        }
+        TEST_ASSERT(quads, "Box faces should be merged into quads");
+        TEST_ASSERT(axis_aligned, "Box planes should be the unit face planes");
+        TEST_ASSERT(fabsf(hull->volume - 1.0f) < 1.0e-5f && vec3_length(hull->centroid) < 1.0e-5f,
+                    "Box volume and centroid should be exact");
+        TEST_ASSERT(hull_is_consistent(hull, 1.0e-5f), "Box faces should wind outward");
+        convex_hull_print("Box hull", hull);
+    }
+    convex_hull_destroy(hull);
+
+    // The same box rotated: coplanarity now depends on the tolerance
+    quat_t rotation = quat_normalize(quat(0.3f, 0.5f, -0.2f, 0.8f));
+    vec3_t* points = mesh_positions(box);
+    for (uint32_t i = 0; i < box->vertex_count; i++) points[i] = quat_rotate_vec3(rotation, vec3_add(points[i], vec3(100.0f, 0.0f, 0.0f)));
+    hull = convex_hull_build(points, box->vertex_count, NULL);
+    TEST_ASSERT(hull && hull->vertex_count == 8 && hull->face_count == 6 && hull->edge_count == 12,
+                "A rotated, offset box should still merge its coplanar faces");
+    TEST_ASSERT(hull && max_outside(hull, points, box->vertex_count) < 1.0e-4f, "Rotated box should enclose its points");
+    convex_hull_destroy(hull);
+    free(points);
+    release_mesh(box);
+
+    // Many copies of a tetrahedron's corners
+    vec3_t corners[4] = { vec3(0.0f, 0.0f, 0.0f), vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), vec3(0.0f, 0.0f, 1.0f) };
+    vec3_t repeated[400];
+    for (uint32_t i = 0; i < 400; i++) repeated[i] = corners[(i * 7) % 4];
+    hull = convex_hull_build(repeated, 400, NULL);
+    TEST_ASSERT(hull && hull->vertex_count == 4 && hull->face_count == 4 && hull->edge_count == 6 &&
+                fabsf(hull->volume - 1.0f / 6.0f) < 1.0e-6f, "Duplicated points should give a clean tetrahedron");
+    convex_hull_destroy(hull);
+}
+
+static void test_sphere_hulls(void) {
+    printf("\n--- Point Cloud Hull Tests ---\n");
+
+    const uint32_t count = 2000;
+    vec3_t* points = (vec3_t*)malloc(count * sizeof(vec3_t));
+    for (uint32_t i = 0; i < count; i++) {
+        points[i] = vec3_scale(random_unit_vector(), (i % 3 == 0) ? 0.5f + 0.5f * random_float() : 1.0f);
+    }
+
+    ConvexHullDesc desc = convex_hull_desc_default();
+    desc.max_vertices = 4096;
+    ConvexHull* hull = convex_hull_build(points, count, &desc);
+    TEST_ASSERT_NOT_NULL(hull, "Sphere cloud hull should build");
+    if (hull) {
+        TEST_ASSERT(max_outside(hull, points, count) < 1.0e-5f, "Full hull should enclose every point");
+        TEST_ASSERT((int)hull->vertex_count - (int)hull->edge_count + (int)hull->face_count == 2,
+                    "Hull should satisfy Euler's formula");
+        TEST_ASSERT(hull_is_consistent(hull, 1.0e-5f), "Hull faces should wind outward with all vertices behind them");
+        float sphere = 4.0f / 3.0f * 3.14159265f;
+        TEST_ASSERT(hull->volume < sphere && hull->volume > 0.9f * sphere, "Hull volume should approach the sphere");
+
+        int support_ok = 1;
+        for (uint32_t i = 0; i < 64; i++) {
+            vec3_t dir = random_unit_vector();
+            float best = -1.0e30f;
+            for (uint32_t p = 0; p < count; p++) best = fmaxf(best, vec3_dot(points[p], dir));
+            support_ok &= fabsf(vec3_dot(convex_hull_support(hull, dir), dir) - best) < 1.0e-5f;
+        }
+        TEST_ASSERT(support_ok, "Support points should match a brute-force search");
+        TEST_ASSERT(convex_hull_distance(hull, vec3_zero()) < -0.9f && convex_hull_distance(hull, vec3(2.0f, 0.0f, 0.0f)) > 0.9f,
+                    "Plane distance should be negative inside and positive outside");
+    }
+    float full_volume = hull ? hull->volume : 0.0f;
+    convex_hull_destroy(hull);
+
+    desc.max_vertices = 24;
+    hull = convex_hull_build(points, count, &desc);
+    TEST_ASSERT(hull && hull->vertex_count <= 24, "Vertex limit should cap the hull");
+    TEST_ASSERT(hull && hull->volume > 0.75f * full_volume && hull_is_consistent(hull, 1.0e-5f),
+                "A limited hull should keep the most significant extreme points");
+    convex_hull_destroy(hull);
+    free(points);
+
+    Mesh* sphere = make_sphere_mesh(2.0f, 16, 24);
+    hull = convex_hull_from_mesh(sphere, &desc);
+    TEST_ASSERT(hull && hull->vertex_count <= 24 && hull_is_consistent(hull, 1.0e-5f),
+                "Mesh hulls should handle duplicated seam and pole vertices");
+    convex_hull_destroy(hull);
+    release_mesh(sphere);
+}
+
+static void test_degenerate_input(void) {
+    printf("\n--- Degenerate Input Tests ---\n");
+
+    vec3_t flat[64];
+    for (uint32_t i = 0; i < 64; i++) flat[i] = vec3((float)(i % 8), 0.25f * (float)(i % 8) + (float)(i / 8), 3.0f);
+    TEST_ASSERT(convex_hull_build(flat, 64, NULL) == NULL, "Coplanar input should be rejected");
+
+    vec3_t line[16];
+    for (uint32_t i = 0; i < 16; i++) line[i] = vec3((float)i, 2.0f * (float)i, -(float)i);
+    TEST_ASSERT(convex_hull_build(line, 16, NULL) == NULL, "Collinear input should be rejected");
+
+    TEST_ASSERT(convex_hull_build(flat, 3, NULL) == NULL, "Fewer than four points should be rejected");
+    TEST_ASSERT(convex_hull_build(NULL, 10, NULL) == NULL, "NULL input should be rejected");
+
+    flat[10].z = 3.001f;
+    ConvexHull* sliver = convex_hull_build(flat, 64, NULL);
+    TEST_ASSERT(sliver && sliver->volume > 0.0f && hull_is_consistent(sliver, 1.0e-5f),
+                "A thin sliver should still build a valid hull");
+    convex_hull_destroy(sliver);
+}
+
+static void test_asset_hulls(void) {
+    printf("\n--- Asset Hull Tests ---\n");
+
+    const char* names[2] = { "UnitBox.fbx", "UnitSphere.fbx" };
+    for (uint32_t n = 0; n < 2; n++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", assets_dir, names[n]);
+        char* err = NULL;
+        Model3D* model = fbx_load_model(path, &err);
+        if (!model || model->mesh_count == 0) {
+            printf("  %s unavailable: %s\n", names[n], err ? err : "no meshes");
+            fbx_free_error(err);
+            TEST_ASSERT(0, "Sample asset should load");
+            continue;
+        }
+
+        Mesh* mesh = &model->meshes[0];
+        ConvexHullDesc desc = convex_hull_desc_default();
+        desc.max_vertices = 1024;
+        ConvexHull* hull = convex_hull_from_mesh(mesh, &desc);
+        vec3_t* points = mesh_positions(mesh);
+        float diagonal = vec3_distance(model->bounding_min, model->bounding_max);
+        if (n == 0) {
+            TEST_ASSERT(hull && hull->vertex_count == 8 && hull->face_count == 6, "UnitBox hull should be a box");
+        } else {
+            TEST_ASSERT(hull && hull->vertex_count <= mesh->vertex_count && hull->face_count >= 8,
+                        "UnitSphere hull should build");
+        }
+        TEST_ASSERT(hull && max_outside(hull, points, mesh->vertex_count) < 1.0e-5f * diagonal &&
+                    hull_is_consistent(hull, 1.0e-5f * diagonal), "Asset hulls should enclose their meshes");
+        convex_hull_print(names[n], hull);
+        free(points);
+        convex_hull_destroy(hull);
+        model3d_free(model);
+        free(model);
+    }
+}
+
+// ============================================================================
+// CONVEX DECOMPOSITION TESTS
+// ============================================================================
+
+static void test_decomposition(void) {
+    printf("\n--- Convex Decomposition Tests ---\n");
+
+    // L-shape: a 2x1x1 bar with a 1x1x1 block on one end
+    Mesh* bar = make_box_mesh(vec3(0.0f, 0.0f, 0.0f), vec3(2.0f, 1.0f, 1.0f), 2);
+    Mesh* block = make_box_mesh(vec3(0.0f, 1.0f, 0.0f), vec3(1.0f, 2.0f, 1.0f), 1);
+    Mesh* l_shape = merge_meshes(bar, block);
+    ConvexHull* single = convex_hull_from_mesh(l_shape, NULL);
+    ConvexDecomposition* parts = convex_decompose_mesh(l_shape, NULL);
+    TEST_ASSERT_NOT_NULL(parts, "L-shape should decompose");
+    if (parts && single) {
+        printf("  L-shape: %u hulls, volume %.3f (single hull %.3f)\n", parts->hull_count, total_volume(parts), single->volume);
+        TEST_ASSERT(parts->hull_count >= 2, "L-shape should need more than one hull");
+        TEST_ASSERT(fabsf(total_volume(parts) - 3.0f) < 0.05f, "L-shape hulls should fit the solid closely");
+        TEST_ASSERT(decomposition_coverage(parts, l_shape) < 1.0e-4f, "L-shape hulls should cover every vertex");
+        int consistent = 1;
+        for (uint32_t i = 0; i < parts->hull_count; i++) consistent &= hull_is_consistent(parts->hulls[i], 1.0e-4f);
+        TEST_ASSERT(consistent, "Decomposition hulls should be valid convex hulls");
+    }
+    convex_hull_destroy(single);
+    convex_decomposition_destroy(parts);
+    release_mesh(bar);
+    release_mesh(block);
+    release_mesh(l_shape);
+
+    Mesh* torus = make_torus_mesh(2.0f, 0.5f, 32, 12);
+    single = convex_hull_from_mesh(torus, NULL);
+    ConvexDecompositionDesc desc = convex_decomposition_desc_default();
+    parts = convex_decompose_mesh(torus, &desc);
+    TEST_ASSERT_NOT_NULL(parts, "Torus should decompose");
+    if (parts && single) {
+        float solid = 2.0f * 3.14159265f * 3.14159265f * 2.0f * 0.25f;
+        printf("  Torus: %u hulls, volume %.3f (single hull %.3f, solid %.3f)\n", parts->hull_count,
+               total_volume(parts), single->volume, solid);
+        TEST_ASSERT(parts->hull_count >= 4 && parts->hull_count <= desc.max_hulls, "Torus should split into several hulls");
+        TEST_ASSERT(total_volume(parts) < 1.15f * solid && total_volume(parts) < 0.7f * single->volume,
+                    "Torus hulls should fit the ring and leave the hole open");
+        TEST_ASSERT(decomposition_coverage(parts, torus) < 0.02f, "Torus hulls should cover the surface");
+    }
+    convex_hull_destroy(single);
+    convex_decomposition_destroy(parts);
+
+    desc.max_hulls = 3;
+    parts = convex_decompose_mesh(torus, &desc);
+    TEST_ASSERT(parts && parts->hull_count <= 3, "Decomposition should respect the hull budget");
+    convex_decomposition_destroy(parts);
+    release_mesh(torus);
+
+    Mesh* sphere = make_sphere_mesh(1.0f, 12, 16);
+    parts = convex_decompose_mesh(sphere, NULL);
+    TEST_ASSERT(parts && parts->hull_count == 1, "Convex meshes should stay a single hull");
+    convex_decomposition_destroy(parts);
+    release_mesh(sphere);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static double time_hull(const vec3_t* points, uint32_t count, const ConvexHullDesc* desc, int runs, ConvexHull** out) {
+    double best = 1.0e9;
+    for (int run = 0; run < runs; run++) {
+        double start = now_ms();
+        ConvexHull* hull = convex_hull_build(points, count, desc);
+        double elapsed = now_ms() - start;
+        if (elapsed < best) best = elapsed;
+        if (run + 1 < runs) convex_hull_destroy(hull);
+        else *out = hull;
+    }
+    return best;
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    ConvexHullDesc limited = convex_hull_desc_default();
+    ConvexHullDesc full = convex_hull_desc_default();
+    full.max_vertices = 1u << 20;
+
+    const char* names[2] = { "UnitBox.fbx", "UnitSphere.fbx" };
+    for (uint32_t n = 0; n < 2; n++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", assets_dir, names[n]);
+        char* err = NULL;
+        Model3D* model = fbx_load_model(path, &err);
+        fbx_free_error(err);
+        if (!model || model->mesh_count == 0) continue;
+        vec3_t* points = mesh_positions(&model->meshes[0]);
+        ConvexHull* hull = NULL;
+        double ms = time_hull(points, model->meshes[0].vertex_count, &full, 20, &hull);
+        printf("  %-16s %7u points -> %4u vertices, %4u faces: %.3f ms\n", names[n],
+               model->meshes[0].vertex_count, hull ? hull->vertex_count : 0, hull ? hull->face_count : 0, ms);
+        convex_hull_destroy(hull);
+        free(points);
+        model3d_free(model);
+        free(model);
+    }
+
+    const uint32_t counts[3] = { 1000, 10000, 100000 };
+    double sphere_100k = 0.0, cube_100k = 0.0;
+    for (uint32_t c = 0; c < 3; c++) {
+        uint32_t count = counts[c];
+        vec3_t* sphere = (vec3_t*)malloc(count * sizeof(vec3_t));
+        vec3_t* cube = (vec3_t*)malloc(count * sizeof(vec3_t));
+        for (uint32_t i = 0; i < count; i++) {
+            sphere[i] = vec3_scale(random_unit_vector(), 0.5f + 0.5f * random_float());
+            cube[i] = vec3(random_float() - 0.5f, random_float() - 0.5f, random_float() - 0.5f);
+        }
+        ConvexHull* hull = NULL;
+        double ms = time_hull(sphere, count, &full, 3, &hull);
+        printf("  ball %6u        full hull   -> %4u vertices, %4u faces: %.3f ms\n", count,
+               hull ? hull->vertex_count : 0, hull ? hull->face_count : 0, ms);
+        convex_hull_destroy(hull);
+        double limited_ms = time_hull(sphere, count, &limited, 3, &hull);
+        printf("  ball %6u        64-vertex   -> %4u vertices, %4u faces: %.3f ms\n", count,
+               hull ? hull->vertex_count : 0, hull ? hull->face_count : 0, limited_ms);
+        convex_hull_destroy(hull);
+        double cube_ms = time_hull(cube, count, &full, 3, &hull);
+        printf("  cube %6u        full hull   -> %4u vertices, %4u faces: %.3f ms\n", count,
+               hull ? hull->vertex_count : 0, hull ? hull->face_count : 0, cube_ms);
+        convex_hull_destroy(hull);
+        if (count == 100000) {
+            sphere_100k = limited_ms;
+            cube_100k = cube_ms;
+        }
+        free(sphere);
+        free(cube);
+    }
+
+    Mesh* box = make_box_mesh(vec3(-1.0f, -1.0f, -1.0f), vec3(1.0f, 1.0f, 1.0f), 64);
+    vec3_t* box_points = mesh_positions(box);
+    ConvexHull* box_hull = NULL;
+    double box_ms = time_hull(box_points, box->vertex_count, &full, 3, &box_hull);
+    printf("  grid box %6u    coplanar    -> %4u vertices, %4u faces: %.3f ms\n", box->vertex_count,
+           box_hull ? box_hull->vertex_count : 0, box_hull ? box_hull->face_count : 0, box_ms);
+    convex_hull_destroy(box_hull);
+    free(box_points);
+    release_mesh(box);
+
+    Mesh* torus = make_torus_mesh(2.0f, 0.5f, 48, 16);
+    double start = now_ms();
+    ConvexDecomposition* parts = convex_decompose_mesh(torus, NULL);
+    double decompose_ms = now_ms() - start;
+    printf("  torus %u triangles decomposition -> %u hulls: %.3f ms\n", torus->index_count / 3,
+           parts ? parts->hull_count : 0, decompose_ms);
+    convex_decomposition_destroy(parts);
+    release_mesh(torus);
+
+    TEST_ASSERT(sphere_100k < 50.0, "64-vertex hull of 100k points should build in milliseconds");
+    TEST_ASSERT(cube_100k < 100.0, "Full hull of 100k points should build quickly");
+    TEST_ASSERT(decompose_ms < 2000.0, "Torus decomposition should finish in interactive time");
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Convex Hull Unit Tests\n");
+    printf("===================================\n");
+
+    test_box_hulls();
+    test_sphere_hulls();
+    test_degenerate_input();
+    test_asset_hulls();
+    test_decomposition();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,223 @@
+#include "engine_jobs.h"
+#include <pthread.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+// ============================================================================
+// JOB SYSTEM STATE
+// ============================================================================
+
+struct JobSystem {
+    pthread_t threads[JOB_SYSTEM_MAX_WORKERS];
+    uint32_t worker_count;              // Includes the calling thread
+    uint32_t thread_count;              // Pool threads actually started
+
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;           // Signalled when a job is published
+    pthread_cond_t idle_cond;           // Signalled when the last worker leaves a job
+    pthread_mutex_t call_mutex;         // Serializes concurrent parallel_for callers
+
+    // Current job (written by the caller while no worker is active)
+    JobRangeFunc func;
+    void* user_data;
+    uint32_t count;
+    uint32_t grain;
+    uint32_t chunk_count;
+    uint32_t next_chunk;                // Claimed with an atomic fetch-add
+
+    uint64_t generation;                // Bumped per published job
+    uint32_t active_workers;            // Workers currently inside a job
+    int job_open;                       // Workers may still join the job
+    int shutdown;
+};
+
+typedef struct {
+    struct JobSystem* jobs;
+    uint32_t worker_index;
+} JobWorkerArgs;
+
+// Job system whose chunks this thread is running, and as which worker. A
+// parallel_for on that system from inside a chunk runs serially instead of
+// waiting on the job that is running it.
+static __thread struct JobSystem* current_jobs;
+static __thread uint32_t current_worker_index;
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static void run_chunks(struct JobSystem* jobs, uint32_t worker_index) {
+    struct JobSystem* outer_jobs = current_jobs;
+    uint32_t outer_worker_index = current_worker_index;
+    current_jobs = jobs;
+    current_worker_index = worker_index;
+    for (;;) {
+        uint32_t chunk = __sync_fetch_and_add(&jobs->next_chunk, 1);
+        if (chunk >= jobs->chunk_count) {
+            break;
+        }
+        uint32_t begin = chunk * jobs->grain;
+        uint32_t end = begin + jobs->grain;
+        if (end > jobs->count) end = jobs->count;
+        jobs->func(jobs->user_data, begin, end, worker_index);
+    }
+    current_jobs = outer_jobs;
+    current_worker_index = outer_worker_index;
+}
+
+static void* worker_main(void* arg) {
+    JobWorkerArgs* args = (JobWorkerArgs*)arg;
+    struct JobSystem* jobs = args->jobs;
+    uint32_t worker_index = args->worker_index;
+    free(args);
+
+    uint64_t seen_generation = 0;
+    pthread_mutex_lock(&jobs->mutex);
+    for (;;) {
+        while (!jobs->shutdown && (!jobs->job_open || jobs->generation == seen_generation)) {
+            pthread_cond_wait(&jobs->work_cond, &jobs->mutex);
+        }
+        if (jobs->shutdown) {
+            break;
+        }
+        seen_generation = jobs->generation;
+        jobs->active_workers++;
+        pthread_mutex_unlock(&jobs->mutex);
+
+        run_chunks(jobs, worker_index);
+
+        pthread_mutex_lock(&jobs->mutex);
+        jobs->active_workers--;
+        if (jobs->active_workers == 0) {
+            pthread_cond_signal(&jobs->idle_cond);
+        }
+    }
+    pthread_mutex_unlock(&jobs->mutex);
+    return NULL;
+}
+
+// ============================================================================
+// JOB SYSTEM FUNCTIONS
+// ============================================================================
+
+uint32_t job_system_cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (uint32_t)n : 1;
+}
+
+JobSystemHandle job_system_create(uint32_t worker_count) {
+    if (worker_count == 0) {
+        worker_count = job_system_cpu_count();
+    }
+    if (worker_count > JOB_SYSTEM_MAX_WORKERS) {
+        worker_count = JOB_SYSTEM_MAX_WORKERS;
+    }
+
+    struct JobSystem* jobs = (struct JobSystem*)calloc(1, sizeof(struct JobSystem));
+    if (!jobs) {
+        fprintf(stderr, "Error: Failed to allocate memory for job system\n");
+        return NULL;
+    }
+
+    pthread_mutex_init(&jobs->mutex, NULL);
+    pthread_mutex_init(&jobs->call_mutex, NULL);
+    pthread_cond_init(&jobs->work_cond, NULL);
+    pthread_cond_init(&jobs->idle_cond, NULL);
+    jobs->worker_count = 1;
+
+    // Worker 0 is the calling thread; start the remaining pool threads
+    for (uint32_t i = 1; i < worker_count; i++) {
+        JobWorkerArgs* args = (JobWorkerArgs*)malloc(sizeof(JobWorkerArgs));
+        if (!args) {
+            break;
+        }
+        args->jobs = jobs;
+        args->worker_index = i;
+        if (pthread_create(&jobs->threads[jobs->thread_count], NULL, worker_main, args) != 0) {
+            fprintf(stderr, "Warning: Failed to start job worker %u, continuing with %u\n", i, jobs->worker_count);
+            free(args);
+            break;
+        }
+        jobs->thread_count++;
+        jobs->worker_count++;
+    }
+
+    fprintf(stderr, "Created job system with %u workers\n", jobs->worker_count);
+    return jobs;
+}
+
+void job_system_destroy(JobSystemHandle jobs) {
+    if (!jobs) {
+        return;
+    }
+
+    pthread_mutex_lock(&jobs->mutex);
+    jobs->shutdown = 1;
+    pthread_cond_broadcast(&jobs->work_cond);
+    pthread_mutex_unlock(&jobs->mutex);
+
+    for (uint32_t i = 0; i < jobs->thread_count; i++) {
+        pthread_join(jobs->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&jobs->work_cond);
+    pthread_cond_destroy(&jobs->idle_cond);
+    pthread_mutex_destroy(&jobs->mutex);
+    pthread_mutex_destroy(&jobs->call_mutex);
+    free(jobs);
+}
+
+uint32_t job_system_get_worker_count(JobSystemHandle jobs) {
+    return jobs ? jobs->worker_count : 1;
+}
+
+void job_system_parallel_for(JobSystemHandle jobs, uint32_t count, uint32_t grain,
+                             JobRangeFunc func, void* user_data) {
+    if (!func || count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = JOB_SYSTEM_DEFAULT_GRAIN;
+    }
+
+    // Nested call from one of this pool's chunks: the pool is busy with the
+    // outer job, so run on this worker (checked first so small nested calls
+    // keep the worker index too)
+    if (jobs && current_jobs == jobs) {
+        func(user_data, 0, count, current_worker_index);
+        return;
+    }
+
+    // Serial path: no pool, or not enough work to be worth waking threads
+    if (!jobs || jobs->worker_count == 1 || count <= grain) {
+        func(user_data, 0, count, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&jobs->call_mutex);
+
+    pthread_mutex_lock(&jobs->mutex);
+    jobs->func = func;
+    jobs->user_data = user_data;
+    jobs->count = count;
+    jobs->grain = grain;
+    jobs->chunk_count = (count + grain - 1) / grain;
+    jobs->next_chunk = 0;
+    jobs->generation++;
+    jobs->job_open = 1;
+    pthread_cond_broadcast(&jobs->work_cond);
+    pthread_mutex_unlock(&jobs->mutex);
+
+    run_chunks(jobs, 0);
+
+    // Close the job so late wakers skip it, then wait for in-flight chunks
+    pthread_mutex_lock(&jobs->mutex);
+    jobs->job_open = 0;
+    while (jobs->active_workers > 0) {
+        pthread_cond_wait(&jobs->idle_cond, &jobs->mutex);
+    }
+    pthread_mutex_unlock(&jobs->mutex);
+
+    pthread_mutex_unlock(&jobs->call_mutex);
+}
@@ -0,0 +1,58 @@
+#ifndef ENGINE_JOBS_H
+#define ENGINE_JOBS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// ============================================================================
+// JOB SYSTEM CONFIGURATION
+// ============================================================================
+
+#define JOB_SYSTEM_MAX_WORKERS 64            // Upper bound on worker threads
+#define JOB_SYSTEM_DEFAULT_GRAIN 64          // Default items per chunk
+
+// ============================================================================
+// JOB SYSTEM TYPES
+// ============================================================================
+
+// Opaque job system handle (persistent pthread worker pool)
+typedef struct JobSystem* JobSystemHandle;
+
+// Range callback: processes items [begin, end). worker_index is 0 for the
+// calling thread and 1..worker_count-1 for pool threads, so callers can keep
+// per-worker scratch memory without locking.
+typedef void (*JobRangeFunc)(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index);
+
+// ============================================================================
+// JOB SYSTEM FUNCTIONS
+// ============================================================================
+
+// Create a worker pool. worker_count includes the calling thread;
+// 0 selects the number of online CPU cores.
+JobSystemHandle job_system_create(uint32_t worker_count);
+
+// Stop and join all worker threads
+void job_system_destroy(JobSystemHandle jobs);
+
+// Number of threads participating in parallel_for (always >= 1, 1 for NULL)
+uint32_t job_system_get_worker_count(JobSystemHandle jobs);
+
+// Split [0, count) into chunks of `grain` items and run them across the pool.
+// Blocks until every chunk has completed. A NULL job system runs serially on
+// the calling thread, so callers never need a separate single-threaded path.
+// Calls from inside a chunk of the same job system (nested parallel_for)
+// also run serially, on the worker index of the chunk that made them.
+void job_system_parallel_for(JobSystemHandle jobs, uint32_t count, uint32_t grain,
+                             JobRangeFunc func, void* user_data);
+
+// Number of online CPU cores
+uint32_t job_system_cpu_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_JOBS_H
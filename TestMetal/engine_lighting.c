@@ -0,0 +1,720 @@
+#include "engine_lighting.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// SOA FIELD TABLES
+// ============================================================================
+
+// Per-cluster view-space bounds
+#define CLUSTER_BOUND_FIELDS(X) \
+    X(min_x) X(min_y) X(min_z) \
+    X(max_x) X(max_y) X(max_z) \
+    X(center_x) X(center_y) X(center_z) X(bound_radius)
+
+// Per-light view-space data written by each build
+#define LIGHT_VIEW_FIELDS(X) \
+    X(view_x) X(view_y) X(view_z) X(view_radius) \
+    X(view_dir_x) X(view_dir_y) X(view_dir_z) \
+    X(cone_cos) X(cone_sin)
+
+// Compacted row candidates in ClusterScratch
+#define SCRATCH_FLOAT_FIELDS(X) \
+    X(x) X(y) X(z) X(radius) \
+    X(dir_x) X(dir_y) X(dir_z) \
+    X(cone_cos) X(cone_sin)
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+// Light arrays are padded to a multiple of four so 4-wide loads never
+// read past the end
+FORCE_INLINE uint32_t round_up4(uint32_t n) {
+    return (n + 3u) & ~3u;
+}
+
+// Row-vector transforms (p' = p * M)
+FORCE_INLINE vec3_t transform_point(mat4_t m, vec3_t p) {
+    return vec3(p.x * m.x.x + p.y * m.y.x + p.z * m.z.x + m.w.x,
+                p.x * m.x.y + p.y * m.y.y + p.z * m.z.y + m.w.y,
+                p.x * m.x.z + p.y * m.y.z + p.z * m.z.z + m.w.z);
+}
+
+FORCE_INLINE vec3_t transform_direction(mat4_t m, vec3_t d) {
+    return vec3(d.x * m.x.x + d.y * m.y.x + d.z * m.z.x,
+                d.x * m.x.y + d.y * m.y.y + d.z * m.z.y,
+                d.x * m.x.z + d.y * m.y.z + d.z * m.z.z);
+}
+
+// Squared distance from a point to a box along one axis
+FORCE_INLINE float axis_distance(float p, float lo, float hi) {
+    float d = 0.0f;
+    if (p < lo) d = lo - p;
+    if (p > hi) d = p - hi;
+    return d;
+}
+
+FORCE_INLINE simd4f_t axis_distance4(simd4f_t p, simd4f_t lo, simd4f_t hi) {
+    return simd4f_max(simd4f_max(lo - p, p - hi), simd4f_splat(0.0f));
+}
+
+// Sphere vs box, scalar
+FORCE_INLINE int sphere_touches_box(float x, float y, float z, float r,
+                                    float min_x, float min_y, float min_z,
+                                    float max_x, float max_y, float max_z) {
+    float dx = axis_distance(x, min_x, max_x);
+    float dy = axis_distance(y, min_y, max_y);
+    float dz = axis_distance(z, min_z, max_z);
+    return dx * dx + dy * dy + dz * dz <= r * r;
+}
+
+// Scalar light-vs-cluster test: range sphere against the cluster box, and
+// for spots the cone against the cluster's bounding sphere
+static int light_touches_cluster(const ClusteredLighting* lighting, uint32_t light, uint32_t cluster) {
+    float x = lighting->view_x[light];
+    float y = lighting->view_y[light];
+    float z = lighting->view_z[light];
+    float r = lighting->view_radius[light];
+    if (!sphere_touches_box(x, y, z, r,
+                            lighting->min_x[cluster], lighting->min_y[cluster], lighting->min_z[cluster],
+                            lighting->max_x[cluster], lighting->max_y[cluster], lighting->max_z[cluster])) {
+        return 0;
+    }
+    if (!lighting->is_spot[light]) {
+        return 1;
+    }
+
+    float vx = lighting->center_x[cluster] - x;
+    float vy = lighting->center_y[cluster] - y;
+    float vz = lighting->center_z[cluster] - z;
+    float bound = lighting->bound_radius[cluster];
+    float len_sq = vx * vx + vy * vy + vz * vz;
+    float along = vx * lighting->view_dir_x[light] + vy * lighting->view_dir_y[light] + vz * lighting->view_dir_z[light];
+    float lateral = sqrtf(fmaxf(len_sq - along * along, 0.0f));
+    float closest = lighting->cone_cos[light] * lateral - along * lighting->cone_sin[light];
+    return !(closest > bound || along > bound + r || along < -bound);
+}
+
+static void free_slices(ClusteredLighting* lighting) {
+    if (!lighting->slice_data) {
+        return;
+    }
+    for (uint32_t s = 0; s < lighting->desc.slices; s++) {
+        free(lighting->slice_data[s].ranges);
+        free(lighting->slice_data[s].indices);
+    }
+    free(lighting->slice_data);
+    lighting->slice_data = NULL;
+}
+
+static void free_scratch(ClusteredLighting* lighting) {
+    if (!lighting->scratch) {
+        return;
+    }
+    for (uint32_t w = 0; w < lighting->scratch_count; w++) {
+        ClusterScratch* scratch = &lighting->scratch[w];
+        free(scratch->slice_lights);
+        free(scratch->row_lights);
+#define LIGHTING_FREE_FIELD(name) free(scratch->name);
+        SCRATCH_FLOAT_FIELDS(LIGHTING_FREE_FIELD)
+#undef LIGHTING_FREE_FIELD
+        free(scratch->is_spot);
+    }
+    free(lighting->scratch);
+    lighting->scratch = NULL;
+    lighting->scratch_count = 0;
+}
+
+// One scratch set per worker, each able to hold every light
+static int ensure_scratch(ClusteredLighting* lighting, uint32_t worker_count) {
+    if (lighting->scratch_count >= worker_count) {
+        return 1;
+    }
+    free_scratch(lighting);
+
+    lighting->scratch = (ClusterScratch*)calloc(worker_count, sizeof(ClusterScratch));
+    if (!lighting->scratch) {
+        return 0;
+    }
+    lighting->scratch_count = worker_count;
+
+    uint32_t capacity = round_up4(lighting->light_capacity);
+    int ok = 1;
+    for (uint32_t w = 0; w < worker_count; w++) {
+        ClusterScratch* scratch = &lighting->scratch[w];
+        scratch->slice_lights = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+        scratch->row_lights = (uint16_t*)malloc(capacity * sizeof(uint16_t));
+#define LIGHTING_ALLOC_FIELD(name) \
+        scratch->name = (float*)calloc(capacity, sizeof(float)); ok = ok && scratch->name;
+        SCRATCH_FLOAT_FIELDS(LIGHTING_ALLOC_FIELD)
+#undef LIGHTING_ALLOC_FIELD
+        scratch->is_spot = (int32_t*)calloc(capacity, sizeof(int32_t));
+        ok = ok && scratch->slice_lights && scratch->row_lights && scratch->is_spot;
+    }
+    if (!ok) {
+        free_scratch(lighting);
+    }
+    return ok;
+}
+
+// Recompute slice depths and cluster bounds from the projection
+static void compute_cluster_bounds(ClusteredLighting* lighting) {
+    const ClusterGridDesc* desc = &lighting->desc;
+    float near_plane = desc->near_plane;
+    float far_plane = desc->far_plane;
+    float log_ratio = log2f(far_plane / near_plane);
+
+    lighting->tan_half_y = tanf(desc->fov_y * 0.5f);
+    lighting->tan_half_x = lighting->tan_half_y * desc->aspect;
+    lighting->slice_scale = (float)desc->slices / log_ratio;
+    lighting->slice_bias = -(float)desc->slices * log2f(near_plane) / log_ratio;
+
+    for (uint32_t s = 0; s <= desc->slices; s++) {
+        lighting->slice_depths[s] = near_plane * powf(far_plane / near_plane, (float)s / (float)desc->slices);
+    }
+    lighting->slice_depths[0] = near_plane;
+    lighting->slice_depths[desc->slices] = far_plane;
+
+    for (uint32_t s = 0; s < desc->slices; s++) {
+        float d0 = lighting->slice_depths[s];
+        float d1 = lighting->slice_depths[s + 1];
+        for (uint32_t ty = 0; ty < desc->tiles_y; ty++) {
+            float ny0 = -1.0f + 2.0f * (float)ty / (float)desc->tiles_y;
+            float ny1 = -1.0f + 2.0f * (float)(ty + 1) / (float)desc->tiles_y;
+            for (uint32_t tx = 0; tx < desc->tiles_x; tx++) {
+                float nx0 = -1.0f + 2.0f * (float)tx / (float)desc->tiles_x;
+                float nx1 = -1.0f + 2.0f * (float)(tx + 1) / (float)desc->tiles_x;
+                uint32_t c = (s * desc->tiles_y + ty) * desc->tiles_x + tx;
+
+                // The cluster is a frustum chunk; its box spans the tile's
+                // corners at both slice depths
+                lighting->min_x[c] = fminf(nx0 * d0, nx0 * d1) * lighting->tan_half_x;
+                lighting->max_x[c] = fmaxf(nx1 * d0, nx1 * d1) * lighting->tan_half_x;
+                lighting->min_y[c] = fminf(ny0 * d0, ny0 * d1) * lighting->tan_half_y;
+                lighting->max_y[c] = fmaxf(ny1 * d0, ny1 * d1) * lighting->tan_half_y;
+                lighting->min_z[c] = -d1;
+                lighting->max_z[c] = -d0;
+
+                float hx = 0.5f * (lighting->max_x[c] - lighting->min_x[c]);
+                float hy = 0.5f * (lighting->max_y[c] - lighting->min_y[c]);
+                float hz = 0.5f * (lighting->max_z[c] - lighting->min_z[c]);
+                lighting->center_x[c] = lighting->min_x[c] + hx;
+                lighting->center_y[c] = lighting->min_y[c] + hy;
+                lighting->center_z[c] = lighting->min_z[c] + hz;
+                lighting->bound_radius[c] = sqrtf(hx * hx + hy * hy + hz * hz);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// CLUSTERED LIGHTING FUNCTIONS
+// ============================================================================
+
+ClusterGridDesc cluster_grid_desc_default(void) {
+    ClusterGridDesc desc;
+    desc.tiles_x = 16;
+    desc.tiles_y = 9;
+    desc.slices = 24;
+    desc.max_lights_per_cluster = 128;
+    desc.fov_y = (float)M_PI / 3.0f;
+    desc.aspect = 16.0f / 9.0f;
+    desc.near_plane = 0.1f;
+    desc.far_plane = 100.0f;
+    return desc;
+}
+
+ClusteredLighting* clustered_lighting_create(const ClusterGridDesc* desc, uint32_t max_lights) {
+    if (!desc || desc->tiles_x == 0 || desc->tiles_y == 0 || desc->slices == 0) {
+        fprintf(stderr, "Error: Cannot create clustered lighting with an empty grid\n");
+        return NULL;
+    }
+    if (max_lights == 0 || max_lights > CLUSTER_MAX_LIGHTS) {
+        fprintf(stderr, "Error: Clustered lighting supports 1 to %u lights\n", CLUSTER_MAX_LIGHTS);
+        return NULL;
+    }
+    if (desc->near_plane <= 0.0f || desc->far_plane <= desc->near_plane) {
+        fprintf(stderr, "Error: Clustered lighting needs 0 < near < far\n");
+        return NULL;
+    }
+
+    ClusteredLighting* lighting = (ClusteredLighting*)calloc(1, sizeof(ClusteredLighting));
+    if (!lighting) {
+        fprintf(stderr, "Error: Failed to allocate memory for clustered lighting\n");
+        return NULL;
+    }
+
+    lighting->desc = *desc;
+    if (lighting->desc.max_lights_per_cluster == 0) {
+        lighting->desc.max_lights_per_cluster = max_lights;
+    }
+    lighting->cluster_count = desc->tiles_x * desc->tiles_y * desc->slices;
+    lighting->light_capacity = max_lights;
+
+    uint32_t clusters = lighting->cluster_count;
+    uint32_t light_slots = round_up4(max_lights);
+    uint32_t tiles = desc->tiles_x * desc->tiles_y;
+    int ok = 1;
+
+#define LIGHTING_ALLOC_CLUSTER(name) \
+    lighting->name = (float*)calloc(clusters, sizeof(float)); ok = ok && lighting->name;
+    CLUSTER_BOUND_FIELDS(LIGHTING_ALLOC_CLUSTER)
+#undef LIGHTING_ALLOC_CLUSTER
+#define LIGHTING_ALLOC_LIGHT(name) \
+    lighting->name = (float*)calloc(light_slots, sizeof(float)); ok = ok && lighting->name;
+    LIGHT_VIEW_FIELDS(LIGHTING_ALLOC_LIGHT)
+#undef LIGHTING_ALLOC_LIGHT
+
+    lighting->slice_depths = (float*)calloc(desc->slices + 1, sizeof(float));
+    lighting->lights = (Light*)calloc(max_lights, sizeof(Light));
+    lighting->is_spot = (int32_t*)calloc(light_slots, sizeof(int32_t));
+    lighting->ranges = (ClusterRange*)calloc(clusters, sizeof(ClusterRange));
+    lighting->slice_data = (ClusterSlice*)calloc(desc->slices, sizeof(ClusterSlice));
+    ok = ok && lighting->slice_depths && lighting->lights && lighting->is_spot &&
+         lighting->ranges && lighting->slice_data;
+
+    if (ok) {
+        for (uint32_t s = 0; s < desc->slices; s++) {
+            lighting->slice_data[s].ranges = (ClusterRange*)calloc(tiles, sizeof(ClusterRange));
+            ok = ok && lighting->slice_data[s].ranges;
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for clustered lighting\n");
+        clustered_lighting_destroy(lighting);
+        return NULL;
+    }
+
+    compute_cluster_bounds(lighting);
+
+    fprintf(stderr, "Created clustered lighting with %ux%ux%u clusters, %u lights\n",
+            desc->tiles_x, desc->tiles_y, desc->slices, max_lights);
+    return lighting;
+}
+
+void clustered_lighting_destroy(ClusteredLighting* lighting) {
+    if (!lighting) {
+        return;
+    }
+
+#define LIGHTING_FREE_FIELD(name) free(lighting->name);
+    CLUSTER_BOUND_FIELDS(LIGHTING_FREE_FIELD)
+    LIGHT_VIEW_FIELDS(LIGHTING_FREE_FIELD)
+#undef LIGHTING_FREE_FIELD
+    free(lighting->slice_depths);
+    free(lighting->lights);
+    free(lighting->is_spot);
+    free(lighting->ranges);
+    free(lighting->light_indices);
+    free_slices(lighting);
+    free_scratch(lighting);
+    free(lighting);
+}
+
+void clustered_lighting_set_projection(ClusteredLighting* lighting, float fov_y, float aspect,
+                                       float near_plane, float far_plane) {
+    if (!lighting) {
+        return;
+    }
+    if (near_plane <= 0.0f || far_plane <= near_plane) {
+        fprintf(stderr, "Error: Clustered lighting needs 0 < near < far\n");
+        return;
+    }
+    lighting->desc.fov_y = fov_y;
+    lighting->desc.aspect = aspect;
+    lighting->desc.near_plane = near_plane;
+    lighting->desc.far_plane = far_plane;
+    compute_cluster_bounds(lighting);
+}
+
+uint32_t clustered_lighting_add_light(ClusteredLighting* lighting, const Light* light) {
+    if (!lighting || !light) {
+        return CLUSTER_INVALID_LIGHT;
+    }
+    if (lighting->light_count >= lighting->light_capacity) {
+        fprintf(stderr, "Error: Clustered lighting is full (%u lights)\n", lighting->light_capacity);
+        return CLUSTER_INVALID_LIGHT;
+    }
+
+    uint32_t index = lighting->light_count++;
+    Light* stored = &lighting->lights[index];
+    *stored = *light;
+    if (stored->type == LIGHT_TYPE_SPOT) {
+        stored->direction = vec3_normalize(stored->direction);
+    }
+    return index;
+}
+
+void clustered_lighting_clear_lights(ClusteredLighting* lighting) {
+    if (lighting) {
+        lighting->light_count = 0;
+    }
+}
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+// Grow a slice's index list to hold at least needed entries
+static int slice_reserve(ClusterSlice* slice, uint32_t needed) {
+    if (needed <= slice->index_capacity) {
+        return 1;
+    }
+    uint32_t capacity = slice->index_capacity ? slice->index_capacity : 256;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    uint16_t* indices = (uint16_t*)realloc(slice->indices, capacity * sizeof(uint16_t));
+    if (!indices) {
+        return 0;
+    }
+    slice->indices = indices;
+    slice->index_capacity = capacity;
+    return 1;
+}
+
+// Assign lights to every cluster of one Z slice. Lights are culled against
+// the slice, then each row, and the survivors are compacted so the
+// per-cluster test runs four lights at a time with contiguous loads.
+static uint32_t build_slice(ClusteredLighting* lighting, uint32_t s, ClusterScratch* scratch) {
+    const ClusterGridDesc* desc = &lighting->desc;
+    ClusterSlice* slice = &lighting->slice_data[s];
+    uint32_t tiles_x = desc->tiles_x;
+    uint32_t cap = desc->max_lights_per_cluster;
+    uint32_t first_cluster = s * desc->tiles_y * tiles_x;
+    uint32_t overflow = 0;
+    const simd4i_t lane_index = {0, 1, 2, 3};
+
+    slice->index_count = 0;
+    memset(slice->ranges, 0, desc->tiles_y * tiles_x * sizeof(ClusterRange));
+
+    // Depth cull against the slice's z range
+    simd4f_t slice_min_z = simd4f_splat(lighting->min_z[first_cluster]);
+    simd4f_t slice_max_z = simd4f_splat(lighting->max_z[first_cluster]);
+    uint32_t slice_count = 0;
+    for (uint32_t i = 0; i < lighting->light_count; i += 4) {
+        simd4f_t z = simd4f_load(lighting->view_z + i);
+        simd4f_t r = simd4f_load(lighting->view_radius + i);
+        simd4i_t hit = (z - r <= slice_max_z) & (z + r >= slice_min_z) &
+                       (lane_index < (simd4i_t){0, 0, 0, 0} + (int32_t)(lighting->light_count - i));
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            if (hit[lane]) {
+                scratch->slice_lights[slice_count++] = (uint16_t)(i + lane);
+            }
+        }
+    }
+    if (slice_count == 0) {
+        return 0;
+    }
+
+    for (uint32_t ty = 0; ty < desc->tiles_y; ty++) {
+        uint32_t row_first = first_cluster + ty * tiles_x;
+        uint32_t row_last = row_first + tiles_x - 1;
+
+        // Row cull (clusters of a row share y/z bounds; x grows with the tile)
+        uint32_t row_count = 0;
+        for (uint32_t k = 0; k < slice_count; k++) {
+            uint32_t l = scratch->slice_lights[k];
+            if (sphere_touches_box(lighting->view_x[l], lighting->view_y[l], lighting->view_z[l],
+                                   lighting->view_radius[l],
+                                   lighting->min_x[row_first], lighting->min_y[row_first], lighting->min_z[row_first],
+                                   lighting->max_x[row_last], lighting->max_y[row_first], lighting->max_z[row_first])) {
+                scratch->row_lights[row_count] = (uint16_t)l;
+#define LIGHTING_GATHER_FIELD(field, source) scratch->field[row_count] = lighting->source[l];
+                LIGHTING_GATHER_FIELD(x, view_x)
+                LIGHTING_GATHER_FIELD(y, view_y)
+                LIGHTING_GATHER_FIELD(z, view_z)
+                LIGHTING_GATHER_FIELD(radius, view_radius)
+                LIGHTING_GATHER_FIELD(dir_x, view_dir_x)
+                LIGHTING_GATHER_FIELD(dir_y, view_dir_y)
+                LIGHTING_GATHER_FIELD(dir_z, view_dir_z)
+                LIGHTING_GATHER_FIELD(cone_cos, cone_cos)
+                LIGHTING_GATHER_FIELD(cone_sin, cone_sin)
+                LIGHTING_GATHER_FIELD(is_spot, is_spot)
+#undef LIGHTING_GATHER_FIELD
+                row_count++;
+            }
+        }
+        if (row_count == 0) {
+            continue;
+        }
+
+        for (uint32_t tx = 0; tx < tiles_x; tx++) {
+            uint32_t c = row_first + tx;
+            ClusterRange* range = &slice->ranges[ty * tiles_x + tx];
+            range->offset = slice->index_count;
+            if (!slice_reserve(slice, slice->index_count + (row_count < cap ? row_count : cap))) {
+                overflow += row_count;
+                continue;
+            }
+
+            simd4f_t min_x = simd4f_splat(lighting->min_x[c]);
+            simd4f_t min_y = simd4f_splat(lighting->min_y[c]);
+            simd4f_t min_z = simd4f_splat(lighting->min_z[c]);
+            simd4f_t max_x = simd4f_splat(lighting->max_x[c]);
+            simd4f_t max_y = simd4f_splat(lighting->max_y[c]);
+            simd4f_t max_z = simd4f_splat(lighting->max_z[c]);
+            simd4f_t center_x = simd4f_splat(lighting->center_x[c]);
+            simd4f_t center_y = simd4f_splat(lighting->center_y[c]);
+            simd4f_t center_z = simd4f_splat(lighting->center_z[c]);
+            simd4f_t bound = simd4f_splat(lighting->bound_radius[c]);
+            uint32_t count = 0;
+
+            for (uint32_t j = 0; j < row_count; j += 4) {
+                simd4f_t x = simd4f_load(scratch->x + j);
+                simd4f_t y = simd4f_load(scratch->y + j);
+                simd4f_t z = simd4f_load(scratch->z + j);
+                simd4f_t r = simd4f_load(scratch->radius + j);
+
+                // Range sphere vs cluster box
+                simd4f_t dx = axis_distance4(x, min_x, max_x);
+                simd4f_t dy = axis_distance4(y, min_y, max_y);
+                simd4f_t dz = axis_distance4(z, min_z, max_z);
+                simd4i_t hit = dx * dx + dy * dy + dz * dz <= r * r;
+
+                // Spot cone vs cluster bounding sphere
+                simd4f_t vx = center_x - x;
+                simd4f_t vy = center_y - y;
+                simd4f_t vz = center_z - z;
+                simd4f_t len_sq = vx * vx + vy * vy + vz * vz;
+                simd4f_t along = vx * simd4f_load(scratch->dir_x + j) +
+                                 vy * simd4f_load(scratch->dir_y + j) +
+                                 vz * simd4f_load(scratch->dir_z + j);
+                simd4f_t lateral = simd4f_sqrt(simd4f_max(len_sq - along * along, simd4f_splat(0.0f)));
+                simd4f_t closest = simd4f_load(scratch->cone_cos + j) * lateral -
+                                   along * simd4f_load(scratch->cone_sin + j);
+                simd4i_t cone_cull = (closest > bound) | (along > bound + r) | (along < -bound);
+                simd4i_t is_spot;
+                memcpy(&is_spot, scratch->is_spot + j, sizeof(is_spot));
+                hit &= ~(cone_cull & is_spot);
+                hit &= lane_index < (simd4i_t){0, 0, 0, 0} + (int32_t)(row_count - j);
+
+                for (uint32_t lane = 0; lane < 4; lane++) {
+                    if (hit[lane]) {
+                        if (count < cap) {
+                            slice->indices[slice->index_count + count++] = scratch->row_lights[j + lane];
+                        } else {
+                            overflow++;
+                        }
+                    }
+                }
+            }
+            range->count = count;
+            slice->index_count += count;
+        }
+    }
+    return overflow;
+}
+
+typedef struct {
+    ClusteredLighting* lighting;
+    uint32_t* overflow;         // Per slice
+} ClusterBuildJob;
+
+static void build_slices_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    ClusterBuildJob* job = (ClusterBuildJob*)user_data;
+    ClusterScratch* scratch = &job->lighting->scratch[worker_index];
+    for (uint32_t s = begin; s < end; s++) {
+        job->overflow[s] = build_slice(job->lighting, s, scratch);
+    }
+}
+
+void clustered_lighting_build(ClusteredLighting* lighting, mat4_t view, JobSystemHandle jobs) {
+    if (!lighting) {
+        return;
+    }
+
+    const ClusterGridDesc* desc = &lighting->desc;
+    uint32_t worker_count = jobs ? job_system_get_worker_count(jobs) : 1;
+    uint32_t* overflow = (uint32_t*)calloc(desc->slices, sizeof(uint32_t));
+    if (!overflow || !ensure_scratch(lighting, worker_count)) {
+        fprintf(stderr, "Error: Failed to allocate clustered lighting scratch\n");
+        free(overflow);
+        return;
+    }
+
+    // Lights to view space. Point lights keep a zero cone that is never tested.
+    for (uint32_t i = 0; i < lighting->light_count; i++) {
+        const Light* light = &lighting->lights[i];
+        vec3_t p = transform_point(view, light->position);
+        lighting->view_x[i] = p.x;
+        lighting->view_y[i] = p.y;
+        lighting->view_z[i] = p.z;
+        lighting->view_radius[i] = light->range;
+
+        int spot = light->type == LIGHT_TYPE_SPOT;
+        vec3_t d = spot ? vec3_normalize(transform_direction(view, light->direction)) : vec3_zero();
+        lighting->view_dir_x[i] = d.x;
+        lighting->view_dir_y[i] = d.y;
+        lighting->view_dir_z[i] = d.z;
+        lighting->cone_cos[i] = spot ? cosf(light->spot_outer_angle) : 0.0f;
+        lighting->cone_sin[i] = spot ? sinf(light->spot_outer_angle) : 0.0f;
+        lighting->is_spot[i] = spot ? -1 : 0;
+    }
+
+    ClusterBuildJob job = { lighting, overflow };
+    job_system_parallel_for(jobs, desc->slices, 1, build_slices_range, &job);
+
+    // Concatenate slice lists and rebase their ranges
+    uint32_t total = 0;
+    lighting->overflow_count = 0;
+    for (uint32_t s = 0; s < desc->slices; s++) {
+        total += lighting->slice_data[s].index_count;
+        lighting->overflow_count += overflow[s];
+    }
+    free(overflow);
+
+    if (total > lighting->index_capacity) {
+        uint16_t* indices = (uint16_t*)realloc(lighting->light_indices, total * sizeof(uint16_t));
+        if (!indices) {
+            fprintf(stderr, "Error: Failed to allocate %u cluster light indices\n", total);
+            memset(lighting->ranges, 0, lighting->cluster_count * sizeof(ClusterRange));
+            lighting->index_count = 0;
+            return;
+        }
+        lighting->light_indices = indices;
+        lighting->index_capacity = total;
+    }
+
+    uint32_t tiles = desc->tiles_x * desc->tiles_y;
+    uint32_t base = 0;
+    for (uint32_t s = 0; s < desc->slices; s++) {
+        const ClusterSlice* slice = &lighting->slice_data[s];
+        if (slice->index_count) {
+            memcpy(lighting->light_indices + base, slice->indices, slice->index_count * sizeof(uint16_t));
+        }
+        for (uint32_t t = 0; t < tiles; t++) {
+            lighting->ranges[s * tiles + t].offset = base + slice->ranges[t].offset;
+            lighting->ranges[s * tiles + t].count = slice->ranges[t].count;
+        }
+        base += slice->index_count;
+    }
+    lighting->index_count = total;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+uint32_t clustered_lighting_get_cluster_index(const ClusteredLighting* lighting, vec3_t view_position) {
+    if (!lighting) {
+        return CLUSTER_INVALID_INDEX;
+    }
+    const ClusterGridDesc* desc = &lighting->desc;
+    float depth = -view_position.z;
+    if (!(depth >= desc->near_plane && depth < desc->far_plane)) {
+        return CLUSTER_INVALID_INDEX;
+    }
+
+    // Logarithmic slice estimate, snapped to the stored boundaries
+    int32_t s = (int32_t)floorf(log2f(depth) * lighting->slice_scale + lighting->slice_bias);
+    if (s < 0) s = 0;
+    if (s >= (int32_t)desc->slices) s = (int32_t)desc->slices - 1;
+    while (s > 0 && depth < lighting->slice_depths[s]) s--;
+    while (s + 1 < (int32_t)desc->slices && depth >= lighting->slice_depths[s + 1]) s++;
+
+    float nx = view_position.x / (depth * lighting->tan_half_x);
+    float ny = view_position.y / (depth * lighting->tan_half_y);
+    if (!(nx >= -1.0f && nx < 1.0f && ny >= -1.0f && ny < 1.0f)) {
+        return CLUSTER_INVALID_INDEX;
+    }
+    uint32_t tx = (uint32_t)((nx + 1.0f) * 0.5f * (float)desc->tiles_x);
+    uint32_t ty = (uint32_t)((ny + 1.0f) * 0.5f * (float)desc->tiles_y);
+    if (tx >= desc->tiles_x) tx = desc->tiles_x - 1;
+    if (ty >= desc->tiles_y) ty = desc->tiles_y - 1;
+
+    return ((uint32_t)s * desc->tiles_y + ty) * desc->tiles_x + tx;
+}
+
+const uint16_t* clustered_lighting_get_cluster_lights(const ClusteredLighting* lighting, uint32_t cluster,
+                                                      uint32_t* out_count) {
+    if (!lighting || cluster >= lighting->cluster_count || !lighting->light_indices) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+    if (out_count) *out_count = lighting->ranges[cluster].count;
+    return lighting->light_indices + lighting->ranges[cluster].offset;
+}
+
+uint32_t clustered_lighting_validate(const ClusteredLighting* lighting) {
+    if (!lighting) {
+        return 0;
+    }
+
+    uint32_t mismatches = 0;
+    uint32_t cap = lighting->desc.max_lights_per_cluster;
+    for (uint32_t c = 0; c < lighting->cluster_count; c++) {
+        uint32_t count = 0;
+        const uint16_t* list = clustered_lighting_get_cluster_lights(lighting, c, &count);
+        uint32_t expected = 0;
+        int match = 1;
+        for (uint32_t l = 0; l < lighting->light_count && match; l++) {
+            if (!light_touches_cluster(lighting, l, c)) {
+                continue;
+            }
+            if (expected < cap) {
+                match = expected < count && list[expected] == l;
+            }
+            expected++;
+        }
+        if (!match || (expected < cap ? expected : cap) != count) {
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+// ============================================================================
+// LIGHT HELPERS
+// ============================================================================
+
+Light light_point(vec3_t position, float range, vec3_t color, float intensity) {
+    Light light;
+    memset(&light, 0, sizeof(light));
+    light.type = LIGHT_TYPE_POINT;
+    light.position = position;
+    light.direction = vec3(0.0f, 0.0f, -1.0f);
+    light.color = color;
+    light.intensity = intensity;
+    light.range = range;
+    return light;
+}
+
+Light light_spot(vec3_t position, vec3_t direction, float range, float inner_angle, float outer_angle,
+                 vec3_t color, float intensity) {
+    Light light = light_point(position, range, color, intensity);
+    light.type = LIGHT_TYPE_SPOT;
+    light.direction = vec3_normalize(direction);
+    light.spot_inner_angle = inner_angle;
+    light.spot_outer_angle = outer_angle;
+    return light;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void clustered_lighting_print(const char* name, const ClusteredLighting* lighting) {
+    if (!lighting) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    uint32_t occupied = 0;
+    uint32_t max_count = 0;
+    for (uint32_t c = 0; c < lighting->cluster_count; c++) {
+        uint32_t count = lighting->ranges[c].count;
+        if (count) occupied++;
+        if (count > max_count) max_count = count;
+    }
+
+    printf("%s: %ux%ux%u clusters, %u lights\n", name,
+           lighting->desc.tiles_x, lighting->desc.tiles_y, lighting->desc.slices, lighting->light_count);
+    printf("  Indices: %u (%.1f per occupied cluster, max %u, %u occupied)\n",
+           lighting->index_count, occupied ? (float)lighting->index_count / (float)occupied : 0.0f,
+           max_count, occupied);
+    printf("  Overflow: %u\n", lighting->overflow_count);
+}
@@ -0,0 +1,182 @@
+#ifndef ENGINE_LIGHTING_H
+#define ENGINE_LIGHTING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+
+// ============================================================================
+// CLUSTERED LIGHTING CONFIGURATION
+// ============================================================================
+
+#define CLUSTER_MAX_LIGHTS 65535                // Light indices are stored as uint16
+#define CLUSTER_INVALID_LIGHT 0xFFFFFFFFu
+#define CLUSTER_INVALID_INDEX 0xFFFFFFFFu
+
+// Light types
+typedef enum {
+    LIGHT_TYPE_POINT = 0,
+    LIGHT_TYPE_SPOT = 1
+} LightType;
+
+// ============================================================================
+// CLUSTERED LIGHTING DATA STRUCTURES
+// ============================================================================
+
+// Dynamic light in world space
+typedef struct {
+    LightType type;
+    vec3_t position;
+    vec3_t direction;           // Spot axis (normalized on add)
+    vec3_t color;
+    float intensity;
+    float range;                // Influence radius; no contribution beyond it
+    float spot_inner_angle;     // Half-angles in radians (spot only)
+    float spot_outer_angle;
+} Light;
+
+// Froxel grid over a perspective view frustum. Tiles split the screen
+// uniformly in NDC (row 0 is NDC y = -1); slices split view depth
+// exponentially between near and far.
+typedef struct {
+    uint32_t tiles_x;
+    uint32_t tiles_y;
+    uint32_t slices;
+    uint32_t max_lights_per_cluster;
+    float fov_y;                // Radians
+    float aspect;
+    float near_plane;
+    float far_plane;
+} ClusterGridDesc;
+
+// Slice of ClusteredLighting.light_indices owned by one cluster (GPU layout)
+typedef struct {
+    uint32_t offset;
+    uint32_t count;
+} ClusterRange;
+
+// Light list of one Z slice, built by a single job
+typedef struct {
+    ClusterRange* ranges;       // tiles_x * tiles_y, offsets relative to indices
+    uint16_t* indices;
+    uint32_t index_count;
+    uint32_t index_capacity;
+} ClusterSlice;
+
+// Candidate lights of one slice row, compacted for 4-wide tests
+typedef struct {
+    uint16_t* slice_lights;     // Lights touching the current slice
+    uint16_t* row_lights;       // ... and the current row
+    float* x; float* y; float* z; float* radius;
+    float* dir_x; float* dir_y; float* dir_z;
+    float* cone_cos; float* cone_sin;
+    int32_t* is_spot;
+} ClusterScratch;
+
+// Clustered light assignment. Clusters are indexed
+// (slice * tiles_y + y) * tiles_x + x; each one's view-space bounds are
+// precomputed from the projection, and every build writes compact,
+// index-sorted light lists that can be uploaded as-is.
+typedef struct {
+    ClusterGridDesc desc;
+    uint32_t cluster_count;
+    float tan_half_x;           // View-space x/depth at the right frustum edge
+    float tan_half_y;
+    float slice_scale;          // slice = log2(depth) * slice_scale + slice_bias
+    float slice_bias;
+    float* slice_depths;        // slices + 1 boundaries (positive view depth)
+
+    // Cluster bounds in view space (camera looks down -Z), SoA
+    float* min_x; float* min_y; float* min_z;
+    float* max_x; float* max_y; float* max_z;
+    float* center_x; float* center_y; float* center_z; float* bound_radius;
+
+    // Lights (world space) and their view-space SoA copy from the last build
+    Light* lights;
+    uint32_t light_count;
+    uint32_t light_capacity;
+    float* view_x; float* view_y; float* view_z; float* view_radius;
+    float* view_dir_x; float* view_dir_y; float* view_dir_z;
+    float* cone_cos; float* cone_sin;
+    int32_t* is_spot;
+
+    // Output
+    ClusterRange* ranges;       // cluster_count entries
+    uint16_t* light_indices;
+    uint32_t index_count;
+    uint32_t index_capacity;
+    uint32_t overflow_count;    // Assignments dropped by max_lights_per_cluster
+
+    // Per-slice outputs and per-worker scratch
+    ClusterSlice* slice_data;
+    ClusterScratch* scratch;
+    uint32_t scratch_count;
+} ClusteredLighting;
+
+// ============================================================================
+// CLUSTERED LIGHTING FUNCTIONS
+// ============================================================================
+
+// Default grid: 16x9 tiles, 24 slices, 128 lights per cluster, 60 degree
+// fov at 16:9 over [0.1, 100]
+ClusterGridDesc cluster_grid_desc_default(void);
+
+// Create a light clusterer for up to max_lights lights
+ClusteredLighting* clustered_lighting_create(const ClusterGridDesc* desc, uint32_t max_lights);
+
+// Destroy a light clusterer
+void clustered_lighting_destroy(ClusteredLighting* lighting);
+
+// Change the projection and recompute cluster bounds (grid size is kept)
+void clustered_lighting_set_projection(ClusteredLighting* lighting, float fov_y, float aspect,
+                                       float near_plane, float far_plane);
+
+// Add a light. Returns its index or CLUSTER_INVALID_LIGHT when full.
+uint32_t clustered_lighting_add_light(ClusteredLighting* lighting, const Light* light);
+
+// Remove all lights
+void clustered_lighting_clear_lights(ClusteredLighting* lighting);
+
+// Assign lights to clusters for a world-to-view matrix. Slices are built in
+// parallel; jobs may be NULL (serial).
+void clustered_lighting_build(ClusteredLighting* lighting, mat4_t view, JobSystemHandle jobs);
+
+// Cluster containing a view-space point, or CLUSTER_INVALID_INDEX outside the grid
+uint32_t clustered_lighting_get_cluster_index(const ClusteredLighting* lighting, vec3_t view_position);
+
+// Light indices assigned to a cluster by the last build
+const uint16_t* clustered_lighting_get_cluster_lights(const ClusteredLighting* lighting, uint32_t cluster,
+                                                      uint32_t* out_count);
+
+// Scalar reference check of the last build: recomputes every cluster's list
+// with one light-vs-cluster test at a time and returns the number of
+// clusters whose list differs (0 = valid)
+uint32_t clustered_lighting_validate(const ClusteredLighting* lighting);
+
+// ============================================================================
+// LIGHT HELPERS
+// ============================================================================
+
+// Point light
+Light light_point(vec3_t position, float range, vec3_t color, float intensity);
+
+// Spot light (angles are half-angles in radians)
+Light light_spot(vec3_t position, vec3_t direction, float range, float inner_angle, float outer_angle,
+                 vec3_t color, float intensity);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print grid size and assignment statistics of the last build
+void clustered_lighting_print(const char* name, const ClusteredLighting* lighting);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_LIGHTING_H
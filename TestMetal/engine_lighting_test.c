@@ -0,0 +1,296 @@
+#include "engine_lighting.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static uint32_t rng_state = 12345u;
+
+static float rand_float(float lo, float hi) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return lo + (hi - lo) * (float)(rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static vec3_t transform_point(mat4_t m, vec3_t p) {
+    return vec3(p.x * m.x.x + p.y * m.y.x + p.z * m.z.x + m.w.x,
+                p.x * m.x.y + p.y * m.y.y + p.z * m.z.y + m.w.y,
+                p.x * m.x.z + p.y * m.y.z + p.z * m.z.z + m.w.z);
+}
+
+static int cluster_has_light(const ClusteredLighting* lighting, uint32_t cluster, uint32_t light) {
+    uint32_t count = 0;
+    const uint16_t* list = clustered_lighting_get_cluster_lights(lighting, cluster, &count);
+    for (uint32_t i = 0; i < count; i++) {
+        if (list[i] == light) return 1;
+    }
+    return 0;
+}
+
+// Random point and spot lights scattered in front of a camera at the origin
+static void add_random_lights(ClusteredLighting* lighting, uint32_t count, float spread) {
+    for (uint32_t i = 0; i < count; i++) {
+        vec3_t position = vec3(rand_float(-spread, spread), rand_float(-spread * 0.25f, spread * 0.25f),
+                               rand_float(-spread * 2.0f, 2.0f));
+        vec3_t color = vec3(1.0f, 0.9f, 0.8f);
+        float range = rand_float(0.5f, 6.0f);
+        if (i % 3 == 0) {
+            vec3_t direction = vec3(rand_float(-1.0f, 1.0f), rand_float(-1.0f, 1.0f), rand_float(-1.0f, 1.0f));
+            float outer = rand_float(0.1f, 1.0f);
+            Light light = light_spot(position, direction, range, outer * 0.8f, outer, color, 10.0f);
+            clustered_lighting_add_light(lighting, &light);
+        } else {
+            Light light = light_point(position, range, color, 5.0f);
+            clustered_lighting_add_light(lighting, &light);
+        }
+    }
+}
+
+// ============================================================================
+// TEST FUNCTIONS
+// ============================================================================
+
+static void test_cluster_grid(void) {
+    printf("\n--- Cluster Grid Tests ---\n");
+
+    ClusterGridDesc desc = cluster_grid_desc_default();
+    ClusteredLighting* lighting = clustered_lighting_create(&desc, 16);
+    TEST_ASSERT_NOT_NULL(lighting, "Clustered lighting should be created");
+    TEST_ASSERT_EQUAL(16u * 9u * 24u, lighting->cluster_count, "Default grid should have 16x9x24 clusters");
+
+    int monotonic = 1;
+    for (uint32_t s = 0; s < desc.slices; s++) {
+        if (!(lighting->slice_depths[s + 1] > lighting->slice_depths[s])) monotonic = 0;
+    }
+    TEST_ASSERT(monotonic && lighting->slice_depths[0] == desc.near_plane &&
+                lighting->slice_depths[desc.slices] == desc.far_plane,
+                "Slice depths should grow from near to far");
+
+    // Exponential slicing: every slice has the same far/near ratio
+    float ratio0 = lighting->slice_depths[1] / lighting->slice_depths[0];
+    float ratio1 = lighting->slice_depths[20] / lighting->slice_depths[19];
+    TEST_ASSERT(fabsf(ratio0 - ratio1) < 1e-3f, "Slices should be exponentially spaced");
+
+    uint32_t center = clustered_lighting_get_cluster_index(lighting, vec3(0.01f, 0.01f, -1.0f));
+    TEST_ASSERT(center != CLUSTER_INVALID_INDEX, "Point on the view axis should be in a cluster");
+    TEST_ASSERT_EQUAL(8u, center % desc.tiles_x, "View axis should map to the center tile column");
+    TEST_ASSERT_EQUAL(4u, (center / desc.tiles_x) % desc.tiles_y, "View axis should map to the center tile row");
+    TEST_ASSERT(lighting->min_z[center] <= -1.0f && lighting->max_z[center] >= -1.0f,
+                "Point depth should lie inside its cluster's slice");
+
+    uint32_t bottom_left = clustered_lighting_get_cluster_index(lighting, vec3(-1.0f, -0.5f, -1.0f));
+    TEST_ASSERT_EQUAL(0u, bottom_left % desc.tiles_x, "Left edge should map to column 0");
+    TEST_ASSERT_EQUAL(0u, (bottom_left / desc.tiles_x) % desc.tiles_y, "Bottom edge should map to row 0");
+
+    TEST_ASSERT_EQUAL(CLUSTER_INVALID_INDEX, clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, 1.0f)),
+                      "Point behind the camera should have no cluster");
+    TEST_ASSERT_EQUAL(CLUSTER_INVALID_INDEX, clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, -200.0f)),
+                      "Point beyond the far plane should have no cluster");
+    TEST_ASSERT_EQUAL(CLUSTER_INVALID_INDEX, clustered_lighting_get_cluster_index(lighting, vec3(10.0f, 0.0f, -1.0f)),
+                      "Point outside the side planes should have no cluster");
+
+    desc.slices = 0;
+    TEST_ASSERT(clustered_lighting_create(&desc, 16) == NULL, "Empty grid should be rejected");
+
+    clustered_lighting_destroy(lighting);
+}
+
+static void test_point_and_spot_lights(void) {
+    printf("\n--- Light Assignment Tests ---\n");
+
+    ClusterGridDesc desc = cluster_grid_desc_default();
+    ClusteredLighting* lighting = clustered_lighting_create(&desc, 4);
+
+    // Identity view: world space is view space
+    Light point = light_point(vec3(0.0f, 0.0f, -10.0f), 1.0f, vec3_one(), 1.0f);
+    Light spot = light_spot(vec3(0.0f, 0.0f, -20.0f), vec3(0.0f, 0.0f, -1.0f), 10.0f, 0.1f, 0.15f, vec3_one(), 1.0f);
+    TEST_ASSERT_EQUAL(0u, clustered_lighting_add_light(lighting, &point), "Point light should get index 0");
+    TEST_ASSERT_EQUAL(1u, clustered_lighting_add_light(lighting, &spot), "Spot light should get index 1");
+    clustered_lighting_build(lighting, mat4_identity(), NULL);
+
+    uint32_t at_point = clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, -10.0f));
+    uint32_t far_away = clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, -50.0f));
+    TEST_ASSERT(cluster_has_light(lighting, at_point, 0), "Point light should touch the cluster containing it");
+    TEST_ASSERT(!cluster_has_light(lighting, far_away, 0), "Point light should not reach a distant slice");
+
+    uint32_t on_axis = clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, -27.0f));
+    uint32_t off_axis = clustered_lighting_get_cluster_index(lighting, vec3(7.5f, 0.0f, -25.0f));
+    uint32_t behind = clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, -14.0f));
+    TEST_ASSERT(cluster_has_light(lighting, on_axis, 1), "Spot light should touch clusters along its axis");
+    TEST_ASSERT(!cluster_has_light(lighting, off_axis, 1), "Spot light should skip clusters outside its cone");
+    TEST_ASSERT(!cluster_has_light(lighting, behind, 1), "Spot light should skip clusters behind it");
+    TEST_ASSERT_EQUAL(0u, clustered_lighting_validate(lighting), "Build should match the scalar reference");
+
+    // Moving the camera moves the lights through the grid
+    mat4_t view = mat4_look_at(vec3(0.0f, 0.0f, -8.0f), vec3(0.0f, 0.0f, -9.0f), vec3_unit_y());
+    clustered_lighting_build(lighting, view, NULL);
+    uint32_t near_camera = clustered_lighting_get_cluster_index(lighting, vec3(0.0f, 0.0f, -2.0f));
+    TEST_ASSERT(cluster_has_light(lighting, near_camera, 0), "View matrix should be applied to light positions");
+    TEST_ASSERT_EQUAL(0u, clustered_lighting_validate(lighting), "Moved build should match the scalar reference");
+
+    clustered_lighting_clear_lights(lighting);
+    clustered_lighting_build(lighting, mat4_identity(), NULL);
+    TEST_ASSERT_EQUAL(0u, lighting->index_count, "Build without lights should assign nothing");
+
+    clustered_lighting_destroy(lighting);
+}
+
+static void test_random_scenes(void) {
+    printf("\n--- Reference Validation Tests ---\n");
+
+    ClusterGridDesc desc = cluster_grid_desc_default();
+    ClusteredLighting* lighting = clustered_lighting_create(&desc, 512);
+    ClusteredLighting* serial = clustered_lighting_create(&desc, 512);
+    JobSystemHandle jobs = job_system_create(4);
+    rng_state = 777u;
+    add_random_lights(lighting, 512, 30.0f);
+    rng_state = 777u;
+    add_random_lights(serial, 512, 30.0f);
+
+    mat4_t view = mat4_look_at(vec3(2.0f, 3.0f, 5.0f), vec3(0.0f, 0.0f, -20.0f), vec3_unit_y());
+    clustered_lighting_build(lighting, view, jobs);
+    clustered_lighting_build(serial, view, NULL);
+    TEST_ASSERT(lighting->index_count > 0, "Random scene should assign lights");
+    TEST_ASSERT_EQUAL(0u, lighting->overflow_count, "Random scene should fit the per-cluster limit");
+    TEST_ASSERT_EQUAL(0u, clustered_lighting_validate(lighting), "Parallel build should match the scalar reference");
+    TEST_ASSERT(lighting->index_count == serial->index_count &&
+                memcmp(lighting->ranges, serial->ranges, lighting->cluster_count * sizeof(ClusterRange)) == 0 &&
+                memcmp(lighting->light_indices, serial->light_indices, lighting->index_count * sizeof(uint16_t)) == 0,
+                "Parallel and serial builds should be identical");
+
+    // Ground truth: every light that reaches a point must be listed in its cluster
+    uint32_t missing = 0, samples = 0;
+    for (int i = 0; i < 20000; i++) {
+        vec3_t p = vec3(rand_float(-30.0f, 30.0f), rand_float(-8.0f, 8.0f), rand_float(-60.0f, 2.0f));
+        vec3_t vp = transform_point(view, p);
+        uint32_t cluster = clustered_lighting_get_cluster_index(lighting, vp);
+        if (cluster == CLUSTER_INVALID_INDEX) continue;
+        samples++;
+        for (uint32_t l = 0; l < lighting->light_count; l++) {
+            const Light* light = &lighting->lights[l];
+            vec3_t to_point = vec3_sub(p, light->position);
+            float distance = vec3_length(to_point);
+            if (distance >= light->range * 0.999f) continue;
+            if (light->type == LIGHT_TYPE_SPOT && distance > 1e-4f &&
+                vec3_dot(vec3_scale(to_point, 1.0f / distance), light->direction) <= cosf(light->spot_outer_angle) + 1e-4f) {
+                continue;
+            }
+            if (!cluster_has_light(lighting, cluster, l)) missing++;
+        }
+    }
+    printf("  %u samples inside the frustum, %u missing assignments\n", samples, missing);
+    TEST_ASSERT(samples > 1000, "Enough samples should land inside the frustum");
+    TEST_ASSERT_EQUAL(0u, missing, "Cluster lists should be conservative");
+
+    // Per-cluster limit: lists are truncated, overflow is reported
+    ClusterGridDesc capped_desc = desc;
+    capped_desc.max_lights_per_cluster = 4;
+    ClusteredLighting* capped = clustered_lighting_create(&capped_desc, 512);
+    rng_state = 777u;
+    add_random_lights(capped, 512, 30.0f);
+    clustered_lighting_build(capped, view, jobs);
+    uint32_t max_count = 0;
+    for (uint32_t c = 0; c < capped->cluster_count; c++) {
+        if (capped->ranges[c].count > max_count) max_count = capped->ranges[c].count;
+    }
+    TEST_ASSERT(max_count == 4 && capped->overflow_count > 0, "Capped lists should stop at the limit");
+    TEST_ASSERT_EQUAL(0u, clustered_lighting_validate(capped), "Capped build should match the scalar reference");
+
+    clustered_lighting_destroy(capped);
+    clustered_lighting_destroy(serial);
+    clustered_lighting_destroy(lighting);
+    job_system_destroy(jobs);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t light_count = 1024;
+    const int frames = 50;
+    ClusterGridDesc desc = cluster_grid_desc_default();
+    ClusteredLighting* lighting = clustered_lighting_create(&desc, light_count);
+    JobSystemHandle jobs = job_system_create(0);
+    rng_state = 4242u;
+    add_random_lights(lighting, light_count, 40.0f);
+
+    for (int pass = 0; pass < 2; pass++) {
+        JobSystemHandle pass_jobs = pass == 0 ? NULL : jobs;
+        double total = 0.0, best = 1e9;
+        for (int f = 0; f < frames; f++) {
+            float angle = (float)f * 0.02f;
+            mat4_t view = mat4_look_at(vec3(0.0f, 2.0f, 0.0f), vec3(sinf(angle), 2.0f, -cosf(angle)), vec3_unit_y());
+            double start = now_ms();
+            clustered_lighting_build(lighting, view, pass_jobs);
+            double elapsed = now_ms() - start;
+            total += elapsed;
+            if (elapsed < best) best = elapsed;
+        }
+        printf("%s (%u workers): avg %.3f ms/build, best %.3f ms/build\n",
+               pass == 0 ? "serial" : "parallel", job_system_get_worker_count(pass_jobs), total / frames, best);
+    }
+
+    double start = now_ms();
+    uint32_t mismatches = clustered_lighting_validate(lighting);
+    double reference = now_ms() - start;
+    printf("scalar reference: %.3f ms\n", reference);
+    clustered_lighting_print("  Last build", lighting);
+    TEST_ASSERT_EQUAL(0u, mismatches, "1024-light build should match the scalar reference");
+
+    clustered_lighting_destroy(lighting);
+    job_system_destroy(jobs);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Clustered Lighting Unit Tests\n");
+    printf("===================================\n");
+
+    test_cluster_grid();
+    test_point_and_spot_lights();
+    test_random_scenes();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
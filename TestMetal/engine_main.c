@@ -5,21 +5,166 @@
 #include "engine_2d.h"
 #include "engine_texture_loader.h"
 #include "engine_font.h"
+#include "engine_jobs.h"
+#include "engine_physics.h"
+#include "engine_particles.h"
+#include "engine_lighting.h"
+#include "engine_shadows.h"
+#include "engine_hot_reload.h"
 #include <stdlib.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <dirent.h>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+#define ENGINE_DEFAULT_FONT_SIZE 64
+#define ENGINE_DEFAULT_FONT_SPACING 1.0f
+
+// ============================================================================
+// HOT RELOAD HANDLERS
+// ============================================================================
+
+// Import runs on the reloader thread and only parses; the upload waits for
+// apply because the shared mesh arena is owned by the render thread
+static void* engine_reload_import_model(void* user_data, const char* path) {
+    (void)user_data;
+    char* error = NULL;
+    Model3D* model = fbx_load_model(path, &error);
+    if (!model) {
+        fprintf(stderr, "Hot reload: failed to load %s: %s\n", path, error ? error : "unknown error");
+    }
+    fbx_free_error(error);
+    return model;
+}
+
+static void engine_reload_discard_model(void* user_data, void* imported) {
+    (void)user_data;
+    Model3D* model = (Model3D*)imported;
+    model3d_free(model);
+    free(model);
+}
+
+static void engine_reload_apply_model(void* user_data, const char* name, void* imported) {
+    EngineReloadModel* binding = (EngineReloadModel*)user_data;
+    EngineStateStruct* engine = (EngineStateStruct*)binding->engine;
+
+    MetalModelHandle model = metal_engine_upload_model((MetalEngine*)engine->metal_engine, (Model3D*)imported);
+    engine_reload_discard_model(NULL, imported);
+    if (!model) {
+        fprintf(stderr, "Hot reload: failed to upload %s, keeping the old model\n", name);
+        return;
+    }
+
+    uint32_t rebound = 0;
+    for (uint32_t i = 0; engine->world && i < engine->world->max_entities; i++) {
+        WorldEntity* entity = &engine->world->entities[i];
+        if (entity->id != 0 && entity_get_model(entity) == binding->model) {
+            entity_set_model(entity, model);
+            rebound++;
+        }
+    }
+
+    // Frames in flight may still draw from the old model's pool ranges
+    metal_engine_retire_model((MetalEngine*)engine->metal_engine, binding->model);
+    binding->model = model;
+    fprintf(stderr, "Hot reloaded model %s (%u entities)\n", name, rebound);
+}
+
+static void* engine_reload_import_texture(void* user_data, const char* path) {
+    (void)user_data;
+    return texture_loader_decode_file(path);
+}
+
+static void engine_reload_apply_texture(void* user_data, const char* name, void* imported) {
+    EngineStateStruct* engine = (EngineStateStruct*)user_data;
+    if (texture_loader_replace(engine->texture_loader, name, (TextureImage*)imported)) {
+        fprintf(stderr, "Hot reloaded texture %s\n", name);
+    }
+}
+
+static void engine_reload_discard_texture(void* user_data, void* imported) {
+    (void)user_data;
+    texture_loader_free_image((TextureImage*)imported);
+}
+
+static void* engine_reload_import_font(void* user_data, const char* path) {
+    EngineStateStruct* engine = (EngineStateStruct*)user_data;
+    return engine_font_create(path, ENGINE_DEFAULT_FONT_SIZE, ENGINE_DEFAULT_FONT_SPACING, engine->metal_engine);
+}
+
+// Swap the atlas and glyphs behind the existing font handle
+static void engine_reload_apply_font(void* user_data, const char* name, void* imported) {
+    EngineStateStruct* engine = (EngineStateStruct*)user_data;
+    EngineFontHandle fresh = (EngineFontHandle)imported;
+    if (!engine->default_font) {
+        engine_font_destroy(fresh);
+        return;
+    }
+
+    EngineFont previous = *engine->default_font;
+    *engine->default_font = *fresh;
+    *fresh = previous;
+    engine_font_destroy(fresh);
+    fprintf(stderr, "Hot reloaded font %s\n", name);
+}
+
+static void engine_reload_discard_font(void* user_data, void* imported) {
+    (void)user_data;
+    engine_font_destroy((EngineFontHandle)imported);
+}
+
+static int engine_is_texture_file(const char* name) {
+    const char* ext = strrchr(name, '.');
+    return ext && (strcasecmp(ext, ".png") == 0 || strcasecmp(ext, ".jpg") == 0 ||
+                   strcasecmp(ext, ".jpeg") == 0);
+}
+
+// Watch every image in the assets directory plus the default font. Texture
+// names match the ones passed to texture_loader_load, so a reload replaces
+// the cache entry (and does nothing if the texture was never loaded).
+static void engine_watch_textures_and_fonts(EngineStateStruct* engine) {
+    if (!engine->hot_reload || !engine->resource_path) {
+        return;
+    }
+
+    char assets_path[1024];
+    snprintf(assets_path, sizeof(assets_path), "%s/assets", engine->resource_path);
+    DIR* dir = opendir(assets_path);
+    if (dir) {
+        HotReloadHandler texture_handler = {
+            engine_reload_import_texture, engine_reload_apply_texture, engine_reload_discard_texture, engine
+        };
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (engine_is_texture_file(entry->d_name)) {
+                hot_reload_watch(engine->hot_reload, entry->d_name, &texture_handler);
+            }
+        }
+        closedir(dir);
+    }
+
+    if (engine->default_font) {
+        HotReloadHandler font_handler = {
+            engine_reload_import_font, engine_reload_apply_font, engine_reload_discard_font, engine
+        };
+        hot_reload_watch(engine->hot_reload, "Helvetica.ttf", &font_handler);
+    }
+}
+
 
 // Initialize engine with Metal setup
 EngineStateStruct* engine_initialize(MetalViewHandle view, float viewport_width, float viewport_height, const char* resource_path) {
     fprintf(stderr, "=== ENGINE_INITIALIZE START ===\n");
     fflush(stderr);
     
-    EngineStateStruct* engineState = (EngineStateStruct*)malloc(sizeof(EngineStateStruct));
+    // Zeroed so engine_shutdown can run from any failure path below and skip
+    // the subsystems that were never created
+    EngineStateStruct* engineState = (EngineStateStruct*)calloc(1, sizeof(EngineStateStruct));
     if (engineState) {
         engineState->state = ENGINE_STATE_INITIALIZING;
         
@@ -70,6 +215,43 @@ EngineStateStruct* engine_initialize(MetalViewHandle view, float viewport_width,
             return NULL;
         }
         
+        // Initialize job system (one worker per core, including this thread)
+        engineState->jobs = job_system_create(0);
+        
+        // Initialize physics with one body slot per world entity
+        engineState->physics = physics_world_create(engineState->world->max_entities);
+        if (!engineState->physics) {
+            fprintf(stderr, "Failed to create physics world\n");
+            engine_shutdown(engineState);
+            return NULL;
+        }
+        
+        // Initialize particle system
+        engineState->particles = particle_system_create(32, 65536);
+        if (!engineState->particles) {
+            fprintf(stderr, "Failed to create particle system\n");
+            engine_shutdown(engineState);
+            return NULL;
+        }
+        
+        // Initialize clustered lighting for the default projection
+        ClusterGridDesc cluster_desc = cluster_grid_desc_default();
+        engineState->lighting = clustered_lighting_create(&cluster_desc, 1024);
+        if (!engineState->lighting) {
+            fprintf(stderr, "Failed to create clustered lighting\n");
+            engine_shutdown(engineState);
+            return NULL;
+        }
+        
+        // Initialize sun shadow cascades with one caster per world entity
+        ShadowCascadeDesc shadow_desc = shadow_cascade_desc_default();
+        engineState->shadows = shadow_cascades_create(&shadow_desc, engineState->world->max_entities);
+        if (!engineState->shadows) {
+            fprintf(stderr, "Failed to create shadow cascades\n");
+            engine_shutdown(engineState);
+            return NULL;
+        }
+        
         
     
         engineState->viewport_width = viewport_width;
@@ -78,6 +260,17 @@ EngineStateStruct* engine_initialize(MetalViewHandle view, float viewport_width,
         
         // Store resource path
         engineState->resource_path = resource_path ? strdup(resource_path) : NULL;
+
+        // Watch the assets directory (non-critical - assets just won't reload)
+        if (resource_path) {
+            char watch_path[1024];
+            snprintf(watch_path, sizeof(watch_path), "%s/assets", resource_path);
+            HotReloadDesc reload_desc = hot_reload_desc_default(watch_path);
+            engineState->hot_reload = hot_reload_create(&reload_desc);
+            if (!engineState->hot_reload) {
+                fprintf(stderr, "Warning: Failed to start asset hot reload, continuing without it\n");
+            }
+        }
     
         // Initialize Metal engine
         engineState->metal_engine = (MetalEngineHandle)metal_engine_init();
@@ -129,13 +322,15 @@ EngineStateStruct* engine_initialize(MetalViewHandle view, float viewport_width,
         // Initialize font system
         char font_path[1024];
         snprintf(font_path, sizeof(font_path), "%s/assets/Helvetica.ttf", resource_path);
-        engineState->default_font = engine_font_create(font_path, 64, 1.0f, engineState->metal_engine);
+        engineState->default_font = engine_font_create(font_path, ENGINE_DEFAULT_FONT_SIZE, ENGINE_DEFAULT_FONT_SPACING, engineState->metal_engine);
         if (!engineState->default_font) {
              fprintf(stderr, "Failed to initialize font system (continuing without fonts)\n");
              engineState->default_font = NULL;
         } else {
              fprintf(stderr, "Font system initialized successfully\n");
         }
+
+        engine_watch_textures_and_fonts(engineState);
         
         // Set engine state to running
         engineState->state = ENGINE_STATE_RUNNING;
@@ -211,6 +406,9 @@ int engine_load_assets(EngineStateStruct* engine) {
     fprintf(stderr, "Created entity '%s' with Metal model\n", entity_get_name(entity));
     fflush(stderr);
 
+    // Re-import the sphere when it changes on disk
+    engine_watch_model(engine, "UnitSphere.fbx", metalModel);
+
     // Free the original model data (Metal now has its own copy)
     model3d_free(fbxModel);
     
@@ -247,6 +445,9 @@ void engine_resize_viewport(EngineStateStruct* engine, float width, float height
     // Update projection matrix with new aspect ratio
     float aspect = width / height;
     engine->projection_matrix = mat4_perspective(M_PI / 3.0f, aspect, 0.1f, 100.0f);
+    if (engine->lighting) {
+        clustered_lighting_set_projection(engine->lighting, M_PI / 3.0f, aspect, 0.1f, 100.0f);
+    }
     
     // Resize Metal viewport
     metal_engine_resize_viewport((MetalEngine*)engine->metal_engine, (int)width, (int)height);
@@ -265,6 +466,11 @@ void engine_update(EngineStateStruct* engineState) {
     // Engine update called silently
 
     if (engineState->state == ENGINE_STATE_RUNNING) {
+
+        // Swap in assets re-imported since the last frame, before anything uses them
+        if (engineState->hot_reload) {
+            hot_reload_apply(engineState->hot_reload);
+        }
         
         // Clear UI elements from previous frame
         // if (engineState->ui_2d) {
@@ -294,7 +500,34 @@ void engine_update(EngineStateStruct* engineState) {
                 // Entity rotation updated silently
             }
         }
-        
+
+        // Step physics at a fixed rate and write transforms back to entities
+        if (engineState->physics && engineState->world) {
+            physics_step(engineState->physics, 1.0f / 60.0f, engineState->jobs);
+            physics_sync_to_world(engineState->physics, engineState->world);
+        }
+
+        // Simulate particles after entities have moved so emitters follow them
+        if (engineState->particles) {
+            particle_system_update(engineState->particles, engineState->world, 1.0f / 60.0f, engineState->jobs);
+        }
+
+        // Assign lights to view clusters for this frame's camera
+        if (engineState->lighting) {
+            clustered_lighting_build(engineState->lighting, engineState->view_matrix, engineState->jobs);
+        }
+
+        // Fit shadow cascades to the camera and build their caster lists.
+        // The sun shines opposite to the shaders' light direction (1, 1, 1).
+        if (engineState->shadows && engineState->world) {
+            float aspect = engineState->viewport_height > 0.0f ?
+                engineState->viewport_width / engineState->viewport_height : 16.0f / 9.0f;
+            shadow_cascades_gather_world(engineState->shadows, engineState->world);
+            shadow_cascades_fit(engineState->shadows, engineState->view_matrix, M_PI / 3.0f, aspect,
+                                0.1f, 100.0f, vec3(-1.0f, -1.0f, -1.0f));
+            shadow_cascades_cull(engineState->shadows, engineState->jobs);
+        }
+
         // Add UI elements for testing - render downloaded textures and SDF
         if (engineState->ui_2d && engineState->texture_loader) {
              // Load and display our downloaded textures in a row
@@ -377,10 +610,39 @@ void engine_update(EngineStateStruct* engineState) {
     engine_2d_clear_elements(engineState->ui_2d);
 }
 
+// Rebind every entity using model when name changes under the assets directory
+int engine_watch_model(EngineStateStruct* engine, const char* name, MetalModelHandle model) {
+    if (!engine || !engine->hot_reload || !name || !model) {
+        return 0;
+    }
+    if (engine->reload_model_count >= ENGINE_MAX_RELOAD_MODELS) {
+        fprintf(stderr, "Error: Too many hot reload models (max %d)\n", ENGINE_MAX_RELOAD_MODELS);
+        return 0;
+    }
+
+    EngineReloadModel* binding = &engine->reload_models[engine->reload_model_count];
+    binding->engine = engine;
+    binding->model = model;
+    HotReloadHandler handler = {
+        engine_reload_import_model, engine_reload_apply_model, engine_reload_discard_model, binding
+    };
+    if (!hot_reload_watch(engine->hot_reload, name, &handler)) {
+        return 0;
+    }
+    engine->reload_model_count++;
+    return 1;
+}
+
 // Shutdown engine and free memory
 void engine_shutdown(EngineStateStruct* engineState) {
     if (engineState) {
         engineState->state = ENGINE_STATE_SHUTDOWN;
+
+        // Stop hot reload before the assets it swaps are destroyed
+        if (engineState->hot_reload) {
+            hot_reload_destroy(engineState->hot_reload);
+            engineState->hot_reload = NULL;
+        }
         
         // Shutdown UI 2D system
         if (engineState->ui_2d) {
@@ -400,6 +662,36 @@ void engine_shutdown(EngineStateStruct* engineState) {
              engineState->default_font = NULL;
         }
         
+        // Shutdown shadow cascades
+        if (engineState->shadows) {
+            shadow_cascades_destroy(engineState->shadows);
+            engineState->shadows = NULL;
+        }
+        
+        // Shutdown clustered lighting
+        if (engineState->lighting) {
+            clustered_lighting_destroy(engineState->lighting);
+            engineState->lighting = NULL;
+        }
+        
+        // Shutdown particle system
+        if (engineState->particles) {
+            particle_system_destroy(engineState->particles);
+            engineState->particles = NULL;
+        }
+        
+        // Shutdown physics before the world it references
+        if (engineState->physics) {
+            physics_world_destroy(engineState->physics);
+            engineState->physics = NULL;
+        }
+        
+        // Shutdown job system
+        if (engineState->jobs) {
+            job_system_destroy(engineState->jobs);
+            engineState->jobs = NULL;
+        }
+        
         // Shutdown world system
         if (engineState->world) {
             world_destroy(engineState->world);
@@ -10,12 +10,26 @@ extern "C" {
 #include "engine_2d.h"
 #include "engine_texture_loader.h"
 #include "engine_font.h"
+#include "engine_jobs.h"
+#include "engine_physics.h"
+#include "engine_particles.h"
+#include "engine_lighting.h"
+#include "engine_shadows.h"
+#include "engine_hot_reload.h"
 
 // Forward declarations for Metal types
 struct MetalEngine; // Forward declaration
 typedef struct MetalEngine* MetalEngineHandle;
 typedef void* MetalViewHandle; // Use void* for C compatibility
 
+#define ENGINE_MAX_RELOAD_MODELS 32
+
+// A model file watched for hot reload and the Metal model its entities use
+typedef struct {
+    void* engine;                   // EngineStateStruct* that owns the entities
+    MetalModelHandle model;
+} EngineReloadModel;
+
 // Engine states
 typedef enum {
     ENGINE_STATE_INITIALIZING,
@@ -37,6 +51,21 @@ typedef struct {
     // World system
     World* world;
     
+    // Worker pool shared by engine subsystems
+    JobSystemHandle jobs;
+    
+    // Rigid-body physics for world entities
+    PhysicsWorld* physics;
+    
+    // CPU particle effects (instance buffer rebuilt every frame)
+    ParticleSystem* particles;
+    
+    // Clustered light assignment (rebuilt every frame from the view matrix)
+    ClusteredLighting* lighting;
+    
+    // Sun shadow cascades and their per-cascade caster draw lists
+    ShadowCascades* shadows;
+    
     // UI 2D system
     Engine2D* ui_2d;
     
@@ -58,6 +87,11 @@ typedef struct {
     
     // Resource path for loading assets
     char* resource_path;
+    
+    // Asset hot reload over resource_path/assets; swaps happen at the start of engine_update
+    HotReloaderHandle hot_reload;
+    EngineReloadModel reload_models[ENGINE_MAX_RELOAD_MODELS];
+    uint32_t reload_model_count;
 } EngineStateStruct;
 
 // Engine initialization with Metal setup
@@ -68,6 +102,10 @@ void engine_shutdown(EngineStateStruct* engineState);
 // Metal-specific functions (now part of engine_main interface)
 int engine_load_assets(EngineStateStruct* engine);
 int engine_render_frame(EngineStateStruct* engine);
+
+// Hot reload the model file `name` (relative to resource_path/assets) into
+// every entity that uses `model`
+int engine_watch_model(EngineStateStruct* engine, const char* name, MetalModelHandle model);
 void engine_resize_viewport(EngineStateStruct* engine, float width, float height);
 
 // World management functions
@@ -0,0 +1,333 @@
+#include "engine_material.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// HASHING
+// ============================================================================
+
+// FNV-1a over the block bytes
+static uint32_t material_hash_bytes(const void* data, uint32_t size) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t material_hash_pair(uint32_t pipeline, uint32_t params) {
+    uint64_t key = ((uint64_t)pipeline << 32) | params;
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+static int material_hash_init(MaterialHash* hash, uint32_t count) {
+    uint32_t capacity = 16;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    hash->slots = (uint32_t*)malloc(capacity * sizeof(uint32_t));
+    if (!hash->slots) {
+        return 0;
+    }
+    memset(hash->slots, 0xFF, capacity * sizeof(uint32_t));
+    hash->mask = capacity - 1;
+    return 1;
+}
+
+// Spread the hash before masking so low-entropy hashes still probe well
+static uint32_t material_hash_slot(const MaterialHash* hash, uint32_t value) {
+    return (uint32_t)(((uint64_t)value * 0x9E3779B97F4A7C15ull) >> 32) & hash->mask;
+}
+
+// ============================================================================
+// STORAGE
+// ============================================================================
+
+static int material_reserve(void** data, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 1;
+    }
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    void* grown = realloc(*data, (size_t)new_capacity * element_size);
+    if (!grown) {
+        return 0;
+    }
+    *data = grown;
+    *capacity = new_capacity;
+    return 1;
+}
+
+// Double an id table once it is half full, reinserting by stored hash
+static int material_block_hash_grow(MaterialLibrary* library) {
+    if ((library->block_count + 1) * 2 <= library->block_hash.mask + 1) {
+        return 1;
+    }
+    MaterialHash grown;
+    if (!material_hash_init(&grown, (library->block_hash.mask + 1))) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < library->block_count; i++) {
+        uint32_t slot = material_hash_slot(&grown, library->blocks[i].hash);
+        while (grown.slots[slot] != MATERIAL_INVALID) {
+            slot = (slot + 1) & grown.mask;
+        }
+        grown.slots[slot] = i;
+    }
+    free(library->block_hash.slots);
+    library->block_hash = grown;
+    return 1;
+}
+
+static int material_material_hash_grow(MaterialLibrary* library) {
+    if ((library->material_count + 1) * 2 <= library->material_hash.mask + 1) {
+        return 1;
+    }
+    MaterialHash grown;
+    if (!material_hash_init(&grown, (library->material_hash.mask + 1))) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < library->material_count; i++) {
+        const Material* material = &library->materials[i];
+        uint32_t slot = material_hash_slot(&grown, material_hash_pair(material->pipeline, material->params));
+        while (grown.slots[slot] != MATERIAL_INVALID) {
+            slot = (slot + 1) & grown.mask;
+        }
+        grown.slots[slot] = i;
+    }
+    free(library->material_hash.slots);
+    library->material_hash = grown;
+    return 1;
+}
+
+// ============================================================================
+// LIBRARY
+// ============================================================================
+
+MaterialLibraryDesc material_library_desc_default(void) {
+    MaterialLibraryDesc desc;
+    desc.initial_params_bytes = 16 * 1024;
+    desc.initial_params_blocks = 256;
+    desc.initial_materials = 256;
+    desc.max_params_bytes = 0;
+    return desc;
+}
+
+MaterialLibrary* material_library_create(const MaterialLibraryDesc* desc) {
+    MaterialLibraryDesc d = desc ? *desc : material_library_desc_default();
+
+    MaterialLibrary* library = (MaterialLibrary*)calloc(1, sizeof(MaterialLibrary));
+    if (!library ||
+        !material_reserve((void**)&library->params_data, &library->params_capacity, d.initial_params_bytes, 1) ||
+        !material_reserve((void**)&library->blocks, &library->block_capacity, d.initial_params_blocks,
+                          sizeof(MaterialParamsBlock)) ||
+        !material_reserve((void**)&library->materials, &library->material_capacity, d.initial_materials,
+                          sizeof(Material)) ||
+        !material_hash_init(&library->block_hash, d.initial_params_blocks) ||
+        !material_hash_init(&library->material_hash, d.initial_materials)) {
+        fprintf(stderr, "Error: Failed to allocate memory for material library\n");
+        material_library_destroy(library);
+        return NULL;
+    }
+    library->max_params_bytes = d.max_params_bytes;
+    return library;
+}
+
+void material_library_destroy(MaterialLibrary* library) {
+    if (!library) {
+        return;
+    }
+    free(library->params_data);
+    free(library->blocks);
+    free(library->materials);
+    free(library->block_hash.slots);
+    free(library->material_hash.slots);
+    free(library);
+}
+
+// ============================================================================
+// PARAMETER BLOCKS
+// ============================================================================
+
+MaterialParamsId material_params_intern(MaterialLibrary* library, const void* data, uint32_t size) {
+    if (!library || (size > 0 && !data) || size > MATERIAL_PARAMS_MAX_SIZE) {
+        fprintf(stderr, "Error: Invalid material parameter block (%u bytes)\n", size);
+        return MATERIAL_INVALID;
+    }
+    library->intern_requests++;
+
+    uint32_t hash = material_hash_bytes(data, size);
+    uint32_t slot = material_hash_slot(&library->block_hash, hash);
+    for (;;) {
+        uint32_t id = library->block_hash.slots[slot];
+        if (id == MATERIAL_INVALID) {
+            break;
+        }
+        const MaterialParamsBlock* block = &library->blocks[id];
+        if (block->hash == hash && block->size == size &&
+            (size == 0 || memcmp(library->params_data + block->offset, data, size) == 0)) {
+            library->intern_hits++;
+            return id;
+        }
+        slot = (slot + 1) & library->block_hash.mask;
+    }
+
+    // New block: append at the next aligned offset
+    uint32_t offset = (library->params_bytes + MATERIAL_PARAMS_ALIGNMENT - 1) & ~(uint32_t)(MATERIAL_PARAMS_ALIGNMENT - 1);
+    if (library->max_params_bytes && offset + size > library->max_params_bytes) {
+        library->intern_overflows++;
+        return MATERIAL_INVALID;
+    }
+    if (!material_reserve((void**)&library->params_data, &library->params_capacity, offset + size, 1) ||
+        !material_reserve((void**)&library->blocks, &library->block_capacity, library->block_count + 1,
+                          sizeof(MaterialParamsBlock)) ||
+        !material_block_hash_grow(library)) {
+        fprintf(stderr, "Error: Failed to grow material parameter storage\n");
+        return MATERIAL_INVALID;
+    }
+
+    // Zero the alignment gap so uploads never carry stale bytes
+    memset(library->params_data + library->params_bytes, 0, offset - library->params_bytes);
+    if (size > 0) {
+        memcpy(library->params_data + offset, data, size);
+    }
+    library->params_bytes = offset + size;
+
+    MaterialParamsId id = library->block_count++;
+    library->blocks[id].offset = offset;
+    library->blocks[id].size = size;
+    library->blocks[id].hash = hash;
+
+    slot = material_hash_slot(&library->block_hash, hash);
+    while (library->block_hash.slots[slot] != MATERIAL_INVALID) {
+        slot = (slot + 1) & library->block_hash.mask;
+    }
+    library->block_hash.slots[slot] = id;
+    return id;
+}
+
+const void* material_params_data(const MaterialLibrary* library, MaterialParamsId params) {
+    if (!library || params >= library->block_count) {
+        return NULL;
+    }
+    return library->params_data + library->blocks[params].offset;
+}
+
+uint32_t material_params_size(const MaterialLibrary* library, MaterialParamsId params) {
+    return library && params < library->block_count ? library->blocks[params].size : 0;
+}
+
+uint32_t material_params_offset(const MaterialLibrary* library, MaterialParamsId params) {
+    return library && params < library->block_count ? library->blocks[params].offset : MATERIAL_INVALID;
+}
+
+// ============================================================================
+// MATERIALS
+// ============================================================================
+
+MaterialId material_intern_params(MaterialLibrary* library, uint32_t pipeline, MaterialParamsId params) {
+    if (!library || params >= library->block_count) {
+        fprintf(stderr, "Error: Invalid material parameter block id %u\n", params);
+        return MATERIAL_INVALID;
+    }
+
+    uint32_t slot = material_hash_slot(&library->material_hash, material_hash_pair(pipeline, params));
+    for (;;) {
+        uint32_t id = library->material_hash.slots[slot];
+        if (id == MATERIAL_INVALID) {
+            break;
+        }
+        if (library->materials[id].pipeline == pipeline && library->materials[id].params == params) {
+            return id;
+        }
+        slot = (slot + 1) & library->material_hash.mask;
+    }
+
+    if (!material_reserve((void**)&library->materials, &library->material_capacity, library->material_count + 1,
+                          sizeof(Material)) ||
+        !material_material_hash_grow(library)) {
+        fprintf(stderr, "Error: Failed to grow material storage\n");
+        return MATERIAL_INVALID;
+    }
+
+    MaterialId id = library->material_count++;
+    library->materials[id].pipeline = pipeline;
+    library->materials[id].params = params;
+
+    slot = material_hash_slot(&library->material_hash, material_hash_pair(pipeline, params));
+    while (library->material_hash.slots[slot] != MATERIAL_INVALID) {
+        slot = (slot + 1) & library->material_hash.mask;
+    }
+    library->material_hash.slots[slot] = id;
+    return id;
+}
+
+MaterialId material_intern(MaterialLibrary* library, uint32_t pipeline, const void* params, uint32_t size) {
+    MaterialParamsId block = material_params_intern(library, params, size);
+    if (block == MATERIAL_INVALID) {
+        return MATERIAL_INVALID;
+    }
+    return material_intern_params(library, pipeline, block);
+}
+
+const Material* material_get(const MaterialLibrary* library, MaterialId material) {
+    if (!library || material >= library->material_count) {
+        return NULL;
+    }
+    return &library->materials[material];
+}
+
+// ============================================================================
+// RENDER QUEUES
+// ============================================================================
+
+uint64_t material_sort_key(const MaterialLibrary* library, MaterialId material) {
+    const Material* m = material_get(library, material);
+    if (!m) {
+        return ~0ull; // Invalid materials sort last
+    }
+    return ((uint64_t)m->pipeline << 32) | material;
+}
+
+static int compare_material_draws(const void* a, const void* b) {
+    const MaterialDraw* da = (const MaterialDraw*)a;
+    const MaterialDraw* db = (const MaterialDraw*)b;
+    if (da->key != db->key) {
+        return da->key < db->key ? -1 : 1;
+    }
+    return (da->index > db->index) - (da->index < db->index);
+}
+
+void material_sort_draws(MaterialDraw* draws, uint32_t count) {
+    if (draws && count > 1) {
+        qsort(draws, count, sizeof(MaterialDraw), compare_material_draws);
+    }
+}
+
+int material_library_upload_range(MaterialLibrary* library, uint32_t* begin, uint32_t* end) {
+    if (!library || library->uploaded_bytes == library->params_bytes) {
+        return 0;
+    }
+    *begin = library->uploaded_bytes;
+    *end = library->params_bytes;
+    library->uploaded_bytes = library->params_bytes;
+    return 1;
+}
+
+void material_library_print(const char* name, const MaterialLibrary* library) {
+    if (!library) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    double hit_rate = library->intern_requests ? (double)library->intern_hits / (double)library->intern_requests : 0.0;
+    printf("%s: %u materials, %u parameter blocks in %u bytes\n", name, library->material_count,
+           library->block_count, library->params_bytes);
+    printf("  %llu interns, %.1f%% shared an existing block, %llu over budget\n",
+           (unsigned long long)library->intern_requests, hit_rate * 100.0,
+           (unsigned long long)library->intern_overflows);
+}
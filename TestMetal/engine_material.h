@@ -0,0 +1,133 @@
+#ifndef ENGINE_MATERIAL_H
+#define ENGINE_MATERIAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// ============================================================================
+// MATERIAL CONFIGURATION
+// ============================================================================
+
+#define MATERIAL_INVALID 0xFFFFFFFFu            // Invalid material or parameter block id
+#define MATERIAL_PARAMS_ALIGNMENT 16            // Block offsets in the parameter buffer
+#define MATERIAL_PARAMS_MAX_SIZE 4096
+
+// Pipelines the Metal backend knows; other values are free for new shaders
+typedef enum {
+    MATERIAL_PIPELINE_MESH = 0,
+    MATERIAL_PIPELINE_UI_TEXTURE,
+    MATERIAL_PIPELINE_UI_SDF,
+    MATERIAL_PIPELINE_COUNT
+} MaterialPipeline;
+
+typedef uint32_t MaterialId;
+typedef uint32_t MaterialParamsId;
+
+typedef struct {
+    uint32_t initial_params_bytes;
+    uint32_t initial_params_blocks;
+    uint32_t initial_materials;
+    uint32_t max_params_bytes;      // Parameter buffer budget, 0 for no limit
+} MaterialLibraryDesc;
+
+// ============================================================================
+// MATERIAL DATA STRUCTURES
+// ============================================================================
+
+// A pipeline plus an immutable parameter block. Both are hash-consed, so
+// equal materials have equal ids and ids can be compared instead of contents.
+typedef struct {
+    uint32_t pipeline;
+    MaterialParamsId params;
+} Material;
+
+// Where a unique parameter block lives in the library's parameter buffer
+typedef struct {
+    uint32_t offset;            // Multiple of MATERIAL_PARAMS_ALIGNMENT
+    uint32_t size;
+    uint32_t hash;
+} MaterialParamsBlock;
+
+// One draw in a render queue, sorted by material_sort_draws
+typedef struct {
+    uint64_t key;               // material_sort_key()
+    uint32_t index;             // Caller's draw index, ties keep submission order
+} MaterialDraw;
+
+// Open-addressed id tables (MATERIAL_INVALID marks an empty slot)
+typedef struct {
+    uint32_t* slots;
+    uint32_t mask;
+} MaterialHash;
+
+typedef struct {
+    // Unique parameter blocks, back to back in one append-only buffer
+    uint8_t* params_data;
+    uint32_t params_bytes;
+    uint32_t params_capacity;
+    MaterialParamsBlock* blocks;
+    uint32_t block_count;
+    uint32_t block_capacity;
+    MaterialHash block_hash;
+
+    Material* materials;
+    uint32_t material_count;
+    uint32_t material_capacity;
+    MaterialHash material_hash;
+
+    // Bytes the GPU copy already holds (see material_library_upload_range)
+    uint32_t uploaded_bytes;
+    uint32_t max_params_bytes;
+
+    // Statistics
+    uint64_t intern_requests;
+    uint64_t intern_hits;
+    uint64_t intern_overflows;  // New blocks refused by max_params_bytes
+} MaterialLibrary;
+
+// ============================================================================
+// MATERIAL FUNCTIONS
+// ============================================================================
+
+MaterialLibraryDesc material_library_desc_default(void);
+MaterialLibrary* material_library_create(const MaterialLibraryDesc* desc);
+void material_library_destroy(MaterialLibrary* library);
+
+// Return the id of a block with these bytes, adding it if none exists yet.
+// An empty block (size 0) is valid for pipelines without parameters.
+// Blocks are never evicted: once a new block would go past max_params_bytes
+// this returns MATERIAL_INVALID (quietly) and callers pass the parameters
+// per draw instead, so parameters that change every frame can't grow the
+// buffer without bound.
+MaterialParamsId material_params_intern(MaterialLibrary* library, const void* data, uint32_t size);
+const void* material_params_data(const MaterialLibrary* library, MaterialParamsId params);
+uint32_t material_params_size(const MaterialLibrary* library, MaterialParamsId params);
+uint32_t material_params_offset(const MaterialLibrary* library, MaterialParamsId params);
+
+// Intern a parameter block and then the (pipeline, block) pair
+MaterialId material_intern(MaterialLibrary* library, uint32_t pipeline, const void* params, uint32_t size);
+MaterialId material_intern_params(MaterialLibrary* library, uint32_t pipeline, MaterialParamsId params);
+const Material* material_get(const MaterialLibrary* library, MaterialId material);
+
+// Pipeline in the high word, material id in the low word: sorting groups
+// draws by pipeline first, then by material
+uint64_t material_sort_key(const MaterialLibrary* library, MaterialId material);
+
+// Sort a render queue by key, stable for equal materials
+void material_sort_draws(MaterialDraw* draws, uint32_t count);
+
+// Blocks are immutable and only ever appended, so a GPU copy needs just the
+// bytes added since the last call: [*begin, *end) of params_data. Returns 0
+// when nothing is new.
+int material_library_upload_range(MaterialLibrary* library, uint32_t* begin, uint32_t* end);
+
+void material_library_print(const char* name, const MaterialLibrary* library);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_MATERIAL_H
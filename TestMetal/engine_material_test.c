@@ -0,0 +1,394 @@
+#include "engine_material.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static uint32_t rng_state = 0x12345678u;
+
+static uint32_t rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Same layout as SDFUniforms in ShaderTypes.h
+typedef struct {
+    float fill_color[4];
+    float outline_color[4];
+    float edge_distance;
+    float outline_distance;
+    float smoothing;
+    int32_t has_outline;
+} TestSDFParams;
+
+static TestSDFParams sdf_params(float r, float g, float b, int outline) {
+    TestSDFParams params;
+    memset(&params, 0, sizeof(params));
+    params.fill_color[0] = r;
+    params.fill_color[1] = g;
+    params.fill_color[2] = b;
+    params.fill_color[3] = 1.0f;
+    params.edge_distance = 0.5f;
+    params.outline_distance = 0.4f;
+    params.smoothing = 0.1f;
+    params.has_outline = outline;
+    return params;
+}
+
+// ============================================================================
+// PARAMETER BLOCK TESTS
+// ============================================================================
+
+static void test_params(void) {
+    printf("\n--- Parameter Block Tests ---\n");
+
+    MaterialLibrary* library = material_library_create(NULL);
+    TEST_ASSERT_NOT_NULL(library, "Library created with default desc");
+    if (!library) return;
+
+    TestSDFParams red = sdf_params(1.0f, 0.0f, 0.0f, 0);
+    TestSDFParams red_again = sdf_params(1.0f, 0.0f, 0.0f, 0);
+    TestSDFParams blue = sdf_params(0.0f, 0.0f, 1.0f, 1);
+
+    MaterialParamsId a = material_params_intern(library, &red, sizeof(red));
+    uint32_t bytes_after_first = library->params_bytes;
+    MaterialParamsId b = material_params_intern(library, &red_again, sizeof(red_again));
+    MaterialParamsId c = material_params_intern(library, &blue, sizeof(blue));
+
+    TEST_ASSERT(a != MATERIAL_INVALID && c != MATERIAL_INVALID, "Blocks interned");
+    TEST_ASSERT_EQUAL(a, b, "Identical bytes share one block id");
+    TEST_ASSERT_EQUAL(bytes_after_first, material_params_offset(library, c), "Duplicate added no storage");
+    TEST_ASSERT(a != c, "Different bytes get a new block id");
+    TEST_ASSERT(memcmp(material_params_data(library, c), &blue, sizeof(blue)) == 0 &&
+                material_params_size(library, c) == sizeof(blue), "Block data and size round-trip");
+
+    // Odd sizes still start every block on the alignment
+    uint8_t odd[5] = {1, 2, 3, 4, 5};
+    MaterialParamsId d = material_params_intern(library, odd, sizeof(odd));
+    MaterialParamsId e = material_params_intern(library, &red, 12);
+    TEST_ASSERT(material_params_offset(library, d) % MATERIAL_PARAMS_ALIGNMENT == 0 &&
+                material_params_offset(library, e) % MATERIAL_PARAMS_ALIGNMENT == 0, "Offsets are aligned");
+    TEST_ASSERT(e != a, "A prefix of a block is a different block");
+
+    MaterialParamsId empty = material_params_intern(library, NULL, 0);
+    TEST_ASSERT(empty != MATERIAL_INVALID && material_params_intern(library, NULL, 0) == empty,
+                "Empty block is valid and unique");
+
+    TEST_ASSERT_EQUAL(MATERIAL_INVALID, material_params_intern(library, NULL, 16), "NULL data is rejected");
+    static uint8_t big[MATERIAL_PARAMS_MAX_SIZE + 1];
+    TEST_ASSERT_EQUAL(MATERIAL_INVALID, material_params_intern(library, big, sizeof(big)), "Oversized block is rejected");
+    TEST_ASSERT(material_params_data(library, 999) == NULL, "Unknown block id has no data");
+
+    material_library_destroy(library);
+}
+
+// ============================================================================
+// MATERIAL TESTS
+// ============================================================================
+
+static void test_materials(void) {
+    printf("\n--- Material Tests ---\n");
+
+    MaterialLibrary* library = material_library_create(NULL);
+    TEST_ASSERT_NOT_NULL(library, "Library created");
+    if (!library) return;
+
+    TestSDFParams green = sdf_params(0.0f, 1.0f, 0.0f, 0);
+    MaterialId sdf = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &green, sizeof(green));
+    MaterialId sdf_again = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &green, sizeof(green));
+    MaterialId other_pipeline = material_intern(library, MATERIAL_PIPELINE_MESH, &green, sizeof(green));
+    MaterialId texture = material_intern(library, MATERIAL_PIPELINE_UI_TEXTURE, NULL, 0);
+
+    TEST_ASSERT(sdf != MATERIAL_INVALID && texture != MATERIAL_INVALID, "Materials interned");
+    TEST_ASSERT_EQUAL(sdf, sdf_again, "Same pipeline and parameters give the same material");
+    TEST_ASSERT(other_pipeline != sdf, "Another pipeline is another material");
+    TEST_ASSERT_EQUAL(material_get(library, sdf)->params, material_get(library, other_pipeline)->params,
+                      "Materials on different pipelines share the parameter block");
+    TEST_ASSERT_EQUAL(2u, library->block_count, "Two blocks stored: the SDF parameters and the empty one");
+    TEST_ASSERT_EQUAL((uint32_t)MATERIAL_PIPELINE_UI_SDF, material_get(library, sdf)->pipeline, "Pipeline stored");
+    TEST_ASSERT(material_get(library, 1234) == NULL, "Unknown material id is NULL");
+    TEST_ASSERT_EQUAL(MATERIAL_INVALID, material_intern_params(library, 0, 1234), "Unknown block id is rejected");
+
+    material_library_destroy(library);
+}
+
+static void test_sorting(void) {
+    printf("\n--- Render Queue Tests ---\n");
+
+    MaterialLibrary* library = material_library_create(NULL);
+    TEST_ASSERT_NOT_NULL(library, "Library created");
+    if (!library) return;
+
+    // Submission order interleaves three materials across two pipelines
+    TestSDFParams a = sdf_params(1.0f, 0.0f, 0.0f, 0);
+    TestSDFParams b = sdf_params(0.0f, 1.0f, 0.0f, 0);
+    MaterialId sdf_a = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &a, sizeof(a));
+    MaterialId sdf_b = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &b, sizeof(b));
+    MaterialId mesh = material_intern(library, MATERIAL_PIPELINE_MESH, &a, sizeof(a));
+    MaterialId order[8] = {sdf_b, sdf_a, mesh, sdf_b, sdf_a, mesh, sdf_a, sdf_b};
+
+    MaterialDraw draws[8];
+    for (uint32_t i = 0; i < 8; i++) {
+        draws[i].key = material_sort_key(library, order[i]);
+        draws[i].index = i;
+    }
+    material_sort_draws(draws, 8);
+
+    uint32_t changes = 0;
+    int pipeline_first = 1;
+    int stable = 1;
+    for (uint32_t i = 1; i < 8; i++) {
+        if (draws[i].key != draws[i - 1].key) {
+            changes++;
+        } else if (draws[i].index < draws[i - 1].index) {
+            stable = 0;
+        }
+        if ((draws[i].key >> 32) < (draws[i - 1].key >> 32)) {
+            pipeline_first = 0;
+        }
+    }
+    TEST_ASSERT_EQUAL(2u, changes, "Sorted queue has one batch per material");
+    TEST_ASSERT(pipeline_first && order[draws[0].index] == mesh, "Batches are ordered by pipeline first");
+    TEST_ASSERT(stable, "Equal materials keep submission order");
+    TEST_ASSERT_EQUAL(~0ull, material_sort_key(library, MATERIAL_INVALID), "Invalid materials sort last");
+
+    material_library_destroy(library);
+}
+
+static void test_upload(void) {
+    printf("\n--- Upload Tests ---\n");
+
+    MaterialLibrary* library = material_library_create(NULL);
+    TEST_ASSERT_NOT_NULL(library, "Library created");
+    if (!library) return;
+
+    uint32_t begin = 0, end = 0;
+    TEST_ASSERT(!material_library_upload_range(library, &begin, &end), "Nothing to upload when empty");
+
+    TestSDFParams a = sdf_params(1.0f, 1.0f, 0.0f, 0);
+    TestSDFParams b = sdf_params(1.0f, 0.0f, 1.0f, 1);
+    material_intern(library, MATERIAL_PIPELINE_UI_SDF, &a, sizeof(a));
+    TEST_ASSERT(material_library_upload_range(library, &begin, &end) && begin == 0 && end == sizeof(a),
+                "First upload covers the first block");
+
+    material_intern(library, MATERIAL_PIPELINE_UI_SDF, &a, sizeof(a));
+    TEST_ASSERT(!material_library_upload_range(library, &begin, &end), "Re-interned block needs no upload");
+
+    MaterialId mb = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &b, sizeof(b));
+    uint32_t offset = material_params_offset(library, material_get(library, mb)->params);
+    TEST_ASSERT(material_library_upload_range(library, &begin, &end) && begin == sizeof(a) &&
+                end == offset + sizeof(b), "Later upload covers only the new block");
+
+    material_library_destroy(library);
+}
+
+static void test_budget(void) {
+    printf("\n--- Budget Tests ---\n");
+
+    MaterialLibraryDesc desc = material_library_desc_default();
+    desc.max_params_bytes = 1024;
+    MaterialLibrary* library = material_library_create(&desc);
+    TEST_ASSERT_NOT_NULL(library, "Budgeted library created");
+    if (!library) return;
+
+    // One fixed style plus one whose colour animates every frame
+    TestSDFParams fixed = sdf_params(1.0f, 1.0f, 1.0f, 0);
+    MaterialId fixed_id = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &fixed, sizeof(fixed));
+    int fixed_stable = 1;
+    uint32_t interned = 0, refused = 0, uploaded = 0, begin, end;
+    for (int frame = 0; frame < 600; frame++) {
+        TestSDFParams pulse = sdf_params((float)frame / 600.0f, 0.0f, 0.0f, 1);
+        MaterialId id = material_intern(library, MATERIAL_PIPELINE_UI_SDF, &pulse, sizeof(pulse));
+        if (id == MATERIAL_INVALID) {
+            refused++;
+        } else {
+            interned++;
+        }
+        fixed_stable &= material_intern(library, MATERIAL_PIPELINE_UI_SDF, &fixed, sizeof(fixed)) == fixed_id;
+        if (material_library_upload_range(library, &begin, &end)) {
+            uploaded += end - begin;
+        }
+    }
+
+    TEST_ASSERT(library->params_bytes <= desc.max_params_bytes, "Per-frame styles stay within the budget");
+    TEST_ASSERT(uploaded <= desc.max_params_bytes, "Uploads stay within the budget");
+    TEST_ASSERT(interned > 0 && refused > 0 && interned + refused == 600,
+                "Styles past the budget are refused for per-draw parameters");
+    TEST_ASSERT_EQUAL((uint64_t)refused, library->intern_overflows, "Refused styles are counted");
+    TEST_ASSERT(fixed_stable, "Styles interned before the budget ran out keep their id");
+
+    material_library_destroy(library);
+}
+
+// ============================================================================
+// STRESS AND PERFORMANCE TESTS
+// ============================================================================
+
+static void test_stress(void) {
+    printf("\n--- Stress Tests ---\n");
+
+    MaterialLibraryDesc desc = material_library_desc_default();
+    desc.initial_params_bytes = 64;
+    desc.initial_params_blocks = 1;
+    desc.initial_materials = 1;
+    MaterialLibrary* library = material_library_create(&desc);
+    TEST_ASSERT_NOT_NULL(library, "Library created with tiny initial capacity");
+    if (!library) return;
+
+    // 5000 distinct blocks of varying size, each interned many times
+    enum { UNIQUE = 5000, ROUNDS = 100000 };
+    static uint32_t blocks[UNIQUE][9];
+    static uint32_t sizes[UNIQUE];
+    static MaterialId first[UNIQUE];
+    for (uint32_t i = 0; i < UNIQUE; i++) {
+        sizes[i] = 4 * (1 + i % 9);
+        for (uint32_t w = 0; w < 9; w++) {
+            blocks[i][w] = i * 9 + w;
+        }
+        first[i] = MATERIAL_INVALID;
+    }
+
+    int consistent = 1;
+    for (uint32_t r = 0; r < ROUNDS; r++) {
+        uint32_t i = rng_next() % UNIQUE;
+        uint32_t pipeline = i % 2;
+        MaterialId id = material_intern(library, pipeline, blocks[i], sizes[i]);
+        if (first[i] == MATERIAL_INVALID) {
+            first[i] = id;
+        } else if (first[i] != id) {
+            consistent = 0;
+        }
+    }
+
+    uint32_t seen = 0;
+    int data_ok = 1;
+    for (uint32_t i = 0; i < UNIQUE; i++) {
+        if (first[i] == MATERIAL_INVALID) continue;
+        seen++;
+        const Material* m = material_get(library, first[i]);
+        if (!m || m->pipeline != i % 2 || memcmp(material_params_data(library, m->params), blocks[i], sizes[i]) != 0) {
+            data_ok = 0;
+        }
+    }
+    TEST_ASSERT(consistent, "Repeated interns return the first id");
+    TEST_ASSERT_EQUAL(seen, library->block_count, "One block per distinct content");
+    TEST_ASSERT_EQUAL(seen, library->material_count, "One material per distinct (pipeline, block)");
+    TEST_ASSERT(data_ok, "Every material resolves to its own bytes after growth");
+
+    material_library_print("Stress library", library);
+    material_library_destroy(library);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    MaterialLibrary* library = material_library_create(NULL);
+    TEST_ASSERT_NOT_NULL(library, "Library created");
+    if (!library) return;
+
+    // 10k SDF glyphs per frame drawn in 16 text styles
+    enum { ELEMENTS = 10000, STYLES = 16, FRAMES = 60 };
+    static TestSDFParams styles[STYLES];
+    for (uint32_t s = 0; s < STYLES; s++) {
+        styles[s] = sdf_params((float)(s & 3) / 3.0f, (float)(s >> 2) / 3.0f, 0.5f, (int)(s & 1));
+    }
+
+    static MaterialId element_materials[ELEMENTS];
+    static MaterialDraw draws[ELEMENTS];
+    uint64_t uploaded = 0;
+    double start = now_ms();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        for (uint32_t i = 0; i < ELEMENTS; i++) {
+            const TestSDFParams* params = &styles[(i * 7 + frame) % STYLES];
+            element_materials[i] = material_intern(library, MATERIAL_PIPELINE_UI_SDF, params, sizeof(*params));
+        }
+        uint32_t begin, end;
+        if (material_library_upload_range(library, &begin, &end)) {
+            uploaded += end - begin;
+        }
+    }
+    double intern_ms = (now_ms() - start) / FRAMES;
+
+    start = now_ms();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        for (uint32_t i = 0; i < ELEMENTS; i++) {
+            draws[i].key = material_sort_key(library, element_materials[i]);
+            draws[i].index = i;
+        }
+        material_sort_draws(draws, ELEMENTS);
+    }
+    double sort_ms = (now_ms() - start) / FRAMES;
+
+    uint32_t batches = 1;
+    for (uint32_t i = 1; i < ELEMENTS; i++) {
+        batches += draws[i].key != draws[i - 1].key;
+    }
+
+    uint64_t per_draw_bytes = (uint64_t)ELEMENTS * sizeof(TestSDFParams) * FRAMES;
+    printf("  Interning %d elements: %.3f ms/frame, sorting: %.3f ms/frame\n", ELEMENTS, intern_ms, sort_ms);
+    printf("  Parameter bytes over %d frames: %llu per-draw copies vs %llu uploaded once\n", FRAMES,
+           (unsigned long long)per_draw_bytes, (unsigned long long)uploaded);
+    printf("  %u batches after sorting\n", batches);
+
+    TEST_ASSERT_EQUAL((uint32_t)STYLES, library->block_count, "One block per style");
+    TEST_ASSERT_EQUAL((uint32_t)STYLES, batches, "Sorted queue has one batch per style");
+    TEST_ASSERT(uploaded <= STYLES * (sizeof(TestSDFParams) + MATERIAL_PARAMS_ALIGNMENT), "Each block uploaded once");
+
+    material_library_print("SDF library", library);
+    material_library_destroy(library);
+}
+
+int main(void) {
+    printf("Starting Material Library Unit Tests\n");
+    printf("====================================\n");
+
+    test_params();
+    test_materials();
+    test_sorting();
+    test_upload();
+    test_budget();
+    test_stress();
+    test_performance();
+
+    printf("\n====================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -2,6 +2,29 @@
 #include <stdio.h>
 #include <math.h>
 
+// ============================================================================
+// AFFINE TRANSFORM KERNELS
+// ============================================================================
+
+// Instance records and shader-side float3x4 rely on the packed layout
+typedef char mat34_size_check[(sizeof(mat34_t) == 12 * sizeof(float)) ? 1 : -1];
+
+void mat34_compose_hierarchy(const mat34_t* RESTRICT local, const int32_t* RESTRICT parents, uint32_t count,
+                             mat34_t* RESTRICT world) {
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t parent = parents[i];
+        world[i] = parent < 0 ? local[i] : mat34_mul(local[i], world[parent]);
+    }
+}
+
+void mat34_pack(const mat34_t* RESTRICT transforms, uint32_t count, void* RESTRICT records, size_t stride) {
+    uint8_t* out = (uint8_t*)records;
+    for (uint32_t i = 0; i < count; i++) {
+        memcpy(out, &transforms[i], sizeof(mat34_t));
+        out += stride;
+    }
+}
+
 // ============================================================================
 // DEBUG/PRINTING FUNCTIONS IMPLEMENTATION
 // ============================================================================
@@ -33,6 +56,13 @@ void mat4_print(const char* name, mat4_t m) {
     printf("  [%.6f, %.6f, %.6f, %.6f]\n", m.x.w, m.y.w, m.z.w, m.w.w);
 }
 
+void mat34_print(const char* name, mat34_t m) {
+    printf("%s:\n", name);
+    printf("  [%.6f, %.6f, %.6f, %.6f]\n", m.x.x, m.x.y, m.x.z, m.x.w);
+    printf("  [%.6f, %.6f, %.6f, %.6f]\n", m.y.x, m.y.y, m.y.z, m.y.w);
+    printf("  [%.6f, %.6f, %.6f, %.6f]\n", m.z.x, m.z.y, m.z.z, m.z.w);
+}
+
 void quat_print(const char* name, quat_t q) {
     printf("%s: [%.6f, %.6f, %.6f, %.6f] (w=%.6f)\n", name, q.x, q.y, q.z, q.w, q.w);
 }
@@ -7,6 +7,7 @@ extern "C" {
 
 #include <math.h>
 #include <string.h>
+#include <stdint.h>
 
 // ============================================================================
 // COMPILER-SPECIFIC VECTOR EXTENSIONS
@@ -383,9 +384,45 @@ FORCE_INLINE mat3_t mat3_inverse(mat3_t m) {
 
 // Matrix inverse (4x4)
 FORCE_INLINE mat4_t mat4_inverse(mat4_t m) {
-    // For now, return identity - this is a complex operation
-    // In a real implementation, you would implement proper 4x4 matrix inversion
-    return mat4_identity();
+    // Cofactor expansion using 2x2 sub-determinants of the top and bottom row pairs
+    float s0 = m.x.x * m.y.y - m.y.x * m.x.y;
+    float s1 = m.x.x * m.y.z - m.y.x * m.x.z;
+    float s2 = m.x.x * m.y.w - m.y.x * m.x.w;
+    float s3 = m.x.y * m.y.z - m.y.y * m.x.z;
+    float s4 = m.x.y * m.y.w - m.y.y * m.x.w;
+    float s5 = m.x.z * m.y.w - m.y.z * m.x.w;
+
+    float c5 = m.z.z * m.w.w - m.w.z * m.z.w;
+    float c4 = m.z.y * m.w.w - m.w.y * m.z.w;
+    float c3 = m.z.y * m.w.z - m.w.y * m.z.z;
+    float c2 = m.z.x * m.w.w - m.w.x * m.z.w;
+    float c1 = m.z.x * m.w.z - m.w.x * m.z.z;
+    float c0 = m.z.x * m.w.y - m.w.x * m.z.y;
+
+    float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (fabsf(det) < 1e-12f) {
+        return mat4_identity(); // Return identity if not invertible
+    }
+    float inv_det = 1.0f / det;
+
+    mat4_t r;
+    r.x = vec4(( m.y.y * c5 - m.y.z * c4 + m.y.w * c3) * inv_det,
+               (-m.x.y * c5 + m.x.z * c4 - m.x.w * c3) * inv_det,
+               ( m.w.y * s5 - m.w.z * s4 + m.w.w * s3) * inv_det,
+               (-m.z.y * s5 + m.z.z * s4 - m.z.w * s3) * inv_det);
+    r.y = vec4((-m.y.x * c5 + m.y.z * c2 - m.y.w * c1) * inv_det,
+               ( m.x.x * c5 - m.x.z * c2 + m.x.w * c1) * inv_det,
+               (-m.w.x * s5 + m.w.z * s2 - m.w.w * s1) * inv_det,
+               ( m.z.x * s5 - m.z.z * s2 + m.z.w * s1) * inv_det);
+    r.z = vec4(( m.y.x * c4 - m.y.y * c2 + m.y.w * c0) * inv_det,
+               (-m.x.x * c4 + m.x.y * c2 - m.x.w * c0) * inv_det,
+               ( m.w.x * s4 - m.w.y * s2 + m.w.w * s0) * inv_det,
+               (-m.z.x * s4 + m.z.y * s2 - m.z.w * s0) * inv_det);
+    r.w = vec4((-m.y.x * c3 + m.y.y * c1 - m.y.z * c0) * inv_det,
+               ( m.x.x * c3 - m.x.y * c1 + m.x.z * c0) * inv_det,
+               (-m.w.x * s3 + m.w.y * s1 - m.w.z * s0) * inv_det,
+               ( m.z.x * s3 - m.z.y * s1 + m.z.z * s0) * inv_det);
+    return r;
 }
 
 // ============================================================================
@@ -480,6 +517,54 @@ FORCE_INLINE mat4_t mat4_ortho(float left, float right, float bottom, float top,
     return m;
 }
 
+// ============================================================================
+// FRUSTUM
+// ============================================================================
+
+// Six clip planes (left, right, bottom, top, near, far) as (normal, d);
+// a point p is inside a plane when dot(normal, p) + d >= 0
+typedef struct {
+    vec4_t planes[6];
+} frustum_t;
+
+// Planes of a row-vector view-projection matrix (clip = p * M, -w <= xyz <= w)
+FORCE_INLINE frustum_t frustum_from_matrix(mat4_t m) {
+    vec4_t c0 = vec4(m.x.x, m.y.x, m.z.x, m.w.x);
+    vec4_t c1 = vec4(m.x.y, m.y.y, m.z.y, m.w.y);
+    vec4_t c2 = vec4(m.x.z, m.y.z, m.z.z, m.w.z);
+    vec4_t c3 = vec4(m.x.w, m.y.w, m.z.w, m.w.w);
+    frustum_t f;
+    f.planes[0] = vec4_add(c3, c0);
+    f.planes[1] = vec4_sub(c3, c0);
+    f.planes[2] = vec4_add(c3, c1);
+    f.planes[3] = vec4_sub(c3, c1);
+    f.planes[4] = vec4_add(c3, c2);
+    f.planes[5] = vec4_sub(c3, c2);
+    for (int i = 0; i < 6; i++) {
+        vec4_t p = f.planes[i];
+        float len = sqrtf(p.x * p.x + p.y * p.y + p.z * p.z);
+        if (len > 0.0f) {
+            f.planes[i] = vec4_scale(p, 1.0f / len);
+        }
+    }
+    return f;
+}
+
+// Box vs frustum: 0 when the box is fully outside one plane, 1 otherwise
+// (conservative near frustum corners)
+FORCE_INLINE int frustum_test_aabb(const frustum_t* f, vec3_t min, vec3_t max) {
+    for (int i = 0; i < 6; i++) {
+        vec4_t p = f->planes[i];
+        float x = p.x >= 0.0f ? max.x : min.x;
+        float y = p.y >= 0.0f ? max.y : min.y;
+        float z = p.z >= 0.0f ? max.z : min.z;
+        if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 // ============================================================================
 // QUATERNION OPERATIONS
 // ============================================================================
@@ -631,6 +716,28 @@ FORCE_INLINE mat4_t quat_to_mat4(quat_t q) {
     return m;
 }
 
+// Rotation of an unscaled matrix as a quaternion (inverse of quat_to_mat4)
+FORCE_INLINE quat_t quat_from_mat4(mat4_t m) {
+    // quat_to_mat4 stores R's columns in rows x/y/z, so R[i][j] = row j, component i
+    float r00 = m.x.x, r11 = m.y.y, r22 = m.z.z;
+    float trace = r00 + r11 + r22;
+    quat_t q;
+    if (trace > 0.0f) {
+        float s = sqrtf(trace + 1.0f) * 2.0f;
+        q = quat((m.y.z - m.z.y) / s, (m.z.x - m.x.z) / s, (m.x.y - m.y.x) / s, 0.25f * s);
+    } else if (r00 > r11 && r00 > r22) {
+        float s = sqrtf(1.0f + r00 - r11 - r22) * 2.0f;
+        q = quat(0.25f * s, (m.y.x + m.x.y) / s, (m.z.x + m.x.z) / s, (m.y.z - m.z.y) / s);
+    } else if (r11 > r22) {
+        float s = sqrtf(1.0f + r11 - r00 - r22) * 2.0f;
+        q = quat((m.y.x + m.x.y) / s, 0.25f * s, (m.z.y + m.y.z) / s, (m.z.x - m.x.z) / s);
+    } else {
+        float s = sqrtf(1.0f + r22 - r00 - r11) * 2.0f;
+        q = quat((m.z.x + m.x.z) / s, (m.z.y + m.y.z) / s, 0.25f * s, (m.x.y - m.y.x) / s);
+    }
+    return quat_normalize(q);
+}
+
 // Spherical linear interpolation between two quaternions
 FORCE_INLINE quat_t quat_slerp(quat_t a, quat_t b, float t) {
     float dot = quat_dot(a, b);
@@ -668,6 +775,296 @@ FORCE_INLINE int quat_equal(quat_t a, quat_t b) {
            (fabsf(diff.w) < epsilon);
 }
 
+// ============================================================================
+// SIMD LANE TYPES (SoA KERNELS)
+// ============================================================================
+
+// Four-wide float/int lanes via GCC/Clang vector extensions. These lower to
+// SSE on x86 and NEON on Apple Silicon, and are used by structure-of-arrays
+// kernels that process four elements per iteration.
+typedef float simd4f_t __attribute__((vector_size(16)));
+typedef int32_t simd4i_t __attribute__((vector_size(16)));
+
+// Unaligned load/store (SoA arrays are only guaranteed float alignment)
+FORCE_INLINE simd4f_t simd4f_load(const float* RESTRICT p) {
+    simd4f_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+FORCE_INLINE void simd4f_store(float* RESTRICT p, simd4f_t v) {
+    memcpy(p, &v, sizeof(v));
+}
+
+FORCE_INLINE simd4f_t simd4f_splat(float s) {
+    return (simd4f_t){s, s, s, s};
+}
+
+// Lane select: mask lanes are all-ones (from a vector comparison) or zero
+FORCE_INLINE simd4f_t simd4f_select(simd4i_t mask, simd4f_t a, simd4f_t b) {
+    return (simd4f_t)(((simd4i_t)a & mask) | ((simd4i_t)b & ~mask));
+}
+
+FORCE_INLINE simd4f_t simd4f_min(simd4f_t a, simd4f_t b) {
+    return simd4f_select(a < b, a, b);
+}
+
+FORCE_INLINE simd4f_t simd4f_max(simd4f_t a, simd4f_t b) {
+    return simd4f_select(a > b, a, b);
+}
+
+FORCE_INLINE simd4f_t simd4f_sqrt(simd4f_t v) {
+    return (simd4f_t){sqrtf(v[0]), sqrtf(v[1]), sqrtf(v[2]), sqrtf(v[3])};
+}
+
+// Lane-wise floor (valid for |v| < 2^31)
+FORCE_INLINE simd4f_t simd4f_floor(simd4f_t v) {
+    simd4f_t t = __builtin_convertvector(__builtin_convertvector(v, simd4i_t), simd4f_t);
+    return simd4f_select(t > v, t - simd4f_splat(1.0f), t);
+}
+
+// Fast sine: range reduction to [-pi/2, pi/2] plus a 9th-order Taylor
+// polynomial (max error ~4e-6)
+FORCE_INLINE simd4f_t simd4f_sin(simd4f_t v) {
+    const simd4f_t two_pi = simd4f_splat(6.28318530718f);
+    const simd4f_t pi = simd4f_splat(3.14159265359f);
+    const simd4f_t half_pi = simd4f_splat(1.57079632679f);
+    simd4f_t k = simd4f_floor(v * simd4f_splat(0.159154943092f) + simd4f_splat(0.5f));
+    simd4f_t x = v - k * two_pi;
+    x = simd4f_select(x > half_pi, pi - x, x);
+    x = simd4f_select(x < -half_pi, -pi - x, x);
+    simd4f_t x2 = x * x;
+    simd4f_t p = simd4f_splat(1.0f / 362880.0f);
+    p = p * x2 - simd4f_splat(1.0f / 5040.0f);
+    p = p * x2 + simd4f_splat(1.0f / 120.0f);
+    p = p * x2 - simd4f_splat(1.0f / 6.0f);
+    return x + x * x2 * p;
+}
+
+FORCE_INLINE simd4f_t simd4f_cos(simd4f_t v) {
+    return simd4f_sin(v + simd4f_splat(1.57079632679f));
+}
+
+// Four quaternions in SoA form (one lane per quaternion)
+typedef struct {
+    simd4f_t x, y, z, w;
+} quat4_t;
+
+FORCE_INLINE quat4_t quat4_load(const float* x, const float* y, const float* z, const float* w) {
+    quat4_t q;
+    q.x = simd4f_load(x);
+    q.y = simd4f_load(y);
+    q.z = simd4f_load(z);
+    q.w = simd4f_load(w);
+    return q;
+}
+
+FORCE_INLINE void quat4_store(quat4_t q, float* x, float* y, float* z, float* w) {
+    simd4f_store(x, q.x);
+    simd4f_store(y, q.y);
+    simd4f_store(z, q.z);
+    simd4f_store(w, q.w);
+}
+
+// Lane-wise Hamilton product (same convention as quat_mul)
+FORCE_INLINE quat4_t quat4_mul(quat4_t a, quat4_t b) {
+    quat4_t r;
+    r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    r.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+    r.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+    r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+    return r;
+}
+
+// Lane-wise normalization (same convention as quat_normalize: zero -> identity)
+FORCE_INLINE quat4_t quat4_normalize(quat4_t q) {
+    simd4f_t len_sq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+    simd4i_t valid = len_sq > simd4f_splat(0.0f);
+    simd4f_t inv_len = simd4f_splat(1.0f) / simd4f_sqrt(simd4f_select(valid, len_sq, simd4f_splat(1.0f)));
+    quat4_t r;
+    r.x = simd4f_select(valid, q.x * inv_len, simd4f_splat(0.0f));
+    r.y = simd4f_select(valid, q.y * inv_len, simd4f_splat(0.0f));
+    r.z = simd4f_select(valid, q.z * inv_len, simd4f_splat(0.0f));
+    r.w = simd4f_select(valid, q.w * inv_len, simd4f_splat(1.0f));
+    return r;
+}
+
+// Rotate a vector by a unit quaternion
+FORCE_INLINE vec3_t quat_rotate_vec3(quat_t q, vec3_t v) {
+    vec3_t u = vec3(q.x, q.y, q.z);
+    vec3_t t = vec3_scale(vec3_cross(u, v), 2.0f);
+    return vec3_add(vec3_add(v, vec3_scale(t, q.w)), vec3_cross(u, t));
+}
+
+// ============================================================================
+// AFFINE TRANSFORMS (3x4)
+// ============================================================================
+
+// Affine transform without the constant (0, 0, 0, 1) of a mat4_t. Each row is
+// one output axis as (linear part, translation), so a point maps to
+// dot(row, (p, 1)). 48 bytes, and the same memory as a Metal float3x4
+// applied as float4(p, 1) * m.
+typedef struct {
+    vec4_t x, y, z;
+} mat34_t VECTOR_ALIGN;
+
+FORCE_INLINE simd4f_t simd4f_from_vec4(vec4_t v) {
+    return (simd4f_t){v.x, v.y, v.z, v.w};
+}
+
+FORCE_INLINE vec4_t simd4f_to_vec4(simd4f_t v) {
+    return (vec4_t){v[0], v[1], v[2], v[3]};
+}
+
+FORCE_INLINE mat34_t mat34_identity(void) {
+    mat34_t m;
+    m.x = vec4_unit_x();
+    m.y = vec4_unit_y();
+    m.z = vec4_unit_z();
+    return m;
+}
+
+// Affine part of a row-vector mat4_t (p' = p * M); the last column is dropped
+FORCE_INLINE mat34_t mat34_from_mat4(mat4_t m) {
+    mat34_t r;
+    r.x = vec4(m.x.x, m.y.x, m.z.x, m.w.x);
+    r.y = vec4(m.x.y, m.y.y, m.z.y, m.w.y);
+    r.z = vec4(m.x.z, m.y.z, m.z.z, m.w.z);
+    return r;
+}
+
+FORCE_INLINE mat4_t mat34_to_mat4(mat34_t m) {
+    mat4_t r;
+    r.x = vec4(m.x.x, m.y.x, m.z.x, 0.0f);
+    r.y = vec4(m.x.y, m.y.y, m.z.y, 0.0f);
+    r.z = vec4(m.x.z, m.y.z, m.z.z, 0.0f);
+    r.w = vec4(m.x.w, m.y.w, m.z.w, 1.0f);
+    return r;
+}
+
+// One row of b applied to the rows of a
+FORCE_INLINE vec4_t mat34_combine_row(vec4_t row, simd4f_t ax, simd4f_t ay, simd4f_t az) {
+    simd4f_t r = simd4f_splat(row.x) * ax + simd4f_splat(row.y) * ay + simd4f_splat(row.z) * az;
+    r[3] += row.w;
+    return simd4f_to_vec4(r);
+}
+
+// Composition in mat4_mul_mat4 order: a is applied first, then b
+FORCE_INLINE mat34_t mat34_mul(mat34_t a, mat34_t b) {
+    simd4f_t ax = simd4f_from_vec4(a.x);
+    simd4f_t ay = simd4f_from_vec4(a.y);
+    simd4f_t az = simd4f_from_vec4(a.z);
+    mat34_t r;
+    r.x = mat34_combine_row(b.x, ax, ay, az);
+    r.y = mat34_combine_row(b.y, ax, ay, az);
+    r.z = mat34_combine_row(b.z, ax, ay, az);
+    return r;
+}
+
+// Inverse from the cofactors of the linear part (identity if singular)
+FORCE_INLINE mat34_t mat34_inverse(mat34_t m) {
+    vec3_t c0 = vec3(m.x.x, m.y.x, m.z.x);
+    vec3_t c1 = vec3(m.x.y, m.y.y, m.z.y);
+    vec3_t c2 = vec3(m.x.z, m.y.z, m.z.z);
+    vec3_t r0 = vec3_cross(c1, c2);
+    vec3_t r1 = vec3_cross(c2, c0);
+    vec3_t r2 = vec3_cross(c0, c1);
+    float det = vec3_dot(c0, r0);
+    if (fabsf(det) < 1e-12f) {
+        return mat34_identity(); // Return identity if not invertible
+    }
+
+    simd4f_t inv_det = simd4f_splat(1.0f / det);
+    simd4f_t x = (simd4f_t){r0.x, r0.y, r0.z, 0.0f} * inv_det;
+    simd4f_t y = (simd4f_t){r1.x, r1.y, r1.z, 0.0f} * inv_det;
+    simd4f_t z = (simd4f_t){r2.x, r2.y, r2.z, 0.0f} * inv_det;
+    simd4f_t t = (simd4f_t){m.x.w, m.y.w, m.z.w, 0.0f};
+    simd4f_t tx = x * t, ty = y * t, tz = z * t;
+    x[3] = -(tx[0] + tx[1] + tx[2]);
+    y[3] = -(ty[0] + ty[1] + ty[2]);
+    z[3] = -(tz[0] + tz[1] + tz[2]);
+
+    mat34_t r;
+    r.x = simd4f_to_vec4(x);
+    r.y = simd4f_to_vec4(y);
+    r.z = simd4f_to_vec4(z);
+    return r;
+}
+
+FORCE_INLINE vec3_t mat34_transform_point(mat34_t m, vec3_t p) {
+    return vec3(m.x.x * p.x + m.x.y * p.y + m.x.z * p.z + m.x.w,
+                m.y.x * p.x + m.y.y * p.y + m.y.z * p.z + m.y.w,
+                m.z.x * p.x + m.z.y * p.y + m.z.z * p.z + m.z.w);
+}
+
+// Direction: the translation is ignored
+FORCE_INLINE vec3_t mat34_transform_vector(mat34_t m, vec3_t v) {
+    return vec3(m.x.x * v.x + m.x.y * v.y + m.x.z * v.z,
+                m.y.x * v.x + m.y.y * v.y + m.y.z * v.z,
+                m.z.x * v.x + m.z.y * v.y + m.z.z * v.z);
+}
+
+FORCE_INLINE vec3_t mat34_get_translation(mat34_t m) {
+    return vec3(m.x.w, m.y.w, m.z.w);
+}
+
+// Scale, then rotate, then translate (the rotation is normalized first)
+FORCE_INLINE mat34_t mat34_from_trs(vec3_t translation, quat_t rotation, vec3_t scale) {
+    quat_t q = quat_normalize(rotation);
+    float x2 = q.x + q.x, y2 = q.y + q.y, z2 = q.z + q.z;
+    float xx = q.x * x2, xy = q.x * y2, xz = q.x * z2;
+    float yy = q.y * y2, yz = q.y * z2, zz = q.z * z2;
+    float wx = q.w * x2, wy = q.w * y2, wz = q.w * z2;
+
+    mat34_t m;
+    m.x = vec4((1.0f - (yy + zz)) * scale.x, (xy - wz) * scale.y, (xz + wy) * scale.z, translation.x);
+    m.y = vec4((xy + wz) * scale.x, (1.0f - (xx + zz)) * scale.y, (yz - wx) * scale.z, translation.y);
+    m.z = vec4((xz - wy) * scale.x, (yz + wx) * scale.y, (1.0f - (xx + yy)) * scale.z, translation.z);
+    return m;
+}
+
+// Split a transform without shear back into translation, rotation and
+// scale. A mirrored transform reports a negative x scale.
+FORCE_INLINE void mat34_to_trs(mat34_t m, vec3_t* translation, quat_t* rotation, vec3_t* scale) {
+    vec3_t c0 = vec3(m.x.x, m.y.x, m.z.x);
+    vec3_t c1 = vec3(m.x.y, m.y.y, m.z.y);
+    vec3_t c2 = vec3(m.x.z, m.y.z, m.z.z);
+    vec3_t s = vec3(vec3_length(c0), vec3_length(c1), vec3_length(c2));
+    if (vec3_dot(c0, vec3_cross(c1, c2)) < 0.0f) {
+        s.x = -s.x;
+    }
+
+    // quat_from_mat4 reads the rotation's columns from rows x/y/z
+    mat4_t r = mat4_identity();
+    if (s.x != 0.0f) r.x = vec4(c0.x / s.x, c0.y / s.x, c0.z / s.x, 0.0f);
+    if (s.y != 0.0f) r.y = vec4(c1.x / s.y, c1.y / s.y, c1.z / s.y, 0.0f);
+    if (s.z != 0.0f) r.z = vec4(c2.x / s.z, c2.y / s.z, c2.z / s.z, 0.0f);
+
+    if (translation) *translation = mat34_get_translation(m);
+    if (rotation) *rotation = quat_from_mat4(r);
+    if (scale) *scale = s;
+}
+
+// 12 floats, row by row: the 48-byte instance record layout
+FORCE_INLINE void mat34_store(mat34_t m, float* RESTRICT out) {
+    memcpy(out, &m, sizeof(mat34_t));
+}
+
+FORCE_INLINE mat34_t mat34_load(const float* RESTRICT in) {
+    mat34_t m;
+    memcpy(&m, in, sizeof(mat34_t));
+    return m;
+}
+
+// Local-to-world for a hierarchy whose parents come before their children
+// (parent < 0 for roots). world may not alias local.
+void mat34_compose_hierarchy(const mat34_t* RESTRICT local, const int32_t* RESTRICT parents, uint32_t count,
+                             mat34_t* RESTRICT world);
+
+// Write transforms into the first 48 bytes of instance records `stride` bytes
+// apart (stride >= 48)
+void mat34_pack(const mat34_t* RESTRICT transforms, uint32_t count, void* RESTRICT records, size_t stride);
+
 // ============================================================================
 // UTILITY FUNCTIONS
 // ============================================================================
@@ -761,6 +1158,7 @@ void vec4_print(const char* name, vec4_t v);
 // Print matrix to stdout (for debugging)
 void mat3_print(const char* name, mat3_t m);
 void mat4_print(const char* name, mat4_t m);
+void mat34_print(const char* name, mat34_t m);
 
 // Print quaternion to stdout (for debugging)
 void quat_print(const char* name, quat_t q);
@@ -1,11 +1,33 @@
 #include "engine_math.h"
 #include <stdio.h>
 #include <math.h>
+#include <time.h>
+
+static int tests_run = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
 
 // Test function declarations
 void test_vectors(void);
 void test_matrices(void);
 void test_transformations(void);
+void test_affine(void);
 void test_performance(void);
 
 int main(void) {
@@ -20,11 +42,14 @@ int main(void) {
     test_transformations();
     printf("\n");
     
+    test_affine();
+    printf("\n");
+    
     test_performance();
     printf("\n");
     
-    printf("=== All Tests Completed ===\n");
-    return 0;
+    printf("=== All Tests Completed (%d checks, %d failed) ===\n", tests_run, tests_failed);
+    return tests_failed > 0;
 }
 
 void test_vectors(void) {
@@ -178,6 +203,100 @@ void test_transformations(void) {
     mat4_print("Orthographic", ortho_matrix);
 }
 
+// Row-vector reference: (p, 1) * M
+static vec3_t reference_transform(mat4_t m, vec3_t p) {
+    return vec3(p.x * m.x.x + p.y * m.y.x + p.z * m.z.x + m.w.x,
+                p.x * m.x.y + p.y * m.y.y + p.z * m.z.y + m.w.y,
+                p.x * m.x.z + p.y * m.y.z + p.z * m.z.z + m.w.z);
+}
+
+static int mat34_near(mat34_t a, mat34_t b, float epsilon) {
+    const float* pa = &a.x.x;
+    const float* pb = &b.x.x;
+    for (int i = 0; i < 12; i++) {
+        if (fabsf(pa[i] - pb[i]) > epsilon) return 0;
+    }
+    return 1;
+}
+
+static int vec3_near(vec3_t a, vec3_t b, float epsilon) {
+    return fabsf(a.x - b.x) <= epsilon && fabsf(a.y - b.y) <= epsilon && fabsf(a.z - b.z) <= epsilon;
+}
+
+void test_affine(void) {
+    printf("--- Affine Transform Tests ---\n");
+
+    TEST_ASSERT(sizeof(mat34_t) == 48, "mat34_t should be 48 bytes");
+
+    vec3_t t = vec3(1.0f, -2.0f, 3.5f);
+    quat_t q = quat_from_axis_angle(vec3_normalize(vec3(1.0f, 2.0f, -0.5f)), 0.8f);
+    vec3_t s = vec3(2.0f, 0.5f, 1.5f);
+    mat4_t m4 = mat4_mul_mat4(mat4_mul_mat4(mat4_scale(s), quat_to_mat4(q)), mat4_translation(t));
+    mat34_t m = mat34_from_trs(t, q, s);
+    mat34_print("TRS", m);
+    TEST_ASSERT(mat34_near(m, mat34_from_mat4(m4), 1e-5f), "TRS should match scale * rotation * translation as mat4");
+    TEST_ASSERT(mat34_near(mat34_from_mat4(mat34_to_mat4(m)), m, 0.0f), "mat4 conversion should round-trip");
+
+    vec3_t p = vec3(0.3f, -1.2f, 4.0f);
+    TEST_ASSERT(vec3_near(mat34_transform_point(m, p), reference_transform(m4, p), 1e-5f),
+                "Points should transform like (p, 1) * mat4");
+    TEST_ASSERT(vec3_near(mat34_transform_vector(m, p),
+                          vec3_sub(reference_transform(m4, p), reference_transform(m4, vec3_zero())), 1e-5f),
+                "Vectors should ignore the translation");
+
+    mat34_t n = mat34_from_trs(vec3(-4.0f, 0.0f, 1.0f), quat_from_axis_angle(vec3_unit_y(), -1.3f), vec3(1.0f, 3.0f, 1.0f));
+    mat34_t mn = mat34_mul(m, n);
+    TEST_ASSERT(mat34_near(mn, mat34_from_mat4(mat4_mul_mat4(m4, mat34_to_mat4(n))), 1e-4f),
+                "Composition should follow mat4_mul_mat4 order");
+    TEST_ASSERT(vec3_near(mat34_transform_point(mn, p), mat34_transform_point(n, mat34_transform_point(m, p)), 1e-4f),
+                "mat34_mul(a, b) should apply a first");
+
+    mat34_t inv = mat34_inverse(m);
+    TEST_ASSERT(mat34_near(mat34_mul(m, inv), mat34_identity(), 1e-5f) &&
+                mat34_near(mat34_mul(inv, m), mat34_identity(), 1e-5f), "Inverse should undo the transform");
+    TEST_ASSERT(vec3_near(mat34_transform_point(inv, mat34_transform_point(m, p)), p, 1e-5f),
+                "Inverse should map points back");
+    TEST_ASSERT(mat34_near(mat34_inverse(mat34_from_trs(t, q, vec3(1.0f, 0.0f, 1.0f))), mat34_identity(), 0.0f),
+                "Singular transforms should invert to identity");
+
+    vec3_t t2, s2;
+    quat_t q2;
+    mat34_to_trs(m, &t2, &q2, &s2);
+    TEST_ASSERT(vec3_near(t2, t, 1e-6f) && vec3_near(s2, s, 1e-5f) && fabsf(fabsf(quat_dot(q2, q)) - 1.0f) < 1e-5f,
+                "TRS decomposition should recover translation, rotation and scale");
+    mat34_t mirrored = mat34_from_trs(t, q, vec3(-2.0f, 0.5f, 1.5f));
+    mat34_to_trs(mirrored, &t2, &q2, &s2);
+    TEST_ASSERT(mat34_near(mat34_from_trs(t2, q2, s2), mirrored, 1e-5f), "Mirrored transforms should rebuild exactly");
+
+    // Instance records: 48 bytes of matrix followed by per-instance data
+    typedef struct {
+        float transform[12];
+        float color[4];
+    } InstanceRecord;
+    mat34_t transforms[3] = { m, n, mn };
+    InstanceRecord records[3];
+    for (int i = 0; i < 3; i++) {
+        records[i].color[0] = (float)i;
+    }
+    mat34_pack(transforms, 3, records, sizeof(InstanceRecord));
+    int packed = 1;
+    for (int i = 0; i < 3; i++) {
+        packed &= mat34_near(mat34_load(records[i].transform), transforms[i], 0.0f) && records[i].color[0] == (float)i;
+    }
+    TEST_ASSERT(packed, "Packing should fill the matrix and leave the rest of each record");
+    float row_major[12];
+    mat34_store(m, row_major);
+    TEST_ASSERT(row_major[3] == t.x && row_major[7] == t.y && row_major[11] == t.z,
+                "Stored rows should end with the translation");
+
+    mat34_t local[4] = { m, n, m, n };
+    int32_t parents[4] = { -1, 0, 1, 0 };
+    mat34_t world[4];
+    mat34_compose_hierarchy(local, parents, 4, world);
+    TEST_ASSERT(mat34_near(world[2], mat34_mul(m, mat34_mul(n, m)), 1e-4f) && mat34_near(world[3], mat34_mul(n, m), 1e-5f),
+                "Hierarchy should compose each local transform with its parent's world transform");
+}
+
 void test_performance(void) {
     printf("--- Performance Tests ---\n");
     
@@ -209,11 +328,11 @@ void test_performance(void) {
         m_result = mat4_mul_mat4(m1, m2);
     }
     
-    printf("Matrix multiplication: %d operations completed\n", iterations);
+    printf("Matrix multiplication: %d operations completed (%.1f)\n", iterations, m_result.w.w);
     
     // Test transformation chain
     vec3_t pos = vec3(1.0f, 2.0f, 3.0f);
-    vec4_t pos4 = vec4(pos[0], pos[1], pos[2], 1.0f);
+    vec4_t pos4 = vec4(pos.x, pos.y, pos.z, 1.0f);
     
     printf("\nTesting transformation chain...\n");
     
@@ -228,4 +347,35 @@ void test_performance(void) {
     vec3_print("", pos);
     printf("Transformed position: ");
     vec4_print("", transformed);
+    
+    // Hierarchy composition: mat4 vs 3x4 affine
+    const uint32_t nodes = 65536;
+    const int passes = 16;
+    static mat4_t local4[65536], world4[65536];
+    static mat34_t local34[65536], world34[65536];
+    static int32_t parents[65536];
+    for (uint32_t i = 0; i < nodes; i++) {
+        parents[i] = i == 0 ? -1 : (int32_t)((i - 1) / 4);
+        local34[i] = mat34_from_trs(vec3(0.01f * i, 1.0f, -0.5f),
+                                    quat_from_axis_angle(vec3_unit_y(), 0.001f * i), vec3_one());
+        local4[i] = mat34_to_mat4(local34[i]);
+    }
+    
+    double start = now_ms();
+    for (int pass = 0; pass < passes; pass++) {
+        for (uint32_t i = 0; i < nodes; i++) {
+            world4[i] = parents[i] < 0 ? local4[i] : mat4_mul_mat4(local4[i], world4[parents[i]]);
+        }
+    }
+    double mat4_ms = now_ms() - start;
+    start = now_ms();
+    for (int pass = 0; pass < passes; pass++) {
+        mat34_compose_hierarchy(local34, parents, nodes, world34);
+    }
+    double mat34_ms = now_ms() - start;
+    
+    printf("\nHierarchy of %u nodes x %d passes: mat4 %.2f ms (%zu bytes/node), mat34 %.2f ms (%zu bytes/node)\n",
+           nodes, passes, mat4_ms, sizeof(mat4_t), mat34_ms, sizeof(mat34_t));
+    TEST_ASSERT(mat34_near(world34[nodes - 1], mat34_from_mat4(world4[nodes - 1]), 1e-3f),
+                "Affine hierarchy should match the mat4 result");
 }
@@ -0,0 +1,621 @@
+#include "engine_mesh_codec.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define INDEX_STREAM_TAG 0xE1
+#define VERTEX_STREAM_TAG 0xA1
+#define INDEX_FIFO_SIZE 16                      // Power of two; the edge FIFO addresses 15 entries
+#define INDEX_EDGE_SLOTS 15
+#define INDEX_VERTEX_SLOTS 3
+#define INDEX_NO_EDGE 0xF0
+#define VERTEX_BLOCK_BYTES 8192                 // Decoded bytes per block (stream-major scratch)
+#define VERTEX_BLOCK_MAX 256                    // Vertices per block
+
+// ============================================================================
+// VARINTS
+// ============================================================================
+
+static uint32_t zigzag_encode(uint32_t delta) {
+    return (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+}
+
+static uint32_t zigzag_decode(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1u));
+}
+
+static uint8_t* write_varint(uint8_t* p, uint32_t value) {
+    while (value >= 0x80) {
+        *p++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (uint8_t)value;
+    return p;
+}
+
+// Returns NULL when the varint runs past end or exceeds 32 bits
+static const uint8_t* read_varint(const uint8_t* p, const uint8_t* end, uint32_t* out_value) {
+    uint32_t value = 0;
+    for (uint32_t shift = 0; shift < 35; shift += 7) {
+        if (p >= end) {
+            return NULL;
+        }
+        uint8_t byte = *p++;
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *out_value = value;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// ============================================================================
+// INDEX STREAM
+// ============================================================================
+
+// Shared encoder/decoder state. Edges are directed as their triangle winds
+// them; a neighbour shares an edge in the opposite direction.
+typedef struct {
+    uint32_t edges[INDEX_FIFO_SIZE][2];
+    uint32_t vertices[INDEX_FIFO_SIZE];
+    uint32_t edge_head;
+    uint32_t vertex_head;
+    uint32_t next;              // Lowest index not yet seen in order
+    uint32_t last;              // Last explicitly coded index; varints are deltas from it
+} IndexCodecState;
+
+static void index_state_init(IndexCodecState* state) {
+    memset(state->edges, 0xFF, sizeof(state->edges));
+    memset(state->vertices, 0xFF, sizeof(state->vertices));
+    state->edge_head = 0;
+    state->vertex_head = 0;
+    state->next = 0;
+    state->last = 0;
+}
+
+static void push_edge(IndexCodecState* state, uint32_t a, uint32_t b) {
+    state->edges[state->edge_head][0] = a;
+    state->edges[state->edge_head][1] = b;
+    state->edge_head = (state->edge_head + 1) & (INDEX_FIFO_SIZE - 1);
+}
+
+static void push_vertex(IndexCodecState* state, uint32_t v) {
+    state->vertices[state->vertex_head] = v;
+    state->vertex_head = (state->vertex_head + 1) & (INDEX_FIFO_SIZE - 1);
+}
+
+// i = 0 is the most recent entry
+static const uint32_t* get_edge(const IndexCodecState* state, uint32_t i) {
+    return state->edges[(state->edge_head - 1 - i) & (INDEX_FIFO_SIZE - 1)];
+}
+
+static uint32_t get_vertex(const IndexCodecState* state, uint32_t i) {
+    return state->vertices[(state->vertex_head - 1 - i) & (INDEX_FIFO_SIZE - 1)];
+}
+
+size_t mesh_codec_index_bound(uint32_t index_count) {
+    size_t triangles = index_count / 3;
+    return 1 + triangles + triangles * 3 * 5;
+}
+
+// Layout: tag, one code byte per triangle, then varint data in triangle
+// order. Edge code: high nibble = edge slot, low nibble = rotation * 5 +
+// third-vertex kind (0 next, 1..3 vertex FIFO slot, 4 varint). No-edge
+// code: 0xF0 | mask of vertices equal to next; the others are varints.
+// Varints are zigzag deltas from the previous varint-coded index.
+size_t mesh_codec_encode_indices(uint8_t* out, size_t capacity, const uint32_t* indices, uint32_t index_count) {
+    if (!out || (!indices && index_count > 0) || index_count % 3 != 0) {
+        fprintf(stderr, "Error: Invalid index encode parameters\n");
+        return 0;
+    }
+
+    uint32_t triangle_count = index_count / 3;
+    if (capacity < 1 + (size_t)triangle_count) {
+        return 0;
+    }
+
+    IndexCodecState state;
+    index_state_init(&state);
+
+    out[0] = INDEX_STREAM_TAG;
+    uint8_t* codes = out + 1;
+    uint8_t* data = codes + triangle_count;
+    uint8_t* end = out + capacity;
+
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        if ((size_t)(end - data) < 15) {
+            return 0;
+        }
+        const uint32_t* tri = indices + 3 * t;
+
+        // Most recent shared edge, in any rotation
+        uint32_t slot = INDEX_EDGE_SLOTS, rotation = 0;
+        for (uint32_t i = 0; i < INDEX_EDGE_SLOTS && slot == INDEX_EDGE_SLOTS; i++) {
+            const uint32_t* edge = get_edge(&state, i);
+            for (uint32_t r = 0; r < 3; r++) {
+                if (edge[0] == tri[(r + 1) % 3] && edge[1] == tri[r]) {
+                    slot = i;
+                    rotation = r;
+                    break;
+                }
+            }
+        }
+
+        if (slot < INDEX_EDGE_SLOTS) {
+            uint32_t a = tri[rotation], b = tri[(rotation + 1) % 3], c = tri[(rotation + 2) % 3];
+            uint32_t kind = 4;
+            if (c == state.next) {
+                kind = 0;
+                state.next++;
+            } else {
+                for (uint32_t i = 0; i < INDEX_VERTEX_SLOTS; i++) {
+                    if (get_vertex(&state, i) == c) {
+                        kind = 1 + i;
+                        break;
+                    }
+                }
+                if (kind == 4) {
+                    data = write_varint(data, zigzag_encode(c - state.last));
+                    state.last = c;
+                }
+            }
+            codes[t] = (uint8_t)((slot << 4) | (rotation * 5 + kind));
+
+            push_edge(&state, b, c);
+            push_edge(&state, c, a);
+            if (kind == 0 || kind == 4) {
+                push_vertex(&state, c);
+            }
+        } else {
+            uint32_t mask = 0;
+            for (uint32_t k = 0; k < 3; k++) {
+                if (tri[k] == state.next) {
+                    mask |= 1u << k;
+                    state.next++;
+                } else {
+                    data = write_varint(data, zigzag_encode(tri[k] - state.last));
+                    state.last = tri[k];
+                }
+            }
+            codes[t] = (uint8_t)(INDEX_NO_EDGE | mask);
+
+            push_edge(&state, tri[0], tri[1]);
+            push_edge(&state, tri[1], tri[2]);
+            push_edge(&state, tri[2], tri[0]);
+            for (uint32_t k = 0; k < 3; k++) {
+                push_vertex(&state, tri[k]);
+            }
+        }
+    }
+
+    return (size_t)(data - out);
+}
+
+int mesh_codec_decode_indices(uint32_t* indices, uint32_t index_count, const uint8_t* data, size_t size) {
+    if ((!indices && index_count > 0) || !data || index_count % 3 != 0) {
+        return 0;
+    }
+
+    uint32_t triangle_count = index_count / 3;
+    if (size < 1 + (size_t)triangle_count || data[0] != INDEX_STREAM_TAG) {
+        return 0;
+    }
+
+    IndexCodecState state;
+    index_state_init(&state);
+
+    const uint8_t* codes = data + 1;
+    const uint8_t* p = codes + triangle_count;
+    const uint8_t* end = data + size;
+
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        uint32_t code = codes[t];
+        uint32_t* tri = indices + 3 * t;
+
+        if ((code & 0xF0) != INDEX_NO_EDGE) {
+            uint32_t low = code & 0x0F;
+            if (low >= 15) {
+                return 0;
+            }
+            const uint32_t* edge = get_edge(&state, code >> 4);
+            uint32_t rotation = low / 5, kind = low % 5;
+            uint32_t a = edge[1], b = edge[0], c;
+            if (kind == 0) {
+                c = state.next++;
+            } else if (kind < 4) {
+                c = get_vertex(&state, kind - 1);
+            } else {
+                uint32_t value;
+                if (!(p = read_varint(p, end, &value))) {
+                    return 0;
+                }
+                c = state.last + zigzag_decode(value);
+                state.last = c;
+            }
+            tri[rotation] = a;
+            tri[(rotation + 1) % 3] = b;
+            tri[(rotation + 2) % 3] = c;
+
+            push_edge(&state, b, c);
+            push_edge(&state, c, a);
+            if (kind == 0 || kind == 4) {
+                push_vertex(&state, c);
+            }
+        } else {
+            if (code & 0x08) {
+                return 0;
+            }
+            for (uint32_t k = 0; k < 3; k++) {
+                if (code & (1u << k)) {
+                    tri[k] = state.next++;
+                } else {
+                    uint32_t value;
+                    if (!(p = read_varint(p, end, &value))) {
+                        return 0;
+                    }
+                    tri[k] = state.last + zigzag_decode(value);
+                    state.last = tri[k];
+                }
+            }
+
+            push_edge(&state, tri[0], tri[1]);
+            push_edge(&state, tri[1], tri[2]);
+            push_edge(&state, tri[2], tri[0]);
+            for (uint32_t k = 0; k < 3; k++) {
+                push_vertex(&state, tri[k]);
+            }
+        }
+    }
+
+    return 1;
+}
+
+// ============================================================================
+// VERTEX STREAM
+// ============================================================================
+
+// Sixteen byte lanes via GCC/Clang vector extensions (SSE2 on x86, NEON on
+// Apple Silicon), as for the simd4f_t kernels in engine_math.h
+typedef uint8_t simd16u8_t __attribute__((vector_size(16)));
+typedef uint16_t simd8u16_t __attribute__((vector_size(16)));
+typedef uint32_t simd4u32_t __attribute__((vector_size(16)));
+
+static const uint32_t group_data_bytes[4] = {0, 4, 8, 16};
+
+FORCE_INLINE simd16u8_t simd16u8_splat(uint8_t s) {
+    return (simd16u8_t){s, s, s, s, s, s, s, s, s, s, s, s, s, s, s, s};
+}
+
+static uint32_t vertex_block_size(uint32_t vertex_size) {
+    uint32_t count = (VERTEX_BLOCK_BYTES / vertex_size) & ~15u;
+    return count < VERTEX_BLOCK_MAX ? count : VERTEX_BLOCK_MAX;
+}
+
+static int vertex_size_valid(uint32_t vertex_size) {
+    return vertex_size > 0 && vertex_size % 4 == 0 && vertex_size <= MESH_CODEC_MAX_VERTEX_SIZE;
+}
+
+size_t mesh_codec_vertex_bound(uint32_t vertex_count, uint32_t vertex_size) {
+    if (!vertex_size_valid(vertex_size)) {
+        return 0;
+    }
+    uint32_t block_size = vertex_block_size(vertex_size);
+    size_t bound = 1;
+    for (uint32_t start = 0; start < vertex_count; start += block_size) {
+        uint32_t count = vertex_count - start < block_size ? vertex_count - start : block_size;
+        uint32_t groups = (count + 15) / 16;
+        bound += (size_t)vertex_size * ((groups + 3) / 4 + groups * 16);
+    }
+    return bound;
+}
+
+// Layout: tag, then per block and byte position a 2-bit mode per group of
+// 16 zigzag byte deltas (0, 2, 4 or 8 bits) followed by the packed groups.
+// Deltas run across blocks; padding lanes of the last group repeat the
+// final value.
+size_t mesh_codec_encode_vertices(uint8_t* out, size_t capacity, const void* vertices,
+                                  uint32_t vertex_count, uint32_t vertex_size) {
+    if (!out || (!vertices && vertex_count > 0) || !vertex_size_valid(vertex_size)) {
+        fprintf(stderr, "Error: Invalid vertex encode parameters\n");
+        return 0;
+    }
+    if (capacity < mesh_codec_vertex_bound(vertex_count, vertex_size)) {
+        return 0;
+    }
+
+    const uint8_t* src = (const uint8_t*)vertices;
+    uint32_t block_size = vertex_block_size(vertex_size);
+    uint8_t last[MESH_CODEC_MAX_VERTEX_SIZE] = {0};
+    uint8_t values[VERTEX_BLOCK_MAX];
+    uint8_t* p = out;
+    *p++ = VERTEX_STREAM_TAG;
+
+    for (uint32_t start = 0; start < vertex_count; start += block_size) {
+        uint32_t count = vertex_count - start < block_size ? vertex_count - start : block_size;
+        uint32_t groups = (count + 15) / 16;
+
+        for (uint32_t k = 0; k < vertex_size; k++) {
+            uint8_t prev = last[k];
+            for (uint32_t i = 0; i < groups * 16; i++) {
+                uint8_t byte = i < count ? src[(size_t)(start + i) * vertex_size + k] : prev;
+                uint8_t delta = (uint8_t)(byte - prev);
+                values[i] = (uint8_t)((delta << 1) ^ (uint8_t)((int8_t)delta >> 7));
+                prev = byte;
+            }
+            last[k] = prev;
+
+            uint8_t* header = p;
+            uint32_t header_bytes = (groups + 3) / 4;
+            memset(header, 0, header_bytes);
+            p += header_bytes;
+
+            for (uint32_t g = 0; g < groups; g++) {
+                const uint8_t* v = values + g * 16;
+                uint8_t max_value = 0;
+                for (uint32_t i = 0; i < 16; i++) {
+                    max_value = v[i] > max_value ? v[i] : max_value;
+                }
+                uint32_t mode = max_value == 0 ? 0 : (max_value < 4 ? 1 : (max_value < 16 ? 2 : 3));
+                header[g / 4] |= (uint8_t)(mode << ((g % 4) * 2));
+
+                if (mode == 1) {
+                    for (uint32_t i = 0; i < 4; i++) {
+                        *p++ = (uint8_t)((v[4 * i] << 6) | (v[4 * i + 1] << 4) | (v[4 * i + 2] << 2) | v[4 * i + 3]);
+                    }
+                } else if (mode == 2) {
+                    for (uint32_t i = 0; i < 8; i++) {
+                        *p++ = (uint8_t)((v[2 * i] << 4) | v[2 * i + 1]);
+                    }
+                } else if (mode == 3) {
+                    memcpy(p, v, 16);
+                    p += 16;
+                }
+            }
+        }
+    }
+
+    return (size_t)(p - out);
+}
+
+// Expand one packed group to 16 zigzag values
+FORCE_INLINE simd16u8_t unpack_group(const uint8_t* p, uint32_t mode) {
+    simd16u8_t x = {0};
+    if (mode == 1) {
+        memcpy(&x, p, 4);
+        const simd16u8_t mask = simd16u8_splat(3);
+        simd16u8_t s6 = x >> 6, s4 = (x >> 4) & mask, s2 = (x >> 2) & mask, s0 = x & mask;
+        simd16u8_t a = __builtin_shufflevector(s6, s4, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        simd16u8_t b = __builtin_shufflevector(s2, s0, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+        return (simd16u8_t)__builtin_shufflevector((simd8u16_t)a, (simd8u16_t)b, 0, 8, 1, 9, 2, 10, 3, 11);
+    }
+    if (mode == 2) {
+        memcpy(&x, p, 8);
+        return __builtin_shufflevector(x >> 4, x & simd16u8_splat(15), 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+    }
+    if (mode == 3) {
+        memcpy(&x, p, 16);
+    }
+    return x;
+}
+
+// Zigzag decode and running sum over the 16 lanes, continuing from prev
+FORCE_INLINE simd16u8_t accumulate_group(simd16u8_t x, simd16u8_t prev) {
+    const simd16u8_t zero = {0};
+    x = (x >> 1) ^ (zero - (x & simd16u8_splat(1)));
+    x += __builtin_shufflevector(zero, x, 0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30);
+    x += __builtin_shufflevector(zero, x, 0, 0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29);
+    x += __builtin_shufflevector(zero, x, 0, 0, 0, 0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27);
+    x += __builtin_shufflevector(zero, x, 0, 0, 0, 0, 0, 0, 0, 0, 16, 17, 18, 19, 20, 21, 22, 23);
+    return x + prev;
+}
+
+// Decode one byte stream of a block into out (one vector per group).
+// Returns the position after the stream, or NULL when it is truncated.
+static const uint8_t* decode_byte_stream(const uint8_t* p, const uint8_t* end, uint32_t groups,
+                                         uint8_t last, simd16u8_t* out) {
+    uint32_t header_bytes = (groups + 3) / 4;
+    if ((size_t)(end - p) < header_bytes) {
+        return NULL;
+    }
+    const uint8_t* header = p;
+    p += header_bytes;
+
+    size_t data_bytes = 0;
+    for (uint32_t g = 0; g < groups; g++) {
+        data_bytes += group_data_bytes[(header[g / 4] >> ((g % 4) * 2)) & 3];
+    }
+    if ((size_t)(end - p) < data_bytes) {
+        return NULL;
+    }
+
+    simd16u8_t prev = simd16u8_splat(last);
+    for (uint32_t g = 0; g < groups; g++) {
+        uint32_t mode = (header[g / 4] >> ((g % 4) * 2)) & 3;
+        simd16u8_t x = accumulate_group(unpack_group(p, mode), prev);
+        p += group_data_bytes[mode];
+        out[g] = x;
+        prev = __builtin_shufflevector(x, x, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15);
+    }
+    return p;
+}
+
+int mesh_codec_decode_vertices(void* vertices, uint32_t vertex_count, uint32_t vertex_size,
+                               const uint8_t* data, size_t size) {
+    if ((!vertices && vertex_count > 0) || !data || !vertex_size_valid(vertex_size)) {
+        return 0;
+    }
+    if (size < 1 || data[0] != VERTEX_STREAM_TAG) {
+        return 0;
+    }
+
+    uint8_t* dst = (uint8_t*)vertices;
+    uint32_t block_size = vertex_block_size(vertex_size);
+    uint32_t block_groups = block_size / 16;
+    simd16u8_t streams[VERTEX_BLOCK_BYTES / 16];  // Stream-major: byte k of group g at [k * block_groups + g]
+    uint8_t last[MESH_CODEC_MAX_VERTEX_SIZE] = {0};
+    const uint8_t* p = data + 1;
+    const uint8_t* end = data + size;
+
+    for (uint32_t start = 0; start < vertex_count; start += block_size) {
+        uint32_t count = vertex_count - start < block_size ? vertex_count - start : block_size;
+        uint32_t groups = (count + 15) / 16;
+
+        for (uint32_t k = 0; k < vertex_size; k++) {
+            simd16u8_t* out = streams + k * block_groups;
+            if (!(p = decode_byte_stream(p, end, groups, last[k], out))) {
+                return 0;
+            }
+            last[k] = out[(count - 1) / 16][(count - 1) % 16];
+        }
+
+        // Transpose four byte streams at a time into 4-byte vertex columns
+        for (uint32_t g = 0; g < groups; g++) {
+            uint32_t lanes = count - g * 16 < 16 ? count - g * 16 : 16;
+            uint8_t* base = dst + (size_t)(start + g * 16) * vertex_size;
+            for (uint32_t k = 0; k < vertex_size; k += 4) {
+                simd16u8_t s0 = streams[k * block_groups + g];
+                simd16u8_t s1 = streams[(k + 1) * block_groups + g];
+                simd16u8_t s2 = streams[(k + 2) * block_groups + g];
+                simd16u8_t s3 = streams[(k + 3) * block_groups + g];
+                simd8u16_t lo01 = (simd8u16_t)__builtin_shufflevector(s0, s1, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+                simd8u16_t hi01 = (simd8u16_t)__builtin_shufflevector(s0, s1, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+                simd8u16_t lo23 = (simd8u16_t)__builtin_shufflevector(s2, s3, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+                simd8u16_t hi23 = (simd8u16_t)__builtin_shufflevector(s2, s3, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+                simd4u32_t columns[4] = {
+                    (simd4u32_t)__builtin_shufflevector(lo01, lo23, 0, 8, 1, 9, 2, 10, 3, 11),
+                    (simd4u32_t)__builtin_shufflevector(lo01, lo23, 4, 12, 5, 13, 6, 14, 7, 15),
+                    (simd4u32_t)__builtin_shufflevector(hi01, hi23, 0, 8, 1, 9, 2, 10, 3, 11),
+                    (simd4u32_t)__builtin_shufflevector(hi01, hi23, 4, 12, 5, 13, 6, 14, 7, 15),
+                };
+                const uint8_t* column_bytes = (const uint8_t*)columns;
+                if (lanes == 16) {
+                    for (uint32_t v = 0; v < 16; v++) {
+                        memcpy(base + (size_t)v * vertex_size + k, column_bytes + 4 * v, 4);
+                    }
+                } else {
+                    for (uint32_t v = 0; v < lanes; v++) {
+                        memcpy(base + (size_t)v * vertex_size + k, column_bytes + 4 * v, 4);
+                    }
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+// ============================================================================
+// MESH BLOBS
+// ============================================================================
+
+uint8_t* mesh_codec_encode_mesh(const Mesh* mesh, size_t* out_size) {
+    if (!mesh || !out_size || mesh->index_count % 3 != 0 ||
+        (!mesh->vertices && mesh->vertex_count > 0) || (!mesh->indices && mesh->index_count > 0)) {
+        fprintf(stderr, "Error: Invalid mesh encode parameters\n");
+        return NULL;
+    }
+
+    size_t vertex_bound = mesh_codec_vertex_bound(mesh->vertex_count, sizeof(Vertex));
+    size_t index_bound = mesh_codec_index_bound(mesh->index_count);
+    uint8_t* blob = (uint8_t*)malloc(sizeof(MeshCodecHeader) + vertex_bound + index_bound);
+    if (!blob) {
+        fprintf(stderr, "Error: Failed to allocate memory for encoded mesh\n");
+        return NULL;
+    }
+
+    uint8_t* p = blob + sizeof(MeshCodecHeader);
+    size_t vertex_bytes = mesh_codec_encode_vertices(p, vertex_bound, mesh->vertices, mesh->vertex_count, sizeof(Vertex));
+    size_t index_bytes = mesh_codec_encode_indices(p + vertex_bytes, index_bound, mesh->indices, mesh->index_count);
+    if (vertex_bytes == 0 || index_bytes == 0) {
+        fprintf(stderr, "Error: Failed to encode mesh\n");
+        free(blob);
+        return NULL;
+    }
+
+    MeshCodecHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MESH_CODEC_MAGIC;
+    header.version = MESH_CODEC_VERSION;
+    header.vertex_count = mesh->vertex_count;
+    header.index_count = mesh->index_count;
+    header.vertex_size = sizeof(Vertex);
+    header.vertex_bytes = (uint32_t)vertex_bytes;
+    header.index_bytes = (uint32_t)index_bytes;
+    memcpy(blob, &header, sizeof(header));
+
+    *out_size = sizeof(MeshCodecHeader) + vertex_bytes + index_bytes;
+    uint8_t* shrunk = (uint8_t*)realloc(blob, *out_size);
+    return shrunk ? shrunk : blob;
+}
+
+// Header of a blob, or 0 when it is malformed
+static int read_header(const uint8_t* data, size_t size, MeshCodecHeader* header) {
+    if (!data || size < sizeof(MeshCodecHeader)) {
+        return 0;
+    }
+    memcpy(header, data, sizeof(*header));
+    return header->magic == MESH_CODEC_MAGIC && header->version == MESH_CODEC_VERSION &&
+           header->index_count % 3 == 0 &&
+           (uint64_t)header->vertex_bytes + header->index_bytes <= size - sizeof(MeshCodecHeader);
+}
+
+Mesh* mesh_codec_decode_mesh(const uint8_t* data, size_t size) {
+    MeshCodecHeader header;
+    if (!read_header(data, size, &header)) {
+        fprintf(stderr, "Error: Not a valid encoded mesh\n");
+        return NULL;
+    }
+    if (header.vertex_size != sizeof(Vertex)) {
+        fprintf(stderr, "Error: Encoded mesh vertex size %u does not match Vertex (%zu)\n",
+                header.vertex_size, sizeof(Vertex));
+        return NULL;
+    }
+
+    Mesh* mesh = mesh_allocate(header.vertex_count, header.index_count);
+    if (!mesh) {
+        return NULL;
+    }
+
+    const uint8_t* p = data + sizeof(MeshCodecHeader);
+    if (!mesh_codec_decode_vertices(mesh->vertices, header.vertex_count, sizeof(Vertex), p, header.vertex_bytes) ||
+        !mesh_codec_decode_indices(mesh->indices, header.index_count, p + header.vertex_bytes, header.index_bytes)) {
+        fprintf(stderr, "Error: Encoded mesh streams are corrupt\n");
+        mesh_free(mesh);
+        free(mesh);
+        return NULL;
+    }
+
+    // The index stream decodes on its own, so a corrupt code byte or delta
+    // can still name a vertex the blob doesn't have
+    for (uint32_t i = 0; i < header.index_count; i++) {
+        if (mesh->indices[i] >= header.vertex_count) {
+            fprintf(stderr, "Error: Encoded mesh index %u is out of range (%u vertices)\n",
+                    mesh->indices[i], header.vertex_count);
+            mesh_free(mesh);
+            free(mesh);
+            return NULL;
+        }
+    }
+    return mesh;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void mesh_codec_print(const char* name, const uint8_t* data, size_t size) {
+    MeshCodecHeader header;
+    if (!read_header(data, size, &header)) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    uint32_t triangles = header.index_count / 3;
+    size_t raw_bytes = (size_t)header.vertex_count * header.vertex_size + (size_t)header.index_count * sizeof(uint32_t);
+    printf("%s: %u vertices, %u triangles, %zu bytes (raw %zu, %.1f%%)\n", name, header.vertex_count, triangles,
+           size, raw_bytes, raw_bytes ? 100.0 * (double)size / (double)raw_bytes : 0.0);
+    printf("  Vertices: %u bytes (%.2f per vertex), indices: %u bytes (%.2f per triangle)\n", header.vertex_bytes,
+           header.vertex_count ? (double)header.vertex_bytes / header.vertex_count : 0.0, header.index_bytes,
+           triangles ? (double)header.index_bytes / triangles : 0.0);
+}
@@ -0,0 +1,97 @@
+#ifndef ENGINE_MESH_CODEC_H
+#define ENGINE_MESH_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_model.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// MESH CODEC CONFIGURATION
+// ============================================================================
+
+#define MESH_CODEC_MAGIC 0x4D43534Du            // "MSCM"
+#define MESH_CODEC_VERSION 1
+#define MESH_CODEC_MAX_VERTEX_SIZE 256          // Vertex streams: stride in bytes, multiple of 4
+
+// ============================================================================
+// MESH CODEC FILE FORMAT
+// ============================================================================
+
+// An encoded mesh is this header followed by the vertex stream
+// (vertex_bytes) and the index stream (index_bytes). All fields are
+// little-endian.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertex_count;
+    uint32_t index_count;
+    uint32_t vertex_size;       // sizeof(Vertex) of the writer
+    uint32_t vertex_bytes;
+    uint32_t index_bytes;
+    uint32_t reserved;
+} MeshCodecHeader;
+
+// ============================================================================
+// INDEX STREAM FUNCTIONS
+// ============================================================================
+
+// Worst-case encoded size of a triangle list
+size_t mesh_codec_index_bound(uint32_t index_count);
+
+// Lossless triangle list encoding. Each triangle is one code byte naming a
+// recently seen edge (from a 15-entry edge FIFO) and where its third vertex
+// comes from: the next unseen index, a 3-entry vertex FIFO or a varint
+// delta. Triangles sharing edges in vertex-cache order cost about one byte.
+// index_count must be a multiple of 3. Returns the bytes written, 0 on error.
+size_t mesh_codec_encode_indices(uint8_t* out, size_t capacity, const uint32_t* indices, uint32_t index_count);
+
+// Decode index_count indices. Returns 1 on success, 0 for malformed input.
+int mesh_codec_decode_indices(uint32_t* indices, uint32_t index_count, const uint8_t* data, size_t size);
+
+// ============================================================================
+// VERTEX STREAM FUNCTIONS
+// ============================================================================
+
+// Worst-case encoded size of a vertex buffer
+size_t mesh_codec_vertex_bound(uint32_t vertex_count, uint32_t vertex_size);
+
+// Lossless vertex buffer encoding. Vertices are split into blocks; each
+// byte position is delta-coded against the previous vertex and packed in
+// groups of 16 at 0, 2, 4 or 8 bits. vertex_size must be a multiple of 4
+// up to MESH_CODEC_MAX_VERTEX_SIZE. Returns the bytes written, 0 on error.
+size_t mesh_codec_encode_vertices(uint8_t* out, size_t capacity, const void* vertices,
+                                  uint32_t vertex_count, uint32_t vertex_size);
+
+// Decode vertex_count vertices with 16-wide vector unpacking, prefix sums
+// and transposition. Returns 1 on success, 0 for malformed input.
+int mesh_codec_decode_vertices(void* vertices, uint32_t vertex_count, uint32_t vertex_size,
+                               const uint8_t* data, size_t size);
+
+// ============================================================================
+// MESH FUNCTIONS
+// ============================================================================
+
+// Encode a mesh into a new malloc'd blob (header and both streams).
+// Returns NULL on error.
+uint8_t* mesh_codec_encode_mesh(const Mesh* mesh, size_t* out_size);
+
+// Decode a blob into a new Mesh (release with mesh_free). Returns NULL for
+// malformed input or a Vertex layout mismatch.
+Mesh* mesh_codec_decode_mesh(const uint8_t* data, size_t size);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print the stream sizes of a blob and bytes per triangle
+void mesh_codec_print(const char* name, const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_MESH_CODEC_H
@@ -0,0 +1,425 @@
+#include "engine_mesh_codec.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* assets_dir = "assets";
+
+static uint32_t rng_state = 24681357u;
+
+static uint32_t random_u32(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state;
+}
+
+// ============================================================================
+// GENERATED MESHES
+// ============================================================================
+
+static void release_mesh(Mesh* mesh) {
+    mesh_free(mesh);
+    free(mesh);
+}
+
+// Row-major height field grid, triangles in scanline order
+static Mesh* make_grid_mesh(uint32_t width, uint32_t height) {
+    Mesh* mesh = mesh_allocate((width + 1) * (height + 1), width * height * 6);
+    for (uint32_t y = 0; y <= height; y++) {
+        for (uint32_t x = 0; x <= width; x++) {
+            float fx = (float)x / (float)width, fy = (float)y / (float)height;
+            mesh->vertices[y * (width + 1) + x] = vertex_create_components(
+                fx * 10.0f, 0.25f * sinf(fx * 12.0f) * cosf(fy * 9.0f), fy * 10.0f, fx, fy, 0.0f, 1.0f, 0.0f);
+        }
+    }
+    uint32_t idx = 0;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint32_t i0 = y * (width + 1) + x, i1 = i0 + 1, i2 = i0 + width + 1, i3 = i2 + 1;
+            mesh->indices[idx++] = i0;
+            mesh->indices[idx++] = i2;
+            mesh->indices[idx++] = i1;
+            mesh->indices[idx++] = i1;
+            mesh->indices[idx++] = i2;
+            mesh->indices[idx++] = i3;
+        }
+    }
+    return mesh;
+}
+
+static Mesh* make_sphere_mesh(float radius, uint32_t rings, uint32_t segments) {
+    Mesh* mesh = mesh_allocate((rings + 1) * (segments + 1), rings * segments * 6);
+    uint32_t v = 0, idx = 0;
+    for (uint32_t r = 0; r <= rings; r++) {
+        float phi = 3.14159265f * (float)r / (float)rings;
+        for (uint32_t s = 0; s <= segments; s++) {
+            float theta = 6.2831853f * (float)s / (float)segments;
+            vec3_t n = vec3(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+            mesh->vertices[v++] = vertex_create_components(radius * n.x, radius * n.y, radius * n.z,
+                                                           (float)s / (float)segments, (float)r / (float)rings, n.x, n.y, n.z);
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s, b = a + segments + 1;
+            mesh->indices[idx++] = a;
+            mesh->indices[idx++] = b;
+            mesh->indices[idx++] = a + 1;
+            mesh->indices[idx++] = a + 1;
+            mesh->indices[idx++] = b;
+            mesh->indices[idx++] = b + 1;
+        }
+    }
+    return mesh;
+}
+
+// Encode and decode an index buffer; returns the encoded size (0 on mismatch)
+static size_t index_round_trip(const uint32_t* indices, uint32_t index_count) {
+    size_t bound = mesh_codec_index_bound(index_count);
+    uint8_t* encoded = (uint8_t*)malloc(bound);
+    uint32_t* decoded = (uint32_t*)malloc((index_count + 1) * sizeof(uint32_t));
+    size_t size = mesh_codec_encode_indices(encoded, bound, indices, index_count);
+    int ok = size > 0 && mesh_codec_decode_indices(decoded, index_count, encoded, size) &&
+             memcmp(decoded, indices, index_count * sizeof(uint32_t)) == 0;
+    free(encoded);
+    free(decoded);
+    return ok ? size : 0;
+}
+
+static size_t vertex_round_trip(const void* vertices, uint32_t vertex_count, uint32_t vertex_size) {
+    size_t bound = mesh_codec_vertex_bound(vertex_count, vertex_size);
+    uint8_t* encoded = (uint8_t*)malloc(bound);
+    uint8_t* decoded = (uint8_t*)malloc((size_t)vertex_count * vertex_size + 1);
+    size_t size = mesh_codec_encode_vertices(encoded, bound, vertices, vertex_count, vertex_size);
+    int ok = size > 0 && mesh_codec_decode_vertices(decoded, vertex_count, vertex_size, encoded, size) &&
+             memcmp(decoded, vertices, (size_t)vertex_count * vertex_size) == 0;
+    free(encoded);
+    free(decoded);
+    return ok ? size : 0;
+}
+
+// ============================================================================
+// INDEX STREAM TESTS
+// ============================================================================
+
+static void test_index_round_trip(void) {
+    printf("\n--- Index Stream Tests ---\n");
+
+    Mesh* grid = make_grid_mesh(64, 64);
+    size_t grid_size = index_round_trip(grid->indices, grid->index_count);
+    TEST_ASSERT(grid_size > 0, "Grid indices should round-trip");
+    printf("  Grid: %.2f bytes/triangle\n", (double)grid_size / grid->triangle_count);
+    TEST_ASSERT(grid_size < 2 * (size_t)grid->triangle_count, "Scanline grid should cost under 2 bytes/triangle");
+
+    Mesh* sphere = make_sphere_mesh(1.0f, 32, 64);
+    size_t sphere_size = index_round_trip(sphere->indices, sphere->index_count);
+    TEST_ASSERT(sphere_size > 0, "Sphere indices should round-trip");
+    TEST_ASSERT(sphere_size < 2 * (size_t)sphere->triangle_count, "Sphere should cost under 2 bytes/triangle");
+
+    // Rotated triangles keep their winding and first vertex
+    for (uint32_t t = 0; t < sphere->triangle_count; t += 3) {
+        uint32_t* tri = sphere->indices + 3 * t;
+        uint32_t first = tri[0];
+        tri[0] = tri[1];
+        tri[1] = tri[2];
+        tri[2] = first;
+    }
+    TEST_ASSERT(index_round_trip(sphere->indices, sphere->index_count) > 0, "Rotated triangles should round-trip exactly");
+
+    const uint32_t soup_count = 3000;
+    uint32_t* soup = (uint32_t*)malloc(soup_count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < soup_count; i++) soup[i] = random_u32() % 5000;
+    TEST_ASSERT(index_round_trip(soup, soup_count) > 0, "Random triangle soup should round-trip");
+    for (uint32_t i = 0; i < soup_count; i++) soup[i] = random_u32();
+    TEST_ASSERT(index_round_trip(soup, soup_count) > 0, "Full-range 32-bit indices should round-trip");
+    for (uint32_t i = 0; i < soup_count; i++) soup[i] = 7;
+    TEST_ASSERT(index_round_trip(soup, soup_count) > 0, "Degenerate triangles should round-trip");
+    free(soup);
+
+    uint8_t empty[4];
+    size_t empty_size = mesh_codec_encode_indices(empty, sizeof(empty), NULL, 0);
+    TEST_ASSERT_EQUAL((size_t)1, empty_size, "An empty index buffer should encode to its tag");
+    TEST_ASSERT(mesh_codec_decode_indices(NULL, 0, empty, empty_size), "An empty index buffer should decode");
+
+    release_mesh(grid);
+    release_mesh(sphere);
+}
+
+// ============================================================================
+// VERTEX STREAM TESTS
+// ============================================================================
+
+static void test_vertex_round_trip(void) {
+    printf("\n--- Vertex Stream Tests ---\n");
+
+    const uint32_t sizes[5] = { 4, 12, 32, 64, 256 };
+    const uint32_t counts[9] = { 1, 15, 16, 17, 31, 255, 256, 257, 1000 };
+    uint8_t* data = (uint8_t*)malloc(1000 * 256);
+    int random_ok = 1, smooth_ok = 1;
+    for (uint32_t s = 0; s < 5; s++) {
+        for (uint32_t c = 0; c < 9; c++) {
+            size_t bytes = (size_t)counts[c] * sizes[s];
+            for (size_t i = 0; i < bytes; i++) data[i] = (uint8_t)random_u32();
+            random_ok &= vertex_round_trip(data, counts[c], sizes[s]) > 0;
+            for (size_t i = 0; i < bytes; i++) data[i] = (uint8_t)((i / sizes[s]) * (1 + i % 3) + (random_u32() & 3));
+            smooth_ok &= vertex_round_trip(data, counts[c], sizes[s]) > 0;
+        }
+    }
+    TEST_ASSERT(random_ok, "Random bytes should round-trip at every stride and block boundary");
+    TEST_ASSERT(smooth_ok, "Slowly varying bytes should round-trip at every stride and block boundary");
+    free(data);
+
+    Mesh* grid = make_grid_mesh(64, 64);
+    size_t grid_size = vertex_round_trip(grid->vertices, grid->vertex_count, sizeof(Vertex));
+    TEST_ASSERT(grid_size > 0, "Grid vertices should round-trip");
+    printf("  Grid: %.2f bytes/vertex (raw %zu)\n", (double)grid_size / grid->vertex_count, sizeof(Vertex));
+    TEST_ASSERT(grid_size < (size_t)grid->vertex_count * sizeof(Vertex) / 2, "Grid vertices should compress below half size");
+    release_mesh(grid);
+
+    uint8_t empty[4];
+    size_t empty_size = mesh_codec_encode_vertices(empty, sizeof(empty), NULL, 0, 32);
+    TEST_ASSERT_EQUAL((size_t)1, empty_size, "An empty vertex buffer should encode to its tag");
+    TEST_ASSERT(mesh_codec_decode_vertices(NULL, 0, 32, empty, empty_size), "An empty vertex buffer should decode");
+}
+
+// ============================================================================
+// MESH AND INVALID INPUT TESTS
+// ============================================================================
+
+static void test_mesh_blob(void) {
+    printf("\n--- Mesh Blob Tests ---\n");
+
+    Mesh* sphere = make_sphere_mesh(2.0f, 24, 48);
+    size_t size = 0;
+    uint8_t* blob = mesh_codec_encode_mesh(sphere, &size);
+    TEST_ASSERT_NOT_NULL(blob, "Mesh should encode");
+    mesh_codec_print("Sphere", blob, size);
+
+    Mesh* decoded = mesh_codec_decode_mesh(blob, size);
+    TEST_ASSERT_NOT_NULL(decoded, "Mesh should decode");
+    TEST_ASSERT(decoded && decoded->vertex_count == sphere->vertex_count && decoded->triangle_count == sphere->triangle_count,
+                "Decoded mesh should keep its counts");
+    TEST_ASSERT(decoded && memcmp(decoded->vertices, sphere->vertices, sphere->vertex_count * sizeof(Vertex)) == 0 &&
+                memcmp(decoded->indices, sphere->indices, sphere->index_count * sizeof(uint32_t)) == 0,
+                "Decoded mesh should be bit-identical");
+    if (decoded) release_mesh(decoded);
+
+    size_t raw = sphere->vertex_count * sizeof(Vertex) + sphere->index_count * sizeof(uint32_t);
+    TEST_ASSERT(size < raw / 2, "Encoded sphere should be under half its raw size");
+
+    printf("\n--- Invalid Input Tests ---\n");
+
+    uint8_t out[64];
+    uint32_t tri[3] = { 0, 1, 2 };
+    TEST_ASSERT_EQUAL((size_t)0, mesh_codec_encode_indices(out, sizeof(out), tri, 2), "Partial triangles should be rejected");
+    TEST_ASSERT_EQUAL((size_t)0, mesh_codec_encode_vertices(out, sizeof(out), tri, 1, 6), "Strides that are not a multiple of 4 should be rejected");
+    TEST_ASSERT_EQUAL((size_t)0, mesh_codec_encode_vertices(out, 4, sphere->vertices, 16, sizeof(Vertex)), "Short output buffers should be rejected");
+
+    // Every truncation of either stream must fail cleanly
+    MeshCodecHeader header;
+    memcpy(&header, blob, sizeof(header));
+    const uint8_t* vertex_stream = blob + sizeof(MeshCodecHeader);
+    const uint8_t* index_stream = vertex_stream + header.vertex_bytes;
+    Vertex* vertices = (Vertex*)malloc(sphere->vertex_count * sizeof(Vertex));
+    uint32_t* indices = (uint32_t*)malloc(sphere->index_count * sizeof(uint32_t));
+    int truncated_rejected = 1;
+    for (size_t cut = 0; cut < header.vertex_bytes; cut += 1 + cut / 16) {
+        truncated_rejected &= !mesh_codec_decode_vertices(vertices, sphere->vertex_count, sizeof(Vertex), vertex_stream, cut);
+    }
+    for (size_t cut = 0; cut < header.index_bytes; cut += 1 + cut / 16) {
+        truncated_rejected &= !mesh_codec_decode_indices(indices, sphere->index_count, index_stream, cut);
+    }
+    TEST_ASSERT(truncated_rejected, "Truncated streams should be rejected");
+    TEST_ASSERT(!mesh_codec_decode_indices(indices, sphere->index_count, vertex_stream, header.vertex_bytes),
+                "Streams of the wrong kind should be rejected");
+    free(vertices);
+    free(indices);
+
+    // Well-formed streams whose indices name vertices the blob doesn't have
+    uint8_t bad_blob[sizeof(MeshCodecHeader) + 2048];
+    uint32_t bad_tri[3] = { 0, 1, 5 };
+    MeshCodecHeader bad_header = header;
+    bad_header.vertex_count = 3;
+    bad_header.index_count = 3;
+    bad_header.vertex_bytes = (uint32_t)mesh_codec_encode_vertices(bad_blob + sizeof(MeshCodecHeader),
+                                                                   mesh_codec_vertex_bound(3, sizeof(Vertex)), sphere->vertices, 3, sizeof(Vertex));
+    bad_header.index_bytes = (uint32_t)mesh_codec_encode_indices(bad_blob + sizeof(MeshCodecHeader) + bad_header.vertex_bytes,
+                                                                 mesh_codec_index_bound(3), bad_tri, 3);
+    memcpy(bad_blob, &bad_header, sizeof(bad_header));
+    TEST_ASSERT(bad_header.vertex_bytes > 0 && bad_header.index_bytes > 0 &&
+                mesh_codec_decode_mesh(bad_blob, sizeof(MeshCodecHeader) + bad_header.vertex_bytes + bad_header.index_bytes) == NULL,
+                "Blobs with out-of-range indices should be rejected");
+
+    TEST_ASSERT(mesh_codec_decode_mesh(blob, size - 1) == NULL, "Truncated blobs should be rejected");
+    blob[0] ^= 0xFF;
+    TEST_ASSERT(mesh_codec_decode_mesh(blob, size) == NULL, "Blobs with a bad magic should be rejected");
+    TEST_ASSERT(mesh_codec_decode_mesh(NULL, 0) == NULL, "NULL blobs should be rejected");
+
+    free(blob);
+    release_mesh(sphere);
+}
+
+// ============================================================================
+// ASSET TESTS
+// ============================================================================
+
+static void test_asset_meshes(void) {
+    printf("\n--- Asset Tests ---\n");
+
+    const char* names[2] = { "UnitBox.fbx", "UnitSphere.fbx" };
+    for (uint32_t n = 0; n < 2; n++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", assets_dir, names[n]);
+        char* err = NULL;
+        Model3D* model = fbx_load_model(path, &err);
+        if (!model) {
+            printf("  %s unavailable: %s\n", names[n], err ? err : "(no error)");
+            fbx_free_error(err);
+            TEST_ASSERT(0, "Sample asset should load");
+            continue;
+        }
+
+        int identical = 1;
+        size_t encoded_total = 0, raw_total = 0;
+        uint32_t triangle_total = 0;
+        for (uint32_t m = 0; m < model->mesh_count; m++) {
+            const Mesh* mesh = &model->meshes[m];
+            size_t size = 0;
+            uint8_t* blob = mesh_codec_encode_mesh(mesh, &size);
+            Mesh* decoded = blob ? mesh_codec_decode_mesh(blob, size) : NULL;
+            identical &= decoded && memcmp(decoded->vertices, mesh->vertices, mesh->vertex_count * sizeof(Vertex)) == 0 &&
+                         memcmp(decoded->indices, mesh->indices, mesh->index_count * sizeof(uint32_t)) == 0;
+            mesh_codec_print(names[n], blob, size);
+            encoded_total += size;
+            raw_total += mesh->vertex_count * sizeof(Vertex) + mesh->index_count * sizeof(uint32_t);
+            triangle_total += mesh->triangle_count;
+            if (decoded) release_mesh(decoded);
+            free(blob);
+        }
+        printf("  %s: %.2f bytes/triangle encoded, %.2f raw\n", names[n],
+               triangle_total ? (double)encoded_total / triangle_total : 0.0,
+               triangle_total ? (double)raw_total / triangle_total : 0.0);
+        TEST_ASSERT(identical, "Sample asset should round-trip bit-exactly");
+        TEST_ASSERT(encoded_total < raw_total, "Sample asset should encode smaller than raw");
+        model3d_free(model);
+        free(model);
+    }
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    Mesh* grid = make_grid_mesh(724, 724);
+    size_t vertex_raw = grid->vertex_count * sizeof(Vertex);
+    size_t index_raw = grid->index_count * sizeof(uint32_t);
+
+    size_t vertex_bound = mesh_codec_vertex_bound(grid->vertex_count, sizeof(Vertex));
+    size_t index_bound = mesh_codec_index_bound(grid->index_count);
+    uint8_t* vertex_stream = (uint8_t*)malloc(vertex_bound);
+    uint8_t* index_stream = (uint8_t*)malloc(index_bound);
+    double start = now_ms();
+    size_t vertex_bytes = mesh_codec_encode_vertices(vertex_stream, vertex_bound, grid->vertices, grid->vertex_count, sizeof(Vertex));
+    size_t index_bytes = mesh_codec_encode_indices(index_stream, index_bound, grid->indices, grid->index_count);
+    double encode_ms = now_ms() - start;
+    printf("  Grid %u vertices, %u triangles: encode %.2f ms, %.2f bytes/vertex, %.2f bytes/triangle\n",
+           grid->vertex_count, grid->triangle_count, encode_ms, (double)vertex_bytes / grid->vertex_count,
+           (double)index_bytes / grid->triangle_count);
+
+    Vertex* vertices = (Vertex*)malloc(vertex_raw);
+    uint32_t* indices = (uint32_t*)malloc(index_raw);
+    const int runs = 5;
+    double vertex_ms = 1.0e9, index_ms = 1.0e9, copy_ms = 1.0e9;
+    int ok = 1;
+    for (int r = 0; r < runs; r++) {
+        start = now_ms();
+        ok &= mesh_codec_decode_vertices(vertices, grid->vertex_count, sizeof(Vertex), vertex_stream, vertex_bytes);
+        double t = now_ms() - start;
+        vertex_ms = t < vertex_ms ? t : vertex_ms;
+        start = now_ms();
+        ok &= mesh_codec_decode_indices(indices, grid->index_count, index_stream, index_bytes);
+        t = now_ms() - start;
+        index_ms = t < index_ms ? t : index_ms;
+        start = now_ms();
+        memcpy(vertices, grid->vertices, vertex_raw);
+        memcpy(indices, grid->indices, index_raw);
+        t = now_ms() - start;
+        copy_ms = t < copy_ms ? t : copy_ms;
+    }
+    ok &= memcmp(vertices, grid->vertices, vertex_raw) == 0 && memcmp(indices, grid->indices, index_raw) == 0;
+
+    double vertex_gbps = (double)vertex_raw / (vertex_ms * 1.0e6);
+    double index_gbps = (double)index_raw / (index_ms * 1.0e6);
+    printf("  Decode: vertices %.2f ms (%.2f GB/s), indices %.2f ms (%.2f GB/s), raw memcpy %.2f ms\n",
+           vertex_ms, vertex_gbps, index_ms, index_gbps, copy_ms);
+
+    TEST_ASSERT(ok, "Large grid should round-trip");
+    TEST_ASSERT(vertex_gbps > 1.0, "Vertex decode should exceed 1 GB/s of output");
+    TEST_ASSERT(index_gbps > 0.5, "Index decode should exceed 0.5 GB/s of output");
+
+    free(vertices);
+    free(indices);
+    free(vertex_stream);
+    free(index_stream);
+    release_mesh(grid);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Mesh Codec Unit Tests\n");
+    printf("===================================\n");
+
+    test_index_round_trip();
+    test_vertex_round_trip();
+    test_mesh_blob();
+    test_asset_meshes();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
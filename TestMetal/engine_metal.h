@@ -118,6 +118,14 @@ void metal_engine_render_model_with_matrix(MetalEngine* engine, MetalModelHandle
 // Free uploaded model resources
 void metal_engine_free_model(MetalModelHandle model);
 
+// Free model once the command buffers submitted so far have completed.
+// Use this for models the GPU may still be drawing.
+void metal_engine_retire_model(MetalEngine* engine, MetalModelHandle model);
+
+// Compact the shared model buffers, moving at most maxBytes (0: no limit).
+// Moves are CPU copies in shared memory: call only while the GPU is idle.
+uint64_t metal_engine_defragment_models(MetalEngine* engine, uint64_t maxBytes);
+
 // Update dynamic buffer state
 void metal_engine_update_dynamic_buffer_state(MetalEngine* engine);
 
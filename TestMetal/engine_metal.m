@@ -3,6 +3,9 @@
 #import "engine_world.h"
 #import "engine_2d.h"
 #import "ShaderTypes.h"
+#import "engine_vertex_layout.h"
+#import "engine_tlsf.h"
+#import "engine_constants.h"
 // engine_metal_shaders.h removed to avoid typedef conflicts
 #import <Foundation/Foundation.h>
 #import <Metal/Metal.h>
@@ -16,15 +19,25 @@
 
 #define BufferIndexVertices 0
 #define BufferIndexIndices 1
-#define BufferIndexUniforms 2
+#define BufferIndexFrameConstants 2
 
 #define TextureIndexColorMap 0
 #define SamplerIndexColorMap 0
 
-#define VertexPositionOffset 0
-#define VertexTexcoordOffset 16
-#define VertexNormalOffset 24
-#define VertexStride 36
+// Vertex attribute offsets and strides come from the layouts in
+// engine_vertex_layout.h; stream 1 of a two-stream layout binds here
+#define BufferIndexVertexStream1 3
+
+// Per-view and per-draw blocks from engine_constants.h (per-frame is 2)
+#define BufferIndexViewConstants 4
+#define BufferIndexDrawConstants 5
+
+// Model vertex and index data is carved out of shared pool buffers
+#define MESH_ARENA_POOL_SIZE (16u << 20)
+
+// Constant buffers: one per frame in flight, grown to fit the draw count
+#define MAX_BUFFERS_IN_FLIGHT 3
+#define INITIAL_DRAW_CAPACITY 1024
 
 // Performance and rendering constants
 #define FALLBACK_TEXTURE_SIZE 512
@@ -45,24 +58,25 @@
 #define METAL_DEBUG(fmt, ...) fprintf(stderr, "Metal Debug: " fmt "\n", ##__VA_ARGS__)
 #define METAL_INFO(fmt, ...) fprintf(stderr, "Metal Info: " fmt "\n", ##__VA_ARGS__)
 
-// Define MetalUniforms struct for uniform buffer sizing
-typedef struct {
-    float projectionMatrix[16];    // 4x4 matrix
-    float modelViewMatrix[16];     // 4x4 matrix
-    float modelMatrix[16];         // 4x4 matrix
-    float viewMatrix[16];          // 4x4 matrix
-    float normalMatrix[16];        // 4x4 matrix
-    float cameraPosition[3];       // 3D vector
-    float time;                    // float
-} MetalUniforms;
+// Pool buffers behind the TLSF allocator that holds every model's meshes
+typedef struct MetalMeshArena {
+    TlsfAllocator* allocator;
+    id<MTLDevice> device;
+    __strong id<MTLBuffer> pools[TLSF_DEFAULT_MAX_POOLS];
+} MetalMeshArena;
 
 // MetalModel structure to hold uploaded model data
 typedef struct MetalModel {
-    __strong id<MTLBuffer>* vertexBuffers;      // Array of vertex buffers (one per mesh)
-    __strong id<MTLBuffer>* indexBuffers;       // Array of index buffers (one per mesh)
+    MetalMeshArena* arena;              // Arena the allocations below come from
+    uint32_t* vertexAllocations;        // TLSF handle of each mesh's vertices (all streams)
+    uint32_t* indexAllocations;         // TLSF handle of each mesh's indices
     uint32_t* indexCounts;              // Array of index counts (one per mesh)
+    uint32_t* vertexCounts;             // Array of vertex counts (one per mesh)
+    uint32_t* vertexLayouts;            // VertexLayoutId of each vertex buffer
     uint32_t meshCount;                 // Number of meshes in the model
     char* name;                         // Model name
+    uint32_t retireFrame;               // Frames before this one may still draw it
+    struct MetalModel* nextRetired;     // Retired list, freed as frames complete
 } MetalModel;
 
 #import <MetalKit/MetalKit.h>
@@ -76,36 +90,28 @@ typedef struct MetalModel {
 // Forward declarations
 struct EngineStateStruct; // Forward declaration to avoid circular includes
 
-// Helper function to convert mat4_t to float array (column-major order for Metal)
-static void mat4_to_float_array(mat4_t* mat, float* arr) {
-    // Convert from mat4_t structure to column-major float array
-    // mat4_t stores: x, y, z, w where each is a vec4_t
-    // We need column-major order for Metal: [col0, col1, col2, col3]
-    
-    // Use direct memory copy for better performance
-    memcpy(arr, mat, sizeof(mat4_t));
-}
-
 // Metal device and pipeline state
 typedef struct {
     id<MTLDevice> device;
     id<MTLCommandQueue> commandQueue;
     id<MTLRenderPipelineState> renderPipelineState;
+    id<MTLRenderPipelineState> layoutPipelineStates[VERTEX_LAYOUT_COUNT]; // [VERTEX_LAYOUT_STANDARD] is renderPipelineState
     id<MTLDepthStencilState> depthState;
     MTLVertexDescriptor* mtlVertexDescriptor;
 } MetalDeviceState;
 
 // Metal buffer and resource management
 typedef struct {
-    id<MTLBuffer> dynamicUniformBuffer;
+    id<MTLBuffer> constantBuffers[MAX_BUFFERS_IN_FLIGHT];
     id<MTLTexture> colorMap;
     MTKMesh* mesh;
     MetalModel* uploadedModel;
+    MetalMeshArena* meshArena;
+    MetalModel* retiredModels;          // Replaced models waiting on in-flight frames
     
-    // Buffer management
-    uint32_t uniformBufferOffset;
-    uint8_t uniformBufferIndex;
-    void* uniformBufferAddress;
+    // Buffer management: frame and view blocks once, then one block per draw
+    ConstantsWriter constants;
+    uint8_t constantBufferIndex;
     
     // Manual mesh buffers (for our custom cube)
     id<MTLBuffer> vertexBuffer;
@@ -116,6 +122,8 @@ typedef struct {
 // Metal rendering and game state
 typedef struct {
     uint32_t frameCount;
+    uint32_t completedFrames;           // Frames whose command buffer has completed (atomic)
+    id<MTLCommandBuffer> lastCommandBuffer;
     float rotationAngle;
     int viewportWidth;
     int viewportHeight;
@@ -150,6 +158,7 @@ typedef struct {
     id<MTLBuffer> uiVertexBuffer;
     id<MTLBuffer> uiIndexBuffer;
     id<MTLBuffer> uiUniformBuffer;
+    id<MTLBuffer> materialParamsBuffer;     // GPU copy of the UI material parameter blocks
 } MetalUIState;
 
 typedef struct {
@@ -161,133 +170,246 @@ typedef struct {
 } MetalEngineImpl;
 
 // Constants
-static const NSUInteger kMaxBuffersInFlight = 3;
-static const size_t kAlignedUniformsSize = (sizeof(MetalUniforms) & ~0xFF) + 0x100;
+static const NSUInteger kMaxBuffersInFlight = MAX_BUFFERS_IN_FLIGHT;
 
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
 
-// Internal helper function to render a single mesh
+// Buffer index a vertex stream binds to
+static NSUInteger metal_vertex_stream_index(uint32_t stream) {
+    return stream == 0 ? BufferIndexVertices : BufferIndexVertexStream1;
+}
+
+// Metal vertex descriptor for a layout, straight from its attribute table
+static MTLVertexDescriptor* create_vertex_descriptor(const VertexLayout* layout) {
+    static const MTLVertexFormat formats[VERTEX_FORMAT_COUNT] = {
+#define METAL_VERTEX_FORMAT(name, components, bytes, metal) MTLVertexFormat##metal,
+        VERTEX_FORMAT_LIST(METAL_VERTEX_FORMAT)
+#undef METAL_VERTEX_FORMAT
+    };
+    
+    MTLVertexDescriptor* descriptor = [[MTLVertexDescriptor alloc] init];
+    for (uint32_t a = 0; a < layout->attribute_count; a++) {
+        const VertexAttributeDesc* attribute = &layout->attributes[a];
+        descriptor.attributes[attribute->semantic].format = formats[attribute->format];
+        descriptor.attributes[attribute->semantic].offset = attribute->offset;
+        descriptor.attributes[attribute->semantic].bufferIndex = metal_vertex_stream_index(attribute->stream);
+    }
+    for (uint32_t s = 0; s < layout->stream_count; s++) {
+        NSUInteger index = metal_vertex_stream_index(s);
+        descriptor.layouts[index].stride = layout->strides[s];
+        descriptor.layouts[index].stepRate = 1;
+        descriptor.layouts[index].stepFunction = MTLVertexStepFunctionPerVertex;
+    }
+    return descriptor;
+}
+
+// Backend callback: create the Metal buffer behind a new arena pool
+static int mesh_arena_pool_created(void* user, uint32_t pool, uint32_t size) {
+    MetalMeshArena* arena = (MetalMeshArena*)user;
+    if (pool >= TLSF_DEFAULT_MAX_POOLS) {
+        return 0;
+    }
+    arena->pools[pool] = [arena->device newBufferWithLength:size options:MTLResourceStorageModeShared];
+    if (!arena->pools[pool]) {
+        METAL_ERROR("Failed to create mesh arena pool %u (%u bytes)", pool, size);
+        return 0;
+    }
+    arena->pools[pool].label = [NSString stringWithFormat:@"MeshArena_Pool%u", pool];
+    METAL_INFO("Created mesh arena pool %u (%.1f MB)", pool, size / (1024.0 * 1024.0));
+    return 1;
+}
+
+// Backend callback: defragmentation move inside one shared pool
+static void mesh_arena_move(void* user, uint32_t pool, uint32_t srcOffset, uint32_t dstOffset, uint32_t size) {
+    MetalMeshArena* arena = (MetalMeshArena*)user;
+    uint8_t* contents = (uint8_t*)arena->pools[pool].contents;
+    memmove(contents + dstOffset, contents + srcOffset, size);
+}
+
+static MetalMeshArena* mesh_arena_create(id<MTLDevice> device) {
+    MetalMeshArena* arena = (MetalMeshArena*)calloc(1, sizeof(MetalMeshArena));
+    if (!arena) {
+        return NULL;
+    }
+    arena->device = device;
+    TlsfDesc desc = tlsf_desc_default();
+    desc.pool_size = MESH_ARENA_POOL_SIZE;
+    desc.on_pool_created = mesh_arena_pool_created;
+    desc.user = arena;
+    arena->allocator = tlsf_create(&desc);
+    if (!arena->allocator) {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+static void mesh_arena_destroy(MetalMeshArena* arena) {
+    if (!arena) return;
+    for (uint32_t i = 0; i < TLSF_DEFAULT_MAX_POOLS; i++) {
+        arena->pools[i] = nil;
+    }
+    arena->device = nil;
+    tlsf_destroy(arena->allocator);
+    free(arena);
+}
+
+// CPU address of an arena allocation
+static uint8_t* mesh_arena_contents(MetalMeshArena* arena, TlsfAllocation allocation) {
+    return (uint8_t*)arena->pools[allocation.pool].contents + allocation.offset;
+}
+
+// Free retired models whose last frame has completed; all of them when force is set
+static void release_retired_models(MetalEngineImpl* impl, int force) {
+    uint32_t completed = __atomic_load_n(&impl->render.completedFrames, __ATOMIC_ACQUIRE);
+    MetalModel** link = &impl->resources.retiredModels;
+    while (*link) {
+        MetalModel* model = *link;
+        if (force || completed >= model->retireFrame) {
+            *link = model->nextRetired;
+            metal_engine_free_model((MetalModelHandle)model);
+        } else {
+            link = &model->nextRetired;
+        }
+    }
+}
+
+// Internal helper function to render a single mesh. boundBuffers tracks what
+// each vertex stream slot holds, so meshes sharing a pool only move offsets.
 static void render_single_mesh(id<MTLRenderCommandEncoder> encoder, 
-                              id<MTLBuffer> vertexBuffer, 
-                              id<MTLBuffer> indexBuffer, 
+                              MetalMeshArena* arena,
+                              uint32_t vertexAllocation, 
+                              uint32_t indexAllocation, 
                               uint32_t indexCount, 
+                              const VertexLayout* layout,
+                              uint32_t vertexCount,
                               uint32_t meshIndex,
+                              __unsafe_unretained id<MTLBuffer>* boundBuffers,
                               int debugMode) {
-    if (!vertexBuffer || !indexBuffer || indexCount == 0) {
+    TlsfAllocation vertices = tlsf_allocation(arena->allocator, vertexAllocation);
+    TlsfAllocation indices = tlsf_allocation(arena->allocator, indexAllocation);
+    if (vertices.size == 0 || indices.size == 0 || indexCount == 0) {
         METAL_ERROR("Invalid mesh %u for rendering", meshIndex);
         return;
     }
+    id<MTLBuffer> vertexBuffer = arena->pools[vertices.pool];
+    id<MTLBuffer> indexBuffer = arena->pools[indices.pool];
     
     if (debugMode) {
-        METAL_DEBUG("Rendering mesh %u: vertexBuffer=%p, indexBuffer=%p, indexCount=%u", 
-                   meshIndex, vertexBuffer, indexBuffer, indexCount);
-        METAL_DEBUG("Drawing mesh %u: indexCount=%u, indexBuffer.length=%lu", 
-                   meshIndex, indexCount, (unsigned long)indexBuffer.length);
-        METAL_DEBUG("Buffer pointer during draw: %p", indexBuffer);
+        METAL_DEBUG("Rendering mesh %u: vertices in pool %u at %u, indices in pool %u at %u, indexCount=%u", 
+                   meshIndex, vertices.pool, vertices.offset, indices.pool, indices.offset, indexCount);
     }
     
-    // Set vertex buffer
-    [encoder setVertexBuffer:vertexBuffer offset:0 atIndex:BufferIndexVertices];
+    // Set vertex buffer, one binding per stream of the layout
+    size_t streamOffset = vertices.offset;
+    for (uint32_t s = 0; s < layout->stream_count; s++) {
+        NSUInteger index = metal_vertex_stream_index(s);
+        uint32_t slot = index == BufferIndexVertices ? 0 : 1;
+        if (boundBuffers[slot] == vertexBuffer) {
+            [encoder setVertexBufferOffset:streamOffset atIndex:index];
+        } else {
+            [encoder setVertexBuffer:vertexBuffer offset:streamOffset atIndex:index];
+            boundBuffers[slot] = vertexBuffer;
+        }
+        streamOffset += vertex_layout_stream_size(layout, s, vertexCount);
+    }
     
     // Draw indexed primitives
     [encoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
                         indexCount:indexCount
                          indexType:MTLIndexTypeUInt32
                        indexBuffer:indexBuffer
-                 indexBufferOffset:0];
+                 indexBufferOffset:indices.offset];
 }
 
 // Internal helper function to render all meshes in a model
-static void render_model_meshes(MetalModel* metalModel, 
+static void render_model_meshes(MetalEngineImpl* impl,
+                               MetalModel* metalModel, 
                                id<MTLRenderCommandEncoder> encoder, 
                                int debugMode) {
     if (debugMode) {
         METAL_DEBUG("Rendering model: %s with %u meshes", metalModel->name, metalModel->meshCount);
     }
     
-    // Render each mesh
+    // Render each mesh, switching pipelines only for non-standard layouts
+    uint32_t boundLayout = VERTEX_LAYOUT_STANDARD;
+    __unsafe_unretained id<MTLBuffer> boundBuffers[VERTEX_LAYOUT_MAX_STREAMS] = { nil, nil };
     for (uint32_t i = 0; i < metalModel->meshCount; i++) {
+        uint32_t layoutId = metalModel->vertexLayouts[i];
+        if (layoutId != boundLayout) {
+            [encoder setRenderPipelineState:impl->device.layoutPipelineStates[layoutId]];
+            boundLayout = layoutId;
+        }
         render_single_mesh(encoder, 
-                          metalModel->vertexBuffers[i], 
-                          metalModel->indexBuffers[i], 
+                          metalModel->arena,
+                          metalModel->vertexAllocations[i], 
+                          metalModel->indexAllocations[i], 
                           metalModel->indexCounts[i], 
+                          vertex_layout_get(layoutId),
+                          metalModel->vertexCounts[i],
                           i, 
+                          boundBuffers,
                           debugMode);
     }
+    if (boundLayout != VERTEX_LAYOUT_STANDARD) {
+        [encoder setRenderPipelineState:impl->device.renderPipelineState];
+    }
 }
 
-// Internal helper function to convert vertex data to Metal format
-static float* convert_vertex_data_to_metal(Mesh* mesh) {
-    if (!mesh->vertices || mesh->vertex_count == 0) {
-        return NULL;
+// Internal helper function to place a mesh in the arena. A mesh in the
+// standard layout is already GPU-ready, so its vertices are copied as is;
+// other layouts are packed straight into the shared pool.
+static int create_mesh_allocations(MetalMeshArena* arena, 
+                                  Mesh* mesh, 
+                                  uint32_t meshIndex,
+                                  uint32_t* vertexAllocation,
+                                  uint32_t* indexAllocation) {
+    const VertexLayout* layout = mesh_vertex_layout(mesh);
+    if (!layout) {
+        METAL_ERROR("Unknown vertex layout %u for mesh %u", mesh->vertex_layout, meshIndex);
+        return METAL_FAILURE;
     }
     
-    // Convert vertices to Metal format (position + texcoord + normal)
-    size_t vertexDataSize = mesh->vertex_count * sizeof(float) * VERTEX_COMPONENT_COUNT;
-    float* vertexData = (float*)malloc(vertexDataSize);
-    if (!vertexData) {
-        METAL_ERROR("Failed to allocate vertex data for mesh");
-        return NULL;
+    // Allocate vertex and index ranges
+    size_t vertexDataSize = vertex_layout_size(layout, mesh->vertex_count);
+    size_t indexDataSize = mesh->index_count * sizeof(uint32_t);
+    if (vertexDataSize > UINT32_MAX || indexDataSize > UINT32_MAX) {
+        METAL_ERROR("Mesh %u is too large for the mesh arena", meshIndex);
+        return METAL_FAILURE;
     }
-    
-    // Pack vertex data: position(3) + texcoord(2) + normal(3) = VERTEX_COMPONENT_COUNT floats
-    for (uint32_t j = 0; j < mesh->vertex_count; j++) {
-        Vertex* vertex = &mesh->vertices[j];
-        float* dst = vertexData + j * VERTEX_COMPONENT_COUNT;
-        
-        // Position
-        dst[0] = vertex->position.x;
-        dst[1] = vertex->position.y;
-        dst[2] = vertex->position.z;
-        
-        // TexCoord
-        dst[3] = vertex->texcoord.x;
-        dst[4] = vertex->texcoord.y;
-        
-        // Normal
-        dst[5] = vertex->normal.x;
-        dst[6] = vertex->normal.y;
-        dst[7] = vertex->normal.z;
+    *vertexAllocation = tlsf_alloc(arena->allocator, (uint32_t)vertexDataSize, 0);
+    *indexAllocation = tlsf_alloc(arena->allocator, (uint32_t)indexDataSize, 0);
+    if (*vertexAllocation == TLSF_INVALID || *indexAllocation == TLSF_INVALID) {
+        METAL_ERROR("Failed to allocate arena space for mesh %u", meshIndex);
+        tlsf_free(arena->allocator, *vertexAllocation);
+        tlsf_free(arena->allocator, *indexAllocation);
+        return METAL_FAILURE;
     }
     
-    return vertexData;
-}
-
-// Internal helper function to create Metal buffers for a mesh
-static int create_mesh_buffers(id<MTLDevice> device, 
-                              Mesh* mesh, 
-                              float* vertexData, 
-                              uint32_t meshIndex,
-                              const char* modelName,
-                              id<MTLBuffer>* vertexBuffer,
-                              id<MTLBuffer>* indexBuffer) {
-    // Create vertex buffer
-    size_t vertexDataSize = mesh->vertex_count * sizeof(float) * VERTEX_COMPONENT_COUNT;
-    *vertexBuffer = [device newBufferWithBytes:vertexData
-                                       length:vertexDataSize
-                                      options:MTLResourceStorageModeShared];
-    (*vertexBuffer).label = [NSString stringWithFormat:@"%@_Mesh%u_Vertices", 
-                             [NSString stringWithUTF8String:modelName], meshIndex];
-    
-    // Create index buffer
-    size_t indexBufferSize = mesh->index_count * sizeof(uint32_t);
-    METAL_DEBUG("Creating index buffer: mesh->index_count=%u, sizeof(uint32_t)=%zu, total size=%zu", 
-                mesh->index_count, sizeof(uint32_t), indexBufferSize);
-    METAL_DEBUG("mesh->indices pointer: %p", mesh->indices);
-    
-    if (mesh->indices && mesh->index_count > 0) {
-        METAL_DEBUG("First few indices: %u, %u, %u, %u, %u", 
-                    mesh->indices[0], mesh->indices[1], mesh->indices[2], mesh->indices[3], mesh->indices[4]);
+    // Fill vertex data
+    uint8_t* vertexData = mesh_arena_contents(arena, tlsf_allocation(arena->allocator, *vertexAllocation));
+    if (vertex_layout_matches_vertex(layout)) {
+        memcpy(vertexData, mesh->vertices, vertexDataSize);
+    } else {
+        void* streams[VERTEX_LAYOUT_MAX_STREAMS] = { NULL, NULL };
+        size_t streamOffset = 0;
+        for (uint32_t s = 0; s < layout->stream_count; s++) {
+            streams[s] = vertexData + streamOffset;
+            streamOffset += vertex_layout_stream_size(layout, s, mesh->vertex_count);
+        }
+        if (!vertex_layout_pack(mesh->vertex_layout, mesh->vertices, mesh->vertex_count, streams)) {
+            METAL_ERROR("Failed to pack vertices of mesh %u into layout %s", meshIndex, layout->name);
+            tlsf_free(arena->allocator, *vertexAllocation);
+            tlsf_free(arena->allocator, *indexAllocation);
+            return METAL_FAILURE;
+        }
     }
     
-    *indexBuffer = [device newBufferWithBytes:mesh->indices
-                                      length:indexBufferSize
-                                     options:MTLResourceStorageModeShared];
-    (*indexBuffer).label = [NSString stringWithFormat:@"%@_Mesh%u_Indices", 
-                           [NSString stringWithUTF8String:modelName], meshIndex];
-    METAL_DEBUG("Created index buffer with length: %lu", (unsigned long)(*indexBuffer).length);
+    // Fill index data
+    memcpy(mesh_arena_contents(arena, tlsf_allocation(arena->allocator, *indexAllocation)),
+           mesh->indices, indexDataSize);
     
     return METAL_SUCCESS;
 }
@@ -352,11 +474,20 @@ void metal_engine_shutdown(MetalEngine* engine) {
             impl->resources.indexBuffer = nil;
         }
         
-        // Release uploaded model
+        // Let the last frame finish with the retired models before freeing them
+        if (impl->render.lastCommandBuffer) {
+            [impl->render.lastCommandBuffer waitUntilCompleted];
+            impl->render.lastCommandBuffer = nil;
+        }
+        release_retired_models(impl, 1);
+        
+        // Release uploaded model, then the arena its meshes live in
         if (impl->resources.uploadedModel) {
             metal_engine_free_model((MetalModelHandle)impl->resources.uploadedModel);
             impl->resources.uploadedModel = NULL;
         }
+        mesh_arena_destroy(impl->resources.meshArena);
+        impl->resources.meshArena = NULL;
         
         // Note: In a real implementation, we would release other Metal objects here
     }
@@ -391,29 +522,17 @@ int metal_engine_load_metal_with_view(MetalEngine* engine, MetalViewHandle view)
     }
     
     // Create vertex descriptor
-    impl->device.mtlVertexDescriptor = [[MTLVertexDescriptor alloc] init];
-    
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributePosition].format = MTLVertexFormatFloat3;
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributePosition].offset = 0;
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributePosition].bufferIndex = 0; // Use buffer 0 for all vertex data
-    
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributeTexcoord].format = MTLVertexFormatFloat2;
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributeTexcoord].offset = 12; // After position (3 floats * 4 bytes)
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributeTexcoord].bufferIndex = 0; // Use buffer 0 for all vertex data
-    
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributeNormal].format = MTLVertexFormatFloat3;
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributeNormal].offset = 20; // After texcoord (3 + 2 floats * 4 bytes)
-    impl->device.mtlVertexDescriptor.attributes[VertexAttributeNormal].bufferIndex = 0; // Use buffer 0 for all vertex data
-    
-    impl->device.mtlVertexDescriptor.layouts[0].stride = 32; // 8 floats * 4 bytes (3 pos + 2 tex + 3 normal)
-    impl->device.mtlVertexDescriptor.layouts[0].stepRate = 1;
-    impl->device.mtlVertexDescriptor.layouts[0].stepFunction = MTLVertexStepFunctionPerVertex;
-    
-    // Create uniform buffer
-    NSUInteger uniformBufferSize = kAlignedUniformsSize * kMaxBuffersInFlight;
-    impl->resources.dynamicUniformBuffer = [impl->device.device newBufferWithLength:uniformBufferSize
-                                                           options:MTLResourceStorageModeShared];
-    impl->resources.dynamicUniformBuffer.label = @"UniformBuffer";
+    // The standard layout is the CPU Vertex struct, so uploads need no conversion
+    impl->device.mtlVertexDescriptor = create_vertex_descriptor(vertex_layout_get(VERTEX_LAYOUT_STANDARD));
+    
+    // Create constant buffers
+    ConstantsLayout constantsLayout = constants_layout(INITIAL_DRAW_CAPACITY);
+    for (NSUInteger i = 0; i < kMaxBuffersInFlight; i++) {
+        impl->resources.constantBuffers[i] = [impl->device.device newBufferWithLength:constantsLayout.size
+                                                                              options:MTLResourceStorageModeShared];
+        impl->resources.constantBuffers[i].label = @"ConstantBuffer";
+    }
+    constants_writer_begin(&impl->resources.constants, impl->resources.constantBuffers[0].contents, constantsLayout);
     
     // Create depth stencil state
     MTLDepthStencilDescriptor* depthStateDesc = [[MTLDepthStencilDescriptor alloc] init];
@@ -501,6 +620,19 @@ int metal_engine_create_pipeline(MetalEngine* engine) {
         return 0;
     }
     
+    // Same shaders for meshes declaring other vertex layouts
+    impl->device.layoutPipelineStates[VERTEX_LAYOUT_STANDARD] = impl->device.renderPipelineState;
+    for (uint32_t layoutId = 0; layoutId < VERTEX_LAYOUT_COUNT; layoutId++) {
+        if (layoutId == VERTEX_LAYOUT_STANDARD) continue;
+        pipelineStateDescriptor.vertexDescriptor = create_vertex_descriptor(vertex_layout_get(layoutId));
+        impl->device.layoutPipelineStates[layoutId] = [impl->device.device newRenderPipelineStateWithDescriptor:pipelineStateDescriptor error:&error];
+        if (!impl->device.layoutPipelineStates[layoutId]) {
+            METAL_ERROR("Failed to create pipeline state for vertex layout %s: %s",
+                        vertex_layout_get(layoutId)->name, error.localizedDescription.UTF8String);
+            return 0;
+        }
+    }
+    
     METAL_INFO("Metal pipeline created successfully");
     return 1;
 }
@@ -581,6 +713,15 @@ MetalModelHandle metal_engine_upload_model(MetalEngine* engine, Model3D* model)
     
     MetalEngineImpl* impl = (MetalEngineImpl*)engine;
     
+    // All models share one arena, created with the first upload
+    if (!impl->resources.meshArena) {
+        impl->resources.meshArena = mesh_arena_create(impl->device.device);
+        if (!impl->resources.meshArena) {
+            fprintf(stderr, "Failed to create mesh arena\n");
+            return NULL;
+        }
+    }
+    
     // Allocate MetalModel structure
     MetalModel* metalModel = (MetalModel*)malloc(sizeof(MetalModel));
     if (!metalModel) {
@@ -588,15 +729,23 @@ MetalModelHandle metal_engine_upload_model(MetalEngine* engine, Model3D* model)
         return NULL;
     }
     
+    metalModel->arena = impl->resources.meshArena;
     metalModel->meshCount = model->mesh_count;
     metalModel->name = model->name ? strdup(model->name) : strdup("UnnamedModel");
     
-    // Allocate arrays for buffers and counts
-    metalModel->vertexBuffers = (__strong id<MTLBuffer>*)malloc(model->mesh_count * sizeof(id<MTLBuffer>));
-    metalModel->indexBuffers = (__strong id<MTLBuffer>*)malloc(model->mesh_count * sizeof(id<MTLBuffer>));
-    metalModel->indexCounts = (uint32_t*)malloc(model->mesh_count * sizeof(uint32_t));
+    // Allocate arrays for allocations and counts
+    metalModel->vertexAllocations = (uint32_t*)malloc(model->mesh_count * sizeof(uint32_t));
+    metalModel->indexAllocations = (uint32_t*)malloc(model->mesh_count * sizeof(uint32_t));
+    metalModel->indexCounts = (uint32_t*)calloc(model->mesh_count, sizeof(uint32_t));
+    metalModel->vertexCounts = (uint32_t*)calloc(model->mesh_count, sizeof(uint32_t));
+    metalModel->vertexLayouts = (uint32_t*)calloc(model->mesh_count, sizeof(uint32_t));
+    if (metalModel->vertexAllocations && metalModel->indexAllocations) {
+        memset(metalModel->vertexAllocations, 0xFF, model->mesh_count * sizeof(uint32_t));
+        memset(metalModel->indexAllocations, 0xFF, model->mesh_count * sizeof(uint32_t));
+    }
     
-    if (!metalModel->vertexBuffers || !metalModel->indexBuffers || !metalModel->indexCounts) {
+    if (!metalModel->vertexAllocations || !metalModel->indexAllocations || !metalModel->indexCounts ||
+        !metalModel->vertexCounts || !metalModel->vertexLayouts) {
         fprintf(stderr, "Failed to allocate MetalModel arrays\n");
         metal_engine_free_model((MetalModelHandle)metalModel);
         return NULL;
@@ -611,30 +760,18 @@ MetalModelHandle metal_engine_upload_model(MetalEngine* engine, Model3D* model)
             continue;
         }
         
-        // Convert vertex data to Metal format
-        float* vertexData = convert_vertex_data_to_metal(mesh);
-        if (!vertexData) {
-            METAL_ERROR("Failed to convert vertex data for mesh %u", i);
-            continue;
-        }
-        
-        // Create Metal buffers
-        id<MTLBuffer> vertexBuffer, indexBuffer;
-        if (create_mesh_buffers(impl->device.device, mesh, vertexData, i, metalModel->name, &vertexBuffer, &indexBuffer) != METAL_SUCCESS) {
-            free(vertexData);
+        // Place the mesh in the arena
+        uint32_t vertexAllocation, indexAllocation;
+        if (create_mesh_allocations(impl->resources.meshArena, mesh, i, &vertexAllocation, &indexAllocation) != METAL_SUCCESS) {
             continue;
         }
         
-        // Store buffers
-        metalModel->vertexBuffers[i] = vertexBuffer;
-        metalModel->indexBuffers[i] = indexBuffer;
+        // Store allocations
+        metalModel->vertexAllocations[i] = vertexAllocation;
+        metalModel->indexAllocations[i] = indexAllocation;
         metalModel->indexCounts[i] = mesh->index_count;
-        
-        METAL_DEBUG("Stored buffers for mesh %u: vertexBuffer=%p, indexBuffer=%p, length=%lu", 
-                i, vertexBuffer, indexBuffer, (unsigned long)indexBuffer.length);
-        
-        // Free temporary vertex data
-        free(vertexData);
+        metalModel->vertexCounts[i] = mesh->vertex_count;
+        metalModel->vertexLayouts[i] = mesh->vertex_layout;
         
         METAL_DEBUG("Uploaded mesh %u: %u vertices, %u indices", 
                 i, mesh->vertex_count, mesh->index_count);
@@ -642,6 +779,7 @@ MetalModelHandle metal_engine_upload_model(MetalEngine* engine, Model3D* model)
     
     METAL_INFO("Successfully uploaded model '%s' with %u meshes", 
             metalModel->name, metalModel->meshCount);
+    tlsf_print("Mesh arena", impl->resources.meshArena->allocator);
     
     return (MetalModelHandle)metalModel;
 }
@@ -669,10 +807,53 @@ void metal_engine_render_model_direct(MetalEngine* engine, MetalModelHandle mode
         return;
     }
     
+    MetalEngineImpl* impl = (MetalEngineImpl*)engine;
     MetalModel* metalModel = (MetalModel*)model;
     id<MTLRenderCommandEncoder> encoder = (__bridge id<MTLRenderCommandEncoder>)renderEncoder;
     
-    render_model_meshes(metalModel, encoder, 1); // Enable debug mode
+    render_model_meshes(impl, metalModel, encoder, 1); // Enable debug mode
+}
+
+// Swap the current constant buffer for one with room for at least drawCapacity
+// draws, keeping what this frame has written. Command buffers already encoded
+// retain the old buffer until the GPU is done with it.
+static int grow_constant_buffer(MetalEngineImpl* impl, uint32_t drawCapacity) {
+    ConstantsWriter* constants = &impl->resources.constants;
+    uint32_t capacity = constants->layout.draw_capacity * 2;
+    if (capacity < drawCapacity) {
+        capacity = drawCapacity;
+    }
+    
+    ConstantsLayout layout = constants_layout(capacity);
+    id<MTLBuffer> buffer = [impl->device.device newBufferWithLength:layout.size
+                                                            options:MTLResourceStorageModeShared];
+    if (!buffer) {
+        METAL_ERROR("Failed to grow constant buffer to %u draws", capacity);
+        return METAL_FAILURE;
+    }
+    buffer.label = @"ConstantBuffer";
+    
+    // Frame and view offsets do not depend on the capacity
+    memcpy(buffer.contents, constants->base, constants_writer_draw_offset(constants, constants->draw_count));
+    uint32_t drawCount = constants->draw_count;
+    uint64_t bytesWritten = constants->bytes_written;
+    impl->resources.constantBuffers[impl->resources.constantBufferIndex] = buffer;
+    constants_writer_begin(constants, buffer.contents, layout);
+    constants->draw_count = drawCount;
+    constants->bytes_written = bytesWritten;
+    return METAL_SUCCESS;
+}
+
+// Bind the frame and view blocks and point the draw slot at one draw
+static void bind_constants(MetalEngineImpl* impl, id<MTLRenderCommandEncoder> encoder, size_t drawOffset) {
+    id<MTLBuffer> buffer = impl->resources.constantBuffers[impl->resources.constantBufferIndex];
+    const ConstantsLayout* layout = &impl->resources.constants.layout;
+    
+    [encoder setVertexBuffer:buffer offset:layout->frame_offset atIndex:BufferIndexFrameConstants];
+    [encoder setFragmentBuffer:buffer offset:layout->frame_offset atIndex:BufferIndexFrameConstants];
+    [encoder setVertexBuffer:buffer offset:layout->view_offset atIndex:BufferIndexViewConstants];
+    [encoder setFragmentBuffer:buffer offset:layout->view_offset atIndex:BufferIndexViewConstants];
+    [encoder setVertexBuffer:buffer offset:drawOffset atIndex:BufferIndexDrawConstants];
 }
 
 // Render a specific model with custom model matrix (for per-entity rendering)
@@ -686,32 +867,31 @@ void metal_engine_render_model_with_matrix(MetalEngine* engine, MetalModelHandle
     MetalModel* metalModel = (MetalModel*)model;
     id<MTLRenderCommandEncoder> encoder = (__bridge id<MTLRenderCommandEncoder>)renderEncoder;
     
-    // Update the uniform buffer with the entity's model matrix
-    MetalUniforms* uniforms = (MetalUniforms*)impl->resources.uniformBufferAddress;
-    
-    // Update model matrix for this entity
-    mat4_to_float_array(&modelMatrix, uniforms->modelMatrix);
-    
-    // Recalculate modelViewMatrix with the new model matrix
-    mat4_t viewMatrix = metal_engine_matrix_translation(0.0f, 0.0f, -8.0f);
-    mat4_t modelViewMatrix = mat4_mul_mat4(modelMatrix, viewMatrix);
-    mat4_to_float_array(&modelViewMatrix, uniforms->modelViewMatrix);
-    
-    // Recalculate normal matrix
-    mat4_t normalMatrix = mat4_transpose(mat4_inverse(modelViewMatrix));
-    mat4_to_float_array(&normalMatrix, uniforms->normalMatrix);
-    
-    // Bind uniform buffer to encoder for this entity
-    [encoder setVertexBuffer:impl->resources.dynamicUniformBuffer
-                      offset:impl->resources.uniformBufferOffset
-                     atIndex:BufferIndexUniforms];
+    // Only this entity's draw block is written; the frame and view blocks
+    // were written once when the frame started
+    ConstantsWriter* constants = &impl->resources.constants;
+    mat34_t model = mat34_from_mat4(modelMatrix);
+    uint32_t draw = constants_writer_push_draw(constants, model);
+    int rebind = draw == 0;
+    if (draw == CONSTANTS_INVALID_DRAW) {
+        if (!grow_constant_buffer(impl, constants->draw_count + 1)) {
+            return;
+        }
+        draw = constants_writer_push_draw(constants, model);
+        rebind = 1;
+    }
     
-    [encoder setFragmentBuffer:impl->resources.dynamicUniformBuffer
-                        offset:impl->resources.uniformBufferOffset
-                       atIndex:BufferIndexUniforms];
+    // The first draw of a frame (or of a grown buffer) binds every block;
+    // later draws only move the draw slot along the array
+    size_t drawOffset = constants_writer_draw_offset(constants, draw);
+    if (rebind) {
+        bind_constants(impl, encoder, drawOffset);
+    } else {
+        [encoder setVertexBufferOffset:drawOffset atIndex:BufferIndexDrawConstants];
+    }
     
     // Render all meshes in the model
-    render_model_meshes(metalModel, encoder, 0);
+    render_model_meshes(impl, metalModel, encoder, 0);
 }
 
 // Render a specific model
@@ -721,10 +901,11 @@ void metal_engine_render_model(MetalEngine* engine, MetalModelHandle model, Meta
         return;
     }
     
+    MetalEngineImpl* impl = (MetalEngineImpl*)engine;
     MetalModel* metalModel = (MetalModel*)model;
     id<MTLRenderCommandEncoder> encoder = (__bridge id<MTLRenderCommandEncoder>)renderEncoder;
     
-    render_model_meshes(metalModel, encoder, 0); // Disable debug mode
+    render_model_meshes(impl, metalModel, encoder, 0); // Disable debug mode
 }
 
 // Free uploaded model resources
@@ -733,31 +914,28 @@ void metal_engine_free_model(MetalModelHandle model) {
     
     MetalModel* metalModel = (MetalModel*)model;
     
-    // Release Metal buffers
-    if (metalModel->vertexBuffers) {
+    // Return mesh ranges to the arena (TLSF_INVALID entries are ignored)
+    if (metalModel->vertexAllocations) {
         for (uint32_t i = 0; i < metalModel->meshCount; i++) {
-            if (metalModel->vertexBuffers[i]) {
-                // Note: In a real implementation, we would release Metal objects here
-                metalModel->vertexBuffers[i] = nil;
-            }
+            tlsf_free(metalModel->arena->allocator, metalModel->vertexAllocations[i]);
         }
-        free(metalModel->vertexBuffers);
+        free(metalModel->vertexAllocations);
     }
     
-    if (metalModel->indexBuffers) {
+    if (metalModel->indexAllocations) {
         for (uint32_t i = 0; i < metalModel->meshCount; i++) {
-            if (metalModel->indexBuffers[i]) {
-                // Note: In a real implementation, we would release Metal objects here
-                metalModel->indexBuffers[i] = nil;
-            }
+            tlsf_free(metalModel->arena->allocator, metalModel->indexAllocations[i]);
         }
-        free(metalModel->indexBuffers);
+        free(metalModel->indexAllocations);
     }
     
     if (metalModel->indexCounts) {
         free(metalModel->indexCounts);
     }
     
+    free(metalModel->vertexCounts);
+    free(metalModel->vertexLayouts);
+    
     if (metalModel->name) {
         free(metalModel->name);
     }
@@ -767,6 +945,32 @@ void metal_engine_free_model(MetalModelHandle model) {
     fprintf(stderr, "Freed MetalModel resources\n");
 }
 
+// Free model once every frame submitted so far has completed
+void metal_engine_retire_model(MetalEngine* engine, MetalModelHandle model) {
+    if (!engine || !model) return;
+    
+    MetalEngineImpl* impl = (MetalEngineImpl*)engine;
+    MetalModel* metalModel = (MetalModel*)model;
+    metalModel->retireFrame = impl->render.frameCount;
+    metalModel->nextRetired = impl->resources.retiredModels;
+    impl->resources.retiredModels = metalModel;
+}
+
+// Compact the mesh arena; models keep their handles, only offsets change
+uint64_t metal_engine_defragment_models(MetalEngine* engine, uint64_t maxBytes) {
+    if (!engine) return 0;
+    
+    MetalEngineImpl* impl = (MetalEngineImpl*)engine;
+    MetalMeshArena* arena = impl->resources.meshArena;
+    if (!arena) return 0;
+    
+    uint64_t moved = tlsf_defragment(arena->allocator, maxBytes, mesh_arena_move, arena);
+    if (moved > 0) {
+        METAL_INFO("Defragmented mesh arena: moved %.2f MB", moved / (1024.0 * 1024.0));
+    }
+    return moved;
+}
+
 int metal_engine_create_textures(MetalEngine* engine) {
     if (!engine) return 0;
     
@@ -860,9 +1064,13 @@ void metal_engine_update_dynamic_buffer_state(MetalEngine* engine) {
     
     MetalEngineImpl* impl = (MetalEngineImpl*)engine;
     
-    impl->resources.uniformBufferIndex = (impl->resources.uniformBufferIndex + 1) % kMaxBuffersInFlight;
-    impl->resources.uniformBufferOffset = kAlignedUniformsSize * impl->resources.uniformBufferIndex;
-    impl->resources.uniformBufferAddress = ((uint8_t*)impl->resources.dynamicUniformBuffer.contents) + impl->resources.uniformBufferOffset;
+    impl->resources.constantBufferIndex = (impl->resources.constantBufferIndex + 1) % kMaxBuffersInFlight;
+    id<MTLBuffer> buffer = impl->resources.constantBuffers[impl->resources.constantBufferIndex];
+    
+    // Buffers grow independently, so the capacity comes from the length
+    size_t drawOffset = constants_layout(0).draw_offset;
+    uint32_t drawCapacity = (uint32_t)((buffer.length - drawOffset) / sizeof(DrawConstants));
+    constants_writer_begin(&impl->resources.constants, buffer.contents, constants_layout(drawCapacity));
 }
 
 void metal_engine_update_game_state(MetalEngine* engine) {
@@ -870,38 +1078,21 @@ void metal_engine_update_game_state(MetalEngine* engine) {
     
     MetalEngineImpl* impl = (MetalEngineImpl*)engine;
     
-    MetalUniforms* uniforms = (MetalUniforms*)impl->resources.uniformBufferAddress;
-    
-    // Set projection matrix
-    mat4_to_float_array(&impl->render.projectionMatrix, uniforms->projectionMatrix);
-    
-    // Create model matrix - rotate around the object's center
+    // Create model matrix - rotate around the object's center; it is written
+    // as a draw block when the model is rendered
     vec3_t rotationAxis = vec3(1.0f, 1.0f, 0.0f);
-    mat4_t modelMatrix = metal_engine_matrix_rotation(impl->render.rotationAngle, rotationAxis);
+    impl->render.modelMatrix = metal_engine_matrix_rotation(impl->render.rotationAngle, rotationAxis);
     
     // Create view matrix - move camera back from origin
-    mat4_t viewMatrix = metal_engine_matrix_translation(0.0f, 0.0f, -8.0f);
-    
-    // For modelViewMatrix, we want to apply view transformation first, then model transformation
-    // This ensures the object rotates around its own center, not around the camera
-    mat4_t modelViewMatrix = mat4_mul_mat4(viewMatrix, modelMatrix);
-    
-    mat4_to_float_array(&modelViewMatrix, uniforms->modelViewMatrix);
-    mat4_to_float_array(&modelMatrix, uniforms->modelMatrix);
-    mat4_to_float_array(&viewMatrix, uniforms->viewMatrix);
-    
-    // Calculate normal matrix
-    mat4_t normalMatrix = mat4_inverse(mat4_transpose(modelMatrix));
-    mat4_to_float_array(&normalMatrix, uniforms->normalMatrix);
+    impl->render.viewMatrix = metal_engine_matrix_translation(0.0f, 0.0f, -8.0f);
     
     // Calculate camera position
-    mat4_t invViewMatrix = mat4_inverse(viewMatrix);
+    mat4_t invViewMatrix = mat4_inverse(impl->render.viewMatrix);
     vec4_t cameraPos = invViewMatrix.w;
-    uniforms->cameraPosition[0] = cameraPos.x;
-    uniforms->cameraPosition[1] = cameraPos.y;
-    uniforms->cameraPosition[2] = cameraPos.z;
     
-    uniforms->time = impl->render.rotationAngle;
+    constants_writer_set_frame(&impl->resources.constants, impl->render.rotationAngle, 0.01f, impl->render.frameCount);
+    constants_writer_set_view(&impl->resources.constants, impl->render.viewMatrix, impl->render.projectionMatrix,
+                              vec3(cameraPos.x, cameraPos.y, cameraPos.z));
     
     impl->render.rotationAngle += 0.01f;
 }
@@ -915,43 +1106,14 @@ void metal_engine_update_game_state_from_engine_state(MetalEngine* engine, void*
     }
     
     MetalEngineImpl* impl = (MetalEngineImpl*)engine;
-    MetalUniforms* uniforms = (MetalUniforms*)impl->resources.uniformBufferAddress;
-    
-    // Impl and uniforms accessed silently
-    
-    // Cast to access engine state fields directly
-    // We know the structure layout from engine_main.h
-    char* base = (char*)engineState;
-    
-    // Access fields using correct offsets based on EngineStateStruct layout
-    // state (4) + camera_position (12) + camera_target (12) + camera_up (12) + padding (8) + view_matrix (64) + projection_matrix (64) + model_matrix (64) = 240
-    float* projectionMatrix = (float*)(base + 112);  // projection_matrix starts at offset 112
-    float* viewMatrix = (float*)(base + 48);         // view_matrix starts at offset 48
-    float* modelMatrix = (float*)(base + 176);       // model_matrix starts at offset 176
-    float* cameraPosition = (float*)(base + 4);      // camera_position starts at offset 4
-    
-    // Matrix offsets calculated silently
-    
-    // Read matrices directly from engine state and convert to proper format
-    mat4_to_float_array((mat4_t*)projectionMatrix, uniforms->projectionMatrix);
-    mat4_to_float_array((mat4_t*)viewMatrix, uniforms->viewMatrix);
-    mat4_to_float_array((mat4_t*)modelMatrix, uniforms->modelMatrix);
-    
-    // Using matrices from engine state
-    
-    // Calculate modelViewMatrix from engine state
-    mat4_t modelViewMatrix = mat4_mul_mat4(*(mat4_t*)viewMatrix, *(mat4_t*)modelMatrix);
-    mat4_to_float_array(&modelViewMatrix, uniforms->modelViewMatrix);
-    
-    // Calculate normal matrix
-    mat4_t normalMatrix = mat4_inverse(mat4_transpose(*(mat4_t*)modelMatrix));
-    mat4_to_float_array(&normalMatrix, uniforms->normalMatrix);
-    
-    // Use camera position from engine state
-    memcpy(uniforms->cameraPosition, cameraPosition, sizeof(float) * 3);
+    EngineStateStruct* state = (EngineStateStruct*)engineState;
     
+    // Per-frame and per-view blocks are written once here; model matrices
+    // only go into the per-draw blocks, one per entity
     // Use a simple time value for animation (can be replaced with actual time later)
-    uniforms->time = impl->render.rotationAngle;
+    constants_writer_set_frame(&impl->resources.constants, impl->render.rotationAngle, 0.0f, impl->render.frameCount);
+    constants_writer_set_view(&impl->resources.constants, state->view_matrix, state->projection_matrix,
+                              state->camera_position);
     
     // Matrix values updated silently
 }
@@ -968,13 +1130,30 @@ void metal_engine_render_frame(MetalEngine* engine, MetalViewHandle view, void*
     // Wait for available buffer
     // Note: In a real implementation, we would use a semaphore here
     
+    // Free models retired before frames that have since completed
+    release_retired_models(impl, 0);
+    
     // Create command buffer
     id<MTLCommandBuffer> commandBuffer = [impl->device.commandQueue commandBuffer];
     commandBuffer.label = @"MyCommand";
     
+    // Command buffers on one queue complete in order, so this only moves forward
+    uint32_t completedFrames = impl->render.frameCount + 1;
+    [commandBuffer addCompletedHandler:^(id<MTLCommandBuffer> buffer) {
+        (void)buffer;
+        __atomic_store_n(&impl->render.completedFrames, completedFrames, __ATOMIC_RELEASE);
+    }];
+    
     // Update buffer state
     metal_engine_update_dynamic_buffer_state(engine);
     
+    // Size this frame's constant buffer for every entity up front
+    EngineStateStruct* frameState = (EngineStateStruct*)engineState;
+    uint32_t drawEstimate = frameState->world ? world_get_entity_count(frameState->world) : 0;
+    if (drawEstimate > impl->resources.constants.layout.draw_capacity) {
+        grow_constant_buffer(impl, drawEstimate);
+    }
+    
     // Update game state using engine state directly
     metal_engine_update_game_state_from_engine_state(engine, engineState);
     
@@ -993,7 +1172,7 @@ void metal_engine_render_frame(MetalEngine* engine, MetalViewHandle view, void*
         [renderEncoder setRenderPipelineState:impl->device.renderPipelineState];
         [renderEncoder setDepthStencilState:impl->device.depthState];
         
-        // Set texture (uniforms will be bound per entity)
+        // Set texture (constants will be bound per entity)
         if (impl->resources.colorMap) {
 
         }
@@ -1042,6 +1221,7 @@ void metal_engine_render_frame(MetalEngine* engine, MetalViewHandle view, void*
     }
     
     [commandBuffer commit];
+    impl->render.lastCommandBuffer = commandBuffer;
     
     impl->render.frameCount++;
 }
@@ -1398,6 +1578,39 @@ MetalTextureHandle metal_engine_get_colormap_texture(MetalEngine* engine) {
     return (__bridge MetalTextureHandle)impl->resources.colorMap;
 }
 
+// UI SDF parameter blocks bind directly as SDFUniforms
+typedef char ui_sdf_params_size_check[(sizeof(UISDFParams) == sizeof(struct SDFUniforms)) ? 1 : -1];
+
+// Copy parameter blocks added to the library since the last frame. Blocks
+// are immutable, so each one is uploaded once rather than once per draw.
+static int sync_material_params(MetalEngineImpl* impl, MaterialLibrary* materials) {
+    uint32_t begin, end;
+    if (!material_library_upload_range(materials, &begin, &end)) {
+        return impl->ui.materialParamsBuffer != nil;
+    }
+    
+    id<MTLBuffer> buffer = impl->ui.materialParamsBuffer;
+    if (!buffer || buffer.length < end) {
+        // Blocks already referenced by in-flight frames stay in the old
+        // buffer, which their command buffers retain
+        NSUInteger length = buffer ? buffer.length * 2 : 4096;
+        while (length < end) {
+            length *= 2;
+        }
+        buffer = [impl->device.device newBufferWithLength:length options:MTLResourceStorageModeShared];
+        if (!buffer) {
+            METAL_ERROR("Failed to create material parameter buffer (%lu bytes)", (unsigned long)length);
+            return METAL_FAILURE;
+        }
+        buffer.label = @"MaterialParamsBuffer";
+        impl->ui.materialParamsBuffer = buffer;
+        begin = 0;
+    }
+    
+    memcpy((uint8_t*)buffer.contents + begin, materials->params_data + begin, end - begin);
+    return METAL_SUCCESS;
+}
+
 void metal_engine_render_ui_pass(MetalEngine* engine, void* renderEncoder, void* ui2d) {
     if (!engine || !renderEncoder || !ui2d) {
         return;
@@ -1494,6 +1707,11 @@ void metal_engine_render_ui_pass(MetalEngine* engine, void* renderEncoder, void*
     // Track current pipeline state to minimize state changes
     id<MTLRenderPipelineState> currentPipelineState = nil;
     
+    // Upload new SDF parameter blocks; elements then only pick an offset
+    int hasMaterialParams = sync_material_params(impl, ui->materials);
+    MaterialId boundMaterial = MATERIAL_INVALID;
+    int materialBufferBound = 0;
+    
     // Render all elements in order
     for (uint32_t i = 0; i < ui->elementCount; i++) {
         UIElement* element = &ui->elements[i];
@@ -1515,8 +1733,22 @@ void metal_engine_render_ui_pass(MetalEngine* engine, void* renderEncoder, void*
         }
         
         // Set element-specific uniforms and resources
-        if (element->type == UI_ELEMENT_TYPE_SDF) {
-            // Set SDF uniforms (convert vec4_t to simd_float4)
+        if (element->type == UI_ELEMENT_TYPE_SDF && hasMaterialParams && element->material != MATERIAL_INVALID) {
+            // Point the SDF uniforms at the element's shared parameter block;
+            // consecutive elements with the same style skip the rebind
+            if (element->material != boundMaterial) {
+                const Material* material = material_get(ui->materials, element->material);
+                NSUInteger offset = material_params_offset(ui->materials, material->params);
+                if (materialBufferBound) {
+                    [encoder setFragmentBufferOffset:offset atIndex:1];
+                } else {
+                    [encoder setFragmentBuffer:impl->ui.materialParamsBuffer offset:offset atIndex:1];
+                    materialBufferBound = 1;
+                }
+                boundMaterial = element->material;
+            }
+        } else if (element->type == UI_ELEMENT_TYPE_SDF) {
+            // Fallback without a material: copy the parameters for this draw
             struct SDFUniforms sdfUniforms = {
                 .fillColor = {element->fillColor.x, element->fillColor.y, element->fillColor.z, element->fillColor.w},
                 .outlineColor = {element->outlineColor.x, element->outlineColor.y, element->outlineColor.z, element->outlineColor.w},
@@ -1526,6 +1758,8 @@ void metal_engine_render_ui_pass(MetalEngine* engine, void* renderEncoder, void*
                 .hasOutline = element->hasOutline
             };
             [encoder setFragmentBytes:&sdfUniforms length:sizeof(struct SDFUniforms) atIndex:1];
+            boundMaterial = MATERIAL_INVALID;
+            materialBufferBound = 0;
         } else {
             // Set regular UI uniforms
             UIUniforms uiUniforms = {
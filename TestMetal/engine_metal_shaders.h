@@ -5,6 +5,8 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+
 // Metal-compatible math types (no C standard library dependencies)
 // For C/C++ code, we use our custom types
 typedef float vec2_t __attribute__((vector_size(8)));
@@ -16,6 +18,11 @@ typedef struct {
     vec4_t x, y, z, w;
 } mat4_t;
 
+// Affine rows (linear part, translation); a float3x4 in the shader
+typedef struct {
+    vec4_t x, y, z;
+} mat34_t;
+
 // ============================================================================
 // METAL SHADER TYPES AND STRUCTURES
 // ============================================================================
@@ -27,23 +34,33 @@ typedef enum {
     VertexAttributeNormal = 2
 } VertexAttribute;
 
-// Vertex structure for Metal shaders
+// Vertex structure for Metal shaders: packed floats, the same 32 bytes as
+// the CPU Vertex (VERTEX_LAYOUT_STANDARD in engine_vertex_layout.h)
 typedef struct {
-    vec3_t position;      // 3D position (x, y, z)
-    vec2_t texcoord;      // Texture coordinates (u, v)
-    vec3_t normal;        // Surface normal (nx, ny, nz)
+    float position[3];    // 3D position (x, y, z)
+    float texcoord[2];    // Texture coordinates (u, v)
+    float normal[3];      // Surface normal (nx, ny, nz)
 } MetalVertex;
 
-// Uniform buffer structure for Metal shaders
+// Constant blocks, as written by engine_constants.c
 typedef struct {
-    mat4_t projectionMatrix;           // Projection matrix
-    mat4_t modelViewMatrix;            // Combined model-view matrix
-    mat4_t modelMatrix;                // Model matrix
-    mat4_t viewMatrix;                 // View matrix
-    mat4_t normalMatrix;               // Normal matrix for lighting
-    vec3_t cameraPosition;             // Camera position in world space
     float time;                        // Time for animations
-} MetalUniforms;
+    float delta_time;
+    uint32_t frame_index;
+    uint32_t padding;
+} FrameConstants;
+
+typedef struct {
+    mat4_t view;                       // View matrix
+    mat4_t projection;                 // Projection matrix
+    mat4_t view_projection;            // View, then projection
+    vec4_t camera_position;            // Camera position in world space
+} ViewConstants;
+
+typedef struct {
+    mat34_t model;                     // Model matrix
+    mat34_t normal;                    // Normal matrix for lighting
+} DrawConstants;
 
 // ============================================================================
 // SHADER CONSTANTS
@@ -52,7 +69,9 @@ typedef struct {
 // Buffer indices
 #define BufferIndexVertices    0
 #define BufferIndexIndices     1
-#define BufferIndexUniforms    2
+#define BufferIndexFrameConstants 2
+#define BufferIndexViewConstants  4
+#define BufferIndexDrawConstants  5
 
 // Texture indices
 #define TextureIndexColorMap   0
@@ -60,11 +79,11 @@ typedef struct {
 // Sampler indices
 #define SamplerIndexColorMap   0
 
-// Vertex descriptor offsets and strides
+// Vertex descriptor offsets and strides (VERTEX_LAYOUT_STANDARD)
 #define VertexPositionOffset   0
-#define VertexTexcoordOffset   16
-#define VertexNormalOffset     24
-#define VertexStride           36
+#define VertexTexcoordOffset   12
+#define VertexNormalOffset     20
+#define VertexStride           32
 
 #ifdef __cplusplus
 }
@@ -8,15 +8,25 @@ using namespace metal;
 // METAL-COMPATIBLE STRUCTURES
 // ============================================================================
 
-// Metal-compatible uniform buffer structure
-struct MetalUniforms {
-    float4x4 projectionMatrix;         // Projection matrix
-    float4x4 modelViewMatrix;          // Combined model-view matrix
-    float4x4 modelMatrix;              // Model matrix
-    float4x4 viewMatrix;               // View matrix
-    float4x4 normalMatrix;             // Normal matrix for lighting
-    float3 cameraPosition;             // Camera position in world space
+// Metal-compatible constant blocks (engine_constants.h)
+struct FrameConstants {
     float time;                        // Time for animations
+    float deltaTime;
+    uint frameIndex;
+    uint padding;
+};
+
+struct ViewConstants {
+    float4x4 viewMatrix;               // View matrix
+    float4x4 projectionMatrix;         // Projection matrix
+    float4x4 viewProjectionMatrix;     // View, then projection
+    float4 cameraPosition;             // Camera position in world space
+};
+
+// Rows are (linear part, translation): float4(p, 1) * modelMatrix
+struct DrawConstants {
+    float3x4 modelMatrix;              // Model matrix
+    float3x4 normalMatrix;             // Normal matrix for lighting
 };
 
 // ============================================================================
@@ -26,7 +36,9 @@ struct MetalUniforms {
 // Buffer indices
 #define BufferIndexVertices    0
 #define BufferIndexIndices     1
-#define BufferIndexUniforms    2
+#define BufferIndexFrameConstants 2
+#define BufferIndexViewConstants  4
+#define BufferIndexDrawConstants  5
 
 // Texture indices
 #define TextureIndexColorMap   0
@@ -57,20 +69,21 @@ struct VertexOut {
 };
 
 vertex VertexOut vertex_main(VertexIn in [[stage_in]],
-                           constant MetalUniforms& uniforms [[buffer(BufferIndexUniforms)]]) {
+                           constant ViewConstants& view [[buffer(BufferIndexViewConstants)]],
+                           device const DrawConstants& draw [[buffer(BufferIndexDrawConstants)]]) {
     VertexOut out;
     
+    // Transform position to world space
+    out.worldPosition = float4(in.position, 1.0) * draw.modelMatrix;
+    
     // Transform position to clip space
-    out.position = uniforms.projectionMatrix * uniforms.modelViewMatrix * float4(in.position, 1.0);
+    out.position = view.viewProjectionMatrix * float4(out.worldPosition, 1.0);
     
     // Pass through texture coordinates
     out.texcoord = in.texcoord;
     
     // Transform normal to world space
-    out.normal = (uniforms.modelMatrix * float4(in.normal, 0.0)).xyz;
-    
-    // Transform position to world space
-    out.worldPosition = (uniforms.modelMatrix * float4(in.position, 1.0)).xyz;
+    out.normal = float4(in.normal, 0.0) * draw.normalMatrix;
     
     return out;
 }
@@ -69,10 +69,12 @@ fragment float4 ui_fragment_main(UI2DVertexOut in [[stage_in]],
 // SDF FRAGMENT SHADER
 // ============================================================================
 
+// Uniforms are a material parameter block at a 16-byte aligned offset, so
+// they are read from the device address space
 fragment float4 sdf_fragment_main(UI2DVertexOut in [[stage_in]],
                                  texture2d<float> sdfTexture [[texture(0)]],
                                  sampler sdfSampler [[sampler(0)]],
-                                 constant SDFUniforms& sdfUniforms [[buffer(1)]]) {
+                                 device const SDFUniforms& sdfUniforms [[buffer(1)]]) {
     // Sample SDF texture (distance values in red channel)
     float distance = sdfTexture.sample(sdfSampler, in.texcoord).r;
     
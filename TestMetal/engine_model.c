@@ -47,14 +47,15 @@ Mesh* mesh_allocate(uint32_t vertex_count, uint32_t index_count) {
 
 void mesh_free(Mesh* mesh) {
     if (mesh) {
-        if (mesh->vertices) {
+        if (mesh->vertices && !(mesh->borrowed & MESH_BORROWED_VERTICES)) {
             free(mesh->vertices);
-            mesh->vertices = NULL;
         }
-        if (mesh->indices) {
+        if (mesh->indices && !(mesh->borrowed & MESH_BORROWED_INDICES)) {
             free(mesh->indices);
-            mesh->indices = NULL;
         }
+        mesh->vertices = NULL;
+        mesh->indices = NULL;
+        mesh->borrowed = 0;
         mesh->vertex_count = 0;
         mesh->index_count = 0;
         mesh->triangle_count = 0;
@@ -105,6 +106,13 @@ void model3d_free(Model3D* model) {
             free(model->name);
             model->name = NULL;
         }
+
+        // Borrowed mesh arrays are gone, so their backing data can go too
+        if (model->source_release) {
+            model->source_release(model->source);
+        }
+        model->source = NULL;
+        model->source_release = NULL;
         
         model->mesh_count = 0;
         model->bounding_min = vec3(FLT_MAX, FLT_MAX, FLT_MAX);
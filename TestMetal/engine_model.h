@@ -20,6 +20,10 @@ typedef struct {
     vec3_t normal;        // Surface normal (nx, ny, nz)
 } Vertex;
 
+// Arrays a loader pointed straight at file data; mesh_free leaves them alone
+#define MESH_BORROWED_VERTICES 0x1
+#define MESH_BORROWED_INDICES 0x2
+
 // Mesh structure containing vertices and indices
 typedef struct {
     Vertex* vertices;     // Array of vertices
@@ -27,6 +31,8 @@ typedef struct {
     uint32_t vertex_count; // Number of vertices
     uint32_t index_count;  // Number of indices
     uint32_t triangle_count; // Number of triangles (index_count / 3)
+    uint32_t vertex_layout;  // GPU VertexLayoutId (0: the Vertex struct as is)
+    uint32_t borrowed;       // MESH_BORROWED_* arrays that point into Model3D.source
 } Mesh;
 
 // 3D Model structure containing multiple meshes
@@ -38,6 +44,8 @@ typedef struct {
     vec3_t bounding_max;  // Bounding box maximum
     vec3_t center;        // Model center point
     float radius;         // Bounding sphere radius
+    void* source;         // Loader data borrowed meshes point into (e.g. a mapped file)
+    void (*source_release)(void* source); // Called by model3d_free after the meshes
 } Model3D;
 
 // ============================================================================
@@ -83,6 +91,8 @@ FORCE_INLINE Mesh mesh_create(void) {
     mesh.vertex_count = 0;
     mesh.index_count = 0;
     mesh.triangle_count = 0;
+    mesh.vertex_layout = 0;
+    mesh.borrowed = 0;
     return mesh;
 }
 
@@ -105,6 +115,8 @@ FORCE_INLINE Model3D model3d_create(void) {
     model.bounding_max = vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
     model.center = vec3_zero();
     model.radius = 0.0f;
+    model.source = NULL;
+    model.source_release = NULL;
     return model;
 }
 
@@ -0,0 +1,499 @@
+#include "engine_noise.h"
+#include <stdio.h>
+#include <string.h>
+
+// Output scales that bring each gradient noise to [-1, 1]. Simplex peaks
+// are measured exactly; Perlin peaks are rare, so those are also clamped.
+#define NOISE_PERLIN2_SCALE 0.66f
+#define NOISE_PERLIN3_SCALE 0.97f
+#define NOISE_PERLIN4_SCALE 0.87f
+#define NOISE_SIMPLEX2_SCALE 45.2f
+#define NOISE_SIMPLEX3_SCALE 76.8f
+
+// Decorrelates octaves that would otherwise share lattice points at the origin
+#define NOISE_OCTAVE_OFFSET 19.19f
+
+// ============================================================================
+// LANE HELPERS
+// ============================================================================
+
+FORCE_INLINE simd4i_t noise_splat_i(int32_t v) {
+    return (simd4i_t){v, v, v, v};
+}
+
+// Integer lattice coordinate, wrapped to the table period
+FORCE_INLINE simd4i_t noise_cell(simd4f_t floored) {
+    return __builtin_convertvector(floored, simd4i_t) & noise_splat_i(NOISE_TABLE_SIZE - 1);
+}
+
+// Per-lane table lookup (indices are always within the doubled table)
+FORCE_INLINE simd4i_t noise_perm(const NoiseTable* table, simd4i_t index) {
+    const int32_t* p = table->perm;
+    return (simd4i_t){p[index[0]], p[index[1]], p[index[2]], p[index[3]]};
+}
+
+// Quintic fade 6t^5 - 15t^4 + 10t^3 (C2-continuous across cells)
+FORCE_INLINE simd4f_t noise_fade(simd4f_t t) {
+    return t * t * t * (t * (t * simd4f_splat(6.0f) - simd4f_splat(15.0f)) + simd4f_splat(10.0f));
+}
+
+FORCE_INLINE simd4f_t noise_lerp(simd4f_t a, simd4f_t b, simd4f_t t) {
+    return a + (b - a) * t;
+}
+
+// -v in lanes whose hash has `bit` set
+FORCE_INLINE simd4f_t noise_flip(simd4i_t hash, int32_t bit, simd4f_t v) {
+    return simd4f_select((hash & noise_splat_i(bit)) != noise_splat_i(0), -v, v);
+}
+
+FORCE_INLINE simd4f_t noise_clamp(simd4f_t v) {
+    return simd4f_min(simd4f_max(v, simd4f_splat(-1.0f)), simd4f_splat(1.0f));
+}
+
+// Lattice value in [-1, 1] from a hash in [0, 255]
+FORCE_INLINE simd4f_t noise_value(simd4i_t hash) {
+    return __builtin_convertvector(hash, simd4f_t) * simd4f_splat(2.0f / 255.0f) - simd4f_splat(1.0f);
+}
+
+// ============================================================================
+// GRADIENTS
+// ============================================================================
+
+// Eight directions (+-1, +-2) and (+-2, +-1)
+FORCE_INLINE simd4f_t noise_grad2(simd4i_t hash, simd4f_t x, simd4f_t y) {
+    simd4i_t low = (hash & noise_splat_i(4)) == noise_splat_i(0);
+    simd4f_t u = simd4f_select(low, x, y);
+    simd4f_t v = simd4f_select(low, y, x);
+    return noise_flip(hash, 1, u) + noise_flip(hash, 2, v + v);
+}
+
+// The twelve cube-edge directions of improved Perlin noise (16 with repeats)
+FORCE_INLINE simd4f_t noise_grad3(simd4i_t hash, simd4f_t x, simd4f_t y, simd4f_t z) {
+    simd4i_t h = hash & noise_splat_i(15);
+    simd4f_t u = simd4f_select(h < noise_splat_i(8), x, y);
+    simd4i_t use_x = (h == noise_splat_i(12)) | (h == noise_splat_i(14));
+    simd4f_t v = simd4f_select(h < noise_splat_i(4), y, simd4f_select(use_x, x, z));
+    return noise_flip(h, 1, u) + noise_flip(h, 2, v);
+}
+
+// The 32 directions with one zero and three +-1 components
+FORCE_INLINE simd4f_t noise_grad4(simd4i_t hash, simd4f_t x, simd4f_t y, simd4f_t z, simd4f_t w) {
+    simd4i_t h = hash & noise_splat_i(31);
+    simd4f_t u = simd4f_select(h < noise_splat_i(24), x, y);
+    simd4f_t v = simd4f_select(h < noise_splat_i(16), y, z);
+    simd4f_t t = simd4f_select(h < noise_splat_i(8), z, w);
+    return noise_flip(h, 1, u) + noise_flip(h, 2, v) + noise_flip(h, 4, t);
+}
+
+// ============================================================================
+// LATTICE NOISE (PERLIN AND VALUE)
+// ============================================================================
+
+FORCE_INLINE simd4f_t noise_lattice2(const NoiseTable* table, simd4f_t x, simd4f_t y, int gradient) {
+    simd4f_t fx = simd4f_floor(x), fy = simd4f_floor(y);
+    simd4i_t ix = noise_cell(fx), iy = noise_cell(fy);
+    simd4i_t one = noise_splat_i(1);
+    x -= fx;
+    y -= fy;
+
+    simd4i_t a = noise_perm(table, ix) + iy;
+    simd4i_t b = noise_perm(table, ix + one) + iy;
+    simd4i_t aa = noise_perm(table, a), ab = noise_perm(table, a + one);
+    simd4i_t ba = noise_perm(table, b), bb = noise_perm(table, b + one);
+
+    simd4f_t u = noise_fade(x), v = noise_fade(y);
+    if (gradient) {
+        simd4f_t x1 = x - simd4f_splat(1.0f), y1 = y - simd4f_splat(1.0f);
+        return noise_clamp(noise_lerp(noise_lerp(noise_grad2(aa, x, y), noise_grad2(ba, x1, y), u),
+                                      noise_lerp(noise_grad2(ab, x, y1), noise_grad2(bb, x1, y1), u), v) *
+                           simd4f_splat(NOISE_PERLIN2_SCALE));
+    }
+    return noise_lerp(noise_lerp(noise_value(aa), noise_value(ba), u),
+                      noise_lerp(noise_value(ab), noise_value(bb), u), v);
+}
+
+FORCE_INLINE simd4f_t noise_lattice3(const NoiseTable* table, simd4f_t x, simd4f_t y, simd4f_t z, int gradient) {
+    simd4f_t fx = simd4f_floor(x), fy = simd4f_floor(y), fz = simd4f_floor(z);
+    simd4i_t ix = noise_cell(fx), iy = noise_cell(fy), iz = noise_cell(fz);
+    simd4i_t one = noise_splat_i(1);
+    x -= fx;
+    y -= fy;
+    z -= fz;
+
+    simd4i_t a = noise_perm(table, ix) + iy;
+    simd4i_t b = noise_perm(table, ix + one) + iy;
+    simd4i_t aa = noise_perm(table, a) + iz, ab = noise_perm(table, a + one) + iz;
+    simd4i_t ba = noise_perm(table, b) + iz, bb = noise_perm(table, b + one) + iz;
+    simd4i_t h000 = noise_perm(table, aa), h001 = noise_perm(table, aa + one);
+    simd4i_t h010 = noise_perm(table, ab), h011 = noise_perm(table, ab + one);
+    simd4i_t h100 = noise_perm(table, ba), h101 = noise_perm(table, ba + one);
+    simd4i_t h110 = noise_perm(table, bb), h111 = noise_perm(table, bb + one);
+
+    simd4f_t u = noise_fade(x), v = noise_fade(y), w = noise_fade(z);
+    simd4f_t c000, c100, c010, c110, c001, c101, c011, c111;
+    if (gradient) {
+        simd4f_t x1 = x - simd4f_splat(1.0f), y1 = y - simd4f_splat(1.0f), z1 = z - simd4f_splat(1.0f);
+        c000 = noise_grad3(h000, x, y, z);
+        c100 = noise_grad3(h100, x1, y, z);
+        c010 = noise_grad3(h010, x, y1, z);
+        c110 = noise_grad3(h110, x1, y1, z);
+        c001 = noise_grad3(h001, x, y, z1);
+        c101 = noise_grad3(h101, x1, y, z1);
+        c011 = noise_grad3(h011, x, y1, z1);
+        c111 = noise_grad3(h111, x1, y1, z1);
+    } else {
+        c000 = noise_value(h000);
+        c100 = noise_value(h100);
+        c010 = noise_value(h010);
+        c110 = noise_value(h110);
+        c001 = noise_value(h001);
+        c101 = noise_value(h101);
+        c011 = noise_value(h011);
+        c111 = noise_value(h111);
+    }
+    simd4f_t n = noise_lerp(noise_lerp(noise_lerp(c000, c100, u), noise_lerp(c010, c110, u), v),
+                            noise_lerp(noise_lerp(c001, c101, u), noise_lerp(c011, c111, u), v), w);
+    return gradient ? noise_clamp(n * simd4f_splat(NOISE_PERLIN3_SCALE)) : n;
+}
+
+simd4f_t noise_perlin4_4(const NoiseTable* table, simd4f_t x, simd4f_t y, simd4f_t z, simd4f_t w) {
+    simd4f_t fx = simd4f_floor(x), fy = simd4f_floor(y), fz = simd4f_floor(z), fw = simd4f_floor(w);
+    simd4i_t ix = noise_cell(fx), iy = noise_cell(fy), iz = noise_cell(fz), iw = noise_cell(fw);
+    x -= fx;
+    y -= fy;
+    z -= fz;
+    w -= fw;
+    simd4f_t one = simd4f_splat(1.0f);
+
+    // Corner c has offset bit 0 in x, bit 1 in y, bit 2 in z, bit 3 in w
+    simd4f_t corners[16];
+    for (int c = 0; c < 16; c++) {
+        simd4i_t dx = noise_splat_i(c & 1), dy = noise_splat_i((c >> 1) & 1);
+        simd4i_t dz = noise_splat_i((c >> 2) & 1), dw = noise_splat_i((c >> 3) & 1);
+        simd4i_t h = noise_perm(table, noise_perm(table, noise_perm(table, noise_perm(table, ix + dx) + iy + dy) + iz + dz) +
+                                           iw + dw);
+        corners[c] = noise_grad4(h, (c & 1) ? x - one : x, (c & 2) ? y - one : y, (c & 4) ? z - one : z,
+                                 (c & 8) ? w - one : w);
+    }
+
+    // Collapse one axis at a time
+    simd4f_t t[4] = { noise_fade(x), noise_fade(y), noise_fade(z), noise_fade(w) };
+    for (int axis = 0, count = 16; axis < 4; axis++, count /= 2) {
+        for (int c = 0; c < count / 2; c++) {
+            corners[c] = noise_lerp(corners[2 * c], corners[2 * c + 1], t[axis]);
+        }
+    }
+    return noise_clamp(corners[0] * simd4f_splat(NOISE_PERLIN4_SCALE));
+}
+
+// ============================================================================
+// SIMPLEX NOISE
+// ============================================================================
+
+// Radial falloff (0.5 - r^2)^4 times the gradient ramp of one corner
+FORCE_INLINE simd4f_t noise_simplex_corner2(simd4i_t hash, simd4f_t x, simd4f_t y) {
+    simd4f_t t = simd4f_splat(0.5f) - x * x - y * y;
+    t = simd4f_max(t, simd4f_splat(0.0f));
+    t *= t;
+    return t * t * noise_grad2(hash, x, y);
+}
+
+FORCE_INLINE simd4f_t noise_simplex_corner3(simd4i_t hash, simd4f_t x, simd4f_t y, simd4f_t z) {
+    simd4f_t t = simd4f_splat(0.5f) - x * x - y * y - z * z;
+    t = simd4f_max(t, simd4f_splat(0.0f));
+    t *= t;
+    return t * t * noise_grad3(hash, x, y, z);
+}
+
+FORCE_INLINE simd4f_t noise_simplex2(const NoiseTable* table, simd4f_t x, simd4f_t y) {
+    const float F2 = 0.366025403784f;  // (sqrt(3) - 1) / 2
+    const float G2 = 0.211324865405f;  // (3 - sqrt(3)) / 6
+
+    // Skew to the cell, then unskew its origin back
+    simd4f_t s = (x + y) * simd4f_splat(F2);
+    simd4f_t fi = simd4f_floor(x + s), fj = simd4f_floor(y + s);
+    simd4f_t t = (fi + fj) * simd4f_splat(G2);
+    simd4f_t x0 = x - (fi - t), y0 = y - (fj - t);
+
+    // Lower or upper triangle of the cell
+    simd4i_t lower = x0 > y0;
+    simd4i_t i1 = lower & noise_splat_i(1), j1 = noise_splat_i(1) - i1;
+    simd4f_t fi1 = __builtin_convertvector(i1, simd4f_t), fj1 = __builtin_convertvector(j1, simd4f_t);
+
+    simd4f_t x1 = x0 - fi1 + simd4f_splat(G2), y1 = y0 - fj1 + simd4f_splat(G2);
+    simd4f_t x2 = x0 - simd4f_splat(1.0f - 2.0f * G2), y2 = y0 - simd4f_splat(1.0f - 2.0f * G2);
+
+    simd4i_t ii = noise_cell(fi), jj = noise_cell(fj), one = noise_splat_i(1);
+    simd4i_t h0 = noise_perm(table, ii + noise_perm(table, jj));
+    simd4i_t h1 = noise_perm(table, ii + i1 + noise_perm(table, jj + j1));
+    simd4i_t h2 = noise_perm(table, ii + one + noise_perm(table, jj + one));
+
+    simd4f_t n = noise_simplex_corner2(h0, x0, y0) + noise_simplex_corner2(h1, x1, y1) +
+                 noise_simplex_corner2(h2, x2, y2);
+    return n * simd4f_splat(NOISE_SIMPLEX2_SCALE);
+}
+
+FORCE_INLINE simd4f_t noise_simplex3(const NoiseTable* table, simd4f_t x, simd4f_t y, simd4f_t z) {
+    const float F3 = 1.0f / 3.0f;
+    const float G3 = 1.0f / 6.0f;
+
+    simd4f_t s = (x + y + z) * simd4f_splat(F3);
+    simd4f_t fi = simd4f_floor(x + s), fj = simd4f_floor(y + s), fk = simd4f_floor(z + s);
+    simd4f_t t = (fi + fj + fk) * simd4f_splat(G3);
+    simd4f_t x0 = x - (fi - t), y0 = y - (fj - t), z0 = z - (fk - t);
+
+    // Rank the offsets: the second corner steps along the largest axis, the
+    // third along the two largest
+    simd4i_t xy = x0 >= y0, yz = y0 >= z0, xz = x0 >= z0;
+    simd4i_t one = noise_splat_i(1);
+    simd4i_t i1 = xy & xz & one, j1 = ~xy & yz & one, k1 = ~xz & ~yz & one;
+    simd4i_t i2 = (xy | xz) & one, j2 = (~xy | yz) & one, k2 = (~xz | ~yz) & one;
+
+    simd4f_t g1 = simd4f_splat(G3), g2 = simd4f_splat(2.0f * G3), g3 = simd4f_splat(1.0f - 3.0f * G3);
+    simd4f_t x1 = x0 - __builtin_convertvector(i1, simd4f_t) + g1;
+    simd4f_t y1 = y0 - __builtin_convertvector(j1, simd4f_t) + g1;
+    simd4f_t z1 = z0 - __builtin_convertvector(k1, simd4f_t) + g1;
+    simd4f_t x2 = x0 - __builtin_convertvector(i2, simd4f_t) + g2;
+    simd4f_t y2 = y0 - __builtin_convertvector(j2, simd4f_t) + g2;
+    simd4f_t z2 = z0 - __builtin_convertvector(k2, simd4f_t) + g2;
+    simd4f_t x3 = x0 - g3, y3 = y0 - g3, z3 = z0 - g3;
+
+    simd4i_t ii = noise_cell(fi), jj = noise_cell(fj), kk = noise_cell(fk);
+    simd4i_t h0 = noise_perm(table, ii + noise_perm(table, jj + noise_perm(table, kk)));
+    simd4i_t h1 = noise_perm(table, ii + i1 + noise_perm(table, jj + j1 + noise_perm(table, kk + k1)));
+    simd4i_t h2 = noise_perm(table, ii + i2 + noise_perm(table, jj + j2 + noise_perm(table, kk + k2)));
+    simd4i_t h3 = noise_perm(table, ii + one + noise_perm(table, jj + one + noise_perm(table, kk + one)));
+
+    simd4f_t n = noise_simplex_corner3(h0, x0, y0, z0) + noise_simplex_corner3(h1, x1, y1, z1) +
+                 noise_simplex_corner3(h2, x2, y2, z2) + noise_simplex_corner3(h3, x3, y3, z3);
+    return n * simd4f_splat(NOISE_SIMPLEX3_SCALE);
+}
+
+// ============================================================================
+// CELLULAR NOISE
+// ============================================================================
+
+// Feature point offset in [0, 1] along one axis of a cell
+FORCE_INLINE simd4f_t noise_jitter(const NoiseTable* table, simd4i_t hash) {
+    return __builtin_convertvector(noise_perm(table, hash), simd4f_t) * simd4f_splat(1.0f / 255.0f);
+}
+
+// One feature point per cell; the nearest is within the 3x3 neighbourhood
+FORCE_INLINE simd4f_t noise_worley2(const NoiseTable* table, simd4f_t x, simd4f_t y) {
+    simd4f_t fx = simd4f_floor(x), fy = simd4f_floor(y);
+    simd4i_t ix = __builtin_convertvector(fx, simd4i_t), iy = __builtin_convertvector(fy, simd4i_t);
+    simd4i_t mask = noise_splat_i(NOISE_TABLE_SIZE - 1);
+    x -= fx;
+    y -= fy;
+
+    simd4f_t best = simd4f_splat(8.0f);
+    for (int dy = -1; dy <= 1; dy++) {
+        simd4i_t cy = (iy + noise_splat_i(dy)) & mask;
+        for (int dx = -1; dx <= 1; dx++) {
+            simd4i_t cx = (ix + noise_splat_i(dx)) & mask;
+            simd4i_t h = noise_perm(table, noise_perm(table, cx) + cy);
+            simd4f_t px = simd4f_splat((float)dx) + noise_jitter(table, h) - x;
+            simd4f_t py = simd4f_splat((float)dy) + noise_jitter(table, h + noise_splat_i(1)) - y;
+            best = simd4f_min(best, px * px + py * py);
+        }
+    }
+    return simd4f_sqrt(best);
+}
+
+FORCE_INLINE simd4f_t noise_worley3(const NoiseTable* table, simd4f_t x, simd4f_t y, simd4f_t z) {
+    simd4f_t fx = simd4f_floor(x), fy = simd4f_floor(y), fz = simd4f_floor(z);
+    simd4i_t ix = __builtin_convertvector(fx, simd4i_t), iy = __builtin_convertvector(fy, simd4i_t);
+    simd4i_t iz = __builtin_convertvector(fz, simd4i_t);
+    simd4i_t mask = noise_splat_i(NOISE_TABLE_SIZE - 1);
+    x -= fx;
+    y -= fy;
+    z -= fz;
+
+    simd4f_t best = simd4f_splat(8.0f);
+    for (int dz = -1; dz <= 1; dz++) {
+        simd4i_t cz = (iz + noise_splat_i(dz)) & mask;
+        for (int dy = -1; dy <= 1; dy++) {
+            simd4i_t cy = (iy + noise_splat_i(dy)) & mask;
+            for (int dx = -1; dx <= 1; dx++) {
+                simd4i_t cx = (ix + noise_splat_i(dx)) & mask;
+                simd4i_t h = noise_perm(table, noise_perm(table, noise_perm(table, cx) + cy) + cz);
+                simd4f_t px = simd4f_splat((float)dx) + noise_jitter(table, h) - x;
+                simd4f_t py = simd4f_splat((float)dy) + noise_jitter(table, h + noise_splat_i(1)) - y;
+                simd4f_t pz = simd4f_splat((float)dz) + noise_jitter(table, h + noise_splat_i(2)) - z;
+                best = simd4f_min(best, px * px + py * py + pz * pz);
+            }
+        }
+    }
+    return simd4f_sqrt(best);
+}
+
+// ============================================================================
+// NOISE FUNCTIONS
+// ============================================================================
+
+void noise_table_init(NoiseTable* table, uint32_t seed) {
+    if (!table) {
+        return;
+    }
+    table->seed = seed;
+    for (int32_t i = 0; i < NOISE_TABLE_SIZE; i++) {
+        table->perm[i] = i;
+    }
+
+    // Fisher-Yates with a xorshift stream (a zero seed still shuffles)
+    uint32_t state = seed * 2654435761u + 0x9E3779B9u;
+    for (int32_t i = NOISE_TABLE_SIZE - 1; i > 0; i--) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        int32_t j = (int32_t)(state % (uint32_t)(i + 1));
+        int32_t swap = table->perm[i];
+        table->perm[i] = table->perm[j];
+        table->perm[j] = swap;
+    }
+    memcpy(table->perm + NOISE_TABLE_SIZE, table->perm, NOISE_TABLE_SIZE * sizeof(int32_t));
+}
+
+NoiseFractalDesc noise_fractal_desc_default(void) {
+    NoiseFractalDesc desc;
+    desc.type = NOISE_PERLIN;
+    desc.mode = NOISE_FRACTAL_FBM;
+    desc.octaves = 5;
+    desc.frequency = 1.0f;
+    desc.lacunarity = 2.0f;
+    desc.gain = 0.5f;
+    return desc;
+}
+
+simd4f_t noise_sample2_4(const NoiseTable* table, NoiseType type, simd4f_t x, simd4f_t y) {
+    switch (type) {
+        case NOISE_PERLIN: return noise_lattice2(table, x, y, 1);
+        case NOISE_SIMPLEX: return noise_simplex2(table, x, y);
+        case NOISE_VALUE: return noise_lattice2(table, x, y, 0);
+        case NOISE_WORLEY: return noise_worley2(table, x, y);
+        default: return simd4f_splat(0.0f);
+    }
+}
+
+simd4f_t noise_sample3_4(const NoiseTable* table, NoiseType type, simd4f_t x, simd4f_t y, simd4f_t z) {
+    switch (type) {
+        case NOISE_PERLIN: return noise_lattice3(table, x, y, z, 1);
+        case NOISE_SIMPLEX: return noise_simplex3(table, x, y, z);
+        case NOISE_VALUE: return noise_lattice3(table, x, y, z, 0);
+        case NOISE_WORLEY: return noise_worley3(table, x, y, z);
+        default: return simd4f_splat(0.0f);
+    }
+}
+
+// Ridged octaves: (1 - |n|)^2, each weighted by the previous so creases
+// stay sharp while the valleys between them smooth out
+FORCE_INLINE simd4f_t noise_ridge(simd4f_t n, simd4f_t* weight) {
+    simd4f_t r = simd4f_splat(1.0f) - simd4f_max(n, -n);
+    r = r * r * *weight;
+    *weight = simd4f_min(simd4f_max(r + r, simd4f_splat(0.0f)), simd4f_splat(1.0f));
+    return r;
+}
+
+FORCE_INLINE uint32_t noise_octave_count(const NoiseFractalDesc* desc) {
+    uint32_t octaves = desc->octaves;
+    return octaves < 1 ? 1 : octaves > NOISE_MAX_OCTAVES ? NOISE_MAX_OCTAVES : octaves;
+}
+
+simd4f_t noise_fractal2_4(const NoiseTable* table, const NoiseFractalDesc* desc, simd4f_t x, simd4f_t y) {
+    uint32_t octaves = noise_octave_count(desc);
+    int ridged = desc->mode == NOISE_FRACTAL_RIDGED;
+    simd4f_t sum = simd4f_splat(0.0f), weight = simd4f_splat(1.0f);
+    float frequency = desc->frequency, amplitude = 1.0f, total = 0.0f;
+    for (uint32_t o = 0; o < octaves; o++) {
+        simd4f_t offset = simd4f_splat(NOISE_OCTAVE_OFFSET * (float)o);
+        simd4f_t f = simd4f_splat(frequency);
+        simd4f_t n = noise_sample2_4(table, desc->type, x * f + offset, y * f + offset);
+        sum += simd4f_splat(amplitude) * (ridged ? noise_ridge(n, &weight) : n);
+        total += amplitude;
+        frequency *= desc->lacunarity;
+        amplitude *= desc->gain;
+    }
+    return total > 0.0f ? sum * simd4f_splat(1.0f / total) : sum;
+}
+
+simd4f_t noise_fractal3_4(const NoiseTable* table, const NoiseFractalDesc* desc, simd4f_t x, simd4f_t y, simd4f_t z) {
+    uint32_t octaves = noise_octave_count(desc);
+    int ridged = desc->mode == NOISE_FRACTAL_RIDGED;
+    simd4f_t sum = simd4f_splat(0.0f), weight = simd4f_splat(1.0f);
+    float frequency = desc->frequency, amplitude = 1.0f, total = 0.0f;
+    for (uint32_t o = 0; o < octaves; o++) {
+        simd4f_t offset = simd4f_splat(NOISE_OCTAVE_OFFSET * (float)o);
+        simd4f_t f = simd4f_splat(frequency);
+        simd4f_t n = noise_sample3_4(table, desc->type, x * f + offset, y * f + offset, z * f + offset);
+        sum += simd4f_splat(amplitude) * (ridged ? noise_ridge(n, &weight) : n);
+        total += amplitude;
+        frequency *= desc->lacunarity;
+        amplitude *= desc->gain;
+    }
+    return total > 0.0f ? sum * simd4f_splat(1.0f / total) : sum;
+}
+
+float noise_sample2(const NoiseTable* table, NoiseType type, float x, float y) {
+    return noise_sample2_4(table, type, simd4f_splat(x), simd4f_splat(y))[0];
+}
+
+float noise_sample3(const NoiseTable* table, NoiseType type, float x, float y, float z) {
+    return noise_sample3_4(table, type, simd4f_splat(x), simd4f_splat(y), simd4f_splat(z))[0];
+}
+
+float noise_perlin4(const NoiseTable* table, float x, float y, float z, float w) {
+    return noise_perlin4_4(table, simd4f_splat(x), simd4f_splat(y), simd4f_splat(z), simd4f_splat(w))[0];
+}
+
+float noise_fractal2(const NoiseTable* table, const NoiseFractalDesc* desc, float x, float y) {
+    return noise_fractal2_4(table, desc, simd4f_splat(x), simd4f_splat(y))[0];
+}
+
+float noise_fractal3(const NoiseTable* table, const NoiseFractalDesc* desc, float x, float y, float z) {
+    return noise_fractal3_4(table, desc, simd4f_splat(x), simd4f_splat(y), simd4f_splat(z))[0];
+}
+
+// ============================================================================
+// GRID GENERATION
+// ============================================================================
+
+typedef struct {
+    const NoiseTable* table;
+    const NoiseFractalDesc* desc;
+    float* out;
+    uint32_t width;
+    float origin_x;
+    float origin_y;
+    float spacing;
+} NoiseGridJob;
+
+static void noise_grid_rows(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    const NoiseGridJob* job = (const NoiseGridJob*)user_data;
+    const simd4f_t lane = (simd4f_t){0.0f, 1.0f, 2.0f, 3.0f};
+    for (uint32_t row = begin; row < end; row++) {
+        float* out = job->out + (size_t)row * job->width;
+        simd4f_t y = simd4f_splat(job->origin_y + (float)row * job->spacing);
+        for (uint32_t column = 0; column < job->width; column += 4) {
+            simd4f_t x = simd4f_splat(job->origin_x) + (simd4f_splat((float)column) + lane) * simd4f_splat(job->spacing);
+            simd4f_t n = noise_fractal2_4(job->table, job->desc, x, y);
+            if (column + 4 <= job->width) {
+                simd4f_store(out + column, n);
+            } else {
+                for (uint32_t i = 0; column + i < job->width; i++) {
+                    out[column + i] = n[i];
+                }
+            }
+        }
+    }
+}
+
+void noise_fill_grid(const NoiseTable* table, const NoiseFractalDesc* desc, float* out, uint32_t width,
+                     uint32_t height, float origin_x, float origin_y, float spacing, JobSystemHandle jobs) {
+    if (!table || !desc || !out) {
+        fprintf(stderr, "Error: Invalid parameters for noise grid\n");
+        return;
+    }
+    NoiseGridJob job = { table, desc, out, width, origin_x, origin_y, spacing };
+    job_system_parallel_for(jobs, height, 8, noise_grid_rows, &job);
+}
@@ -0,0 +1,89 @@
+#ifndef ENGINE_NOISE_H
+#define ENGINE_NOISE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+
+// ============================================================================
+// NOISE CONFIGURATION
+// ============================================================================
+
+#define NOISE_TABLE_SIZE 256                    // Lattice period in every axis
+#define NOISE_MAX_OCTAVES 16
+
+typedef enum {
+    NOISE_PERLIN = 0,       // Gradient noise on the cubic lattice, [-1, 1]
+    NOISE_SIMPLEX,          // Gradient noise on the simplex lattice, [-1, 1]
+    NOISE_VALUE,            // Smoothly interpolated lattice values, [-1, 1]
+    NOISE_WORLEY,           // Cellular: distance to the nearest feature point (F1), [0, 1.5]
+    NOISE_TYPE_COUNT
+} NoiseType;
+
+typedef enum {
+    NOISE_FRACTAL_FBM = 0,  // Sum of octaves, [-1, 1] (Worley: [0, 1.5])
+    NOISE_FRACTAL_RIDGED    // Sharp creases where the noise crosses zero, [0, 1]
+} NoiseFractalMode;
+
+typedef struct {
+    NoiseType type;
+    NoiseFractalMode mode;
+    uint32_t octaves;           // Clamped to [1, NOISE_MAX_OCTAVES]
+    float frequency;            // Of the first octave
+    float lacunarity;           // Frequency multiplier per octave
+    float gain;                 // Amplitude multiplier per octave
+} NoiseFractalDesc;
+
+// ============================================================================
+// NOISE DATA STRUCTURES
+// ============================================================================
+
+// Seeded permutation of [0, 256), stored twice so nested lookups never wrap
+typedef struct {
+    uint32_t seed;
+    int32_t perm[NOISE_TABLE_SIZE * 2];
+} NoiseTable;
+
+// ============================================================================
+// NOISE FUNCTIONS
+// ============================================================================
+
+// Shuffle the permutation for a seed (the same seed gives the same noise)
+void noise_table_init(NoiseTable* table, uint32_t seed);
+
+// Default: Perlin fBm, 5 octaves, frequency 1, lacunarity 2, gain 0.5
+NoiseFractalDesc noise_fractal_desc_default(void);
+
+// Four samples per call, one per lane
+simd4f_t noise_sample2_4(const NoiseTable* table, NoiseType type, simd4f_t x, simd4f_t y);
+simd4f_t noise_sample3_4(const NoiseTable* table, NoiseType type, simd4f_t x, simd4f_t y, simd4f_t z);
+
+// 4D Perlin noise, e.g. a 3D field animated along w
+simd4f_t noise_perlin4_4(const NoiseTable* table, simd4f_t x, simd4f_t y, simd4f_t z, simd4f_t w);
+
+// Octave sums of noise_sample*_4
+simd4f_t noise_fractal2_4(const NoiseTable* table, const NoiseFractalDesc* desc, simd4f_t x, simd4f_t y);
+simd4f_t noise_fractal3_4(const NoiseTable* table, const NoiseFractalDesc* desc, simd4f_t x, simd4f_t y, simd4f_t z);
+
+// Single samples (camera shake, gameplay); prefer the 4-wide calls in loops
+float noise_sample2(const NoiseTable* table, NoiseType type, float x, float y);
+float noise_sample3(const NoiseTable* table, NoiseType type, float x, float y, float z);
+float noise_perlin4(const NoiseTable* table, float x, float y, float z, float w);
+float noise_fractal2(const NoiseTable* table, const NoiseFractalDesc* desc, float x, float y);
+float noise_fractal3(const NoiseTable* table, const NoiseFractalDesc* desc, float x, float y, float z);
+
+// Fill a width x height grid (row-major) with 2D fractal noise sampled at
+// origin + (column, row) * spacing, rows split across the job system
+// (NULL runs serially). For heightmaps and procedural textures.
+void noise_fill_grid(const NoiseTable* table, const NoiseFractalDesc* desc, float* out, uint32_t width,
+                     uint32_t height, float origin_x, float origin_y, float spacing, JobSystemHandle jobs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_NOISE_H
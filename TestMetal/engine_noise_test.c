@@ -0,0 +1,403 @@
+#include "engine_noise.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static uint32_t rng_state = 12345u;
+
+// Uniform float in [lo, hi)
+static float random_range(float lo, float hi) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return lo + (hi - lo) * (float)(rng_state & 0xFFFFFF) / 16777216.0f;
+}
+
+static const char* type_names[NOISE_TYPE_COUNT] = { "Perlin", "simplex", "value", "Worley" };
+
+// Range, mean and largest change over a small step for one noise type
+typedef struct {
+    float min, max, mean;
+    float max_step;             // Largest |n(p + 1e-3) - n(p)|
+    int lanes_match;            // 4-wide lanes equal single-sample calls
+} NoiseSurvey;
+
+static NoiseSurvey survey_noise(const NoiseTable* table, NoiseType type, int dimensions, int samples) {
+    NoiseSurvey survey = { 1e9f, -1e9f, 0.0f, 0.0f, 1 };
+    double sum = 0.0;
+    for (int i = 0; i < samples; i += 4) {
+        float x[4], y[4], z[4];
+        for (int k = 0; k < 4; k++) {
+            x[k] = random_range(-300.0f, 300.0f);
+            y[k] = random_range(-300.0f, 300.0f);
+            z[k] = random_range(-300.0f, 300.0f);
+        }
+        simd4f_t vx = simd4f_load(x), vy = simd4f_load(y), vz = simd4f_load(z);
+        simd4f_t step = simd4f_splat(1e-3f);
+        simd4f_t n, m;
+        if (dimensions == 2) {
+            n = noise_sample2_4(table, type, vx, vy);
+            m = noise_sample2_4(table, type, vx + step, vy - step);
+        } else {
+            n = noise_sample3_4(table, type, vx, vy, vz);
+            m = noise_sample3_4(table, type, vx + step, vy - step, vz + step);
+        }
+        for (int k = 0; k < 4; k++) {
+            if (n[k] < survey.min) survey.min = n[k];
+            if (n[k] > survey.max) survey.max = n[k];
+            if (fabsf(m[k] - n[k]) > survey.max_step) survey.max_step = fabsf(m[k] - n[k]);
+            sum += n[k];
+        }
+        if (i < 4096) {
+            for (int k = 0; k < 4; k++) {
+                float single = dimensions == 2 ? noise_sample2(table, type, x[k], y[k])
+                                               : noise_sample3(table, type, x[k], y[k], z[k]);
+                survey.lanes_match &= single == n[k];
+            }
+        }
+    }
+    survey.mean = (float)(sum / samples);
+    return survey;
+}
+
+// ============================================================================
+// PERMUTATION TABLE TESTS
+// ============================================================================
+
+static void test_tables(void) {
+    printf("\n--- Permutation Table Tests ---\n");
+
+    NoiseTable a, b, c;
+    noise_table_init(&a, 1);
+    noise_table_init(&b, 1);
+    noise_table_init(&c, 2);
+
+    int seen[NOISE_TABLE_SIZE] = { 0 };
+    int permutation = 1;
+    for (int i = 0; i < NOISE_TABLE_SIZE; i++) {
+        if (a.perm[i] < 0 || a.perm[i] >= NOISE_TABLE_SIZE || seen[a.perm[i]]++) permutation = 0;
+        if (a.perm[i + NOISE_TABLE_SIZE] != a.perm[i]) permutation = 0;
+    }
+    TEST_ASSERT(permutation, "Table should hold a permutation of [0, 256), stored twice");
+    TEST_ASSERT(memcmp(a.perm, b.perm, sizeof(a.perm)) == 0, "The same seed should give the same table");
+    TEST_ASSERT(memcmp(a.perm, c.perm, sizeof(a.perm)) != 0, "Different seeds should give different tables");
+    TEST_ASSERT(noise_sample3(&a, NOISE_PERLIN, 0.3f, 1.7f, -2.2f) != noise_sample3(&c, NOISE_PERLIN, 0.3f, 1.7f, -2.2f),
+                "Different seeds should give different noise");
+
+    NoiseTable zero;
+    noise_table_init(&zero, 0);
+    int identity = 1;
+    for (int i = 0; i < NOISE_TABLE_SIZE; i++) identity &= zero.perm[i] == i;
+    TEST_ASSERT(!identity, "Seed 0 should still shuffle the table");
+
+    NoiseFractalDesc desc = noise_fractal_desc_default();
+    TEST_ASSERT(desc.type == NOISE_PERLIN && desc.mode == NOISE_FRACTAL_FBM && desc.octaves == 5 &&
+                desc.lacunarity == 2.0f && desc.gain == 0.5f, "Default fractal should be 5-octave Perlin fBm");
+}
+
+// ============================================================================
+// NOISE TYPE TESTS
+// ============================================================================
+
+static void test_noise_types(void) {
+    printf("\n--- Noise Type Tests ---\n");
+
+    NoiseTable table;
+    noise_table_init(&table, 7);
+    int bounded = 1, centred = 1, continuous = 1, lanes = 1, cellular = 1;
+    for (int type = 0; type < NOISE_TYPE_COUNT; type++) {
+        for (int dimensions = 2; dimensions <= 3; dimensions++) {
+            NoiseSurvey s = survey_noise(&table, (NoiseType)type, dimensions, 200000);
+            printf("  %-7s %dD: [%.3f, %.3f] mean %+.4f, max step %.4f\n", type_names[type], dimensions, s.min, s.max,
+                   s.mean, s.max_step);
+            lanes &= s.lanes_match;
+            continuous &= s.max_step < 0.05f;
+            if (type == NOISE_WORLEY) {
+                cellular &= s.min >= 0.0f && s.max <= 1.5f && s.mean > 0.3f;
+            } else {
+                bounded &= s.min >= -1.0f && s.max <= 1.0f && s.min < -0.7f && s.max > 0.7f;
+                centred &= fabsf(s.mean) < 0.05f;
+            }
+        }
+    }
+    TEST_ASSERT(bounded, "Gradient and value noise should span most of [-1, 1] without leaving it");
+    TEST_ASSERT(centred, "Gradient and value noise should average to zero");
+    TEST_ASSERT(cellular, "Worley distances should be non-negative and at most 1.5");
+    TEST_ASSERT(continuous, "Every noise should be continuous");
+    TEST_ASSERT(lanes, "4-wide lanes should match single-sample calls");
+
+    int lattice_zero = 1;
+    for (int i = -3; i <= 3; i++) {
+        lattice_zero &= noise_sample2(&table, NOISE_PERLIN, (float)i, (float)(2 * i)) == 0.0f;
+        lattice_zero &= noise_sample3(&table, NOISE_PERLIN, (float)i, (float)(i + 5), (float)(-i)) == 0.0f;
+        lattice_zero &= noise_perlin4(&table, (float)i, 1.0f, (float)(-i), 3.0f) == 0.0f;
+    }
+    TEST_ASSERT(lattice_zero, "Perlin noise should vanish on the integer lattice");
+
+    int periodic = 1;
+    for (int i = 0; i < 64; i++) {
+        float x = random_range(0.0f, 8.0f), y = random_range(0.0f, 8.0f);
+        for (int type = 0; type < NOISE_TYPE_COUNT; type++) {
+            if (type == NOISE_SIMPLEX) continue; // Skewed lattice has no axis period
+            periodic &= fabsf(noise_sample2(&table, (NoiseType)type, x, y) -
+                              noise_sample2(&table, (NoiseType)type, x + NOISE_TABLE_SIZE, y)) < 1e-3f;
+        }
+    }
+    TEST_ASSERT(periodic, "Lattice noises should repeat every 256 units");
+
+    float min4 = 1e9f, max4 = -1e9f, step4 = 0.0f;
+    for (int i = 0; i < 50000; i++) {
+        float x = random_range(-50.0f, 50.0f), y = random_range(-50.0f, 50.0f);
+        float z = random_range(-50.0f, 50.0f), w = random_range(-50.0f, 50.0f);
+        float n = noise_perlin4(&table, x, y, z, w);
+        float m = noise_perlin4(&table, x, y, z, w + 1e-3f);
+        if (n < min4) min4 = n;
+        if (n > max4) max4 = n;
+        if (fabsf(m - n) > step4) step4 = fabsf(m - n);
+    }
+    printf("  Perlin  4D: [%.3f, %.3f], max step %.4f\n", min4, max4, step4);
+    TEST_ASSERT(min4 >= -1.0f && max4 <= 1.0f && min4 < -0.6f && max4 > 0.6f, "4D Perlin noise should span [-1, 1]");
+    TEST_ASSERT(step4 < 0.05f, "4D Perlin noise should be continuous along w");
+    TEST_ASSERT(noise_perlin4(&table, 0.3f, 0.6f, 0.2f, 0.5f) != noise_perlin4(&table, 0.3f, 0.6f, 0.2f, 1.5f),
+                "Moving along w should change the 3D slice");
+}
+
+// ============================================================================
+// FRACTAL TESTS
+// ============================================================================
+
+static void test_fractals(void) {
+    printf("\n--- Fractal Tests ---\n");
+
+    NoiseTable table;
+    noise_table_init(&table, 99);
+    NoiseFractalDesc desc = noise_fractal_desc_default();
+    desc.octaves = 1;
+    desc.frequency = 3.0f;
+    TEST_ASSERT(noise_fractal3(&table, &desc, 0.5f, 0.75f, -1.25f) == noise_sample3(&table, NOISE_PERLIN, 1.5f, 2.25f, -3.75f),
+                "A single octave should be the base noise at the first frequency");
+
+    desc.octaves = 0;
+    float clamped_low = noise_fractal2(&table, &desc, 0.4f, 0.9f);
+    desc.octaves = 1;
+    TEST_ASSERT(clamped_low == noise_fractal2(&table, &desc, 0.4f, 0.9f), "Zero octaves should clamp to one");
+    desc.octaves = 1000;
+    float clamped_high = noise_fractal2(&table, &desc, 0.4f, 0.9f);
+    desc.octaves = NOISE_MAX_OCTAVES;
+    TEST_ASSERT(clamped_high == noise_fractal2(&table, &desc, 0.4f, 0.9f), "Octaves should clamp to the maximum");
+
+    int fbm_bounded = 1, ridged_bounded = 1;
+    float fbm_min = 1e9f, fbm_max = -1e9f, ridged_min = 1e9f, ridged_max = -1e9f;
+    NoiseFractalDesc fbm = noise_fractal_desc_default();
+    NoiseFractalDesc ridged = fbm;
+    ridged.mode = NOISE_FRACTAL_RIDGED;
+    for (int type = 0; type < NOISE_TYPE_COUNT; type++) {
+        fbm.type = ridged.type = (NoiseType)type;
+        for (int i = 0; i < 20000; i++) {
+            float x = random_range(-40.0f, 40.0f), y = random_range(-40.0f, 40.0f), z = random_range(-40.0f, 40.0f);
+            float f = noise_fractal3(&table, &fbm, x, y, z);
+            float r = noise_fractal2(&table, &ridged, x, y);
+            fbm_bounded &= f >= -1.0f && f <= 1.5f;
+            if (type != NOISE_WORLEY) {
+                ridged_bounded &= r >= 0.0f && r <= 1.0f;
+                if (f < fbm_min) fbm_min = f;
+                if (f > fbm_max) fbm_max = f;
+                if (r < ridged_min) ridged_min = r;
+                if (r > ridged_max) ridged_max = r;
+            }
+        }
+    }
+    printf("  fBm [%.3f, %.3f], ridged [%.3f, %.3f]\n", fbm_min, fbm_max, ridged_min, ridged_max);
+    TEST_ASSERT(fbm_bounded && fbm_min >= -1.0f && fbm_max <= 1.0f, "fBm should stay within its base noise range");
+    TEST_ASSERT(ridged_bounded && ridged_max > 0.5f, "Ridged noise should stay within [0, 1]");
+
+    // More octaves add fine detail: neighbouring samples differ more (each
+    // octave adds the same slope at gain 0.5, lacunarity 2, before normalization)
+    float coarse = 0.0f, fine = 0.0f;
+    NoiseFractalDesc one = noise_fractal_desc_default();
+    one.octaves = 1;
+    NoiseFractalDesc six = one;
+    six.octaves = 6;
+    for (int i = 0; i < 2000; i++) {
+        float x = random_range(-20.0f, 20.0f), y = random_range(-20.0f, 20.0f);
+        coarse += fabsf(noise_fractal2(&table, &one, x + 0.01f, y) - noise_fractal2(&table, &one, x, y));
+        fine += fabsf(noise_fractal2(&table, &six, x + 0.01f, y) - noise_fractal2(&table, &six, x, y));
+    }
+    printf("  Slope with 6 octaves vs 1: %.2fx\n", fine / coarse);
+    TEST_ASSERT(fine > coarse * 1.1f, "Higher octaves should add high-frequency detail");
+}
+
+// ============================================================================
+// GRID TESTS
+// ============================================================================
+
+static void test_grids(void) {
+    printf("\n--- Grid Tests ---\n");
+
+    NoiseTable table;
+    noise_table_init(&table, 5);
+    NoiseFractalDesc desc = noise_fractal_desc_default();
+    desc.mode = NOISE_FRACTAL_RIDGED;
+    desc.frequency = 0.05f;
+
+    const uint32_t width = 67, height = 45;
+    float* serial = (float*)malloc(width * height * sizeof(float));
+    float* parallel = (float*)malloc(width * height * sizeof(float));
+    TEST_ASSERT_NOT_NULL(serial, "Grid buffers should be allocated");
+    if (!serial || !parallel) {
+        free(serial);
+        free(parallel);
+        return;
+    }
+
+    noise_fill_grid(&table, &desc, serial, width, height, -10.0f, 4.0f, 0.5f, NULL);
+    int matches = 1;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            float expected = noise_fractal2(&table, &desc, -10.0f + 0.5f * x, 4.0f + 0.5f * y);
+            matches &= fabsf(serial[y * width + x] - expected) < 1e-5f;
+        }
+    }
+    TEST_ASSERT(matches, "Grid samples should match per-point fractal noise, including the ragged last column");
+
+    JobSystemHandle jobs = job_system_create(4);
+    noise_fill_grid(&table, &desc, parallel, width, height, -10.0f, 4.0f, 0.5f, jobs);
+    TEST_ASSERT(memcmp(serial, parallel, width * height * sizeof(float)) == 0, "Parallel fill should match serial");
+    job_system_destroy(jobs);
+
+    noise_fill_grid(&table, &desc, NULL, width, height, 0.0f, 0.0f, 1.0f, NULL);
+    TEST_ASSERT(1, "A NULL grid should be rejected without crashing");
+
+    free(serial);
+    free(parallel);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    NoiseTable table;
+    noise_table_init(&table, 2024);
+    const int samples = 4000000;
+    simd4f_t x = (simd4f_t){0.1f, 7.3f, -3.9f, 12.2f};
+    simd4f_t y = (simd4f_t){-5.5f, 0.7f, 2.4f, 9.1f};
+    simd4f_t z = (simd4f_t){1.3f, -2.6f, 4.8f, 0.2f};
+    simd4f_t step = simd4f_splat(0.0137f);
+
+    double perlin3_rate = 0.0;
+    for (int type = 0; type < NOISE_TYPE_COUNT; type++) {
+        for (int dimensions = 2; dimensions <= 3; dimensions++) {
+            simd4f_t px = x, py = y, pz = z, acc = simd4f_splat(0.0f);
+            double start = now_ms();
+            for (int i = 0; i < samples; i += 4) {
+                acc += dimensions == 2 ? noise_sample2_4(&table, (NoiseType)type, px, py)
+                                       : noise_sample3_4(&table, (NoiseType)type, px, py, pz);
+                px += step;
+                py -= step;
+                pz += step;
+            }
+            double elapsed = now_ms() - start;
+            double rate = samples / (elapsed / 1000.0);
+            if (type == NOISE_PERLIN && dimensions == 3) perlin3_rate = rate;
+            printf("  %-7s %dD: %6.1f M samples/s (checksum %.1f)\n", type_names[type], dimensions, rate / 1e6,
+                   acc[0] + acc[1] + acc[2] + acc[3]);
+        }
+    }
+
+    simd4f_t px = x, acc = simd4f_splat(0.0f);
+    double start = now_ms();
+    for (int i = 0; i < samples; i += 4) {
+        acc += noise_perlin4_4(&table, px, y, z, px);
+        px += step;
+    }
+    printf("  Perlin  4D: %6.1f M samples/s (checksum %.1f)\n", samples / (now_ms() - start) / 1e3, acc[0] + acc[3]);
+
+    // The same Perlin samples through the single-sample entry point
+    float scalar_acc = 0.0f, sx = 0.1f;
+    start = now_ms();
+    for (int i = 0; i < samples / 4; i++) {
+        scalar_acc += noise_sample3(&table, NOISE_PERLIN, sx, -5.5f, 1.3f);
+        sx += 0.0137f;
+    }
+    double scalar_rate = (samples / 4) / ((now_ms() - start) / 1000.0);
+    printf("  Perlin  3D single samples: %6.1f M samples/s (%.1fx slower, checksum %.1f)\n", scalar_rate / 1e6,
+           perlin3_rate / scalar_rate, scalar_acc);
+    TEST_ASSERT(perlin3_rate > 2.0 * scalar_rate, "4-wide evaluation should beat single samples by over 2x");
+
+    // A 1024x1024 heightmap of 6-octave ridged noise
+    const uint32_t size = 1024;
+    float* heights = (float*)malloc(size * size * sizeof(float));
+    JobSystemHandle jobs = job_system_create(0);
+    NoiseFractalDesc desc = noise_fractal_desc_default();
+    desc.mode = NOISE_FRACTAL_RIDGED;
+    desc.octaves = 6;
+    desc.frequency = 1.0f / 256.0f;
+    start = now_ms();
+    noise_fill_grid(&table, &desc, heights, size, size, 0.0f, 0.0f, 1.0f, jobs);
+    double elapsed = now_ms() - start;
+    printf("  1024x1024 ridged heightmap, 6 octaves (%u workers): %.1f ms, %.1f M octave samples/s\n",
+           job_system_get_worker_count(jobs), elapsed, size * size * 6.0 / (elapsed / 1000.0) / 1e6);
+    TEST_ASSERT(heights && heights[size * size - 1] >= 0.0f && heights[size * size - 1] <= 1.0f,
+                "Heightmap should be generated");
+    job_system_destroy(jobs);
+    free(heights);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Noise Unit Tests\n");
+    printf("===================================\n");
+
+    test_tables();
+    test_noise_types();
+    test_fractals();
+    test_grids();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,584 @@
+#include "engine_particles.h"
+#include "engine_noise.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// SOA FIELD TABLE
+// ============================================================================
+
+// Every per-particle float array; used for allocation, swap-remove and free
+#define PARTICLE_FLOAT_FIELDS(X) \
+    X(pos_x) X(pos_y) X(pos_z) \
+    X(vel_x) X(vel_y) X(vel_z) \
+    X(age) X(inv_lifetime) X(size) \
+    X(color_r) X(color_g) X(color_b) X(color_a)
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+// xorshift32; state must be non-zero
+FORCE_INLINE uint32_t rng_next(uint32_t* state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// Uniform float in [0, 1)
+FORCE_INLINE float rng_float(uint32_t* state) {
+    return (float)(rng_next(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+FORCE_INLINE float rng_range(uint32_t* state, float lo, float hi) {
+    return lo + (hi - lo) * rng_float(state);
+}
+
+// Uniformly distributed unit vector
+static vec3_t rng_unit_vector(uint32_t* state) {
+    float z = rng_range(state, -1.0f, 1.0f);
+    float a = rng_range(state, 0.0f, 6.28318530718f);
+    float r = sqrtf(1.0f - z * z);
+    return vec3(r * cosf(a), r * sinf(a), z);
+}
+
+static int pool_allocate(ParticlePool* pool, uint32_t capacity) {
+    memset(pool, 0, sizeof(*pool));
+    pool->capacity = capacity;
+    int ok = 1;
+#define PARTICLE_ALLOC_FIELD(name) \
+    pool->name = (float*)calloc(capacity, sizeof(float)); ok = ok && pool->name;
+    PARTICLE_FLOAT_FIELDS(PARTICLE_ALLOC_FIELD)
+#undef PARTICLE_ALLOC_FIELD
+    return ok;
+}
+
+static void pool_free(ParticlePool* pool) {
+#define PARTICLE_FREE_FIELD(name) free(pool->name);
+    PARTICLE_FLOAT_FIELDS(PARTICLE_FREE_FIELD)
+#undef PARTICLE_FREE_FIELD
+    memset(pool, 0, sizeof(*pool));
+}
+
+// ============================================================================
+// CURL NOISE FIELD
+// ============================================================================
+
+#define CURL_CELLS (PARTICLE_CURL_GRID * PARTICLE_CURL_GRID * PARTICLE_CURL_GRID)
+#define CURL_MASK (PARTICLE_CURL_GRID - 1)
+#define CURL_INDEX(i, j, k) ((((k) & CURL_MASK) * PARTICLE_CURL_GRID + ((j) & CURL_MASK)) * PARTICLE_CURL_GRID + ((i) & CURL_MASK))
+
+// Offsets that decorrelate the three potential components
+static const float curl_offsets[3] = { 0.0f, 31.416f, -47.853f };
+
+// Bake the curl of a simplex noise vector potential into a periodic grid of
+// (x, y, z, 0) cells. A curl is divergence-free, so particles swirl without
+// collecting in sinks. The potential is cross-faded with its copies one
+// period away so the grid tiles, and the curl is taken by central
+// differences on that periodic grid.
+static float* curl_field_bake(uint32_t seed) {
+    float* potential = (float*)malloc((size_t)CURL_CELLS * 3 * sizeof(float));
+    float* field = (float*)malloc((size_t)CURL_CELLS * 4 * sizeof(float));
+    if (!potential || !field) {
+        free(potential);
+        free(field);
+        return NULL;
+    }
+
+    NoiseTable table;
+    noise_table_init(&table, seed);
+    const float h = PARTICLE_CURL_CELL;
+    const float period = PARTICLE_CURL_GRID * h;
+    const simd4f_t lane = { 0.0f, 1.0f, 2.0f, 3.0f };
+
+    for (int k = 0; k < PARTICLE_CURL_GRID; k++) {
+        for (int j = 0; j < PARTICLE_CURL_GRID; j++) {
+            for (int i = 0; i < PARTICLE_CURL_GRID; i += 4) {
+                simd4f_t x = (simd4f_splat((float)i) + lane) * simd4f_splat(h);
+                simd4f_t y = simd4f_splat((float)j * h), z = simd4f_splat((float)k * h);
+                simd4f_t sx = x * simd4f_splat(1.0f / period);
+                float sy = (float)j / PARTICLE_CURL_GRID, sz = (float)k / PARTICLE_CURL_GRID;
+                for (int c = 0; c < 3; c++) {
+                    simd4f_t sum = simd4f_splat(0.0f);
+                    simd4f_t o = simd4f_splat(curl_offsets[c]);
+                    for (int corner = 0; corner < 8; corner++) {
+                        int cx = corner & 1, cy = (corner >> 1) & 1, cz = corner >> 2;
+                        simd4f_t w = (cx ? sx : simd4f_splat(1.0f) - sx) *
+                                     simd4f_splat((cy ? sy : 1.0f - sy) * (cz ? sz : 1.0f - sz));
+                        sum += w * noise_sample3_4(&table, NOISE_SIMPLEX, x - simd4f_splat(cx * period) + o,
+                                                   y - simd4f_splat(cy * period) + o, z - simd4f_splat(cz * period) + o);
+                    }
+                    for (int l = 0; l < 4; l++) {
+                        potential[CURL_INDEX(i + l, j, k) * 3 + c] = sum[l];
+                    }
+                }
+            }
+        }
+    }
+
+    // Potential (a, b, c); curl = (dc/dy - db/dz, da/dz - dc/dx, db/dx - da/dy)
+    const float inv = 0.5f / h;
+    for (int k = 0; k < PARTICLE_CURL_GRID; k++) {
+        for (int j = 0; j < PARTICLE_CURL_GRID; j++) {
+            for (int i = 0; i < PARTICLE_CURL_GRID; i++) {
+                const float* xp = potential + CURL_INDEX(i + 1, j, k) * 3;
+                const float* xn = potential + CURL_INDEX(i - 1, j, k) * 3;
+                const float* yp = potential + CURL_INDEX(i, j + 1, k) * 3;
+                const float* yn = potential + CURL_INDEX(i, j - 1, k) * 3;
+                const float* zp = potential + CURL_INDEX(i, j, k + 1) * 3;
+                const float* zn = potential + CURL_INDEX(i, j, k - 1) * 3;
+                float* out = field + CURL_INDEX(i, j, k) * 4;
+                out[0] = ((yp[2] - yn[2]) - (zp[1] - zn[1])) * inv;
+                out[1] = ((zp[0] - zn[0]) - (xp[2] - xn[2])) * inv;
+                out[2] = ((xp[1] - xn[1]) - (yp[0] - yn[0])) * inv;
+                out[3] = 0.0f;
+            }
+        }
+    }
+
+    free(potential);
+    return field;
+}
+
+// Trilinear lookup in cell (i, j, k) at fractions (fx, fy, fz); returns (x, y, z, 0)
+static inline simd4f_t curl_field_sample(const float* field, int32_t i, int32_t j, int32_t k,
+                                         float fx, float fy, float fz) {
+    simd4f_t tx = simd4f_splat(fx), ty = simd4f_splat(fy), tz = simd4f_splat(fz);
+
+    simd4f_t c000 = simd4f_load(field + CURL_INDEX(i, j, k) * 4);
+    simd4f_t c100 = simd4f_load(field + CURL_INDEX(i + 1, j, k) * 4);
+    simd4f_t c010 = simd4f_load(field + CURL_INDEX(i, j + 1, k) * 4);
+    simd4f_t c110 = simd4f_load(field + CURL_INDEX(i + 1, j + 1, k) * 4);
+    simd4f_t c001 = simd4f_load(field + CURL_INDEX(i, j, k + 1) * 4);
+    simd4f_t c101 = simd4f_load(field + CURL_INDEX(i + 1, j, k + 1) * 4);
+    simd4f_t c011 = simd4f_load(field + CURL_INDEX(i, j + 1, k + 1) * 4);
+    simd4f_t c111 = simd4f_load(field + CURL_INDEX(i + 1, j + 1, k + 1) * 4);
+
+    simd4f_t c00 = c000 + (c100 - c000) * tx, c10 = c010 + (c110 - c010) * tx;
+    simd4f_t c01 = c001 + (c101 - c001) * tx, c11 = c011 + (c111 - c011) * tx;
+    simd4f_t c0 = c00 + (c10 - c00) * ty, c1 = c01 + (c11 - c01) * ty;
+    return c0 + (c1 - c0) * tz;
+}
+
+// ============================================================================
+// PARTICLE SYSTEM FUNCTIONS
+// ============================================================================
+
+ParticleSystem* particle_system_create(uint32_t max_emitters, uint32_t max_instances) {
+    if (max_emitters == 0) {
+        fprintf(stderr, "Error: Cannot create particle system with 0 max emitters\n");
+        return NULL;
+    }
+
+    ParticleSystem* system = (ParticleSystem*)calloc(1, sizeof(ParticleSystem));
+    if (!system) {
+        fprintf(stderr, "Error: Failed to allocate memory for particle system\n");
+        return NULL;
+    }
+
+    system->emitters = (ParticleEmitter*)calloc(max_emitters, sizeof(ParticleEmitter));
+    system->instances = (ParticleInstance*)malloc((max_instances ? max_instances : 1) * sizeof(ParticleInstance));
+    system->curl_field = curl_field_bake(PARTICLE_NOISE_SEED);
+    if (!system->emitters || !system->instances || !system->curl_field) {
+        fprintf(stderr, "Error: Failed to allocate memory for particle emitters\n");
+        particle_system_destroy(system);
+        return NULL;
+    }
+
+    system->emitter_capacity = max_emitters;
+    system->instance_capacity = max_instances;
+    system->gravity = vec3(0.0f, -9.81f, 0.0f);
+
+    fprintf(stderr, "Created particle system with %u emitters, %u instances\n", max_emitters, max_instances);
+    return system;
+}
+
+void particle_system_destroy(ParticleSystem* system) {
+    if (!system) {
+        return;
+    }
+
+    if (system->emitters) {
+        for (uint32_t i = 0; i < system->emitter_capacity; i++) {
+            pool_free(&system->emitters[i].pool);
+        }
+    }
+    free(system->emitters);
+    free(system->instances);
+    free(system->curl_field);
+    free(system);
+}
+
+const ParticleInstance* particle_system_get_instances(const ParticleSystem* system, uint32_t* out_count) {
+    if (!system) {
+        if (out_count) *out_count = 0;
+        return NULL;
+    }
+    if (out_count) *out_count = system->instance_count;
+    return system->instances;
+}
+
+uint32_t particle_system_get_particle_count(const ParticleSystem* system) {
+    if (!system) {
+        return 0;
+    }
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < system->emitter_capacity; i++) {
+        if (system->emitters[i].active) {
+            total += system->emitters[i].pool.count;
+        }
+    }
+    return total;
+}
+
+// ============================================================================
+// EMITTER FUNCTIONS
+// ============================================================================
+
+ParticleEmitterDesc particle_emitter_desc_default(void) {
+    ParticleEmitterDesc desc;
+    desc.max_particles = 1024;
+    desc.spawn_rate = 100.0f;
+    desc.lifetime_min = 1.0f;
+    desc.lifetime_max = 2.0f;
+    desc.offset = vec3_zero();
+    desc.direction = vec3_unit_y();
+    desc.spread = 0.2f;
+    desc.speed_min = 2.0f;
+    desc.speed_max = 4.0f;
+    desc.start_size = 0.1f;
+    desc.end_size = 0.02f;
+    desc.start_color = vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    desc.end_color = vec4(1.0f, 1.0f, 1.0f, 0.0f);
+    desc.gravity_scale = 1.0f;
+    desc.drag = 0.1f;
+    desc.curl_strength = 0.0f;
+    desc.curl_frequency = 1.0f;
+    desc.seed = 0;
+    return desc;
+}
+
+uint32_t particle_emitter_create(ParticleSystem* system, const World* world, const WorldEntity* entity, const ParticleEmitterDesc* desc) {
+    if (!system || !desc || desc->max_particles == 0) {
+        fprintf(stderr, "Error: Invalid parameters for particle_emitter_create\n");
+        return PARTICLE_INVALID_EMITTER;
+    }
+
+    uint32_t slot = 0;
+    if (entity) {
+        ptrdiff_t index = world ? entity - world->entities : -1;
+        if (index < 0 || (uint32_t)index >= world->max_entities || entity->id == 0) {
+            fprintf(stderr, "Error: Entity does not belong to the given world\n");
+            return PARTICLE_INVALID_EMITTER;
+        }
+        slot = (uint32_t)index;
+    }
+
+    for (uint32_t i = 0; i < system->emitter_capacity; i++) {
+        ParticleEmitter* emitter = &system->emitters[i];
+        if (emitter->active) continue;
+
+        if (!pool_allocate(&emitter->pool, desc->max_particles)) {
+            fprintf(stderr, "Error: Failed to allocate %u particles\n", desc->max_particles);
+            pool_free(&emitter->pool);
+            return PARTICLE_INVALID_EMITTER;
+        }
+        emitter->active = 1;
+        emitter->emitting = 1;
+        emitter->entity_id = entity ? entity->id : 0;
+        emitter->entity_slot = slot;
+        emitter->desc = *desc;
+        emitter->desc.direction = vec3_normalize(desc->direction);
+        emitter->spawn_accumulator = 0.0f;
+        emitter->pending_burst = 0;
+        emitter->rng_state = desc->seed ? desc->seed : 0x9E3779B9u * (i + 1);
+        emitter->instance_offset = 0;
+        return i;
+    }
+
+    fprintf(stderr, "Error: Particle system is at maximum capacity (%u emitters)\n", system->emitter_capacity);
+    return PARTICLE_INVALID_EMITTER;
+}
+
+void particle_emitter_destroy(ParticleSystem* system, uint32_t emitter) {
+    if (!system || emitter >= system->emitter_capacity || !system->emitters[emitter].active) {
+        return;
+    }
+    pool_free(&system->emitters[emitter].pool);
+    system->emitters[emitter].active = 0;
+}
+
+void particle_emitter_burst(ParticleSystem* system, uint32_t emitter, uint32_t count) {
+    if (system && emitter < system->emitter_capacity && system->emitters[emitter].active) {
+        system->emitters[emitter].pending_burst += count;
+    }
+}
+
+uint32_t particle_emitter_get_count(const ParticleSystem* system, uint32_t emitter) {
+    if (!system || emitter >= system->emitter_capacity || !system->emitters[emitter].active) {
+        return 0;
+    }
+    return system->emitters[emitter].pool.count;
+}
+
+// ============================================================================
+// SIMULATION
+// ============================================================================
+
+typedef struct {
+    ParticleSystem* system;
+    const World* world;
+    float dt;
+} ParticleUpdateJob;
+
+static void emitter_spawn(ParticleEmitter* emitter, vec3_t origin, quat_t orientation, uint32_t spawn_count) {
+    ParticlePool* pool = &emitter->pool;
+    const ParticleEmitterDesc* d = &emitter->desc;
+    vec3_t axis = quat_rotate_vec3(orientation, d->direction);
+
+    uint32_t room = pool->capacity - pool->count;
+    if (spawn_count > room) spawn_count = room;
+
+    for (uint32_t n = 0; n < spawn_count; n++) {
+        uint32_t i = pool->count++;
+        vec3_t dir = vec3_add(vec3_scale(axis, 1.0f - d->spread), vec3_scale(rng_unit_vector(&emitter->rng_state), d->spread));
+        float len = vec3_length(dir);
+        dir = len > 1e-6f ? vec3_scale(dir, 1.0f / len) : axis;
+        vec3_t v = vec3_scale(dir, rng_range(&emitter->rng_state, d->speed_min, d->speed_max));
+        float lifetime = rng_range(&emitter->rng_state, d->lifetime_min, d->lifetime_max);
+
+        pool->pos_x[i] = origin.x; pool->pos_y[i] = origin.y; pool->pos_z[i] = origin.z;
+        pool->vel_x[i] = v.x; pool->vel_y[i] = v.y; pool->vel_z[i] = v.z;
+        pool->age[i] = 0.0f;
+        pool->inv_lifetime[i] = lifetime > 1e-4f ? 1.0f / lifetime : 1e4f;
+        pool->size[i] = d->start_size;
+        pool->color_r[i] = d->start_color.x; pool->color_g[i] = d->start_color.y;
+        pool->color_b[i] = d->start_color.z; pool->color_a[i] = d->start_color.w;
+    }
+}
+
+// Gravity, drag and curl-noise turbulence, four particles per iteration.
+// The baked field scrolls one noise unit per second along (1, 1, 1).
+static void emitter_simulate(ParticleEmitter* emitter, const float* curl_field, vec3_t gravity, float time, float dt) {
+    ParticlePool* pool = &emitter->pool;
+    const ParticleEmitterDesc* d = &emitter->desc;
+
+    const simd4f_t vdt = simd4f_splat(dt);
+    const simd4f_t drag = simd4f_splat(1.0f / (1.0f + d->drag * dt));
+    const simd4f_t gx = simd4f_splat(gravity.x * d->gravity_scale * dt);
+    const simd4f_t gy = simd4f_splat(gravity.y * d->gravity_scale * dt);
+    const simd4f_t gz = simd4f_splat(gravity.z * d->gravity_scale * dt);
+    const simd4f_t curl = simd4f_splat(d->curl_strength * dt);
+    const simd4f_t freq = simd4f_splat(d->curl_frequency / PARTICLE_CURL_CELL);
+    const simd4f_t phase = simd4f_splat(time / PARTICLE_CURL_CELL);
+    const simd4f_t zero = simd4f_splat(0.0f), one = simd4f_splat(1.0f);
+    const simd4f_t s0 = simd4f_splat(d->start_size), ds = simd4f_splat(d->end_size - d->start_size);
+    const simd4f_t r0 = simd4f_splat(d->start_color.x), dr = simd4f_splat(d->end_color.x - d->start_color.x);
+    const simd4f_t g0 = simd4f_splat(d->start_color.y), dg = simd4f_splat(d->end_color.y - d->start_color.y);
+    const simd4f_t b0 = simd4f_splat(d->start_color.z), db = simd4f_splat(d->end_color.z - d->start_color.z);
+    const simd4f_t a0 = simd4f_splat(d->start_color.w), da = simd4f_splat(d->end_color.w - d->start_color.w);
+    const int use_curl = d->curl_strength != 0.0f;
+
+    // Pad to a multiple of four: lanes past count are simulated but never read
+    uint32_t count = pool->count;
+    uint32_t padded = (count + 3) & ~3u;
+    if (padded > pool->capacity) padded = count & ~3u;
+
+    uint32_t i = 0;
+    for (; i < padded; i += 4) {
+        simd4f_t px = simd4f_load(pool->pos_x + i), py = simd4f_load(pool->pos_y + i), pz = simd4f_load(pool->pos_z + i);
+        simd4f_t vx = simd4f_load(pool->vel_x + i), vy = simd4f_load(pool->vel_y + i), vz = simd4f_load(pool->vel_z + i);
+
+        vx += gx; vy += gy; vz += gz;
+        if (use_curl) {
+            simd4f_t gxs = px * freq + phase, gys = py * freq + phase, gzs = pz * freq + phase;
+            simd4f_t fx = simd4f_floor(gxs), fy = simd4f_floor(gys), fz = simd4f_floor(gzs);
+            simd4i_t ix = __builtin_convertvector(fx, simd4i_t), iy = __builtin_convertvector(fy, simd4i_t);
+            simd4i_t iz = __builtin_convertvector(fz, simd4i_t);
+            gxs -= fx; gys -= fy; gzs -= fz;
+            simd4f_t cx, cy, cz;
+            for (int l = 0; l < 4; l++) {
+                simd4f_t c = curl_field_sample(curl_field, ix[l], iy[l], iz[l], gxs[l], gys[l], gzs[l]);
+                cx[l] = c[0]; cy[l] = c[1]; cz[l] = c[2];
+            }
+            vx += cx * curl;
+            vy += cy * curl;
+            vz += cz * curl;
+        }
+        vx *= drag; vy *= drag; vz *= drag;
+        simd4f_store(pool->vel_x + i, vx); simd4f_store(pool->vel_y + i, vy); simd4f_store(pool->vel_z + i, vz);
+        simd4f_store(pool->pos_x + i, px + vx * vdt);
+        simd4f_store(pool->pos_y + i, py + vy * vdt);
+        simd4f_store(pool->pos_z + i, pz + vz * vdt);
+
+        simd4f_t age = simd4f_load(pool->age + i) + vdt;
+        simd4f_store(pool->age + i, age);
+        simd4f_t t = simd4f_min(simd4f_max(age * simd4f_load(pool->inv_lifetime + i), zero), one);
+        simd4f_store(pool->size + i, s0 + ds * t);
+        simd4f_store(pool->color_r + i, r0 + dr * t);
+        simd4f_store(pool->color_g + i, g0 + dg * t);
+        simd4f_store(pool->color_b + i, b0 + db * t);
+        simd4f_store(pool->color_a + i, a0 + da * t);
+    }
+
+    // Scalar tail when the pool is full and count is not a multiple of four
+    for (; i < count; i++) {
+        float vx = pool->vel_x[i] + gx[0], vy = pool->vel_y[i] + gy[0], vz = pool->vel_z[i] + gz[0];
+        if (use_curl) {
+            float gxs = pool->pos_x[i] * freq[0] + phase[0], fx = floorf(gxs);
+            float gys = pool->pos_y[i] * freq[0] + phase[0], fy = floorf(gys);
+            float gzs = pool->pos_z[i] * freq[0] + phase[0], fz = floorf(gzs);
+            simd4f_t c = curl_field_sample(curl_field, (int32_t)fx, (int32_t)fy, (int32_t)fz,
+                                           gxs - fx, gys - fy, gzs - fz);
+            vx += c[0] * curl[0];
+            vy += c[1] * curl[0];
+            vz += c[2] * curl[0];
+        }
+        vx *= drag[0]; vy *= drag[0]; vz *= drag[0];
+        pool->vel_x[i] = vx; pool->vel_y[i] = vy; pool->vel_z[i] = vz;
+        pool->pos_x[i] += vx * dt; pool->pos_y[i] += vy * dt; pool->pos_z[i] += vz * dt;
+
+        pool->age[i] += dt;
+        float t = pool->age[i] * pool->inv_lifetime[i];
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        pool->size[i] = s0[0] + ds[0] * t;
+        pool->color_r[i] = r0[0] + dr[0] * t;
+        pool->color_g[i] = g0[0] + dg[0] * t;
+        pool->color_b[i] = b0[0] + db[0] * t;
+        pool->color_a[i] = a0[0] + da[0] * t;
+    }
+}
+
+// Remove expired particles by moving the last live particle into each hole
+static void emitter_compact(ParticleEmitter* emitter) {
+    ParticlePool* pool = &emitter->pool;
+    uint32_t i = 0;
+    while (i < pool->count) {
+        if (pool->age[i] * pool->inv_lifetime[i] < 1.0f) {
+            i++;
+            continue;
+        }
+        uint32_t last = --pool->count;
+#define PARTICLE_MOVE_FIELD(name) pool->name[i] = pool->name[last];
+        PARTICLE_FLOAT_FIELDS(PARTICLE_MOVE_FIELD)
+#undef PARTICLE_MOVE_FIELD
+    }
+}
+
+static void update_emitters_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    ParticleUpdateJob* job = (ParticleUpdateJob*)user_data;
+    ParticleSystem* system = job->system;
+
+    for (uint32_t e = begin; e < end; e++) {
+        ParticleEmitter* emitter = &system->emitters[e];
+        if (!emitter->active) continue;
+
+        // Follow the owning entity; stop emitting once it is destroyed
+        vec3_t origin = emitter->desc.offset;
+        quat_t orientation = quat_identity();
+        if (emitter->entity_id != 0) {
+            const WorldEntity* entity = NULL;
+            if (job->world && emitter->entity_slot < job->world->max_entities) {
+                entity = &job->world->entities[emitter->entity_slot];
+            }
+            if (!entity || entity->id != emitter->entity_id) {
+                emitter->emitting = 0;
+            } else {
+                orientation = entity->orientation;
+                origin = vec3_add(entity->position, quat_rotate_vec3(orientation, emitter->desc.offset));
+            }
+        }
+
+        if (emitter->emitting) {
+            emitter->spawn_accumulator += emitter->desc.spawn_rate * job->dt;
+            uint32_t spawn_count = (uint32_t)emitter->spawn_accumulator;
+            emitter->spawn_accumulator -= (float)spawn_count;
+            spawn_count += emitter->pending_burst;
+            if (spawn_count > PARTICLE_MAX_SPAWN_PER_UPDATE) spawn_count = PARTICLE_MAX_SPAWN_PER_UPDATE;
+            emitter_spawn(emitter, origin, orientation, spawn_count);
+        }
+        emitter->pending_burst = 0;
+
+        emitter_simulate(emitter, system->curl_field, system->gravity, system->time, job->dt);
+        emitter_compact(emitter);
+    }
+}
+
+// Transpose each emitter's SoA pool into its slice of the instance buffer
+static void write_instances_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    ParticleUpdateJob* job = (ParticleUpdateJob*)user_data;
+    ParticleSystem* system = job->system;
+
+    for (uint32_t e = begin; e < end; e++) {
+        ParticleEmitter* emitter = &system->emitters[e];
+        if (!emitter->active || emitter->instance_offset >= system->instance_count) continue;
+
+        const ParticlePool* pool = &emitter->pool;
+        uint32_t count = pool->count;
+        if (emitter->instance_offset + count > system->instance_count) {
+            count = system->instance_count - emitter->instance_offset;
+        }
+
+        ParticleInstance* out = system->instances + emitter->instance_offset;
+        for (uint32_t i = 0; i < count; i++) {
+            out[i].position[0] = pool->pos_x[i];
+            out[i].position[1] = pool->pos_y[i];
+            out[i].position[2] = pool->pos_z[i];
+            out[i].size = pool->size[i];
+            out[i].color[0] = pool->color_r[i];
+            out[i].color[1] = pool->color_g[i];
+            out[i].color[2] = pool->color_b[i];
+            out[i].color[3] = pool->color_a[i];
+        }
+    }
+}
+
+void particle_system_update(ParticleSystem* system, const World* world, float dt, JobSystemHandle jobs) {
+    if (!system || dt <= 0.0f) {
+        return;
+    }
+
+    ParticleUpdateJob job = { system, world, dt };
+    job_system_parallel_for(jobs, system->emitter_capacity, 1, update_emitters_range, &job);
+    system->time += dt;
+
+    // Prefix sum gives each emitter a contiguous instance range
+    uint32_t offset = 0;
+    for (uint32_t e = 0; e < system->emitter_capacity; e++) {
+        ParticleEmitter* emitter = &system->emitters[e];
+        if (!emitter->active) continue;
+        emitter->instance_offset = offset;
+        offset += emitter->pool.count;
+    }
+    system->instance_count = offset < system->instance_capacity ? offset : system->instance_capacity;
+
+    job_system_parallel_for(jobs, system->emitter_capacity, 1, write_instances_range, &job);
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void particle_system_print(const char* name, const ParticleSystem* system) {
+    if (!system) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < system->emitter_capacity; i++) {
+        if (system->emitters[i].active) active++;
+    }
+
+    printf("%s:\n", name);
+    printf("  Emitters: %u / %u\n", active, system->emitter_capacity);
+    printf("  Particles: %u\n", particle_system_get_particle_count(system));
+    printf("  Instances: %u / %u\n", system->instance_count, system->instance_capacity);
+}
@@ -0,0 +1,150 @@
+#ifndef ENGINE_PARTICLES_H
+#define ENGINE_PARTICLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_world.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+
+// ============================================================================
+// PARTICLE CONFIGURATION
+// ============================================================================
+
+#define PARTICLE_INVALID_EMITTER 0xFFFFFFFFu
+#define PARTICLE_MAX_SPAWN_PER_UPDATE 65536     // Caps catch-up after long frames
+#define PARTICLE_NOISE_SEED 0x5EEDu             // Turbulence field shared by all emitters
+#define PARTICLE_CURL_GRID 32                   // Baked curl noise cells per axis (power of two)
+#define PARTICLE_CURL_CELL 0.25f                // Noise units per cell; the field repeats every 8
+
+// ============================================================================
+// PARTICLE DATA STRUCTURES
+// ============================================================================
+
+// Emitter parameters
+typedef struct {
+    uint32_t max_particles;     // Pool capacity for this emitter
+    float spawn_rate;           // Particles per second (0 = bursts only)
+    float lifetime_min;         // Seconds
+    float lifetime_max;
+    vec3_t offset;              // Spawn offset in entity space
+    vec3_t direction;           // Emission direction in entity space
+    float spread;               // 0 = along direction, 1 = full sphere
+    float speed_min;
+    float speed_max;
+    float start_size;
+    float end_size;
+    vec4_t start_color;
+    vec4_t end_color;
+    float gravity_scale;        // Multiplies ParticleSystem.gravity
+    float drag;                 // Linear drag coefficient (1/s)
+    float curl_strength;        // Turbulence acceleration
+    float curl_frequency;       // Spatial frequency of the turbulence field
+    uint32_t seed;              // Random seed (0 picks one from the slot)
+} ParticleEmitterDesc;
+
+// Particles of one emitter in structure-of-arrays layout. Slots
+// [0, count) are live; a dying particle is replaced by the last one.
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+    float* pos_x; float* pos_y; float* pos_z;
+    float* vel_x; float* vel_y; float* vel_z;
+    float* age;                 // Seconds since spawn
+    float* inv_lifetime;        // 1 / lifetime, so age * inv_lifetime is [0, 1)
+    float* size;
+    float* color_r; float* color_g; float* color_b; float* color_a;
+} ParticlePool;
+
+// Emitter attached to a World entity
+typedef struct {
+    int active;
+    uint32_t entity_id;         // Owning entity (0 = world space)
+    uint32_t entity_slot;
+    ParticleEmitterDesc desc;
+    ParticlePool pool;
+    float spawn_accumulator;    // Fractional particles carried between frames
+    uint32_t pending_burst;     // Particles requested by particle_emitter_burst
+    uint32_t rng_state;
+    int emitting;               // Cleared when the owning entity disappears
+    uint32_t instance_offset;   // First instance written this frame
+} ParticleEmitter;
+
+// Per-particle instance data for batched drawing (32 bytes)
+typedef struct {
+    float position[3];
+    float size;
+    float color[4];
+} ParticleInstance;
+
+// Particle system: emitters plus the shared per-frame instance buffer
+typedef struct {
+    ParticleEmitter* emitters;
+    uint32_t emitter_capacity;
+    vec3_t gravity;
+    float time;                 // Accumulated simulation time (animates turbulence)
+    float* curl_field;          // Baked curl noise, PARTICLE_CURL_GRID^3 (x, y, z, 0) cells
+
+    ParticleInstance* instances;
+    uint32_t instance_count;
+    uint32_t instance_capacity;
+} ParticleSystem;
+
+// ============================================================================
+// PARTICLE SYSTEM FUNCTIONS
+// ============================================================================
+
+// Create a particle system with room for max_emitters emitters and a
+// shared instance buffer of max_instances particles per frame
+ParticleSystem* particle_system_create(uint32_t max_emitters, uint32_t max_instances);
+
+// Destroy a particle system, its emitters and instance buffer
+void particle_system_destroy(ParticleSystem* system);
+
+// Spawn, simulate and compact every emitter (in parallel across emitters),
+// then rebuild the instance buffer. world may be NULL if no emitter is
+// attached to an entity. jobs may be NULL (serial).
+void particle_system_update(ParticleSystem* system, const World* world, float dt, JobSystemHandle jobs);
+
+// Instance buffer built by the last update
+const ParticleInstance* particle_system_get_instances(const ParticleSystem* system, uint32_t* out_count);
+
+// Total live particles across all emitters
+uint32_t particle_system_get_particle_count(const ParticleSystem* system);
+
+// ============================================================================
+// EMITTER FUNCTIONS
+// ============================================================================
+
+// Default emitter description (small upward fountain)
+ParticleEmitterDesc particle_emitter_desc_default(void);
+
+// Create an emitter that follows an entity (entity may be NULL for world
+// space, in which case desc->offset is the world position).
+// Returns the emitter index or PARTICLE_INVALID_EMITTER on failure.
+uint32_t particle_emitter_create(ParticleSystem* system, const World* world, const WorldEntity* entity, const ParticleEmitterDesc* desc);
+
+// Destroy an emitter and free its particles
+void particle_emitter_destroy(ParticleSystem* system, uint32_t emitter);
+
+// Queue count particles to spawn on the next update
+void particle_emitter_burst(ParticleSystem* system, uint32_t emitter, uint32_t count);
+
+// Live particle count of one emitter
+uint32_t particle_emitter_get_count(const ParticleSystem* system, uint32_t emitter);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print particle system statistics
+void particle_system_print(const char* name, const ParticleSystem* system);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_PARTICLES_H
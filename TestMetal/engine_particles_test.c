@@ -0,0 +1,345 @@
+#include "engine_particles.h"
+#include "engine_profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// ============================================================================
+// TEST FUNCTIONS
+// ============================================================================
+
+static void test_emission_rate(void) {
+    printf("\n--- Emission Tests ---\n");
+
+    ParticleSystem* system = particle_system_create(4, 4096);
+    TEST_ASSERT_NOT_NULL(system, "Particle system should be created");
+
+    ParticleEmitterDesc desc = particle_emitter_desc_default();
+    desc.spawn_rate = 120.0f;
+    desc.lifetime_min = desc.lifetime_max = 10.0f;
+    uint32_t emitter = particle_emitter_create(system, NULL, NULL, &desc);
+    TEST_ASSERT(emitter != PARTICLE_INVALID_EMITTER, "World-space emitter should be created");
+
+    for (int i = 0; i < 60; i++) {
+        particle_system_update(system, NULL, 1.0f / 60.0f, NULL);
+    }
+    uint32_t count = particle_emitter_get_count(system, emitter);
+    TEST_ASSERT(count >= 119 && count <= 120, "One second at 120/s should spawn ~120 particles");
+
+    particle_emitter_burst(system, emitter, 500);
+    particle_system_update(system, NULL, 1.0f / 60.0f, NULL);
+    TEST_ASSERT(particle_emitter_get_count(system, emitter) >= 620, "Burst should spawn immediately");
+
+    uint32_t instance_count = 0;
+    const ParticleInstance* instances = particle_system_get_instances(system, &instance_count);
+    TEST_ASSERT_NOT_NULL(instances, "Instance buffer should exist");
+    TEST_ASSERT_EQUAL(particle_system_get_particle_count(system), instance_count, "Every live particle should have an instance");
+    TEST_ASSERT_EQUAL(32u, (unsigned)sizeof(ParticleInstance), "Instances should be 32 bytes");
+
+    particle_system_destroy(system);
+}
+
+static void test_lifetime_and_compaction(void) {
+    printf("\n--- Lifetime Tests ---\n");
+
+    ParticleSystem* system = particle_system_create(2, 4096);
+    ParticleEmitterDesc desc = particle_emitter_desc_default();
+    desc.spawn_rate = 0.0f;
+    desc.lifetime_min = 0.5f;
+    desc.lifetime_max = 1.5f;
+    uint32_t emitter = particle_emitter_create(system, NULL, NULL, &desc);
+
+    particle_emitter_burst(system, emitter, 1000);
+    particle_system_update(system, NULL, 0.1f, NULL);
+    TEST_ASSERT_EQUAL(1000u, particle_emitter_get_count(system, emitter), "Burst particles should be alive");
+
+    // Halfway through the lifetime range roughly half should have died
+    for (int i = 0; i < 9; i++) {
+        particle_system_update(system, NULL, 0.1f, NULL);
+    }
+    uint32_t count = particle_emitter_get_count(system, emitter);
+    TEST_ASSERT(count > 350 && count < 650, "About half the particles should survive 1 second");
+
+    const ParticlePool* pool = &system->emitters[emitter].pool;
+    int all_alive = 1;
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (pool->age[i] * pool->inv_lifetime[i] >= 1.0f) all_alive = 0;
+    }
+    TEST_ASSERT(all_alive, "Compaction should leave only live particles in [0, count)");
+
+    for (int i = 0; i < 10; i++) {
+        particle_system_update(system, NULL, 0.1f, NULL);
+    }
+    TEST_ASSERT_EQUAL(0u, particle_emitter_get_count(system, emitter), "All particles should expire");
+
+    particle_system_destroy(system);
+}
+
+static void test_gravity_and_drag(void) {
+    printf("\n--- Integration Tests ---\n");
+
+    ParticleSystem* system = particle_system_create(1, 16);
+    ParticleEmitterDesc desc = particle_emitter_desc_default();
+    desc.spawn_rate = 0.0f;
+    desc.speed_min = desc.speed_max = 0.0f;
+    desc.drag = 0.0f;
+    desc.lifetime_min = desc.lifetime_max = 100.0f;
+    uint32_t emitter = particle_emitter_create(system, NULL, NULL, &desc);
+
+    // Five particles cover both the SIMD lanes and the padded tail
+    particle_emitter_burst(system, emitter, 5);
+    for (int i = 0; i < 100; i++) {
+        particle_system_update(system, NULL, 0.01f, NULL);
+    }
+    const ParticlePool* pool = &system->emitters[emitter].pool;
+    TEST_ASSERT(fabsf(pool->vel_y[4] + 9.81f) < 1e-3f, "Velocity should be g * t after one second");
+    TEST_ASSERT(fabsf(pool->pos_y[0] - pool->pos_y[4]) < 1e-6f, "All lanes should integrate identically");
+
+    system->emitters[emitter].desc.drag = 1.0f;
+    system->gravity = vec3_zero();
+    float before = pool->vel_y[0];
+    particle_system_update(system, NULL, 0.01f, NULL);
+    TEST_ASSERT(fabsf(pool->vel_y[0] - before / 1.01f) < 1e-4f, "Drag should damp velocity");
+
+    particle_system_destroy(system);
+}
+
+static void test_curl_noise(void) {
+    printf("\n--- Curl Noise Tests ---\n");
+
+    // SIMD sine should match libm closely
+    float max_error = 0.0f;
+    for (float x = -20.0f; x < 20.0f; x += 0.01f) {
+        simd4f_t s = simd4f_sin(simd4f_splat(x));
+        float e = fabsf(s[0] - sinf(x));
+        if (e > max_error) max_error = e;
+    }
+    TEST_ASSERT(max_error < 1e-5f, "simd4f_sin should be accurate to 1e-5");
+
+    ParticleSystem* system = particle_system_create(1, 1024);
+
+    // The baked field is a curl, so its central-difference divergence vanishes
+    const int n = PARTICLE_CURL_GRID, m = PARTICLE_CURL_GRID - 1;
+    const float* field = system->curl_field;
+    float max_divergence = 0.0f, max_speed = 0.0f;
+    for (int k = 0; k < n; k++) {
+        for (int j = 0; j < n; j++) {
+            for (int i = 0; i < n; i++) {
+                #define CELL(x, y, z) (((((z) & m) * n + ((y) & m)) * n + ((x) & m)) * 4)
+                float div = (field[CELL(i + 1, j, k)] - field[CELL(i - 1, j, k)]) +
+                            (field[CELL(i, j + 1, k) + 1] - field[CELL(i, j - 1, k) + 1]) +
+                            (field[CELL(i, j, k + 1) + 2] - field[CELL(i, j, k - 1) + 2]);
+                if (fabsf(div) > max_divergence) max_divergence = fabsf(div);
+                if (fabsf(field[CELL(i, j, k)]) > max_speed) max_speed = fabsf(field[CELL(i, j, k)]);
+                #undef CELL
+            }
+        }
+    }
+    TEST_ASSERT(max_speed > 0.1f && max_divergence < 1e-3f * max_speed, "Curl noise field should be divergence-free");
+
+    ParticleEmitterDesc desc = particle_emitter_desc_default();
+    desc.spawn_rate = 0.0f;
+    desc.spread = 1.0f;
+    desc.gravity_scale = 0.0f;
+    desc.drag = 0.0f;
+    desc.curl_strength = 5.0f;
+    desc.lifetime_min = desc.lifetime_max = 100.0f;
+    uint32_t emitter = particle_emitter_create(system, NULL, NULL, &desc);
+    particle_emitter_burst(system, emitter, 1000);
+    particle_system_update(system, NULL, 1.0f / 60.0f, NULL);
+
+    const ParticlePool* pool = &system->emitters[emitter].pool;
+    float start_x = pool->vel_x[0], start_y = pool->vel_y[0], start_z = pool->vel_z[0];
+    for (int i = 0; i < 30; i++) {
+        particle_system_update(system, NULL, 1.0f / 60.0f, NULL);
+    }
+    float dv = fabsf(pool->vel_x[0] - start_x) + fabsf(pool->vel_y[0] - start_y) + fabsf(pool->vel_z[0] - start_z);
+    TEST_ASSERT(dv > 0.1f, "Turbulence should deflect particles without gravity");
+
+    int finite = 1;
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (!(fabsf(pool->pos_x[i]) < 1e6f && fabsf(pool->vel_y[i]) < 1e6f)) finite = 0;
+    }
+    TEST_ASSERT(finite, "Turbulent particles should stay finite");
+
+    particle_system_destroy(system);
+}
+
+static void test_entity_emitters(void) {
+    printf("\n--- Entity Emitter Tests ---\n");
+
+    World* world = world_create(4);
+    WorldEntity* torch = world_create_entity(world, "Torch");
+    entity_set_position(torch, vec3(10.0f, 0.0f, 0.0f));
+
+    ParticleSystem* system = particle_system_create(2, 1024);
+    ParticleEmitterDesc desc = particle_emitter_desc_default();
+    desc.spawn_rate = 0.0f;
+    desc.speed_min = desc.speed_max = 0.0f;
+    desc.gravity_scale = 0.0f;
+    desc.offset = vec3(0.0f, 1.0f, 0.0f);
+    uint32_t emitter = particle_emitter_create(system, world, torch, &desc);
+    TEST_ASSERT(emitter != PARTICLE_INVALID_EMITTER, "Entity emitter should be created");
+
+    particle_emitter_burst(system, emitter, 1);
+    particle_system_update(system, world, 0.01f, NULL);
+    const ParticlePool* pool = &system->emitters[emitter].pool;
+    TEST_ASSERT(fabsf(pool->pos_x[0] - 10.0f) < 1e-4f && fabsf(pool->pos_y[0] - 1.0f) < 1e-4f,
+                "Particles should spawn at the entity plus offset");
+
+    // Rotating the entity rotates the offset
+    entity_set_orientation(torch, quat_from_axis_angle(vec3_unit_z(), (float)M_PI * 0.5f));
+    particle_emitter_burst(system, emitter, 1);
+    particle_system_update(system, world, 0.01f, NULL);
+    TEST_ASSERT(fabsf(pool->pos_x[1] - 9.0f) < 1e-3f && fabsf(pool->pos_y[1]) < 1e-3f,
+                "Offset should follow entity orientation");
+
+    // Destroyed entity: existing particles live on, no new ones spawn
+    world_destroy_entity(world, torch->id);
+    particle_emitter_burst(system, emitter, 10);
+    particle_system_update(system, world, 0.01f, NULL);
+    TEST_ASSERT_EQUAL(2u, particle_emitter_get_count(system, emitter), "Orphaned emitter should stop spawning");
+
+    particle_system_destroy(system);
+    world_destroy(world);
+}
+
+static void test_instance_buffer_overflow(void) {
+    printf("\n--- Instance Buffer Tests ---\n");
+
+    ParticleSystem* system = particle_system_create(3, 100);
+    ParticleEmitterDesc desc = particle_emitter_desc_default();
+    desc.spawn_rate = 0.0f;
+    desc.lifetime_min = desc.lifetime_max = 10.0f;
+    for (int i = 0; i < 3; i++) {
+        uint32_t e = particle_emitter_create(system, NULL, NULL, &desc);
+        particle_emitter_burst(system, e, 60);
+    }
+    particle_system_update(system, NULL, 0.01f, NULL);
+
+    uint32_t count = 0;
+    particle_system_get_instances(system, &count);
+    TEST_ASSERT_EQUAL(180u, particle_system_get_particle_count(system), "All particles should simulate");
+    TEST_ASSERT_EQUAL(100u, count, "Instance output should be clamped to capacity");
+
+    particle_emitter_destroy(system, 1);
+    TEST_ASSERT_EQUAL(120u, particle_system_get_particle_count(system), "Destroying an emitter drops its particles");
+
+    particle_system_destroy(system);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t emitter_count = 64;
+    const uint32_t per_emitter = 16384;     // 64 * 16384 = 1M particles
+    const int frames = 60;
+    JobSystemHandle jobs = job_system_create(0);
+
+    for (int pass = 0; pass < 2; pass++) {
+        JobSystemHandle pass_jobs = pass == 0 ? NULL : jobs;
+        ParticleSystem* system = particle_system_create(emitter_count, emitter_count * per_emitter);
+
+        ParticleEmitterDesc desc = particle_emitter_desc_default();
+        desc.max_particles = per_emitter;
+        desc.spawn_rate = 8192.0f;          // Replaces particles as they expire
+        desc.lifetime_min = 2.0f;
+        desc.lifetime_max = 4.0f;
+        desc.spread = 1.0f;
+        desc.curl_strength = 2.0f;
+        for (uint32_t e = 0; e < emitter_count; e++) {
+            desc.offset = vec3((float)(e % 8) * 10.0f, 0.0f, (float)(e / 8) * 10.0f);
+            desc.seed = e + 1;
+            uint32_t index = particle_emitter_create(system, NULL, NULL, &desc);
+            particle_emitter_burst(system, index, per_emitter);
+        }
+        particle_system_update(system, NULL, 1.0f / 60.0f, pass_jobs);
+
+        double total = 0.0, best = 1e9;
+        uint64_t simulated = 0;
+        for (int f = 0; f < frames; f++) {
+            simulated += particle_system_get_particle_count(system);
+            double start = now_ms();
+            particle_system_update(system, NULL, 1.0f / 60.0f, pass_jobs);
+            double elapsed = now_ms() - start;
+            total += elapsed;
+            if (elapsed < best) best = elapsed;
+        }
+
+        printf("%s (%u workers): avg %.3f ms/frame, best %.3f ms/frame, %.2f ns/particle\n",
+               pass == 0 ? "serial" : "parallel", job_system_get_worker_count(pass_jobs),
+               total / frames, best, total * 1e6 / (double)simulated);
+        particle_system_print("  Final frame", system);
+        TEST_ASSERT(particle_system_get_particle_count(system) > 900000, "Benchmark should sustain ~1M particles");
+
+        particle_system_destroy(system);
+    }
+
+    job_system_destroy(jobs);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Particle Unit Tests\n");
+    printf("===================================\n");
+
+    test_emission_rate();
+    test_lifetime_and_compaction();
+    test_gravity_and_drag();
+    test_curl_noise();
+    test_entity_emitters();
+    test_instance_buffer_overflow();
+
+    // ENGINE_PROFILE=<file> samples the benchmarks into collapsed stacks
+    ProfilerHandle profiler = profiler_begin_from_env();
+    test_performance();
+    profiler_end_from_env(profiler);
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
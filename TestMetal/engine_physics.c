@@ -0,0 +1,1025 @@
+#include "engine_physics.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <float.h>
+
+// ============================================================================
+// SOA FIELD TABLES
+// ============================================================================
+
+// Every per-body float array; used for allocation, swap-remove and free
+#define PHYSICS_FLOAT_FIELDS(X) \
+    X(pos_x) X(pos_y) X(pos_z) \
+    X(rot_x) X(rot_y) X(rot_z) X(rot_w) \
+    X(vel_x) X(vel_y) X(vel_z) \
+    X(ang_x) X(ang_y) X(ang_z) \
+    X(inv_mass) X(inv_inertia_x) X(inv_inertia_y) X(inv_inertia_z) \
+    X(half_x) X(half_y) X(half_z) \
+    X(restitution) X(friction) \
+    X(inv_iw_xx) X(inv_iw_xy) X(inv_iw_xz) X(inv_iw_yy) X(inv_iw_yz) X(inv_iw_zz) \
+    X(aabb_min_x) X(aabb_min_y) X(aabb_min_z) \
+    X(aabb_max_x) X(aabb_max_y) X(aabb_max_z)
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+FORCE_INLINE vec3_t body_position(const PhysicsBodies* b, uint32_t i) {
+    return vec3(b->pos_x[i], b->pos_y[i], b->pos_z[i]);
+}
+
+FORCE_INLINE quat_t body_orientation(const PhysicsBodies* b, uint32_t i) {
+    return quat(b->rot_x[i], b->rot_y[i], b->rot_z[i], b->rot_w[i]);
+}
+
+FORCE_INLINE vec3_t body_velocity(const PhysicsBodies* b, uint32_t i) {
+    return vec3(b->vel_x[i], b->vel_y[i], b->vel_z[i]);
+}
+
+FORCE_INLINE vec3_t body_angular_velocity(const PhysicsBodies* b, uint32_t i) {
+    return vec3(b->ang_x[i], b->ang_y[i], b->ang_z[i]);
+}
+
+FORCE_INLINE vec3_t body_half_extents(const PhysicsBodies* b, uint32_t i) {
+    return vec3(b->half_x[i], b->half_y[i], b->half_z[i]);
+}
+
+// Rotation matrix rows for v' = R v
+static mat3_t rotation_rows(quat_t q) {
+    float x = q.x, y = q.y, z = q.z, w = q.w;
+    mat3_t r;
+    r.x = vec3(1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - w * z), 2.0f * (x * z + w * y));
+    r.y = vec3(2.0f * (x * y + w * z), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - w * x));
+    r.z = vec3(2.0f * (x * z - w * y), 2.0f * (y * z + w * x), 1.0f - 2.0f * (x * x + y * y));
+    return r;
+}
+
+FORCE_INLINE float vec3_get(vec3_t v, int i) {
+    return i == 0 ? v.x : (i == 1 ? v.y : v.z);
+}
+
+FORCE_INLINE float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Orthonormal tangent basis for a unit normal
+static void tangent_basis(vec3_t n, vec3_t* t1, vec3_t* t2) {
+    if (fabsf(n.x) >= 0.57735f) {
+        *t1 = vec3_normalize(vec3(n.y, -n.x, 0.0f));
+    } else {
+        *t1 = vec3_normalize(vec3(0.0f, n.z, -n.y));
+    }
+    *t2 = vec3_cross(n, *t1);
+}
+
+static int ensure_pair_capacity(PhysicsWorld* physics, uint32_t needed) {
+    if (needed <= physics->pair_capacity) return 1;
+    uint32_t cap = physics->pair_capacity ? physics->pair_capacity * 2 : 1024;
+    while (cap < needed) cap *= 2;
+    PhysicsPair* pairs = (PhysicsPair*)realloc(physics->pairs, cap * sizeof(PhysicsPair));
+    if (!pairs) {
+        fprintf(stderr, "Error: Failed to grow physics pair array to %u\n", cap);
+        return 0;
+    }
+    physics->pairs = pairs;
+    physics->pair_capacity = cap;
+    return 1;
+}
+
+static int ensure_contact_capacity(PhysicsWorld* physics, uint32_t needed) {
+    if (needed <= physics->contact_capacity) return 1;
+    uint32_t cap = physics->contact_capacity ? physics->contact_capacity * 2 : 1024;
+    while (cap < needed) cap *= 2;
+    PhysicsContact* contacts = (PhysicsContact*)realloc(physics->contacts, cap * sizeof(PhysicsContact));
+    if (!contacts) {
+        fprintf(stderr, "Error: Failed to grow physics contact array to %u\n", cap);
+        return 0;
+    }
+    physics->contacts = contacts;
+    PhysicsContact* sorted = (PhysicsContact*)realloc(physics->contacts_sorted, cap * sizeof(PhysicsContact));
+    if (!sorted) {
+        fprintf(stderr, "Error: Failed to grow physics contact array to %u\n", cap);
+        return 0;
+    }
+    physics->contacts_sorted = sorted;
+    physics->contact_capacity = cap;
+    return 1;
+}
+
+// ============================================================================
+// PHYSICS WORLD FUNCTIONS
+// ============================================================================
+
+PhysicsWorld* physics_world_create(uint32_t max_bodies) {
+    if (max_bodies == 0) {
+        fprintf(stderr, "Error: Cannot create physics world with 0 max bodies\n");
+        return NULL;
+    }
+
+    PhysicsWorld* physics = (PhysicsWorld*)calloc(1, sizeof(PhysicsWorld));
+    if (!physics) {
+        fprintf(stderr, "Error: Failed to allocate memory for physics world\n");
+        return NULL;
+    }
+
+    PhysicsBodies* b = &physics->bodies;
+    b->capacity = max_bodies;
+    int ok = 1;
+#define PHYSICS_ALLOC_FIELD(name) \
+    b->name = (float*)calloc(max_bodies, sizeof(float)); ok = ok && b->name;
+    PHYSICS_FLOAT_FIELDS(PHYSICS_ALLOC_FIELD)
+#undef PHYSICS_ALLOC_FIELD
+    b->entity_id = (uint32_t*)calloc(max_bodies, sizeof(uint32_t));
+    b->entity_slot = (uint32_t*)calloc(max_bodies, sizeof(uint32_t));
+    b->shape = (uint8_t*)calloc(max_bodies, sizeof(uint8_t));
+    physics->sap_order = (uint32_t*)calloc(max_bodies, sizeof(uint32_t));
+    physics->island_parent = (uint32_t*)calloc(max_bodies, sizeof(uint32_t));
+    physics->island_id = (uint32_t*)calloc(max_bodies, sizeof(uint32_t));
+    physics->islands = (PhysicsIsland*)calloc(max_bodies, sizeof(PhysicsIsland));
+    ok = ok && b->entity_id && b->entity_slot && b->shape &&
+         physics->sap_order && physics->island_parent && physics->island_id && physics->islands;
+
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for physics body arrays\n");
+        physics_world_destroy(physics);
+        return NULL;
+    }
+
+    physics->gravity = vec3(0.0f, -9.81f, 0.0f);
+    physics->linear_damping = 0.01f;
+    physics->angular_damping = 0.05f;
+    physics->solver_iterations = PHYSICS_DEFAULT_SOLVER_ITERATIONS;
+
+    fprintf(stderr, "Created physics world with capacity for %u bodies\n", max_bodies);
+    return physics;
+}
+
+void physics_world_destroy(PhysicsWorld* physics) {
+    if (!physics) {
+        return;
+    }
+
+    PhysicsBodies* b = &physics->bodies;
+#define PHYSICS_FREE_FIELD(name) free(b->name);
+    PHYSICS_FLOAT_FIELDS(PHYSICS_FREE_FIELD)
+#undef PHYSICS_FREE_FIELD
+    free(b->entity_id);
+    free(b->entity_slot);
+    free(b->shape);
+    free(physics->sap_order);
+    free(physics->pairs);
+    free(physics->contacts);
+    free(physics->contacts_sorted);
+    free(physics->island_parent);
+    free(physics->island_id);
+    free(physics->islands);
+    free(physics);
+}
+
+// ============================================================================
+// BODY MANAGEMENT FUNCTIONS
+// ============================================================================
+
+PhysicsBodyDesc physics_body_desc_default(void) {
+    PhysicsBodyDesc desc;
+    desc.shape = PHYSICS_SHAPE_BOX;
+    desc.half_extents = vec3(0.5f, 0.5f, 0.5f);
+    desc.mass = 1.0f;
+    desc.restitution = 0.1f;
+    desc.friction = 0.5f;
+    desc.velocity = vec3_zero();
+    desc.angular_velocity = vec3_zero();
+    return desc;
+}
+
+uint32_t physics_add_body(PhysicsWorld* physics, const World* world, const WorldEntity* entity, const PhysicsBodyDesc* desc) {
+    if (!physics || !world || !entity || !desc) {
+        fprintf(stderr, "Error: Invalid parameters for physics_add_body\n");
+        return PHYSICS_INVALID_BODY;
+    }
+
+    PhysicsBodies* b = &physics->bodies;
+    if (b->count >= b->capacity) {
+        fprintf(stderr, "Error: Physics world is at maximum capacity (%u bodies)\n", b->capacity);
+        return PHYSICS_INVALID_BODY;
+    }
+
+    ptrdiff_t slot = entity - world->entities;
+    if (slot < 0 || (uint32_t)slot >= world->max_entities || entity->id == 0) {
+        fprintf(stderr, "Error: Entity does not belong to the given world\n");
+        return PHYSICS_INVALID_BODY;
+    }
+
+    uint32_t i = b->count++;
+    b->entity_id[i] = entity->id;
+    b->entity_slot[i] = (uint32_t)slot;
+
+    quat_t q = quat_normalize(entity->orientation);
+    b->pos_x[i] = entity->position.x; b->pos_y[i] = entity->position.y; b->pos_z[i] = entity->position.z;
+    b->rot_x[i] = q.x; b->rot_y[i] = q.y; b->rot_z[i] = q.z; b->rot_w[i] = q.w;
+    b->vel_x[i] = desc->velocity.x; b->vel_y[i] = desc->velocity.y; b->vel_z[i] = desc->velocity.z;
+    b->ang_x[i] = desc->angular_velocity.x; b->ang_y[i] = desc->angular_velocity.y; b->ang_z[i] = desc->angular_velocity.z;
+
+    b->shape[i] = (uint8_t)desc->shape;
+    vec3_t h = desc->half_extents;
+    if (desc->shape == PHYSICS_SHAPE_SPHERE) {
+        h = vec3(h.x, h.x, h.x);
+    }
+    b->half_x[i] = h.x; b->half_y[i] = h.y; b->half_z[i] = h.z;
+    b->restitution[i] = desc->restitution;
+    b->friction[i] = desc->friction;
+
+    if (desc->mass > 0.0f) {
+        float m = desc->mass;
+        float ix, iy, iz;
+        if (desc->shape == PHYSICS_SHAPE_SPHERE) {
+            ix = iy = iz = 0.4f * m * h.x * h.x;
+        } else {
+            ix = m / 3.0f * (h.y * h.y + h.z * h.z);
+            iy = m / 3.0f * (h.x * h.x + h.z * h.z);
+            iz = m / 3.0f * (h.x * h.x + h.y * h.y);
+        }
+        b->inv_mass[i] = 1.0f / m;
+        b->inv_inertia_x[i] = 1.0f / ix;
+        b->inv_inertia_y[i] = 1.0f / iy;
+        b->inv_inertia_z[i] = 1.0f / iz;
+    } else {
+        // Static bodies never move
+        b->inv_mass[i] = 0.0f;
+        b->inv_inertia_x[i] = b->inv_inertia_y[i] = b->inv_inertia_z[i] = 0.0f;
+        b->vel_x[i] = b->vel_y[i] = b->vel_z[i] = 0.0f;
+        b->ang_x[i] = b->ang_y[i] = b->ang_z[i] = 0.0f;
+    }
+
+    // New bodies join the end of the sweep order; the next sort fixes it up
+    physics->sap_order[i] = i;
+    physics->sap_added++;
+    return i;
+}
+
+int physics_remove_body(PhysicsWorld* physics, uint32_t body) {
+    if (!physics || body >= physics->bodies.count) {
+        fprintf(stderr, "Error: Invalid physics body %u\n", body);
+        return 0;
+    }
+
+    PhysicsBodies* b = &physics->bodies;
+    uint32_t last = b->count - 1;
+
+    // Drop the body from the sweep order and rename the moved body
+    uint32_t w = 0;
+    for (uint32_t i = 0; i < b->count; i++) {
+        uint32_t idx = physics->sap_order[i];
+        if (idx == body) continue;
+        physics->sap_order[w++] = (idx == last) ? body : idx;
+    }
+
+    if (body != last) {
+#define PHYSICS_MOVE_FIELD(name) b->name[body] = b->name[last];
+        PHYSICS_FLOAT_FIELDS(PHYSICS_MOVE_FIELD)
+#undef PHYSICS_MOVE_FIELD
+        b->entity_id[body] = b->entity_id[last];
+        b->entity_slot[body] = b->entity_slot[last];
+        b->shape[body] = b->shape[last];
+    }
+    b->count--;
+    return 1;
+}
+
+uint32_t physics_find_body(const PhysicsWorld* physics, uint32_t entity_id) {
+    if (!physics || entity_id == 0) {
+        return PHYSICS_INVALID_BODY;
+    }
+    for (uint32_t i = 0; i < physics->bodies.count; i++) {
+        if (physics->bodies.entity_id[i] == entity_id) {
+            return i;
+        }
+    }
+    return PHYSICS_INVALID_BODY;
+}
+
+void physics_set_velocity(PhysicsWorld* physics, uint32_t body, vec3_t velocity) {
+    if (physics && body < physics->bodies.count && physics->bodies.inv_mass[body] > 0.0f) {
+        physics->bodies.vel_x[body] = velocity.x;
+        physics->bodies.vel_y[body] = velocity.y;
+        physics->bodies.vel_z[body] = velocity.z;
+    }
+}
+
+vec3_t physics_get_velocity(const PhysicsWorld* physics, uint32_t body) {
+    return (physics && body < physics->bodies.count) ? body_velocity(&physics->bodies, body) : vec3_zero();
+}
+
+void physics_set_angular_velocity(PhysicsWorld* physics, uint32_t body, vec3_t angular_velocity) {
+    if (physics && body < physics->bodies.count && physics->bodies.inv_mass[body] > 0.0f) {
+        physics->bodies.ang_x[body] = angular_velocity.x;
+        physics->bodies.ang_y[body] = angular_velocity.y;
+        physics->bodies.ang_z[body] = angular_velocity.z;
+    }
+}
+
+vec3_t physics_get_position(const PhysicsWorld* physics, uint32_t body) {
+    return (physics && body < physics->bodies.count) ? body_position(&physics->bodies, body) : vec3_zero();
+}
+
+quat_t physics_get_orientation(const PhysicsWorld* physics, uint32_t body) {
+    return (physics && body < physics->bodies.count) ? body_orientation(&physics->bodies, body) : quat_identity();
+}
+
+// ============================================================================
+// INTEGRATION (SIMD, SEMI-IMPLICIT EULER)
+// ============================================================================
+
+typedef struct {
+    PhysicsWorld* physics;
+    float dt;
+} PhysicsIntegrateJob;
+
+// v += g * dt, then damping; static bodies (inv_mass == 0) stay at rest
+static void integrate_velocities_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    PhysicsIntegrateJob* job = (PhysicsIntegrateJob*)user_data;
+    PhysicsBodies* b = &job->physics->bodies;
+    float dt = job->dt;
+    vec3_t g = job->physics->gravity;
+    float lin_damp = 1.0f / (1.0f + dt * job->physics->linear_damping);
+    float ang_damp = 1.0f / (1.0f + dt * job->physics->angular_damping);
+
+    const simd4f_t zero = simd4f_splat(0.0f);
+    const simd4f_t gx = simd4f_splat(g.x * dt), gy = simd4f_splat(g.y * dt), gz = simd4f_splat(g.z * dt);
+    const simd4f_t ld = simd4f_splat(lin_damp), ad = simd4f_splat(ang_damp);
+
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        simd4i_t dynamic = simd4f_load(b->inv_mass + i) > zero;
+        simd4f_store(b->vel_x + i, simd4f_select(dynamic, (simd4f_load(b->vel_x + i) + gx) * ld, zero));
+        simd4f_store(b->vel_y + i, simd4f_select(dynamic, (simd4f_load(b->vel_y + i) + gy) * ld, zero));
+        simd4f_store(b->vel_z + i, simd4f_select(dynamic, (simd4f_load(b->vel_z + i) + gz) * ld, zero));
+        simd4f_store(b->ang_x + i, simd4f_select(dynamic, simd4f_load(b->ang_x + i) * ad, zero));
+        simd4f_store(b->ang_y + i, simd4f_select(dynamic, simd4f_load(b->ang_y + i) * ad, zero));
+        simd4f_store(b->ang_z + i, simd4f_select(dynamic, simd4f_load(b->ang_z + i) * ad, zero));
+    }
+    for (; i < end; i++) {
+        if (b->inv_mass[i] > 0.0f) {
+            b->vel_x[i] = (b->vel_x[i] + g.x * dt) * lin_damp;
+            b->vel_y[i] = (b->vel_y[i] + g.y * dt) * lin_damp;
+            b->vel_z[i] = (b->vel_z[i] + g.z * dt) * lin_damp;
+            b->ang_x[i] *= ang_damp;
+            b->ang_y[i] *= ang_damp;
+            b->ang_z[i] *= ang_damp;
+        }
+    }
+}
+
+// x += v * dt, q += 0.5 * dt * (w * q), then renormalize
+static void integrate_positions_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    PhysicsIntegrateJob* job = (PhysicsIntegrateJob*)user_data;
+    PhysicsBodies* b = &job->physics->bodies;
+    float dt = job->dt;
+
+    const simd4f_t vdt = simd4f_splat(dt);
+    const simd4f_t half_dt = simd4f_splat(0.5f * dt);
+
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        simd4f_store(b->pos_x + i, simd4f_load(b->pos_x + i) + simd4f_load(b->vel_x + i) * vdt);
+        simd4f_store(b->pos_y + i, simd4f_load(b->pos_y + i) + simd4f_load(b->vel_y + i) * vdt);
+        simd4f_store(b->pos_z + i, simd4f_load(b->pos_z + i) + simd4f_load(b->vel_z + i) * vdt);
+
+        quat4_t q = quat4_load(b->rot_x + i, b->rot_y + i, b->rot_z + i, b->rot_w + i);
+        quat4_t w;
+        w.x = simd4f_load(b->ang_x + i);
+        w.y = simd4f_load(b->ang_y + i);
+        w.z = simd4f_load(b->ang_z + i);
+        w.w = simd4f_splat(0.0f);
+        quat4_t dq = quat4_mul(w, q);
+        q.x += dq.x * half_dt;
+        q.y += dq.y * half_dt;
+        q.z += dq.z * half_dt;
+        q.w += dq.w * half_dt;
+        quat4_store(quat4_normalize(q), b->rot_x + i, b->rot_y + i, b->rot_z + i, b->rot_w + i);
+    }
+    for (; i < end; i++) {
+        b->pos_x[i] += b->vel_x[i] * dt;
+        b->pos_y[i] += b->vel_y[i] * dt;
+        b->pos_z[i] += b->vel_z[i] * dt;
+
+        quat_t q = body_orientation(b, i);
+        quat_t dq = quat_mul(quat(b->ang_x[i], b->ang_y[i], b->ang_z[i], 0.0f), q);
+        q = quat_normalize(quat_add(q, quat_scale(dq, 0.5f * dt)));
+        b->rot_x[i] = q.x; b->rot_y[i] = q.y; b->rot_z[i] = q.z; b->rot_w[i] = q.w;
+    }
+}
+
+// World-space inverse inertia (R * diag * R^T) and AABBs
+static void update_derived_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    PhysicsIntegrateJob* job = (PhysicsIntegrateJob*)user_data;
+    PhysicsBodies* b = &job->physics->bodies;
+
+    for (uint32_t i = begin; i < end; i++) {
+        mat3_t r = rotation_rows(body_orientation(b, i));
+        vec3_t d = vec3(b->inv_inertia_x[i], b->inv_inertia_y[i], b->inv_inertia_z[i]);
+        vec3_t rx = vec3_mul(r.x, d), ry = vec3_mul(r.y, d), rz = vec3_mul(r.z, d);
+        b->inv_iw_xx[i] = vec3_dot(rx, r.x);
+        b->inv_iw_xy[i] = vec3_dot(rx, r.y);
+        b->inv_iw_xz[i] = vec3_dot(rx, r.z);
+        b->inv_iw_yy[i] = vec3_dot(ry, r.y);
+        b->inv_iw_yz[i] = vec3_dot(ry, r.z);
+        b->inv_iw_zz[i] = vec3_dot(rz, r.z);
+
+        vec3_t e;
+        if (b->shape[i] == PHYSICS_SHAPE_SPHERE) {
+            e = vec3(b->half_x[i], b->half_x[i], b->half_x[i]);
+        } else {
+            vec3_t h = body_half_extents(b, i);
+            e.x = fabsf(r.x.x) * h.x + fabsf(r.x.y) * h.y + fabsf(r.x.z) * h.z;
+            e.y = fabsf(r.y.x) * h.x + fabsf(r.y.y) * h.y + fabsf(r.y.z) * h.z;
+            e.z = fabsf(r.z.x) * h.x + fabsf(r.z.y) * h.y + fabsf(r.z.z) * h.z;
+        }
+        b->aabb_min_x[i] = b->pos_x[i] - e.x; b->aabb_max_x[i] = b->pos_x[i] + e.x;
+        b->aabb_min_y[i] = b->pos_y[i] - e.y; b->aabb_max_y[i] = b->pos_y[i] + e.y;
+        b->aabb_min_z[i] = b->pos_z[i] - e.z; b->aabb_max_z[i] = b->pos_z[i] + e.z;
+    }
+}
+
+// ============================================================================
+// BROADPHASE (SWEEP AND PRUNE)
+// ============================================================================
+
+typedef struct {
+    float key;
+    uint32_t body;
+} SweepKey;
+
+static int compare_sweep_keys(const void* a, const void* b) {
+    float ka = ((const SweepKey*)a)->key, kb = ((const SweepKey*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+// Full O(n log n) re-sort after bulk insertion; returns 0 on allocation failure
+static int sort_sweep_order_full(PhysicsWorld* physics) {
+    uint32_t n = physics->bodies.count;
+    SweepKey* keys = (SweepKey*)malloc(n * sizeof(SweepKey));
+    if (!keys) return 0;
+    for (uint32_t i = 0; i < n; i++) {
+        keys[i].body = physics->sap_order[i];
+        keys[i].key = physics->bodies.aabb_min_x[keys[i].body];
+    }
+    qsort(keys, n, sizeof(SweepKey), compare_sweep_keys);
+    for (uint32_t i = 0; i < n; i++) {
+        physics->sap_order[i] = keys[i].body;
+    }
+    free(keys);
+    return 1;
+}
+
+static void broadphase(PhysicsWorld* physics) {
+    PhysicsBodies* b = &physics->bodies;
+    uint32_t n = b->count;
+    uint32_t* order = physics->sap_order;
+    const float* min_x = b->aabb_min_x;
+
+    // Many new bodies would make the insertion sort quadratic
+    if (physics->sap_added > n / 16 + 1) {
+        sort_sweep_order_full(physics);
+    }
+    physics->sap_added = 0;
+
+    // Incremental insertion sort: bodies move little per step, so the order
+    // from the previous step is nearly sorted and this runs in ~O(n)
+    uint32_t swaps = 0;
+    for (uint32_t i = 1; i < n; i++) {
+        uint32_t key = order[i];
+        float kx = min_x[key];
+        uint32_t j = i;
+        while (j > 0 && min_x[order[j - 1]] > kx) {
+            order[j] = order[j - 1];
+            j--;
+            swaps++;
+        }
+        order[j] = key;
+    }
+    physics->stats.sap_swaps = swaps;
+
+    // Sweep along X, test Y/Z overlap for intervals that intersect
+    physics->pair_count = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        uint32_t a = order[i];
+        float max_x = b->aabb_max_x[a];
+        for (uint32_t j = i + 1; j < n; j++) {
+            uint32_t c = order[j];
+            if (min_x[c] > max_x) break;
+            if (b->inv_mass[a] == 0.0f && b->inv_mass[c] == 0.0f) continue;
+            if (b->aabb_min_y[a] > b->aabb_max_y[c] || b->aabb_min_y[c] > b->aabb_max_y[a]) continue;
+            if (b->aabb_min_z[a] > b->aabb_max_z[c] || b->aabb_min_z[c] > b->aabb_max_z[a]) continue;
+            if (!ensure_pair_capacity(physics, physics->pair_count + 1)) return;
+            physics->pairs[physics->pair_count].body_a = a;
+            physics->pairs[physics->pair_count].body_b = c;
+            physics->pair_count++;
+        }
+    }
+    physics->stats.pair_count = physics->pair_count;
+}
+
+// ============================================================================
+// NARROWPHASE
+// ============================================================================
+
+static void contact_init(PhysicsContact* c, uint32_t a, uint32_t b, vec3_t normal, vec3_t point, float depth) {
+    memset(c, 0, sizeof(*c));
+    c->body_a = a;
+    c->body_b = b;
+    c->normal = normal;
+    c->point = point;
+    c->depth = depth;
+}
+
+static uint32_t collide_sphere_sphere(const PhysicsBodies* b, uint32_t a, uint32_t s, PhysicsContact* out) {
+    vec3_t pa = body_position(b, a), pb = body_position(b, s);
+    float ra = b->half_x[a], rb = b->half_x[s];
+    vec3_t d = vec3_sub(pb, pa);
+    float dist_sq = vec3_dot(d, d);
+    float r = ra + rb;
+    if (dist_sq >= r * r) return 0;
+    float dist = sqrtf(dist_sq);
+    vec3_t n = dist > 1e-6f ? vec3_scale(d, 1.0f / dist) : vec3_unit_y();
+    float depth = r - dist;
+    contact_init(out, a, s, n, vec3_add(pa, vec3_scale(n, ra - 0.5f * depth)), depth);
+    return 1;
+}
+
+// Box is always body A so the normal points from the box to the sphere
+static uint32_t collide_box_sphere(const PhysicsBodies* b, uint32_t box, uint32_t sphere, PhysicsContact* out) {
+    vec3_t p = body_position(b, box);
+    quat_t q = body_orientation(b, box);
+    vec3_t h = body_half_extents(b, box);
+    vec3_t c = body_position(b, sphere);
+    float r = b->half_x[sphere];
+
+    vec3_t local = quat_rotate_vec3(quat_conjugate(q), vec3_sub(c, p));
+    vec3_t clamped = vec3(clampf(local.x, -h.x, h.x), clampf(local.y, -h.y, h.y), clampf(local.z, -h.z, h.z));
+    vec3_t diff = vec3_sub(local, clamped);
+    float dist_sq = vec3_dot(diff, diff);
+
+    vec3_t n_local, closest = clamped;
+    float depth;
+    if (dist_sq > 1e-12f) {
+        if (dist_sq >= r * r) return 0;
+        float dist = sqrtf(dist_sq);
+        n_local = vec3_scale(diff, 1.0f / dist);
+        depth = r - dist;
+    } else {
+        // Center inside the box: push out through the nearest face
+        float dx = h.x - fabsf(local.x), dy = h.y - fabsf(local.y), dz = h.z - fabsf(local.z);
+        if (dx <= dy && dx <= dz) {
+            n_local = vec3(local.x < 0.0f ? -1.0f : 1.0f, 0.0f, 0.0f);
+            closest.x = n_local.x * h.x;
+            depth = r + dx;
+        } else if (dy <= dz) {
+            n_local = vec3(0.0f, local.y < 0.0f ? -1.0f : 1.0f, 0.0f);
+            closest.y = n_local.y * h.y;
+            depth = r + dy;
+        } else {
+            n_local = vec3(0.0f, 0.0f, local.z < 0.0f ? -1.0f : 1.0f);
+            closest.z = n_local.z * h.z;
+            depth = r + dz;
+        }
+    }
+
+    vec3_t n = quat_rotate_vec3(q, n_local);
+    vec3_t point = vec3_add(p, quat_rotate_vec3(q, closest));
+    contact_init(out, box, sphere, n, point, depth);
+    return 1;
+}
+
+typedef struct {
+    vec3_t center;
+    vec3_t axis[3];
+    float half[3];
+} OrientedBox;
+
+static OrientedBox oriented_box(const PhysicsBodies* b, uint32_t i) {
+    OrientedBox box;
+    quat_t q = body_orientation(b, i);
+    box.center = body_position(b, i);
+    box.axis[0] = quat_rotate_vec3(q, vec3_unit_x());
+    box.axis[1] = quat_rotate_vec3(q, vec3_unit_y());
+    box.axis[2] = quat_rotate_vec3(q, vec3_unit_z());
+    box.half[0] = b->half_x[i];
+    box.half[1] = b->half_y[i];
+    box.half[2] = b->half_z[i];
+    return box;
+}
+
+FORCE_INLINE float box_projected_radius(const OrientedBox* box, vec3_t axis) {
+    return box->half[0] * fabsf(vec3_dot(box->axis[0], axis)) +
+           box->half[1] * fabsf(vec3_dot(box->axis[1], axis)) +
+           box->half[2] * fabsf(vec3_dot(box->axis[2], axis));
+}
+
+static int box_contains_point(const OrientedBox* box, vec3_t p, float tolerance) {
+    vec3_t d = vec3_sub(p, box->center);
+    for (int k = 0; k < 3; k++) {
+        if (fabsf(vec3_dot(d, box->axis[k])) > box->half[k] + tolerance) return 0;
+    }
+    return 1;
+}
+
+static vec3_t box_vertex(const OrientedBox* box, int index) {
+    vec3_t v = box->center;
+    for (int k = 0; k < 3; k++) {
+        float s = (index & (1 << k)) ? box->half[k] : -box->half[k];
+        v = vec3_add(v, vec3_scale(box->axis[k], s));
+    }
+    return v;
+}
+
+// Keep the deepest contacts when a manifold overflows
+static void manifold_add(PhysicsContact* out, uint32_t* count, uint32_t a, uint32_t b, vec3_t n, vec3_t point, float depth) {
+    if (*count < PHYSICS_MAX_CONTACTS_PER_PAIR) {
+        contact_init(&out[(*count)++], a, b, n, point, depth);
+        return;
+    }
+    uint32_t shallowest = 0;
+    for (uint32_t i = 1; i < *count; i++) {
+        if (out[i].depth < out[shallowest].depth) shallowest = i;
+    }
+    if (depth > out[shallowest].depth) {
+        contact_init(&out[shallowest], a, b, n, point, depth);
+    }
+}
+
+static uint32_t collide_box_box(const PhysicsBodies* b, uint32_t ia, uint32_t ib, PhysicsContact* out) {
+    OrientedBox A = oriented_box(b, ia);
+    OrientedBox B = oriented_box(b, ib);
+    vec3_t d = vec3_sub(B.center, A.center);
+
+    // Separating axis test over 3 + 3 face axes and 9 edge-edge axes
+    float best_overlap = FLT_MAX;
+    vec3_t best_axis = vec3_unit_y();
+    int best_type = -1;        // 0 = face, 1 = edge
+    int best_edge_a = 0, best_edge_b = 0;
+
+    for (int k = 0; k < 6; k++) {
+        vec3_t axis = k < 3 ? A.axis[k] : B.axis[k - 3];
+        float overlap = box_projected_radius(&A, axis) + box_projected_radius(&B, axis) - fabsf(vec3_dot(d, axis));
+        if (overlap < 0.0f) return 0;
+        if (overlap < best_overlap) {
+            best_overlap = overlap;
+            best_axis = axis;
+            best_type = 0;
+        }
+    }
+    float best_face_overlap = best_overlap;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            vec3_t axis = vec3_cross(A.axis[i], B.axis[j]);
+            float len = vec3_length(axis);
+            if (len < 1e-4f) continue; // Parallel edges: covered by face axes
+            axis = vec3_scale(axis, 1.0f / len);
+            float overlap = box_projected_radius(&A, axis) + box_projected_radius(&B, axis) - fabsf(vec3_dot(d, axis));
+            if (overlap < 0.0f) return 0;
+            // Prefer face contacts unless an edge axis is clearly better
+            if (overlap < best_overlap && overlap < 0.95f * best_face_overlap - 0.001f) {
+                best_overlap = overlap;
+                best_axis = axis;
+                best_type = 1;
+                best_edge_a = i;
+                best_edge_b = j;
+            }
+        }
+    }
+
+    vec3_t n = vec3_dot(d, best_axis) < 0.0f ? vec3_neg(best_axis) : best_axis;
+    uint32_t count = 0;
+
+    if (best_type == 1) {
+        // Closest points between the two supporting edges
+        vec3_t ca = A.center, cb = B.center;
+        for (int k = 0; k < 3; k++) {
+            if (k != best_edge_a) {
+                float s = vec3_dot(A.axis[k], n) > 0.0f ? A.half[k] : -A.half[k];
+                ca = vec3_add(ca, vec3_scale(A.axis[k], s));
+            }
+            if (k != best_edge_b) {
+                float s = vec3_dot(B.axis[k], n) < 0.0f ? B.half[k] : -B.half[k];
+                cb = vec3_add(cb, vec3_scale(B.axis[k], s));
+            }
+        }
+        vec3_t ua = A.axis[best_edge_a], ub = B.axis[best_edge_b];
+        vec3_t r = vec3_sub(ca, cb);
+        float uab = vec3_dot(ua, ub);
+        float denom = 1.0f - uab * uab;
+        float ta = 0.0f, tb = 0.0f;
+        if (denom > 1e-6f) {
+            float da = vec3_dot(ua, r), db = vec3_dot(ub, r);
+            ta = clampf((uab * db - da) / denom, -A.half[best_edge_a], A.half[best_edge_a]);
+            tb = clampf(db + uab * ta, -B.half[best_edge_b], B.half[best_edge_b]);
+        }
+        vec3_t pa = vec3_add(ca, vec3_scale(ua, ta));
+        vec3_t pb = vec3_add(cb, vec3_scale(ub, tb));
+        manifold_add(out, &count, ia, ib, n, vec3_scale(vec3_add(pa, pb), 0.5f), best_overlap);
+        return count;
+    }
+
+    // Face contact: vertices of either box inside the other, depth along n
+    const float tolerance = PHYSICS_LINEAR_SLOP + 0.01f;
+    float a_support = vec3_dot(n, A.center) + box_projected_radius(&A, n);
+    float b_support = vec3_dot(n, B.center) - box_projected_radius(&B, n);
+    for (int v = 0; v < 8; v++) {
+        vec3_t pb = box_vertex(&B, v);
+        float depth = a_support - vec3_dot(n, pb);
+        if (depth > 0.0f && box_contains_point(&A, pb, tolerance)) {
+            manifold_add(out, &count, ia, ib, n, vec3_add(pb, vec3_scale(n, 0.5f * depth)), depth);
+        }
+        vec3_t pa = box_vertex(&A, v);
+        depth = vec3_dot(n, pa) - b_support;
+        if (depth > 0.0f && box_contains_point(&B, pa, tolerance)) {
+            manifold_add(out, &count, ia, ib, n, vec3_sub(pa, vec3_scale(n, 0.5f * depth)), depth);
+        }
+    }
+
+    if (count == 0) {
+        // Crossed faces with no vertex inside: single contact mid-overlap
+        vec3_t point = vec3_add(A.center, vec3_scale(n, box_projected_radius(&A, n) - 0.5f * best_overlap));
+        manifold_add(out, &count, ia, ib, n, point, best_overlap);
+    }
+    return count;
+}
+
+static void narrowphase(PhysicsWorld* physics) {
+    PhysicsBodies* b = &physics->bodies;
+    physics->contact_count = 0;
+
+    for (uint32_t p = 0; p < physics->pair_count; p++) {
+        if (!ensure_contact_capacity(physics, physics->contact_count + PHYSICS_MAX_CONTACTS_PER_PAIR)) {
+            break;
+        }
+        uint32_t a = physics->pairs[p].body_a;
+        uint32_t c = physics->pairs[p].body_b;
+        PhysicsContact* out = physics->contacts + physics->contact_count;
+        uint8_t sa = b->shape[a], sc = b->shape[c];
+
+        uint32_t added;
+        if (sa == PHYSICS_SHAPE_SPHERE && sc == PHYSICS_SHAPE_SPHERE) {
+            added = collide_sphere_sphere(b, a, c, out);
+        } else if (sa == PHYSICS_SHAPE_BOX && sc == PHYSICS_SHAPE_SPHERE) {
+            added = collide_box_sphere(b, a, c, out);
+        } else if (sa == PHYSICS_SHAPE_SPHERE && sc == PHYSICS_SHAPE_BOX) {
+            added = collide_box_sphere(b, c, a, out);
+        } else {
+            added = collide_box_box(b, a, c, out);
+        }
+        physics->contact_count += added;
+    }
+    physics->stats.contact_count = physics->contact_count;
+}
+
+// ============================================================================
+// ISLANDS
+// ============================================================================
+
+static uint32_t island_find(uint32_t* parent, uint32_t i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]]; // Path halving
+        i = parent[i];
+    }
+    return i;
+}
+
+// Group contacts by connected dynamic bodies. Static bodies never join
+// islands, so islands share no written state and can be solved in parallel.
+static void build_islands(PhysicsWorld* physics) {
+    PhysicsBodies* b = &physics->bodies;
+    uint32_t* parent = physics->island_parent;
+    uint32_t* island_id = physics->island_id;
+
+    for (uint32_t i = 0; i < b->count; i++) {
+        parent[i] = i;
+        island_id[i] = PHYSICS_INVALID_BODY;
+    }
+
+    for (uint32_t c = 0; c < physics->contact_count; c++) {
+        uint32_t a = physics->contacts[c].body_a;
+        uint32_t d = physics->contacts[c].body_b;
+        if (b->inv_mass[a] > 0.0f && b->inv_mass[d] > 0.0f) {
+            uint32_t ra = island_find(parent, a), rd = island_find(parent, d);
+            if (ra != rd) parent[ra] = rd;
+        }
+    }
+
+    // Assign island ids and count contacts per island
+    physics->island_count = 0;
+    for (uint32_t c = 0; c < physics->contact_count; c++) {
+        PhysicsContact* contact = &physics->contacts[c];
+        uint32_t dyn = b->inv_mass[contact->body_a] > 0.0f ? contact->body_a : contact->body_b;
+        uint32_t root = island_find(parent, dyn);
+        if (island_id[root] == PHYSICS_INVALID_BODY) {
+            island_id[root] = physics->island_count;
+            physics->islands[physics->island_count].contact_start = 0;
+            physics->islands[physics->island_count].contact_count = 0;
+            physics->island_count++;
+        }
+        physics->islands[island_id[root]].contact_count++;
+    }
+
+    // Prefix sum, then scatter contacts so each island is contiguous
+    uint32_t offset = 0;
+    for (uint32_t i = 0; i < physics->island_count; i++) {
+        physics->islands[i].contact_start = offset;
+        offset += physics->islands[i].contact_count;
+        physics->islands[i].contact_count = 0;
+    }
+    for (uint32_t c = 0; c < physics->contact_count; c++) {
+        PhysicsContact* contact = &physics->contacts[c];
+        uint32_t dyn = b->inv_mass[contact->body_a] > 0.0f ? contact->body_a : contact->body_b;
+        PhysicsIsland* island = &physics->islands[island_id[island_find(parent, dyn)]];
+        physics->contacts_sorted[island->contact_start + island->contact_count++] = *contact;
+    }
+    physics->stats.island_count = physics->island_count;
+}
+
+// ============================================================================
+// SEQUENTIAL IMPULSE SOLVER
+// ============================================================================
+
+typedef struct {
+    PhysicsWorld* physics;
+    float inv_dt;
+} PhysicsSolveJob;
+
+// World inverse inertia times a vector
+FORCE_INLINE vec3_t inv_inertia_mul(const PhysicsBodies* b, uint32_t i, vec3_t v) {
+    return vec3(b->inv_iw_xx[i] * v.x + b->inv_iw_xy[i] * v.y + b->inv_iw_xz[i] * v.z,
+                b->inv_iw_xy[i] * v.x + b->inv_iw_yy[i] * v.y + b->inv_iw_yz[i] * v.z,
+                b->inv_iw_xz[i] * v.x + b->inv_iw_yz[i] * v.y + b->inv_iw_zz[i] * v.z);
+}
+
+FORCE_INLINE float effective_mass_term(const PhysicsBodies* b, uint32_t i, vec3_t r, vec3_t axis) {
+    vec3_t rn = vec3_cross(r, axis);
+    return vec3_dot(rn, inv_inertia_mul(b, i, rn));
+}
+
+FORCE_INLINE vec3_t contact_relative_velocity(const PhysicsBodies* b, const PhysicsContact* c) {
+    vec3_t va = vec3_add(body_velocity(b, c->body_a), vec3_cross(body_angular_velocity(b, c->body_a), c->ra));
+    vec3_t vb = vec3_add(body_velocity(b, c->body_b), vec3_cross(body_angular_velocity(b, c->body_b), c->rb));
+    return vec3_sub(vb, va);
+}
+
+// Apply +impulse to B and -impulse to A; static bodies are never written
+static void apply_contact_impulse(PhysicsBodies* b, const PhysicsContact* c, vec3_t impulse) {
+    uint32_t a = c->body_a, d = c->body_b;
+    if (b->inv_mass[a] > 0.0f) {
+        float im = b->inv_mass[a];
+        b->vel_x[a] -= impulse.x * im; b->vel_y[a] -= impulse.y * im; b->vel_z[a] -= impulse.z * im;
+        vec3_t dw = inv_inertia_mul(b, a, vec3_cross(c->ra, impulse));
+        b->ang_x[a] -= dw.x; b->ang_y[a] -= dw.y; b->ang_z[a] -= dw.z;
+    }
+    if (b->inv_mass[d] > 0.0f) {
+        float im = b->inv_mass[d];
+        b->vel_x[d] += impulse.x * im; b->vel_y[d] += impulse.y * im; b->vel_z[d] += impulse.z * im;
+        vec3_t dw = inv_inertia_mul(b, d, vec3_cross(c->rb, impulse));
+        b->ang_x[d] += dw.x; b->ang_y[d] += dw.y; b->ang_z[d] += dw.z;
+    }
+}
+
+static void prepare_contact(PhysicsBodies* b, PhysicsContact* c, float inv_dt) {
+    uint32_t a = c->body_a, d = c->body_b;
+    c->ra = vec3_sub(c->point, body_position(b, a));
+    c->rb = vec3_sub(c->point, body_position(b, d));
+    tangent_basis(c->normal, &c->tangent1, &c->tangent2);
+
+    float inv_mass_sum = b->inv_mass[a] + b->inv_mass[d];
+
+    float kn = inv_mass_sum + effective_mass_term(b, a, c->ra, c->normal) + effective_mass_term(b, d, c->rb, c->normal);
+    float kt1 = inv_mass_sum + effective_mass_term(b, a, c->ra, c->tangent1) + effective_mass_term(b, d, c->rb, c->tangent1);
+    float kt2 = inv_mass_sum + effective_mass_term(b, a, c->ra, c->tangent2) + effective_mass_term(b, d, c->rb, c->tangent2);
+    c->normal_mass = kn > 0.0f ? 1.0f / kn : 0.0f;
+    c->tangent_mass1 = kt1 > 0.0f ? 1.0f / kt1 : 0.0f;
+    c->tangent_mass2 = kt2 > 0.0f ? 1.0f / kt2 : 0.0f;
+
+    c->friction = sqrtf(b->friction[a] * b->friction[d]);
+    float restitution = b->restitution[a] > b->restitution[d] ? b->restitution[a] : b->restitution[d];
+
+    float penetration = c->depth - PHYSICS_LINEAR_SLOP;
+    c->bias = penetration > 0.0f ? PHYSICS_BAUMGARTE * inv_dt * penetration : 0.0f;
+    float vn = vec3_dot(contact_relative_velocity(b, c), c->normal);
+    if (vn < -PHYSICS_RESTITUTION_THRESHOLD) {
+        c->bias += -restitution * vn;
+    }
+    c->normal_impulse = 0.0f;
+    c->tangent_impulse1 = 0.0f;
+    c->tangent_impulse2 = 0.0f;
+}
+
+static void solve_contact(PhysicsBodies* b, PhysicsContact* c) {
+    // Friction, clamped by the current normal impulse
+    float max_friction = c->friction * c->normal_impulse;
+    vec3_t dv = contact_relative_velocity(b, c);
+    float lambda = -vec3_dot(dv, c->tangent1) * c->tangent_mass1;
+    float old = c->tangent_impulse1;
+    c->tangent_impulse1 = clampf(old + lambda, -max_friction, max_friction);
+    apply_contact_impulse(b, c, vec3_scale(c->tangent1, c->tangent_impulse1 - old));
+
+    dv = contact_relative_velocity(b, c);
+    lambda = -vec3_dot(dv, c->tangent2) * c->tangent_mass2;
+    old = c->tangent_impulse2;
+    c->tangent_impulse2 = clampf(old + lambda, -max_friction, max_friction);
+    apply_contact_impulse(b, c, vec3_scale(c->tangent2, c->tangent_impulse2 - old));
+
+    // Non-penetration, accumulated impulse clamped to push only
+    dv = contact_relative_velocity(b, c);
+    lambda = (c->bias - vec3_dot(dv, c->normal)) * c->normal_mass;
+    old = c->normal_impulse;
+    c->normal_impulse = old + lambda > 0.0f ? old + lambda : 0.0f;
+    apply_contact_impulse(b, c, vec3_scale(c->normal, c->normal_impulse - old));
+}
+
+static void solve_islands_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    PhysicsSolveJob* job = (PhysicsSolveJob*)user_data;
+    PhysicsWorld* physics = job->physics;
+    PhysicsBodies* b = &physics->bodies;
+
+    for (uint32_t i = begin; i < end; i++) {
+        PhysicsIsland* island = &physics->islands[i];
+        PhysicsContact* contacts = physics->contacts_sorted + island->contact_start;
+        for (uint32_t c = 0; c < island->contact_count; c++) {
+            prepare_contact(b, &contacts[c], job->inv_dt);
+        }
+        for (uint32_t it = 0; it < physics->solver_iterations; it++) {
+            for (uint32_t c = 0; c < island->contact_count; c++) {
+                solve_contact(b, &contacts[c]);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// STEP
+// ============================================================================
+
+void physics_step(PhysicsWorld* physics, float dt, JobSystemHandle jobs) {
+    if (!physics || dt <= 0.0f || physics->bodies.count == 0) {
+        return;
+    }
+
+    uint32_t n = physics->bodies.count;
+    PhysicsIntegrateJob integrate = { physics, dt };
+
+    // 1. External forces
+    job_system_parallel_for(jobs, n, 1024, integrate_velocities_range, &integrate);
+
+    // 2. Collision detection on current poses
+    job_system_parallel_for(jobs, n, 1024, update_derived_range, &integrate);
+    broadphase(physics);
+    narrowphase(physics);
+
+    // 3. Velocity constraints, one island per task
+    build_islands(physics);
+    PhysicsSolveJob solve = { physics, 1.0f / dt };
+    job_system_parallel_for(jobs, physics->island_count, 16, solve_islands_range, &solve);
+
+    // 4. Advance poses with the solved velocities
+    job_system_parallel_for(jobs, n, 1024, integrate_positions_range, &integrate);
+}
+
+void physics_sync_to_world(const PhysicsWorld* physics, World* world) {
+    if (!physics || !world) {
+        return;
+    }
+
+    const PhysicsBodies* b = &physics->bodies;
+    for (uint32_t i = 0; i < b->count; i++) {
+        if (b->inv_mass[i] == 0.0f) continue;
+        uint32_t slot = b->entity_slot[i];
+        if (slot >= world->max_entities) continue;
+        WorldEntity* entity = &world->entities[slot];
+        if (entity->id != b->entity_id[i]) continue; // Entity was destroyed
+        entity->position = body_position(b, i);
+        entity->orientation = body_orientation(b, i);
+    }
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void physics_print(const char* name, const PhysicsWorld* physics) {
+    if (!physics) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s:\n", name);
+    printf("  Bodies: %u / %u\n", physics->bodies.count, physics->bodies.capacity);
+    printf("  Gravity: (%.3f, %.3f, %.3f)\n", physics->gravity.x, physics->gravity.y, physics->gravity.z);
+    printf("  Solver iterations: %u\n", physics->solver_iterations);
+    printf("  Pairs: %u  Contacts: %u  Islands: %u  SAP swaps: %u\n",
+           physics->stats.pair_count, physics->stats.contact_count,
+           physics->stats.island_count, physics->stats.sap_swaps);
+}
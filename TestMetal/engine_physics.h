@@ -0,0 +1,197 @@
+#ifndef ENGINE_PHYSICS_H
+#define ENGINE_PHYSICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_world.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+
+// ============================================================================
+// PHYSICS CONFIGURATION
+// ============================================================================
+
+#define PHYSICS_DEFAULT_SOLVER_ITERATIONS 8     // Sequential impulse passes per step
+#define PHYSICS_MAX_CONTACTS_PER_PAIR 4         // Manifold size for box contacts
+#define PHYSICS_LINEAR_SLOP 0.005f              // Allowed penetration before correction
+#define PHYSICS_BAUMGARTE 0.2f                  // Position error correction factor
+#define PHYSICS_RESTITUTION_THRESHOLD 1.0f      // Minimum approach speed for bounce
+#define PHYSICS_INVALID_BODY 0xFFFFFFFFu
+
+// ============================================================================
+// PHYSICS DATA STRUCTURES
+// ============================================================================
+
+// Collision shape types
+typedef enum {
+    PHYSICS_SHAPE_SPHERE = 0,
+    PHYSICS_SHAPE_BOX = 1
+} PhysicsShapeType;
+
+// Body creation parameters
+typedef struct {
+    PhysicsShapeType shape;
+    vec3_t half_extents;        // Box half extents (x is the radius for spheres)
+    float mass;                 // 0 creates a static body
+    float restitution;          // Bounciness [0, 1]
+    float friction;             // Coulomb friction coefficient
+    vec3_t velocity;            // Initial linear velocity
+    vec3_t angular_velocity;    // Initial angular velocity (world space)
+} PhysicsBodyDesc;
+
+// Rigid bodies in structure-of-arrays layout. Slots [0, count) are dense;
+// removal swaps the last body into the freed slot.
+typedef struct {
+    uint32_t count;
+    uint32_t capacity;
+
+    // Owning World entity (id + slot index for O(1) validated lookup)
+    uint32_t* entity_id;
+    uint32_t* entity_slot;
+
+    // State
+    float* pos_x; float* pos_y; float* pos_z;
+    float* rot_x; float* rot_y; float* rot_z; float* rot_w;
+    float* vel_x; float* vel_y; float* vel_z;
+    float* ang_x; float* ang_y; float* ang_z;
+
+    // Mass properties (inverse inertia is the diagonal of the local tensor)
+    float* inv_mass;
+    float* inv_inertia_x; float* inv_inertia_y; float* inv_inertia_z;
+
+    // Shape and material
+    uint8_t* shape;
+    float* half_x; float* half_y; float* half_z;
+    float* restitution;
+    float* friction;
+
+    // Derived each step (world inverse inertia is symmetric: 6 unique terms)
+    float* inv_iw_xx; float* inv_iw_xy; float* inv_iw_xz;
+    float* inv_iw_yy; float* inv_iw_yz; float* inv_iw_zz;
+    float* aabb_min_x; float* aabb_min_y; float* aabb_min_z;
+    float* aabb_max_x; float* aabb_max_y; float* aabb_max_z;
+} PhysicsBodies;
+
+// Broadphase candidate pair
+typedef struct {
+    uint32_t body_a;
+    uint32_t body_b;
+} PhysicsPair;
+
+// Contact point with solver scratch data
+typedef struct {
+    uint32_t body_a;
+    uint32_t body_b;
+    vec3_t normal;              // Points from A to B
+    vec3_t point;               // World-space contact point
+    float depth;                // Penetration depth (positive when overlapping)
+
+    vec3_t ra, rb;              // Contact offsets from body centers
+    vec3_t tangent1, tangent2;
+    float normal_mass;
+    float tangent_mass1, tangent_mass2;
+    float bias;
+    float friction;
+    float normal_impulse;
+    float tangent_impulse1, tangent_impulse2;
+} PhysicsContact;
+
+// Connected set of interacting dynamic bodies; contacts are stored contiguously
+typedef struct {
+    uint32_t contact_start;
+    uint32_t contact_count;
+} PhysicsIsland;
+
+// Per-step counters
+typedef struct {
+    uint32_t pair_count;
+    uint32_t contact_count;
+    uint32_t island_count;
+    uint32_t sap_swaps;         // Insertion-sort swaps (low when coherent)
+} PhysicsStats;
+
+// Physics world operating on World entities
+typedef struct {
+    PhysicsBodies bodies;
+    vec3_t gravity;
+    float linear_damping;
+    float angular_damping;
+    uint32_t solver_iterations;
+
+    // Sweep-and-prune: body indices sorted by aabb_min_x, kept between steps
+    uint32_t* sap_order;
+    uint32_t sap_added;             // Bodies appended since the last sort
+
+    PhysicsPair* pairs;
+    uint32_t pair_count;
+    uint32_t pair_capacity;
+
+    PhysicsContact* contacts;
+    PhysicsContact* contacts_sorted;
+    uint32_t contact_count;
+    uint32_t contact_capacity;
+
+    // Island building scratch (union-find parents per body)
+    uint32_t* island_parent;
+    uint32_t* island_id;
+    PhysicsIsland* islands;
+    uint32_t island_count;
+
+    PhysicsStats stats;
+} PhysicsWorld;
+
+// ============================================================================
+// PHYSICS WORLD FUNCTIONS
+// ============================================================================
+
+// Create a physics world that can hold up to max_bodies rigid bodies
+PhysicsWorld* physics_world_create(uint32_t max_bodies);
+
+// Destroy a physics world and free all associated memory
+void physics_world_destroy(PhysicsWorld* physics);
+
+// Advance the simulation by dt seconds. jobs may be NULL (serial).
+void physics_step(PhysicsWorld* physics, float dt, JobSystemHandle jobs);
+
+// Copy simulated transforms of dynamic bodies back to their World entities
+void physics_sync_to_world(const PhysicsWorld* physics, World* world);
+
+// ============================================================================
+// BODY MANAGEMENT FUNCTIONS
+// ============================================================================
+
+// Default body description (unit box, mass 1)
+PhysicsBodyDesc physics_body_desc_default(void);
+
+// Attach a rigid body to an entity; takes the entity's current transform.
+// Returns the body index or PHYSICS_INVALID_BODY on failure.
+uint32_t physics_add_body(PhysicsWorld* physics, const World* world, const WorldEntity* entity, const PhysicsBodyDesc* desc);
+
+// Remove a body (the last body moves into its index)
+int physics_remove_body(PhysicsWorld* physics, uint32_t body);
+
+// Find the body attached to an entity (linear search)
+uint32_t physics_find_body(const PhysicsWorld* physics, uint32_t entity_id);
+
+// Body state access
+void physics_set_velocity(PhysicsWorld* physics, uint32_t body, vec3_t velocity);
+vec3_t physics_get_velocity(const PhysicsWorld* physics, uint32_t body);
+void physics_set_angular_velocity(PhysicsWorld* physics, uint32_t body, vec3_t angular_velocity);
+vec3_t physics_get_position(const PhysicsWorld* physics, uint32_t body);
+quat_t physics_get_orientation(const PhysicsWorld* physics, uint32_t body);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print physics world statistics
+void physics_print(const char* name, const PhysicsWorld* physics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_PHYSICS_H
@@ -0,0 +1,397 @@
+#include "engine_physics.h"
+#include "engine_profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Add an entity with a body at the given position
+static uint32_t spawn_body(PhysicsWorld* physics, World* world, const char* name,
+                           vec3_t position, const PhysicsBodyDesc* desc) {
+    WorldEntity* entity = world_create_entity(world, name);
+    if (!entity) return PHYSICS_INVALID_BODY;
+    entity_set_position(entity, position);
+    return physics_add_body(physics, world, entity, desc);
+}
+
+// Large static ground box with its top face at y = 0
+static uint32_t spawn_ground(PhysicsWorld* physics, World* world, float half_size) {
+    PhysicsBodyDesc ground = physics_body_desc_default();
+    ground.mass = 0.0f;
+    ground.half_extents = vec3(half_size, 1.0f, half_size);
+    return spawn_body(physics, world, "Ground", vec3(0.0f, -1.0f, 0.0f), &ground);
+}
+
+// ============================================================================
+// TEST FUNCTIONS
+// ============================================================================
+
+static void test_body_management(void) {
+    printf("\n--- Body Management Tests ---\n");
+
+    World* world = world_create(8);
+    PhysicsWorld* physics = physics_world_create(4);
+    TEST_ASSERT_NOT_NULL(physics, "Physics world should be created");
+
+    PhysicsBodyDesc desc = physics_body_desc_default();
+    uint32_t a = spawn_body(physics, world, "A", vec3(1.0f, 2.0f, 3.0f), &desc);
+    uint32_t b = spawn_body(physics, world, "B", vec3(4.0f, 5.0f, 6.0f), &desc);
+    TEST_ASSERT_EQUAL(0u, a, "First body should get index 0");
+    TEST_ASSERT_EQUAL(1u, b, "Second body should get index 1");
+
+    WorldEntity* entity_b = world_get_entity_by_name(world, "B");
+    TEST_ASSERT_EQUAL(b, physics_find_body(physics, entity_b->id), "Body should be found by entity id");
+
+    TEST_ASSERT(physics_remove_body(physics, a), "Body removal should succeed");
+    TEST_ASSERT_EQUAL(1u, physics->bodies.count, "Body count should drop after removal");
+    TEST_ASSERT_EQUAL(0u, physics_find_body(physics, entity_b->id), "Last body should move into the freed index");
+    vec3_t p = physics_get_position(physics, 0);
+    TEST_ASSERT(p.x == 4.0f && p.y == 5.0f && p.z == 6.0f, "Moved body should keep its state");
+
+    World* other = world_create(1);
+    WorldEntity* foreign = world_create_entity(other, "Foreign");
+    TEST_ASSERT_EQUAL(PHYSICS_INVALID_BODY, physics_add_body(physics, world, foreign, &desc),
+                      "Entity from another world should be rejected");
+
+    physics_world_destroy(physics);
+    world_destroy(other);
+    world_destroy(world);
+}
+
+static void test_broadphase_pairs(void) {
+    printf("\n--- Broadphase Tests ---\n");
+
+    World* world = world_create(8);
+    PhysicsWorld* physics = physics_world_create(8);
+    physics->gravity = vec3_zero();
+
+    PhysicsBodyDesc desc = physics_body_desc_default();
+    spawn_body(physics, world, "Far", vec3(10.0f, 0.0f, 0.0f), &desc);
+    spawn_body(physics, world, "Near1", vec3(0.0f, 0.0f, 0.0f), &desc);
+    spawn_body(physics, world, "Near2", vec3(0.9f, 0.0f, 0.0f), &desc);
+    spawn_body(physics, world, "OffY", vec3(0.5f, 5.0f, 0.0f), &desc);
+
+    physics_step(physics, 1.0f / 60.0f, NULL);
+    TEST_ASSERT_EQUAL(1u, physics->stats.pair_count, "Only overlapping AABBs should form a pair");
+    TEST_ASSERT(physics->stats.contact_count >= 1, "Overlapping boxes should produce contacts");
+
+    // Nothing moves much, so the sweep order should already be sorted
+    physics_step(physics, 1.0f / 60.0f, NULL);
+    TEST_ASSERT_EQUAL(0u, physics->stats.sap_swaps, "Coherent frames should need no SAP swaps");
+
+    physics_world_destroy(physics);
+    world_destroy(world);
+}
+
+static void test_sphere_rests_on_ground(void) {
+    printf("\n--- Sphere Resting Contact Tests ---\n");
+
+    World* world = world_create(4);
+    PhysicsWorld* physics = physics_world_create(4);
+    spawn_ground(physics, world, 10.0f);
+
+    PhysicsBodyDesc ball = physics_body_desc_default();
+    ball.shape = PHYSICS_SHAPE_SPHERE;
+    ball.half_extents = vec3(0.5f, 0.0f, 0.0f);
+    ball.restitution = 0.0f;
+    uint32_t body = spawn_body(physics, world, "Ball", vec3(0.0f, 3.0f, 0.0f), &ball);
+
+    for (int i = 0; i < 240; i++) {
+        physics_step(physics, 1.0f / 60.0f, NULL);
+    }
+
+    vec3_t p = physics_get_position(physics, body);
+    vec3_t v = physics_get_velocity(physics, body);
+    TEST_ASSERT(fabsf(p.y - 0.5f) < 0.02f, "Sphere should rest on top of the ground");
+    TEST_ASSERT(vec3_length(v) < 0.05f, "Resting sphere should have settled");
+
+    physics_sync_to_world(physics, world);
+    WorldEntity* entity = world_get_entity_by_name(world, "Ball");
+    TEST_ASSERT(fabsf(entity->position.y - p.y) < 1e-6f, "Sync should copy body position to the entity");
+    WorldEntity* ground = world_get_entity_by_name(world, "Ground");
+    TEST_ASSERT(ground->position.y == -1.0f, "Static bodies should never move");
+
+    physics_world_destroy(physics);
+    world_destroy(world);
+}
+
+static void test_box_stack(void) {
+    printf("\n--- Box Stacking Tests ---\n");
+
+    World* world = world_create(8);
+    PhysicsWorld* physics = physics_world_create(8);
+    spawn_ground(physics, world, 10.0f);
+
+    PhysicsBodyDesc box = physics_body_desc_default();
+    box.restitution = 0.0f;
+    uint32_t bodies[3];
+    for (int i = 0; i < 3; i++) {
+        bodies[i] = spawn_body(physics, world, "Box", vec3(0.0f, 0.5f + 1.01f * i, 0.0f), &box);
+    }
+
+    for (int i = 0; i < 300; i++) {
+        physics_step(physics, 1.0f / 60.0f, NULL);
+    }
+
+    int stacked = 1;
+    for (int i = 0; i < 3; i++) {
+        vec3_t p = physics_get_position(physics, bodies[i]);
+        if (fabsf(p.y - (0.5f + i)) > 0.1f || fabsf(p.x) > 0.1f || fabsf(p.z) > 0.1f) {
+            stacked = 0;
+        }
+    }
+    TEST_ASSERT(stacked, "Three stacked boxes should stay stacked");
+    TEST_ASSERT_EQUAL(1u, physics->stats.island_count, "Stack should form a single island");
+
+    // A fast box must not tunnel through the ground in one step
+    PhysicsBodyDesc fast = physics_body_desc_default();
+    fast.velocity = vec3(0.0f, -20.0f, 0.0f);
+    uint32_t dropped = spawn_body(physics, world, "Fast", vec3(5.0f, 0.6f, 0.0f), &fast);
+    for (int i = 0; i < 120; i++) {
+        physics_step(physics, 1.0f / 60.0f, NULL);
+    }
+    TEST_ASSERT(physics_get_position(physics, dropped).y > 0.3f, "Fast box should not tunnel through the ground");
+
+    physics_world_destroy(physics);
+    world_destroy(world);
+}
+
+static void test_rotation_integration(void) {
+    printf("\n--- Rotation Integration Tests ---\n");
+
+    World* world = world_create(8);
+    PhysicsWorld* physics = physics_world_create(8);
+    physics->gravity = vec3_zero();
+    physics->angular_damping = 0.0f;
+
+    // Five bodies exercise both the 4-wide and the scalar tail paths
+    PhysicsBodyDesc desc = physics_body_desc_default();
+    desc.angular_velocity = vec3(0.0f, (float)M_PI, 0.0f);
+    for (int i = 0; i < 5; i++) {
+        spawn_body(physics, world, "Spinner", vec3(3.0f * i, 0.0f, 0.0f), &desc);
+    }
+
+    for (int i = 0; i < 60; i++) {
+        physics_step(physics, 1.0f / 60.0f, NULL);
+    }
+
+    // Half a turn around Y after one second
+    int ok = 1;
+    for (uint32_t i = 0; i < 5; i++) {
+        quat_t q = physics_get_orientation(physics, i);
+        if (fabsf(fabsf(q.y) - 1.0f) > 0.01f || fabsf(quat_length(q) - 1.0f) > 1e-4f) {
+            ok = 0;
+        }
+    }
+    TEST_ASSERT(ok, "Angular velocity should integrate into unit orientations");
+
+    physics_world_destroy(physics);
+    world_destroy(world);
+}
+
+// Fill a world with a pile of mixed boxes and spheres above the ground
+static void build_pile(PhysicsWorld* physics, World* world, uint32_t count) {
+    spawn_ground(physics, world, 200.0f);
+
+    PhysicsBodyDesc box = physics_body_desc_default();
+    PhysicsBodyDesc ball = physics_body_desc_default();
+    ball.shape = PHYSICS_SHAPE_SPHERE;
+    ball.half_extents = vec3(0.5f, 0.0f, 0.0f);
+
+    uint32_t side = (uint32_t)ceilf(sqrtf((float)count / 4.0f));
+    float origin = -(float)side;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t layer = i / (side * side);
+        uint32_t cell = i % (side * side);
+        float jitter = 0.05f * (float)((i * 7919u) % 13u) / 13.0f;
+        vec3_t p = vec3(origin + 2.0f * (cell % side) + jitter,
+                        1.0f + 1.5f * layer,
+                        origin + 2.0f * (cell / side) - jitter);
+        spawn_body(physics, world, "Body", p, (i & 1) ? &ball : &box);
+    }
+}
+
+static void test_parallel_matches_serial(void) {
+    printf("\n--- Parallel Solver Tests ---\n");
+
+    const uint32_t count = 2000;
+    World* world_a = world_create(count + 1);
+    World* world_b = world_create(count + 1);
+    PhysicsWorld* serial = physics_world_create(count + 1);
+    PhysicsWorld* parallel = physics_world_create(count + 1);
+    build_pile(serial, world_a, count);
+    build_pile(parallel, world_b, count);
+
+    JobSystemHandle jobs = job_system_create(4);
+    for (int i = 0; i < 60; i++) {
+        physics_step(serial, 1.0f / 60.0f, NULL);
+        physics_step(parallel, 1.0f / 60.0f, jobs);
+    }
+
+    // Islands share no dynamic bodies, so the result is independent of scheduling
+    int identical = 1;
+    for (uint32_t i = 0; i < serial->bodies.count; i++) {
+        if (serial->bodies.pos_y[i] != parallel->bodies.pos_y[i] ||
+            serial->bodies.vel_y[i] != parallel->bodies.vel_y[i]) {
+            identical = 0;
+            break;
+        }
+    }
+    TEST_ASSERT(identical, "Parallel island solve should match the serial result exactly");
+    TEST_ASSERT(serial->stats.island_count > 1, "Pile should split into multiple islands");
+
+    job_system_destroy(jobs);
+    physics_world_destroy(serial);
+    physics_world_destroy(parallel);
+    world_destroy(world_a);
+    world_destroy(world_b);
+}
+
+typedef struct {
+    JobSystemHandle jobs;
+    uint32_t visits[64];
+    uint32_t bad_worker;
+} NestedJobTest;
+
+typedef struct {
+    NestedJobTest* test;
+    uint32_t outer;
+    uint32_t worker_index;      // Of the outer chunk making the nested call
+} NestedJobInner;
+
+static void nested_inner(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    NestedJobInner* inner = (NestedJobInner*)user_data;
+    __sync_fetch_and_add(&inner->test->visits[inner->outer], end - begin);
+    if (worker_index != inner->worker_index) {
+        __sync_fetch_and_add(&inner->test->bad_worker, 1);
+    }
+}
+
+// Each outer item makes a large nested call and one below the grain
+static void nested_outer(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    NestedJobTest* test = (NestedJobTest*)user_data;
+    for (uint32_t i = begin; i < end; i++) {
+        NestedJobInner inner = { test, i, worker_index };
+        job_system_parallel_for(test->jobs, 248, 16, nested_inner, &inner);
+        job_system_parallel_for(test->jobs, 8, 16, nested_inner, &inner);
+    }
+}
+
+static void test_nested_parallel_for(void) {
+    printf("\n--- Nested Job Tests ---\n");
+
+    NestedJobTest test;
+    memset(&test, 0, sizeof(test));
+    test.jobs = job_system_create(4);
+    job_system_parallel_for(test.jobs, 64, 1, nested_outer, &test);
+
+    int complete = 1;
+    for (uint32_t i = 0; i < 64; i++) {
+        if (test.visits[i] != 256) complete = 0;
+    }
+    TEST_ASSERT(complete, "Nested parallel_for should finish and cover every item");
+    TEST_ASSERT_EQUAL(0u, test.bad_worker, "Nested chunks should run on the calling chunk's worker index");
+
+    job_system_destroy(test.jobs);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t count = 10000;
+    const int steps = 120;
+    JobSystemHandle jobs = job_system_create(0);
+
+    for (int pass = 0; pass < 2; pass++) {
+        JobSystemHandle pass_jobs = pass == 0 ? NULL : jobs;
+        World* world = world_create(count + 1);
+        PhysicsWorld* physics = physics_world_create(count + 1);
+        build_pile(physics, world, count);
+
+        double best = 1e9, total = 0.0;
+        for (int i = 0; i < steps; i++) {
+            double start = now_ms();
+            physics_step(physics, 1.0f / 60.0f, pass_jobs);
+            double elapsed = now_ms() - start;
+            total += elapsed;
+            if (elapsed < best) best = elapsed;
+        }
+
+        printf("%u bodies, %s (%u workers): avg %.3f ms/step, best %.3f ms/step\n",
+               count, pass == 0 ? "serial" : "parallel", job_system_get_worker_count(pass_jobs),
+               total / steps, best);
+        physics_print("  Final step", physics);
+        TEST_ASSERT(physics->stats.contact_count > 0, "Benchmark pile should be in contact after settling");
+
+        physics_world_destroy(physics);
+        world_destroy(world);
+    }
+
+    job_system_destroy(jobs);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Physics Unit Tests\n");
+    printf("===================================\n");
+
+    test_body_management();
+    test_broadphase_pairs();
+    test_sphere_rests_on_ground();
+    test_box_stack();
+    test_rotation_integration();
+    test_parallel_matches_serial();
+    test_nested_parallel_for();
+
+    // ENGINE_PROFILE=<file> samples the benchmarks into collapsed stacks
+    ProfilerHandle profiler = profiler_begin_from_env();
+    test_performance();
+    profiler_end_from_env(profiler);
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,981 @@
+// perf_event_open, F_SETSIG, REG_RIP and dladdr are GNU extensions
+#define _GNU_SOURCE
+#include "engine_profiler.h"
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dlfcn.h>
+#include <sys/time.h>
+
+#ifdef __APPLE__
+#include <sys/ucontext.h>
+#else
+#include <ucontext.h>
+#endif
+
+#ifdef __linux__
+#include <dirent.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#define PROFILER_HAS_PERF 1
+#define PROFILER_HAS_PROC 1
+#else
+#define PROFILER_HAS_PERF 0
+#define PROFILER_HAS_PROC 0
+#endif
+
+#define PROFILER_MAX_MAPPINGS 4096
+
+// ============================================================================
+// INTERNAL STRUCTURES
+// ============================================================================
+
+typedef struct {
+    uint32_t tid;
+    uint32_t depth;                     // 0: slot claimed but its frames didn't fit
+    uint32_t first_frame;               // Index into Profiler.frames, innermost first
+    uint64_t counters[PROFILER_COUNTER_COUNT]; // Deltas since the thread's previous sample
+} ProfilerSample;
+
+typedef struct {
+    uint32_t tid;
+    char name[16];                      // comm, captured while the thread is alive
+    volatile int group_fd;              // Task-clock leader, -1 when not attached
+    int member_fds[PROFILER_COUNTER_COUNT];
+    uint32_t member_counters[PROFILER_COUNTER_COUNT]; // Counter at each group read slot
+    uint32_t member_count;
+    uint64_t last[PROFILER_COUNTER_COUNT];  // Touched only by this thread's handler
+} ProfilerThread;
+
+typedef struct {
+    uintptr_t start;
+    uintptr_t end;
+} ProfilerMapping;
+
+typedef struct Profiler {
+    ProfilerDesc desc;
+    ProfilerSample* samples;
+    uintptr_t* frames;
+    uint32_t frame_capacity;
+    volatile uint32_t sample_cursor;    // Claimed by the signal handler
+    volatile uint32_t frame_cursor;
+    volatile uint32_t recorded;
+    volatile uint32_t dropped;
+
+    uint32_t backend;
+    uint32_t counters;                  // Requested counters still supported
+    int running;
+
+    ProfilerThread threads[PROFILER_MAX_THREADS];
+    volatile uint32_t thread_count;     // Bumped after the slot is filled
+
+    // Writable mappings bound the frame-pointer walk. The monitor refreshes
+    // the inactive copy while handlers read the other one.
+    ProfilerMapping* mappings[2];
+    uint32_t mapping_counts[2];
+    volatile uint32_t mapping_index;
+    volatile uint32_t mapping_readers[2];
+
+    pthread_t monitor;
+    int monitor_started;
+    volatile int monitor_stop;
+    volatile uint32_t monitor_tid;
+
+    struct sigaction previous_action;
+    char output_path[PROFILER_PATH_MAX]; // Set by profiler_begin_from_env
+} Profiler;
+
+static const char* const PROFILER_COUNTER_NAMES[PROFILER_COUNTER_COUNT] = {
+    "cycles", "instructions", "llc_misses"
+};
+
+// The profiler that owns SIGPROF (set by start, cleared by stop) and the one
+// the handler records into. Handlers count themselves in so stop can wait
+// for them before closing descriptors or freeing buffers.
+static Profiler* volatile g_profiler_owner = NULL;
+static Profiler* volatile g_active_profiler = NULL;
+static volatile uint32_t g_handlers_inside = 0;
+
+// ============================================================================
+// SIGNAL HANDLER
+// ============================================================================
+
+static uint32_t profiler_current_tid(void) {
+#if defined(__linux__)
+    return (uint32_t)syscall(SYS_gettid);
+#elif defined(__APPLE__)
+    return (uint32_t)pthread_mach_thread_np(pthread_self());
+#else
+    return 0;
+#endif
+}
+
+// Interrupted pc, frame pointer and stack pointer. Returns 0 on platforms
+// whose signal context layout isn't known here.
+static int profiler_context_registers(void* context, uintptr_t* pc, uintptr_t* fp, uintptr_t* sp) {
+    ucontext_t* uc = (ucontext_t*)context;
+#if defined(__linux__) && defined(__x86_64__)
+    *pc = (uintptr_t)uc->uc_mcontext.gregs[REG_RIP];
+    *fp = (uintptr_t)uc->uc_mcontext.gregs[REG_RBP];
+    *sp = (uintptr_t)uc->uc_mcontext.gregs[REG_RSP];
+#elif defined(__linux__) && defined(__aarch64__)
+    *pc = (uintptr_t)uc->uc_mcontext.pc;
+    *fp = (uintptr_t)uc->uc_mcontext.regs[29];
+    *sp = (uintptr_t)uc->uc_mcontext.sp;
+#elif defined(__APPLE__) && defined(__x86_64__)
+    *pc = (uintptr_t)uc->uc_mcontext->__ss.__rip;
+    *fp = (uintptr_t)uc->uc_mcontext->__ss.__rbp;
+    *sp = (uintptr_t)uc->uc_mcontext->__ss.__rsp;
+#elif defined(__APPLE__) && defined(__arm64__)
+    *pc = (uintptr_t)__darwin_arm_thread_state64_get_pc(uc->uc_mcontext->__ss);
+    *fp = (uintptr_t)__darwin_arm_thread_state64_get_fp(uc->uc_mcontext->__ss);
+    *sp = (uintptr_t)__darwin_arm_thread_state64_get_sp(uc->uc_mcontext->__ss);
+#else
+    (void)uc;
+    (void)pc;
+    (void)fp;
+    (void)sp;
+    return 0;
+#endif
+    return 1;
+}
+
+// Bounds of the stack holding sp, so the walk never dereferences a frame
+// pointer outside readable memory
+static int profiler_stack_bounds(Profiler* profiler, uintptr_t sp, uintptr_t* lo, uintptr_t* hi) {
+#if defined(__APPLE__)
+    (void)profiler;
+    pthread_t self = pthread_self();
+    *hi = (uintptr_t)pthread_get_stackaddr_np(self);
+    *lo = *hi - pthread_get_stacksize_np(self);
+    return sp >= *lo && sp < *hi;
+#else
+    uint32_t index;
+    for (;;) {
+        index = __atomic_load_n(&profiler->mapping_index, __ATOMIC_ACQUIRE);
+        __sync_fetch_and_add(&profiler->mapping_readers[index], 1);
+        if (index == __atomic_load_n(&profiler->mapping_index, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        __sync_fetch_and_sub(&profiler->mapping_readers[index], 1);
+    }
+
+    const ProfilerMapping* mappings = profiler->mappings[index];
+    uint32_t low = 0;
+    uint32_t high = profiler->mapping_counts[index];
+    int found = 0;
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (sp < mappings[mid].start) {
+            high = mid;
+        } else if (sp >= mappings[mid].end) {
+            low = mid + 1;
+        } else {
+            *lo = mappings[mid].start;
+            *hi = mappings[mid].end;
+            found = 1;
+            break;
+        }
+    }
+    __sync_fetch_and_sub(&profiler->mapping_readers[index], 1);
+    return found;
+#endif
+}
+
+// Walk the frame-pointer chain. Each record is {caller's fp, return address}
+// and the chain ends with a null fp at the thread entry point.
+static uint32_t profiler_unwind(Profiler* profiler, void* context, uintptr_t* frames) {
+    uintptr_t pc, fp, sp;
+    if (!profiler_context_registers(context, &pc, &fp, &sp) || pc == 0) {
+        return 0;
+    }
+    uint32_t depth = 0;
+    frames[depth++] = pc;
+
+    uintptr_t lo, hi;
+    if (!profiler_stack_bounds(profiler, sp, &lo, &hi)) {
+        return depth;
+    }
+    while (depth < PROFILER_MAX_DEPTH) {
+        if (fp < sp || fp < lo || fp > hi - 2 * sizeof(uintptr_t) || (fp & (sizeof(uintptr_t) - 1)) != 0) {
+            break;
+        }
+        const uintptr_t* record = (const uintptr_t*)fp;
+        uintptr_t next = record[0];
+        uintptr_t ret = record[1];
+        if (ret == 0) {
+            break;
+        }
+        frames[depth++] = ret;
+        if (next <= fp) {
+            break;
+        }
+        fp = next;
+    }
+    return depth;
+}
+
+#if PROFILER_HAS_PERF
+static ProfilerThread* profiler_thread_for_fd(Profiler* profiler, int fd) {
+    uint32_t count = __atomic_load_n(&profiler->thread_count, __ATOMIC_ACQUIRE);
+    for (uint32_t i = 0; i < count; i++) {
+        if (__atomic_load_n(&profiler->threads[i].group_fd, __ATOMIC_ACQUIRE) == fd) {
+            return &profiler->threads[i];
+        }
+    }
+    return NULL;
+}
+
+// read() is async-signal-safe; the group comes back as {nr, leader, members...}
+static void profiler_read_counters(ProfilerThread* thread, uint64_t* counters) {
+    uint64_t values[2 + PROFILER_COUNTER_COUNT];
+    ssize_t bytes = read(thread->group_fd, values, sizeof(values));
+    if (bytes < (ssize_t)(2 * sizeof(uint64_t))) {
+        return;
+    }
+    for (uint32_t i = 0; i < thread->member_count && i + 1 < values[0]; i++) {
+        uint32_t counter = thread->member_counters[i];
+        counters[counter] = values[2 + i] - thread->last[counter];
+        thread->last[counter] = values[2 + i];
+    }
+}
+#endif
+
+static void profiler_record(Profiler* profiler, siginfo_t* info, void* context) {
+    uintptr_t frames[PROFILER_MAX_DEPTH];
+    uint32_t depth = profiler_unwind(profiler, context, frames);
+    if (depth == 0) {
+        __sync_fetch_and_add(&profiler->dropped, 1);
+        return;
+    }
+
+    uint32_t index = __sync_fetch_and_add(&profiler->sample_cursor, 1);
+    if (index >= profiler->desc.max_samples) {
+        __sync_fetch_and_add(&profiler->dropped, 1);
+        return;
+    }
+    ProfilerSample* sample = &profiler->samples[index];
+    sample->depth = 0;
+    for (uint32_t c = 0; c < PROFILER_COUNTER_COUNT; c++) {
+        sample->counters[c] = 0;
+    }
+
+    ProfilerThread* thread = NULL;
+#if PROFILER_HAS_PERF
+    if (profiler->backend == PROFILER_BACKEND_PERF_EVENT && info && info->si_code == POLL_IN) {
+        thread = profiler_thread_for_fd(profiler, info->si_fd);
+    }
+    if (thread) {
+        profiler_read_counters(thread, sample->counters);
+    }
+#else
+    (void)info;
+#endif
+    sample->tid = thread ? thread->tid : profiler_current_tid();
+
+    uint32_t first = __sync_fetch_and_add(&profiler->frame_cursor, depth);
+    if (first > profiler->frame_capacity || depth > profiler->frame_capacity - first) {
+        __sync_fetch_and_add(&profiler->dropped, 1);
+        return;
+    }
+    for (uint32_t i = 0; i < depth; i++) {
+        profiler->frames[first + i] = frames[i];
+    }
+    sample->first_frame = first;
+    sample->depth = depth;
+    __sync_fetch_and_add(&profiler->recorded, 1);
+}
+
+static void profiler_signal_handler(int signal_number, siginfo_t* info, void* context) {
+    (void)signal_number;
+    int saved_errno = errno;
+    __sync_fetch_and_add(&g_handlers_inside, 1);
+    Profiler* profiler = __atomic_load_n(&g_active_profiler, __ATOMIC_ACQUIRE);
+    if (profiler) {
+        profiler_record(profiler, info, context);
+    }
+    __sync_fetch_and_sub(&g_handlers_inside, 1);
+    errno = saved_errno;
+}
+
+// ============================================================================
+// THREAD AND MAPPING DISCOVERY
+// ============================================================================
+
+#if PROFILER_HAS_PROC
+static uint32_t profiler_load_mappings(ProfilerMapping* mappings, uint32_t max_mappings) {
+    FILE* file = fopen("/proc/self/maps", "r");
+    if (!file) {
+        return 0;
+    }
+    char line[512];
+    uint32_t count = 0;
+    while (count < max_mappings && fgets(line, sizeof(line), file)) {
+        // Skip the tail of lines with long paths
+        size_t length = strlen(line);
+        int complete = length > 0 && line[length - 1] == '\n';
+        unsigned long start, end;
+        char perms[5];
+        if (sscanf(line, "%lx-%lx %4s", &start, &end, perms) == 3 && perms[0] == 'r' && perms[1] == 'w') {
+            mappings[count].start = (uintptr_t)start;
+            mappings[count].end = (uintptr_t)end;
+            count++;
+        }
+        while (!complete && fgets(line, sizeof(line), file)) {
+            length = strlen(line);
+            complete = length > 0 && line[length - 1] == '\n';
+        }
+    }
+    fclose(file);
+    return count;
+}
+
+static void profiler_refresh_mappings(Profiler* profiler) {
+    uint32_t current = profiler->mapping_index;
+    uint32_t next = 1 - current;
+    while (__atomic_load_n(&profiler->mapping_readers[next], __ATOMIC_ACQUIRE) != 0) {
+        sched_yield();
+    }
+    profiler->mapping_counts[next] = profiler_load_mappings(profiler->mappings[next], PROFILER_MAX_MAPPINGS);
+    __sync_bool_compare_and_swap(&profiler->mapping_index, current, next);
+}
+
+static void profiler_read_thread_name(uint32_t tid, char* name, size_t size) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%u/comm", tid);
+    name[0] = '\0';
+    FILE* file = fopen(path, "r");
+    if (file) {
+        if (!fgets(name, (int)size, file)) {
+            name[0] = '\0';
+        }
+        fclose(file);
+    }
+    name[strcspn(name, "\n")] = '\0';
+}
+#endif
+
+#if PROFILER_HAS_PERF
+static const uint64_t PROFILER_COUNTER_CONFIGS[PROFILER_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES
+};
+
+static int profiler_perf_event_open(struct perf_event_attr* attr, uint32_t tid, int group_fd) {
+    return (int)syscall(SYS_perf_event_open, attr, (pid_t)tid, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+// Open a task-clock sampling leader for the thread, with the requested
+// hardware counters as group members, and route overflows to that thread
+// as SIGPROF carrying the leader's fd
+static int profiler_attach_thread(Profiler* profiler, ProfilerThread* thread) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_SOFTWARE;
+    attr.config = PERF_COUNT_SW_TASK_CLOCK;
+    attr.sample_period = 1000000000ull / profiler->desc.sample_hz;
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.wakeup_events = 1;
+    int fd = profiler_perf_event_open(&attr, thread->tid, -1);
+    if (fd < 0) {
+        return 0;
+    }
+
+    thread->member_count = 0;
+    for (uint32_t c = 0; c < PROFILER_COUNTER_COUNT; c++) {
+        if (!(profiler->counters & PROFILER_COUNTER_BIT(c))) {
+            continue;
+        }
+        struct perf_event_attr counter;
+        memset(&counter, 0, sizeof(counter));
+        counter.size = sizeof(counter);
+        counter.type = PERF_TYPE_HARDWARE;
+        counter.config = PROFILER_COUNTER_CONFIGS[c];
+        counter.exclude_kernel = 1;
+        counter.exclude_hv = 1;
+        int counter_fd = profiler_perf_event_open(&counter, thread->tid, fd);
+        if (counter_fd < 0) {
+            // No PMU access (common in VMs): keep sampling without this counter
+            profiler->counters &= ~PROFILER_COUNTER_BIT(c);
+            continue;
+        }
+        thread->member_fds[thread->member_count] = counter_fd;
+        thread->member_counters[thread->member_count] = c;
+        thread->last[c] = 0;
+        thread->member_count++;
+    }
+
+    struct f_owner_ex owner;
+    owner.type = F_OWNER_TID;
+    owner.pid = (pid_t)thread->tid;
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_ASYNC) != 0 || fcntl(fd, F_SETSIG, SIGPROF) != 0 ||
+        fcntl(fd, F_SETOWN_EX, &owner) != 0) {
+        for (uint32_t i = 0; i < thread->member_count; i++) {
+            close(thread->member_fds[i]);
+        }
+        thread->member_count = 0;
+        close(fd);
+        return 0;
+    }
+
+    __sync_bool_compare_and_swap(&thread->group_fd, -1, fd);
+    ioctl(fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return 1;
+}
+
+static void profiler_detach_threads(Profiler* profiler) {
+    for (uint32_t i = 0; i < profiler->thread_count; i++) {
+        ProfilerThread* thread = &profiler->threads[i];
+        if (thread->group_fd < 0) {
+            continue;
+        }
+        int fd = thread->group_fd;
+        __sync_bool_compare_and_swap(&thread->group_fd, fd, -1);
+        for (uint32_t m = 0; m < thread->member_count; m++) {
+            close(thread->member_fds[m]);
+        }
+        thread->member_count = 0;
+        close(fd);
+    }
+}
+#endif
+
+#if PROFILER_HAS_PROC
+// Record every live thread (for names) and, with the perf backend, attach
+// the ones not sampled yet. Returns the number of threads attached.
+static uint32_t profiler_scan_threads(Profiler* profiler) {
+    DIR* dir = opendir("/proc/self/task");
+    if (!dir) {
+        return 0;
+    }
+    uint32_t attached = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        char* end = NULL;
+        unsigned long value = strtoul(entry->d_name, &end, 10);
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9' || *end != '\0') {
+            continue;
+        }
+        uint32_t tid = (uint32_t)value;
+        if (tid == __atomic_load_n(&profiler->monitor_tid, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+
+        ProfilerThread* thread = NULL;
+        for (uint32_t i = 0; i < profiler->thread_count; i++) {
+            if (profiler->threads[i].tid == tid) {
+                thread = &profiler->threads[i];
+                break;
+            }
+        }
+        if (!thread) {
+            if (profiler->thread_count >= PROFILER_MAX_THREADS) {
+                continue;
+            }
+            thread = &profiler->threads[profiler->thread_count];
+            memset(thread, 0, sizeof(*thread));
+            thread->tid = tid;
+            thread->group_fd = -1;
+            profiler_read_thread_name(tid, thread->name, sizeof(thread->name));
+            __sync_fetch_and_add(&profiler->thread_count, 1);
+        }
+#if PROFILER_HAS_PERF
+        if (profiler->backend == PROFILER_BACKEND_PERF_EVENT && thread->group_fd < 0 &&
+            profiler_attach_thread(profiler, thread)) {
+            attached++;
+        }
+#endif
+    }
+    closedir(dir);
+    return attached;
+}
+
+static void* profiler_monitor_main(void* arg) {
+    Profiler* profiler = (Profiler*)arg;
+    __sync_lock_test_and_set(&profiler->monitor_tid, profiler_current_tid());
+    struct timespec interval = { 0, PROFILER_RESCAN_MS * 1000000L };
+    while (!__atomic_load_n(&profiler->monitor_stop, __ATOMIC_ACQUIRE)) {
+        nanosleep(&interval, NULL);
+        if (__atomic_load_n(&profiler->monitor_stop, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+        // Mappings first, so a new thread's stack is known before it is sampled
+        profiler_refresh_mappings(profiler);
+        profiler_scan_threads(profiler);
+    }
+    return NULL;
+}
+#endif
+
+// ============================================================================
+// SYMBOLIZATION
+// ============================================================================
+
+typedef struct {
+    uintptr_t* addresses;
+    char** names;
+    uint32_t mask;
+} ProfilerSymbolTable;
+
+typedef struct {
+    char* stack;
+    uint64_t weight;
+} ProfilerStackLine;
+
+// Collapsed format separates frames with ';' and the weight with ' '
+static void profiler_sanitize(char* text) {
+    for (; *text; text++) {
+        if (*text == ';' || *text == ' ' || *text == '\t' || *text == '\n') {
+            *text = '_';
+        }
+    }
+}
+
+static char* profiler_symbolize(uintptr_t address) {
+    char buffer[512];
+    Dl_info info;
+    if (dladdr((void*)address, &info) && info.dli_sname) {
+        snprintf(buffer, sizeof(buffer), "%s", info.dli_sname);
+    } else if (dladdr((void*)address, &info) && info.dli_fname) {
+        const char* module = strrchr(info.dli_fname, '/');
+        module = module ? module + 1 : info.dli_fname;
+        snprintf(buffer, sizeof(buffer), "%s+0x%lx", module,
+                 (unsigned long)(address - (uintptr_t)info.dli_fbase));
+    } else {
+        snprintf(buffer, sizeof(buffer), "0x%lx", (unsigned long)address);
+    }
+    profiler_sanitize(buffer);
+    return strdup(buffer);
+}
+
+static const char* profiler_lookup_symbol(ProfilerSymbolTable* table, uintptr_t address) {
+    uint32_t slot = (uint32_t)((address * 0x9E3779B97F4A7C15ull) >> 32) & table->mask;
+    while (table->names[slot] && table->addresses[slot] != address) {
+        slot = (slot + 1) & table->mask;
+    }
+    if (!table->names[slot]) {
+        table->addresses[slot] = address;
+        table->names[slot] = profiler_symbolize(address);
+    }
+    return table->names[slot] ? table->names[slot] : "?";
+}
+
+static const char* profiler_thread_name(Profiler* profiler, uint32_t tid, char* fallback, size_t size) {
+    for (uint32_t i = 0; i < profiler->thread_count; i++) {
+        if (profiler->threads[i].tid == tid && profiler->threads[i].name[0]) {
+            return profiler->threads[i].name;
+        }
+    }
+    snprintf(fallback, size, "thread-%u", tid);
+    return fallback;
+}
+
+static int profiler_compare_lines(const void* a, const void* b) {
+    return strcmp(((const ProfilerStackLine*)a)->stack, ((const ProfilerStackLine*)b)->stack);
+}
+
+// ============================================================================
+// PUBLIC API IMPLEMENTATION
+// ============================================================================
+
+ProfilerDesc profiler_desc_default(void) {
+    ProfilerDesc desc;
+    desc.sample_hz = PROFILER_DEFAULT_HZ;
+    desc.max_samples = PROFILER_DEFAULT_MAX_SAMPLES;
+    desc.counters = 0;
+    desc.force_sigprof = 0;
+    return desc;
+}
+
+ProfilerHandle profiler_create(const ProfilerDesc* desc) {
+    if (!desc) {
+        fprintf(stderr, "Error: Profiler desc is NULL\n");
+        return NULL;
+    }
+    if (desc->sample_hz == 0 || desc->sample_hz > PROFILER_MAX_HZ) {
+        fprintf(stderr, "Error: Profiler sample rate %u Hz is out of range (1-%d)\n", desc->sample_hz, PROFILER_MAX_HZ);
+        return NULL;
+    }
+    if (desc->max_samples == 0 || desc->max_samples > UINT32_MAX / PROFILER_AVERAGE_DEPTH) {
+        fprintf(stderr, "Error: Invalid profiler sample capacity %u\n", desc->max_samples);
+        return NULL;
+    }
+
+    Profiler* profiler = (Profiler*)calloc(1, sizeof(Profiler));
+    if (!profiler) {
+        fprintf(stderr, "Error: Failed to allocate memory for profiler\n");
+        return NULL;
+    }
+    profiler->desc = *desc;
+    profiler->desc.counters &= PROFILER_COUNTER_ALL;
+    profiler->frame_capacity = desc->max_samples * PROFILER_AVERAGE_DEPTH;
+    profiler->samples = (ProfilerSample*)calloc(desc->max_samples, sizeof(ProfilerSample));
+    profiler->frames = (uintptr_t*)malloc((size_t)profiler->frame_capacity * sizeof(uintptr_t));
+#if PROFILER_HAS_PROC
+    profiler->mappings[0] = (ProfilerMapping*)malloc(PROFILER_MAX_MAPPINGS * sizeof(ProfilerMapping));
+    profiler->mappings[1] = (ProfilerMapping*)malloc(PROFILER_MAX_MAPPINGS * sizeof(ProfilerMapping));
+    int mappings_ok = profiler->mappings[0] && profiler->mappings[1];
+#else
+    int mappings_ok = 1;
+#endif
+    if (!profiler->samples || !profiler->frames || !mappings_ok) {
+        fprintf(stderr, "Error: Failed to allocate profiler sample buffers\n");
+        profiler_destroy(profiler);
+        return NULL;
+    }
+    profiler->backend = desc->force_sigprof || !PROFILER_HAS_PERF ? PROFILER_BACKEND_SIGPROF : PROFILER_BACKEND_PERF_EVENT;
+    return profiler;
+}
+
+void profiler_destroy(ProfilerHandle profiler) {
+    if (!profiler) {
+        return;
+    }
+    profiler_stop(profiler);
+    free(profiler->samples);
+    free(profiler->frames);
+    free(profiler->mappings[0]);
+    free(profiler->mappings[1]);
+    free(profiler);
+}
+
+int profiler_start(ProfilerHandle profiler) {
+    if (!profiler) {
+        return 0;
+    }
+    if (profiler->running) {
+        return 1;
+    }
+    if (!__sync_bool_compare_and_swap(&g_profiler_owner, NULL, profiler)) {
+        fprintf(stderr, "Error: Another profiler is already running\n");
+        return 0;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = profiler_signal_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &profiler->previous_action) != 0) {
+        fprintf(stderr, "Error: Failed to install the SIGPROF handler\n");
+        g_profiler_owner = NULL;
+        return 0;
+    }
+
+#if PROFILER_HAS_PROC
+    profiler->mapping_index = 0;
+    profiler->mapping_counts[0] = profiler_load_mappings(profiler->mappings[0], PROFILER_MAX_MAPPINGS);
+#endif
+    profiler->backend = profiler->desc.force_sigprof || !PROFILER_HAS_PERF ? PROFILER_BACKEND_SIGPROF : PROFILER_BACKEND_PERF_EVENT;
+    profiler->counters = profiler->desc.counters;
+    profiler->monitor_tid = 0;
+    profiler->running = 1;
+    __sync_bool_compare_and_swap(&g_active_profiler, NULL, profiler);
+
+#if PROFILER_HAS_PROC
+    uint32_t attached = profiler_scan_threads(profiler);
+    if (profiler->backend == PROFILER_BACKEND_PERF_EVENT && attached == 0) {
+        fprintf(stderr, "Warning: perf_event_open unavailable (%s), sampling with SIGPROF\n", strerror(errno));
+        profiler->backend = PROFILER_BACKEND_SIGPROF;
+    }
+#endif
+    if (profiler->backend == PROFILER_BACKEND_SIGPROF) {
+        // A process-wide CPU timer has no per-thread hardware counters
+        profiler->counters = 0;
+        struct itimerval timer;
+        timer.it_interval.tv_sec = 0;
+        timer.it_interval.tv_usec = 1000000 / profiler->desc.sample_hz;
+        if (timer.it_interval.tv_usec == 0) {
+            timer.it_interval.tv_usec = 1;
+        }
+        timer.it_value = timer.it_interval;
+        setitimer(ITIMER_PROF, &timer, NULL);
+    }
+
+#if PROFILER_HAS_PROC
+    // The monitor picks up threads started later; it never samples itself
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGPROF);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+    profiler->monitor_stop = 0;
+    profiler->monitor_started = pthread_create(&profiler->monitor, NULL, profiler_monitor_main, profiler) == 0;
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    if (!profiler->monitor_started) {
+        fprintf(stderr, "Warning: Failed to start profiler monitor, new threads won't be sampled\n");
+    }
+#endif
+    return 1;
+}
+
+void profiler_stop(ProfilerHandle profiler) {
+    if (!profiler || !profiler->running) {
+        return;
+    }
+    if (profiler->monitor_started) {
+        __sync_lock_test_and_set(&profiler->monitor_stop, 1);
+        pthread_join(profiler->monitor, NULL);
+        profiler->monitor_started = 0;
+    }
+
+    if (profiler->backend == PROFILER_BACKEND_SIGPROF) {
+        struct itimerval timer;
+        memset(&timer, 0, sizeof(timer));
+        setitimer(ITIMER_PROF, &timer, NULL);
+    }
+#if PROFILER_HAS_PERF
+    for (uint32_t i = 0; i < profiler->thread_count; i++) {
+        if (profiler->threads[i].group_fd >= 0) {
+            ioctl(profiler->threads[i].group_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+#endif
+
+    // Wait out handlers already running before their descriptors close
+    __sync_bool_compare_and_swap(&g_active_profiler, profiler, NULL);
+    while (__atomic_load_n(&g_handlers_inside, __ATOMIC_ACQUIRE) != 0) {
+        sched_yield();
+    }
+#if PROFILER_HAS_PERF
+    profiler_detach_threads(profiler);
+#endif
+
+    // A SIGPROF still queued would kill the process under the default action
+    if (profiler->previous_action.sa_handler == SIG_DFL && !(profiler->previous_action.sa_flags & SA_SIGINFO)) {
+        struct sigaction ignore;
+        memset(&ignore, 0, sizeof(ignore));
+        ignore.sa_handler = SIG_IGN;
+        sigemptyset(&ignore.sa_mask);
+        sigaction(SIGPROF, &ignore, NULL);
+    } else {
+        sigaction(SIGPROF, &profiler->previous_action, NULL);
+    }
+
+    profiler->running = 0;
+    __sync_synchronize();
+    g_profiler_owner = NULL;
+}
+
+int profiler_is_running(ProfilerHandle profiler) {
+    return profiler ? profiler->running : 0;
+}
+
+void profiler_reset(ProfilerHandle profiler) {
+    if (!profiler || profiler->running) {
+        return;
+    }
+    profiler->sample_cursor = 0;
+    profiler->frame_cursor = 0;
+    profiler->recorded = 0;
+    profiler->dropped = 0;
+}
+
+int profiler_write_collapsed(ProfilerHandle profiler, const char* path, ProfilerWeight weight) {
+    if (!profiler || !path) {
+        return 0;
+    }
+    if (profiler->running) {
+        fprintf(stderr, "Error: Stop the profiler before writing samples\n");
+        return 0;
+    }
+    if (weight > PROFILER_WEIGHT_LLC_MISSES) {
+        fprintf(stderr, "Error: Invalid profiler weight %d\n", (int)weight);
+        return 0;
+    }
+    uint32_t counter = weight == PROFILER_WEIGHT_SAMPLES ? 0 : (uint32_t)weight - 1;
+    if (weight != PROFILER_WEIGHT_SAMPLES && !(profiler->counters & PROFILER_COUNTER_BIT(counter))) {
+        fprintf(stderr, "Error: Counter %s was not collected\n", PROFILER_COUNTER_NAMES[counter]);
+        return 0;
+    }
+
+    uint32_t sample_count = profiler->sample_cursor < profiler->desc.max_samples ?
+                            profiler->sample_cursor : profiler->desc.max_samples;
+    uint32_t frame_count = profiler->frame_cursor < profiler->frame_capacity ?
+                           profiler->frame_cursor : profiler->frame_capacity;
+
+    ProfilerSymbolTable table;
+    uint32_t capacity = 64;
+    while (capacity < frame_count * 2) {
+        capacity *= 2;
+    }
+    table.mask = capacity - 1;
+    table.addresses = (uintptr_t*)calloc(capacity, sizeof(uintptr_t));
+    table.names = (char**)calloc(capacity, sizeof(char*));
+    ProfilerStackLine* lines = (ProfilerStackLine*)calloc(sample_count + 1, sizeof(ProfilerStackLine));
+    FILE* file = fopen(path, "w");
+    int ok = table.addresses && table.names && lines && file;
+    if (!file) {
+        fprintf(stderr, "Error: Failed to open profile output: %s\n", path);
+    } else if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for profile symbolization\n");
+    }
+
+    uint32_t line_count = 0;
+    for (uint32_t s = 0; ok && s < sample_count; s++) {
+        const ProfilerSample* sample = &profiler->samples[s];
+        uint64_t sample_weight = weight == PROFILER_WEIGHT_SAMPLES ? 1 : sample->counters[counter];
+        if (sample->depth == 0 || sample_weight == 0) {
+            continue;
+        }
+
+        // Root first: thread, outermost caller ... sampled pc. Return
+        // addresses point past the call, so look up the byte before them.
+        char fallback[32];
+        const char* names[PROFILER_MAX_DEPTH + 1];
+        size_t length = 0;
+        names[0] = profiler_thread_name(profiler, sample->tid, fallback, sizeof(fallback));
+        length += strlen(names[0]) + 1;
+        for (uint32_t f = 0; f < sample->depth; f++) {
+            uintptr_t address = profiler->frames[sample->first_frame + sample->depth - 1 - f];
+            if (f + 1 < sample->depth) {
+                address -= 1;
+            }
+            names[1 + f] = profiler_lookup_symbol(&table, address);
+            length += strlen(names[1 + f]) + 1;
+        }
+
+        char* stack = (char*)malloc(length);
+        if (!stack) {
+            ok = 0;
+            break;
+        }
+        char* cursor = stack;
+        for (uint32_t n = 0; n <= sample->depth; n++) {
+            size_t name_length = strlen(names[n]);
+            memcpy(cursor, names[n], name_length);
+            cursor += name_length;
+            *cursor++ = n < sample->depth ? ';' : '\0';
+        }
+        lines[line_count].stack = stack;
+        lines[line_count].weight = sample_weight;
+        line_count++;
+    }
+
+    if (ok) {
+        qsort(lines, line_count, sizeof(ProfilerStackLine), profiler_compare_lines);
+        for (uint32_t i = 0; i < line_count;) {
+            uint64_t total = 0;
+            uint32_t j = i;
+            while (j < line_count && strcmp(lines[j].stack, lines[i].stack) == 0) {
+                total += lines[j].weight;
+                j++;
+            }
+            fprintf(file, "%s %llu\n", lines[i].stack, (unsigned long long)total);
+            i = j;
+        }
+    }
+
+    if (file && fclose(file) != 0) {
+        ok = 0;
+    }
+    for (uint32_t i = 0; lines && i < line_count; i++) {
+        free(lines[i].stack);
+    }
+    for (uint32_t i = 0; table.names && i < capacity; i++) {
+        free(table.names[i]);
+    }
+    free(lines);
+    free(table.names);
+    free(table.addresses);
+    return ok;
+}
+
+void profiler_get_stats(ProfilerHandle profiler, ProfilerStats* stats) {
+    if (!profiler || !stats) {
+        return;
+    }
+    stats->backend = profiler->backend;
+    stats->running = (uint32_t)profiler->running;
+    stats->threads = profiler->thread_count;
+    stats->samples = profiler->recorded;
+    stats->dropped = profiler->dropped;
+    stats->counters = profiler->counters;
+}
+
+ProfilerHandle profiler_begin_from_env(void) {
+    const char* path = getenv("ENGINE_PROFILE");
+    if (!path || !path[0]) {
+        return NULL;
+    }
+    ProfilerDesc desc = profiler_desc_default();
+    const char* hz = getenv("ENGINE_PROFILE_HZ");
+    if (hz && hz[0]) {
+        desc.sample_hz = (uint32_t)strtoul(hz, NULL, 10);
+    }
+    const char* counters = getenv("ENGINE_PROFILE_COUNTERS");
+    for (uint32_t c = 0; counters && c < PROFILER_COUNTER_COUNT; c++) {
+        size_t length = strlen(PROFILER_COUNTER_NAMES[c]);
+        for (const char* item = counters; *item; ) {
+            size_t item_length = strcspn(item, ",");
+            if (item_length == length && strncmp(item, PROFILER_COUNTER_NAMES[c], length) == 0) {
+                desc.counters |= PROFILER_COUNTER_BIT(c);
+            }
+            item += item_length;
+            if (*item == ',') {
+                item++;
+            }
+        }
+    }
+
+    ProfilerHandle profiler = profiler_create(&desc);
+    if (!profiler) {
+        return NULL;
+    }
+    snprintf(profiler->output_path, sizeof(profiler->output_path), "%s", path);
+    if (!profiler_start(profiler)) {
+        profiler_destroy(profiler);
+        return NULL;
+    }
+    return profiler;
+}
+
+void profiler_end_from_env(ProfilerHandle profiler) {
+    if (!profiler) {
+        return;
+    }
+    profiler_stop(profiler);
+    profiler_print("Profiler", profiler);
+    if (profiler->output_path[0]) {
+        profiler_write_collapsed(profiler, profiler->output_path, PROFILER_WEIGHT_SAMPLES);
+        for (uint32_t c = 0; c < PROFILER_COUNTER_COUNT; c++) {
+            if (profiler->counters & PROFILER_COUNTER_BIT(c)) {
+                char path[PROFILER_PATH_MAX + 16];
+                snprintf(path, sizeof(path), "%s.%s", profiler->output_path, PROFILER_COUNTER_NAMES[c]);
+                profiler_write_collapsed(profiler, path, (ProfilerWeight)(PROFILER_WEIGHT_CYCLES + c));
+            }
+        }
+    }
+    profiler_destroy(profiler);
+}
+
+void profiler_print(const char* name, ProfilerHandle profiler) {
+    if (!profiler) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+    ProfilerStats stats;
+    profiler_get_stats(profiler, &stats);
+    printf("%s: %s at %u Hz, %s\n", name,
+           stats.backend == PROFILER_BACKEND_PERF_EVENT ? "perf_event" : "SIGPROF",
+           profiler->desc.sample_hz, stats.running ? "running" : "stopped");
+    printf("  %u samples, %u dropped, %u threads", stats.samples, stats.dropped, stats.threads);
+    for (uint32_t c = 0; c < PROFILER_COUNTER_COUNT; c++) {
+        if (stats.counters & PROFILER_COUNTER_BIT(c)) {
+            printf(", %s", PROFILER_COUNTER_NAMES[c]);
+        }
+    }
+    printf("\n");
+}
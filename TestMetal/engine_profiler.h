@@ -0,0 +1,123 @@
+#ifndef ENGINE_PROFILER_H
+#define ENGINE_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// ============================================================================
+// PROFILER CONFIGURATION
+// ============================================================================
+
+#define PROFILER_MAX_DEPTH 64                   // Frames kept per sample
+#define PROFILER_MAX_THREADS 256                // Threads sampled by the perf backend
+#define PROFILER_MAX_HZ 20000
+#define PROFILER_PATH_MAX 1024
+
+#define PROFILER_DEFAULT_HZ 997                 // Prime, so periodic work doesn't alias
+#define PROFILER_DEFAULT_MAX_SAMPLES 32768
+#define PROFILER_AVERAGE_DEPTH 24               // Frame pool per sample, on average
+#define PROFILER_RESCAN_MS 50                   // New-thread scan period
+
+// ============================================================================
+// PROFILER TYPES
+// ============================================================================
+
+typedef enum {
+    PROFILER_BACKEND_PERF_EVENT = 0,            // Per-thread task-clock events (Linux)
+    PROFILER_BACKEND_SIGPROF                    // Process CPU timer (setitimer)
+} ProfilerBackend;
+
+typedef enum {
+    PROFILER_COUNTER_CYCLES = 0,
+    PROFILER_COUNTER_INSTRUCTIONS,
+    PROFILER_COUNTER_LLC_MISSES,
+    PROFILER_COUNTER_COUNT
+} ProfilerCounter;
+
+#define PROFILER_COUNTER_BIT(counter) (1u << (counter))
+#define PROFILER_COUNTER_ALL ((1u << PROFILER_COUNTER_COUNT) - 1)
+
+// What each collapsed stack is weighted by: one per sample, or the counter
+// delta since the thread's previous sample
+typedef enum {
+    PROFILER_WEIGHT_SAMPLES = 0,
+    PROFILER_WEIGHT_CYCLES,
+    PROFILER_WEIGHT_INSTRUCTIONS,
+    PROFILER_WEIGHT_LLC_MISSES
+} ProfilerWeight;
+
+typedef struct {
+    uint32_t sample_hz;             // Samples per second of thread CPU time
+    uint32_t max_samples;           // Preallocated; further samples are dropped
+    uint32_t counters;              // PROFILER_COUNTER_BIT mask (perf backend only)
+    int force_sigprof;              // Skip perf_event_open even where it works
+} ProfilerDesc;
+
+typedef struct {
+    uint32_t backend;               // ProfilerBackend chosen by the last start
+    uint32_t running;
+    uint32_t threads;               // Threads seen by the perf backend / thread scan
+    uint32_t samples;
+    uint32_t dropped;               // Buffer full or no usable stack
+    uint32_t counters;              // Counters actually being collected
+} ProfilerStats;
+
+// Opaque profiler handle
+typedef struct Profiler* ProfilerHandle;
+
+// ============================================================================
+// PROFILER FUNCTIONS
+// ============================================================================
+
+// Defaults: PROFILER_DEFAULT_HZ, PROFILER_DEFAULT_MAX_SAMPLES, no counters
+ProfilerDesc profiler_desc_default(void);
+
+// Allocate the sample buffers. Nothing is sampled until profiler_start.
+ProfilerHandle profiler_create(const ProfilerDesc* desc);
+void profiler_destroy(ProfilerHandle profiler);
+
+// Start sampling every thread in the process, including threads created
+// later. Uses perf_event_open when available and falls back to SIGPROF.
+// Only one profiler runs at a time; SIGPROF is taken over while it does.
+// Stacks are walked through frame pointers, so build with
+// -fno-omit-frame-pointer for anything deeper than the sampled function
+// (leaf functions that need no stack frame still hide their caller).
+// Returns 0 on failure.
+int profiler_start(ProfilerHandle profiler);
+
+// Stop sampling. Samples accumulate across start/stop pairs until reset.
+void profiler_stop(ProfilerHandle profiler);
+
+int profiler_is_running(ProfilerHandle profiler);
+
+// Drop collected samples (not while running)
+void profiler_reset(ProfilerHandle profiler);
+
+// Symbolize the samples and write them in collapsed-stack format
+// ("thread;outer;...;inner weight" per line), ready for flamegraph.pl.
+// Frames without a symbol are written as module+0xoffset for addr2line.
+// Fails while running or when weight names a counter that wasn't collected.
+int profiler_write_collapsed(ProfilerHandle profiler, const char* path, ProfilerWeight weight);
+
+void profiler_get_stats(ProfilerHandle profiler, ProfilerStats* stats);
+
+// Runner hook: start a profiler when ENGINE_PROFILE names an output file.
+// ENGINE_PROFILE_HZ sets the rate and ENGINE_PROFILE_COUNTERS takes a comma
+// list of cycles, instructions and llc_misses. Returns NULL when off.
+ProfilerHandle profiler_begin_from_env(void);
+
+// Stop, write ENGINE_PROFILE plus ENGINE_PROFILE.<counter> for each counter
+// collected, and destroy. NULL is a no-op.
+void profiler_end_from_env(ProfilerHandle profiler);
+
+// Print profiler state
+void profiler_print(const char* name, ProfilerHandle profiler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_PROFILER_H
@@ -0,0 +1,388 @@
+// pthread_setname_np is a GNU extension
+#define _GNU_SOURCE
+#include "engine_profiler.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static const char* OUTPUT = "/tmp/engine_profiler_test.folded";
+
+static double thread_cpu_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// Non-static and out of line so they keep their own symbols (the Makefile
+// links with -rdynamic for dladdr). The leaf keeps a stack slot because GCC
+// gives stackless leaves no frame, which would hide the caller.
+volatile double profiler_test_sink = 0.0;
+
+__attribute__((noinline)) double profiler_test_hot_leaf(uint32_t iterations) {
+    volatile double sum = 0.0;
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += (double)(i ^ (i >> 3)) * 0.5;
+    }
+    return sum;
+}
+
+__attribute__((noinline)) void profiler_test_hot_caller(double cpu_ms) {
+    double end = thread_cpu_ms() + cpu_ms;
+    while (thread_cpu_ms() < end) {
+        profiler_test_sink += profiler_test_hot_leaf(20000);
+    }
+}
+
+__attribute__((noinline)) void* profiler_test_thread_spin(void* arg) {
+#ifdef __linux__
+    pthread_setname_np(pthread_self(), "prof-worker");
+#endif
+    double end = thread_cpu_ms() + *(const double*)arg;
+    while (thread_cpu_ms() < end) {
+        profiler_test_sink += profiler_test_hot_leaf(20000);
+    }
+    return NULL;
+}
+
+// Whole collapsed file, NUL terminated
+static char* read_output(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* text = (char*)malloc((size_t)size + 1);
+    if (text && fread(text, 1, (size_t)size, f) != (size_t)size) {
+        free(text);
+        text = NULL;
+    }
+    if (text) {
+        text[size] = '\0';
+    }
+    fclose(f);
+    return text;
+}
+
+// Every line is "frame;frame;... weight"; returns the summed weights, or -1
+// when a line is malformed
+static long long collapsed_total(const char* text) {
+    long long total = 0;
+    while (*text) {
+        const char* end = strchr(text, '\n');
+        if (!end) {
+            return -1;
+        }
+        const char* space = end;
+        while (space > text && space[-1] != ' ') {
+            space--;
+        }
+        if (space == text || space == end) {
+            return -1;
+        }
+        for (const char* c = text; c < space - 1; c++) {
+            if (*c == ' ') {
+                return -1;
+            }
+        }
+        total += strtoll(space, NULL, 10);
+        text = end + 1;
+    }
+    return total;
+}
+
+// ============================================================================
+// CREATION TESTS
+// ============================================================================
+
+static void test_creation(void) {
+    printf("\n--- Profiler Creation Tests ---\n");
+
+    ProfilerDesc desc = profiler_desc_default();
+    TEST_ASSERT_EQUAL(PROFILER_DEFAULT_HZ, desc.sample_hz, "Default rate");
+    TEST_ASSERT_EQUAL(PROFILER_DEFAULT_MAX_SAMPLES, desc.max_samples, "Default capacity");
+    TEST_ASSERT_EQUAL(0u, desc.counters, "No counters by default");
+
+    TEST_ASSERT(profiler_create(NULL) == NULL, "NULL desc rejected");
+    desc.sample_hz = 0;
+    TEST_ASSERT(profiler_create(&desc) == NULL, "Zero rate rejected");
+    desc.sample_hz = PROFILER_MAX_HZ + 1;
+    TEST_ASSERT(profiler_create(&desc) == NULL, "Excessive rate rejected");
+    desc = profiler_desc_default();
+    desc.max_samples = 0;
+    TEST_ASSERT(profiler_create(&desc) == NULL, "Zero capacity rejected");
+
+    desc = profiler_desc_default();
+    ProfilerHandle profiler = profiler_create(&desc);
+    TEST_ASSERT_NOT_NULL(profiler, "Profiler created");
+    TEST_ASSERT(!profiler_is_running(profiler), "Not running until started");
+
+    ProfilerStats stats;
+    profiler_get_stats(profiler, &stats);
+    TEST_ASSERT_EQUAL(0u, stats.samples, "No samples yet");
+
+    TEST_ASSERT(profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_SAMPLES), "Empty profile written");
+    char* text = read_output(OUTPUT);
+    TEST_ASSERT(text && text[0] == '\0', "Empty profile has no stacks");
+    free(text);
+    TEST_ASSERT(!profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_CYCLES),
+                "Counter weight rejected when not collected");
+
+    profiler_print("Idle profiler", profiler);
+    profiler_destroy(profiler);
+    profiler_destroy(NULL);
+    TEST_ASSERT(!profiler_start(NULL), "NULL profiler does not start");
+}
+
+// ============================================================================
+// SAMPLING TESTS
+// ============================================================================
+
+static void test_sampling(const char* label, int force_sigprof) {
+    printf("\n--- %s Sampling Tests ---\n", label);
+
+    ProfilerDesc desc = profiler_desc_default();
+    desc.force_sigprof = force_sigprof;
+    ProfilerHandle profiler = profiler_create(&desc);
+    ProfilerHandle other = profiler_create(&desc);
+    TEST_ASSERT(profiler && other, "Profilers created");
+    if (!profiler || !other) {
+        profiler_destroy(profiler);
+        profiler_destroy(other);
+        return;
+    }
+
+    TEST_ASSERT(profiler_start(profiler), "Profiler started");
+    TEST_ASSERT(profiler_is_running(profiler), "Profiler running");
+    TEST_ASSERT(profiler_start(profiler), "Starting again is a no-op");
+    TEST_ASSERT(!profiler_start(other), "Only one profiler runs at a time");
+    TEST_ASSERT(!profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_SAMPLES), "No writing while running");
+
+    profiler_test_hot_caller(200.0);
+    profiler_stop(profiler);
+    TEST_ASSERT(!profiler_is_running(profiler), "Profiler stopped");
+
+    ProfilerStats stats;
+    profiler_get_stats(profiler, &stats);
+    profiler_print(label, profiler);
+    if (force_sigprof) {
+        TEST_ASSERT_EQUAL((uint32_t)PROFILER_BACKEND_SIGPROF, stats.backend, "SIGPROF backend forced");
+    }
+    // 200 ms at ~1 kHz, but setitimer is limited to the kernel tick (often
+    // 250 Hz), so leave plenty of slack
+    TEST_ASSERT(stats.samples >= 20, "Hot loop sampled");
+
+    // The stopped profiler releases SIGPROF for the next one
+    TEST_ASSERT(profiler_start(other), "Second profiler starts after the first stops");
+    profiler_stop(other);
+
+    TEST_ASSERT(profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_SAMPLES), "Collapsed stacks written");
+    char* text = read_output(OUTPUT);
+    TEST_ASSERT_NOT_NULL(text, "Collapsed output readable");
+    if (text) {
+        TEST_ASSERT_EQUAL((long long)stats.samples, collapsed_total(text), "Weights add up to the sample count");
+        TEST_ASSERT(strstr(text, "profiler_test_hot_caller;profiler_test_hot_leaf ") != NULL,
+                    "Leaf attributed under its caller");
+        TEST_ASSERT(strstr(text, "main;") != NULL, "Stacks reach main");
+        free(text);
+    }
+
+    profiler_destroy(profiler);
+    profiler_destroy(other);
+}
+
+static void test_late_threads(const char* label, int force_sigprof) {
+    printf("\n--- %s Thread Tests ---\n", label);
+
+    ProfilerDesc desc = profiler_desc_default();
+    desc.force_sigprof = force_sigprof;
+    ProfilerHandle profiler = profiler_create(&desc);
+    TEST_ASSERT(profiler && profiler_start(profiler), "Profiler started before the worker exists");
+    if (!profiler) {
+        return;
+    }
+
+    double cpu_ms = 200.0;
+    pthread_t worker;
+    int started = pthread_create(&worker, NULL, profiler_test_thread_spin, &cpu_ms) == 0;
+    TEST_ASSERT(started, "Worker started");
+    if (started) {
+        pthread_join(worker, NULL);
+    }
+    profiler_stop(profiler);
+
+    ProfilerStats stats;
+    profiler_get_stats(profiler, &stats);
+    TEST_ASSERT(stats.threads >= 2, "Worker thread discovered");
+
+    TEST_ASSERT(profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_SAMPLES), "Collapsed stacks written");
+    char* text = read_output(OUTPUT);
+    TEST_ASSERT(text && strstr(text, "profiler_test_thread_spin;profiler_test_hot_leaf ") != NULL,
+                "Worker started after profiler_start is sampled");
+#ifdef __linux__
+    TEST_ASSERT(text && strstr(text, "prof-worker;") != NULL, "Stacks are rooted at the thread name");
+#endif
+    free(text);
+    profiler_destroy(profiler);
+}
+
+static void test_toggle_and_capacity(void) {
+    printf("\n--- Profiler Toggle Tests ---\n");
+
+    ProfilerDesc desc = profiler_desc_default();
+    ProfilerHandle profiler = profiler_create(&desc);
+    TEST_ASSERT_NOT_NULL(profiler, "Profiler created");
+    if (!profiler) {
+        return;
+    }
+
+    ProfilerStats first, second;
+    profiler_start(profiler);
+    profiler_test_hot_caller(100.0);
+    profiler_stop(profiler);
+    profiler_get_stats(profiler, &first);
+
+    // Time spent stopped is not sampled
+    profiler_test_hot_caller(100.0);
+    profiler_get_stats(profiler, &second);
+    TEST_ASSERT_EQUAL(first.samples, second.samples, "Nothing sampled while stopped");
+
+    profiler_start(profiler);
+    profiler_test_hot_caller(100.0);
+    profiler_stop(profiler);
+    profiler_get_stats(profiler, &second);
+    TEST_ASSERT(second.samples > first.samples, "Samples accumulate across start/stop");
+
+    profiler_reset(profiler);
+    profiler_get_stats(profiler, &second);
+    TEST_ASSERT_EQUAL(0u, second.samples, "Reset drops samples");
+    profiler_destroy(profiler);
+
+    desc.max_samples = 8;
+    profiler = profiler_create(&desc);
+    TEST_ASSERT_NOT_NULL(profiler, "Small profiler created");
+    if (!profiler) {
+        return;
+    }
+    profiler_start(profiler);
+    profiler_test_hot_caller(100.0);
+    profiler_stop(profiler);
+    profiler_get_stats(profiler, &second);
+    TEST_ASSERT_EQUAL(8u, second.samples, "Samples capped at capacity");
+    TEST_ASSERT(second.dropped > 0, "Overflow counted as dropped");
+    profiler_destroy(profiler);
+}
+
+static void test_counters(void) {
+    printf("\n--- Profiler Counter Tests ---\n");
+
+    ProfilerDesc desc = profiler_desc_default();
+    desc.counters = PROFILER_COUNTER_ALL;
+    ProfilerHandle profiler = profiler_create(&desc);
+    TEST_ASSERT(profiler && profiler_start(profiler), "Profiler with counters started");
+    if (!profiler) {
+        return;
+    }
+    profiler_test_hot_caller(200.0);
+    profiler_stop(profiler);
+
+    ProfilerStats stats;
+    profiler_get_stats(profiler, &stats);
+    profiler_print("Counters", profiler);
+    TEST_ASSERT((stats.counters & ~PROFILER_COUNTER_ALL) == 0, "Collected counters are a subset of the request");
+    TEST_ASSERT(stats.samples >= 20, "Sampling continues whatever counters are available");
+
+    if (stats.counters & PROFILER_COUNTER_BIT(PROFILER_COUNTER_CYCLES)) {
+        TEST_ASSERT(profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_CYCLES), "Cycle-weighted stacks written");
+        char* text = read_output(OUTPUT);
+        TEST_ASSERT(text && collapsed_total(text) > 0, "Cycle weights recorded");
+        free(text);
+    } else {
+        printf("  (no hardware cycle counter on this machine)\n");
+        TEST_ASSERT(!profiler_write_collapsed(profiler, OUTPUT, PROFILER_WEIGHT_CYCLES),
+                    "Cycle weight rejected without the counter");
+    }
+    profiler_destroy(profiler);
+}
+
+static void test_env_hook(void) {
+    printf("\n--- Profiler Runner Hook Tests ---\n");
+
+    unsetenv("ENGINE_PROFILE");
+    TEST_ASSERT(profiler_begin_from_env() == NULL, "Profiling off without ENGINE_PROFILE");
+    profiler_end_from_env(NULL);
+
+    remove(OUTPUT);
+    setenv("ENGINE_PROFILE", OUTPUT, 1);
+    setenv("ENGINE_PROFILE_HZ", "499", 1);
+    setenv("ENGINE_PROFILE_COUNTERS", "cycles,llc_misses", 1);
+    ProfilerHandle profiler = profiler_begin_from_env();
+    TEST_ASSERT_NOT_NULL(profiler, "ENGINE_PROFILE starts a profiler");
+    TEST_ASSERT(profiler_is_running(profiler), "Runner profiler is running");
+    profiler_test_hot_caller(100.0);
+    profiler_end_from_env(profiler);
+
+    char* text = read_output(OUTPUT);
+    TEST_ASSERT(text && strstr(text, "profiler_test_hot_leaf ") != NULL, "Runner profile written on end");
+    free(text);
+    unsetenv("ENGINE_PROFILE");
+    unsetenv("ENGINE_PROFILE_HZ");
+    unsetenv("ENGINE_PROFILE_COUNTERS");
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(void) {
+    printf("Starting Profiler Unit Tests\n");
+    printf("===================================\n");
+
+    test_creation();
+    test_sampling("perf_event", 0);
+    test_sampling("SIGPROF", 1);
+    test_late_threads("perf_event", 0);
+    test_late_threads("SIGPROF", 1);
+    test_toggle_and_capacity();
+    test_counters();
+    test_env_hook();
+
+    remove(OUTPUT);
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
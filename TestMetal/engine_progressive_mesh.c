@@ -0,0 +1,1083 @@
+#include "engine_progressive_mesh.h"
+#include "engine_halfedge.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#define PM_NONE 0xFFFFFFFFu
+#define PM_DROPPED 0xFFFFFFFEu                  // Degenerate input triangle
+#define PM_MIN_COS_SQUARED 0.0625f              // Collapses may turn a face by at most ~75 degrees
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+// A file is the model header, one mesh header plus base vertices and base
+// indices per mesh, then split records: PmFileSplit, the new triangles'
+// indices and the corner slots
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertex_size;       // sizeof(Vertex) of the writer
+    uint32_t mesh_count;
+    uint32_t split_count;       // Records across all meshes
+    uint32_t reserved;
+} PmFileHeader;
+
+typedef struct {
+    uint32_t base_vertex_count;
+    uint32_t base_triangle_count;
+    uint32_t split_count;
+    uint32_t triangle_count;
+    uint32_t corner_count;
+    uint32_t reserved;
+} PmFileMesh;
+
+typedef struct {
+    uint32_t mesh;
+    uint32_t parent;
+    uint32_t new_triangles;
+    uint32_t corner_count;
+    float error;
+    uint32_t reserved;
+    Vertex vertex;
+} PmFileSplit;
+
+// ============================================================================
+// QUADRICS
+// ============================================================================
+
+// Symmetric 4x4 error quadric: a2 ab ac ad b2 bc bd c2 cd d2
+typedef struct {
+    double q[10];
+} PmQuadric;
+
+static void quadric_add_plane(PmQuadric* quadric, double a, double b, double c, double d, double weight) {
+    double* q = quadric->q;
+    q[0] += weight * a * a; q[1] += weight * a * b; q[2] += weight * a * c; q[3] += weight * a * d;
+    q[4] += weight * b * b; q[5] += weight * b * c; q[6] += weight * b * d;
+    q[7] += weight * c * c; q[8] += weight * c * d;
+    q[9] += weight * d * d;
+}
+
+static double quadric_eval(const PmQuadric* a, const PmQuadric* b, vec3_t p) {
+    double q[10];
+    for (int i = 0; i < 10; i++) q[i] = a->q[i] + b->q[i];
+    double x = p.x, y = p.y, z = p.z;
+    double e = q[0] * x * x + 2.0 * q[1] * x * y + 2.0 * q[2] * x * z + 2.0 * q[3] * x +
+               q[4] * y * y + 2.0 * q[5] * y * z + 2.0 * q[6] * y +
+               q[7] * z * z + 2.0 * q[8] * z + q[9];
+    return e > 0.0 ? e : 0.0;
+}
+
+// ============================================================================
+// SIMPLIFIER
+// ============================================================================
+
+typedef struct {
+    uint32_t* items;
+    uint32_t count;
+    uint32_t capacity;
+} PmTriangleList;
+
+typedef struct {
+    float cost;
+    uint32_t vertex;
+    uint32_t target;
+    uint32_t version;
+} PmHeapEntry;
+
+typedef struct {
+    const Vertex* vertices;
+    uint32_t vertex_count;
+    uint32_t triangle_count;
+    uint32_t* tris;             // Current corners (collapsed vertices replaced)
+    uint32_t* removed_by;       // Collapse step that removed each triangle, PM_NONE or PM_DROPPED
+    PmTriangleList* lists;      // Incident triangles per vertex (may hold removed ones)
+    PmQuadric* quadrics;
+    uint8_t* locked;
+    uint8_t* collapsed;
+    uint32_t* version;
+    uint32_t* mark;             // Neighbour stamps
+    uint32_t stamp;
+    uint32_t* candidates;
+    uint32_t candidate_capacity;
+    PmHeapEntry* heap;
+    uint32_t heap_count;
+    uint32_t heap_capacity;
+    uint32_t* collapse_vertex;  // Per collapse step
+    uint32_t* collapse_parent;
+    float* collapse_error;
+    uint32_t collapse_count;
+    uint32_t alive_triangles;
+    int out_of_memory;
+} PmBuilder;
+
+static int list_push(PmBuilder* b, uint32_t vertex, uint32_t triangle) {
+    PmTriangleList* list = &b->lists[vertex];
+    if (list->count == list->capacity) {
+        // Drop removed triangles before growing
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < list->count; i++) {
+            if (b->removed_by[list->items[i]] == PM_NONE) list->items[kept++] = list->items[i];
+        }
+        list->count = kept;
+    }
+    if (list->count == list->capacity) {
+        uint32_t capacity = list->capacity ? list->capacity * 2 : 8;
+        uint32_t* items = (uint32_t*)realloc(list->items, capacity * sizeof(uint32_t));
+        if (!items) {
+            b->out_of_memory = 1;
+            return 0;
+        }
+        list->items = items;
+        list->capacity = capacity;
+    }
+    list->items[list->count++] = triangle;
+    return 1;
+}
+
+static void heap_push(PmBuilder* b, PmHeapEntry entry) {
+    if (b->heap_count == b->heap_capacity) {
+        uint32_t capacity = b->heap_capacity ? b->heap_capacity * 2 : 1024;
+        PmHeapEntry* heap = (PmHeapEntry*)realloc(b->heap, capacity * sizeof(PmHeapEntry));
+        if (!heap) {
+            b->out_of_memory = 1;
+            return;
+        }
+        b->heap = heap;
+        b->heap_capacity = capacity;
+    }
+    uint32_t i = b->heap_count++;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (b->heap[parent].cost <= entry.cost) break;
+        b->heap[i] = b->heap[parent];
+        i = parent;
+    }
+    b->heap[i] = entry;
+}
+
+static PmHeapEntry heap_pop(PmBuilder* b) {
+    PmHeapEntry top = b->heap[0];
+    PmHeapEntry last = b->heap[--b->heap_count];
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= b->heap_count) break;
+        if (child + 1 < b->heap_count && b->heap[child + 1].cost < b->heap[child].cost) child++;
+        if (last.cost <= b->heap[child].cost) break;
+        b->heap[i] = b->heap[child];
+        i = child;
+    }
+    if (b->heap_count > 0) b->heap[i] = last;
+    return top;
+}
+
+static uint32_t next_stamp(PmBuilder* b) {
+    if (++b->stamp == 0) {
+        memset(b->mark, 0, b->vertex_count * sizeof(uint32_t));
+        b->stamp = 1;
+    }
+    return b->stamp;
+}
+
+static vec3_t triangle_normal(vec3_t p0, vec3_t p1, vec3_t p2) {
+    return vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+}
+
+// Half-edge collapse u -> v keeps the surface manifold (link condition)
+// and turns no remaining face of u too far
+static int collapse_valid(PmBuilder* b, uint32_t u, uint32_t v) {
+    const PmTriangleList* list = &b->lists[u];
+    uint32_t shared = 0;
+    for (uint32_t i = 0; i < list->count; i++) {
+        uint32_t t = list->items[i];
+        if (b->removed_by[t] != PM_NONE) continue;
+        const uint32_t* tri = b->tris + 3 * t;
+        if (tri[0] == v || tri[1] == v || tri[2] == v) {
+            shared++;
+            continue;
+        }
+        vec3_t p[3], q[3];
+        for (int k = 0; k < 3; k++) {
+            p[k] = b->vertices[tri[k]].position;
+            q[k] = tri[k] == u ? b->vertices[v].position : p[k];
+        }
+        vec3_t n0 = triangle_normal(p[0], p[1], p[2]);
+        vec3_t n1 = triangle_normal(q[0], q[1], q[2]);
+        float d = vec3_dot(n0, n1);
+        if (d <= 0.0f || d * d < PM_MIN_COS_SQUARED * vec3_dot(n0, n0) * vec3_dot(n1, n1)) {
+            return 0;
+        }
+    }
+    if (shared == 0) {
+        return 0;
+    }
+
+    uint32_t in_u = next_stamp(b);
+    for (uint32_t i = 0; i < list->count; i++) {
+        uint32_t t = list->items[i];
+        if (b->removed_by[t] != PM_NONE) continue;
+        for (int k = 0; k < 3; k++) b->mark[b->tris[3 * t + k]] = in_u;
+    }
+    uint32_t counted = next_stamp(b);
+    uint32_t common = 0;
+    const PmTriangleList* v_list = &b->lists[v];
+    for (uint32_t i = 0; i < v_list->count; i++) {
+        uint32_t t = v_list->items[i];
+        if (b->removed_by[t] != PM_NONE) continue;
+        for (int k = 0; k < 3; k++) {
+            uint32_t w = b->tris[3 * t + k];
+            if (w != u && w != v && b->mark[w] == in_u) {
+                b->mark[w] = counted;
+                common++;
+            }
+        }
+    }
+    return common == shared;
+}
+
+// Queue the cheapest valid collapse of u, if any
+static void evaluate_vertex(PmBuilder* b, uint32_t u) {
+    b->version[u]++;
+    if (b->locked[u] || b->collapsed[u]) {
+        return;
+    }
+
+    const PmTriangleList* list = &b->lists[u];
+    uint32_t seen = next_stamp(b);
+    uint32_t candidate_count = 0;
+    b->mark[u] = seen;
+    for (uint32_t i = 0; i < list->count; i++) {
+        uint32_t t = list->items[i];
+        if (b->removed_by[t] != PM_NONE) continue;
+        for (int k = 0; k < 3; k++) {
+            uint32_t w = b->tris[3 * t + k];
+            if (b->mark[w] == seen) continue;
+            b->mark[w] = seen;
+            if (candidate_count == b->candidate_capacity) {
+                uint32_t capacity = b->candidate_capacity ? b->candidate_capacity * 2 : 64;
+                uint32_t* candidates = (uint32_t*)realloc(b->candidates, capacity * sizeof(uint32_t));
+                if (!candidates) {
+                    b->out_of_memory = 1;
+                    return;
+                }
+                b->candidates = candidates;
+                b->candidate_capacity = capacity;
+            }
+            b->candidates[candidate_count++] = w;
+        }
+    }
+
+    // Cheapest first; validity is only checked until one passes
+    float best_cost = FLT_MAX;
+    uint32_t best = PM_NONE;
+    while (candidate_count > 0) {
+        uint32_t pick = 0;
+        float pick_cost = FLT_MAX;
+        for (uint32_t i = 0; i < candidate_count; i++) {
+            uint32_t v = b->candidates[i];
+            float cost = (float)quadric_eval(&b->quadrics[u], &b->quadrics[v], b->vertices[v].position);
+            if (cost < pick_cost) {
+                pick_cost = cost;
+                pick = i;
+            }
+        }
+        uint32_t v = b->candidates[pick];
+        b->candidates[pick] = b->candidates[--candidate_count];
+        if (collapse_valid(b, u, v)) {
+            best = v;
+            best_cost = pick_cost;
+            break;
+        }
+    }
+
+    if (best != PM_NONE) {
+        PmHeapEntry entry = { best_cost, u, best, b->version[u] };
+        heap_push(b, entry);
+    }
+}
+
+static void collapse(PmBuilder* b, uint32_t u, uint32_t v, float cost) {
+    uint32_t step = b->collapse_count++;
+    b->collapse_vertex[step] = u;
+    b->collapse_parent[step] = v;
+    b->collapse_error[step] = cost;
+    b->collapsed[u] = 1;
+
+    PmTriangleList* list = &b->lists[u];
+    for (uint32_t i = 0; i < list->count; i++) {
+        uint32_t t = list->items[i];
+        if (b->removed_by[t] != PM_NONE) continue;
+        uint32_t* tri = b->tris + 3 * t;
+        if (tri[0] == v || tri[1] == v || tri[2] == v) {
+            b->removed_by[t] = step;
+            b->alive_triangles--;
+        } else {
+            for (int k = 0; k < 3; k++) {
+                if (tri[k] == u) tri[k] = v;
+            }
+            list_push(b, v, t);
+        }
+    }
+    free(list->items);
+    list->items = NULL;
+    list->count = list->capacity = 0;
+
+    for (int i = 0; i < 10; i++) b->quadrics[v].q[i] += b->quadrics[u].q[i];
+
+    // Everything whose neighbourhood changed is around v now
+    evaluate_vertex(b, v);
+    PmTriangleList* v_list = &b->lists[v];
+    uint32_t seen = next_stamp(b);
+    b->mark[v] = seen;
+    uint32_t neighbour_count = 0;
+    for (uint32_t i = 0; i < v_list->count; i++) {
+        uint32_t t = v_list->items[i];
+        if (b->removed_by[t] != PM_NONE) continue;
+        for (int k = 0; k < 3; k++) {
+            uint32_t w = b->tris[3 * t + k];
+            if (b->mark[w] == seen) continue;
+            b->mark[w] = seen;
+            // Re-evaluating reuses the stamps and candidate list, so gather first
+            if (neighbour_count == b->candidate_capacity) {
+                uint32_t capacity = b->candidate_capacity ? b->candidate_capacity * 2 : 64;
+                uint32_t* candidates = (uint32_t*)realloc(b->candidates, capacity * sizeof(uint32_t));
+                if (!candidates) {
+                    b->out_of_memory = 1;
+                    return;
+                }
+                b->candidates = candidates;
+                b->candidate_capacity = capacity;
+            }
+            b->candidates[neighbour_count++] = w;
+        }
+    }
+    uint32_t* neighbours = (uint32_t*)malloc((neighbour_count + 1) * sizeof(uint32_t));
+    if (!neighbours) {
+        b->out_of_memory = 1;
+        return;
+    }
+    memcpy(neighbours, b->candidates, neighbour_count * sizeof(uint32_t));
+    for (uint32_t i = 0; i < neighbour_count; i++) evaluate_vertex(b, neighbours[i]);
+    free(neighbours);
+}
+
+static int compare_positions(const void* a, const void* b, const Vertex* vertices) {
+    const vec3_t* pa = &vertices[*(const uint32_t*)a].position;
+    const vec3_t* pb = &vertices[*(const uint32_t*)b].position;
+    if (pa->x != pb->x) return pa->x < pb->x ? -1 : 1;
+    if (pa->y != pb->y) return pa->y < pb->y ? -1 : 1;
+    if (pa->z != pb->z) return pa->z < pb->z ? -1 : 1;
+    return 0;
+}
+
+static const Vertex* sort_vertices;
+
+static int compare_vertex_positions(const void* a, const void* b) {
+    return compare_positions(a, b, sort_vertices);
+}
+
+// Lock seam vertices (shared positions) and border or non-manifold
+// vertices (edges not shared by exactly two consistently wound triangles)
+static int lock_vertices(PmBuilder* b) {
+    uint32_t* order = (uint32_t*)malloc(b->vertex_count * sizeof(uint32_t));
+    HalfEdgeMesh* topology = halfedge_mesh_build_indices(b->tris, b->triangle_count * 3, b->vertex_count);
+    if (!order || !topology) {
+        free(order);
+        halfedge_mesh_destroy(topology);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < b->vertex_count; i++) order[i] = i;
+    sort_vertices = b->vertices;
+    qsort(order, b->vertex_count, sizeof(uint32_t), compare_vertex_positions);
+    for (uint32_t i = 1; i < b->vertex_count; i++) {
+        if (compare_positions(&order[i - 1], &order[i], b->vertices) == 0) {
+            b->locked[order[i - 1]] = 1;
+            b->locked[order[i]] = 1;
+        }
+    }
+
+    // Degenerate triangles are ignored by the topology as they are here
+    for (uint32_t i = 0; i < b->vertex_count; i++) {
+        if (topology->vertex_flags[i] & (HALFEDGE_VERTEX_BORDER | HALFEDGE_VERTEX_NONMANIFOLD)) b->locked[i] = 1;
+    }
+
+    free(order);
+    halfedge_mesh_destroy(topology);
+    return 1;
+}
+
+static void builder_free(PmBuilder* b) {
+    if (b->lists) {
+        for (uint32_t i = 0; i < b->vertex_count; i++) free(b->lists[i].items);
+    }
+    free(b->tris);
+    free(b->removed_by);
+    free(b->lists);
+    free(b->quadrics);
+    free(b->locked);
+    free(b->collapsed);
+    free(b->version);
+    free(b->mark);
+    free(b->candidates);
+    free(b->heap);
+    free(b->collapse_vertex);
+    free(b->collapse_parent);
+    free(b->collapse_error);
+}
+
+// Run collapses until the target triangle count or no valid collapse is left
+static int simplify(PmBuilder* b, const Mesh* mesh, uint32_t target_triangles) {
+    uint32_t vc = mesh->vertex_count, tc = mesh->index_count / 3;
+    b->vertices = mesh->vertices;
+    b->vertex_count = vc;
+    b->triangle_count = tc;
+    b->tris = (uint32_t*)malloc((size_t)tc * 3 * sizeof(uint32_t) + 1);
+    b->removed_by = (uint32_t*)malloc((size_t)tc * sizeof(uint32_t) + 1);
+    b->lists = (PmTriangleList*)calloc(vc, sizeof(PmTriangleList));
+    b->quadrics = (PmQuadric*)calloc(vc, sizeof(PmQuadric));
+    b->locked = (uint8_t*)calloc(vc, 1);
+    b->collapsed = (uint8_t*)calloc(vc, 1);
+    b->version = (uint32_t*)calloc(vc, sizeof(uint32_t));
+    b->mark = (uint32_t*)calloc(vc, sizeof(uint32_t));
+    b->collapse_vertex = (uint32_t*)malloc(vc * sizeof(uint32_t));
+    b->collapse_parent = (uint32_t*)malloc(vc * sizeof(uint32_t));
+    b->collapse_error = (float*)malloc(vc * sizeof(float));
+    if (!b->tris || !b->removed_by || !b->lists || !b->quadrics || !b->locked || !b->collapsed || !b->version ||
+        !b->mark || !b->collapse_vertex || !b->collapse_parent || !b->collapse_error) {
+        return 0;
+    }
+
+    memcpy(b->tris, mesh->indices, (size_t)tc * 3 * sizeof(uint32_t));
+    for (uint32_t t = 0; t < tc; t++) {
+        const uint32_t* tri = b->tris + 3 * t;
+        int degenerate = tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0];
+        b->removed_by[t] = degenerate ? PM_DROPPED : PM_NONE;
+        if (degenerate) continue;
+        b->alive_triangles++;
+
+        vec3_t p0 = mesh->vertices[tri[0]].position, p1 = mesh->vertices[tri[1]].position, p2 = mesh->vertices[tri[2]].position;
+        vec3_t n = triangle_normal(p0, p1, p2);
+        float length = vec3_length(n);
+        if (length > 0.0f) {
+            n = vec3_scale(n, 1.0f / length);
+            double d = -(double)vec3_dot(n, p0);
+            for (int k = 0; k < 3; k++) quadric_add_plane(&b->quadrics[tri[k]], n.x, n.y, n.z, d, 0.5 * length);
+        }
+        for (int k = 0; k < 3; k++) {
+            if (!list_push(b, tri[k], t)) return 0;
+        }
+    }
+    if (!lock_vertices(b)) {
+        return 0;
+    }
+
+    for (uint32_t u = 0; u < vc; u++) evaluate_vertex(b, u);
+    while (b->alive_triangles > target_triangles && b->heap_count > 0 && !b->out_of_memory) {
+        PmHeapEntry entry = heap_pop(b);
+        uint32_t u = entry.vertex;
+        if (entry.version != b->version[u] || b->collapsed[u] || b->collapsed[entry.target]) continue;
+        if (!collapse_valid(b, u, entry.target)) {
+            evaluate_vertex(b, u);
+            continue;
+        }
+        collapse(b, u, entry.target, entry.cost);
+    }
+    return !b->out_of_memory;
+}
+
+// ============================================================================
+// PROGRESSIVE MESH FUNCTIONS
+// ============================================================================
+
+ProgressiveMeshDesc progressive_mesh_desc_default(void) {
+    ProgressiveMeshDesc desc;
+    desc.base_ratio = PROGRESSIVE_MESH_DEFAULT_BASE_RATIO;
+    desc.min_base_triangles = 16;
+    return desc;
+}
+
+// Allocate a progressive mesh with room for every split
+static ProgressiveMesh* progressive_mesh_allocate(uint32_t base_vertex_count, uint32_t base_triangle_count,
+                                                  uint32_t split_count, uint32_t triangle_count, uint32_t corner_count) {
+    ProgressiveMesh* pm = (ProgressiveMesh*)calloc(1, sizeof(ProgressiveMesh));
+    if (!pm) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive mesh\n");
+        return NULL;
+    }
+    pm->base_vertex_count = base_vertex_count;
+    pm->base_triangle_count = base_triangle_count;
+    pm->total_split_count = split_count;
+    pm->total_triangle_count = triangle_count;
+    pm->total_corner_count = corner_count;
+    pm->vertices = (Vertex*)malloc(((size_t)base_vertex_count + split_count) * sizeof(Vertex) + 1);
+    pm->source_indices = (uint32_t*)malloc((size_t)triangle_count * 3 * sizeof(uint32_t) + 1);
+    pm->splits = (ProgressiveSplit*)malloc((size_t)split_count * sizeof(ProgressiveSplit) + 1);
+    pm->corners = (uint32_t*)malloc((size_t)corner_count * sizeof(uint32_t) + 1);
+    pm->mesh.indices = (uint32_t*)malloc((size_t)triangle_count * 3 * sizeof(uint32_t) + 1);
+    if (!pm->vertices || !pm->source_indices || !pm->splits || !pm->corners || !pm->mesh.indices) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive mesh\n");
+        progressive_mesh_destroy(pm);
+        return NULL;
+    }
+    pm->mesh.vertices = pm->vertices;
+    return pm;
+}
+
+// Show the base level once the base is in place
+static void reset_to_base(ProgressiveMesh* pm) {
+    memcpy(pm->mesh.indices, pm->source_indices, (size_t)pm->base_triangle_count * 3 * sizeof(uint32_t));
+    pm->level = 0;
+    pm->mesh.vertex_count = pm->base_vertex_count;
+    pm->mesh.triangle_count = pm->base_triangle_count;
+    pm->mesh.index_count = (uint32_t)((size_t)pm->base_triangle_count * 3);
+}
+
+ProgressiveMesh* progressive_mesh_build(const Mesh* mesh, const ProgressiveMeshDesc* desc) {
+    if (!mesh || !mesh->vertices || !mesh->indices || mesh->index_count < 3 || mesh->index_count % 3 != 0 ||
+        mesh->index_count / 3 > PROGRESSIVE_MESH_MAX_TRIANGLES || mesh->vertex_count > PROGRESSIVE_MESH_MAX_VERTICES) {
+        fprintf(stderr, "Error: Invalid progressive mesh parameters\n");
+        return NULL;
+    }
+    for (uint32_t i = 0; i < mesh->index_count; i++) {
+        if (mesh->indices[i] >= mesh->vertex_count) {
+            fprintf(stderr, "Error: Progressive mesh index %u out of range\n", mesh->indices[i]);
+            return NULL;
+        }
+    }
+
+    ProgressiveMeshDesc settings = desc ? *desc : progressive_mesh_desc_default();
+    uint32_t triangle_input = mesh->index_count / 3;
+    uint32_t target = (uint32_t)((float)triangle_input * settings.base_ratio);
+    if (target < settings.min_base_triangles) target = settings.min_base_triangles;
+
+    PmBuilder b;
+    memset(&b, 0, sizeof(b));
+    if (!simplify(&b, mesh, target)) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive mesh simplification\n");
+        builder_free(&b);
+        return NULL;
+    }
+
+    // Survivors first, then collapsed vertices in reverse collapse order:
+    // split s introduces vertex base + s
+    uint32_t vc = mesh->vertex_count, tc = triangle_input;
+    uint32_t split_count = b.collapse_count, base_vertices = vc - split_count;
+    uint32_t* remap = (uint32_t*)malloc(vc * sizeof(uint32_t));
+    uint32_t* parent = (uint32_t*)malloc(vc * sizeof(uint32_t));    // By new index
+    uint32_t* order = (uint32_t*)malloc(((size_t)tc + 1) * sizeof(uint32_t));
+    uint32_t* split_first = (uint32_t*)calloc((size_t)split_count + 2, sizeof(uint32_t));
+    uint32_t* corner_first = (uint32_t*)calloc((size_t)split_count + 1, sizeof(uint32_t));
+    if (!remap || !parent || !order || !split_first || !corner_first) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive mesh\n");
+        free(remap);
+        free(parent);
+        free(order);
+        free(split_first);
+        free(corner_first);
+        builder_free(&b);
+        return NULL;
+    }
+
+    uint32_t next = 0;
+    for (uint32_t i = 0; i < vc; i++) {
+        if (!b.collapsed[i]) remap[i] = next++;
+    }
+    for (uint32_t s = 0; s < split_count; s++) {
+        remap[b.collapse_vertex[split_count - 1 - s]] = base_vertices + s;
+    }
+    for (uint32_t s = 0; s < split_count; s++) {
+        parent[base_vertices + s] = remap[b.collapse_parent[split_count - 1 - s]];
+    }
+
+    // Triangles ordered by the split that makes them appear (base first);
+    // bucket 0 is the base, bucket s + 1 split s
+    uint32_t kept = 0;
+    for (uint32_t t = 0; t < tc; t++) {
+        if (b.removed_by[t] == PM_DROPPED) continue;
+        uint32_t bucket = b.removed_by[t] == PM_NONE ? 0 : split_count - b.removed_by[t];
+        split_first[bucket + 1]++;
+        kept++;
+    }
+    for (uint32_t s = 0; s <= split_count; s++) split_first[s + 1] += split_first[s];
+    uint32_t base_triangles = split_first[1];
+    for (uint32_t t = 0; t < tc; t++) {
+        if (b.removed_by[t] == PM_DROPPED) continue;
+        uint32_t bucket = b.removed_by[t] == PM_NONE ? 0 : split_count - b.removed_by[t];
+        order[split_first[bucket]++] = t;
+    }
+    // split_first[s] is now the end of bucket s, i.e. the triangle count after split s - 1
+
+    // Each corner is rewritten by every vertex on its collapse chain that
+    // is introduced after its triangle appears
+    uint32_t corner_total = 0;
+    int corners_ok = 1;
+    for (uint32_t pass = 0; pass < 2 && corners_ok; pass++) {
+        for (uint32_t slot = 0; slot < kept; slot++) {
+            uint32_t t = order[slot];
+            uint32_t appear = b.removed_by[t] == PM_NONE ? base_vertices : base_vertices + (split_count - b.removed_by[t]);
+            for (int k = 0; k < 3; k++) {
+                uint32_t x = remap[mesh->indices[3 * t + k]];
+                while (x >= appear) {
+                    uint32_t s = x - base_vertices;
+                    if (pass == 0) {
+                        corner_first[s]++;
+                        corner_total++;
+                    } else {
+                        b.tris[corner_first[s]++] = slot * 3 + (uint32_t)k;
+                    }
+                    x = parent[x];
+                }
+            }
+        }
+        if (pass == 0) {
+            uint32_t sum = 0;
+            for (uint32_t s = 0; s < split_count; s++) {
+                uint32_t count = corner_first[s];
+                corner_first[s] = sum;
+                sum += count;
+            }
+            // Corner slots are staged in the builder's triangle array
+            if (corner_total > tc * 3) {
+                uint32_t* grown = (uint32_t*)realloc(b.tris, (size_t)corner_total * sizeof(uint32_t));
+                if (!grown) {
+                    corners_ok = 0;
+                    break;
+                }
+                b.tris = grown;
+            }
+        }
+    }
+
+    ProgressiveMesh* pm = NULL;
+    if (!corners_ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive mesh corners\n");
+    } else {
+        pm = progressive_mesh_allocate(base_vertices, base_triangles, split_count, kept, corner_total);
+    }
+    if (pm) {
+        for (uint32_t i = 0; i < vc; i++) pm->vertices[remap[i]] = mesh->vertices[i];
+        for (uint32_t slot = 0; slot < kept; slot++) {
+            uint32_t t = order[slot];
+            uint32_t appear = b.removed_by[t] == PM_NONE ? base_vertices : base_vertices + (split_count - b.removed_by[t]);
+            for (int k = 0; k < 3; k++) {
+                uint32_t x = remap[mesh->indices[3 * t + k]];
+                while (x >= appear) x = parent[x];
+                pm->source_indices[slot * 3 + k] = x;
+            }
+        }
+        memcpy(pm->corners, b.tris, (size_t)corner_total * sizeof(uint32_t));
+        uint32_t corner_start = 0;
+        for (uint32_t s = 0; s < split_count; s++) {
+            ProgressiveSplit* split = &pm->splits[s];
+            split->parent = parent[base_vertices + s];
+            split->triangle_count = split_first[s + 1];
+            split->corner_first = corner_start;
+            split->corner_count = corner_first[s] - corner_start;
+            split->error = b.collapse_error[split_count - 1 - s];
+            corner_start = corner_first[s];
+        }
+        pm->split_count = split_count;
+        pm->corner_count = corner_total;
+        reset_to_base(pm);
+        fprintf(stderr, "Built progressive mesh: %u -> %u triangles, %u splits\n", kept, base_triangles, split_count);
+    }
+
+    free(remap);
+    free(parent);
+    free(order);
+    free(split_first);
+    free(corner_first);
+    builder_free(&b);
+    return pm;
+}
+
+void progressive_mesh_destroy(ProgressiveMesh* pm) {
+    if (!pm) {
+        return;
+    }
+    free(pm->vertices);
+    free(pm->source_indices);
+    free(pm->splits);
+    free(pm->corners);
+    free(pm->mesh.indices);
+    free(pm);
+}
+
+uint32_t progressive_mesh_triangles_at(const ProgressiveMesh* pm, uint32_t level) {
+    if (!pm) {
+        return 0;
+    }
+    if (level > pm->split_count) level = pm->split_count;
+    return level == 0 ? pm->base_triangle_count : pm->splits[level - 1].triangle_count;
+}
+
+uint32_t progressive_mesh_set_level(ProgressiveMesh* pm, uint32_t level) {
+    if (!pm) {
+        return 0;
+    }
+    if (level > pm->split_count) level = pm->split_count;
+
+    uint32_t* indices = pm->mesh.indices;
+    while (pm->level < level) {
+        const ProgressiveSplit* split = &pm->splits[pm->level];
+        uint32_t first = progressive_mesh_triangles_at(pm, pm->level) * 3;
+        memcpy(indices + first, pm->source_indices + first, (split->triangle_count * 3 - first) * sizeof(uint32_t));
+        uint32_t vertex = pm->base_vertex_count + pm->level;
+        const uint32_t* corners = pm->corners + split->corner_first;
+        for (uint32_t i = 0; i < split->corner_count; i++) indices[corners[i]] = vertex;
+        pm->level++;
+    }
+    while (pm->level > level) {
+        const ProgressiveSplit* split = &pm->splits[pm->level - 1];
+        const uint32_t* corners = pm->corners + split->corner_first;
+        for (uint32_t i = 0; i < split->corner_count; i++) indices[corners[i]] = split->parent;
+        pm->level--;
+    }
+
+    pm->mesh.vertex_count = pm->base_vertex_count + pm->level;
+    pm->mesh.triangle_count = progressive_mesh_triangles_at(pm, pm->level);
+    pm->mesh.index_count = pm->mesh.triangle_count * 3;
+    return pm->level;
+}
+
+uint32_t progressive_mesh_level_for_budget(const ProgressiveMesh* pm, uint32_t triangle_budget) {
+    if (!pm) {
+        return 0;
+    }
+    // Triangle counts never decrease with the level
+    uint32_t lo = 0, hi = pm->split_count;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        if (pm->splits[mid - 1].triangle_count <= triangle_budget) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// ============================================================================
+// PROGRESSIVE MODEL FUNCTIONS
+// ============================================================================
+
+ProgressiveModel* progressive_model_build(const Model3D* model, const ProgressiveMeshDesc* desc) {
+    if (!model || model->mesh_count == 0) {
+        fprintf(stderr, "Error: Invalid progressive model parameters\n");
+        return NULL;
+    }
+
+    ProgressiveModel* result = (ProgressiveModel*)calloc(1, sizeof(ProgressiveModel));
+    if (!result || !(result->meshes = (ProgressiveMesh**)calloc(model->mesh_count, sizeof(ProgressiveMesh*)))) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive model\n");
+        free(result);
+        return NULL;
+    }
+    result->mesh_count = model->mesh_count;
+    for (uint32_t m = 0; m < model->mesh_count; m++) {
+        if (!(result->meshes[m] = progressive_mesh_build(&model->meshes[m], desc))) {
+            progressive_model_destroy(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+void progressive_model_destroy(ProgressiveModel* model) {
+    if (!model) {
+        return;
+    }
+    for (uint32_t m = 0; m < model->mesh_count; m++) progressive_mesh_destroy(model->meshes[m]);
+    if (model->stream) fclose(model->stream);
+    free(model->meshes);
+    free(model);
+}
+
+int progressive_model_save(const ProgressiveModel* model, const char* path) {
+    if (!model || !path) {
+        fprintf(stderr, "Error: Invalid progressive model save parameters\n");
+        return 0;
+    }
+    uint32_t total_splits = 0;
+    for (uint32_t m = 0; m < model->mesh_count; m++) {
+        const ProgressiveMesh* pm = model->meshes[m];
+        if (pm->split_count != pm->total_split_count) {
+            fprintf(stderr, "Error: Progressive model is still streaming\n");
+            return 0;
+        }
+        total_splits += pm->split_count;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create progressive model %s\n", path);
+        return 0;
+    }
+    uint32_t* next = (uint32_t*)calloc(model->mesh_count, sizeof(uint32_t));
+    if (!next) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive model save\n");
+        fclose(file);
+        return 0;
+    }
+
+    PmFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PROGRESSIVE_MESH_MAGIC;
+    header.version = PROGRESSIVE_MESH_VERSION;
+    header.vertex_size = sizeof(Vertex);
+    header.mesh_count = model->mesh_count;
+    header.split_count = total_splits;
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for (uint32_t m = 0; ok && m < model->mesh_count; m++) {
+        const ProgressiveMesh* pm = model->meshes[m];
+        PmFileMesh mesh_header;
+        memset(&mesh_header, 0, sizeof(mesh_header));
+        mesh_header.base_vertex_count = pm->base_vertex_count;
+        mesh_header.base_triangle_count = pm->base_triangle_count;
+        mesh_header.split_count = pm->split_count;
+        mesh_header.triangle_count = pm->total_triangle_count;
+        mesh_header.corner_count = pm->corner_count;
+        ok = fwrite(&mesh_header, sizeof(mesh_header), 1, file) == 1 &&
+             fwrite(pm->vertices, sizeof(Vertex), pm->base_vertex_count, file) == pm->base_vertex_count &&
+             fwrite(pm->source_indices, sizeof(uint32_t), pm->base_triangle_count * 3, file) == pm->base_triangle_count * 3;
+    }
+
+    // Largest error first across meshes, keeping each mesh's order
+    for (uint32_t written = 0; ok && written < total_splits; written++) {
+        uint32_t best = 0;
+        float best_error = -1.0f;
+        for (uint32_t m = 0; m < model->mesh_count; m++) {
+            const ProgressiveMesh* pm = model->meshes[m];
+            if (next[m] < pm->split_count && pm->splits[next[m]].error > best_error) {
+                best = m;
+                best_error = pm->splits[next[m]].error;
+            }
+        }
+        const ProgressiveMesh* pm = model->meshes[best];
+        uint32_t s = next[best]++;
+        const ProgressiveSplit* split = &pm->splits[s];
+        uint32_t first = progressive_mesh_triangles_at(pm, s) * 3;
+
+        PmFileSplit record;
+        memset(&record, 0, sizeof(record));
+        record.mesh = best;
+        record.parent = split->parent;
+        record.new_triangles = split->triangle_count - first / 3;
+        record.corner_count = split->corner_count;
+        record.error = split->error;
+        record.vertex = pm->vertices[pm->base_vertex_count + s];
+        ok = fwrite(&record, sizeof(record), 1, file) == 1 &&
+             fwrite(pm->source_indices + first, sizeof(uint32_t), record.new_triangles * 3, file) == record.new_triangles * 3 &&
+             fwrite(pm->corners + split->corner_first, sizeof(uint32_t), split->corner_count, file) == split->corner_count;
+    }
+
+    free(next);
+    if (fclose(file) != 0) ok = 0;
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write progressive model %s\n", path);
+        return 0;
+    }
+    fprintf(stderr, "Saved progressive model %s: %u meshes, %u splits\n", path, model->mesh_count, total_splits);
+    return 1;
+}
+
+ProgressiveModel* progressive_model_open(const char* path) {
+    if (!path) {
+        fprintf(stderr, "Error: Invalid progressive model open parameters\n");
+        return NULL;
+    }
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open progressive model %s\n", path);
+        return NULL;
+    }
+
+    PmFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.magic != PROGRESSIVE_MESH_MAGIC ||
+        header.version != PROGRESSIVE_MESH_VERSION || header.vertex_size != sizeof(Vertex) || header.mesh_count == 0) {
+        fprintf(stderr, "Error: %s is not a valid progressive model\n", path);
+        fclose(file);
+        return NULL;
+    }
+
+    ProgressiveModel* model = (ProgressiveModel*)calloc(1, sizeof(ProgressiveModel));
+    if (!model || !(model->meshes = (ProgressiveMesh**)calloc(header.mesh_count, sizeof(ProgressiveMesh*)))) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive model\n");
+        free(model);
+        fclose(file);
+        return NULL;
+    }
+    model->mesh_count = header.mesh_count;
+    model->stream = file;
+
+    uint32_t total_splits = 0;
+    for (uint32_t m = 0; m < header.mesh_count; m++) {
+        PmFileMesh mesh_header;
+        ProgressiveMesh* pm = NULL;
+        // Bound the counts before they size anything: index counts are
+        // triangles * 3 and vertex ids are base + split, both in uint32
+        int ok = fread(&mesh_header, sizeof(mesh_header), 1, file) == 1 &&
+                 mesh_header.base_triangle_count <= mesh_header.triangle_count &&
+                 mesh_header.triangle_count <= PROGRESSIVE_MESH_MAX_TRIANGLES &&
+                 (uint64_t)mesh_header.base_vertex_count + mesh_header.split_count <= PROGRESSIVE_MESH_MAX_VERTICES &&
+                 (uint64_t)mesh_header.corner_count <= (uint64_t)mesh_header.triangle_count * 3;
+        if (ok) {
+            pm = progressive_mesh_allocate(mesh_header.base_vertex_count, mesh_header.base_triangle_count,
+                                           mesh_header.split_count, mesh_header.triangle_count, mesh_header.corner_count);
+            model->meshes[m] = pm;
+        }
+        size_t base_indices = pm ? (size_t)pm->base_triangle_count * 3 : 0;
+        ok = pm && fread(pm->vertices, sizeof(Vertex), pm->base_vertex_count, file) == pm->base_vertex_count &&
+             fread(pm->source_indices, sizeof(uint32_t), base_indices, file) == base_indices;
+        for (size_t i = 0; ok && i < base_indices; i++) {
+            ok = pm->source_indices[i] < pm->base_vertex_count;
+        }
+        if (!ok) {
+            fprintf(stderr, "Error: %s is not a valid progressive model\n", path);
+            progressive_model_destroy(model);
+            return NULL;
+        }
+        reset_to_base(pm);
+        total_splits += pm->total_split_count;
+    }
+    model->splits_remaining = total_splits;
+    if (total_splits != header.split_count) {
+        fprintf(stderr, "Error: %s is not a valid progressive model\n", path);
+        progressive_model_destroy(model);
+        return NULL;
+    }
+    if (total_splits == 0) {
+        fclose(model->stream);
+        model->stream = NULL;
+    }
+
+    fprintf(stderr, "Opened progressive model %s: %u meshes, %u splits to stream\n", path, header.mesh_count, total_splits);
+    return model;
+}
+
+// Read one split record into its mesh; 0 on a read error or bad record
+static int read_split(ProgressiveModel* model) {
+    PmFileSplit record;
+    FILE* file = model->stream;
+    if (fread(&record, sizeof(record), 1, file) != 1 || record.mesh >= model->mesh_count) {
+        return 0;
+    }
+    ProgressiveMesh* pm = model->meshes[record.mesh];
+    uint32_t s = pm->split_count;
+    uint32_t first = progressive_mesh_triangles_at(pm, s);
+    uint32_t vertex = pm->base_vertex_count + s;
+    if (s >= pm->total_split_count || record.parent >= vertex ||
+        record.new_triangles > pm->total_triangle_count - first ||
+        record.corner_count > pm->total_corner_count - pm->corner_count) {
+        return 0;
+    }
+
+    size_t first_index = (size_t)first * 3;
+    size_t new_indices = (size_t)record.new_triangles * 3;
+    uint32_t* indices = pm->source_indices + first_index;
+    uint32_t* corners = pm->corners + pm->corner_count;
+    if (fread(indices, sizeof(uint32_t), new_indices, file) != new_indices ||
+        fread(corners, sizeof(uint32_t), record.corner_count, file) != record.corner_count) {
+        return 0;
+    }
+    for (size_t i = 0; i < new_indices; i++) {
+        if (indices[i] > vertex) return 0;
+    }
+    for (uint32_t i = 0; i < record.corner_count; i++) {
+        if (corners[i] >= first_index) return 0;
+    }
+
+    pm->vertices[vertex] = record.vertex;
+    ProgressiveSplit* split = &pm->splits[s];
+    split->parent = record.parent;
+    split->triangle_count = first + record.new_triangles;
+    split->corner_first = pm->corner_count;
+    split->corner_count = record.corner_count;
+    split->error = record.error;
+    pm->corner_count += record.corner_count;
+    pm->split_count++;
+    return 1;
+}
+
+uint32_t progressive_model_stream(ProgressiveModel* model, uint32_t max_splits) {
+    if (!model || !model->stream) {
+        return 0;
+    }
+
+    uint32_t read = 0;
+    while (read < max_splits && model->splits_remaining > 0) {
+        if (!read_split(model)) {
+            fprintf(stderr, "Error: Corrupt progressive model stream, %u splits missing\n", model->splits_remaining);
+            model->splits_remaining = 0;
+            break;
+        }
+        model->splits_remaining--;
+        read++;
+    }
+    if (model->splits_remaining == 0) {
+        fclose(model->stream);
+        model->stream = NULL;
+    }
+    return read;
+}
+
+uint32_t progressive_model_set_triangle_budget(ProgressiveModel* model, uint32_t triangle_budget) {
+    if (!model) {
+        return 0;
+    }
+    uint32_t* levels = (uint32_t*)calloc(model->mesh_count, sizeof(uint32_t));
+    if (!levels) {
+        fprintf(stderr, "Error: Failed to allocate memory for progressive model levels\n");
+        return 0;
+    }
+
+    uint32_t total = 0;
+    for (uint32_t m = 0; m < model->mesh_count; m++) total += model->meshes[m]->base_triangle_count;
+
+    // Greedy by error: stop at the first split that does not fit so the
+    // error order across meshes is kept
+    for (;;) {
+        uint32_t best = model->mesh_count;
+        float best_error = -1.0f;
+        for (uint32_t m = 0; m < model->mesh_count; m++) {
+            const ProgressiveMesh* pm = model->meshes[m];
+            if (levels[m] < pm->split_count && pm->splits[levels[m]].error > best_error) {
+                best = m;
+                best_error = pm->splits[levels[m]].error;
+            }
+        }
+        if (best == model->mesh_count) break;
+        const ProgressiveMesh* pm = model->meshes[best];
+        uint32_t added = pm->splits[levels[best]].triangle_count - progressive_mesh_triangles_at(pm, levels[best]);
+        if (total + added > triangle_budget) break;
+        total += added;
+        levels[best]++;
+    }
+
+    total = 0;
+    for (uint32_t m = 0; m < model->mesh_count; m++) {
+        progressive_mesh_set_level(model->meshes[m], levels[m]);
+        total += model->meshes[m]->mesh.triangle_count;
+    }
+    free(levels);
+    return total;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void progressive_mesh_print(const char* name, const ProgressiveMesh* pm) {
+    if (!pm) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s: base %u vertices / %u triangles, full %u / %u\n", name, pm->base_vertex_count, pm->base_triangle_count,
+           pm->base_vertex_count + pm->total_split_count, pm->total_triangle_count);
+    printf("  Splits: %u/%u loaded, %u corners, level %u (%u triangles)\n", pm->split_count, pm->total_split_count,
+           pm->corner_count, pm->level, pm->mesh.triangle_count);
+}
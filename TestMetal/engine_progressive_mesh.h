@@ -0,0 +1,141 @@
+#ifndef ENGINE_PROGRESSIVE_MESH_H
+#define ENGINE_PROGRESSIVE_MESH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_model.h"
+#include <stdint.h>
+#include <stdio.h>
+
+// ============================================================================
+// PROGRESSIVE MESH CONFIGURATION
+// ============================================================================
+
+#define PROGRESSIVE_MESH_MAGIC 0x4853504Du      // "MPSH"
+#define PROGRESSIVE_MESH_VERSION 1
+#define PROGRESSIVE_MESH_DEFAULT_BASE_RATIO 0.05f
+#define PROGRESSIVE_MESH_MAX_TRIANGLES (1u << 26)   // Per mesh; keeps index counts well inside uint32
+#define PROGRESSIVE_MESH_MAX_VERTICES (1u << 26)    // Per mesh, base plus one per split
+
+// Build parameters
+typedef struct {
+    float base_ratio;           // Target base triangles as a fraction of the input
+    uint32_t min_base_triangles; // Never simplify below this many triangles
+} ProgressiveMeshDesc;
+
+// ============================================================================
+// PROGRESSIVE MESH DATA STRUCTURES
+// ============================================================================
+
+// One vertex split: introduces vertex base_vertex_count + s (collapsed into
+// parent when coarsening), appends the triangles up to triangle_count and
+// rewrites the index slots corners[corner_first .. + corner_count] from
+// parent to the new vertex.
+typedef struct {
+    uint32_t parent;
+    uint32_t triangle_count;    // Triangles drawn once this split is applied
+    uint32_t corner_first;
+    uint32_t corner_count;
+    float error;                // Quadric error of the collapse it undoes
+} ProgressiveSplit;
+
+// Base mesh plus vertex splits ordered coarse to fine (Hoppe-style, with
+// half-edge collapses so vertices keep their original attributes).
+// `mesh` is the drawable current level: its vertices alias `vertices`, its
+// indices are rewritten in place as the level changes. Splits may still be
+// streaming in, so only the first split_count are usable.
+typedef struct {
+    Mesh mesh;
+    Vertex* vertices;           // Base vertices, then one per split
+    uint32_t* source_indices;   // Every triangle as it is first drawn
+    ProgressiveSplit* splits;
+    uint32_t* corners;          // Index buffer slots rewritten by each split
+    uint32_t base_vertex_count;
+    uint32_t base_triangle_count;
+    uint32_t total_split_count;
+    uint32_t total_triangle_count;
+    uint32_t total_corner_count;
+    uint32_t split_count;       // Splits loaded so far
+    uint32_t corner_count;      // Corners loaded so far
+    uint32_t level;             // Splits applied to `mesh`
+} ProgressiveMesh;
+
+// Progressive Model3D: one progressive mesh per source mesh, optionally
+// streaming its splits from a file
+typedef struct {
+    ProgressiveMesh** meshes;
+    uint32_t mesh_count;
+    FILE* stream;               // Open while splits remain on disk
+    uint32_t splits_remaining;
+} ProgressiveModel;
+
+// ============================================================================
+// PROGRESSIVE MESH FUNCTIONS
+// ============================================================================
+
+// Default: 5% of the input triangles, at least 16
+ProgressiveMeshDesc progressive_mesh_desc_default(void);
+
+// Simplify a mesh with quadric-error half-edge collapses and record the
+// inverse splits. Open borders and seams (distinct vertices sharing a
+// position) are kept fixed so no level cracks; degenerate input triangles
+// are dropped. The result starts at the base level.
+ProgressiveMesh* progressive_mesh_build(const Mesh* mesh, const ProgressiveMeshDesc* desc);
+
+// Free a progressive mesh
+void progressive_mesh_destroy(ProgressiveMesh* pm);
+
+// Apply or undo splits until `level` are applied (clamped to the loaded
+// splits). Cost is proportional to the splits crossed. Returns the level.
+uint32_t progressive_mesh_set_level(ProgressiveMesh* pm, uint32_t level);
+
+// Triangles drawn at a level
+uint32_t progressive_mesh_triangles_at(const ProgressiveMesh* pm, uint32_t level);
+
+// Finest loaded level drawing at most `triangle_budget` triangles (the
+// base level if even that exceeds it)
+uint32_t progressive_mesh_level_for_budget(const ProgressiveMesh* pm, uint32_t triangle_budget);
+
+// ============================================================================
+// PROGRESSIVE MODEL FUNCTIONS
+// ============================================================================
+
+// Build every mesh of a model (fully loaded, at the base level)
+ProgressiveModel* progressive_model_build(const Model3D* model, const ProgressiveMeshDesc* desc);
+
+// Free a model and close its stream
+void progressive_model_destroy(ProgressiveModel* model);
+
+// Write the bases of every mesh, then all splits interleaved across meshes
+// from the largest error down, so any prefix of the file is a balanced
+// model. Returns 1 on success.
+int progressive_model_save(const ProgressiveModel* model, const char* path);
+
+// Read the header and the base meshes only; the model is drawable at once.
+// Splits follow with progressive_model_stream.
+ProgressiveModel* progressive_model_open(const char* path);
+
+// Read up to max_splits more splits from the file (the stream closes at
+// the end). Applied levels are unchanged. Returns the splits read; 0 at
+// the end of the file or on a read error.
+uint32_t progressive_model_stream(ProgressiveModel* model, uint32_t max_splits);
+
+// Refine or coarsen every mesh to fit a total triangle budget, spending it
+// on the loaded splits with the largest error first. Returns the
+// triangles drawn.
+uint32_t progressive_model_set_triangle_budget(ProgressiveModel* model, uint32_t triangle_budget);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print base/full sizes, loaded splits and the current level
+void progressive_mesh_print(const char* name, const ProgressiveMesh* pm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_PROGRESSIVE_MESH_H
@@ -0,0 +1,520 @@
+#include "engine_progressive_mesh.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* assets_dir = "assets";
+static const char* MODEL_PATH = "/tmp/engine_progressive_mesh_test.pmsh";
+static const char* CORRUPT_PATH = "/tmp/engine_progressive_mesh_corrupt.pmsh";
+
+// ============================================================================
+// GENERATED MESHES
+// ============================================================================
+
+static void release_mesh(Mesh* mesh) {
+    mesh_free(mesh);
+    free(mesh);
+}
+
+// Closed UV sphere with welded seam and single pole vertices
+static Mesh* make_sphere_mesh(float radius, uint32_t rings, uint32_t segments) {
+    uint32_t vertex_count = 2 + (rings - 1) * segments;
+    uint32_t triangle_count = 2 * segments + (rings - 2) * segments * 2;
+    Mesh* mesh = mesh_allocate(vertex_count, triangle_count * 3);
+    mesh->vertices[0] = vertex_create_components(0.0f, radius, 0.0f, 0.5f, 0.0f, 0.0f, 1.0f, 0.0f);
+    mesh->vertices[1] = vertex_create_components(0.0f, -radius, 0.0f, 0.5f, 1.0f, 0.0f, -1.0f, 0.0f);
+    for (uint32_t r = 1; r < rings; r++) {
+        float phi = 3.14159265f * (float)r / (float)rings;
+        for (uint32_t s = 0; s < segments; s++) {
+            float theta = 6.2831853f * (float)s / (float)segments;
+            vec3_t n = vec3(sinf(phi) * cosf(theta), cosf(phi), sinf(phi) * sinf(theta));
+            mesh->vertices[2 + (r - 1) * segments + s] = vertex_create_components(
+                radius * n.x, radius * n.y, radius * n.z, (float)s / (float)segments, (float)r / (float)rings, n.x, n.y, n.z);
+        }
+    }
+    uint32_t idx = 0;
+    for (uint32_t s = 0; s < segments; s++) {
+        uint32_t s1 = (s + 1) % segments;
+        mesh->indices[idx++] = 0;
+        mesh->indices[idx++] = 2 + s1;
+        mesh->indices[idx++] = 2 + s;
+        uint32_t last = 2 + (rings - 2) * segments;
+        mesh->indices[idx++] = 1;
+        mesh->indices[idx++] = last + s;
+        mesh->indices[idx++] = last + s1;
+    }
+    for (uint32_t r = 1; r < rings - 1; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t s1 = (s + 1) % segments;
+            uint32_t a = 2 + (r - 1) * segments + s, b = 2 + (r - 1) * segments + s1;
+            uint32_t c = a + segments, d = b + segments;
+            mesh->indices[idx++] = a;
+            mesh->indices[idx++] = b;
+            mesh->indices[idx++] = c;
+            mesh->indices[idx++] = b;
+            mesh->indices[idx++] = d;
+            mesh->indices[idx++] = c;
+        }
+    }
+    return mesh;
+}
+
+// Open height field grid
+static Mesh* make_grid_mesh(uint32_t size) {
+    Mesh* mesh = mesh_allocate((size + 1) * (size + 1), size * size * 6);
+    for (uint32_t y = 0; y <= size; y++) {
+        for (uint32_t x = 0; x <= size; x++) {
+            float fx = (float)x / (float)size, fy = (float)y / (float)size;
+            mesh->vertices[y * (size + 1) + x] = vertex_create_components(
+                fx * 4.0f, 0.2f * sinf(fx * 6.0f) * cosf(fy * 5.0f), fy * 4.0f, fx, fy, 0.0f, 1.0f, 0.0f);
+        }
+    }
+    uint32_t idx = 0;
+    for (uint32_t y = 0; y < size; y++) {
+        for (uint32_t x = 0; x < size; x++) {
+            uint32_t i0 = y * (size + 1) + x, i1 = i0 + 1, i2 = i0 + size + 1, i3 = i2 + 1;
+            mesh->indices[idx++] = i0;
+            mesh->indices[idx++] = i2;
+            mesh->indices[idx++] = i1;
+            mesh->indices[idx++] = i1;
+            mesh->indices[idx++] = i2;
+            mesh->indices[idx++] = i3;
+        }
+    }
+    return mesh;
+}
+
+// Triangles as vertex-content keys (rotation and winding kept), sorted
+typedef struct {
+    float key[9];
+} TriangleKey;
+
+static int compare_keys(const void* a, const void* b) {
+    return memcmp(a, b, sizeof(TriangleKey));
+}
+
+static TriangleKey* triangle_keys(const Vertex* vertices, const uint32_t* indices, uint32_t triangle_count) {
+    TriangleKey* keys = (TriangleKey*)malloc((triangle_count + 1) * sizeof(TriangleKey));
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        for (int k = 0; k < 3; k++) {
+            vec3_t p = vertices[indices[3 * t + k]].position;
+            keys[t].key[3 * k] = p.x;
+            keys[t].key[3 * k + 1] = p.y;
+            keys[t].key[3 * k + 2] = p.z;
+        }
+    }
+    qsort(keys, triangle_count, sizeof(TriangleKey), compare_keys);
+    return keys;
+}
+
+static int same_triangles(const Mesh* a, const Mesh* b) {
+    if (a->triangle_count != b->triangle_count) return 0;
+    TriangleKey* ka = triangle_keys(a->vertices, a->indices, a->triangle_count);
+    TriangleKey* kb = triangle_keys(b->vertices, b->indices, b->triangle_count);
+    int same = memcmp(ka, kb, a->triangle_count * sizeof(TriangleKey)) == 0;
+    free(ka);
+    free(kb);
+    return same;
+}
+
+// Every index is in range and no triangle is degenerate
+static int level_well_formed(const ProgressiveMesh* pm) {
+    const Mesh* mesh = &pm->mesh;
+    for (uint32_t t = 0; t < mesh->triangle_count; t++) {
+        const uint32_t* tri = mesh->indices + 3 * t;
+        if (tri[0] >= mesh->vertex_count || tri[1] >= mesh->vertex_count || tri[2] >= mesh->vertex_count) return 0;
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0]) return 0;
+    }
+    return 1;
+}
+
+// Every face of a sphere level faces away from the centre
+static int sphere_faces_outward(const ProgressiveMesh* pm) {
+    const Mesh* mesh = &pm->mesh;
+    for (uint32_t t = 0; t < mesh->triangle_count; t++) {
+        vec3_t p0 = mesh->vertices[mesh->indices[3 * t]].position;
+        vec3_t p1 = mesh->vertices[mesh->indices[3 * t + 1]].position;
+        vec3_t p2 = mesh->vertices[mesh->indices[3 * t + 2]].position;
+        vec3_t n = vec3_cross(vec3_sub(p1, p0), vec3_sub(p2, p0));
+        vec3_t c = vec3_scale(vec3_add(vec3_add(p0, p1), p2), 1.0f / 3.0f);
+        if (vec3_dot(n, c) <= 0.0f) return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// PROGRESSIVE MESH TESTS
+// ============================================================================
+
+static void test_sphere_levels(void) {
+    printf("\n--- Progressive Sphere Tests ---\n");
+
+    Mesh* sphere = make_sphere_mesh(1.0f, 32, 64);
+    ProgressiveMesh* pm = progressive_mesh_build(sphere, NULL);
+    TEST_ASSERT_NOT_NULL(pm, "Sphere should build");
+    if (!pm) {
+        release_mesh(sphere);
+        return;
+    }
+    progressive_mesh_print("Sphere", pm);
+
+    TEST_ASSERT_EQUAL(0u, pm->level, "A built mesh should start at the base level");
+    TEST_ASSERT(pm->base_triangle_count <= sphere->triangle_count / 20 + 2, "Base should reach about 5% of the triangles");
+    TEST_ASSERT_EQUAL(sphere->vertex_count, pm->base_vertex_count + pm->total_split_count, "Every vertex is base or split");
+    TEST_ASSERT(level_well_formed(pm) && sphere_faces_outward(pm), "Base level should be well formed and unflipped");
+
+    int monotonic = 1;
+    for (uint32_t s = 1; s < pm->split_count; s++) monotonic &= pm->splits[s].triangle_count >= pm->splits[s - 1].triangle_count;
+    TEST_ASSERT(monotonic, "Triangle counts should never decrease with the level");
+
+    int levels_ok = 1;
+    for (uint32_t step = 1; step <= 10; step++) {
+        progressive_mesh_set_level(pm, pm->split_count * step / 10);
+        levels_ok &= level_well_formed(pm) && sphere_faces_outward(pm);
+    }
+    TEST_ASSERT(levels_ok, "Intermediate levels should be well formed and unflipped");
+
+    TEST_ASSERT_EQUAL(pm->split_count, pm->level, "Refining fully should apply every split");
+    TEST_ASSERT(same_triangles(&pm->mesh, sphere), "Full level should reproduce the input triangles exactly");
+
+    uint32_t* base = (uint32_t*)malloc(pm->base_triangle_count * 3 * sizeof(uint32_t));
+    memcpy(base, pm->source_indices, pm->base_triangle_count * 3 * sizeof(uint32_t));
+    progressive_mesh_set_level(pm, 0);
+    TEST_ASSERT(pm->mesh.triangle_count == pm->base_triangle_count &&
+                memcmp(pm->mesh.indices, base, pm->base_triangle_count * 3 * sizeof(uint32_t)) == 0,
+                "Coarsening to the base should restore the base indices");
+    free(base);
+
+    uint32_t mid = pm->split_count / 2;
+    progressive_mesh_set_level(pm, mid);
+    uint32_t* snapshot = (uint32_t*)malloc(pm->mesh.index_count * sizeof(uint32_t));
+    uint32_t snapshot_count = pm->mesh.index_count;
+    memcpy(snapshot, pm->mesh.indices, snapshot_count * sizeof(uint32_t));
+    progressive_mesh_set_level(pm, pm->split_count);
+    progressive_mesh_set_level(pm, mid / 3);
+    progressive_mesh_set_level(pm, mid);
+    TEST_ASSERT(pm->mesh.index_count == snapshot_count && memcmp(pm->mesh.indices, snapshot, snapshot_count * sizeof(uint32_t)) == 0,
+                "A level should be identical however it is reached");
+    free(snapshot);
+
+    uint32_t budget = sphere->triangle_count / 2;
+    uint32_t level = progressive_mesh_level_for_budget(pm, budget);
+    TEST_ASSERT(progressive_mesh_triangles_at(pm, level) <= budget &&
+                (level == pm->split_count || progressive_mesh_triangles_at(pm, level + 1) > budget),
+                "Budget level should be the finest that fits");
+    TEST_ASSERT_EQUAL(0u, progressive_mesh_level_for_budget(pm, 1), "Budgets below the base should give the base");
+
+    progressive_mesh_destroy(pm);
+    release_mesh(sphere);
+}
+
+static void test_open_grid(void) {
+    printf("\n--- Open Mesh Tests ---\n");
+
+    Mesh* grid = make_grid_mesh(32);
+    ProgressiveMesh* pm = progressive_mesh_build(grid, NULL);
+    TEST_ASSERT_NOT_NULL(pm, "Grid should build");
+    if (pm) {
+        progressive_mesh_print("Grid", pm);
+        TEST_ASSERT(pm->base_triangle_count < grid->triangle_count / 4, "Grid interior should simplify");
+
+        // Border vertices are locked, so they stay in the base
+        int border_kept = 1;
+        for (uint32_t i = pm->base_vertex_count; i < pm->base_vertex_count + pm->split_count; i++) {
+            vec3_t p = pm->vertices[i].position;
+            border_kept &= p.x > 0.0f && p.x < 4.0f && p.z > 0.0f && p.z < 4.0f;
+        }
+        TEST_ASSERT(border_kept, "Border vertices should never be collapsed");
+        progressive_mesh_set_level(pm, pm->split_count);
+        TEST_ASSERT(same_triangles(&pm->mesh, grid), "Full grid level should reproduce the input");
+    }
+    progressive_mesh_destroy(pm);
+
+    // UV seam: duplicating the first column of sphere vertices for the
+    // last segment gives vertices that share positions
+    Mesh* sphere = make_sphere_mesh(1.0f, 16, 32);
+    Mesh* seamed = mesh_allocate(sphere->vertex_count + 15, sphere->index_count);
+    memcpy(seamed->vertices, sphere->vertices, sphere->vertex_count * sizeof(Vertex));
+    memcpy(seamed->indices, sphere->indices, sphere->index_count * sizeof(uint32_t));
+    for (uint32_t r = 1; r < 16; r++) {
+        uint32_t original = 2 + (r - 1) * 32;
+        seamed->vertices[sphere->vertex_count + r - 1] = sphere->vertices[original];
+        seamed->vertices[sphere->vertex_count + r - 1].texcoord.x = 1.0f;
+    }
+    for (uint32_t t = 0; t < seamed->triangle_count; t++) {
+        uint32_t* tri = seamed->indices + 3 * t;
+        int last_segment = 0;
+        for (int k = 0; k < 3; k++) last_segment |= tri[k] >= 2 && (tri[k] - 2) % 32 == 31;
+        for (int k = 0; k < 3 && last_segment; k++) {
+            if (tri[k] >= 2 && (tri[k] - 2) % 32 == 0) tri[k] = sphere->vertex_count + (tri[k] - 2) / 32;
+        }
+    }
+    pm = progressive_mesh_build(seamed, NULL);
+    TEST_ASSERT_NOT_NULL(pm, "Seamed sphere should build");
+    if (pm) {
+        int seams_in_base = 1;
+        for (uint32_t i = pm->base_vertex_count; i < pm->base_vertex_count + pm->split_count; i++) {
+            vec3_t p = pm->vertices[i].position;
+            seams_in_base &= !(fabsf(p.z) < 1.0e-6f && p.x > 0.0f);
+        }
+        TEST_ASSERT(seams_in_base, "Seam vertices should stay in the base so levels never crack");
+        progressive_mesh_set_level(pm, pm->split_count);
+        TEST_ASSERT(same_triangles(&pm->mesh, seamed), "Full seamed level should reproduce the input");
+    }
+    progressive_mesh_destroy(pm);
+    release_mesh(seamed);
+    release_mesh(sphere);
+
+    Mesh* split_grid = make_grid_mesh(16);
+    TEST_ASSERT(progressive_mesh_build(NULL, NULL) == NULL, "NULL meshes should be rejected");
+    split_grid->indices[5] = split_grid->vertex_count + 3;
+    TEST_ASSERT(progressive_mesh_build(split_grid, NULL) == NULL, "Out-of-range indices should be rejected");
+    release_mesh(split_grid);
+    release_mesh(grid);
+}
+
+// ============================================================================
+// PROGRESSIVE MODEL TESTS
+// ============================================================================
+
+static Model3D* make_test_model(void) {
+    Model3D* model = model3d_allocate(2);
+    Mesh* sphere = make_sphere_mesh(1.0f, 24, 48);
+    Mesh* grid = make_grid_mesh(24);
+    model->meshes[0] = *sphere;
+    model->meshes[1] = *grid;
+    free(sphere);
+    free(grid);
+    return model;
+}
+
+static void test_model_streaming(void) {
+    printf("\n--- Progressive Model Streaming Tests ---\n");
+
+    Model3D* source = make_test_model();
+    ProgressiveModel* built = progressive_model_build(source, NULL);
+    TEST_ASSERT_NOT_NULL(built, "Model should build");
+    if (!built) {
+        model3d_free(source);
+        free(source);
+        return;
+    }
+    TEST_ASSERT(progressive_model_save(built, MODEL_PATH), "Model should save");
+
+    ProgressiveModel* model = progressive_model_open(MODEL_PATH);
+    TEST_ASSERT_NOT_NULL(model, "Model should open");
+    if (model) {
+        int base_ready = 1;
+        for (uint32_t m = 0; m < model->mesh_count; m++) {
+            const ProgressiveMesh* pm = model->meshes[m];
+            base_ready &= pm->split_count == 0 && pm->mesh.triangle_count == built->meshes[m]->base_triangle_count &&
+                          memcmp(pm->mesh.indices, built->meshes[m]->source_indices, pm->mesh.index_count * sizeof(uint32_t)) == 0;
+        }
+        TEST_ASSERT(base_ready, "Opened model should be drawable at the base before streaming");
+
+        uint32_t streamed = progressive_model_stream(model, 100);
+        TEST_ASSERT_EQUAL(100u, streamed, "Streaming should read the requested splits");
+        TEST_ASSERT(model->meshes[0]->split_count > 0 && model->meshes[1]->split_count > 0,
+                    "Early splits should be shared between meshes by error");
+        uint32_t partial = progressive_model_set_triangle_budget(model, 1u << 30);
+        TEST_ASSERT(partial > model->meshes[0]->base_triangle_count + model->meshes[1]->base_triangle_count,
+                    "Streamed splits should refine the drawn model at once");
+        TEST_ASSERT(level_well_formed(model->meshes[0]) && level_well_formed(model->meshes[1]),
+                    "Partially streamed levels should be well formed");
+
+        while (progressive_model_stream(model, 64) > 0) {
+        }
+        TEST_ASSERT(model->stream == NULL && model->splits_remaining == 0, "Stream should close once every split is read");
+
+        int identical = 1;
+        for (uint32_t m = 0; m < model->mesh_count; m++) {
+            const ProgressiveMesh* a = model->meshes[m];
+            const ProgressiveMesh* b = built->meshes[m];
+            identical &= a->split_count == b->split_count && a->corner_count == b->corner_count &&
+                         memcmp(a->vertices, b->vertices, (a->base_vertex_count + a->split_count) * sizeof(Vertex)) == 0 &&
+                         memcmp(a->source_indices, b->source_indices, a->total_triangle_count * 3 * sizeof(uint32_t)) == 0;
+        }
+        TEST_ASSERT(identical, "Fully streamed model should match the built one");
+
+        uint32_t full = 0;
+        for (uint32_t m = 0; m < model->mesh_count; m++) full += model->meshes[m]->total_triangle_count;
+        uint32_t drawn = progressive_model_set_triangle_budget(model, full / 3);
+        TEST_ASSERT(drawn <= full / 3 && drawn > full / 4, "Budget should be filled closely without exceeding it");
+        TEST_ASSERT(model->meshes[0]->level > 0 && model->meshes[1]->level > 0, "Budget should be spread across meshes");
+        TEST_ASSERT_EQUAL(full, progressive_model_set_triangle_budget(model, full), "A full budget should draw every triangle");
+        TEST_ASSERT(same_triangles(&model->meshes[0]->mesh, &source->meshes[0]), "Full streamed sphere should match the source");
+        progressive_model_set_triangle_budget(model, 0);
+        TEST_ASSERT(model->meshes[0]->level == 0 && model->meshes[1]->level == 0, "A zero budget should coarsen to the bases");
+    }
+    progressive_model_destroy(model);
+
+    // Truncated file: the stream reports the damage and stops
+    FILE* in = fopen(MODEL_PATH, "rb");
+    FILE* out = fopen(CORRUPT_PATH, "wb");
+    if (in && out) {
+        fseek(in, 0, SEEK_END);
+        long size = ftell(in);
+        fseek(in, 0, SEEK_SET);
+        char* bytes = (char*)malloc((size_t)size);
+        size_t got = fread(bytes, 1, (size_t)size, in);
+        fwrite(bytes, 1, got * 3 / 4, out);
+        free(bytes);
+    }
+    if (in) fclose(in);
+    if (out) fclose(out);
+    ProgressiveModel* truncated = progressive_model_open(CORRUPT_PATH);
+    TEST_ASSERT_NOT_NULL(truncated, "A truncated file should still open its bases");
+    if (truncated) {
+        uint32_t total = 0, read;
+        while ((read = progressive_model_stream(truncated, 1000)) > 0) total += read;
+        TEST_ASSERT(total < built->meshes[0]->split_count + built->meshes[1]->split_count && truncated->stream == NULL,
+                    "Streaming a truncated file should stop cleanly");
+        progressive_model_set_triangle_budget(truncated, 1u << 30);
+        TEST_ASSERT(level_well_formed(truncated->meshes[0]) && level_well_formed(truncated->meshes[1]),
+                    "Levels of a truncated file should be well formed");
+    }
+    progressive_model_destroy(truncated);
+
+    // Mesh header whose base_triangle_count * 3 wraps to 2 in uint32. The
+    // first mesh header follows the 24-byte file header.
+    in = fopen(MODEL_PATH, "rb");
+    out = fopen(CORRUPT_PATH, "wb");
+    if (in && out) {
+        uint8_t bytes[256];
+        size_t got = fread(bytes, 1, sizeof(bytes), in);
+        uint32_t base_triangles = 0x55555556u, triangles = 0x60000000u;
+        memcpy(bytes + 24 + 4, &base_triangles, sizeof(uint32_t));
+        memcpy(bytes + 24 + 12, &triangles, sizeof(uint32_t));
+        fwrite(bytes, 1, got, out);
+    }
+    if (in) fclose(in);
+    if (out) fclose(out);
+    TEST_ASSERT(progressive_model_open(CORRUPT_PATH) == NULL, "Oversized mesh headers should be rejected");
+    TEST_ASSERT(progressive_model_open("/tmp/engine_progressive_mesh_missing.pmsh") == NULL, "Missing files should be rejected");
+
+    remove(MODEL_PATH);
+    remove(CORRUPT_PATH);
+    progressive_model_destroy(built);
+    model3d_free(source);
+    free(source);
+}
+
+static void test_assets(void) {
+    printf("\n--- Asset Tests ---\n");
+
+    const char* names[2] = { "UnitBox.fbx", "UnitSphere.fbx" };
+    for (uint32_t n = 0; n < 2; n++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", assets_dir, names[n]);
+        char* err = NULL;
+        Model3D* model = fbx_load_model(path, &err);
+        if (!model) {
+            printf("  %s unavailable: %s\n", names[n], err ? err : "(no error)");
+            fbx_free_error(err);
+            TEST_ASSERT(0, "Sample asset should load");
+            continue;
+        }
+
+        ProgressiveModel* pmodel = progressive_model_build(model, NULL);
+        TEST_ASSERT_NOT_NULL(pmodel, "Sample asset should build");
+        int ok = pmodel != NULL;
+        for (uint32_t m = 0; pmodel && m < pmodel->mesh_count; m++) {
+            ProgressiveMesh* pm = pmodel->meshes[m];
+            progressive_mesh_print(names[n], pm);
+            progressive_mesh_set_level(pm, pm->split_count);
+            ok &= level_well_formed(pm);
+        }
+        TEST_ASSERT(ok, "Sample asset levels should be well formed");
+        progressive_model_destroy(pmodel);
+        model3d_free(model);
+        free(model);
+    }
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    Mesh* sphere = make_sphere_mesh(1.0f, 256, 512);
+    double start = now_ms();
+    ProgressiveMesh* pm = progressive_mesh_build(sphere, NULL);
+    double build_ms = now_ms() - start;
+    TEST_ASSERT_NOT_NULL(pm, "Large sphere should build");
+    if (pm) {
+        start = now_ms();
+        progressive_mesh_set_level(pm, pm->split_count);
+        double refine_ms = now_ms() - start;
+        start = now_ms();
+        progressive_mesh_set_level(pm, 0);
+        double coarsen_ms = now_ms() - start;
+        printf("  %u triangles: build %.1f ms, %u splits, %u corners\n", sphere->triangle_count, build_ms,
+               pm->split_count, pm->corner_count);
+        printf("  Refine base -> full %.2f ms (%.1f ns/split), coarsen %.2f ms\n", refine_ms,
+               refine_ms * 1.0e6 / pm->split_count, coarsen_ms);
+        TEST_ASSERT(build_ms < 10000.0, "262k-triangle build should finish in seconds");
+        TEST_ASSERT(refine_ms < 100.0, "Applying every split of a 262k-triangle mesh should take under 100 ms");
+    }
+    progressive_mesh_destroy(pm);
+    release_mesh(sphere);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Progressive Mesh Unit Tests\n");
+    printf("===================================\n");
+
+    test_sphere_levels();
+    test_open_grid();
+    test_model_streaming();
+    test_assets();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,590 @@
+#include "engine_sdf_volume.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+
+#define SDF_BVH_LEAF_SIZE 4
+#define SDF_BVH_MAX_DEPTH 48
+#define SDF_BRICK_STORED 0u                     // Bake-time brick state: samples kept
+
+// ============================================================================
+// TRIANGLE BVH
+// ============================================================================
+
+// Interior nodes have count == 0 and children first, first + 1
+typedef struct {
+    vec3_t min;
+    vec3_t max;
+    uint32_t first;
+    uint32_t count;
+} SdfBvhNode;
+
+typedef struct {
+    SdfBvhNode* nodes;
+    uint32_t node_count;
+    vec3_t* triangles;          // Three corners per triangle, in leaf order
+    uint32_t triangle_count;
+} SdfBvh;
+
+typedef struct {
+    const vec3_t* source;       // Unordered corners
+    const vec3_t* centroids;
+    uint32_t* order;
+    SdfBvh* bvh;
+} SdfBvhBuilder;
+
+static vec3_t vec3_min3(vec3_t a, vec3_t b) {
+    return vec3(fminf(a.x, b.x), fminf(a.y, b.y), fminf(a.z, b.z));
+}
+
+static vec3_t vec3_max3(vec3_t a, vec3_t b) {
+    return vec3(fmaxf(a.x, b.x), fmaxf(a.y, b.y), fmaxf(a.z, b.z));
+}
+
+static float axis_value(vec3_t v, int axis) {
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+// Midpoint split on the widest centroid axis; falls back to halving the
+// range when every centroid lands on one side
+static void bvh_build_node(SdfBvhBuilder* builder, uint32_t node_index, uint32_t begin, uint32_t end, uint32_t depth) {
+    SdfBvh* bvh = builder->bvh;
+    SdfBvhNode* node = &bvh->nodes[node_index];
+    vec3_t lo = vec3(FLT_MAX, FLT_MAX, FLT_MAX), hi = vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    vec3_t centroid_lo = lo, centroid_hi = hi;
+    for (uint32_t i = begin; i < end; i++) {
+        uint32_t t = builder->order[i];
+        for (uint32_t k = 0; k < 3; k++) {
+            lo = vec3_min3(lo, builder->source[3 * t + k]);
+            hi = vec3_max3(hi, builder->source[3 * t + k]);
+        }
+        centroid_lo = vec3_min3(centroid_lo, builder->centroids[t]);
+        centroid_hi = vec3_max3(centroid_hi, builder->centroids[t]);
+    }
+    node->min = lo;
+    node->max = hi;
+
+    if (end - begin <= SDF_BVH_LEAF_SIZE || depth >= SDF_BVH_MAX_DEPTH) {
+        node->first = begin;
+        node->count = end - begin;
+        return;
+    }
+
+    vec3_t extent = vec3_sub(centroid_hi, centroid_lo);
+    int axis = extent.y > extent.x ? 1 : 0;
+    if (extent.z > axis_value(extent, axis)) axis = 2;
+    float split = 0.5f * (axis_value(centroid_lo, axis) + axis_value(centroid_hi, axis));
+    uint32_t mid = begin;
+    for (uint32_t i = begin; i < end; i++) {
+        if (axis_value(builder->centroids[builder->order[i]], axis) < split) {
+            uint32_t swap = builder->order[i];
+            builder->order[i] = builder->order[mid];
+            builder->order[mid++] = swap;
+        }
+    }
+    if (mid == begin || mid == end) {
+        mid = begin + (end - begin) / 2;
+    }
+
+    uint32_t left = bvh->node_count;
+    bvh->node_count += 2;
+    node->first = left;
+    node->count = 0;
+    bvh_build_node(builder, left, begin, mid, depth + 1);
+    bvh_build_node(builder, left + 1, mid, end, depth + 1);
+}
+
+static int bvh_build(SdfBvh* bvh, const vec3_t* corners, uint32_t triangle_count) {
+    memset(bvh, 0, sizeof(*bvh));
+    bvh->nodes = (SdfBvhNode*)malloc(2 * triangle_count * sizeof(SdfBvhNode));
+    bvh->triangles = (vec3_t*)malloc(3 * triangle_count * sizeof(vec3_t));
+    vec3_t* centroids = (vec3_t*)malloc(triangle_count * sizeof(vec3_t));
+    uint32_t* order = (uint32_t*)malloc(triangle_count * sizeof(uint32_t));
+    if (!bvh->nodes || !bvh->triangles || !centroids || !order) {
+        free(centroids);
+        free(order);
+        return 0;
+    }
+
+    for (uint32_t t = 0; t < triangle_count; t++) {
+        centroids[t] = vec3_scale(vec3_add(vec3_add(corners[3 * t], corners[3 * t + 1]), corners[3 * t + 2]), 1.0f / 3.0f);
+        order[t] = t;
+    }
+    SdfBvhBuilder builder = { corners, centroids, order, bvh };
+    bvh->node_count = 1;
+    bvh->triangle_count = triangle_count;
+    bvh_build_node(&builder, 0, 0, triangle_count, 0);
+    for (uint32_t i = 0; i < triangle_count; i++) {
+        memcpy(&bvh->triangles[3 * i], &corners[3 * order[i]], 3 * sizeof(vec3_t));
+    }
+    free(centroids);
+    free(order);
+    return 1;
+}
+
+static void bvh_free(SdfBvh* bvh) {
+    free(bvh->nodes);
+    free(bvh->triangles);
+}
+
+static float box_distance_sq(const SdfBvhNode* node, vec3_t p) {
+    float dx = fmaxf(fmaxf(node->min.x - p.x, p.x - node->max.x), 0.0f);
+    float dy = fmaxf(fmaxf(node->min.y - p.y, p.y - node->max.y), 0.0f);
+    float dz = fmaxf(fmaxf(node->min.z - p.z, p.z - node->max.z), 0.0f);
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// Closest point on triangle abc to p (Voronoi region walk)
+static vec3_t closest_point_on_triangle(vec3_t p, vec3_t a, vec3_t b, vec3_t c) {
+    vec3_t ab = vec3_sub(b, a), ac = vec3_sub(c, a), ap = vec3_sub(p, a);
+    float d1 = vec3_dot(ab, ap), d2 = vec3_dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) return a;
+
+    vec3_t bp = vec3_sub(p, b);
+    float d3 = vec3_dot(ab, bp), d4 = vec3_dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) return b;
+
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return vec3_add(a, vec3_scale(ab, d1 / (d1 - d3)));
+    }
+
+    vec3_t cp = vec3_sub(p, c);
+    float d5 = vec3_dot(ab, cp), d6 = vec3_dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) return c;
+
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return vec3_add(a, vec3_scale(ac, d2 / (d2 - d6)));
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return vec3_add(b, vec3_scale(vec3_sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+    }
+
+    float denom = 1.0f / (va + vb + vc);
+    return vec3_add(a, vec3_add(vec3_scale(ab, vb * denom), vec3_scale(ac, vc * denom)));
+}
+
+// Unsigned distance to the nearest triangle
+static float bvh_distance(const SdfBvh* bvh, vec3_t p) {
+    float best = FLT_MAX;
+    uint32_t stack[SDF_BVH_MAX_DEPTH + 2];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const SdfBvhNode* node = &bvh->nodes[stack[--top]];
+        if (box_distance_sq(node, p) >= best) continue;
+
+        if (node->count) {
+            for (uint32_t t = node->first; t < node->first + node->count; t++) {
+                const vec3_t* tri = &bvh->triangles[3 * t];
+                vec3_t q = vec3_sub(closest_point_on_triangle(p, tri[0], tri[1], tri[2]), p);
+                float d = vec3_dot(q, q);
+                if (d < best) best = d;
+            }
+        } else {
+            // Nearer child on top of the stack
+            float dl = box_distance_sq(&bvh->nodes[node->first], p);
+            float dr = box_distance_sq(&bvh->nodes[node->first + 1], p);
+            if (dl < dr) {
+                if (dr < best) stack[top++] = node->first + 1;
+                stack[top++] = node->first;
+            } else {
+                if (dl < best) stack[top++] = node->first;
+                stack[top++] = node->first + 1;
+            }
+        }
+    }
+    return sqrtf(best);
+}
+
+static int ray_hits_box(const SdfBvhNode* node, vec3_t origin, vec3_t inv_dir) {
+    float t0 = (node->min.x - origin.x) * inv_dir.x, t1 = (node->max.x - origin.x) * inv_dir.x;
+    float tmin = fminf(t0, t1), tmax = fmaxf(t0, t1);
+    t0 = (node->min.y - origin.y) * inv_dir.y;
+    t1 = (node->max.y - origin.y) * inv_dir.y;
+    tmin = fmaxf(tmin, fminf(t0, t1));
+    tmax = fminf(tmax, fmaxf(t0, t1));
+    t0 = (node->min.z - origin.z) * inv_dir.z;
+    t1 = (node->max.z - origin.z) * inv_dir.z;
+    tmin = fmaxf(tmin, fminf(t0, t1));
+    tmax = fminf(tmax, fmaxf(t0, t1));
+    return tmax >= fmaxf(tmin, 0.0f);
+}
+
+// Number of triangles a ray crosses (Moller-Trumbore, both facings)
+static uint32_t bvh_count_crossings(const SdfBvh* bvh, vec3_t origin, vec3_t dir) {
+    vec3_t inv_dir = vec3(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
+    uint32_t crossings = 0;
+    uint32_t stack[SDF_BVH_MAX_DEPTH + 2];
+    uint32_t top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+        const SdfBvhNode* node = &bvh->nodes[stack[--top]];
+        if (!ray_hits_box(node, origin, inv_dir)) continue;
+
+        if (!node->count) {
+            stack[top++] = node->first;
+            stack[top++] = node->first + 1;
+            continue;
+        }
+        for (uint32_t t = node->first; t < node->first + node->count; t++) {
+            const vec3_t* tri = &bvh->triangles[3 * t];
+            vec3_t e1 = vec3_sub(tri[1], tri[0]), e2 = vec3_sub(tri[2], tri[0]);
+            vec3_t pv = vec3_cross(dir, e2);
+            float det = vec3_dot(e1, pv);
+            if (fabsf(det) < 1.0e-12f) continue;
+            float inv_det = 1.0f / det;
+            vec3_t tv = vec3_sub(origin, tri[0]);
+            float u = vec3_dot(tv, pv) * inv_det;
+            if (u < 0.0f || u > 1.0f) continue;
+            vec3_t qv = vec3_cross(tv, e1);
+            float v = vec3_dot(dir, qv) * inv_det;
+            if (v < 0.0f || u + v > 1.0f) continue;
+            if (vec3_dot(e2, qv) * inv_det > 0.0f) crossings++;
+        }
+    }
+    return crossings;
+}
+
+// Ray parity along three skewed directions, majority vote: a ray grazing
+// a shared edge or vertex can miscount, two of three rarely do
+static int bvh_is_inside(const SdfBvh* bvh, vec3_t p) {
+    static const vec3_t directions[3] = {
+        { 0.9447f, 0.1294f, 0.3021f },
+        { -0.2063f, 0.9686f, 0.1386f },
+        { 0.1606f, -0.2887f, 0.9438f }
+    };
+    uint32_t odd = 0;
+    for (uint32_t i = 0; i < 3; i++) {
+        odd += bvh_count_crossings(bvh, p, directions[i]) & 1u;
+        if (odd == 2 || (i == 1 && odd == 0)) break;
+    }
+    return odd >= 2;
+}
+
+// ============================================================================
+// BAKING
+// ============================================================================
+
+typedef struct {
+    const SdfBvh* bvh;
+    const SdfVolume* volume;
+    uint8_t* samples;           // SDF_BRICK_SAMPLES per brick, every brick
+    uint32_t* states;           // SDF_BRICK_STORED or SDF_BRICK_OUTSIDE/INSIDE
+} SdfBakeJob;
+
+static uint8_t quantize_distance(float distance, float range) {
+    float n = distance / range;
+    n = n < -1.0f ? -1.0f : (n > 1.0f ? 1.0f : n);
+    return (uint8_t)lrintf((n * 0.5f + 0.5f) * 255.0f);
+}
+
+static void bake_bricks_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    SdfBakeJob* job = (SdfBakeJob*)user_data;
+    const SdfVolume* volume = job->volume;
+    const float voxel = volume->voxel_size;
+    const float brick_half_diagonal = 0.5f * voxel * (float)(SDF_BRICK_SIZE - 1) * 1.7320508f;
+    float distances[SDF_BRICK_SAMPLES];
+    uint8_t inside[SDF_BRICK_SAMPLES];
+
+    for (uint32_t b = begin; b < end; b++) {
+        uint32_t bx = b % volume->bricks[0];
+        uint32_t by = (b / volume->bricks[0]) % volume->bricks[1];
+        uint32_t bz = b / (volume->bricks[0] * volume->bricks[1]);
+        vec3_t corner = vec3_add(volume->origin, vec3_scale(vec3((float)bx, (float)by, (float)bz),
+                                                            voxel * (float)SDF_BRICK_SIZE));
+
+        // A brick whose centre is farther from the surface than its half
+        // diagonal plus the band saturates to one value
+        vec3_t center = vec3_add(corner, vec3_scale(vec3(1.0f, 1.0f, 1.0f), 0.5f * voxel * (float)(SDF_BRICK_SIZE - 1)));
+        float center_distance = bvh_distance(job->bvh, center);
+        if (center_distance - brick_half_diagonal > volume->range) {
+            job->states[b] = bvh_is_inside(job->bvh, center) ? SDF_BRICK_INSIDE : SDF_BRICK_OUTSIDE;
+            continue;
+        }
+
+        uint8_t* out = &job->samples[(size_t)b * SDF_BRICK_SAMPLES];
+        uint32_t saturated_outside = 0, saturated_inside = 0;
+        for (uint32_t z = 0; z < SDF_BRICK_SIZE; z++) {
+            for (uint32_t y = 0; y < SDF_BRICK_SIZE; y++) {
+                for (uint32_t x = 0; x < SDF_BRICK_SIZE; x++) {
+                    uint32_t i = (z * SDF_BRICK_SIZE + y) * SDF_BRICK_SIZE + x;
+                    vec3_t p = vec3_add(corner, vec3_scale(vec3((float)x, (float)y, (float)z), voxel));
+                    float d = bvh_distance(job->bvh, p);
+
+                    // A neighbour whose empty ball reaches this sample
+                    // shares its side of the surface; cast rays otherwise
+                    const float reach = voxel * 1.001f;
+                    if (x > 0 && distances[i - 1] > reach) {
+                        inside[i] = inside[i - 1];
+                    } else if (y > 0 && distances[i - SDF_BRICK_SIZE] > reach) {
+                        inside[i] = inside[i - SDF_BRICK_SIZE];
+                    } else if (z > 0 && distances[i - SDF_BRICK_SIZE * SDF_BRICK_SIZE] > reach) {
+                        inside[i] = inside[i - SDF_BRICK_SIZE * SDF_BRICK_SIZE];
+                    } else {
+                        inside[i] = (uint8_t)bvh_is_inside(job->bvh, p);
+                    }
+                    distances[i] = d;
+
+                    out[i] = quantize_distance(inside[i] ? -d : d, volume->range);
+                    saturated_outside += out[i] == 255;
+                    saturated_inside += out[i] == 0;
+                }
+            }
+        }
+        job->states[b] = saturated_outside == SDF_BRICK_SAMPLES ? SDF_BRICK_OUTSIDE :
+                         (saturated_inside == SDF_BRICK_SAMPLES ? SDF_BRICK_INSIDE : SDF_BRICK_STORED);
+    }
+}
+
+// ============================================================================
+// SDF VOLUME FUNCTIONS
+// ============================================================================
+
+SdfVolumeDesc sdf_volume_desc_default(void) {
+    SdfVolumeDesc desc;
+    desc.resolution = 64;
+    desc.padding = 0.1f;
+    desc.band_voxels = 4.0f;
+    return desc;
+}
+
+SdfVolume* sdf_volume_bake(const Model3D* model, const SdfVolumeDesc* desc, JobSystemHandle jobs) {
+    SdfVolumeDesc defaults = sdf_volume_desc_default();
+    if (!desc) desc = &defaults;
+    if (!model || !model->meshes || desc->resolution < SDF_BRICK_SIZE || desc->band_voxels <= 0.0f) {
+        fprintf(stderr, "Error: Invalid SDF volume bake parameters\n");
+        return NULL;
+    }
+
+    // Flatten every mesh into a triangle soup
+    uint32_t triangle_count = 0;
+    for (uint32_t m = 0; m < model->mesh_count; m++) {
+        triangle_count += model->meshes[m].index_count / 3;
+    }
+    vec3_t* corners = (vec3_t*)malloc((triangle_count ? triangle_count : 1) * 3 * sizeof(vec3_t));
+    if (!corners) {
+        fprintf(stderr, "Error: Failed to allocate memory for SDF volume\n");
+        return NULL;
+    }
+    uint32_t t = 0;
+    vec3_t lo = vec3(FLT_MAX, FLT_MAX, FLT_MAX), hi = vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (uint32_t m = 0; m < model->mesh_count; m++) {
+        const Mesh* mesh = &model->meshes[m];
+        for (uint32_t i = 0; i + 2 < mesh->index_count; i += 3) {
+            uint32_t a = mesh->indices[i], b = mesh->indices[i + 1], c = mesh->indices[i + 2];
+            if (a >= mesh->vertex_count || b >= mesh->vertex_count || c >= mesh->vertex_count) continue;
+            corners[3 * t] = mesh->vertices[a].position;
+            corners[3 * t + 1] = mesh->vertices[b].position;
+            corners[3 * t + 2] = mesh->vertices[c].position;
+            for (uint32_t k = 0; k < 3; k++) {
+                lo = vec3_min3(lo, corners[3 * t + k]);
+                hi = vec3_max3(hi, corners[3 * t + k]);
+            }
+            t++;
+        }
+    }
+    triangle_count = t;
+    if (triangle_count == 0) {
+        fprintf(stderr, "Error: SDF volume bake needs triangles\n");
+        free(corners);
+        return NULL;
+    }
+
+    SdfVolume* volume = (SdfVolume*)calloc(1, sizeof(SdfVolume));
+    SdfBvh bvh;
+    int ok = volume && bvh_build(&bvh, corners, triangle_count);
+    free(corners);
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for SDF volume\n");
+        if (volume) bvh_free(&bvh);
+        free(volume);
+        return NULL;
+    }
+
+    // Cubic voxels sized by the padded longest side; each axis gets the
+    // whole bricks it needs, centred on the mesh
+    vec3_t extent = vec3_sub(hi, lo);
+    float longest = fmaxf(extent.x, fmaxf(extent.y, extent.z));
+    if (longest <= 0.0f) longest = 1.0f;
+    uint32_t max_samples = (desc->resolution + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE * SDF_BRICK_SIZE;
+    float padded = longest * (1.0f + 2.0f * desc->padding);
+    volume->voxel_size = padded / (float)(max_samples - 1);
+    volume->range = desc->band_voxels * volume->voxel_size;
+    volume->triangle_count = triangle_count;
+    vec3_t center = vec3_scale(vec3_add(lo, hi), 0.5f);
+    float half_span[3];
+    for (int axis = 0; axis < 3; axis++) {
+        float needed = axis_value(extent, axis) + 2.0f * desc->padding * longest;
+        uint32_t samples = (uint32_t)ceilf(needed / volume->voxel_size) + 1;
+        samples = (samples + SDF_BRICK_SIZE - 1) / SDF_BRICK_SIZE * SDF_BRICK_SIZE;
+        if (samples > max_samples) samples = max_samples;
+        volume->dims[axis] = samples;
+        volume->bricks[axis] = samples / SDF_BRICK_SIZE;
+        half_span[axis] = 0.5f * volume->voxel_size * (float)(samples - 1);
+    }
+    volume->origin = vec3(center.x - half_span[0], center.y - half_span[1], center.z - half_span[2]);
+
+    uint32_t total_bricks = volume->bricks[0] * volume->bricks[1] * volume->bricks[2];
+    SdfBakeJob job;
+    job.bvh = &bvh;
+    job.volume = volume;
+    job.samples = (uint8_t*)malloc((size_t)total_bricks * SDF_BRICK_SAMPLES);
+    job.states = (uint32_t*)malloc(total_bricks * sizeof(uint32_t));
+    volume->brick_table = (uint32_t*)malloc(total_bricks * sizeof(uint32_t));
+    if (!job.samples || !job.states || !volume->brick_table) {
+        fprintf(stderr, "Error: Failed to allocate memory for SDF volume\n");
+        free(job.samples);
+        free(job.states);
+        bvh_free(&bvh);
+        sdf_volume_destroy(volume);
+        return NULL;
+    }
+
+    job_system_parallel_for(jobs, total_bricks, 1, bake_bricks_range, &job);
+    bvh_free(&bvh);
+
+    // Compact the stored bricks into the pool
+    for (uint32_t b = 0; b < total_bricks; b++) {
+        volume->brick_count += job.states[b] == SDF_BRICK_STORED;
+    }
+    volume->brick_pool = (uint8_t*)malloc((size_t)(volume->brick_count ? volume->brick_count : 1) * SDF_BRICK_SAMPLES);
+    if (!volume->brick_pool) {
+        fprintf(stderr, "Error: Failed to allocate memory for SDF volume bricks\n");
+        free(job.samples);
+        free(job.states);
+        sdf_volume_destroy(volume);
+        return NULL;
+    }
+    uint32_t stored = 0;
+    for (uint32_t b = 0; b < total_bricks; b++) {
+        if (job.states[b] != SDF_BRICK_STORED) {
+            volume->brick_table[b] = job.states[b];
+            continue;
+        }
+        memcpy(&volume->brick_pool[(size_t)stored * SDF_BRICK_SAMPLES],
+               &job.samples[(size_t)b * SDF_BRICK_SAMPLES], SDF_BRICK_SAMPLES);
+        volume->brick_table[b] = stored++;
+    }
+    free(job.samples);
+    free(job.states);
+
+    fprintf(stderr, "Baked SDF volume: %ux%ux%u samples, %u/%u bricks stored, %zu KB\n",
+            volume->dims[0], volume->dims[1], volume->dims[2], volume->brick_count, total_bricks,
+            sdf_volume_memory_size(volume) / 1024);
+    return volume;
+}
+
+void sdf_volume_destroy(SdfVolume* volume) {
+    if (!volume) {
+        return;
+    }
+    free(volume->brick_table);
+    free(volume->brick_pool);
+    free(volume);
+}
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+
+static float fetch_sample(const SdfVolume* volume, uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t brick = ((z / SDF_BRICK_SIZE) * volume->bricks[1] + y / SDF_BRICK_SIZE) * volume->bricks[0] +
+                     x / SDF_BRICK_SIZE;
+    uint32_t entry = volume->brick_table[brick];
+    if (entry == SDF_BRICK_OUTSIDE) return volume->range;
+    if (entry == SDF_BRICK_INSIDE) return -volume->range;
+    uint32_t local = ((z % SDF_BRICK_SIZE) * SDF_BRICK_SIZE + y % SDF_BRICK_SIZE) * SDF_BRICK_SIZE + x % SDF_BRICK_SIZE;
+    uint8_t q = volume->brick_pool[(size_t)entry * SDF_BRICK_SAMPLES + local];
+    return ((float)q * (2.0f / 255.0f) - 1.0f) * volume->range;
+}
+
+// Trilinear interpolation of the 8 samples around point (clamped into the
+// lattice); returns the extra distance from point to the clamped position
+static float sample_cell(const SdfVolume* volume, vec3_t point, float* out_distance, vec3_t* out_gradient) {
+    float g[3] = { (point.x - volume->origin.x) / volume->voxel_size,
+                   (point.y - volume->origin.y) / volume->voxel_size,
+                   (point.z - volume->origin.z) / volume->voxel_size };
+    uint32_t i0[3];
+    float f[3];
+    float outside_sq = 0.0f;
+    for (int axis = 0; axis < 3; axis++) {
+        float max_g = (float)(volume->dims[axis] - 1);
+        float clamped = g[axis] < 0.0f ? 0.0f : (g[axis] > max_g ? max_g : g[axis]);
+        float excess = (g[axis] - clamped) * volume->voxel_size;
+        outside_sq += excess * excess;
+        uint32_t cell = (uint32_t)clamped;
+        if (cell > volume->dims[axis] - 2) cell = volume->dims[axis] - 2;
+        i0[axis] = cell;
+        f[axis] = clamped - (float)cell;
+    }
+
+    float c[8];
+    for (uint32_t k = 0; k < 8; k++) {
+        c[k] = fetch_sample(volume, i0[0] + (k & 1), i0[1] + ((k >> 1) & 1), i0[2] + ((k >> 2) & 1));
+    }
+    float x00 = c[0] + (c[1] - c[0]) * f[0], x10 = c[2] + (c[3] - c[2]) * f[0];
+    float x01 = c[4] + (c[5] - c[4]) * f[0], x11 = c[6] + (c[7] - c[6]) * f[0];
+    float y0 = x00 + (x10 - x00) * f[1], y1 = x01 + (x11 - x01) * f[1];
+    *out_distance = y0 + (y1 - y0) * f[2];
+
+    if (out_gradient) {
+        float dx0 = (c[1] - c[0]) + ((c[3] - c[2]) - (c[1] - c[0])) * f[1];
+        float dx1 = (c[5] - c[4]) + ((c[7] - c[6]) - (c[5] - c[4])) * f[1];
+        *out_gradient = vec3(dx0 + (dx1 - dx0) * f[2], (x10 - x00) + ((x11 - x01) - (x10 - x00)) * f[2], y1 - y0);
+    }
+    return sqrtf(outside_sq);
+}
+
+float sdf_volume_sample(const SdfVolume* volume, vec3_t point) {
+    float distance;
+    float outside = sample_cell(volume, point, &distance, NULL);
+    return distance + outside;
+}
+
+float sdf_volume_sample_gradient(const SdfVolume* volume, vec3_t point, vec3_t* out_gradient) {
+    float distance;
+    vec3_t gradient;
+    float outside = sample_cell(volume, point, &distance, &gradient);
+    float length = vec3_length(gradient);
+    if (out_gradient) {
+        *out_gradient = length > 1.0e-12f ? vec3_scale(gradient, 1.0f / length) : vec3_zero();
+    }
+    return distance + outside;
+}
+
+void sdf_volume_get_bounds(const SdfVolume* volume, vec3_t* out_min, vec3_t* out_max) {
+    *out_min = volume->origin;
+    *out_max = vec3_add(volume->origin, vec3_scale(vec3((float)(volume->dims[0] - 1), (float)(volume->dims[1] - 1),
+                                                        (float)(volume->dims[2] - 1)), volume->voxel_size));
+}
+
+size_t sdf_volume_memory_size(const SdfVolume* volume) {
+    size_t total_bricks = (size_t)volume->bricks[0] * volume->bricks[1] * volume->bricks[2];
+    return total_bricks * sizeof(uint32_t) + (size_t)volume->brick_count * SDF_BRICK_SAMPLES;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void sdf_volume_print(const char* name, const SdfVolume* volume) {
+    if (!volume) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    uint32_t total_bricks = volume->bricks[0] * volume->bricks[1] * volume->bricks[2];
+    printf("%s: %ux%ux%u samples, voxel %.4f, range %.4f, %u triangles\n", name,
+           volume->dims[0], volume->dims[1], volume->dims[2], volume->voxel_size, volume->range,
+           volume->triangle_count);
+    printf("  Bricks: %u/%u stored (%.1f%%), %.1f KB (dense 8-bit: %.1f KB)\n", volume->brick_count, total_bricks,
+           100.0f * (float)volume->brick_count / (float)total_bricks, (double)sdf_volume_memory_size(volume) / 1024.0,
+           (double)total_bricks * SDF_BRICK_SAMPLES / 1024.0);
+}
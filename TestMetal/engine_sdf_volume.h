@@ -0,0 +1,91 @@
+#ifndef ENGINE_SDF_VOLUME_H
+#define ENGINE_SDF_VOLUME_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_model.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// SDF VOLUME CONFIGURATION
+// ============================================================================
+
+#define SDF_BRICK_SIZE 8                        // Samples per brick side
+#define SDF_BRICK_SAMPLES (SDF_BRICK_SIZE * SDF_BRICK_SIZE * SDF_BRICK_SIZE)
+#define SDF_BRICK_OUTSIDE 0xFFFFFFFFu           // Brick table: every sample is +range
+#define SDF_BRICK_INSIDE 0xFFFFFFFEu            // Brick table: every sample is -range
+
+// Bake parameters
+typedef struct {
+    uint32_t resolution;        // Samples along the longest axis (rounded up to whole bricks)
+    float padding;              // Margin around the mesh, as a fraction of its longest side
+    float band_voxels;          // Quantization range in voxels; distances saturate beyond it
+} SdfVolumeDesc;
+
+// ============================================================================
+// SDF VOLUME DATA STRUCTURES
+// ============================================================================
+
+// Sparse bricked signed distance grid. Samples sit on a regular lattice of
+// cubic voxels; bricks of SDF_BRICK_SIZE^3 samples that lie entirely
+// beyond the band are not stored, only tagged inside or outside. Stored
+// samples are 8-bit: q / 255 maps linearly onto [-range, range].
+typedef struct {
+    vec3_t origin;              // Position of sample (0, 0, 0)
+    float voxel_size;
+    float range;
+    uint32_t dims[3];           // Samples per axis (multiples of SDF_BRICK_SIZE)
+    uint32_t bricks[3];         // Bricks per axis
+    uint32_t* brick_table;      // Per brick (x fastest): pool index or SDF_BRICK_OUTSIDE/INSIDE
+    uint8_t* brick_pool;        // brick_count * SDF_BRICK_SAMPLES samples, x fastest within a brick
+    uint32_t brick_count;       // Stored bricks
+    uint32_t triangle_count;    // Triangles baked
+} SdfVolume;
+
+// ============================================================================
+// SDF VOLUME FUNCTIONS
+// ============================================================================
+
+// Default: 64 samples, 10% padding, 4-voxel band
+SdfVolumeDesc sdf_volume_desc_default(void);
+
+// Bake every mesh of a model. Distances come from a triangle BVH and signs
+// from ray parity (majority of three rays), so the mesh should be closed.
+// Bricks are baked in parallel; a NULL job system bakes serially.
+SdfVolume* sdf_volume_bake(const Model3D* model, const SdfVolumeDesc* desc, JobSystemHandle jobs);
+
+// Free a volume
+void sdf_volume_destroy(SdfVolume* volume);
+
+// Trilinear signed distance. Inside the band the error is about half a
+// voxel; beyond it the result saturates at +/-range. Outside the volume
+// the distance to its bounds is added.
+float sdf_volume_sample(const SdfVolume* volume, vec3_t point);
+
+// Distance and normalized gradient (analytic derivative of the trilinear
+// interpolation; zero where the field is flat, e.g. saturated)
+float sdf_volume_sample_gradient(const SdfVolume* volume, vec3_t point, vec3_t* out_gradient);
+
+// World-space bounds of the sample lattice
+void sdf_volume_get_bounds(const SdfVolume* volume, vec3_t* out_min, vec3_t* out_max);
+
+// Bytes held by the brick table and pool
+size_t sdf_volume_memory_size(const SdfVolume* volume);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print grid size, stored bricks and memory
+void sdf_volume_print(const char* name, const SdfVolume* volume);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SDF_VOLUME_H
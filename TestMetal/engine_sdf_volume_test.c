@@ -0,0 +1,416 @@
+#include "engine_sdf_volume.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* assets_dir = "assets";
+
+static uint32_t rng_state = 987654321u;
+
+static float random_float(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return (float)(rng_state >> 8) / 16777216.0f;
+}
+
+static vec3_t random_in_box(vec3_t lo, vec3_t hi) {
+    return vec3(lo.x + (hi.x - lo.x) * random_float(), lo.y + (hi.y - lo.y) * random_float(),
+                lo.z + (hi.z - lo.z) * random_float());
+}
+
+// ============================================================================
+// GENERATED MODELS
+// ============================================================================
+
+// Wrap one mesh in a model (the model takes over its arrays)
+static Model3D* model_from_mesh(Mesh* mesh) {
+    Model3D* model = model3d_allocate(1);
+    model->meshes[0] = *mesh;
+    free(mesh);
+    return model;
+}
+
+static void release_model(Model3D* model) {
+    model3d_free(model);
+    free(model);
+}
+
+static Model3D* make_sphere_model(float radius, uint32_t rings, uint32_t segments) {
+    Mesh* mesh = mesh_allocate((rings + 1) * (segments + 1), rings * segments * 6);
+    uint32_t v = 0, idx = 0;
+    for (uint32_t r = 0; r <= rings; r++) {
+        float phi = 3.14159265f * (float)r / (float)rings;
+        for (uint32_t s = 0; s <= segments; s++) {
+            float theta = 6.2831853f * (float)s / (float)segments;
+            mesh->vertices[v++] = vertex_create_components(radius * sinf(phi) * cosf(theta), radius * cosf(phi),
+                                                           radius * sinf(phi) * sinf(theta), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < segments; s++) {
+            uint32_t a = r * (segments + 1) + s, b = a + 1, c = a + segments + 1, d = c + 1;
+            uint32_t quad[6] = { a, b, d, a, d, c };
+            for (uint32_t k = 0; k < 6; k++) mesh->indices[idx++] = quad[k];
+        }
+    }
+    return model_from_mesh(mesh);
+}
+
+static Model3D* make_torus_model(float major, float minor, uint32_t rings, uint32_t sides) {
+    Mesh* mesh = mesh_allocate(rings * sides, rings * sides * 6);
+    for (uint32_t r = 0; r < rings; r++) {
+        float theta = 6.2831853f * (float)r / (float)rings;
+        for (uint32_t s = 0; s < sides; s++) {
+            float phi = 6.2831853f * (float)s / (float)sides;
+            float radial = major + minor * cosf(phi);
+            mesh->vertices[r * sides + s] = vertex_create_components(radial * cosf(theta), minor * sinf(phi),
+                                                                     radial * sinf(theta), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+    uint32_t idx = 0;
+    for (uint32_t r = 0; r < rings; r++) {
+        for (uint32_t s = 0; s < sides; s++) {
+            uint32_t a = r * sides + s, b = r * sides + (s + 1) % sides;
+            uint32_t c = ((r + 1) % rings) * sides + s, d = ((r + 1) % rings) * sides + (s + 1) % sides;
+            uint32_t quad[6] = { a, b, d, a, d, c };
+            for (uint32_t k = 0; k < 6; k++) mesh->indices[idx++] = quad[k];
+        }
+    }
+    return model_from_mesh(mesh);
+}
+
+// Axis-aligned box of 12 triangles
+static Model3D* make_box_model(vec3_t lo, vec3_t hi) {
+    Mesh* mesh = mesh_allocate(8, 36);
+    for (uint32_t i = 0; i < 8; i++) {
+        mesh->vertices[i] = vertex_create_components((i & 1) ? hi.x : lo.x, (i & 2) ? hi.y : lo.y, (i & 4) ? hi.z : lo.z,
+                                                     0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    static const uint32_t indices[36] = {
+        0, 2, 3, 0, 3, 1,   4, 5, 7, 4, 7, 6,   0, 1, 5, 0, 5, 4,
+        2, 6, 7, 2, 7, 3,   0, 4, 6, 0, 6, 2,   1, 3, 7, 1, 7, 5
+    };
+    memcpy(mesh->indices, indices, sizeof(indices));
+    return model_from_mesh(mesh);
+}
+
+static float box_distance(vec3_t p, vec3_t half) {
+    vec3_t q = vec3(fabsf(p.x) - half.x, fabsf(p.y) - half.y, fabsf(p.z) - half.z);
+    vec3_t outside = vec3(fmaxf(q.x, 0.0f), fmaxf(q.y, 0.0f), fmaxf(q.z, 0.0f));
+    return vec3_length(outside) + fminf(fmaxf(q.x, fmaxf(q.y, q.z)), 0.0f);
+}
+
+static float torus_distance(vec3_t p, float major, float minor) {
+    float ring = sqrtf(p.x * p.x + p.z * p.z) - major;
+    return sqrtf(ring * ring + p.y * p.y) - minor;
+}
+
+// ============================================================================
+// SDF VOLUME TESTS
+// ============================================================================
+
+static void test_sphere_volume(void) {
+    printf("\n--- Sphere Volume Tests ---\n");
+
+    Model3D* sphere = make_sphere_model(1.0f, 48, 96);
+    SdfVolume* volume = sdf_volume_bake(sphere, NULL, NULL);
+    TEST_ASSERT_NOT_NULL(volume, "Sphere volume should bake");
+    if (!volume) {
+        release_model(sphere);
+        return;
+    }
+    sdf_volume_print("Sphere SDF", volume);
+
+    uint32_t total_bricks = volume->bricks[0] * volume->bricks[1] * volume->bricks[2];
+    TEST_ASSERT(volume->dims[0] == 64 && volume->dims[1] == 64 && volume->dims[2] == 64,
+                "A cubic mesh should get the full resolution on every axis");
+    TEST_ASSERT(volume->brick_count > 0 && volume->brick_count < total_bricks * 3 / 4,
+                "Only bricks near the surface should be stored");
+
+    float worst_error = 0.0f, worst_gradient = 1.0f;
+    int signs_ok = 1;
+    for (uint32_t i = 0; i < 4000; i++) {
+        vec3_t p = random_in_box(vec3(-1.2f, -1.2f, -1.2f), vec3(1.2f, 1.2f, 1.2f));
+        float exact = vec3_length(p) - 1.0f;
+        vec3_t gradient;
+        float d = sdf_volume_sample_gradient(volume, p, &gradient);
+        if (fabsf(exact) < 0.75f * volume->range) {
+            worst_error = fmaxf(worst_error, fabsf(d - exact));
+            if (fabsf(exact) < 0.5f * volume->range && vec3_length(p) > 0.0f) {
+                worst_gradient = fminf(worst_gradient, vec3_dot(gradient, vec3_normalize(p)));
+            }
+        }
+        if (fabsf(exact) > volume->voxel_size && (d < 0.0f) != (exact < 0.0f)) signs_ok = 0;
+    }
+    printf("  Band error %.4f (voxel %.4f), worst gradient alignment %.4f\n", worst_error, volume->voxel_size, worst_gradient);
+    TEST_ASSERT(worst_error < 0.5f * volume->voxel_size, "Distances in the band should be within half a voxel");
+    TEST_ASSERT(worst_gradient > 0.98f, "Gradients near the surface should point along the normal");
+    TEST_ASSERT(signs_ok, "Signs should be correct away from the surface");
+    TEST_ASSERT(fabsf(sdf_volume_sample(volume, vec3_zero()) + volume->range) < 1.0e-5f,
+                "Deep inside should saturate at -range");
+    TEST_ASSERT(sdf_volume_sample(volume, vec3(5.0f, 0.0f, 0.0f)) > 3.5f,
+                "Outside the volume the distance to its bounds should be added");
+
+    vec3_t lo, hi;
+    sdf_volume_get_bounds(volume, &lo, &hi);
+    TEST_ASSERT(lo.x < -1.1f && hi.x > 1.1f, "Volume bounds should include the padding");
+
+    sdf_volume_destroy(volume);
+    release_model(sphere);
+}
+
+static void test_box_and_torus_volumes(void) {
+    printf("\n--- Box And Torus Volume Tests ---\n");
+
+    Model3D* box = make_box_model(vec3(-1.0f, -0.5f, -0.25f), vec3(1.0f, 0.5f, 0.25f));
+    SdfVolumeDesc desc = sdf_volume_desc_default();
+    SdfVolume* volume = sdf_volume_bake(box, &desc, NULL);
+    TEST_ASSERT_NOT_NULL(volume, "Box volume should bake");
+    if (volume) {
+        TEST_ASSERT(volume->dims[0] == 64 && volume->dims[1] < 64 && volume->dims[2] < volume->dims[1],
+                    "Short axes should use fewer bricks");
+        float worst = 0.0f;
+        for (uint32_t i = 0; i < 4000; i++) {
+            vec3_t p = random_in_box(vec3(-1.1f, -0.6f, -0.35f), vec3(1.1f, 0.6f, 0.35f));
+            float exact = box_distance(p, vec3(1.0f, 0.5f, 0.25f));
+            if (fabsf(exact) < 0.75f * volume->range) {
+                worst = fmaxf(worst, fabsf(sdf_volume_sample(volume, p) - exact));
+            }
+        }
+        printf("  Box band error %.4f (voxel %.4f)\n", worst, volume->voxel_size);
+        TEST_ASSERT(worst < 0.5f * volume->voxel_size, "Box distances should match the analytic box");
+
+        vec3_t gradient;
+        sdf_volume_sample_gradient(volume, vec3(1.02f, 0.1f, -0.05f), &gradient);
+        TEST_ASSERT(gradient.x > 0.99f, "Box face gradient should be the face normal");
+        sdf_volume_sample_gradient(volume, vec3(0.0f, -0.51f, 0.03f), &gradient);
+        TEST_ASSERT(gradient.y < -0.99f, "Bottom face gradient should point down");
+    }
+    sdf_volume_destroy(volume);
+    release_model(box);
+
+    Model3D* torus = make_torus_model(2.0f, 0.5f, 96, 48);
+    volume = sdf_volume_bake(torus, &desc, NULL);
+    TEST_ASSERT_NOT_NULL(volume, "Torus volume should bake");
+    if (volume) {
+        TEST_ASSERT(sdf_volume_sample(volume, vec3_zero()) > 0.0f, "The torus hole should be outside");
+        TEST_ASSERT(sdf_volume_sample(volume, vec3(2.0f, 0.0f, 0.0f)) < 0.0f &&
+                    sdf_volume_sample(volume, vec3(0.0f, 0.1f, -2.1f)) < 0.0f, "The tube should be inside");
+        float worst = 0.0f;
+        int signs_ok = 1;
+        for (uint32_t i = 0; i < 4000; i++) {
+            vec3_t p = random_in_box(vec3(-2.6f, -0.6f, -2.6f), vec3(2.6f, 0.6f, 2.6f));
+            float exact = torus_distance(p, 2.0f, 0.5f);
+            float d = sdf_volume_sample(volume, p);
+            if (fabsf(exact) < 0.75f * volume->range) worst = fmaxf(worst, fabsf(d - exact));
+            if (fabsf(exact) > volume->voxel_size && (d < 0.0f) != (exact < 0.0f)) signs_ok = 0;
+        }
+        printf("  Torus band error %.4f (voxel %.4f)\n", worst, volume->voxel_size);
+        TEST_ASSERT(worst < 0.6f * volume->voxel_size, "Torus distances should match the analytic torus");
+        TEST_ASSERT(signs_ok, "Ray parity should resolve the torus inside and outside");
+    }
+    sdf_volume_destroy(volume);
+    release_model(torus);
+}
+
+static void test_threaded_bake(void) {
+    printf("\n--- Threaded Bake Tests ---\n");
+
+    Model3D* torus = make_torus_model(2.0f, 0.5f, 64, 32);
+    SdfVolume* serial = sdf_volume_bake(torus, NULL, NULL);
+    JobSystemHandle jobs = job_system_create(4);
+    SdfVolume* threaded = sdf_volume_bake(torus, NULL, jobs);
+    TEST_ASSERT(serial && threaded, "Serial and threaded bakes should succeed");
+    if (serial && threaded) {
+        uint32_t total_bricks = serial->bricks[0] * serial->bricks[1] * serial->bricks[2];
+        TEST_ASSERT(serial->brick_count == threaded->brick_count &&
+                    memcmp(serial->brick_table, threaded->brick_table, total_bricks * sizeof(uint32_t)) == 0 &&
+                    memcmp(serial->brick_pool, threaded->brick_pool, (size_t)serial->brick_count * SDF_BRICK_SAMPLES) == 0,
+                    "Threaded bakes should be identical to serial bakes");
+    }
+    sdf_volume_destroy(serial);
+    sdf_volume_destroy(threaded);
+    job_system_destroy(jobs);
+    release_model(torus);
+}
+
+static void test_invalid_input(void) {
+    printf("\n--- Invalid Input Tests ---\n");
+
+    TEST_ASSERT(sdf_volume_bake(NULL, NULL, NULL) == NULL, "NULL models should be rejected");
+
+    Model3D* box = make_box_model(vec3(-1.0f, -1.0f, -1.0f), vec3(1.0f, 1.0f, 1.0f));
+    SdfVolumeDesc desc = sdf_volume_desc_default();
+    desc.resolution = 4;
+    TEST_ASSERT(sdf_volume_bake(box, &desc, NULL) == NULL, "Resolutions below one brick should be rejected");
+    box->meshes[0].index_count = 0;
+    TEST_ASSERT(sdf_volume_bake(box, NULL, NULL) == NULL, "Models without triangles should be rejected");
+    release_model(box);
+}
+
+static void test_asset_volumes(void) {
+    printf("\n--- Asset Volume Tests ---\n");
+
+    const char* names[2] = { "UnitBox.fbx", "UnitSphere.fbx" };
+    for (uint32_t n = 0; n < 2; n++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s", assets_dir, names[n]);
+        char* err = NULL;
+        Model3D* model = fbx_load_model(path, &err);
+        if (!model) {
+            printf("  %s unavailable: %s\n", names[n], err ? err : "(no error)");
+            fbx_free_error(err);
+            TEST_ASSERT(0, "Sample asset should load");
+            continue;
+        }
+
+        SdfVolume* volume = sdf_volume_bake(model, NULL, NULL);
+        TEST_ASSERT_NOT_NULL(volume, "Sample asset should bake");
+        if (volume) {
+            sdf_volume_print(names[n], volume);
+            TEST_ASSERT(sdf_volume_sample(volume, vec3_zero()) < 0.0f && sdf_volume_sample(volume, vec3(0.9f, 0.9f, 0.9f)) > 0.0f,
+                        "Asset centre should be inside and its corner region outside");
+            // Both assets span [-0.5, 0.5] (box) or radius 1 (sphere)
+            vec3_t probe = n == 0 ? vec3(0.55f, 0.1f, 0.2f) : vec3(0.0f, 1.05f, 0.0f);
+            float expected = 0.05f;
+            TEST_ASSERT(fabsf(sdf_volume_sample(volume, probe) - expected) < volume->voxel_size,
+                        "Asset distances should be accurate near the surface");
+        }
+        sdf_volume_destroy(volume);
+        model3d_free(model);
+        free(model);
+    }
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    JobSystemHandle jobs = job_system_create(0);
+    printf("  %u worker(s)\n", job_system_get_worker_count(jobs));
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", assets_dir, "UnitSphere.fbx");
+    char* err = NULL;
+    Model3D* asset = fbx_load_model(path, &err);
+    fbx_free_error(err);
+    if (asset) {
+        double start = now_ms();
+        SdfVolume* volume = sdf_volume_bake(asset, NULL, jobs);
+        printf("  UnitSphere.fbx 64^3 bake: %.2f ms\n", now_ms() - start);
+        sdf_volume_destroy(volume);
+        model3d_free(asset);
+        free(asset);
+    }
+
+    Model3D* torus = make_torus_model(2.0f, 0.5f, 256, 128);
+    SdfVolumeDesc desc = sdf_volume_desc_default();
+    double bake_64_ms = 0.0;
+    SdfVolume* volume = NULL;
+    uint32_t resolutions[2] = { 64, 128 };
+    for (uint32_t r = 0; r < 2; r++) {
+        desc.resolution = resolutions[r];
+        double start = now_ms();
+        SdfVolume* serial = sdf_volume_bake(torus, &desc, NULL);
+        double serial_ms = now_ms() - start;
+        start = now_ms();
+        SdfVolume* threaded = sdf_volume_bake(torus, &desc, jobs);
+        double threaded_ms = now_ms() - start;
+        printf("  Torus %u triangles %u^3: serial %.2f ms, threaded %.2f ms, %u bricks, %.1f KB\n",
+               torus->meshes[0].index_count / 3, desc.resolution, serial_ms, threaded_ms,
+               threaded ? threaded->brick_count : 0, threaded ? (double)sdf_volume_memory_size(threaded) / 1024.0 : 0.0);
+        if (r == 0) {
+            bake_64_ms = threaded_ms;
+            volume = threaded;
+        } else {
+            sdf_volume_destroy(threaded);
+        }
+        sdf_volume_destroy(serial);
+    }
+
+    const uint32_t query_count = 1000000;
+    vec3_t* points = (vec3_t*)malloc(query_count * sizeof(vec3_t));
+    for (uint32_t i = 0; i < query_count; i++) points[i] = random_in_box(vec3(-2.7f, -0.7f, -2.7f), vec3(2.7f, 0.7f, 2.7f));
+    float checksum = 0.0f;
+    double start = now_ms();
+    for (uint32_t i = 0; volume && i < query_count; i++) checksum += sdf_volume_sample(volume, points[i]);
+    double sample_ms = now_ms() - start;
+    start = now_ms();
+    vec3_t gradient;
+    for (uint32_t i = 0; volume && i < query_count; i++) {
+        checksum += sdf_volume_sample_gradient(volume, points[i], &gradient);
+        checksum += gradient.x;
+    }
+    double gradient_ms = now_ms() - start;
+    printf("  1M queries: distance %.1f ns, distance + gradient %.1f ns (checksum %.1f)\n",
+           sample_ms * 1.0e6 / query_count, gradient_ms * 1.0e6 / query_count, checksum);
+
+    TEST_ASSERT(volume && bake_64_ms < 5000.0, "64^3 bake of a 65k-triangle torus should finish in seconds");
+    TEST_ASSERT(sample_ms * 1.0e6 / query_count < 500.0, "Distance queries should take well under a microsecond");
+
+    free(points);
+    sdf_volume_destroy(volume);
+    release_model(torus);
+    job_system_destroy(jobs);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting SDF Volume Unit Tests\n");
+    printf("===================================\n");
+
+    test_sphere_volume();
+    test_box_and_torus_volumes();
+    test_threaded_bake();
+    test_invalid_input();
+    test_asset_volumes();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
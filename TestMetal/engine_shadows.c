@@ -0,0 +1,327 @@
+#include "engine_shadows.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// SOA FIELD TABLE
+// ============================================================================
+
+// Caster world-space box as center and half extent
+#define SHADOW_CASTER_FIELDS(X) \
+    X(center_x) X(center_y) X(center_z) \
+    X(extent_x) X(extent_y) X(extent_z)
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+// Row-vector transform (p' = p * M)
+FORCE_INLINE vec3_t transform_point(mat4_t m, vec3_t p) {
+    return vec3(p.x * m.x.x + p.y * m.y.x + p.z * m.z.x + m.w.x,
+                p.x * m.x.y + p.y * m.y.y + p.z * m.z.y + m.w.y,
+                p.x * m.x.z + p.y * m.y.z + p.z * m.z.z + m.w.z);
+}
+
+FORCE_INLINE simd4f_t simd4f_abs(simd4f_t v) {
+    return simd4f_max(v, -v);
+}
+
+// Radii are rounded up to 1/16 unit so float noise in the corner fit does
+// not change the projection scale from frame to frame
+#define SHADOW_RADIUS_QUANTUM 16.0f
+
+// ============================================================================
+// SHADOW FUNCTIONS
+// ============================================================================
+
+ShadowCascadeDesc shadow_cascade_desc_default(void) {
+    ShadowCascadeDesc desc;
+    desc.cascade_count = 4;
+    desc.resolution = 2048;
+    desc.split_lambda = 0.75f;
+    desc.max_distance = 100.0f;
+    return desc;
+}
+
+ShadowCascades* shadow_cascades_create(const ShadowCascadeDesc* desc, uint32_t max_casters) {
+    if (!desc || desc->cascade_count == 0 || desc->cascade_count > SHADOW_MAX_CASCADES) {
+        fprintf(stderr, "Error: Shadow cascades support 1 to %d cascades\n", SHADOW_MAX_CASCADES);
+        return NULL;
+    }
+    if (desc->resolution == 0 || max_casters == 0) {
+        fprintf(stderr, "Error: Cannot create shadow cascades with 0 resolution or casters\n");
+        return NULL;
+    }
+
+    ShadowCascades* shadows = (ShadowCascades*)calloc(1, sizeof(ShadowCascades));
+    if (!shadows) {
+        fprintf(stderr, "Error: Failed to allocate memory for shadow cascades\n");
+        return NULL;
+    }
+
+    shadows->desc = *desc;
+    shadows->caster_capacity = max_casters;
+    shadows->light_direction = vec3(0.0f, -1.0f, 0.0f);
+
+    // Padded to a multiple of four for 4-wide loads
+    uint32_t slots = (max_casters + 3u) & ~3u;
+    int ok = 1;
+#define SHADOW_ALLOC_FIELD(name) \
+    shadows->name = (float*)calloc(slots, sizeof(float)); ok = ok && shadows->name;
+    SHADOW_CASTER_FIELDS(SHADOW_ALLOC_FIELD)
+#undef SHADOW_ALLOC_FIELD
+    shadows->caster_ids = (uint32_t*)calloc(slots, sizeof(uint32_t));
+    ok = ok && shadows->caster_ids;
+    for (uint32_t c = 0; c < desc->cascade_count; c++) {
+        shadows->cascades[c].casters = (uint32_t*)malloc(max_casters * sizeof(uint32_t));
+        shadows->cascades[c].view = mat4_identity();
+        shadows->cascades[c].projection = mat4_identity();
+        shadows->cascades[c].view_projection = mat4_identity();
+        ok = ok && shadows->cascades[c].casters;
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to allocate memory for shadow casters\n");
+        shadow_cascades_destroy(shadows);
+        return NULL;
+    }
+
+    fprintf(stderr, "Created shadow cascades: %u x %u texels, %u casters\n",
+            desc->cascade_count, desc->resolution, max_casters);
+    return shadows;
+}
+
+void shadow_cascades_destroy(ShadowCascades* shadows) {
+    if (!shadows) {
+        return;
+    }
+
+#define SHADOW_FREE_FIELD(name) free(shadows->name);
+    SHADOW_CASTER_FIELDS(SHADOW_FREE_FIELD)
+#undef SHADOW_FREE_FIELD
+    free(shadows->caster_ids);
+    for (uint32_t c = 0; c < SHADOW_MAX_CASCADES; c++) {
+        free(shadows->cascades[c].casters);
+    }
+    free(shadows);
+}
+
+void shadow_compute_splits(float near_plane, float far_plane, uint32_t count, float lambda, float* out_splits) {
+    if (!out_splits || count == 0) {
+        return;
+    }
+    for (uint32_t i = 0; i <= count; i++) {
+        float t = (float)i / (float)count;
+        float log_split = near_plane * powf(far_plane / near_plane, t);
+        float linear_split = near_plane + (far_plane - near_plane) * t;
+        out_splits[i] = lambda * log_split + (1.0f - lambda) * linear_split;
+    }
+    out_splits[0] = near_plane;
+    out_splits[count] = far_plane;
+}
+
+void shadow_cascades_fit(ShadowCascades* shadows, mat4_t camera_view, float fov_y, float aspect,
+                         float near_plane, float far_plane, vec3_t light_direction) {
+    if (!shadows) {
+        return;
+    }
+
+    const ShadowCascadeDesc* desc = &shadows->desc;
+    float shadow_far = fminf(far_plane, desc->max_distance);
+    if (shadow_far <= near_plane) {
+        shadow_far = far_plane;
+    }
+    float splits[SHADOW_MAX_CASCADES + 1];
+    shadow_compute_splits(near_plane, shadow_far, desc->cascade_count, desc->split_lambda, splits);
+
+    shadows->light_direction = vec3_normalize(light_direction);
+    vec3_t up = fabsf(shadows->light_direction.y) > 0.99f ? vec3_unit_z() : vec3_unit_y();
+    // Light rotation only: depends on the light, never on the camera
+    mat4_t light_rotation = mat4_look_at(vec3_zero(), shadows->light_direction, up);
+
+    mat4_t camera_to_world = mat4_inverse(camera_view);
+    float tan_y = tanf(fov_y * 0.5f);
+    float tan_x = tan_y * aspect;
+
+    for (uint32_t c = 0; c < desc->cascade_count; c++) {
+        ShadowCascade* cascade = &shadows->cascades[c];
+        cascade->split_near = splits[c];
+        cascade->split_far = splits[c + 1];
+
+        // Slice corners in world space
+        vec3_t corners[8];
+        vec3_t center = vec3_zero();
+        for (uint32_t k = 0; k < 8; k++) {
+            float depth = (k & 4) ? cascade->split_far : cascade->split_near;
+            float x = (k & 1) ? depth * tan_x : -depth * tan_x;
+            float y = (k & 2) ? depth * tan_y : -depth * tan_y;
+            corners[k] = transform_point(camera_to_world, vec3(x, y, -depth));
+            center = vec3_add(center, corners[k]);
+        }
+        center = vec3_scale(center, 1.0f / 8.0f);
+
+        // The corners move rigidly with the camera, so the sphere radius
+        // only depends on the split distances and field of view
+        float radius = 0.0f;
+        for (uint32_t k = 0; k < 8; k++) {
+            radius = fmaxf(radius, vec3_distance(center, corners[k]));
+        }
+        radius = ceilf(radius * SHADOW_RADIUS_QUANTUM) / SHADOW_RADIUS_QUANTUM;
+
+        // Snap the center to whole texels in light space so static
+        // geometry rasterizes identically as the camera moves
+        float texel = 2.0f * radius / (float)desc->resolution;
+        vec3_t light_center = transform_point(light_rotation, center);
+        float snapped_x = floorf(light_center.x / texel) * texel;
+        float snapped_y = floorf(light_center.y / texel) * texel;
+
+        // Eye one radius behind the center: receivers span depth [0, 2r]
+        cascade->view = light_rotation;
+        cascade->view.w = vec4(-snapped_x, -snapped_y, -(light_center.z + radius), 1.0f);
+        cascade->center = center;
+        cascade->radius = radius;
+        cascade->texel_size = texel;
+        cascade->caster_near = 0.0f;
+        cascade->projection = mat4_ortho(-radius, radius, -radius, radius, 0.0f, 2.0f * radius);
+        cascade->view_projection = mat4_mul_mat4(cascade->view, cascade->projection);
+        cascade->caster_count = 0;
+    }
+}
+
+void shadow_cascades_clear_casters(ShadowCascades* shadows) {
+    if (shadows) {
+        shadows->caster_count = 0;
+    }
+}
+
+int shadow_cascades_add_caster(ShadowCascades* shadows, uint32_t id, vec3_t bounds_min, vec3_t bounds_max) {
+    if (!shadows) {
+        return 0;
+    }
+    if (shadows->caster_count >= shadows->caster_capacity) {
+        fprintf(stderr, "Error: Shadow caster capacity reached (%u)\n", shadows->caster_capacity);
+        return 0;
+    }
+
+    uint32_t i = shadows->caster_count++;
+    shadows->center_x[i] = 0.5f * (bounds_min.x + bounds_max.x);
+    shadows->center_y[i] = 0.5f * (bounds_min.y + bounds_max.y);
+    shadows->center_z[i] = 0.5f * (bounds_min.z + bounds_max.z);
+    shadows->extent_x[i] = 0.5f * (bounds_max.x - bounds_min.x);
+    shadows->extent_y[i] = 0.5f * (bounds_max.y - bounds_min.y);
+    shadows->extent_z[i] = 0.5f * (bounds_max.z - bounds_min.z);
+    shadows->caster_ids[i] = id;
+    return 1;
+}
+
+void shadow_cascades_gather_world(ShadowCascades* shadows, const World* world) {
+    if (!shadows) {
+        return;
+    }
+    shadows->caster_count = 0;
+    if (!world) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < world->max_entities; i++) {
+        const WorldEntity* entity = &world->entities[i];
+        if (entity->id == 0 || !entity->is_active) {
+            continue;
+        }
+        vec3_t bounds_min, bounds_max;
+        entity_get_world_bounds(entity, &bounds_min, &bounds_max);
+        if (!shadow_cascades_add_caster(shadows, entity->id, bounds_min, bounds_max)) {
+            break;
+        }
+    }
+}
+
+// ============================================================================
+// CULLING
+// ============================================================================
+
+// Test every caster against one cascade's light volume, four at a time.
+// Casters only need to overlap the volume sideways and not lie entirely
+// beyond the receivers; anything between the light and the receivers casts,
+// so the near plane is pulled back to the nearest accepted caster.
+static void cull_cascade(ShadowCascades* shadows, ShadowCascade* cascade) {
+    mat4_t v = cascade->view;
+    simd4f_t r = simd4f_splat(cascade->radius);
+    simd4f_t far_depth = simd4f_splat(2.0f * cascade->radius);
+    const simd4i_t lane_index = {0, 1, 2, 3};
+    simd4f_t nearest = simd4f_splat(0.0f);
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < shadows->caster_count; i += 4) {
+        simd4f_t cx = simd4f_load(shadows->center_x + i);
+        simd4f_t cy = simd4f_load(shadows->center_y + i);
+        simd4f_t cz = simd4f_load(shadows->center_z + i);
+        simd4f_t ex = simd4f_load(shadows->extent_x + i);
+        simd4f_t ey = simd4f_load(shadows->extent_y + i);
+        simd4f_t ez = simd4f_load(shadows->extent_z + i);
+
+        // Box center and half extent in light space
+        simd4f_t lx = cx * v.x.x + cy * v.y.x + cz * v.z.x + v.w.x;
+        simd4f_t ly = cx * v.x.y + cy * v.y.y + cz * v.z.y + v.w.y;
+        simd4f_t lz = cx * v.x.z + cy * v.y.z + cz * v.z.z + v.w.z;
+        simd4f_t lex = ex * fabsf(v.x.x) + ey * fabsf(v.y.x) + ez * fabsf(v.z.x);
+        simd4f_t ley = ex * fabsf(v.x.y) + ey * fabsf(v.y.y) + ez * fabsf(v.z.y);
+        simd4f_t lez = ex * fabsf(v.x.z) + ey * fabsf(v.y.z) + ez * fabsf(v.z.z);
+
+        // Light looks down -Z: depth = -z
+        simd4f_t depth_min = -lz - lez;
+        simd4i_t hit = (simd4f_abs(lx) - lex <= r) & (simd4f_abs(ly) - ley <= r) & (depth_min <= far_depth);
+        hit &= lane_index < (simd4i_t){0, 0, 0, 0} + (int32_t)(shadows->caster_count - i);
+        nearest = simd4f_select(hit, simd4f_min(nearest, depth_min), nearest);
+
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            if (hit[lane]) {
+                cascade->casters[count++] = shadows->caster_ids[i + lane];
+            }
+        }
+    }
+
+    float caster_near = fminf(fminf(nearest[0], nearest[1]), fminf(nearest[2], nearest[3]));
+    cascade->caster_count = count;
+    cascade->caster_near = caster_near;
+    cascade->projection = mat4_ortho(-cascade->radius, cascade->radius, -cascade->radius, cascade->radius,
+                                     caster_near, 2.0f * cascade->radius);
+    cascade->view_projection = mat4_mul_mat4(cascade->view, cascade->projection);
+}
+
+static void cull_cascades_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    ShadowCascades* shadows = (ShadowCascades*)user_data;
+    for (uint32_t c = begin; c < end; c++) {
+        cull_cascade(shadows, &shadows->cascades[c]);
+    }
+}
+
+void shadow_cascades_cull(ShadowCascades* shadows, JobSystemHandle jobs) {
+    if (!shadows) {
+        return;
+    }
+    job_system_parallel_for(jobs, shadows->desc.cascade_count, 1, cull_cascades_range, shadows);
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void shadow_cascades_print(const char* name, const ShadowCascades* shadows) {
+    if (!shadows) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s: %u cascades, %u casters, light (%.2f, %.2f, %.2f)\n", name,
+           shadows->desc.cascade_count, shadows->caster_count,
+           shadows->light_direction.x, shadows->light_direction.y, shadows->light_direction.z);
+    for (uint32_t c = 0; c < shadows->desc.cascade_count; c++) {
+        const ShadowCascade* cascade = &shadows->cascades[c];
+        printf("  [%u] %.2f - %.2f: radius %.2f, texel %.4f, near %.2f, %u casters\n", c,
+               cascade->split_near, cascade->split_far, cascade->radius, cascade->texel_size,
+               cascade->caster_near, cascade->caster_count);
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef ENGINE_SHADOWS_H
+#define ENGINE_SHADOWS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_world.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+
+// ============================================================================
+// SHADOW CONFIGURATION
+// ============================================================================
+
+#define SHADOW_MAX_CASCADES 4
+
+// Cascaded shadow map parameters for one directional light
+typedef struct {
+    uint32_t cascade_count;     // 1..SHADOW_MAX_CASCADES
+    uint32_t resolution;        // Shadow map texels per side, per cascade
+    float split_lambda;         // 0 = linear splits, 1 = logarithmic
+    float max_distance;         // Shadow range from the camera (clamped to its far plane)
+} ShadowCascadeDesc;
+
+// ============================================================================
+// SHADOW DATA STRUCTURES
+// ============================================================================
+
+// One cascade: a texel-snapped orthographic light volume around a slice of
+// the camera frustum, and the casters that must be drawn into it
+typedef struct {
+    float split_near;           // View depth range covered by this cascade
+    float split_far;
+    vec3_t center;              // Bounding sphere of the frustum slice (world space)
+    float radius;               // Quantized so it does not change as the camera turns
+    float texel_size;           // World units per shadow map texel
+    float caster_near;          // Light-space depth of the nearest caster drawn
+    mat4_t view;
+    mat4_t projection;          // mat4_ortho; near plane pulled back to caster_near
+    mat4_t view_projection;
+    uint32_t* casters;          // Draw list: caster ids
+    uint32_t caster_count;
+} ShadowCascade;
+
+// Shadow casters (world-space boxes, SoA) and the cascades fitted to a camera
+typedef struct {
+    ShadowCascadeDesc desc;
+    vec3_t light_direction;     // Direction the light travels (normalized)
+    ShadowCascade cascades[SHADOW_MAX_CASCADES];
+
+    float* center_x; float* center_y; float* center_z;
+    float* extent_x; float* extent_y; float* extent_z;
+    uint32_t* caster_ids;
+    uint32_t caster_count;
+    uint32_t caster_capacity;
+} ShadowCascades;
+
+// ============================================================================
+// SHADOW FUNCTIONS
+// ============================================================================
+
+// Default: 4 cascades of 2048 texels, lambda 0.75, 100 units
+ShadowCascadeDesc shadow_cascade_desc_default(void);
+
+// Create cascades with room for max_casters casters
+ShadowCascades* shadow_cascades_create(const ShadowCascadeDesc* desc, uint32_t max_casters);
+
+// Destroy cascades and their draw lists
+void shadow_cascades_destroy(ShadowCascades* shadows);
+
+// Practical split scheme: blend of logarithmic and linear distances.
+// Writes count + 1 values from near_plane to far_plane.
+void shadow_compute_splits(float near_plane, float far_plane, uint32_t count, float lambda, float* out_splits);
+
+// Compute splits and fit every cascade's light view and projection to the
+// camera (world-to-view matrix plus perspective parameters)
+void shadow_cascades_fit(ShadowCascades* shadows, mat4_t camera_view, float fov_y, float aspect,
+                         float near_plane, float far_plane, vec3_t light_direction);
+
+// Caster management. Ids are reported back in the cascade draw lists.
+void shadow_cascades_clear_casters(ShadowCascades* shadows);
+int shadow_cascades_add_caster(ShadowCascades* shadows, uint32_t id, vec3_t bounds_min, vec3_t bounds_max);
+
+// Replace the casters with every active world entity (id = entity id)
+void shadow_cascades_gather_world(ShadowCascades* shadows, const World* world);
+
+// Cull casters against each cascade's light volume and fill the draw lists.
+// Cascades are culled in parallel; jobs may be NULL (serial).
+void shadow_cascades_cull(ShadowCascades* shadows, JobSystemHandle jobs);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print splits, cascade sizes and draw list lengths
+void shadow_cascades_print(const char* name, const ShadowCascades* shadows);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SHADOWS_H
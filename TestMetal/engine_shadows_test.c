@@ -0,0 +1,323 @@
+#include "engine_shadows.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static uint32_t rng_state = 2024u;
+
+static float rand_float(float lo, float hi) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return lo + (hi - lo) * (float)(rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static vec3_t transform_point(mat4_t m, vec3_t p) {
+    return vec3(p.x * m.x.x + p.y * m.y.x + p.z * m.z.x + m.w.x,
+                p.x * m.x.y + p.y * m.y.y + p.z * m.z.y + m.w.y,
+                p.x * m.x.z + p.y * m.y.z + p.z * m.z.z + m.w.z);
+}
+
+static int cascade_has_caster(const ShadowCascade* cascade, uint32_t id) {
+    for (uint32_t i = 0; i < cascade->caster_count; i++) {
+        if (cascade->casters[i] == id) return 1;
+    }
+    return 0;
+}
+
+#define TEST_FOV ((float)M_PI / 3.0f)
+#define TEST_ASPECT (16.0f / 9.0f)
+
+// ============================================================================
+// TEST FUNCTIONS
+// ============================================================================
+
+static void test_splits(void) {
+    printf("\n--- Split Tests ---\n");
+
+    float linear[5], logarithmic[5], practical[5];
+    shadow_compute_splits(1.0f, 101.0f, 4, 0.0f, linear);
+    shadow_compute_splits(1.0f, 101.0f, 4, 1.0f, logarithmic);
+    shadow_compute_splits(1.0f, 101.0f, 4, 0.5f, practical);
+
+    TEST_ASSERT(fabsf(linear[1] - 26.0f) < 1e-4f && fabsf(linear[2] - 51.0f) < 1e-4f,
+                "Lambda 0 should give linear splits");
+    TEST_ASSERT(fabsf(logarithmic[2] - sqrtf(101.0f)) < 1e-3f, "Lambda 1 should give logarithmic splits");
+    TEST_ASSERT(fabsf(practical[2] - 0.5f * (linear[2] + logarithmic[2])) < 1e-3f,
+                "Practical splits should blend linear and logarithmic");
+    TEST_ASSERT(practical[0] == 1.0f && practical[4] == 101.0f, "Splits should start at near and end at far");
+
+    int increasing = 1;
+    for (int i = 0; i < 4; i++) {
+        if (!(practical[i + 1] > practical[i])) increasing = 0;
+    }
+    TEST_ASSERT(increasing, "Splits should increase");
+}
+
+static void test_stable_fit(void) {
+    printf("\n--- Cascade Fit Tests ---\n");
+
+    ShadowCascadeDesc desc = shadow_cascade_desc_default();
+    ShadowCascades* shadows = shadow_cascades_create(&desc, 16);
+    TEST_ASSERT_NOT_NULL(shadows, "Shadow cascades should be created");
+
+    vec3_t light = vec3(-1.0f, -2.0f, -0.5f);
+    vec3_t eye = vec3(3.0f, 2.0f, 5.0f);
+    mat4_t view = mat4_look_at(eye, vec3(3.0f, 1.5f, -5.0f), vec3_unit_y());
+    shadow_cascades_fit(shadows, view, TEST_FOV, TEST_ASPECT, 0.1f, 500.0f, light);
+
+    TEST_ASSERT(fabsf(shadows->cascades[3].split_far - 100.0f) < 1e-4f, "Shadow range should stop at max_distance");
+
+    // Every slice corner must lie inside its cascade's light volume
+    mat4_t camera_to_world = mat4_inverse(view);
+    float tan_y = tanf(TEST_FOV * 0.5f), tan_x = tan_y * TEST_ASPECT;
+    int contained = 1;
+    for (uint32_t c = 0; c < desc.cascade_count; c++) {
+        const ShadowCascade* cascade = &shadows->cascades[c];
+        for (uint32_t k = 0; k < 8; k++) {
+            float d = (k & 4) ? cascade->split_far : cascade->split_near;
+            vec3_t corner = transform_point(camera_to_world,
+                vec3((k & 1) ? d * tan_x : -d * tan_x, (k & 2) ? d * tan_y : -d * tan_y, -d));
+            vec3_t ls = transform_point(cascade->view, corner);
+            float slack = cascade->texel_size * 1.01f;
+            if (fabsf(ls.x) > cascade->radius + slack || fabsf(ls.y) > cascade->radius + slack ||
+                -ls.z < -1e-3f || -ls.z > 2.0f * cascade->radius + 1e-3f) {
+                contained = 0;
+            }
+        }
+    }
+    TEST_ASSERT(contained, "Cascade volumes should contain their frustum slices");
+    TEST_ASSERT(shadows->cascades[0].radius < shadows->cascades[3].radius, "Far cascades should be larger");
+
+    // Turning the camera in place must not change the projection scale
+    float radii[SHADOW_MAX_CASCADES];
+    for (uint32_t c = 0; c < desc.cascade_count; c++) radii[c] = shadows->cascades[c].radius;
+    int stable = 1;
+    for (int step = 1; step < 32; step++) {
+        float yaw = (float)step * 0.173f;
+        mat4_t turned = mat4_look_at(eye, vec3_add(eye, vec3(sinf(yaw), -0.05f * step, -cosf(yaw))), vec3_unit_y());
+        shadow_cascades_fit(shadows, turned, TEST_FOV, TEST_ASPECT, 0.1f, 500.0f, light);
+        for (uint32_t c = 0; c < desc.cascade_count; c++) {
+            if (shadows->cascades[c].radius != radii[c]) stable = 0;
+        }
+    }
+    TEST_ASSERT(stable, "Cascade radii should not change as the camera rotates");
+
+    // Moving the camera moves the light volume in whole texels
+    int snapped = 1;
+    mat4_t first_view = mat4_identity();
+    for (int step = 0; step < 16; step++) {
+        vec3_t moved = vec3_add(eye, vec3(0.037f * step, 0.0f, -0.011f * step));
+        mat4_t moved_view = mat4_look_at(moved, vec3_add(moved, vec3(0.0f, -0.1f, -1.0f)), vec3_unit_y());
+        shadow_cascades_fit(shadows, moved_view, TEST_FOV, TEST_ASPECT, 0.1f, 500.0f, light);
+        const ShadowCascade* cascade = &shadows->cascades[1];
+        if (step == 0) {
+            first_view = cascade->view;
+            continue;
+        }
+        float dx = (cascade->view.w.x - first_view.w.x) / cascade->texel_size;
+        float dy = (cascade->view.w.y - first_view.w.y) / cascade->texel_size;
+        if (fabsf(dx - roundf(dx)) > 1e-2f || fabsf(dy - roundf(dy)) > 1e-2f) snapped = 0;
+    }
+    TEST_ASSERT(snapped, "Light volume should move in whole texels");
+
+    shadow_cascades_destroy(shadows);
+    desc.cascade_count = SHADOW_MAX_CASCADES + 1;
+    TEST_ASSERT(shadow_cascades_create(&desc, 16) == NULL, "Too many cascades should be rejected");
+}
+
+static void test_caster_culling(void) {
+    printf("\n--- Caster Culling Tests ---\n");
+
+    ShadowCascadeDesc desc = shadow_cascade_desc_default();
+    ShadowCascades* shadows = shadow_cascades_create(&desc, 16);
+
+    // Camera on the ground looking down -Z, sun straight down
+    mat4_t view = mat4_look_at(vec3(0.0f, 1.0f, 0.0f), vec3(0.0f, 1.0f, -1.0f), vec3_unit_y());
+    shadow_cascades_fit(shadows, view, TEST_FOV, TEST_ASPECT, 0.1f, 100.0f, vec3(0.0f, -1.0f, 0.0f));
+    const ShadowCascade* first = &shadows->cascades[0];
+    vec3_t c0 = first->center;
+
+    shadow_cascades_add_caster(shadows, 1, vec3_sub(c0, vec3_one()), vec3_add(c0, vec3_one()));
+    shadow_cascades_add_caster(shadows, 2, vec3(500.0f, 0.0f, 0.0f), vec3(502.0f, 2.0f, 2.0f));
+    shadow_cascades_add_caster(shadows, 3, vec3(c0.x - 1.0f, 200.0f, c0.z - 1.0f), vec3(c0.x + 1.0f, 202.0f, c0.z + 1.0f));
+    shadow_cascades_add_caster(shadows, 4, vec3(c0.x - 1.0f, -300.0f, c0.z - 1.0f), vec3(c0.x + 1.0f, -298.0f, c0.z + 1.0f));
+    shadow_cascades_cull(shadows, NULL);
+
+    TEST_ASSERT(cascade_has_caster(first, 1), "Caster inside the slice should be drawn");
+    TEST_ASSERT(!cascade_has_caster(first, 2), "Caster beside the volume should be culled");
+    TEST_ASSERT(cascade_has_caster(first, 3), "Caster between the light and the slice should be drawn");
+    TEST_ASSERT(!cascade_has_caster(first, 4), "Caster beyond the receivers should be culled");
+    TEST_ASSERT(first->caster_near < -150.0f, "Near plane should be pulled back to the highest caster");
+
+    // The nearest caster must map inside the projection's depth range
+    vec3_t top = transform_point(first->view_projection, vec3(c0.x, 202.0f, c0.z));
+    TEST_ASSERT(top.z >= -1.0001f && top.z <= 1.0001f, "Pulled-back caster should not be clipped");
+
+    // World entities become casters through their bounds
+    World* world = world_create(8);
+    WorldEntity* a = world_create_entity(world, "a");
+    WorldEntity* b = world_create_entity(world, "b");
+    WorldEntity* hidden = world_create_entity(world, "hidden");
+    entity_set_position(a, c0);
+    entity_set_bounds(a, vec3(-2.0f, 0.0f, -1.0f), vec3(2.0f, 1.0f, 1.0f));
+    entity_set_orientation_axis_angle(a, vec3_unit_y(), (float)M_PI * 0.5f);
+    entity_set_position(b, vec3(800.0f, 0.0f, 0.0f));
+    entity_set_position(hidden, c0);
+    entity_set_active(hidden, 0);
+
+    vec3_t bmin, bmax;
+    entity_get_world_bounds(a, &bmin, &bmax);
+    TEST_ASSERT(fabsf((bmax.x - bmin.x) - 2.0f) < 1e-4f && fabsf((bmax.z - bmin.z) - 4.0f) < 1e-4f,
+                "Rotated entity bounds should swap extents");
+
+    shadow_cascades_gather_world(shadows, world);
+    TEST_ASSERT_EQUAL(2u, shadows->caster_count, "Only active entities should become casters");
+    shadow_cascades_cull(shadows, NULL);
+    TEST_ASSERT(cascade_has_caster(first, a->id) && !cascade_has_caster(first, b->id),
+                "Entity draw lists should follow entity bounds");
+
+    world_destroy(world);
+    shadow_cascades_destroy(shadows);
+}
+
+static void scatter_casters(ShadowCascades* shadows, uint32_t count) {
+    rng_state = 99u;
+    for (uint32_t i = 0; i < count; i++) {
+        vec3_t p = vec3(rand_float(-250.0f, 250.0f), rand_float(0.0f, 10.0f), rand_float(-250.0f, 250.0f));
+        vec3_t e = vec3(rand_float(0.2f, 2.0f), rand_float(0.2f, 4.0f), rand_float(0.2f, 2.0f));
+        shadow_cascades_add_caster(shadows, i + 1, vec3_sub(p, e), vec3_add(p, e));
+    }
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t caster_count = 50000;
+    const int frames = 50;
+    ShadowCascadeDesc desc = shadow_cascade_desc_default();
+    ShadowCascades* serial = shadow_cascades_create(&desc, caster_count);
+    ShadowCascades* parallel = shadow_cascades_create(&desc, caster_count);
+    JobSystemHandle jobs = job_system_create(0);
+    scatter_casters(serial, caster_count);
+    scatter_casters(parallel, caster_count);
+    vec3_t light = vec3(-0.4f, -1.0f, -0.3f);
+
+    int identical = 1;
+    double total[2] = {0.0, 0.0}, best[2] = {1e9, 1e9};
+    for (int f = 0; f < frames; f++) {
+        float yaw = (float)f * 0.05f;
+        vec3_t eye = vec3(0.0f, 2.0f, 0.0f);
+        mat4_t view = mat4_look_at(eye, vec3(sinf(yaw), 1.8f, -cosf(yaw)), vec3_unit_y());
+
+        for (int pass = 0; pass < 2; pass++) {
+            ShadowCascades* shadows = pass == 0 ? serial : parallel;
+            double start = now_ms();
+            shadow_cascades_fit(shadows, view, TEST_FOV, TEST_ASPECT, 0.1f, 200.0f, light);
+            shadow_cascades_cull(shadows, pass == 0 ? NULL : jobs);
+            double elapsed = now_ms() - start;
+            total[pass] += elapsed;
+            if (elapsed < best[pass]) best[pass] = elapsed;
+        }
+
+        for (uint32_t c = 0; c < desc.cascade_count; c++) {
+            const ShadowCascade* a = &serial->cascades[c];
+            const ShadowCascade* b = &parallel->cascades[c];
+            if (a->caster_count != b->caster_count ||
+                memcmp(a->casters, b->casters, a->caster_count * sizeof(uint32_t)) != 0) {
+                identical = 0;
+            }
+        }
+    }
+
+    printf("serial (1 workers): avg %.3f ms/frame, best %.3f ms/frame\n", total[0] / frames, best[0]);
+    printf("parallel (%u workers): avg %.3f ms/frame, best %.3f ms/frame\n",
+           job_system_get_worker_count(jobs), total[1] / frames, best[1]);
+    printf("%.2f ns/caster/cascade\n", total[0] * 1e6 / ((double)frames * caster_count * desc.cascade_count));
+    shadow_cascades_print("  Last frame", parallel);
+
+    // Scalar reference for the last frame
+    uint32_t mismatches = 0;
+    for (uint32_t c = 0; c < desc.cascade_count; c++) {
+        const ShadowCascade* cascade = &parallel->cascades[c];
+        uint32_t expected = 0;
+        for (uint32_t i = 0; i < caster_count; i++) {
+            vec3_t center = vec3(parallel->center_x[i], parallel->center_y[i], parallel->center_z[i]);
+            vec3_t extent = vec3(parallel->extent_x[i], parallel->extent_y[i], parallel->extent_z[i]);
+            mat4_t v = cascade->view;
+            vec3_t lc = transform_point(v, center);
+            float ex = extent.x * fabsf(v.x.x) + extent.y * fabsf(v.y.x) + extent.z * fabsf(v.z.x);
+            float ey = extent.x * fabsf(v.x.y) + extent.y * fabsf(v.y.y) + extent.z * fabsf(v.z.y);
+            float ez = extent.x * fabsf(v.x.z) + extent.y * fabsf(v.y.z) + extent.z * fabsf(v.z.z);
+            if (fabsf(lc.x) - ex <= cascade->radius && fabsf(lc.y) - ey <= cascade->radius &&
+                -lc.z - ez <= 2.0f * cascade->radius) {
+                if (expected >= cascade->caster_count || cascade->casters[expected] != i + 1) mismatches++;
+                expected++;
+            }
+        }
+        if (expected != cascade->caster_count) mismatches++;
+    }
+    TEST_ASSERT(identical, "Parallel and serial culling should produce identical draw lists");
+    TEST_ASSERT_EQUAL(0u, mismatches, "SIMD culling should match the scalar reference");
+    TEST_ASSERT(parallel->cascades[0].caster_count < parallel->cascades[3].caster_count,
+                "Far cascades should draw more casters");
+
+    shadow_cascades_destroy(serial);
+    shadow_cascades_destroy(parallel);
+    job_system_destroy(jobs);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Shadow Cascade Unit Tests\n");
+    printf("===================================\n");
+
+    test_splits();
+    test_stable_fit();
+    test_caster_culling();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
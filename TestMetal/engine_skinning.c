@@ -0,0 +1,470 @@
+#include "engine_skinning.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+// Split an affine matrix into translation, rotation and per-axis scale
+static void mat4_decompose(mat4_t m, vec3_t* t, quat_t* r, vec3_t* s) {
+    vec3_t rx = vec3(m.x.x, m.x.y, m.x.z);
+    vec3_t ry = vec3(m.y.x, m.y.y, m.y.z);
+    vec3_t rz = vec3(m.z.x, m.z.y, m.z.z);
+    float sx = vec3_length(rx), sy = vec3_length(ry), sz = vec3_length(rz);
+    // Mirrored bases keep a negative scale on x so the rotation stays proper
+    if (vec3_dot(vec3_cross(rx, ry), rz) < 0.0f) sx = -sx;
+    *s = vec3(sx, sy, sz);
+    *t = vec3(m.w.x, m.w.y, m.w.z);
+
+    mat4_t rot = mat4_identity();
+    if (sx != 0.0f) rot.x = vec4(rx.x / sx, rx.y / sx, rx.z / sx, 0.0f);
+    if (sy != 0.0f) rot.y = vec4(ry.x / sy, ry.y / sy, ry.z / sy, 0.0f);
+    if (sz != 0.0f) rot.z = vec4(rz.x / sz, rz.y / sz, rz.z / sz, 0.0f);
+    *r = quat_from_mat4(rot);
+}
+
+FORCE_INLINE simd4f_t simd4f_from_quat(quat_t q) {
+    return (simd4f_t){q.x, q.y, q.z, q.w};
+}
+
+// ============================================================================
+// SKELETON FUNCTIONS
+// ============================================================================
+
+Skeleton* skeleton_create(uint32_t joint_count) {
+    if (joint_count == 0 || joint_count > SKIN_MAX_JOINTS) {
+        fprintf(stderr, "Error: Skeleton joint count must be 1..%d (got %u)\n", SKIN_MAX_JOINTS, joint_count);
+        return NULL;
+    }
+
+    Skeleton* skeleton = (Skeleton*)calloc(1, sizeof(Skeleton));
+    if (!skeleton) {
+        fprintf(stderr, "Error: Failed to allocate memory for skeleton\n");
+        return NULL;
+    }
+
+    skeleton->joint_count = joint_count;
+    skeleton->parents = (int32_t*)malloc(joint_count * sizeof(int32_t));
+    skeleton->names = (char**)calloc(joint_count, sizeof(char*));
+    skeleton->inverse_bind = (mat4_t*)malloc(joint_count * sizeof(mat4_t));
+    skeleton->bind_translations = (vec3_t*)malloc(joint_count * sizeof(vec3_t));
+    skeleton->bind_rotations = (quat_t*)malloc(joint_count * sizeof(quat_t));
+    skeleton->bind_scales = (vec3_t*)malloc(joint_count * sizeof(vec3_t));
+    if (!skeleton->parents || !skeleton->names || !skeleton->inverse_bind ||
+        !skeleton->bind_translations || !skeleton->bind_rotations || !skeleton->bind_scales) {
+        fprintf(stderr, "Error: Failed to allocate memory for %u joints\n", joint_count);
+        skeleton_destroy(skeleton);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < joint_count; i++) {
+        skeleton->parents[i] = -1;
+        skeleton->inverse_bind[i] = mat4_identity();
+        skeleton->bind_translations[i] = vec3_zero();
+        skeleton->bind_rotations[i] = quat_identity();
+        skeleton->bind_scales[i] = vec3(1.0f, 1.0f, 1.0f);
+    }
+
+    return skeleton;
+}
+
+void skeleton_destroy(Skeleton* skeleton) {
+    if (!skeleton) {
+        return;
+    }
+    if (skeleton->names) {
+        for (uint32_t i = 0; i < skeleton->joint_count; i++) {
+            free(skeleton->names[i]);
+        }
+    }
+    free(skeleton->names);
+    free(skeleton->parents);
+    free(skeleton->inverse_bind);
+    free(skeleton->bind_translations);
+    free(skeleton->bind_rotations);
+    free(skeleton->bind_scales);
+    free(skeleton);
+}
+
+int32_t skeleton_find_joint(const Skeleton* skeleton, const char* name) {
+    if (!skeleton || !name) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < skeleton->joint_count; i++) {
+        if (skeleton->names[i] && strcmp(skeleton->names[i], name) == 0) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+void skeleton_set_bind_matrices(Skeleton* skeleton, const mat4_t* model_bind) {
+    if (!skeleton || !model_bind) {
+        return;
+    }
+    for (uint32_t i = 0; i < skeleton->joint_count; i++) {
+        skeleton->inverse_bind[i] = mat4_inverse(model_bind[i]);
+        int32_t parent = skeleton->parents[i];
+        mat4_t local = model_bind[i];
+        if (parent >= 0) {
+            local = mat4_mul_mat4(model_bind[i], skeleton->inverse_bind[parent]);
+        }
+        mat4_decompose(local, &skeleton->bind_translations[i], &skeleton->bind_rotations[i], &skeleton->bind_scales[i]);
+    }
+}
+
+// ============================================================================
+// POSE FUNCTIONS
+// ============================================================================
+
+Pose* pose_create(const Skeleton* skeleton) {
+    if (!skeleton) {
+        fprintf(stderr, "Error: Cannot create pose without a skeleton\n");
+        return NULL;
+    }
+
+    Pose* pose = (Pose*)calloc(1, sizeof(Pose));
+    if (!pose) {
+        fprintf(stderr, "Error: Failed to allocate memory for pose\n");
+        return NULL;
+    }
+
+    uint32_t n = skeleton->joint_count;
+    pose->skeleton = skeleton;
+    pose->translations = (vec3_t*)malloc(n * sizeof(vec3_t));
+    pose->rotations = (quat_t*)malloc(n * sizeof(quat_t));
+    pose->scales = (vec3_t*)malloc(n * sizeof(vec3_t));
+    pose->model = (mat4_t*)malloc(n * sizeof(mat4_t));
+    pose->palette = (mat4_t*)malloc(n * sizeof(mat4_t));
+    if (!pose->translations || !pose->rotations || !pose->scales || !pose->model || !pose->palette) {
+        fprintf(stderr, "Error: Failed to allocate memory for pose joints\n");
+        pose_destroy(pose);
+        return NULL;
+    }
+
+    pose_set_bind(pose);
+    pose_compute_palette(pose);
+    return pose;
+}
+
+void pose_destroy(Pose* pose) {
+    if (!pose) {
+        return;
+    }
+    free(pose->translations);
+    free(pose->rotations);
+    free(pose->scales);
+    free(pose->model);
+    free(pose->palette);
+    free(pose);
+}
+
+void pose_set_bind(Pose* pose) {
+    if (!pose) {
+        return;
+    }
+    const Skeleton* skeleton = pose->skeleton;
+    uint32_t n = skeleton->joint_count;
+    memcpy(pose->translations, skeleton->bind_translations, n * sizeof(vec3_t));
+    memcpy(pose->rotations, skeleton->bind_rotations, n * sizeof(quat_t));
+    memcpy(pose->scales, skeleton->bind_scales, n * sizeof(vec3_t));
+}
+
+void pose_compute_palette(Pose* pose) {
+    if (!pose) {
+        return;
+    }
+    const Skeleton* skeleton = pose->skeleton;
+    for (uint32_t i = 0; i < skeleton->joint_count; i++) {
+        mat4_t local = mat4_mul_mat4(mat4_scale(pose->scales[i]), quat_to_mat4(pose->rotations[i]));
+        local.w = vec4(pose->translations[i].x, pose->translations[i].y, pose->translations[i].z, 1.0f);
+
+        int32_t parent = skeleton->parents[i];
+        pose->model[i] = parent >= 0 ? mat4_mul_mat4(local, pose->model[parent]) : local;
+        pose->palette[i] = mat4_mul_mat4(skeleton->inverse_bind[i], pose->model[i]);
+    }
+}
+
+void pose_compute_dual_quat_palette(const Pose* pose, DualQuat* out) {
+    if (!pose || !out) {
+        return;
+    }
+    for (uint32_t i = 0; i < pose->skeleton->joint_count; i++) {
+        vec3_t t, s;
+        quat_t r;
+        mat4_decompose(pose->palette[i], &t, &r, &s);
+        out[i].real = r;
+        out[i].dual = quat_scale(quat_mul(quat(t.x, t.y, t.z, 0.0f), r), 0.5f);
+    }
+}
+
+// ============================================================================
+// SKIN DATA FUNCTIONS
+// ============================================================================
+
+SkinData* skin_data_create(uint32_t vertex_count) {
+    SkinData* skin = (SkinData*)calloc(1, sizeof(SkinData));
+    if (!skin) {
+        fprintf(stderr, "Error: Failed to allocate memory for skin data\n");
+        return NULL;
+    }
+
+    skin->influences = (SkinInfluence*)calloc(vertex_count ? vertex_count : 1, sizeof(SkinInfluence));
+    if (!skin->influences) {
+        fprintf(stderr, "Error: Failed to allocate %u skin influences\n", vertex_count);
+        free(skin);
+        return NULL;
+    }
+    skin->vertex_count = vertex_count;
+    for (uint32_t i = 0; i < vertex_count; i++) {
+        skin->influences[i].weights[0] = SKIN_WEIGHT_SCALE;
+    }
+    return skin;
+}
+
+void skin_data_destroy(SkinData* skin) {
+    if (!skin) {
+        return;
+    }
+    free(skin->influences);
+    free(skin);
+}
+
+void skin_data_set_vertex(SkinData* skin, uint32_t vertex, const uint32_t* joints, const float* weights, uint32_t count) {
+    if (!skin || vertex >= skin->vertex_count) {
+        return;
+    }
+
+    // Keep the SKIN_MAX_INFLUENCES largest weights (insertion into a sorted top list)
+    uint32_t top_joint[SKIN_MAX_INFLUENCES] = {0};
+    float top_weight[SKIN_MAX_INFLUENCES] = {0};
+    for (uint32_t i = 0; i < count; i++) {
+        float w = weights[i];
+        if (!(w > 0.0f) || joints[i] >= SKIN_MAX_JOINTS) continue;
+        int slot = SKIN_MAX_INFLUENCES;
+        while (slot > 0 && top_weight[slot - 1] < w) slot--;
+        if (slot == SKIN_MAX_INFLUENCES) continue;
+        for (int k = SKIN_MAX_INFLUENCES - 1; k > slot; k--) {
+            top_weight[k] = top_weight[k - 1];
+            top_joint[k] = top_joint[k - 1];
+        }
+        top_weight[slot] = w;
+        top_joint[slot] = joints[i];
+    }
+
+    SkinInfluence* inf = &skin->influences[vertex];
+    float total = 0.0f;
+    for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) total += top_weight[k];
+    if (total <= 0.0f) {
+        memset(inf, 0, sizeof(*inf));
+        inf->weights[0] = SKIN_WEIGHT_SCALE;
+        return;
+    }
+
+    // Round each weight, then give the rounding residual to the largest so
+    // the quantized weights always sum to exactly SKIN_WEIGHT_SCALE
+    int sum = 0;
+    int q[SKIN_MAX_INFLUENCES];
+    for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+        q[k] = (int)(top_weight[k] / total * (float)SKIN_WEIGHT_SCALE + 0.5f);
+        sum += q[k];
+    }
+    q[0] += SKIN_WEIGHT_SCALE - sum;
+    for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+        inf->joints[k] = (uint8_t)top_joint[k];
+        inf->weights[k] = (uint8_t)q[k];
+    }
+}
+
+// ============================================================================
+// SKINNING KERNELS
+// ============================================================================
+
+typedef struct {
+    const Vertex* src;
+    const SkinInfluence* influences;
+    const mat4_t* palette;
+    const DualQuat* dq_palette;
+    Vertex* dst;
+} SkinningJob;
+
+// Blends the palette rows of up to four joints with SIMD, then transforms
+// position (all four rows) and normal (rotation rows only)
+static void skin_linear_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    const SkinningJob* job = (const SkinningJob*)user_data;
+    const float inv_scale = 1.0f / (float)SKIN_WEIGHT_SCALE;
+
+    for (uint32_t v = begin; v < end; v++) {
+        const SkinInfluence* inf = &job->influences[v];
+        simd4f_t bx = simd4f_splat(0.0f), by = bx, bz = bx, bw = bx;
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            if (inf->weights[k] == 0) continue;
+            const mat4_t* m = &job->palette[inf->joints[k]];
+            simd4f_t w = simd4f_splat((float)inf->weights[k] * inv_scale);
+            bx += w * simd4f_from_vec4(m->x);
+            by += w * simd4f_from_vec4(m->y);
+            bz += w * simd4f_from_vec4(m->z);
+            bw += w * simd4f_from_vec4(m->w);
+        }
+
+        const Vertex* in = &job->src[v];
+        Vertex* out = &job->dst[v];
+        simd4f_t p = bx * simd4f_splat(in->position.x) + by * simd4f_splat(in->position.y) +
+                     bz * simd4f_splat(in->position.z) + bw;
+        simd4f_t n = bx * simd4f_splat(in->normal.x) + by * simd4f_splat(in->normal.y) +
+                     bz * simd4f_splat(in->normal.z);
+        float len_sq = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+        float inv_len = len_sq > 0.0f ? 1.0f / sqrtf(len_sq) : 0.0f;
+
+        out->position = vec3(p[0], p[1], p[2]);
+        out->texcoord = in->texcoord;
+        out->normal = vec3(n[0] * inv_len, n[1] * inv_len, n[2] * inv_len);
+    }
+}
+
+// Blends dual quaternions (with antipodality correction against the first
+// influence), normalizes, then applies rotation and translation
+static void skin_dual_quat_range(void* user_data, uint32_t begin, uint32_t end, uint32_t worker_index) {
+    (void)worker_index;
+    const SkinningJob* job = (const SkinningJob*)user_data;
+    const float inv_scale = 1.0f / (float)SKIN_WEIGHT_SCALE;
+
+    for (uint32_t v = begin; v < end; v++) {
+        const SkinInfluence* inf = &job->influences[v];
+        simd4f_t pivot = simd4f_from_quat(job->dq_palette[inf->joints[0]].real);
+        simd4f_t real = simd4f_splat(0.0f), dual = real;
+        for (int k = 0; k < SKIN_MAX_INFLUENCES; k++) {
+            if (inf->weights[k] == 0) continue;
+            const DualQuat* dq = &job->dq_palette[inf->joints[k]];
+            simd4f_t r = simd4f_from_quat(dq->real);
+            simd4f_t d = simd4f_from_quat(dq->dual);
+            simd4f_t rp = r * pivot;
+            float w = (float)inf->weights[k] * inv_scale;
+            if (rp[0] + rp[1] + rp[2] + rp[3] < 0.0f) w = -w;
+            real += simd4f_splat(w) * r;
+            dual += simd4f_splat(w) * d;
+        }
+
+        simd4f_t rr = real * real;
+        float len_sq = rr[0] + rr[1] + rr[2] + rr[3];
+        float inv_len = len_sq > 0.0f ? 1.0f / sqrtf(len_sq) : 0.0f;
+        real *= simd4f_splat(inv_len);
+        dual *= simd4f_splat(inv_len);
+
+        quat_t qr = quat(real[0], real[1], real[2], real[3]);
+        // Translation = 2 * vec(dual * conj(real))
+        vec3_t rv = vec3(real[0], real[1], real[2]);
+        vec3_t dv = vec3(dual[0], dual[1], dual[2]);
+        vec3_t t = vec3_scale(vec3_add(vec3_sub(vec3_scale(dv, real[3]), vec3_scale(rv, dual[3])), vec3_cross(rv, dv)), 2.0f);
+
+        const Vertex* in = &job->src[v];
+        Vertex* out = &job->dst[v];
+        out->position = vec3_add(quat_rotate_vec3(qr, in->position), t);
+        out->texcoord = in->texcoord;
+        out->normal = quat_rotate_vec3(qr, in->normal);
+    }
+}
+
+void skinning_apply_linear(const Vertex* bind_vertices, const SkinInfluence* influences, const mat4_t* palette,
+                           Vertex* out_vertices, uint32_t vertex_count, JobSystemHandle jobs) {
+    if (!bind_vertices || !influences || !palette || !out_vertices || vertex_count == 0) {
+        return;
+    }
+    SkinningJob job = {bind_vertices, influences, palette, NULL, out_vertices};
+    job_system_parallel_for(jobs, vertex_count, SKIN_DEFAULT_GRAIN, skin_linear_range, &job);
+}
+
+void skinning_apply_dual_quat(const Vertex* bind_vertices, const SkinInfluence* influences, const DualQuat* palette,
+                              Vertex* out_vertices, uint32_t vertex_count, JobSystemHandle jobs) {
+    if (!bind_vertices || !influences || !palette || !out_vertices || vertex_count == 0) {
+        return;
+    }
+    SkinningJob job = {bind_vertices, influences, NULL, palette, out_vertices};
+    job_system_parallel_for(jobs, vertex_count, SKIN_DEFAULT_GRAIN, skin_dual_quat_range, &job);
+}
+
+// ============================================================================
+// SKINNED INSTANCE FUNCTIONS
+// ============================================================================
+
+SkinnedInstance* skinned_instance_create(const Mesh* mesh, const SkinData* skin, const Skeleton* skeleton) {
+    if (!mesh || !skin || !skeleton) {
+        fprintf(stderr, "Error: Invalid parameters for skinned_instance_create\n");
+        return NULL;
+    }
+    if (skin->vertex_count != mesh->vertex_count) {
+        fprintf(stderr, "Error: Skin has %u vertices but mesh has %u\n", skin->vertex_count, mesh->vertex_count);
+        return NULL;
+    }
+
+    SkinnedInstance* instance = (SkinnedInstance*)calloc(1, sizeof(SkinnedInstance));
+    if (!instance) {
+        fprintf(stderr, "Error: Failed to allocate memory for skinned instance\n");
+        return NULL;
+    }
+
+    instance->mesh = mesh;
+    instance->skin = skin;
+    instance->vertex_count = mesh->vertex_count;
+    instance->pose = pose_create(skeleton);
+    instance->dq_palette = (DualQuat*)malloc(skeleton->joint_count * sizeof(DualQuat));
+    instance->vertices = (Vertex*)malloc((mesh->vertex_count ? mesh->vertex_count : 1) * sizeof(Vertex));
+    if (!instance->pose || !instance->dq_palette || !instance->vertices) {
+        fprintf(stderr, "Error: Failed to allocate memory for skinned instance buffers\n");
+        skinned_instance_destroy(instance);
+        return NULL;
+    }
+
+    if (mesh->vertex_count > 0) {
+        memcpy(instance->vertices, mesh->vertices, mesh->vertex_count * sizeof(Vertex));
+    }
+    return instance;
+}
+
+void skinned_instance_destroy(SkinnedInstance* instance) {
+    if (!instance) {
+        return;
+    }
+    pose_destroy(instance->pose);
+    free(instance->dq_palette);
+    free(instance->vertices);
+    free(instance);
+}
+
+void skinned_instance_update(SkinnedInstance* instance, SkinningMode mode, JobSystemHandle jobs) {
+    if (!instance) {
+        return;
+    }
+    pose_compute_palette(instance->pose);
+    if (mode == SKINNING_DUAL_QUATERNION) {
+        pose_compute_dual_quat_palette(instance->pose, instance->dq_palette);
+        skinning_apply_dual_quat(instance->mesh->vertices, instance->skin->influences, instance->dq_palette,
+                                 instance->vertices, instance->vertex_count, jobs);
+    } else {
+        skinning_apply_linear(instance->mesh->vertices, instance->skin->influences, instance->pose->palette,
+                              instance->vertices, instance->vertex_count, jobs);
+    }
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void skeleton_print(const char* name, const Skeleton* skeleton) {
+    if (!skeleton) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    printf("%s: %u joints\n", name, skeleton->joint_count);
+    for (uint32_t i = 0; i < skeleton->joint_count; i++) {
+        int depth = 0;
+        for (int32_t p = skeleton->parents[i]; p >= 0; p = skeleton->parents[p]) depth++;
+        vec3_t t = skeleton->bind_translations[i];
+        printf("  %*s[%u] %s (%.3f, %.3f, %.3f)\n", depth * 2, "", i,
+               skeleton->names[i] ? skeleton->names[i] : "<unnamed>", t.x, t.y, t.z);
+    }
+}
@@ -0,0 +1,173 @@
+#ifndef ENGINE_SKINNING_H
+#define ENGINE_SKINNING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_model.h"
+#include "engine_jobs.h"
+#include <stdint.h>
+
+// ============================================================================
+// SKINNING CONFIGURATION
+// ============================================================================
+
+#define SKIN_MAX_INFLUENCES 4           // Joint influences per vertex
+#define SKIN_MAX_JOINTS 256             // Joint indices are stored as uint8
+#define SKIN_WEIGHT_SCALE 255           // Quantized weights of a vertex sum to this
+#define SKIN_DEFAULT_GRAIN 1024         // Vertices per job chunk
+
+// Matrix convention: engine_math row-vector form, p' = p * M, so the rows
+// x/y/z are the transformed basis vectors and row w is the translation.
+// A child's model matrix is local * parent_model, and the skinning matrix
+// is inverse_bind * model.
+
+// ============================================================================
+// SKINNING DATA STRUCTURES
+// ============================================================================
+
+// Joint hierarchy with bind pose. Parents always precede their children.
+typedef struct {
+    uint32_t joint_count;
+    int32_t* parents;           // -1 for root joints
+    char** names;
+    mat4_t* inverse_bind;       // Mesh space -> joint space at bind time
+    vec3_t* bind_translations;  // Local rest pose
+    quat_t* bind_rotations;
+    vec3_t* bind_scales;
+} Skeleton;
+
+// Local joint transforms plus derived model-space matrices and palette
+typedef struct {
+    const Skeleton* skeleton;
+    vec3_t* translations;
+    quat_t* rotations;
+    vec3_t* scales;
+    mat4_t* model;              // Model-space joint matrices
+    mat4_t* palette;            // Skinning matrices (inverse_bind * model)
+} Pose;
+
+// Quantized per-vertex influences (8 bytes per vertex)
+typedef struct {
+    uint8_t joints[SKIN_MAX_INFLUENCES];
+    uint8_t weights[SKIN_MAX_INFLUENCES];  // Sum to SKIN_WEIGHT_SCALE
+} SkinInfluence;
+
+// Skin weights for one mesh, indexed like Mesh.vertices
+typedef struct {
+    SkinInfluence* influences;
+    uint32_t vertex_count;
+} SkinData;
+
+// Unit dual quaternion for rigid joint transforms
+typedef struct {
+    quat_t real;                // Rotation
+    quat_t dual;                // 0.5 * translation * real
+} DualQuat;
+
+// Skinning method
+typedef enum {
+    SKINNING_LINEAR_BLEND = 0,
+    SKINNING_DUAL_QUATERNION = 1
+} SkinningMode;
+
+// One animated copy of a skinned mesh: its pose and output vertex buffer
+typedef struct {
+    const Mesh* mesh;           // Bind-pose vertices (not owned)
+    const SkinData* skin;       // Not owned
+    Pose* pose;
+    DualQuat* dq_palette;       // Scratch for dual quaternion skinning
+    Vertex* vertices;           // Skinned output, same layout as Mesh.vertices
+    uint32_t vertex_count;
+} SkinnedInstance;
+
+// ============================================================================
+// SKELETON FUNCTIONS
+// ============================================================================
+
+// Create a skeleton with joint_count joints at identity bind pose
+Skeleton* skeleton_create(uint32_t joint_count);
+
+// Destroy a skeleton and its joint names
+void skeleton_destroy(Skeleton* skeleton);
+
+// Find a joint by name, or -1 if not found
+int32_t skeleton_find_joint(const Skeleton* skeleton, const char* name);
+
+// Set the rest pose from model-space bind matrices (inverse_bind becomes
+// their inverse); local TRS is derived relative to each parent
+void skeleton_set_bind_matrices(Skeleton* skeleton, const mat4_t* model_bind);
+
+// ============================================================================
+// POSE FUNCTIONS
+// ============================================================================
+
+// Create a pose for a skeleton, initialized to the bind pose
+Pose* pose_create(const Skeleton* skeleton);
+
+// Destroy a pose
+void pose_destroy(Pose* pose);
+
+// Reset local transforms to the skeleton's bind pose
+void pose_set_bind(Pose* pose);
+
+// Local TRS -> model matrices -> skinning palette
+void pose_compute_palette(Pose* pose);
+
+// Convert the palette to dual quaternions (scale is ignored)
+void pose_compute_dual_quat_palette(const Pose* pose, DualQuat* out);
+
+// ============================================================================
+// SKIN DATA FUNCTIONS
+// ============================================================================
+
+// Create skin data for vertex_count vertices (all bound to joint 0)
+SkinData* skin_data_create(uint32_t vertex_count);
+
+// Destroy skin data
+void skin_data_destroy(SkinData* skin);
+
+// Set a vertex's influences: keeps the 4 largest weights, normalizes and
+// quantizes them so they sum exactly to SKIN_WEIGHT_SCALE
+void skin_data_set_vertex(SkinData* skin, uint32_t vertex, const uint32_t* joints, const float* weights, uint32_t count);
+
+// ============================================================================
+// SKINNING KERNELS
+// ============================================================================
+
+// Linear blend skinning of positions and normals. Texcoords are copied.
+// Runs in parallel over vertex ranges when jobs is non-NULL.
+void skinning_apply_linear(const Vertex* bind_vertices, const SkinInfluence* influences, const mat4_t* palette,
+                           Vertex* out_vertices, uint32_t vertex_count, JobSystemHandle jobs);
+
+// Dual quaternion skinning (no volume loss at twisting joints, rigid only)
+void skinning_apply_dual_quat(const Vertex* bind_vertices, const SkinInfluence* influences, const DualQuat* palette,
+                              Vertex* out_vertices, uint32_t vertex_count, JobSystemHandle jobs);
+
+// ============================================================================
+// SKINNED INSTANCE FUNCTIONS
+// ============================================================================
+
+// Create an instance with its own pose and output buffer
+SkinnedInstance* skinned_instance_create(const Mesh* mesh, const SkinData* skin, const Skeleton* skeleton);
+
+// Destroy an instance
+void skinned_instance_destroy(SkinnedInstance* instance);
+
+// Recompute the palette from the instance pose and skin into its output buffer
+void skinned_instance_update(SkinnedInstance* instance, SkinningMode mode, JobSystemHandle jobs);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print joint hierarchy
+void skeleton_print(const char* name, const Skeleton* skeleton);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_SKINNING_H
@@ -0,0 +1,464 @@
+#include "engine_skinning.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int vec3_near(vec3_t a, vec3_t b, float eps) {
+    return fabsf(a.x - b.x) < eps && fabsf(a.y - b.y) < eps && fabsf(a.z - b.z) < eps;
+}
+
+static int mat4_near_identity(mat4_t m, float eps) {
+    mat4_t id = mat4_identity();
+    const float* a = &m.x.x;
+    const float* b = &id.x.x;
+    for (int i = 0; i < 16; i++) {
+        if (fabsf(a[i] - b[i]) > eps) return 0;
+    }
+    return 1;
+}
+
+// Two-joint chain: root at the origin, child one unit up
+static Skeleton* create_chain_skeleton(void) {
+    Skeleton* skeleton = skeleton_create(2);
+    skeleton->parents[1] = 0;
+    mat4_t bind[2] = {mat4_identity(), mat4_translation(vec3(0.0f, 1.0f, 0.0f))};
+    skeleton_set_bind_matrices(skeleton, bind);
+    return skeleton;
+}
+
+// ============================================================================
+// TEST FUNCTIONS
+// ============================================================================
+
+static void test_math_helpers(void) {
+    printf("\n--- Math Helper Tests ---\n");
+
+    quat_t q = quat_normalize(quat(0.2f, -0.4f, 0.1f, 0.9f));
+    mat4_t m = mat4_mul_mat4(mat4_mul_mat4(mat4_scale(vec3(2.0f, 0.5f, 1.5f)), quat_to_mat4(q)),
+                             mat4_translation(vec3(3.0f, -1.0f, 4.0f)));
+    TEST_ASSERT(mat4_near_identity(mat4_mul_mat4(m, mat4_inverse(m)), 1e-5f), "mat4_inverse should invert an affine TRS matrix");
+
+    quat_t back = quat_from_mat4(quat_to_mat4(q));
+    TEST_ASSERT(fabsf(fabsf(quat_dot(q, back)) - 1.0f) < 1e-5f, "quat_from_mat4 should round-trip quat_to_mat4");
+
+    quat_t flip = quat_from_axis_angle(vec3(0.0f, 1.0f, 0.0f), 3.1f);
+    back = quat_from_mat4(quat_to_mat4(flip));
+    TEST_ASSERT(fabsf(fabsf(quat_dot(flip, back)) - 1.0f) < 1e-5f, "quat_from_mat4 should handle near-180 degree rotations");
+}
+
+static void test_weight_quantization(void) {
+    printf("\n--- Weight Quantization Tests ---\n");
+
+    SkinData* skin = skin_data_create(3);
+    TEST_ASSERT_NOT_NULL(skin, "Skin data should be created");
+    TEST_ASSERT_EQUAL(8, (int)sizeof(SkinInfluence), "Influences should pack into 8 bytes");
+
+    uint32_t joints[5] = {7, 3, 9, 1, 4};
+    float weights[5] = {0.04f, 0.5f, 0.1f, 0.3f, 0.06f};
+    skin_data_set_vertex(skin, 0, joints, weights, 5);
+    SkinInfluence* inf = &skin->influences[0];
+    int sum = inf->weights[0] + inf->weights[1] + inf->weights[2] + inf->weights[3];
+    TEST_ASSERT_EQUAL(SKIN_WEIGHT_SCALE, sum, "Quantized weights should sum to exactly 255");
+    TEST_ASSERT(inf->joints[0] == 3 && inf->joints[1] == 1 && inf->joints[2] == 9 && inf->joints[3] == 4,
+                "The four largest influences should be kept, strongest first");
+
+    float thirds[3] = {1.0f, 1.0f, 1.0f};
+    skin_data_set_vertex(skin, 1, joints, thirds, 3);
+    inf = &skin->influences[1];
+    sum = inf->weights[0] + inf->weights[1] + inf->weights[2] + inf->weights[3];
+    TEST_ASSERT(sum == SKIN_WEIGHT_SCALE && inf->weights[3] == 0, "Equal weights should quantize without residual drift");
+
+    float zeros[2] = {0.0f, 0.0f};
+    skin_data_set_vertex(skin, 2, joints, zeros, 2);
+    inf = &skin->influences[2];
+    TEST_ASSERT(inf->joints[0] == 0 && inf->weights[0] == SKIN_WEIGHT_SCALE, "Unweighted vertices should fall back to joint 0");
+
+    skin_data_destroy(skin);
+}
+
+static void test_bind_pose(void) {
+    printf("\n--- Bind Pose Tests ---\n");
+
+    Skeleton* skeleton = skeleton_create(3);
+    skeleton->parents[1] = 0;
+    skeleton->parents[2] = 1;
+    quat_t r = quat_from_axis_angle(vec3(0.0f, 0.0f, 1.0f), 0.7f);
+    mat4_t bind[3];
+    bind[0] = mat4_translation(vec3(0.5f, 0.0f, 0.0f));
+    bind[1] = mat4_mul_mat4(quat_to_mat4(r), mat4_translation(vec3(0.5f, 1.0f, 0.0f)));
+    bind[2] = mat4_mul_mat4(mat4_translation(vec3(0.0f, 1.0f, 0.0f)), bind[1]);
+    skeleton_set_bind_matrices(skeleton, bind);
+    TEST_ASSERT(vec3_near(skeleton->bind_translations[2], vec3(0.0f, 1.0f, 0.0f), 1e-5f), "Local bind translation should be relative to the parent");
+
+    Pose* pose = pose_create(skeleton);
+    TEST_ASSERT_NOT_NULL(pose, "Pose should be created");
+    int identity = 1;
+    for (uint32_t i = 0; i < 3; i++) identity = identity && mat4_near_identity(pose->palette[i], 1e-5f);
+    TEST_ASSERT(identity, "Bind pose palette should be identity");
+
+    Vertex src[3] = {
+        vertex_create_components(0.0f, 0.0f, 0.0f, 0.1f, 0.2f, 1.0f, 0.0f, 0.0f),
+        vertex_create_components(1.0f, 2.0f, 0.0f, 0.3f, 0.4f, 0.0f, 1.0f, 0.0f),
+        vertex_create_components(0.0f, 3.0f, 1.0f, 0.5f, 0.6f, 0.0f, 0.0f, 1.0f),
+    };
+    SkinInfluence influences[3] = {
+        {{0, 0, 0, 0}, {255, 0, 0, 0}},
+        {{0, 1, 0, 0}, {128, 127, 0, 0}},
+        {{0, 1, 2, 0}, {85, 85, 85, 0}},
+    };
+    Vertex out[3];
+    skinning_apply_linear(src, influences, pose->palette, out, 3, NULL);
+    int same = 1;
+    for (int i = 0; i < 3; i++) {
+        same = same && vec3_near(out[i].position, src[i].position, 1e-5f) && vec3_near(out[i].normal, src[i].normal, 1e-5f);
+        same = same && out[i].texcoord.x == src[i].texcoord.x && out[i].texcoord.y == src[i].texcoord.y;
+    }
+    TEST_ASSERT(same, "Linear blend skinning at bind pose should reproduce the input");
+
+    DualQuat dq[3];
+    pose_compute_dual_quat_palette(pose, dq);
+    skinning_apply_dual_quat(src, influences, dq, out, 3, NULL);
+    same = 1;
+    for (int i = 0; i < 3; i++) {
+        same = same && vec3_near(out[i].position, src[i].position, 1e-5f) && vec3_near(out[i].normal, src[i].normal, 1e-5f);
+    }
+    TEST_ASSERT(same, "Dual quaternion skinning at bind pose should reproduce the input");
+
+    pose_destroy(pose);
+    skeleton_destroy(skeleton);
+}
+
+static void test_posed_skinning(void) {
+    printf("\n--- Posed Skinning Tests ---\n");
+
+    Skeleton* skeleton = create_chain_skeleton();
+    Pose* pose = pose_create(skeleton);
+    pose->rotations[1] = quat_from_axis_angle(vec3(0.0f, 0.0f, 1.0f), 1.57079632679f);
+    pose_compute_palette(pose);
+
+    // Rigid vertex on the child, blended vertex half way around the elbow
+    Vertex src[2] = {
+        vertex_create_components(1.0f, 2.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f),
+        vertex_create_components(1.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f),
+    };
+    SkinInfluence influences[2] = {
+        {{1, 0, 0, 0}, {255, 0, 0, 0}},
+        {{0, 1, 0, 0}, {128, 127, 0, 0}},
+    };
+    Vertex lbs[2], dqs[2];
+    skinning_apply_linear(src, influences, pose->palette, lbs, 2, NULL);
+    TEST_ASSERT(vec3_near(lbs[0].position, vec3(-1.0f, 2.0f, 0.0f), 1e-4f), "Rigid vertex should follow the rotated joint (LBS)");
+    TEST_ASSERT(vec3_near(lbs[0].normal, vec3(0.0f, 1.0f, 0.0f), 1e-4f), "Rigid normal should rotate with the joint (LBS)");
+
+    DualQuat dq[2];
+    pose_compute_dual_quat_palette(pose, dq);
+    skinning_apply_dual_quat(src, influences, dq, dqs, 2, NULL);
+    TEST_ASSERT(vec3_near(dqs[0].position, vec3(-1.0f, 2.0f, 0.0f), 1e-4f), "Rigid vertex should follow the rotated joint (DQ)");
+    TEST_ASSERT(vec3_near(dqs[0].normal, vec3(0.0f, 1.0f, 0.0f), 1e-4f), "Rigid normal should rotate with the joint (DQ)");
+
+    // Blending two rotations: LBS collapses towards the pivot, DQ keeps the radius
+    vec3_t pivot = vec3(0.0f, 1.0f, 0.0f);
+    float radius = vec3_distance(src[1].position, pivot);
+    float lbs_radius = vec3_distance(lbs[1].position, pivot);
+    float dq_radius = vec3_distance(dqs[1].position, pivot);
+    printf("Blended vertex radius: bind %.3f, LBS %.3f, DQ %.3f\n", radius, lbs_radius, dq_radius);
+    TEST_ASSERT(lbs_radius < radius * 0.8f, "LBS should lose volume at a 90 degree bend");
+    TEST_ASSERT(fabsf(dq_radius - radius) < 1e-2f, "DQ should preserve distance to the joint");
+
+    pose_destroy(pose);
+    skeleton_destroy(skeleton);
+}
+
+static void test_skinned_instance(void) {
+    printf("\n--- Skinned Instance Tests ---\n");
+
+    Skeleton* skeleton = create_chain_skeleton();
+    Mesh* mesh = mesh_allocate(4, 0);
+    SkinData* skin = skin_data_create(4);
+    for (uint32_t i = 0; i < 4; i++) {
+        mesh->vertices[i] = vertex_create_components(0.5f, (float)i * 0.6f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+        uint32_t joints[2] = {0, 1};
+        float weights[2] = {1.0f - (float)i / 3.0f, (float)i / 3.0f};
+        skin_data_set_vertex(skin, i, joints, weights, 2);
+    }
+
+    SkinnedInstance* a = skinned_instance_create(mesh, skin, skeleton);
+    SkinnedInstance* b = skinned_instance_create(mesh, skin, skeleton);
+    TEST_ASSERT(a && b, "Skinned instances should be created");
+
+    b->pose->rotations[1] = quat_from_axis_angle(vec3(1.0f, 0.0f, 0.0f), 0.5f);
+    skinned_instance_update(a, SKINNING_LINEAR_BLEND, NULL);
+    skinned_instance_update(b, SKINNING_DUAL_QUATERNION, NULL);
+    TEST_ASSERT(vec3_near(a->vertices[3].position, mesh->vertices[3].position, 1e-5f), "Bind pose instance should match the mesh");
+    TEST_ASSERT(!vec3_near(b->vertices[3].position, mesh->vertices[3].position, 1e-3f), "Posed instance should deform independently");
+    TEST_ASSERT(vec3_near(b->vertices[0].position, mesh->vertices[0].position, 1e-5f), "Root-bound vertex should not move");
+
+    SkinData* wrong = skin_data_create(3);
+    TEST_ASSERT(skinned_instance_create(mesh, wrong, skeleton) == NULL, "Mismatched skin should be rejected");
+    skin_data_destroy(wrong);
+
+    skinned_instance_destroy(a);
+    skinned_instance_destroy(b);
+    skin_data_destroy(skin);
+    mesh_free(mesh);
+    free(mesh);
+    skeleton_destroy(skeleton);
+}
+
+static const char* SKINNED_FBX =
+    "; FBX 7.4.0 project file\n"
+    "Objects:  {\n"
+    "\tGeometry: 100, \"Geometry::Strip\", \"Mesh\" {\n"
+    "\t\tVertices: *12 {\n"
+    "\t\t\ta: -1,0,0,1,0,0,1,2,0,-1,2,0\n"
+    "\t\t}\n"
+    "\t\tPolygonVertexIndex: *4 {\n"
+    "\t\t\ta: 0,1,2,-4\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tModel: 200, \"Model::Root\", \"LimbNode\" {\n"
+    "\t\tProperties70:  {\n"
+    "\t\t\tP: \"Lcl Translation\", \"Lcl Translation\", \"\", \"A\",0,0,0\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tModel: 201, \"Model::Bone\", \"LimbNode\" {\n"
+    "\t\tProperties70:  {\n"
+    "\t\t\tP: \"Lcl Translation\", \"Lcl Translation\", \"\", \"A\",0,1,0\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tDeformer: 300, \"Deformer::Skin\", \"Skin\" {\n"
+    "\t\tVersion: 101\n"
+    "\t}\n"
+    "\tDeformer: 301, \"SubDeformer::Root\", \"Cluster\" {\n"
+    "\t\tIndexes: *3 {\n"
+    "\t\t\ta: 0,1,2\n"
+    "\t\t}\n"
+    "\t\tWeights: *3 {\n"
+    "\t\t\ta: 1,1,0.25\n"
+    "\t\t}\n"
+    "\t\tTransform: *16 {\n"
+    "\t\t\ta: 1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1\n"
+    "\t\t}\n"
+    "\t\tTransformLink: *16 {\n"
+    "\t\t\ta: 1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1\n"
+    "\t\t}\n"
+    "\t}\n"
+    "\tDeformer: 302, \"SubDeformer::Bone\", \"Cluster\" {\n"
+    "\t\tIndexes: *2 {\n"
+    "\t\t\ta: 2,3\n"
+    "\t\t}\n"
+    "\t\tWeights: *2 {\n"
+    "\t\t\ta: 0.75,1\n"
+    "\t\t}\n"
+    "\t\tTransform: *16 {\n"
+    "\t\t\ta: 1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1\n"
+    "\t\t}\n"
+    "\t\tTransformLink: *16 {\n"
+    "\t\t\ta: 1,0,0,0,0,1,0,0,0,0,1,0,0,1,0,1\n"
+    "\t\t}\n"
+    "\t}\n"
+    "}\n"
+    "Connections:  {\n"
+    "\tC: \"OO\",200,0\n"
+    "\tC: \"OO\",201,200\n"
+    "\tC: \"OO\",300,100\n"
+    "\tC: \"OO\",301,300\n"
+    "\tC: \"OO\",302,300\n"
+    "\tC: \"OO\",200,301\n"
+    "\tC: \"OO\",201,302\n"
+    "}\n";
+
+static void test_fbx_skin_import(void) {
+    printf("\n--- FBX Skin Import Tests ---\n");
+
+    const char* path = "/tmp/engine_skinning_test.fbx";
+    FILE* f = fopen(path, "w");
+    TEST_ASSERT_NOT_NULL(f, "Temporary FBX file should be writable");
+    if (!f) return;
+    fputs(SKINNED_FBX, f);
+    fclose(f);
+
+    Skeleton* skeleton = NULL;
+    SkinData* skin = NULL;
+    char* err = NULL;
+    Model3D* model = fbx_load_skinned_model(path, &skeleton, &skin, &err);
+    TEST_ASSERT_NOT_NULL(model, "Skinned FBX should load");
+    if (!model) {
+        printf("  error: %s\n", err ? err : "(none)");
+        fbx_free_error(err);
+        return;
+    }
+
+    TEST_ASSERT_EQUAL(2u, skeleton->joint_count, "Skeleton should have two joints");
+    int32_t root = skeleton_find_joint(skeleton, "Root");
+    int32_t bone = skeleton_find_joint(skeleton, "Bone");
+    TEST_ASSERT(root >= 0 && bone >= 0 && skeleton->parents[bone] == root, "Bone should be parented to Root");
+    TEST_ASSERT(vec3_near(skeleton->bind_translations[bone], vec3(0.0f, 1.0f, 0.0f), 1e-5f), "Bind pose should come from TransformLink");
+    TEST_ASSERT_EQUAL(model->meshes[0].vertex_count, skin->vertex_count, "Skin should cover every output vertex");
+    skeleton_print("Imported skeleton", skeleton);
+
+    // Control point 2 (1,2,0) is weighted 0.25 Root / 0.75 Bone
+    int found = 0;
+    for (uint32_t v = 0; v < skin->vertex_count; v++) {
+        vec3_t p = model->meshes[0].vertices[v].position;
+        if (!vec3_near(p, vec3(1.0f, 2.0f, 0.0f), 1e-6f)) continue;
+        const SkinInfluence* inf = &skin->influences[v];
+        found = inf->joints[0] == (uint8_t)bone && inf->weights[0] == 191 &&
+                inf->joints[1] == (uint8_t)root && inf->weights[1] == 64;
+        break;
+    }
+    TEST_ASSERT(found, "Cluster weights should map to the vertices of their control point");
+
+    SkinnedInstance* instance = skinned_instance_create(&model->meshes[0], skin, skeleton);
+    instance->pose->rotations[bone] = quat_from_axis_angle(vec3(0.0f, 0.0f, 1.0f), 1.57079632679f);
+    skinned_instance_update(instance, SKINNING_LINEAR_BLEND, NULL);
+    int moved = 0;
+    for (uint32_t v = 0; v < instance->vertex_count; v++) {
+        vec3_t p = model->meshes[0].vertices[v].position;
+        if (vec3_near(p, vec3(-1.0f, 2.0f, 0.0f), 1e-6f)) {
+            moved = vec3_near(instance->vertices[v].position, vec3(-1.0f, 0.0f, 0.0f), 1e-4f);
+        }
+    }
+    TEST_ASSERT(moved, "Imported skin should deform with the pose");
+
+    skinned_instance_destroy(instance);
+    skin_data_destroy(skin);
+    skeleton_destroy(skeleton);
+    model3d_free(model);
+    free(model);
+    remove(path);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t vertex_count = 100000;
+    const uint32_t joint_count = 64;
+    const int iterations = 50;
+
+    Skeleton* skeleton = skeleton_create(joint_count);
+    mat4_t* bind = (mat4_t*)malloc(joint_count * sizeof(mat4_t));
+    for (uint32_t j = 0; j < joint_count; j++) {
+        skeleton->parents[j] = (int32_t)j - 1;
+        bind[j] = mat4_translation(vec3(0.0f, (float)j * 0.1f, 0.0f));
+    }
+    skeleton_set_bind_matrices(skeleton, bind);
+    free(bind);
+
+    Pose* pose = pose_create(skeleton);
+    for (uint32_t j = 0; j < joint_count; j++) {
+        pose->rotations[j] = quat_from_axis_angle(vec3_normalize(vec3(1.0f, 0.3f, (float)(j % 3))), 0.05f);
+    }
+    pose_compute_palette(pose);
+    DualQuat* dq = (DualQuat*)malloc(joint_count * sizeof(DualQuat));
+    pose_compute_dual_quat_palette(pose, dq);
+
+    Vertex* src = (Vertex*)malloc(vertex_count * sizeof(Vertex));
+    Vertex* out_serial = (Vertex*)malloc(vertex_count * sizeof(Vertex));
+    Vertex* out_parallel = (Vertex*)malloc(vertex_count * sizeof(Vertex));
+    SkinData* skin = skin_data_create(vertex_count);
+    uint32_t rng = 12345;
+    for (uint32_t i = 0; i < vertex_count; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        float y = (float)(rng >> 8) / 16777216.0f * 6.4f;
+        src[i] = vertex_create_components(0.3f, y, 0.1f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f);
+        uint32_t base = (uint32_t)(y * 10.0f) % joint_count;
+        uint32_t joints[4] = {base, (base + 1) % joint_count, (base + 2) % joint_count, (base + 3) % joint_count};
+        float weights[4] = {0.5f, 0.25f, 0.15f, 0.1f};
+        skin_data_set_vertex(skin, i, joints, weights, 4);
+    }
+
+    JobSystemHandle jobs = job_system_create(0);
+    const char* mode_names[2] = {"LBS", "DQ"};
+    for (int mode = 0; mode < 2; mode++) {
+        for (int pass = 0; pass < 2; pass++) {
+            JobSystemHandle pass_jobs = pass == 0 ? NULL : jobs;
+            Vertex* out = pass == 0 ? out_serial : out_parallel;
+            double best = 1e9, total = 0.0;
+            for (int it = 0; it < iterations; it++) {
+                double start = now_ms();
+                if (mode == 0) {
+                    skinning_apply_linear(src, skin->influences, pose->palette, out, vertex_count, pass_jobs);
+                } else {
+                    skinning_apply_dual_quat(src, skin->influences, dq, out, vertex_count, pass_jobs);
+                }
+                double elapsed = now_ms() - start;
+                total += elapsed;
+                if (elapsed < best) best = elapsed;
+            }
+            printf("%s %s (%u workers): avg %.3f ms, best %.3f ms, %.0f vertices/ms\n",
+                   mode_names[mode], pass == 0 ? "serial" : "parallel", job_system_get_worker_count(pass_jobs),
+                   total / iterations, best, (double)vertex_count / (total / iterations));
+        }
+        TEST_ASSERT(memcmp(out_serial, out_parallel, vertex_count * sizeof(Vertex)) == 0,
+                    mode == 0 ? "Parallel LBS should match serial output" : "Parallel DQ should match serial output");
+    }
+
+    job_system_destroy(jobs);
+    skin_data_destroy(skin);
+    free(src);
+    free(out_serial);
+    free(out_parallel);
+    free(dq);
+    pose_destroy(pose);
+    skeleton_destroy(skeleton);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Skinning Unit Tests\n");
+    printf("===================================\n");
+
+    test_math_helpers();
+    test_weight_quantization();
+    test_bind_pose();
+    test_posed_skinning();
+    test_skinned_instance();
+    test_fbx_skin_import();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
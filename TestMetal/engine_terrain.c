@@ -0,0 +1,669 @@
+#include "engine_terrain.h"
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ============================================================================
+// FILE LAYOUT
+// ============================================================================
+
+// Tile placement of every mip of a header
+typedef struct {
+    uint32_t first_tile[TERRAIN_MAX_LODS];
+    uint32_t tiles_per_side[TERRAIN_MAX_LODS];
+    uint32_t tile_size[TERRAIN_MAX_LODS];
+    uint32_t tile_shift[TERRAIN_MAX_LODS];
+    uint32_t node_count;        // Nodes across all LODs
+} TerrainLayout;
+
+FORCE_INLINE uint64_t align_up(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+FORCE_INLINE int is_power_of_two(uint32_t v) {
+    return v && !(v & (v - 1));
+}
+
+FORCE_INLINE uint32_t log2_u32(uint32_t v) {
+    uint32_t r = 0;
+    while (v > 1) {
+        v >>= 1;
+        r++;
+    }
+    return r;
+}
+
+static void compute_layout(const TerrainFileHeader* header, TerrainLayout* layout) {
+    uint32_t tiles = 0;
+    layout->node_count = 0;
+    for (uint32_t m = 0; m < header->lod_count; m++) {
+        uint32_t mip_size = header->size >> m;
+        uint32_t tile_size = header->tile_size < mip_size ? header->tile_size : mip_size;
+        layout->first_tile[m] = tiles;
+        layout->tile_size[m] = tile_size;
+        layout->tile_shift[m] = log2_u32(tile_size);
+        layout->tiles_per_side[m] = mip_size / tile_size;
+        tiles += layout->tiles_per_side[m] * layout->tiles_per_side[m];
+
+        uint32_t nodes = header->size / (header->leaf_size << m);
+        layout->node_count += nodes * nodes;
+    }
+}
+
+// Height sample (x, z) of one mip, reading through its tile
+FORCE_INLINE const uint16_t* tile_data(const uint8_t* tiles, uint32_t stride, const TerrainLayout* layout,
+                                       uint32_t mip, uint32_t tile_x, uint32_t tile_z) {
+    uint32_t tile = layout->first_tile[mip] + tile_z * layout->tiles_per_side[mip] + tile_x;
+    return (const uint16_t*)(tiles + (size_t)tile * stride);
+}
+
+FORCE_INLINE uint16_t layout_sample(const uint8_t* tiles, uint32_t stride, const TerrainLayout* layout,
+                                    uint32_t mip, uint32_t x, uint32_t z) {
+    uint32_t shift = layout->tile_shift[mip];
+    uint32_t mask = layout->tile_size[mip] - 1;
+    const uint16_t* data = tile_data(tiles, stride, layout, mip, x >> shift, z >> shift);
+    return data[((z & mask) << shift) + (x & mask)];
+}
+
+// ============================================================================
+// TERRAIN BUILD FUNCTIONS
+// ============================================================================
+
+TerrainBuildDesc terrain_build_desc_default(void) {
+    TerrainBuildDesc desc;
+    desc.size = 4096;
+    desc.tile_size = 256;
+    desc.leaf_size = 64;
+    desc.sample_spacing = 1.0f;
+    desc.height_scale = 512.0f / 65535.0f;
+    return desc;
+}
+
+int terrain_build_file(const char* path, const TerrainBuildDesc* desc, TerrainHeightFunc height_func, void* user_data) {
+    if (!path || !desc || !height_func) {
+        fprintf(stderr, "Error: Invalid terrain build parameters\n");
+        return 0;
+    }
+    if (!is_power_of_two(desc->size) || !is_power_of_two(desc->tile_size) ||
+        !is_power_of_two(desc->leaf_size) || desc->leaf_size > desc->size || desc->leaf_size < 2) {
+        fprintf(stderr, "Error: Terrain size, tile and leaf sizes must be powers of two (leaf <= size)\n");
+        return 0;
+    }
+    uint32_t lod_count = log2_u32(desc->size / desc->leaf_size) + 1;
+    if (lod_count > TERRAIN_MAX_LODS) {
+        fprintf(stderr, "Error: Terrain needs %u LODs (max %d); use larger leaves\n", lod_count, TERRAIN_MAX_LODS);
+        return 0;
+    }
+
+    TerrainFileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = TERRAIN_FILE_MAGIC;
+    header.version = TERRAIN_FILE_VERSION;
+    header.size = desc->size;
+    header.tile_size = desc->tile_size;
+    header.leaf_size = desc->leaf_size;
+    header.lod_count = lod_count;
+    header.sample_spacing = desc->sample_spacing;
+    header.height_scale = desc->height_scale;
+
+    TerrainLayout layout;
+    compute_layout(&header, &layout);
+    uint32_t last = lod_count - 1;
+    header.tile_count = layout.first_tile[last] + layout.tiles_per_side[last] * layout.tiles_per_side[last];
+    header.tile_stride = (uint32_t)align_up((uint64_t)desc->tile_size * desc->tile_size * sizeof(uint16_t),
+                                            TERRAIN_FILE_ALIGNMENT);
+    header.minmax_offset = align_up(sizeof(TerrainFileHeader), 64);
+    header.tiles_offset = align_up(header.minmax_offset + (uint64_t)layout.node_count * 2 * sizeof(uint16_t),
+                                   TERRAIN_FILE_ALIGNMENT);
+    uint64_t file_size = header.tiles_offset + (uint64_t)header.tile_count * header.tile_stride;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot create terrain file %s\n", path);
+        return 0;
+    }
+    if (ftruncate(fd, (off_t)file_size) != 0) {
+        fprintf(stderr, "Error: Cannot size terrain file %s\n", path);
+        close(fd);
+        return 0;
+    }
+    uint8_t* mapping = (uint8_t*)mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map terrain file %s\n", path);
+        close(fd);
+        return 0;
+    }
+
+    memcpy(mapping, &header, sizeof(header));
+    uint8_t* tiles = mapping + header.tiles_offset;
+
+    // Mip 0 from the height function, one tile at a time
+    for (uint32_t tz = 0; tz < layout.tiles_per_side[0]; tz++) {
+        for (uint32_t tx = 0; tx < layout.tiles_per_side[0]; tx++) {
+            uint16_t* data = (uint16_t*)tile_data(tiles, header.tile_stride, &layout, 0, tx, tz);
+            uint32_t ts = layout.tile_size[0];
+            for (uint32_t z = 0; z < ts; z++) {
+                for (uint32_t x = 0; x < ts; x++) {
+                    data[z * ts + x] = height_func(user_data, tx * ts + x, tz * ts + z);
+                }
+            }
+        }
+    }
+
+    // Coarser mips keep every other sample, so a fully morphed vertex of
+    // LOD m lands exactly on a sample of mip m + 1
+    for (uint32_t m = 1; m < lod_count; m++) {
+        uint32_t ts = layout.tile_size[m];
+        for (uint32_t tz = 0; tz < layout.tiles_per_side[m]; tz++) {
+            for (uint32_t tx = 0; tx < layout.tiles_per_side[m]; tx++) {
+                uint16_t* data = (uint16_t*)tile_data(tiles, header.tile_stride, &layout, m, tx, tz);
+                for (uint32_t z = 0; z < ts; z++) {
+                    for (uint32_t x = 0; x < ts; x++) {
+                        data[z * ts + x] = layout_sample(tiles, header.tile_stride, &layout, m - 1,
+                                                         (tx * ts + x) * 2, (tz * ts + z) * 2);
+                    }
+                }
+            }
+        }
+    }
+
+    // Leaf min/max over each node's samples including its far edge, then
+    // every parent from its four children
+    uint16_t* minmax = (uint16_t*)(mapping + header.minmax_offset);
+    uint32_t leaves = desc->size / desc->leaf_size;
+    for (uint32_t nz = 0; nz < leaves; nz++) {
+        for (uint32_t nx = 0; nx < leaves; nx++) {
+            uint32_t x0 = nx * desc->leaf_size, z0 = nz * desc->leaf_size;
+            uint32_t x1 = x0 + desc->leaf_size < desc->size ? x0 + desc->leaf_size : desc->size - 1;
+            uint32_t z1 = z0 + desc->leaf_size < desc->size ? z0 + desc->leaf_size : desc->size - 1;
+            uint16_t lo = 0xFFFF, hi = 0;
+            for (uint32_t z = z0; z <= z1; z++) {
+                for (uint32_t x = x0; x <= x1; x++) {
+                    uint16_t h = layout_sample(tiles, header.tile_stride, &layout, 0, x, z);
+                    if (h < lo) lo = h;
+                    if (h > hi) hi = h;
+                }
+            }
+            minmax[(nz * leaves + nx) * 2 + 0] = lo;
+            minmax[(nz * leaves + nx) * 2 + 1] = hi;
+        }
+    }
+    uint16_t* child = minmax;
+    uint32_t child_side = leaves;
+    for (uint32_t lod = 1; lod < lod_count; lod++) {
+        uint16_t* parent = child + child_side * child_side * 2;
+        uint32_t side = child_side / 2;
+        for (uint32_t nz = 0; nz < side; nz++) {
+            for (uint32_t nx = 0; nx < side; nx++) {
+                uint16_t lo = 0xFFFF, hi = 0;
+                for (uint32_t c = 0; c < 4; c++) {
+                    uint32_t cx = nx * 2 + (c & 1), cz = nz * 2 + (c >> 1);
+                    const uint16_t* pair = child + (cz * child_side + cx) * 2;
+                    if (pair[0] < lo) lo = pair[0];
+                    if (pair[1] > hi) hi = pair[1];
+                }
+                parent[(nz * side + nx) * 2 + 0] = lo;
+                parent[(nz * side + nx) * 2 + 1] = hi;
+            }
+        }
+        child = parent;
+        child_side = side;
+    }
+
+    int ok = msync(mapping, file_size, MS_SYNC) == 0;
+    munmap(mapping, file_size);
+    close(fd);
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write terrain file %s\n", path);
+    }
+    return ok;
+}
+
+// ============================================================================
+// TERRAIN FUNCTIONS
+// ============================================================================
+
+Terrain* terrain_open(const char* path, uint32_t max_instances) {
+    if (!path || max_instances == 0) {
+        fprintf(stderr, "Error: Invalid terrain open parameters\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open terrain file %s\n", path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TerrainFileHeader)) {
+        fprintf(stderr, "Error: Terrain file %s is too small\n", path);
+        close(fd);
+        return NULL;
+    }
+    uint8_t* mapping = (uint8_t*)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map terrain file %s\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    const TerrainFileHeader* header = (const TerrainFileHeader*)mapping;
+    TerrainLayout layout;
+    int valid = header->magic == TERRAIN_FILE_MAGIC && header->version == TERRAIN_FILE_VERSION &&
+                header->lod_count > 0 && header->lod_count <= TERRAIN_MAX_LODS &&
+                is_power_of_two(header->size) && is_power_of_two(header->tile_size) &&
+                is_power_of_two(header->leaf_size) &&
+                header->size == header->leaf_size << (header->lod_count - 1);
+    if (valid) {
+        compute_layout(header, &layout);
+        valid = header->tiles_offset + (uint64_t)header->tile_count * header->tile_stride <= (uint64_t)st.st_size;
+    }
+    if (!valid) {
+        fprintf(stderr, "Error: %s is not a valid terrain file\n", path);
+        munmap(mapping, (size_t)st.st_size);
+        close(fd);
+        return NULL;
+    }
+
+    Terrain* terrain = (Terrain*)calloc(1, sizeof(Terrain));
+    if (!terrain) {
+        fprintf(stderr, "Error: Failed to allocate memory for terrain\n");
+        munmap(mapping, (size_t)st.st_size);
+        close(fd);
+        return NULL;
+    }
+    terrain->fd = fd;
+    terrain->mapping = mapping;
+    terrain->mapping_size = (size_t)st.st_size;
+    terrain->header = header;
+
+    const uint16_t* minmax = (const uint16_t*)(mapping + header->minmax_offset);
+    for (uint32_t lod = 0; lod < header->lod_count; lod++) {
+        terrain->minmax[lod] = minmax;
+        terrain->nodes_per_side[lod] = header->size / (header->leaf_size << lod);
+        minmax += terrain->nodes_per_side[lod] * terrain->nodes_per_side[lod] * 2;
+        terrain->mip_first_tile[lod] = layout.first_tile[lod];
+        terrain->mip_tiles_per_side[lod] = layout.tiles_per_side[lod];
+        terrain->mip_tile_size[lod] = layout.tile_size[lod];
+    }
+
+    terrain->tile_last_used = (uint32_t*)calloc(header->tile_count, sizeof(uint32_t));
+    terrain->instances = (TerrainInstance*)malloc(max_instances * sizeof(TerrainInstance));
+    if (!terrain->tile_last_used || !terrain->instances) {
+        fprintf(stderr, "Error: Failed to allocate memory for terrain\n");
+        terrain_close(terrain);
+        return NULL;
+    }
+    terrain->instance_capacity = max_instances;
+
+    // Tiles are paged in explicitly by terrain_stream; no readahead
+    madvise(mapping, terrain->mapping_size, MADV_RANDOM);
+
+    float leaf_world = (float)header->leaf_size * header->sample_spacing;
+    terrain_set_lod_distances(terrain, leaf_world * 4.0f, 0.3f);
+
+    fprintf(stderr, "Opened terrain %s: %ux%u samples, %u LODs, %u tiles\n",
+            path, header->size, header->size, header->lod_count, header->tile_count);
+    return terrain;
+}
+
+void terrain_close(Terrain* terrain) {
+    if (!terrain) {
+        return;
+    }
+    if (terrain->mapping) {
+        munmap(terrain->mapping, terrain->mapping_size);
+    }
+    if (terrain->fd >= 0) {
+        close(terrain->fd);
+    }
+    free(terrain->tile_last_used);
+    free(terrain->instances);
+    free(terrain);
+}
+
+void terrain_set_lod_distances(Terrain* terrain, float detail_distance, float morph_ratio) {
+    if (!terrain) {
+        return;
+    }
+    if (morph_ratio < 0.01f) morph_ratio = 0.01f;
+    if (morph_ratio > 0.9f) morph_ratio = 0.9f;
+
+    // A LOD l node only borders LOD l + 1 nodes within range[l] plus the
+    // diagonal of its parent, and those must not have started morphing yet:
+    // range[l] * (1 - morph_ratio) >= diagonal(LOD l + 1). Raise the detail
+    // distance until that holds for the tallest node of every level.
+    const TerrainFileHeader* header = terrain->header;
+    for (uint32_t lod = 1; lod < header->lod_count; lod++) {
+        uint32_t count = terrain->nodes_per_side[lod] * terrain->nodes_per_side[lod];
+        uint16_t span = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            uint16_t node_span = terrain->minmax[lod][i * 2 + 1] - terrain->minmax[lod][i * 2];
+            if (node_span > span) span = node_span;
+        }
+        float size = (float)(header->leaf_size << lod) * header->sample_spacing;
+        float height = (float)span * header->height_scale;
+        float diagonal = sqrtf(2.0f * size * size + height * height);
+        float minimum = diagonal / ((1.0f - morph_ratio) * (float)(1u << (lod - 1)));
+        if (detail_distance < minimum) detail_distance = minimum;
+    }
+
+    float previous = 0.0f;
+    float range = detail_distance;
+    for (uint32_t lod = 0; lod < terrain->header->lod_count; lod++) {
+        terrain->lods[lod].range = range;
+        terrain->lods[lod].morph_start = range - (range - previous) * morph_ratio;
+        previous = range;
+        range *= 2.0f;
+    }
+}
+
+// ============================================================================
+// SELECTION
+// ============================================================================
+
+typedef enum {
+    SELECT_DONE = 0,            // Drawn, subdivided or culled
+    SELECT_OUT_OF_RANGE = 1     // Too far for this LOD; the parent draws it
+} TerrainSelectResult;
+
+typedef struct {
+    Terrain* terrain;
+    vec3_t camera;
+    frustum_t frustum;
+} TerrainSelectContext;
+
+static void node_bounds(const Terrain* terrain, uint32_t lod, uint32_t nx, uint32_t nz,
+                        vec3_t* out_min, vec3_t* out_max) {
+    const TerrainFileHeader* header = terrain->header;
+    float size = (float)(header->leaf_size << lod) * header->sample_spacing;
+    const uint16_t* pair = terrain->minmax[lod] + (nz * terrain->nodes_per_side[lod] + nx) * 2;
+    *out_min = vec3((float)nx * size, (float)pair[0] * header->height_scale, (float)nz * size);
+    *out_max = vec3((float)(nx + 1) * size, (float)pair[1] * header->height_scale, (float)(nz + 1) * size);
+}
+
+FORCE_INLINE int sphere_intersects_box(vec3_t center, float radius, vec3_t min, vec3_t max) {
+    float dx = fmaxf(fmaxf(min.x - center.x, center.x - max.x), 0.0f);
+    float dy = fmaxf(fmaxf(min.y - center.y, center.y - max.y), 0.0f);
+    float dz = fmaxf(fmaxf(min.z - center.z, center.z - max.z), 0.0f);
+    return dx * dx + dy * dy + dz * dz <= radius * radius;
+}
+
+static void emit_node(Terrain* terrain, uint32_t lod, uint32_t nx, uint32_t nz) {
+    if (terrain->instance_count >= terrain->instance_capacity) {
+        terrain->stats.nodes_dropped++;
+        return;
+    }
+    float size = (float)(terrain->header->leaf_size << lod) * terrain->header->sample_spacing;
+    TerrainInstance* instance = &terrain->instances[terrain->instance_count++];
+    instance->origin_x = (float)nx * size;
+    instance->origin_z = (float)nz * size;
+    instance->size = size;
+    instance->lod = lod;
+    terrain->stats.nodes_selected++;
+    terrain->stats.lod_counts[lod]++;
+}
+
+// CDLOD selection: a node in its own range is drawn whole unless it also
+// reaches into the next finer range, in which case children that do are
+// refined and children that do not are drawn at their own (fully morphed)
+// LOD, which matches the parent's grid
+static TerrainSelectResult select_node(TerrainSelectContext* ctx, uint32_t lod, uint32_t nx, uint32_t nz) {
+    Terrain* terrain = ctx->terrain;
+    terrain->stats.nodes_visited++;
+
+    vec3_t bmin, bmax;
+    node_bounds(terrain, lod, nx, nz, &bmin, &bmax);
+    if (!frustum_test_aabb(&ctx->frustum, bmin, bmax)) {
+        terrain->stats.nodes_culled++;
+        return SELECT_DONE;
+    }
+    if (!sphere_intersects_box(ctx->camera, terrain->lods[lod].range, bmin, bmax)) {
+        return SELECT_OUT_OF_RANGE;
+    }
+    if (lod == 0 || !sphere_intersects_box(ctx->camera, terrain->lods[lod - 1].range, bmin, bmax)) {
+        emit_node(terrain, lod, nx, nz);
+        return SELECT_DONE;
+    }
+
+    for (uint32_t c = 0; c < 4; c++) {
+        uint32_t cx = nx * 2 + (c & 1), cz = nz * 2 + (c >> 1);
+        if (select_node(ctx, lod - 1, cx, cz) == SELECT_OUT_OF_RANGE) {
+            emit_node(terrain, lod - 1, cx, cz);
+        }
+    }
+    return SELECT_DONE;
+}
+
+uint32_t terrain_select(Terrain* terrain, vec3_t camera_position, mat4_t view_projection) {
+    if (!terrain) {
+        return 0;
+    }
+
+    TerrainStats* stats = &terrain->stats;
+    uint32_t tiles_resident = stats->tiles_resident;
+    memset(stats, 0, sizeof(*stats));
+    stats->tiles_resident = tiles_resident;
+    terrain->instance_count = 0;
+
+    TerrainSelectContext ctx;
+    ctx.terrain = terrain;
+    ctx.camera = camera_position;
+    ctx.frustum = frustum_from_matrix(view_projection);
+
+    uint32_t root = terrain->header->lod_count - 1;
+    if (select_node(&ctx, root, 0, 0) == SELECT_OUT_OF_RANGE) {
+        emit_node(terrain, root, 0, 0);
+    }
+    return terrain->instance_count;
+}
+
+// ============================================================================
+// STREAMING
+// ============================================================================
+
+static void advise_tile(const Terrain* terrain, uint32_t tile, int advice) {
+    static long page_size = 0;
+    if (page_size == 0) {
+        page_size = sysconf(_SC_PAGESIZE);
+        if (page_size <= 0) page_size = 4096;
+    }
+    const TerrainFileHeader* header = terrain->header;
+    uintptr_t begin = (uintptr_t)(terrain->mapping + header->tiles_offset + (size_t)tile * header->tile_stride);
+    uintptr_t end = begin + header->tile_stride;
+    begin &= ~(uintptr_t)(page_size - 1);
+    madvise((void*)begin, end - begin, advice);
+}
+
+void terrain_stream(Terrain* terrain) {
+    if (!terrain) {
+        return;
+    }
+
+    const TerrainFileHeader* header = terrain->header;
+    uint32_t frame = ++terrain->frame;
+    terrain->stats.tiles_requested = 0;
+    terrain->stats.tiles_evicted = 0;
+
+    // A LOD l node reads a (leaf_size + 1)^2 block of mip l
+    for (uint32_t i = 0; i < terrain->instance_count; i++) {
+        const TerrainInstance* instance = &terrain->instances[i];
+        uint32_t mip = instance->lod;
+        float mip_spacing = header->sample_spacing * (float)(1u << mip);
+        uint32_t mip_size = header->size >> mip;
+        uint32_t x0 = (uint32_t)(instance->origin_x / mip_spacing + 0.5f);
+        uint32_t z0 = (uint32_t)(instance->origin_z / mip_spacing + 0.5f);
+        uint32_t x1 = x0 + header->leaf_size < mip_size ? x0 + header->leaf_size : mip_size - 1;
+        uint32_t z1 = z0 + header->leaf_size < mip_size ? z0 + header->leaf_size : mip_size - 1;
+        uint32_t shift = log2_u32(terrain->mip_tile_size[mip]);
+
+        for (uint32_t tz = z0 >> shift; tz <= z1 >> shift; tz++) {
+            for (uint32_t tx = x0 >> shift; tx <= x1 >> shift; tx++) {
+                uint32_t tile = terrain->mip_first_tile[mip] + tz * terrain->mip_tiles_per_side[mip] + tx;
+                if (terrain->tile_last_used[tile] == 0) {
+                    advise_tile(terrain, tile, MADV_WILLNEED);
+                    terrain->stats.tiles_requested++;
+                    terrain->stats.tiles_resident++;
+                }
+                terrain->tile_last_used[tile] = frame;
+            }
+        }
+    }
+
+    for (uint32_t tile = 0; tile < header->tile_count; tile++) {
+        uint32_t last_used = terrain->tile_last_used[tile];
+        if (last_used != 0 && frame - last_used > TERRAIN_TILE_EVICT_FRAMES) {
+            advise_tile(terrain, tile, MADV_DONTNEED);
+            terrain->tile_last_used[tile] = 0;
+            terrain->stats.tiles_evicted++;
+            terrain->stats.tiles_resident--;
+        }
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+const uint16_t* terrain_get_tile(const Terrain* terrain, uint32_t mip, uint32_t tile_x, uint32_t tile_z) {
+    if (!terrain || mip >= terrain->header->lod_count ||
+        tile_x >= terrain->mip_tiles_per_side[mip] || tile_z >= terrain->mip_tiles_per_side[mip]) {
+        return NULL;
+    }
+    uint32_t tile = terrain->mip_first_tile[mip] + tile_z * terrain->mip_tiles_per_side[mip] + tile_x;
+    return (const uint16_t*)(terrain->mapping + terrain->header->tiles_offset + (size_t)tile * terrain->header->tile_stride);
+}
+
+FORCE_INLINE float mip_sample(const Terrain* terrain, uint32_t mip, uint32_t x, uint32_t z) {
+    uint32_t tile_size = terrain->mip_tile_size[mip];
+    uint32_t shift = log2_u32(tile_size);
+    const uint16_t* data = terrain_get_tile(terrain, mip, x >> shift, z >> shift);
+    return (float)data[((z & (tile_size - 1)) << shift) + (x & (tile_size - 1))];
+}
+
+// Bilinear height of one mip at sample coordinates (u, v), in world units
+static float mip_height(const Terrain* terrain, uint32_t mip, float u, float v) {
+    uint32_t last = (terrain->header->size >> mip) - 1;
+    if (u < 0.0f) u = 0.0f;
+    if (v < 0.0f) v = 0.0f;
+    if (u > (float)last) u = (float)last;
+    if (v > (float)last) v = (float)last;
+
+    uint32_t x0 = (uint32_t)u, z0 = (uint32_t)v;
+    uint32_t x1 = x0 < last ? x0 + 1 : last;
+    uint32_t z1 = z0 < last ? z0 + 1 : last;
+    float fx = u - (float)x0, fz = v - (float)z0;
+    float h00 = mip_sample(terrain, mip, x0, z0), h10 = mip_sample(terrain, mip, x1, z0);
+    float h01 = mip_sample(terrain, mip, x0, z1), h11 = mip_sample(terrain, mip, x1, z1);
+    float h = (h00 + (h10 - h00) * fx) + ((h01 + (h11 - h01) * fx) - (h00 + (h10 - h00) * fx)) * fz;
+    return h * terrain->header->height_scale;
+}
+
+float terrain_get_height(const Terrain* terrain, float x, float z) {
+    if (!terrain) {
+        return 0.0f;
+    }
+    float spacing = terrain->header->sample_spacing;
+    return mip_height(terrain, 0, x / spacing, z / spacing);
+}
+
+void terrain_get_bounds(const Terrain* terrain, vec3_t* out_min, vec3_t* out_max) {
+    if (!terrain) {
+        return;
+    }
+    vec3_t bmin, bmax;
+    node_bounds(terrain, terrain->header->lod_count - 1, 0, 0, &bmin, &bmax);
+    if (out_min) *out_min = bmin;
+    if (out_max) *out_max = bmax;
+}
+
+vec3_t terrain_morph_vertex(const Terrain* terrain, const TerrainInstance* instance,
+                            uint32_t gx, uint32_t gz, vec3_t camera_position) {
+    if (!terrain || !instance) {
+        return vec3_zero();
+    }
+
+    const TerrainFileHeader* header = terrain->header;
+    float grid = (float)header->leaf_size;
+    float mip_spacing = header->sample_spacing * (float)(1u << instance->lod);
+    const TerrainLod* lod = &terrain->lods[instance->lod];
+
+    // Morph factor from the unmorphed vertex's distance to the camera
+    float x = instance->origin_x + (float)gx / grid * instance->size;
+    float z = instance->origin_z + (float)gz / grid * instance->size;
+    vec3_t p = vec3(x, mip_height(terrain, instance->lod, x / mip_spacing, z / mip_spacing), z);
+    float k = (vec3_distance(p, camera_position) - lod->morph_start) / (lod->range - lod->morph_start);
+    if (k < 0.0f) k = 0.0f;
+    if (k > 1.0f) k = 1.0f;
+
+    // Odd grid vertices slide onto their even neighbour
+    float mx = (float)gx - (float)(gx & 1u) * k;
+    float mz = (float)gz - (float)(gz & 1u) * k;
+    x = instance->origin_x + mx / grid * instance->size;
+    z = instance->origin_z + mz / grid * instance->size;
+    return vec3(x, mip_height(terrain, instance->lod, x / mip_spacing, z / mip_spacing), z);
+}
+
+Mesh* terrain_create_grid_mesh(uint32_t resolution) {
+    if (resolution == 0) {
+        fprintf(stderr, "Error: Terrain grid resolution must be positive\n");
+        return NULL;
+    }
+
+    uint32_t side = resolution + 1;
+    Mesh* mesh = mesh_allocate(side * side, resolution * resolution * 6);
+    if (!mesh) {
+        return NULL;
+    }
+
+    float inv = 1.0f / (float)resolution;
+    for (uint32_t z = 0; z < side; z++) {
+        for (uint32_t x = 0; x < side; x++) {
+            mesh->vertices[z * side + x] = vertex_create_components((float)x * inv, 0.0f, (float)z * inv,
+                                                                    (float)x * inv, (float)z * inv,
+                                                                    0.0f, 1.0f, 0.0f);
+        }
+    }
+
+    uint32_t* index = mesh->indices;
+    for (uint32_t z = 0; z < resolution; z++) {
+        for (uint32_t x = 0; x < resolution; x++) {
+            uint32_t i0 = z * side + x;
+            uint32_t i1 = i0 + 1;
+            uint32_t i2 = i0 + side;
+            uint32_t i3 = i2 + 1;
+            *index++ = i0; *index++ = i2; *index++ = i1;
+            *index++ = i1; *index++ = i2; *index++ = i3;
+        }
+    }
+    mesh->triangle_count = mesh_calculate_triangle_count(mesh->index_count);
+    return mesh;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void terrain_print(const char* name, const Terrain* terrain) {
+    if (!terrain) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    const TerrainStats* stats = &terrain->stats;
+    printf("%s: %ux%u samples, %u LODs, %u instances\n", name,
+           terrain->header->size, terrain->header->size, terrain->header->lod_count, terrain->instance_count);
+    printf("  Nodes: %u visited, %u culled, %u selected, %u dropped\n",
+           stats->nodes_visited, stats->nodes_culled, stats->nodes_selected, stats->nodes_dropped);
+    printf("  Per LOD:");
+    for (uint32_t lod = 0; lod < terrain->header->lod_count; lod++) {
+        printf(" %u", stats->lod_counts[lod]);
+    }
+    printf("\n  Tiles: %u resident, %u requested, %u evicted\n",
+           stats->tiles_resident, stats->tiles_requested, stats->tiles_evicted);
+}
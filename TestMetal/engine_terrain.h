@@ -0,0 +1,180 @@
+#ifndef ENGINE_TERRAIN_H
+#define ENGINE_TERRAIN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_model.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// TERRAIN CONFIGURATION
+// ============================================================================
+
+#define TERRAIN_FILE_MAGIC 0x4E525254u          // "TRRN"
+#define TERRAIN_FILE_VERSION 1
+#define TERRAIN_FILE_ALIGNMENT 16384            // Tile alignment (largest page size we run on)
+#define TERRAIN_MAX_LODS 16
+#define TERRAIN_TILE_EVICT_FRAMES 120           // Unused tiles are released after this many streams
+
+// ============================================================================
+// TERRAIN FILE FORMAT
+// ============================================================================
+
+// A terrain file is this header, a min/max height pyramid (one uint16 pair
+// per quadtree node, finest LOD first, nodes row-major) and a mip chain of
+// uint16 heightmap tiles. Mip m is point-sampled from mip m - 1 and is the
+// one drawn by LOD m nodes, so each node always reads one
+// (leaf_size + 1)^2 block. Tiles are row-major within a mip and start on
+// TERRAIN_FILE_ALIGNMENT boundaries so they can be paged independently.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;              // Samples per side of mip 0 (power of two)
+    uint32_t tile_size;         // Samples per tile side (smaller mips use one tile)
+    uint32_t leaf_size;         // Samples per side of a LOD 0 node (= grid mesh resolution)
+    uint32_t lod_count;         // Quadtree levels, also the mip count
+    uint32_t tile_count;        // Tiles across all mips
+    uint32_t tile_stride;       // Bytes between tiles
+    float sample_spacing;       // World units between samples
+    float height_scale;         // World units per height unit
+    uint64_t minmax_offset;
+    uint64_t tiles_offset;
+} TerrainFileHeader;
+
+// Build parameters for terrain_build_file
+typedef struct {
+    uint32_t size;
+    uint32_t tile_size;
+    uint32_t leaf_size;
+    float sample_spacing;
+    float height_scale;
+} TerrainBuildDesc;
+
+// Height source for the builder: sample at (x, z) of mip 0
+typedef uint16_t (*TerrainHeightFunc)(void* user_data, uint32_t x, uint32_t z);
+
+// ============================================================================
+// TERRAIN DATA STRUCTURES
+// ============================================================================
+
+// One draw of the shared grid mesh (16 bytes). The grid spans
+// [origin, origin + size] on XZ and samples heights from mip `lod`.
+typedef struct {
+    float origin_x;
+    float origin_z;
+    float size;
+    uint32_t lod;
+} TerrainInstance;
+
+// Distance band of one LOD: nodes are drawn up to `range`, and vertices
+// morph toward the next LOD's grid between morph_start and range
+typedef struct {
+    float range;
+    float morph_start;
+} TerrainLod;
+
+// Selection and streaming statistics of the last frame
+typedef struct {
+    uint32_t nodes_visited;
+    uint32_t nodes_culled;
+    uint32_t nodes_selected;
+    uint32_t nodes_dropped;     // Selected past instance_capacity
+    uint32_t lod_counts[TERRAIN_MAX_LODS];
+    uint32_t tiles_requested;   // Tiles newly paged in by the last stream
+    uint32_t tiles_evicted;
+    uint32_t tiles_resident;
+} TerrainStats;
+
+// Memory-mapped terrain
+typedef struct {
+    int fd;
+    uint8_t* mapping;
+    size_t mapping_size;
+    const TerrainFileHeader* header;
+
+    // Quadtree
+    const uint16_t* minmax[TERRAIN_MAX_LODS];   // Node (min, max) pairs per LOD
+    uint32_t nodes_per_side[TERRAIN_MAX_LODS];
+    TerrainLod lods[TERRAIN_MAX_LODS];
+
+    // Mip tiles
+    uint32_t mip_first_tile[TERRAIN_MAX_LODS];
+    uint32_t mip_tiles_per_side[TERRAIN_MAX_LODS];
+    uint32_t mip_tile_size[TERRAIN_MAX_LODS];
+    uint32_t* tile_last_used;   // Stream frame of last use (0 = not resident)
+    uint32_t frame;
+
+    // Selection output
+    TerrainInstance* instances;
+    uint32_t instance_count;
+    uint32_t instance_capacity;
+    TerrainStats stats;
+} Terrain;
+
+// ============================================================================
+// TERRAIN BUILD FUNCTIONS
+// ============================================================================
+
+// Default: 4096 samples, 256-sample tiles, 64-sample leaves, 1 unit spacing,
+// heights scaled to 0..512 units
+TerrainBuildDesc terrain_build_desc_default(void);
+
+// Write a terrain file from a height function. Returns 1 on success.
+int terrain_build_file(const char* path, const TerrainBuildDesc* desc, TerrainHeightFunc height_func, void* user_data);
+
+// ============================================================================
+// TERRAIN FUNCTIONS
+// ============================================================================
+
+// Map a terrain file; instance lists hold up to max_instances nodes
+Terrain* terrain_open(const char* path, uint32_t max_instances);
+
+// Unmap and free a terrain
+void terrain_close(Terrain* terrain);
+
+// Set LOD bands: LOD 0 is drawn up to detail_distance and every level
+// doubles it; morph_ratio is the fraction of each band spent morphing.
+// detail_distance is raised to the smallest crack-free value if needed.
+void terrain_set_lod_distances(Terrain* terrain, float detail_distance, float morph_ratio);
+
+// Select quadtree nodes for a camera and fill the instance list.
+// Returns the instance count.
+uint32_t terrain_select(Terrain* terrain, vec3_t camera_position, mat4_t view_projection);
+
+// Page in the tiles the current instances read and release tiles unused
+// for TERRAIN_TILE_EVICT_FRAMES streams
+void terrain_stream(Terrain* terrain);
+
+// Heights of one tile (tile_size^2 samples, row-major) for upload
+const uint16_t* terrain_get_tile(const Terrain* terrain, uint32_t mip, uint32_t tile_x, uint32_t tile_z);
+
+// Bilinear world-space height at (x, z), clamped to the last sample
+float terrain_get_height(const Terrain* terrain, float x, float z);
+
+// World-space bounds of the whole terrain
+void terrain_get_bounds(const Terrain* terrain, vec3_t* out_min, vec3_t* out_max);
+
+// CPU reference of the vertex shader: place grid vertex (gx, gz) of an
+// instance, morphing odd vertices toward the next LOD by camera distance
+vec3_t terrain_morph_vertex(const Terrain* terrain, const TerrainInstance* instance,
+                            uint32_t gx, uint32_t gz, vec3_t camera_position);
+
+// Shared (resolution + 1)^2 grid mesh over [0, 1] on XZ
+Mesh* terrain_create_grid_mesh(uint32_t resolution);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print terrain size and last frame statistics
+void terrain_print(const char* name, const Terrain* terrain);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_TERRAIN_H
@@ -0,0 +1,378 @@
+#include "engine_terrain.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* SMALL_TERRAIN_PATH = "/tmp/engine_terrain_test_1k.trn";
+static const char* LARGE_TERRAIN_PATH = "/tmp/engine_terrain_test_16k.trn";
+
+// Rolling hills with a ridge, in height units
+static uint16_t hills_height(void* user_data, uint32_t x, uint32_t z) {
+    (void)user_data;
+    float fx = (float)x, fz = (float)z;
+    float h = 30000.0f + 14000.0f * sinf(fx * 0.0061f) * cosf(fz * 0.0047f)
+            + 6000.0f * sinf((fx + fz) * 0.023f) + 2000.0f * cosf(fx * 0.091f - fz * 0.057f);
+    return (uint16_t)h;
+}
+
+// Everything on the map is inside this frustum
+static mat4_t everything_view_projection(void) {
+    return mat4_ortho(-1.0e5f, 1.0e5f, -1.0e5f, 1.0e5f, -1.0e5f, 1.0e5f);
+}
+
+static mat4_t camera_view_projection(vec3_t eye, vec3_t target) {
+    mat4_t view = mat4_look_at(eye, target, vec3(0.0f, 1.0f, 0.0f));
+    mat4_t projection = mat4_perspective((float)M_PI / 3.0f, 16.0f / 9.0f, 0.5f, 20000.0f);
+    return mat4_mul_mat4(view, projection);
+}
+
+// Height of a polyline of morphed edge vertices at coordinate `t` along the edge
+static float edge_height(const Terrain* terrain, const TerrainInstance* instance, int axis_x,
+                         uint32_t fixed, float t, vec3_t camera) {
+    uint32_t grid = terrain->header->leaf_size;
+    vec3_t previous = vec3_zero();
+    for (uint32_t g = 0; g <= grid; g++) {
+        vec3_t p = axis_x ? terrain_morph_vertex(terrain, instance, g, fixed, camera)
+                          : terrain_morph_vertex(terrain, instance, fixed, g, camera);
+        float along = axis_x ? p.x : p.z;
+        if (g > 0) {
+            float previous_along = axis_x ? previous.x : previous.z;
+            if (t >= previous_along - 1e-3f && t <= along + 1e-3f) {
+                float span = along - previous_along;
+                float w = span > 1e-6f ? (t - previous_along) / span : 0.0f;
+                return previous.y + (p.y - previous.y) * w;
+            }
+        }
+        previous = p;
+    }
+    return -1.0e9f;
+}
+
+// ============================================================================
+// TERRAIN TESTS
+// ============================================================================
+
+static void test_build_and_open(void) {
+    printf("\n--- Build Tests ---\n");
+
+    TerrainBuildDesc desc = terrain_build_desc_default();
+    desc.size = 1024;
+    desc.tile_size = 128;
+    desc.leaf_size = 32;
+    TEST_ASSERT(terrain_build_file(SMALL_TERRAIN_PATH, &desc, hills_height, NULL), "Terrain file should build");
+
+    TerrainBuildDesc bad = desc;
+    bad.size = 1000;
+    TEST_ASSERT(!terrain_build_file("/tmp/engine_terrain_test_bad.trn", &bad, hills_height, NULL),
+                "Non power of two sizes should be rejected");
+
+    Terrain* terrain = terrain_open(SMALL_TERRAIN_PATH, 4096);
+    TEST_ASSERT_NOT_NULL(terrain, "Terrain file should open");
+    if (!terrain) return;
+
+    TEST_ASSERT_EQUAL(6u, terrain->header->lod_count, "1024 samples with 32-sample leaves should have 6 LODs");
+    TEST_ASSERT_EQUAL(0u, terrain->header->tiles_offset % TERRAIN_FILE_ALIGNMENT, "Tiles should start page aligned");
+    TEST_ASSERT_EQUAL(0u, terrain->header->tile_stride % TERRAIN_FILE_ALIGNMENT, "Tile stride should be page aligned");
+
+    int exact = 1;
+    for (uint32_t i = 0; i < 200; i++) {
+        uint32_t x = (i * 7919u) % 1024u, z = (i * 104729u) % 1024u;
+        float expected = (float)hills_height(NULL, x, z) * desc.height_scale;
+        if (fabsf(terrain_get_height(terrain, (float)x, (float)z) - expected) > 1e-3f) exact = 0;
+    }
+    TEST_ASSERT(exact, "Heights at sample positions should match the source");
+
+    const uint16_t* mip0 = terrain_get_tile(terrain, 0, 1, 2);
+    const uint16_t* mip1 = terrain_get_tile(terrain, 1, 0, 1);
+    TEST_ASSERT(mip0 && mip1 && mip1[5 * 128 + 64 + 3] == mip0[10 * 128 + 6],
+                "Mip 1 should point-sample every other mip 0 sample");
+    TEST_ASSERT(terrain_get_tile(terrain, 0, 8, 0) == NULL, "Out of range tiles should return NULL");
+
+    int bounds_ok = 1;
+    for (uint32_t lod = 0; lod < 3; lod++) {
+        uint32_t node_size = 32u << lod;
+        for (uint32_t n = 0; n < 6; n++) {
+            uint32_t nx = (n * 5u + lod) % terrain->nodes_per_side[lod];
+            uint32_t nz = (n * 3u + 1u) % terrain->nodes_per_side[lod];
+            uint16_t lo = 0xFFFF, hi = 0;
+            for (uint32_t z = nz * node_size; z <= nz * node_size + node_size && z < 1024; z++) {
+                for (uint32_t x = nx * node_size; x <= nx * node_size + node_size && x < 1024; x++) {
+                    uint16_t h = hills_height(NULL, x, z);
+                    if (h < lo) lo = h;
+                    if (h > hi) hi = h;
+                }
+            }
+            const uint16_t* pair = terrain->minmax[lod] + (nz * terrain->nodes_per_side[lod] + nx) * 2;
+            if (pair[0] != lo || pair[1] != hi) bounds_ok = 0;
+        }
+    }
+    TEST_ASSERT(bounds_ok, "Node min/max should cover every sample of the node");
+
+    vec3_t bmin, bmax;
+    terrain_get_bounds(terrain, &bmin, &bmax);
+    TEST_ASSERT(bmax.x == 1024.0f && bmax.z == 1024.0f && bmin.y > 0.0f && bmax.y < 512.0f,
+                "Terrain bounds should span the map and height range");
+
+    Mesh* grid = terrain_create_grid_mesh(terrain->header->leaf_size);
+    TEST_ASSERT(grid && grid->vertex_count == 33u * 33u && grid->index_count == 32u * 32u * 6u,
+                "Grid mesh should have (n+1)^2 vertices and 2n^2 triangles");
+    mesh_free(grid);
+
+    terrain_close(terrain);
+}
+
+static void test_selection(void) {
+    printf("\n--- Selection Tests ---\n");
+
+    Terrain* terrain = terrain_open(SMALL_TERRAIN_PATH, 4096);
+    if (!terrain) return;
+
+    vec3_t camera = vec3(300.0f, terrain_get_height(terrain, 300.0f, 420.0f) + 10.0f, 420.0f);
+    uint32_t count = terrain_select(terrain, camera, everything_view_projection());
+    terrain_print("Terrain (whole map)", terrain);
+
+    float area = 0.0f;
+    int ranges_ok = 1;
+    for (uint32_t i = 0; i < count; i++) {
+        const TerrainInstance* instance = &terrain->instances[i];
+        area += instance->size * instance->size;
+        float cx = fmaxf(fmaxf(instance->origin_x - camera.x, camera.x - instance->origin_x - instance->size), 0.0f);
+        float cz = fmaxf(fmaxf(instance->origin_z - camera.z, camera.z - instance->origin_z - instance->size), 0.0f);
+        if (instance->lod + 1 < terrain->header->lod_count &&
+            sqrtf(cx * cx + cz * cz) > terrain->lods[instance->lod + 1].range) ranges_ok = 0;
+    }
+    TEST_ASSERT(fabsf(area - 1024.0f * 1024.0f) < 1.0f, "Selected nodes should tile the whole map exactly once");
+    uint32_t far_lod = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const TerrainInstance* instance = &terrain->instances[i];
+        if (instance->origin_x + instance->size >= 1000.0f && instance->origin_z + instance->size >= 1000.0f) {
+            far_lod = instance->lod;
+        }
+    }
+    TEST_ASSERT(terrain->stats.lod_counts[0] > 0 && far_lod >= 2, "Near nodes should be fine and far nodes coarse");
+    TEST_ASSERT(ranges_ok, "Every node should be within its parent LOD's range");
+    TEST_ASSERT(count < 1024u / 32u * 1024u / 32u / 2u, "Selection should use far fewer nodes than the leaf grid");
+
+    // Cracks: every vertex on a node edge must lie on its neighbour's edge.
+    // The far map border clamps per mip and has no neighbour, so skip it.
+    uint32_t grid = terrain->header->leaf_size;
+    uint32_t edges_checked = 0, cracks = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const TerrainInstance* a = &terrain->instances[i];
+        for (uint32_t j = 0; j < count; j++) {
+            const TerrainInstance* b = &terrain->instances[j];
+            if (i == j || b->size < a->size) continue;
+            int axis_x;
+            uint32_t fixed_a, fixed_b;
+            if (a->origin_x + a->size == b->origin_x) { axis_x = 0; fixed_a = grid; fixed_b = 0; }
+            else if (b->origin_x + b->size == a->origin_x) { axis_x = 0; fixed_a = 0; fixed_b = grid; }
+            else if (a->origin_z + a->size == b->origin_z) { axis_x = 1; fixed_a = grid; fixed_b = 0; }
+            else if (b->origin_z + b->size == a->origin_z) { axis_x = 1; fixed_a = 0; fixed_b = grid; }
+            else continue;
+            float a0 = axis_x ? a->origin_x : a->origin_z, b0 = axis_x ? b->origin_x : b->origin_z;
+            if (a0 < b0 || a0 + a->size > b0 + b->size) continue;
+            edges_checked++;
+            for (uint32_t g = 0; g <= grid; g++) {
+                vec3_t p = axis_x ? terrain_morph_vertex(terrain, a, g, fixed_a, camera)
+                                  : terrain_morph_vertex(terrain, a, fixed_a, g, camera);
+                if ((axis_x ? p.x : p.z) >= 1024.0f) continue;
+                float h = edge_height(terrain, b, axis_x, fixed_b, axis_x ? p.x : p.z, camera);
+                if (fabsf(h - p.y) > 1e-2f) cracks++;
+            }
+        }
+    }
+    printf("  %u shared edges checked\n", edges_checked);
+    TEST_ASSERT(edges_checked > count, "Neighbouring nodes should share edges");
+    TEST_ASSERT_EQUAL(0u, cracks, "Morphed edges should match between neighbouring LODs");
+
+    // Culling against a real camera frustum
+    vec3_t target = vec3(900.0f, camera.y - 40.0f, 900.0f);
+    mat4_t view_projection = camera_view_projection(camera, target);
+    frustum_t frustum = frustum_from_matrix(view_projection);
+    uint32_t culled_count = terrain_select(terrain, camera, view_projection);
+    int visible = 1;
+    for (uint32_t i = 0; i < culled_count; i++) {
+        const TerrainInstance* instance = &terrain->instances[i];
+        vec3_t bmin = vec3(instance->origin_x, 0.0f, instance->origin_z);
+        vec3_t bmax = vec3(instance->origin_x + instance->size, 512.0f, instance->origin_z + instance->size);
+        if (!frustum_test_aabb(&frustum, bmin, bmax)) visible = 0;
+    }
+    TEST_ASSERT(terrain->stats.nodes_culled > 0 && culled_count < count, "Frustum culling should reject nodes");
+    TEST_ASSERT(visible, "Selected nodes should intersect the frustum");
+
+    terrain->instance_capacity = 8;
+    terrain_select(terrain, camera, everything_view_projection());
+    TEST_ASSERT(terrain->instance_count == 8 && terrain->stats.nodes_dropped > 0,
+                "Selection should stop at the instance capacity");
+
+    terrain_close(terrain);
+}
+
+static void test_morph(void) {
+    printf("\n--- Morph Tests ---\n");
+
+    Terrain* terrain = terrain_open(SMALL_TERRAIN_PATH, 4096);
+    if (!terrain) return;
+
+    TerrainInstance instance = {256.0f, 256.0f, 64.0f, 1};
+    vec3_t near_camera = vec3(290.0f, 200.0f, 290.0f);
+    vec3_t far_camera = vec3(256.0f + 64.0f * 40.0f, 200.0f, 256.0f);
+
+    vec3_t unmorphed = terrain_morph_vertex(terrain, &instance, 3, 5, near_camera);
+    TEST_ASSERT(fabsf(unmorphed.x - 262.0f) < 1e-3f && fabsf(unmorphed.z - 266.0f) < 1e-3f,
+                "Vertices near the camera should not morph");
+
+    vec3_t odd = terrain_morph_vertex(terrain, &instance, 3, 5, far_camera);
+    vec3_t even = terrain_morph_vertex(terrain, &instance, 2, 4, far_camera);
+    TEST_ASSERT(vec3_distance(odd, even) < 1e-3f, "Fully morphed odd vertices should collapse onto even ones");
+    float coarse = terrain_get_height(terrain, 260.0f, 264.0f);
+    TEST_ASSERT(fabsf(even.y - coarse) < 1e-3f, "Even vertices should keep the sampled height");
+
+    terrain_close(terrain);
+}
+
+static void test_streaming(void) {
+    printf("\n--- Streaming Tests ---\n");
+
+    Terrain* terrain = terrain_open(SMALL_TERRAIN_PATH, 4096);
+    if (!terrain) return;
+
+    vec3_t camera = vec3(100.0f, 300.0f, 100.0f);
+    mat4_t view_projection = camera_view_projection(camera, vec3(400.0f, 200.0f, 400.0f));
+    terrain_select(terrain, camera, view_projection);
+    terrain_stream(terrain);
+    uint32_t first = terrain->stats.tiles_requested;
+    TEST_ASSERT(first > 0 && first < terrain->header->tile_count, "Streaming should request the visible tiles only");
+    TEST_ASSERT_EQUAL(first, terrain->stats.tiles_resident, "Requested tiles should be resident");
+
+    terrain_stream(terrain);
+    TEST_ASSERT_EQUAL(0u, terrain->stats.tiles_requested, "Resident tiles should not be requested again");
+
+    camera = vec3(1000.0f, 300.0f, 1000.0f);
+    view_projection = camera_view_projection(camera, vec3(1000.0f, 200.0f, 1020.0f));
+    uint32_t evicted = 0;
+    for (uint32_t frame = 0; frame <= TERRAIN_TILE_EVICT_FRAMES + 1; frame++) {
+        terrain_select(terrain, camera, view_projection);
+        terrain_stream(terrain);
+        evicted += terrain->stats.tiles_evicted;
+    }
+    TEST_ASSERT(evicted > 0, "Tiles left behind should be evicted");
+    uint32_t resident = 0;
+    for (uint32_t tile = 0; tile < terrain->header->tile_count; tile++) {
+        if (terrain->tile_last_used[tile] != 0) resident++;
+    }
+    TEST_ASSERT_EQUAL(resident, terrain->stats.tiles_resident, "Resident count should track the tile table");
+
+    terrain_close(terrain);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    TerrainBuildDesc desc = terrain_build_desc_default();
+    desc.size = 16384;
+    double start = now_ms();
+    int built = terrain_build_file(LARGE_TERRAIN_PATH, &desc, hills_height, NULL);
+    double build_ms = now_ms() - start;
+    TEST_ASSERT(built, "16k x 16k terrain should build");
+    if (!built) return;
+
+    Terrain* terrain = terrain_open(LARGE_TERRAIN_PATH, 16384);
+    TEST_ASSERT_NOT_NULL(terrain, "16k x 16k terrain should open");
+    if (!terrain) return;
+    printf("  Built %.0f MB in %.0f ms\n", (double)terrain->mapping_size / (1024.0 * 1024.0), build_ms);
+
+    // Fly across the map a few hundred units above the ground
+    const uint32_t frames = 200;
+    double select_ms = 0.0, stream_ms = 0.0;
+    uint32_t max_selected = 0, total_selected = 0, max_visited = 0;
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        float t = (float)frame / (float)frames;
+        float x = 1000.0f + t * 14000.0f, z = 8000.0f + 3000.0f * sinf(t * 6.0f);
+        vec3_t camera = vec3(x, terrain_get_height(terrain, x, z) + 150.0f, z);
+        vec3_t target = vec3(x + 100.0f, camera.y - 40.0f, z + 30.0f * cosf(t * 6.0f));
+        mat4_t view_projection = camera_view_projection(camera, target);
+
+        start = now_ms();
+        uint32_t count = terrain_select(terrain, camera, view_projection);
+        select_ms += now_ms() - start;
+        start = now_ms();
+        terrain_stream(terrain);
+        stream_ms += now_ms() - start;
+
+        total_selected += count;
+        if (count > max_selected) max_selected = count;
+        if (terrain->stats.nodes_visited > max_visited) max_visited = terrain->stats.nodes_visited;
+    }
+    terrain_print("Terrain (16k, last frame)", terrain);
+    printf("  Selection: %.3f ms/frame, %u nodes/frame average (max %u, %u visited)\n",
+           select_ms / frames, total_selected / frames, max_selected, max_visited);
+    printf("  Streaming: %.3f ms/frame\n", stream_ms / frames);
+
+    TEST_ASSERT_EQUAL(0u, terrain->stats.nodes_dropped, "16k instances should hold a full selection");
+    TEST_ASSERT(max_selected < 2000, "CDLOD should keep the node count small on a 16k map");
+    TEST_ASSERT(terrain->stats.tiles_resident < terrain->header->tile_count / 4,
+                "Only a fraction of the tiles should be resident");
+
+    terrain_close(terrain);
+    unlink(LARGE_TERRAIN_PATH);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Terrain Unit Tests\n");
+    printf("===================================\n");
+
+    test_build_and_open();
+    test_selection();
+    test_morph();
+    test_streaming();
+    test_performance();
+
+    unlink(SMALL_TERRAIN_PATH);
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
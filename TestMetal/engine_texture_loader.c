@@ -402,6 +402,123 @@ MetalTextureHandle texture_loader_load_from_file(TextureLoaderHandle loader, con
     return (__bridge_retained MetalTextureHandle)texture;
 }
 
+// ============================================================================
+// HOT RELOAD
+// ============================================================================
+
+TextureImage* texture_loader_decode_file(const char* path) {
+    if (!path) {
+        TEXTURE_ERROR("Invalid path for decode_file");
+        return NULL;
+    }
+    
+    int width, height, channels;
+    unsigned char* data = stbi_load(path, &width, &height, &channels, 0);
+    if (!data) {
+        TEXTURE_ERROR("stb_image failed to decode: %s", path);
+        return NULL;
+    }
+    if (width <= 0 || height <= 0 || width > TEXTURE_MAX_DIMENSION || height > TEXTURE_MAX_DIMENSION ||
+        channels < 1 || channels > 4) {
+        TEXTURE_ERROR("Invalid texture for reload: %s (%dx%d, %d channels)", path, width, height, channels);
+        stbi_image_free(data);
+        return NULL;
+    }
+    
+    TextureImage* image = (TextureImage*)calloc(1, sizeof(TextureImage));
+    if (!image) {
+        stbi_image_free(data);
+        return NULL;
+    }
+    image->width = (uint32_t)width;
+    image->height = (uint32_t)height;
+    
+    // Same formats as texture_loader_load_from_file without options
+    static const TexturePixelFormat formats[5] = {0, MTLPixelFormatR8Unorm, MTLPixelFormatRG8Unorm,
+                                                  MTLPixelFormatRGBA8Unorm, MTLPixelFormatRGBA8Unorm};
+    image->pixelFormat = formats[channels];
+    image->channels = channels == 3 ? 4 : (uint32_t)channels;
+    
+    size_t pixelCount = (size_t)width * (size_t)height;
+    image->pixels = (unsigned char*)malloc(pixelCount * image->channels);
+    if (!image->pixels) {
+        TEXTURE_ERROR("Failed to allocate memory for reloaded texture: %s", path);
+        stbi_image_free(data);
+        free(image);
+        return NULL;
+    }
+    if (channels == 3) {
+        for (size_t i = 0; i < pixelCount; i++) {
+            image->pixels[i * 4 + 0] = data[i * 3 + 0];
+            image->pixels[i * 4 + 1] = data[i * 3 + 1];
+            image->pixels[i * 4 + 2] = data[i * 3 + 2];
+            image->pixels[i * 4 + 3] = 255;
+        }
+    } else {
+        memcpy(image->pixels, data, pixelCount * image->channels);
+    }
+    stbi_image_free(data);
+    return image;
+}
+
+void texture_loader_free_image(TextureImage* image) {
+    if (image) {
+        free(image->pixels);
+        free(image);
+    }
+}
+
+int texture_loader_replace(TextureLoaderHandle loader, const char* filename, TextureImage* image) {
+    if (!loader || !filename || !image) {
+        texture_loader_free_image(image);
+        return 0;
+    }
+    
+    TextureLoader* tl = (TextureLoader*)loader;
+    TextureCacheEntry* entry = texture_loader_find_entry(loader, filename);
+    if (!tl->isInitialized || !entry) {
+        TEXTURE_DEBUG("Texture not cached, nothing to reload: %s", filename);
+        texture_loader_free_image(image);
+        return 0;
+    }
+    
+    id<MTLTexture> texture = (__bridge id<MTLTexture>)entry->texture;
+    MTLRegion region = MTLRegionMake2D(0, 0, image->width, image->height);
+    NSUInteger bytesPerRow = image->width * image->channels;
+    
+    if (texture.width == image->width && texture.height == image->height &&
+        texture.pixelFormat == (MTLPixelFormat)image->pixelFormat) {
+        // Same shape: overwrite in place so every holder of the handle sees it
+        [texture replaceRegion:region mipmapLevel:0 withBytes:image->pixels bytesPerRow:bytesPerRow];
+    } else {
+        id<MTLDevice> device = (__bridge id<MTLDevice>)tl->device;
+        MTLTextureDescriptor* textureDesc = [MTLTextureDescriptor texture2DDescriptorWithPixelFormat:(MTLPixelFormat)image->pixelFormat
+                                                                                                width:image->width
+                                                                                               height:image->height
+                                                                                            mipmapped:NO];
+        textureDesc.usage = MTLTextureUsageShaderRead;
+        id<MTLTexture> replacement = [device newTextureWithDescriptor:textureDesc];
+        if (!replacement) {
+            TEXTURE_ERROR("Failed to create Metal texture for reload: %s", filename);
+            texture_loader_free_image(image);
+            return 0;
+        }
+        [replacement replaceRegion:region mipmapLevel:0 withBytes:image->pixels bytesPerRow:bytesPerRow];
+        
+        // Like eviction, the old texture is not released: a caller may still hold its handle
+        tl->stats.memoryUsage -= entry->width * entry->height * entry->channels;
+        entry->texture = (__bridge_retained MetalTextureHandle)replacement;
+        entry->width = image->width;
+        entry->height = image->height;
+        entry->channels = image->channels;
+        tl->stats.memoryUsage += entry->width * entry->height * entry->channels;
+    }
+    
+    TEXTURE_INFO("Reloaded texture: %s (%ux%u)", filename, image->width, image->height);
+    texture_loader_free_image(image);
+    return 1;
+}
+
 // ============================================================================
 // PUBLIC API IMPLEMENTATION
 // ============================================================================
@@ -64,6 +64,15 @@ typedef enum {
     TEXTURE_LOADER_ERROR_NOT_INITIALIZED
 } TextureLoaderResult;
 
+// Decoded pixels for a hot reload, ready to upload on the render thread
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;                           // Upload channels (RGB is expanded to RGBA)
+    TexturePixelFormat pixelFormat;
+    unsigned char* pixels;
+} TextureImage;
+
 // Cache statistics
 typedef struct {
     uint32_t size;                               // Current cache size
@@ -108,6 +117,14 @@ void texture_loader_set_fallback(TextureLoaderHandle loader, MetalTextureHandle
 MetalTextureHandle texture_loader_create_fallback(MetalDeviceHandle device);
 int texture_loader_is_cached(TextureLoaderHandle loader, const char* filename);
 
+// Hot Reload: decode on any thread, then swap into the cache on the render thread.
+// A replacement with the same size and format is written into the existing
+// texture, so handles already given out see it too. Returns 0 (and frees the
+// image) when the file is not cached.
+TextureImage* texture_loader_decode_file(const char* path);
+int texture_loader_replace(TextureLoaderHandle loader, const char* filename, TextureImage* image);
+void texture_loader_free_image(TextureImage* image);
+
 // Error Handling
 const char* texture_loader_get_error_string(TextureLoaderResult result);
 
@@ -0,0 +1,527 @@
+#include "engine_tlsf.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// BIN MAPPING
+// ============================================================================
+
+static uint32_t tlsf_log2(uint32_t value) {
+    return 31u - (uint32_t)__builtin_clz(value);
+}
+
+// Bin of a block of `units` granules: linear below TLSF_SL_COUNT units,
+// then TLSF_SL_COUNT bins per power of two
+static void tlsf_mapping(uint32_t units, uint32_t* fl, uint32_t* sl) {
+    if (units < TLSF_SL_COUNT) {
+        *fl = 0;
+        *sl = units;
+        return;
+    }
+    uint32_t log2 = tlsf_log2(units);
+    *fl = log2 - TLSF_SL_LOG2 + 1;
+    *sl = (units >> (log2 - TLSF_SL_LOG2)) - TLSF_SL_COUNT;
+}
+
+// Round a request up to the next bin boundary so any block in the bin fits
+static uint32_t tlsf_round_up(uint32_t units) {
+    if (units < TLSF_SL_COUNT) {
+        return units;
+    }
+    uint32_t step = 1u << (tlsf_log2(units) - TLSF_SL_LOG2);
+    return units + step - 1 < units ? units : units + step - 1;
+}
+
+// ============================================================================
+// BLOCK MANAGEMENT
+// ============================================================================
+
+static uint32_t tlsf_new_block(TlsfAllocator* allocator) {
+    if (allocator->spare_block != TLSF_INVALID) {
+        uint32_t index = allocator->spare_block;
+        allocator->spare_block = allocator->blocks[index].next_free;
+        allocator->blocks[index].live = 1;
+        return index;
+    }
+    if (allocator->block_count == allocator->block_capacity) {
+        uint32_t capacity = allocator->block_capacity ? allocator->block_capacity * 2 : 256;
+        TlsfBlock* blocks = (TlsfBlock*)realloc(allocator->blocks, capacity * sizeof(TlsfBlock));
+        if (!blocks) {
+            return TLSF_INVALID;
+        }
+        allocator->blocks = blocks;
+        allocator->block_capacity = capacity;
+    }
+    uint32_t index = allocator->block_count++;
+    memset(&allocator->blocks[index], 0, sizeof(TlsfBlock));
+    allocator->blocks[index].live = 1;
+    return index;
+}
+
+static void tlsf_release_block(TlsfAllocator* allocator, uint32_t index) {
+    TlsfBlock* block = &allocator->blocks[index];
+    block->live = 0;
+    block->used = 0;
+    block->next_free = allocator->spare_block;
+    allocator->spare_block = index;
+}
+
+static void tlsf_insert_free(TlsfAllocator* allocator, uint32_t index) {
+    TlsfBlock* block = &allocator->blocks[index];
+    uint32_t fl, sl;
+    tlsf_mapping(block->size / TLSF_GRANULARITY, &fl, &sl);
+    uint32_t head = allocator->free_heads[fl][sl];
+    block->used = 0;
+    block->prev_free = TLSF_INVALID;
+    block->next_free = head;
+    if (head != TLSF_INVALID) {
+        allocator->blocks[head].prev_free = index;
+    }
+    allocator->free_heads[fl][sl] = index;
+    allocator->fl_bitmap |= 1u << fl;
+    allocator->sl_bitmap[fl] |= 1u << sl;
+}
+
+static void tlsf_remove_free(TlsfAllocator* allocator, uint32_t index) {
+    TlsfBlock* block = &allocator->blocks[index];
+    uint32_t fl, sl;
+    tlsf_mapping(block->size / TLSF_GRANULARITY, &fl, &sl);
+    if (block->prev_free != TLSF_INVALID) {
+        allocator->blocks[block->prev_free].next_free = block->next_free;
+    } else {
+        allocator->free_heads[fl][sl] = block->next_free;
+    }
+    if (block->next_free != TLSF_INVALID) {
+        allocator->blocks[block->next_free].prev_free = block->prev_free;
+    }
+    if (allocator->free_heads[fl][sl] == TLSF_INVALID) {
+        allocator->sl_bitmap[fl] &= ~(1u << sl);
+        if (allocator->sl_bitmap[fl] == 0) {
+            allocator->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+// A free block of at least `units` granules, or TLSF_INVALID
+static uint32_t tlsf_find_free(const TlsfAllocator* allocator, uint32_t units) {
+    uint32_t fl, sl;
+    tlsf_mapping(tlsf_round_up(units), &fl, &sl);
+    if (fl >= TLSF_FL_COUNT) {
+        return TLSF_INVALID;
+    }
+
+    uint32_t sl_map = allocator->sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+        uint32_t fl_map = fl + 1 < 32 ? allocator->fl_bitmap & (~0u << (fl + 1)) : 0;
+        if (fl_map == 0) {
+            return TLSF_INVALID;
+        }
+        fl = (uint32_t)__builtin_ctz(fl_map);
+        sl_map = allocator->sl_bitmap[fl];
+    }
+    return allocator->free_heads[fl][(uint32_t)__builtin_ctz(sl_map)];
+}
+
+// Insert a new block of `size` at `offset` right after `after` (or first)
+static uint32_t tlsf_split(TlsfAllocator* allocator, uint32_t pool, uint32_t offset, uint32_t size, uint32_t after,
+                           uint32_t before) {
+    uint32_t index = tlsf_new_block(allocator);
+    if (index == TLSF_INVALID) {
+        return TLSF_INVALID;
+    }
+    TlsfBlock* block = &allocator->blocks[index];
+    block->offset = offset;
+    block->size = size;
+    block->pool = pool;
+    block->prev_physical = after;
+    block->next_physical = before;
+    if (after != TLSF_INVALID) {
+        allocator->blocks[after].next_physical = index;
+    } else {
+        allocator->pool_first[pool] = index;
+    }
+    if (before != TLSF_INVALID) {
+        allocator->blocks[before].prev_physical = index;
+    }
+    return index;
+}
+
+// ============================================================================
+// TLSF FUNCTIONS
+// ============================================================================
+
+TlsfDesc tlsf_desc_default(void) {
+    TlsfDesc desc;
+    desc.pool_size = TLSF_DEFAULT_POOL_SIZE;
+    desc.max_pools = TLSF_DEFAULT_MAX_POOLS;
+    desc.on_pool_created = NULL;
+    desc.user = NULL;
+    return desc;
+}
+
+TlsfAllocator* tlsf_create(const TlsfDesc* desc) {
+    TlsfDesc d = desc ? *desc : tlsf_desc_default();
+    if (d.pool_size < TLSF_GRANULARITY || d.max_pools == 0) {
+        fprintf(stderr, "Error: Invalid TLSF allocator parameters\n");
+        return NULL;
+    }
+
+    TlsfAllocator* allocator = (TlsfAllocator*)calloc(1, sizeof(TlsfAllocator));
+    if (allocator) {
+        allocator->pool_sizes = (uint32_t*)calloc(d.max_pools, sizeof(uint32_t));
+        allocator->pool_first = (uint32_t*)calloc(d.max_pools, sizeof(uint32_t));
+    }
+    if (!allocator || !allocator->pool_sizes || !allocator->pool_first) {
+        fprintf(stderr, "Error: Failed to allocate memory for TLSF allocator\n");
+        tlsf_destroy(allocator);
+        return NULL;
+    }
+    allocator->desc = d;
+    allocator->desc.pool_size = d.pool_size / TLSF_GRANULARITY * TLSF_GRANULARITY;
+    allocator->spare_block = TLSF_INVALID;
+    memset(allocator->free_heads, 0xFF, sizeof(allocator->free_heads));
+    return allocator;
+}
+
+void tlsf_destroy(TlsfAllocator* allocator) {
+    if (!allocator) {
+        return;
+    }
+    free(allocator->blocks);
+    free(allocator->pool_sizes);
+    free(allocator->pool_first);
+    free(allocator);
+}
+
+uint32_t tlsf_add_pool(TlsfAllocator* allocator, uint32_t size) {
+    size = size / TLSF_GRANULARITY * TLSF_GRANULARITY;
+    if (!allocator || size == 0 || allocator->pool_count >= allocator->desc.max_pools) {
+        return TLSF_INVALID;
+    }
+    uint32_t pool = allocator->pool_count;
+    if (allocator->desc.on_pool_created && !allocator->desc.on_pool_created(allocator->desc.user, pool, size)) {
+        return TLSF_INVALID;
+    }
+
+    uint32_t index = tlsf_new_block(allocator);
+    if (index == TLSF_INVALID) {
+        return TLSF_INVALID;
+    }
+    TlsfBlock* block = &allocator->blocks[index];
+    block->offset = 0;
+    block->size = size;
+    block->pool = pool;
+    block->prev_physical = TLSF_INVALID;
+    block->next_physical = TLSF_INVALID;
+    allocator->pool_sizes[pool] = size;
+    allocator->pool_first[pool] = index;
+    allocator->pool_count++;
+    tlsf_insert_free(allocator, index);
+    return pool;
+}
+
+uint32_t tlsf_alloc(TlsfAllocator* allocator, uint32_t size, uint32_t alignment) {
+    if (!allocator || size == 0 || size > 0x7FFFFFFFu || (alignment & (alignment - 1)) != 0 ||
+        alignment > TLSF_MAX_ALIGNMENT) {
+        fprintf(stderr, "Error: Invalid TLSF allocation parameters\n");
+        return TLSF_INVALID;
+    }
+    if (alignment < TLSF_GRANULARITY) {
+        alignment = TLSF_GRANULARITY;
+    }
+    size = (size + TLSF_GRANULARITY - 1) / TLSF_GRANULARITY * TLSF_GRANULARITY;
+
+    // Over-ask by the worst-case padding so the aligned start fits too
+    uint32_t request = size + alignment - TLSF_GRANULARITY;
+    uint32_t index = tlsf_find_free(allocator, request / TLSF_GRANULARITY);
+    if (index == TLSF_INVALID) {
+        // A dedicated pool must reach the bin the search starts from
+        uint32_t pool_size = allocator->desc.pool_size;
+        uint32_t needed = tlsf_round_up(request / TLSF_GRANULARITY);
+        if (pool_size / TLSF_GRANULARITY < needed) {
+            pool_size = needed * TLSF_GRANULARITY;
+        }
+        if (tlsf_add_pool(allocator, pool_size) == TLSF_INVALID) {
+            return TLSF_INVALID;
+        }
+        index = tlsf_find_free(allocator, request / TLSF_GRANULARITY);
+        if (index == TLSF_INVALID) {
+            return TLSF_INVALID;
+        }
+    }
+    tlsf_remove_free(allocator, index);
+
+    // Leading padding becomes a free block of its own
+    TlsfBlock* block = &allocator->blocks[index];
+    uint32_t aligned = (block->offset + alignment - 1) & ~(alignment - 1);
+    uint32_t padding = aligned - block->offset;
+    if (padding > 0) {
+        uint32_t pad = tlsf_split(allocator, block->pool, block->offset, padding,
+                                  allocator->blocks[index].prev_physical, index);
+        if (pad == TLSF_INVALID) {
+            tlsf_insert_free(allocator, index);
+            return TLSF_INVALID;
+        }
+        block = &allocator->blocks[index];
+        block->offset = aligned;
+        block->size -= padding;
+        tlsf_insert_free(allocator, pad);
+    }
+
+    // The remainder goes back to its bin
+    if (block->size - size >= TLSF_GRANULARITY) {
+        uint32_t rest = tlsf_split(allocator, block->pool, block->offset + size, block->size - size, index,
+                                   block->next_physical);
+        block = &allocator->blocks[index];
+        if (rest != TLSF_INVALID) {
+            block->size = size;
+            tlsf_insert_free(allocator, rest);
+        }
+    }
+
+    block->used = 1;
+    block->alignment_log2 = (uint16_t)tlsf_log2(alignment);
+    allocator->used_bytes += block->size;
+    allocator->allocation_count++;
+    return index;
+}
+
+void tlsf_free(TlsfAllocator* allocator, uint32_t handle) {
+    if (!allocator || handle >= allocator->block_count || !allocator->blocks[handle].live ||
+        !allocator->blocks[handle].used) {
+        if (handle != TLSF_INVALID) {
+            fprintf(stderr, "Error: Invalid TLSF handle %u\n", handle);
+        }
+        return;
+    }
+
+    TlsfBlock* block = &allocator->blocks[handle];
+    allocator->used_bytes -= block->size;
+    allocator->allocation_count--;
+    block->used = 0;
+
+    uint32_t prev = block->prev_physical;
+    if (prev != TLSF_INVALID && !allocator->blocks[prev].used) {
+        tlsf_remove_free(allocator, prev);
+        allocator->blocks[prev].size += block->size;
+        allocator->blocks[prev].next_physical = block->next_physical;
+        if (block->next_physical != TLSF_INVALID) {
+            allocator->blocks[block->next_physical].prev_physical = prev;
+        }
+        tlsf_release_block(allocator, handle);
+        handle = prev;
+        block = &allocator->blocks[handle];
+    }
+
+    uint32_t next = block->next_physical;
+    if (next != TLSF_INVALID && !allocator->blocks[next].used) {
+        tlsf_remove_free(allocator, next);
+        block->size += allocator->blocks[next].size;
+        block->next_physical = allocator->blocks[next].next_physical;
+        if (block->next_physical != TLSF_INVALID) {
+            allocator->blocks[block->next_physical].prev_physical = handle;
+        }
+        tlsf_release_block(allocator, next);
+    }
+    tlsf_insert_free(allocator, handle);
+}
+
+TlsfAllocation tlsf_allocation(const TlsfAllocator* allocator, uint32_t handle) {
+    TlsfAllocation allocation = { 0, 0, 0 };
+    if (allocator && handle < allocator->block_count && allocator->blocks[handle].live &&
+        allocator->blocks[handle].used) {
+        const TlsfBlock* block = &allocator->blocks[handle];
+        allocation.pool = block->pool;
+        allocation.offset = block->offset;
+        allocation.size = block->size;
+    }
+    return allocation;
+}
+
+uint64_t tlsf_defragment(TlsfAllocator* allocator, uint64_t max_bytes, TlsfMoveCallback move, void* user) {
+    if (!allocator) {
+        return 0;
+    }
+
+    uint64_t moved = 0;
+    for (uint32_t pool = 0; pool < allocator->pool_count; pool++) {
+        uint32_t index = allocator->pool_first[pool];
+        while (index != TLSF_INVALID) {
+            TlsfBlock* gap = &allocator->blocks[index];
+            uint32_t next = gap->next_physical;
+            if (gap->used || next == TLSF_INVALID) {
+                index = next;
+                continue;
+            }
+
+            // Free blocks are coalesced, so the next one is in use. It slides
+            // to the first offset in the gap its alignment allows.
+            TlsfBlock* used = &allocator->blocks[next];
+            uint32_t alignment = 1u << used->alignment_log2;
+            uint32_t target = (gap->offset + alignment - 1) & ~(alignment - 1);
+            if (target >= used->offset) {
+                index = next;
+                continue;
+            }
+            if (max_bytes && moved + used->size > max_bytes) {
+                return moved;
+            }
+
+            // A misaligned gap keeps its head as padding and needs a block
+            // for the space freed behind the moved allocation
+            uint32_t padding = target - gap->offset;
+            uint32_t freed = index;
+            if (padding > 0) {
+                freed = tlsf_new_block(allocator);
+                if (freed == TLSF_INVALID) {
+                    return moved;
+                }
+                gap = &allocator->blocks[index];
+                used = &allocator->blocks[next];
+                tlsf_remove_free(allocator, index);
+                gap->size = padding;
+                tlsf_insert_free(allocator, index);
+                allocator->blocks[freed].pool = pool;
+                allocator->blocks[freed].size = used->offset - target;
+            } else {
+                tlsf_remove_free(allocator, index);
+            }
+            if (move) {
+                move(user, pool, used->offset, target, used->size);
+            }
+            moved += used->size;
+
+            // Relink as: [padding,] used, freed, after
+            TlsfBlock* hole = &allocator->blocks[freed];
+            uint32_t prev = padding > 0 ? index : gap->prev_physical;
+            uint32_t after = used->next_physical;
+            used->offset = target;
+            hole->offset = target + used->size;
+            used->prev_physical = prev;
+            used->next_physical = freed;
+            hole->prev_physical = next;
+            hole->next_physical = after;
+            if (prev != TLSF_INVALID) {
+                allocator->blocks[prev].next_physical = next;
+            } else {
+                allocator->pool_first[pool] = next;
+            }
+            if (after != TLSF_INVALID) {
+                allocator->blocks[after].prev_physical = freed;
+                if (!allocator->blocks[after].used) {
+                    tlsf_remove_free(allocator, after);
+                    hole->size += allocator->blocks[after].size;
+                    hole->next_physical = allocator->blocks[after].next_physical;
+                    if (hole->next_physical != TLSF_INVALID) {
+                        allocator->blocks[hole->next_physical].prev_physical = freed;
+                    }
+                    tlsf_release_block(allocator, after);
+                }
+            }
+            tlsf_insert_free(allocator, freed);
+            index = freed;
+        }
+    }
+    return moved;
+}
+
+TlsfStats tlsf_stats(const TlsfAllocator* allocator) {
+    TlsfStats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (!allocator) {
+        return stats;
+    }
+
+    stats.pool_count = allocator->pool_count;
+    for (uint32_t pool = 0; pool < allocator->pool_count; pool++) {
+        stats.capacity += allocator->pool_sizes[pool];
+    }
+    stats.used_bytes = allocator->used_bytes;
+    stats.free_bytes = stats.capacity - stats.used_bytes;
+    stats.allocation_count = allocator->allocation_count;
+    for (uint32_t i = 0; i < allocator->block_count; i++) {
+        const TlsfBlock* block = &allocator->blocks[i];
+        if (block->live && !block->used) {
+            stats.free_block_count++;
+            if (block->size > stats.largest_free_block) {
+                stats.largest_free_block = block->size;
+            }
+        }
+    }
+    stats.fragmentation = stats.free_bytes > 0 ? 1.0f - (float)stats.largest_free_block / (float)stats.free_bytes : 0.0f;
+    return stats;
+}
+
+int tlsf_validate(const TlsfAllocator* allocator) {
+    if (!allocator) {
+        return 0;
+    }
+
+    uint32_t free_in_pools = 0;
+    uint64_t used = 0;
+    for (uint32_t pool = 0; pool < allocator->pool_count; pool++) {
+        uint32_t offset = 0, prev = TLSF_INVALID;
+        int prev_free = 0;
+        for (uint32_t index = allocator->pool_first[pool]; index != TLSF_INVALID;
+             index = allocator->blocks[index].next_physical) {
+            const TlsfBlock* block = &allocator->blocks[index];
+            if (!block->live || block->pool != pool || block->offset != offset || block->prev_physical != prev ||
+                block->size == 0 || block->size % TLSF_GRANULARITY != 0 || (!block->used && prev_free)) {
+                return 0;
+            }
+            if (block->used) {
+                used += block->size;
+                if (block->offset & ((1u << block->alignment_log2) - 1)) return 0;
+            } else {
+                free_in_pools++;
+            }
+            prev_free = !block->used;
+            offset += block->size;
+            prev = index;
+        }
+        if (offset != allocator->pool_sizes[pool]) {
+            return 0;
+        }
+    }
+
+    uint32_t free_in_bins = 0;
+    for (uint32_t fl = 0; fl < TLSF_FL_COUNT; fl++) {
+        for (uint32_t sl = 0; sl < TLSF_SL_COUNT; sl++) {
+            uint32_t head = allocator->free_heads[fl][sl];
+            int bit = (allocator->sl_bitmap[fl] >> sl) & 1;
+            if (bit != (head != TLSF_INVALID)) {
+                return 0;
+            }
+            for (uint32_t index = head; index != TLSF_INVALID; index = allocator->blocks[index].next_free) {
+                uint32_t block_fl, block_sl;
+                tlsf_mapping(allocator->blocks[index].size / TLSF_GRANULARITY, &block_fl, &block_sl);
+                if (allocator->blocks[index].used || block_fl != fl || block_sl != sl) {
+                    return 0;
+                }
+                free_in_bins++;
+            }
+        }
+        if (((allocator->fl_bitmap >> fl) & 1) != (allocator->sl_bitmap[fl] != 0)) {
+            return 0;
+        }
+    }
+    return free_in_bins == free_in_pools && used == allocator->used_bytes;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void tlsf_print(const char* name, const TlsfAllocator* allocator) {
+    if (!allocator) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    TlsfStats stats = tlsf_stats(allocator);
+    printf("%s: %u pools, %.2f / %.2f MB used, %u allocations\n", name, stats.pool_count,
+           stats.used_bytes / (1024.0 * 1024.0), stats.capacity / (1024.0 * 1024.0), stats.allocation_count);
+    printf("  %u free blocks, largest %u bytes, fragmentation %.3f\n", stats.free_block_count,
+           stats.largest_free_block, stats.fragmentation);
+}
@@ -0,0 +1,140 @@
+#ifndef ENGINE_TLSF_H
+#define ENGINE_TLSF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+// ============================================================================
+// TLSF CONFIGURATION
+// ============================================================================
+
+#define TLSF_GRANULARITY 16                     // Every size and offset is a multiple of this
+#define TLSF_SL_LOG2 4                          // 16 second-level bins per power of two
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_COUNT 26                        // Blocks up to 4 GB
+#define TLSF_MAX_ALIGNMENT 4096
+#define TLSF_INVALID 0xFFFFFFFFu                // Invalid handle
+#define TLSF_DEFAULT_POOL_SIZE (64u << 20)
+#define TLSF_DEFAULT_MAX_POOLS 16
+
+// Called when the allocator adds a pool, so the backend can create the
+// buffer behind it. Return 0 to refuse (the allocation then fails).
+typedef int (*TlsfPoolCallback)(void* user, uint32_t pool, uint32_t size);
+
+// Called by defragmentation for each move; regions may overlap (memmove)
+typedef void (*TlsfMoveCallback)(void* user, uint32_t pool, uint32_t src_offset, uint32_t dst_offset, uint32_t size);
+
+typedef struct {
+    uint32_t pool_size;         // Bytes per pool (larger requests get a pool of their own size)
+    uint32_t max_pools;
+    TlsfPoolCallback on_pool_created;
+    void* user;
+} TlsfDesc;
+
+// ============================================================================
+// TLSF DATA STRUCTURES
+// ============================================================================
+
+// Where an allocation lives; stable until the next defragmentation
+typedef struct {
+    uint32_t pool;
+    uint32_t offset;
+    uint32_t size;              // Rounded up to TLSF_GRANULARITY
+} TlsfAllocation;
+
+// One physical block, free or used. Handles are block indices.
+typedef struct {
+    uint32_t offset;
+    uint32_t size;
+    uint32_t pool;
+    uint32_t prev_physical;     // Neighbours in address order within the pool
+    uint32_t next_physical;
+    uint32_t prev_free;         // Free-list links in its bin (free blocks only)
+    uint32_t next_free;
+    uint16_t alignment_log2;
+    uint8_t used;
+    uint8_t live;               // 0 when the slot is on the spare-node list
+} TlsfBlock;
+
+typedef struct {
+    uint32_t pool_count;
+    uint64_t capacity;          // Bytes across all pools
+    uint64_t used_bytes;
+    uint64_t free_bytes;
+    uint32_t allocation_count;
+    uint32_t free_block_count;
+    uint32_t largest_free_block;
+    float fragmentation;        // 1 - largest free block / free bytes
+} TlsfStats;
+
+// Two-level segregated-fit allocator over offsets in backend pools (GPU
+// buffers, host memory...). It never touches the memory it manages.
+typedef struct {
+    TlsfDesc desc;
+    TlsfBlock* blocks;
+    uint32_t block_count;
+    uint32_t block_capacity;
+    uint32_t spare_block;       // Head of recycled block slots
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[TLSF_FL_COUNT];
+    uint32_t free_heads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+    uint32_t* pool_sizes;
+    uint32_t* pool_first;       // First block of each pool in address order
+    uint32_t pool_count;
+    uint32_t allocation_count;
+    uint64_t used_bytes;
+} TlsfAllocator;
+
+// ============================================================================
+// TLSF FUNCTIONS
+// ============================================================================
+
+// Default: 64 MB pools, at most 16
+TlsfDesc tlsf_desc_default(void);
+
+// Create an allocator with no pools yet; the first allocation adds one
+TlsfAllocator* tlsf_create(const TlsfDesc* desc);
+
+// Free the allocator (not the backend pools)
+void tlsf_destroy(TlsfAllocator* allocator);
+
+// Add a pool explicitly. Returns its index or TLSF_INVALID.
+uint32_t tlsf_add_pool(TlsfAllocator* allocator, uint32_t size);
+
+// Allocate size bytes at a power-of-two alignment (at most
+// TLSF_MAX_ALIGNMENT). O(1) apart from adding a pool. Returns a handle or
+// TLSF_INVALID.
+uint32_t tlsf_alloc(TlsfAllocator* allocator, uint32_t size, uint32_t alignment);
+
+// Free an allocation, merging with free neighbours. O(1).
+void tlsf_free(TlsfAllocator* allocator, uint32_t handle);
+
+// Pool, offset and size of an allocation (all zero for a bad handle)
+TlsfAllocation tlsf_allocation(const TlsfAllocator* allocator, uint32_t handle);
+
+// Slide allocations towards the start of their pools so free space
+// coalesces at the end, moving at most max_bytes (0: no limit). Handles
+// stay valid; their offsets change. Returns the bytes moved.
+uint64_t tlsf_defragment(TlsfAllocator* allocator, uint64_t max_bytes, TlsfMoveCallback move, void* user);
+
+// Usage and fragmentation
+TlsfStats tlsf_stats(const TlsfAllocator* allocator);
+
+// Verify bins, bitmaps and physical links; returns 1 when consistent
+int tlsf_validate(const TlsfAllocator* allocator);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print pools, usage and fragmentation
+void tlsf_print(const char* name, const TlsfAllocator* allocator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_TLSF_H
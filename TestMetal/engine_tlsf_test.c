@@ -0,0 +1,357 @@
+#include "engine_tlsf.h"
+#include "engine_profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+// ============================================================================
+// HOST-MEMORY BACKEND
+// ============================================================================
+
+// Pools are plain host buffers; the allocator only sees offsets
+typedef struct {
+    uint8_t* pools[TLSF_DEFAULT_MAX_POOLS];
+    uint32_t sizes[TLSF_DEFAULT_MAX_POOLS];
+    uint32_t created;
+    int refuse;
+} HostBackend;
+
+static int host_pool_created(void* user, uint32_t pool, uint32_t size) {
+    HostBackend* backend = (HostBackend*)user;
+    if (backend->refuse || pool >= TLSF_DEFAULT_MAX_POOLS) {
+        return 0;
+    }
+    backend->pools[pool] = (uint8_t*)malloc(size);
+    backend->sizes[pool] = size;
+    backend->created++;
+    return backend->pools[pool] != NULL;
+}
+
+static void host_move(void* user, uint32_t pool, uint32_t src_offset, uint32_t dst_offset, uint32_t size) {
+    HostBackend* backend = (HostBackend*)user;
+    memmove(backend->pools[pool] + dst_offset, backend->pools[pool] + src_offset, size);
+}
+
+static void host_backend_free(HostBackend* backend) {
+    for (uint32_t i = 0; i < TLSF_DEFAULT_MAX_POOLS; i++) {
+        free(backend->pools[i]);
+    }
+    memset(backend, 0, sizeof(*backend));
+}
+
+static uint32_t test_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// Fill an allocation with a pattern derived from its handle
+static void fill_allocation(const TlsfAllocator* allocator, const HostBackend* backend, uint32_t handle) {
+    TlsfAllocation a = tlsf_allocation(allocator, handle);
+    uint8_t* p = backend->pools[a.pool] + a.offset;
+    for (uint32_t i = 0; i < a.size; i++) p[i] = (uint8_t)(handle * 31 + i);
+}
+
+static int check_allocation(const TlsfAllocator* allocator, const HostBackend* backend, uint32_t handle) {
+    TlsfAllocation a = tlsf_allocation(allocator, handle);
+    const uint8_t* p = backend->pools[a.pool] + a.offset;
+    for (uint32_t i = 0; i < a.size; i++) {
+        if (p[i] != (uint8_t)(handle * 31 + i)) return 0;
+    }
+    return 1;
+}
+
+// ============================================================================
+// ALLOCATION TESTS
+// ============================================================================
+
+static void test_basic(void) {
+    printf("\n--- Basic Allocation Tests ---\n");
+
+    TlsfDesc desc = tlsf_desc_default();
+    TEST_ASSERT_EQUAL(TLSF_DEFAULT_POOL_SIZE, desc.pool_size, "Default pools should be 64 MB");
+
+    HostBackend backend;
+    memset(&backend, 0, sizeof(backend));
+    desc.pool_size = 1 << 20;
+    desc.on_pool_created = host_pool_created;
+    desc.user = &backend;
+    TlsfAllocator* allocator = tlsf_create(&desc);
+    TEST_ASSERT_NOT_NULL(allocator, "Allocator should be created");
+    if (!allocator) return;
+    TEST_ASSERT_EQUAL(0u, allocator->pool_count, "No pool should exist before the first allocation");
+
+    uint32_t a = tlsf_alloc(allocator, 100, 0);
+    TlsfAllocation info = tlsf_allocation(allocator, a);
+    TEST_ASSERT(a != TLSF_INVALID && info.pool == 0 && info.offset == 0 && info.size == 112,
+                "First allocation should round up to the granularity at offset 0");
+    TEST_ASSERT_EQUAL(1u, backend.created, "The first allocation should create a pool through the callback");
+
+    uint32_t b = tlsf_alloc(allocator, 1000, 256);
+    info = tlsf_allocation(allocator, b);
+    TEST_ASSERT(b != TLSF_INVALID && info.offset % 256 == 0, "Aligned allocations should honour the alignment");
+    uint32_t c = tlsf_alloc(allocator, 5000, 0);
+    TEST_ASSERT(tlsf_validate(allocator), "Allocator should validate after allocations");
+
+    TlsfStats stats = tlsf_stats(allocator);
+    TEST_ASSERT(stats.allocation_count == 3 && stats.used_bytes == 112 + 1008 + 5008,
+                "Stats should count allocations and used bytes");
+    TEST_ASSERT(stats.free_block_count == 2, "Alignment padding should stay available as a free block");
+
+    // Good fit: a freed hole of a bin-boundary size is found again
+    uint32_t d = tlsf_alloc(allocator, 1024, 0);
+    uint32_t e = tlsf_alloc(allocator, 64, 0);
+    uint32_t d_offset = tlsf_allocation(allocator, d).offset;
+    tlsf_free(allocator, d);
+    d = tlsf_alloc(allocator, 1024, 0);
+    TEST_ASSERT_EQUAL(d_offset, tlsf_allocation(allocator, d).offset, "A freed hole should be reused");
+    tlsf_free(allocator, d);
+    tlsf_free(allocator, e);
+
+    tlsf_free(allocator, a);
+    tlsf_free(allocator, b);
+    tlsf_free(allocator, c);
+    stats = tlsf_stats(allocator);
+    TEST_ASSERT(stats.allocation_count == 0 && stats.free_block_count == 1 && stats.largest_free_block == (1u << 20),
+                "Freeing everything should coalesce back into one block");
+    TEST_ASSERT(tlsf_validate(allocator), "Allocator should validate after frees");
+
+    TEST_ASSERT(tlsf_alloc(allocator, 0, 0) == TLSF_INVALID, "Zero-size allocations should fail");
+    TEST_ASSERT(tlsf_alloc(allocator, 64, 48) == TLSF_INVALID, "Non-power-of-two alignments should fail");
+    TEST_ASSERT(tlsf_alloc(allocator, 64, TLSF_MAX_ALIGNMENT * 2) == TLSF_INVALID, "Oversized alignments should fail");
+    tlsf_free(allocator, c);
+    tlsf_free(allocator, TLSF_INVALID);
+    TEST_ASSERT(tlsf_validate(allocator), "Double frees should be rejected without corruption");
+    TEST_ASSERT_EQUAL(0u, tlsf_allocation(allocator, c).size, "Freed handles should report nothing");
+    TEST_ASSERT(tlsf_create(&(TlsfDesc){ 0, 1, NULL, NULL }) == NULL, "Zero-size pools should be rejected");
+
+    tlsf_print("Allocator", allocator);
+    tlsf_destroy(allocator);
+    host_backend_free(&backend);
+}
+
+static void test_pools(void) {
+    printf("\n--- Pool Tests ---\n");
+
+    HostBackend backend;
+    memset(&backend, 0, sizeof(backend));
+    TlsfDesc desc = tlsf_desc_default();
+    desc.pool_size = 4096;
+    desc.max_pools = 3;
+    desc.on_pool_created = host_pool_created;
+    desc.user = &backend;
+    TlsfAllocator* allocator = tlsf_create(&desc);
+    if (!allocator) return;
+
+    uint32_t first = tlsf_alloc(allocator, 3000, 0);
+    uint32_t second = tlsf_alloc(allocator, 3000, 0);
+    TEST_ASSERT(tlsf_allocation(allocator, first).pool == 0 && tlsf_allocation(allocator, second).pool == 1,
+                "A full pool should spill into a new one");
+
+    uint32_t big = tlsf_alloc(allocator, 100000, 0);
+    TEST_ASSERT(big != TLSF_INVALID && allocator->pool_sizes[2] >= 100000,
+                "Requests larger than a pool should get a pool of their own size");
+    TEST_ASSERT(tlsf_alloc(allocator, 8000, 0) == TLSF_INVALID, "Allocation should fail at the pool limit");
+    TEST_ASSERT(tlsf_validate(allocator), "Allocator should validate across pools");
+    tlsf_destroy(allocator);
+    host_backend_free(&backend);
+
+    memset(&backend, 0, sizeof(backend));
+    backend.refuse = 1;
+    desc.user = &backend;
+    allocator = tlsf_create(&desc);
+    TEST_ASSERT(allocator && tlsf_alloc(allocator, 64, 0) == TLSF_INVALID,
+                "A backend refusing a pool should fail the allocation");
+    TEST_ASSERT(allocator && tlsf_add_pool(allocator, 8192) == TLSF_INVALID, "Explicit pools should ask the backend too");
+    tlsf_destroy(allocator);
+
+    allocator = tlsf_create(NULL);
+    TEST_ASSERT(allocator && tlsf_add_pool(allocator, 1000) == 0 && allocator->pool_sizes[0] == 992,
+                "Explicit pools should round down to the granularity");
+    tlsf_destroy(allocator);
+}
+
+// ============================================================================
+// STRESS AND DEFRAGMENTATION TESTS
+// ============================================================================
+
+static void test_stress(void) {
+    printf("\n--- Stress Tests ---\n");
+
+    HostBackend backend;
+    memset(&backend, 0, sizeof(backend));
+    TlsfDesc desc = tlsf_desc_default();
+    desc.pool_size = 8 << 20;
+    desc.on_pool_created = host_pool_created;
+    desc.user = &backend;
+    TlsfAllocator* allocator = tlsf_create(&desc);
+    if (!allocator) return;
+
+    enum { SLOTS = 2000, OPS = 40000 };
+    uint32_t handles[SLOTS];
+    for (uint32_t i = 0; i < SLOTS; i++) handles[i] = TLSF_INVALID;
+
+    uint32_t seed = 0x1234567u;
+    int ok = 1, valid = 1;
+    for (uint32_t op = 0; op < OPS; op++) {
+        uint32_t slot = test_random(&seed) % SLOTS;
+        if (handles[slot] != TLSF_INVALID) {
+            ok &= check_allocation(allocator, &backend, handles[slot]);
+            tlsf_free(allocator, handles[slot]);
+            handles[slot] = TLSF_INVALID;
+        } else {
+            uint32_t size = 16 + test_random(&seed) % (test_random(&seed) % 4 == 0 ? 32768 : 1024);
+            uint32_t alignment = 1u << (test_random(&seed) % 9);
+            handles[slot] = tlsf_alloc(allocator, size, alignment);
+            if (handles[slot] != TLSF_INVALID) {
+                TlsfAllocation a = tlsf_allocation(allocator, handles[slot]);
+                ok &= a.size >= size && a.offset % (alignment < TLSF_GRANULARITY ? TLSF_GRANULARITY : alignment) == 0;
+                fill_allocation(allocator, &backend, handles[slot]);
+            }
+        }
+        if (op % 5000 == 0) valid &= tlsf_validate(allocator);
+    }
+    for (uint32_t i = 0; i < SLOTS; i++) {
+        if (handles[i] != TLSF_INVALID) ok &= check_allocation(allocator, &backend, handles[i]);
+    }
+    TEST_ASSERT(ok, "Random allocations should never overlap or lose their contents");
+    TEST_ASSERT(valid && tlsf_validate(allocator), "Allocator should stay consistent under random traffic");
+
+    // Punch holes, then compact
+    for (uint32_t i = 0; i < SLOTS; i += 2) {
+        tlsf_free(allocator, handles[i]);
+        handles[i] = TLSF_INVALID;
+    }
+    TlsfStats before = tlsf_stats(allocator);
+    tlsf_print("Fragmented", allocator);
+
+    uint64_t limited = tlsf_defragment(allocator, 64 * 1024, host_move, &backend);
+    TEST_ASSERT(limited > 0 && limited <= 64 * 1024, "Incremental defragmentation should respect its byte budget");
+    uint64_t moved = limited;
+    uint64_t step;
+    while ((step = tlsf_defragment(allocator, 256 * 1024, host_move, &backend)) > 0) {
+        moved += step;
+    }
+    TlsfStats after = tlsf_stats(allocator);
+    tlsf_print("Defragmented", allocator);
+    printf("  Moved %.2f MB; fragmentation %.3f -> %.3f\n", moved / (1024.0 * 1024.0), before.fragmentation,
+           after.fragmentation);
+
+    ok = 1;
+    for (uint32_t i = 0; i < SLOTS; i++) {
+        if (handles[i] != TLSF_INVALID) ok &= check_allocation(allocator, &backend, handles[i]);
+    }
+    TEST_ASSERT(ok, "Allocations should keep their contents through defragmentation");
+    TEST_ASSERT(tlsf_validate(allocator), "Allocator should validate after defragmentation");
+    TEST_ASSERT(after.used_bytes == before.used_bytes && after.free_block_count < before.free_block_count,
+                "Defragmentation should coalesce free space without changing usage");
+    TEST_ASSERT(after.fragmentation < 0.05f && after.fragmentation < before.fragmentation,
+                "Defragmentation should leave little besides alignment padding");
+
+    for (uint32_t i = 0; i < SLOTS; i++) tlsf_free(allocator, handles[i]);
+    TEST_ASSERT(tlsf_stats(allocator).free_block_count == allocator->pool_count, "Everything should coalesce at the end");
+    tlsf_destroy(allocator);
+    host_backend_free(&backend);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    TlsfDesc desc = tlsf_desc_default();
+    desc.pool_size = 256u << 20;
+    TlsfAllocator* allocator = tlsf_create(&desc);
+    if (!allocator) return;
+
+    enum { SLOTS = 16384, OPS = 2000000 };
+    uint32_t* handles = (uint32_t*)malloc(SLOTS * sizeof(uint32_t));
+    for (uint32_t i = 0; i < SLOTS; i++) handles[i] = TLSF_INVALID;
+
+    uint32_t seed = 0xBADC0DEu;
+    uint32_t failures = 0;
+    double start = now_ms();
+    for (uint32_t op = 0; op < OPS; op++) {
+        uint32_t slot = test_random(&seed) % SLOTS;
+        if (handles[slot] != TLSF_INVALID) {
+            tlsf_free(allocator, handles[slot]);
+            handles[slot] = TLSF_INVALID;
+        } else {
+            handles[slot] = tlsf_alloc(allocator, 64 + test_random(&seed) % 16384, 16);
+            failures += handles[slot] == TLSF_INVALID;
+        }
+    }
+    double elapsed = now_ms() - start;
+    double ns_per_op = elapsed * 1.0e6 / OPS;
+    TlsfStats stats = tlsf_stats(allocator);
+    printf("  %d mixed alloc/free: %.2f ms (%.1f ns/op), %u live, fragmentation %.3f\n", OPS, elapsed, ns_per_op,
+           stats.allocation_count, stats.fragmentation);
+
+    TEST_ASSERT(failures == 0 && tlsf_validate(allocator), "Benchmark traffic should fit and stay consistent");
+    TEST_ASSERT(ns_per_op < 500.0, "Alloc/free should average under 500 ns");
+
+    free(handles);
+    tlsf_destroy(allocator);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting TLSF Allocator Unit Tests\n");
+    printf("===================================\n");
+
+    test_basic();
+    test_pools();
+    test_stress();
+
+    // ENGINE_PROFILE=<file> samples the benchmarks into collapsed stacks
+    ProfilerHandle profiler = profiler_begin_from_env();
+    test_performance();
+    profiler_end_from_env(profiler);
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
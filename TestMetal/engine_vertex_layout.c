@@ -0,0 +1,426 @@
+#include "engine_vertex_layout.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// ============================================================================
+// GENERATED CONSTANTS
+// ============================================================================
+
+enum {
+#define VERTEX_FORMAT_CONSTANTS(name, components, bytes, metal) \
+    VERTEX_FORMAT_COMPONENTS_##name = components, VERTEX_FORMAT_BYTES_##name = bytes,
+    VERTEX_FORMAT_LIST(VERTEX_FORMAT_CONSTANTS)
+#undef VERTEX_FORMAT_CONSTANTS
+
+#define VERTEX_SEMANTIC_CONSTANTS(name, index, components, field) \
+    VERTEX_SOURCE_COMPONENTS_##name = components, VERTEX_SOURCE_OFFSET_##name = offsetof(Vertex, field),
+    VERTEX_SEMANTIC_LIST(VERTEX_SEMANTIC_CONSTANTS)
+#undef VERTEX_SEMANTIC_CONSTANTS
+};
+
+// C99 compile-time check: a negative array size fails the build
+#define VERTEX_LAYOUT_STATIC_ASSERT(condition, tag) typedef char vertex_layout_assert_##tag[(condition) ? 1 : -1]
+
+// The standard layout must stay the Vertex struct byte for byte; this is
+// what lets upload skip conversion
+VERTEX_LAYOUT_STATIC_ASSERT(sizeof(Vertex) == 32, standard_stride);
+#define VERTEX_STANDARD_CHECK(semantic, format, stream, offset)                                                   \
+    VERTEX_LAYOUT_STATIC_ASSERT(stream == 0 && VERTEX_SOURCE_OFFSET_##semantic == (offset) &&                    \
+                                VERTEX_FORMAT_BYTES_##format == 4 * VERTEX_SOURCE_COMPONENTS_##semantic,       \
+                                standard_##semantic);
+VERTEX_LAYOUT_STANDARD_ATTRIBUTES(VERTEX_STANDARD_CHECK)
+#undef VERTEX_STANDARD_CHECK
+
+// ============================================================================
+// LAYOUT TABLE
+// ============================================================================
+
+#define VERTEX_LAYOUT_ATTRIBUTE_DESC(semantic, format, stream, offset) \
+    { VERTEX_SEMANTIC_##semantic, VERTEX_FORMAT_##format, stream, 0, offset },
+#define VERTEX_LAYOUT_ATTRIBUTE_ONE(semantic, format, stream, offset) +1
+#define VERTEX_LAYOUT_DESC(name, attributes, stride0, stride1)                                  \
+    { #name, { attributes(VERTEX_LAYOUT_ATTRIBUTE_DESC) }, 0 attributes(VERTEX_LAYOUT_ATTRIBUTE_ONE), \
+      (stride1) ? 2 : 1, { stride0, stride1 } },
+
+static const VertexLayout vertex_layouts[VERTEX_LAYOUT_COUNT] = {
+    VERTEX_LAYOUT_LIST(VERTEX_LAYOUT_DESC)
+};
+
+#undef VERTEX_LAYOUT_DESC
+#undef VERTEX_LAYOUT_ATTRIBUTE_ONE
+#undef VERTEX_LAYOUT_ATTRIBUTE_DESC
+
+// ============================================================================
+// FORMAT CONVERSION
+// ============================================================================
+
+// Round to nearest even; overflow goes to infinity, tiny values to subnormals
+FORCE_INLINE uint16_t float_to_half(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+    if (magnitude >= 0x47800000u) {
+        return (uint16_t)(sign | (magnitude > 0x7F800000u ? 0x7E00u : 0x7C00u));
+    }
+    if (magnitude < 0x38800000u) {
+        float scaled;
+        memcpy(&scaled, &magnitude, sizeof(scaled));
+        return (uint16_t)(sign | (uint32_t)lrintf(scaled * 16777216.0f));
+    }
+    uint32_t half = (magnitude - 0x38000000u) >> 13;
+    uint32_t rest = magnitude & 0x1FFFu;
+    half += rest > 0x1000u || (rest == 0x1000u && (half & 1));
+    return (uint16_t)(sign | half);
+}
+
+FORCE_INLINE float half_to_float(uint16_t half) {
+    uint32_t sign = (uint32_t)(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1Fu;
+    uint32_t mantissa = half & 0x3FFu;
+    uint32_t bits;
+    if (exponent == 0) {
+        float value = (float)mantissa * (1.0f / 16777216.0f);
+        return sign ? -value : value;
+    }
+    if (exponent == 31) {
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    }
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+FORCE_INLINE float vertex_component(const float* values, uint32_t components, uint32_t c) {
+    return c < components ? values[c] : 0.0f;
+}
+
+FORCE_INLINE float vertex_clamp(float value, float lo, float hi) {
+    return value < lo ? lo : (value > hi ? hi : value);
+}
+
+// Stores: dst may be unaligned, `components` comes from the source semantic
+#define VERTEX_STORE_FLOATS(name, count)                                                               \
+    FORCE_INLINE void vertex_store_##name(uint8_t* dst, const float* values, uint32_t components) {    \
+        float out[count];                                                                              \
+        for (uint32_t c = 0; c < count; c++) out[c] = vertex_component(values, components, c);         \
+        memcpy(dst, out, sizeof(out));                                                                 \
+    }                                                                                                  \
+    FORCE_INLINE void vertex_load_##name(const uint8_t* src, float* values, uint32_t components) {    \
+        float in[count];                                                                               \
+        memcpy(in, src, sizeof(in));                                                                   \
+        for (uint32_t c = 0; c < components; c++) values[c] = c < count ? in[c] : 0.0f;                \
+    }
+
+#define VERTEX_STORE_HALVES(name, count)                                                               \
+    FORCE_INLINE void vertex_store_##name(uint8_t* dst, const float* values, uint32_t components) {    \
+        uint16_t out[count];                                                                           \
+        for (uint32_t c = 0; c < count; c++) out[c] = float_to_half(vertex_component(values, components, c)); \
+        memcpy(dst, out, sizeof(out));                                                                 \
+    }                                                                                                  \
+    FORCE_INLINE void vertex_load_##name(const uint8_t* src, float* values, uint32_t components) {    \
+        uint16_t in[count];                                                                            \
+        memcpy(in, src, sizeof(in));                                                                   \
+        for (uint32_t c = 0; c < components; c++) values[c] = c < count ? half_to_float(in[c]) : 0.0f; \
+    }
+
+VERTEX_STORE_FLOATS(FLOAT2, 2)
+VERTEX_STORE_FLOATS(FLOAT3, 3)
+VERTEX_STORE_FLOATS(FLOAT4, 4)
+VERTEX_STORE_HALVES(HALF2, 2)
+VERTEX_STORE_HALVES(HALF4, 4)
+
+#undef VERTEX_STORE_HALVES
+#undef VERTEX_STORE_FLOATS
+
+FORCE_INLINE void vertex_store_SNORM8X4(uint8_t* dst, const float* values, uint32_t components) {
+    for (uint32_t c = 0; c < 4; c++) {
+        dst[c] = (uint8_t)(int8_t)lrintf(vertex_clamp(vertex_component(values, components, c), -1.0f, 1.0f) * 127.0f);
+    }
+}
+
+FORCE_INLINE void vertex_load_SNORM8X4(const uint8_t* src, float* values, uint32_t components) {
+    for (uint32_t c = 0; c < components; c++) {
+        values[c] = c < 4 ? vertex_clamp((float)(int8_t)src[c] * (1.0f / 127.0f), -1.0f, 1.0f) : 0.0f;
+    }
+}
+
+FORCE_INLINE void vertex_store_UNORM8X4(uint8_t* dst, const float* values, uint32_t components) {
+    for (uint32_t c = 0; c < 4; c++) {
+        dst[c] = (uint8_t)lrintf(vertex_clamp(vertex_component(values, components, c), 0.0f, 1.0f) * 255.0f);
+    }
+}
+
+FORCE_INLINE void vertex_load_UNORM8X4(const uint8_t* src, float* values, uint32_t components) {
+    for (uint32_t c = 0; c < components; c++) {
+        values[c] = c < 4 ? (float)src[c] * (1.0f / 255.0f) : 0.0f;
+    }
+}
+
+// ============================================================================
+// GENERATED PACKERS
+// ============================================================================
+
+#define VERTEX_SOURCE(vertex, semantic) ((const float*)((const uint8_t*)(vertex) + VERTEX_SOURCE_OFFSET_##semantic))
+#define VERTEX_TARGET(vertex, semantic) ((float*)((uint8_t*)(vertex) + VERTEX_SOURCE_OFFSET_##semantic))
+
+// One function per layout with every offset, stride and format a constant
+#define VERTEX_PACK_ATTRIBUTE(semantic, format, stream, offset)                                          \
+    vertex_store_##format(base[stream] + (size_t)i * strides[stream] + (offset), VERTEX_SOURCE(v, semantic), \
+                          VERTEX_SOURCE_COMPONENTS_##semantic);
+#define VERTEX_UNPACK_ATTRIBUTE(semantic, format, stream, offset)                                        \
+    vertex_load_##format(base[stream] + (size_t)i * strides[stream] + (offset), VERTEX_TARGET(v, semantic), \
+                         VERTEX_SOURCE_COMPONENTS_##semantic);
+
+#define VERTEX_LAYOUT_CODEC(name, attributes, stride0, stride1)                                          \
+    static void vertex_pack_##name(const Vertex* RESTRICT vertices, uint32_t count, void* const* streams) { \
+        uint8_t* base[VERTEX_LAYOUT_MAX_STREAMS] = { (uint8_t*)streams[0], (stride1) ? (uint8_t*)streams[1] : NULL }; \
+        const uint32_t strides[VERTEX_LAYOUT_MAX_STREAMS] = { stride0, stride1 };                       \
+        for (uint32_t i = 0; i < count; i++) {                                                          \
+            const Vertex* v = &vertices[i];                                                             \
+            attributes(VERTEX_PACK_ATTRIBUTE)                                                           \
+        }                                                                                               \
+    }                                                                                                   \
+    static void vertex_unpack_##name(const void* const* streams, uint32_t count, Vertex* RESTRICT vertices) { \
+        const uint8_t* base[VERTEX_LAYOUT_MAX_STREAMS] = {                                              \
+            (const uint8_t*)streams[0], (stride1) ? (const uint8_t*)streams[1] : NULL };                \
+        const uint32_t strides[VERTEX_LAYOUT_MAX_STREAMS] = { stride0, stride1 };                       \
+        for (uint32_t i = 0; i < count; i++) {                                                          \
+            Vertex* v = &vertices[i];                                                                   \
+            *v = vertex_default();                                                                      \
+            attributes(VERTEX_UNPACK_ATTRIBUTE)                                                         \
+        }                                                                                               \
+    }
+
+VERTEX_LAYOUT_LIST(VERTEX_LAYOUT_CODEC)
+
+#undef VERTEX_LAYOUT_CODEC
+#undef VERTEX_UNPACK_ATTRIBUTE
+#undef VERTEX_PACK_ATTRIBUTE
+
+typedef void (*VertexPackFunc)(const Vertex* RESTRICT vertices, uint32_t count, void* const* streams);
+typedef void (*VertexUnpackFunc)(const void* const* streams, uint32_t count, Vertex* RESTRICT vertices);
+
+#define VERTEX_LAYOUT_PACK_ENTRY(name, attributes, stride0, stride1) vertex_pack_##name,
+#define VERTEX_LAYOUT_UNPACK_ENTRY(name, attributes, stride0, stride1) vertex_unpack_##name,
+static const VertexPackFunc vertex_packers[VERTEX_LAYOUT_COUNT] = { VERTEX_LAYOUT_LIST(VERTEX_LAYOUT_PACK_ENTRY) };
+static const VertexUnpackFunc vertex_unpackers[VERTEX_LAYOUT_COUNT] = { VERTEX_LAYOUT_LIST(VERTEX_LAYOUT_UNPACK_ENTRY) };
+#undef VERTEX_LAYOUT_UNPACK_ENTRY
+#undef VERTEX_LAYOUT_PACK_ENTRY
+
+// ============================================================================
+// VERTEX LAYOUT FUNCTIONS
+// ============================================================================
+
+const VertexLayout* vertex_layout_get(uint32_t layout_id) {
+    return layout_id < VERTEX_LAYOUT_COUNT ? &vertex_layouts[layout_id] : NULL;
+}
+
+const VertexLayout* mesh_vertex_layout(const Mesh* mesh) {
+    return mesh ? vertex_layout_get(mesh->vertex_layout) : NULL;
+}
+
+uint32_t vertex_format_components(uint32_t format) {
+    switch (format) {
+#define VERTEX_FORMAT_CASE(name, components, bytes, metal) case VERTEX_FORMAT_##name: return components;
+        VERTEX_FORMAT_LIST(VERTEX_FORMAT_CASE)
+#undef VERTEX_FORMAT_CASE
+        default: return 0;
+    }
+}
+
+uint32_t vertex_format_size(uint32_t format) {
+    switch (format) {
+#define VERTEX_FORMAT_CASE(name, components, bytes, metal) case VERTEX_FORMAT_##name: return bytes;
+        VERTEX_FORMAT_LIST(VERTEX_FORMAT_CASE)
+#undef VERTEX_FORMAT_CASE
+        default: return 0;
+    }
+}
+
+size_t vertex_layout_stream_size(const VertexLayout* layout, uint32_t stream, uint32_t vertex_count) {
+    if (!layout || stream >= layout->stream_count) {
+        return 0;
+    }
+    return (size_t)layout->strides[stream] * vertex_count;
+}
+
+size_t vertex_layout_size(const VertexLayout* layout, uint32_t vertex_count) {
+    size_t size = 0;
+    for (uint32_t s = 0; layout && s < layout->stream_count; s++) {
+        size += vertex_layout_stream_size(layout, s, vertex_count);
+    }
+    return size;
+}
+
+int vertex_layout_matches_vertex(const VertexLayout* layout) {
+    if (!layout || layout->stream_count != 1 || layout->strides[0] != sizeof(Vertex) ||
+        layout->attribute_count != VERTEX_SEMANTIC_COUNT) {
+        return 0;
+    }
+
+    static const uint32_t source_offsets[VERTEX_SEMANTIC_COUNT] = {
+#define VERTEX_SEMANTIC_OFFSET(name, index, components, field) [index] = offsetof(Vertex, field),
+        VERTEX_SEMANTIC_LIST(VERTEX_SEMANTIC_OFFSET)
+#undef VERTEX_SEMANTIC_OFFSET
+    };
+    static const uint32_t source_components[VERTEX_SEMANTIC_COUNT] = {
+#define VERTEX_SEMANTIC_COMPONENTS(name, index, components, field) [index] = components,
+        VERTEX_SEMANTIC_LIST(VERTEX_SEMANTIC_COMPONENTS)
+#undef VERTEX_SEMANTIC_COMPONENTS
+    };
+    for (uint32_t a = 0; a < layout->attribute_count; a++) {
+        const VertexAttributeDesc* attribute = &layout->attributes[a];
+        int is_float = attribute->format == VERTEX_FORMAT_FLOAT2 || attribute->format == VERTEX_FORMAT_FLOAT3 ||
+                       attribute->format == VERTEX_FORMAT_FLOAT4;
+        if (attribute->semantic >= VERTEX_SEMANTIC_COUNT || !is_float ||
+            vertex_format_components(attribute->format) != source_components[attribute->semantic] ||
+            attribute->offset != source_offsets[attribute->semantic]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int vertex_layout_validate(const VertexLayout* layout) {
+    if (!layout || layout->attribute_count == 0 || layout->attribute_count > VERTEX_LAYOUT_MAX_ATTRIBUTES ||
+        layout->stream_count == 0 || layout->stream_count > VERTEX_LAYOUT_MAX_STREAMS) {
+        return 0;
+    }
+    for (uint32_t s = 0; s < layout->stream_count; s++) {
+        if (layout->strides[s] == 0 || layout->strides[s] % 4 != 0) {
+            return 0;
+        }
+    }
+
+    uint32_t semantics_seen = 0;
+    for (uint32_t a = 0; a < layout->attribute_count; a++) {
+        const VertexAttributeDesc* attribute = &layout->attributes[a];
+        uint32_t size = vertex_format_size(attribute->format);
+        if (size == 0 || attribute->semantic >= VERTEX_SEMANTIC_COUNT || attribute->stream >= layout->stream_count ||
+            attribute->offset % 4 != 0 || attribute->offset + size > layout->strides[attribute->stream] ||
+            (semantics_seen & (1u << attribute->semantic))) {
+            return 0;
+        }
+        semantics_seen |= 1u << attribute->semantic;
+
+        for (uint32_t b = 0; b < a; b++) {
+            const VertexAttributeDesc* other = &layout->attributes[b];
+            if (other->stream == attribute->stream && attribute->offset < other->offset + vertex_format_size(other->format) &&
+                other->offset < attribute->offset + size) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+int vertex_layout_pack(uint32_t layout_id, const Vertex* vertices, uint32_t count, void* const* streams) {
+    const VertexLayout* layout = vertex_layout_get(layout_id);
+    if (!layout || (count > 0 && (!vertices || !streams))) {
+        fprintf(stderr, "Error: Invalid vertex layout pack parameters\n");
+        return 0;
+    }
+    if (count == 0) {
+        return 1;
+    }
+    for (uint32_t s = 0; s < layout->stream_count; s++) {
+        if (!streams[s]) {
+            fprintf(stderr, "Error: Vertex layout %s is missing stream %u\n", layout->name, s);
+            return 0;
+        }
+    }
+
+    if (vertex_layout_matches_vertex(layout)) {
+        memcpy(streams[0], vertices, (size_t)count * sizeof(Vertex));
+        return 1;
+    }
+    vertex_packers[layout_id](vertices, count, streams);
+    return 1;
+}
+
+int vertex_layout_unpack(uint32_t layout_id, const void* const* streams, uint32_t count, Vertex* vertices) {
+    const VertexLayout* layout = vertex_layout_get(layout_id);
+    if (!layout || (count > 0 && (!vertices || !streams))) {
+        fprintf(stderr, "Error: Invalid vertex layout unpack parameters\n");
+        return 0;
+    }
+    if (count == 0) {
+        return 1;
+    }
+    for (uint32_t s = 0; s < layout->stream_count; s++) {
+        if (!streams[s]) {
+            fprintf(stderr, "Error: Vertex layout %s is missing stream %u\n", layout->name, s);
+            return 0;
+        }
+    }
+
+    if (vertex_layout_matches_vertex(layout)) {
+        memcpy(vertices, streams[0], (size_t)count * sizeof(Vertex));
+        return 1;
+    }
+    vertex_unpackers[layout_id](streams, count, vertices);
+    return 1;
+}
+
+void vertex_format_encode(uint32_t format, const float* values, uint32_t components, void* dst) {
+    switch (format) {
+#define VERTEX_FORMAT_CASE(name, count, bytes, metal) \
+        case VERTEX_FORMAT_##name: vertex_store_##name((uint8_t*)dst, values, components); break;
+        VERTEX_FORMAT_LIST(VERTEX_FORMAT_CASE)
+#undef VERTEX_FORMAT_CASE
+        default: break;
+    }
+}
+
+void vertex_format_decode(uint32_t format, const void* src, float* values, uint32_t components) {
+    switch (format) {
+#define VERTEX_FORMAT_CASE(name, count, bytes, metal) \
+        case VERTEX_FORMAT_##name: vertex_load_##name((const uint8_t*)src, values, components); break;
+        VERTEX_FORMAT_LIST(VERTEX_FORMAT_CASE)
+#undef VERTEX_FORMAT_CASE
+        default:
+            for (uint32_t c = 0; c < components; c++) values[c] = 0.0f;
+            break;
+    }
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void vertex_layout_print(const char* name, const VertexLayout* layout) {
+    if (!layout) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    static const char* format_names[VERTEX_FORMAT_COUNT] = {
+#define VERTEX_FORMAT_NAME(format, components, bytes, metal) #format,
+        VERTEX_FORMAT_LIST(VERTEX_FORMAT_NAME)
+#undef VERTEX_FORMAT_NAME
+    };
+    static const char* semantic_names[VERTEX_SEMANTIC_COUNT] = {
+#define VERTEX_SEMANTIC_NAME(semantic, index, components, field) [index] = #semantic,
+        VERTEX_SEMANTIC_LIST(VERTEX_SEMANTIC_NAME)
+#undef VERTEX_SEMANTIC_NAME
+    };
+
+    printf("%s: layout %s, %u attributes, %u stream%s (stride", name, layout->name, layout->attribute_count,
+           layout->stream_count, layout->stream_count == 1 ? "" : "s");
+    for (uint32_t s = 0; s < layout->stream_count; s++) {
+        printf(" %u", layout->strides[s]);
+    }
+    printf(")%s\n", vertex_layout_matches_vertex(layout) ? ", matches Vertex" : "");
+    for (uint32_t a = 0; a < layout->attribute_count; a++) {
+        const VertexAttributeDesc* attribute = &layout->attributes[a];
+        printf("  %-8s %-8s stream %u offset %u\n",
+               attribute->semantic < VERTEX_SEMANTIC_COUNT ? semantic_names[attribute->semantic] : "?",
+               attribute->format < VERTEX_FORMAT_COUNT ? format_names[attribute->format] : "?", attribute->stream,
+               attribute->offset);
+    }
+}
@@ -0,0 +1,156 @@
+#ifndef ENGINE_VERTEX_LAYOUT_H
+#define ENGINE_VERTEX_LAYOUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_model.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// ============================================================================
+// VERTEX LAYOUT CONFIGURATION
+// ============================================================================
+
+#define VERTEX_LAYOUT_MAX_ATTRIBUTES 8
+#define VERTEX_LAYOUT_MAX_STREAMS 2
+
+// Attribute formats: X(name, components, bytes, metal_format), where
+// metal_format completes MTLVertexFormat<metal_format>
+#define VERTEX_FORMAT_LIST(X)                   \
+    X(FLOAT2, 2, 8, Float2)                     \
+    X(FLOAT3, 3, 12, Float3)                    \
+    X(FLOAT4, 4, 16, Float4)                    \
+    X(HALF2, 2, 4, Half2)                       \
+    X(HALF4, 4, 8, Half4)                       \
+    X(SNORM8X4, 4, 4, Char4Normalized)          \
+    X(UNORM8X4, 4, 4, UChar4Normalized)
+
+// Attribute semantics: X(name, shader attribute index, source components,
+// Vertex field). Indices match VertexAttribute in engine_metal_shaders.h.
+#define VERTEX_SEMANTIC_LIST(X)                 \
+    X(POSITION, 0, 3, position)                 \
+    X(TEXCOORD, 1, 2, texcoord)                 \
+    X(NORMAL, 2, 3, normal)
+
+// Layout attributes: A(semantic, format, stream, offset)
+
+// Byte-for-byte the Vertex struct: upload is a straight copy
+#define VERTEX_LAYOUT_STANDARD_ATTRIBUTES(A)    \
+    A(POSITION, FLOAT3, 0, 0)                   \
+    A(TEXCOORD, FLOAT2, 0, 12)                  \
+    A(NORMAL, FLOAT3, 0, 20)
+
+// 20 bytes: half texcoords, 8-bit normals
+#define VERTEX_LAYOUT_COMPACT_ATTRIBUTES(A)     \
+    A(POSITION, FLOAT3, 0, 0)                   \
+    A(NORMAL, SNORM8X4, 0, 12)                  \
+    A(TEXCOORD, HALF2, 0, 16)
+
+// Positions alone in stream 0 for depth-only passes, the rest in stream 1
+#define VERTEX_LAYOUT_SPLIT_ATTRIBUTES(A)       \
+    A(POSITION, FLOAT3, 0, 0)                   \
+    A(NORMAL, SNORM8X4, 1, 0)                   \
+    A(TEXCOORD, HALF2, 1, 4)
+
+// Layouts: X(name, attributes, stream 0 stride, stream 1 stride)
+#define VERTEX_LAYOUT_LIST(X)                                       \
+    X(STANDARD, VERTEX_LAYOUT_STANDARD_ATTRIBUTES, 32, 0)           \
+    X(COMPACT, VERTEX_LAYOUT_COMPACT_ATTRIBUTES, 20, 0)             \
+    X(SPLIT, VERTEX_LAYOUT_SPLIT_ATTRIBUTES, 12, 8)
+
+// ============================================================================
+// VERTEX LAYOUT DATA STRUCTURES
+// ============================================================================
+
+typedef enum {
+#define VERTEX_FORMAT_ENUM(name, components, bytes, metal) VERTEX_FORMAT_##name,
+    VERTEX_FORMAT_LIST(VERTEX_FORMAT_ENUM)
+#undef VERTEX_FORMAT_ENUM
+    VERTEX_FORMAT_COUNT
+} VertexFormat;
+
+typedef enum {
+#define VERTEX_SEMANTIC_ENUM(name, index, components, field) VERTEX_SEMANTIC_##name = index,
+    VERTEX_SEMANTIC_LIST(VERTEX_SEMANTIC_ENUM)
+#undef VERTEX_SEMANTIC_ENUM
+    VERTEX_SEMANTIC_COUNT
+} VertexSemantic;
+
+// Mesh.vertex_layout holds one of these; the zero default is STANDARD
+typedef enum {
+#define VERTEX_LAYOUT_ENUM(name, attributes, stride0, stride1) VERTEX_LAYOUT_##name,
+    VERTEX_LAYOUT_LIST(VERTEX_LAYOUT_ENUM)
+#undef VERTEX_LAYOUT_ENUM
+    VERTEX_LAYOUT_COUNT
+} VertexLayoutId;
+
+typedef struct {
+    uint8_t semantic;           // VertexSemantic
+    uint8_t format;             // VertexFormat
+    uint8_t stream;             // Vertex buffer the attribute is read from
+    uint8_t reserved;
+    uint32_t offset;            // Bytes from the start of a vertex in its stream
+} VertexAttributeDesc;
+
+// Attribute streams, formats and offsets of one GPU vertex layout
+typedef struct {
+    const char* name;
+    VertexAttributeDesc attributes[VERTEX_LAYOUT_MAX_ATTRIBUTES];
+    uint32_t attribute_count;
+    uint32_t stream_count;
+    uint32_t strides[VERTEX_LAYOUT_MAX_STREAMS];
+} VertexLayout;
+
+// ============================================================================
+// VERTEX LAYOUT FUNCTIONS
+// ============================================================================
+
+// Layout descriptor, NULL for an unknown id
+const VertexLayout* vertex_layout_get(uint32_t layout_id);
+
+// Layout declared by a mesh
+const VertexLayout* mesh_vertex_layout(const Mesh* mesh);
+
+// Components and bytes of a format (0 when unknown)
+uint32_t vertex_format_components(uint32_t format);
+uint32_t vertex_format_size(uint32_t format);
+
+// Bytes of one stream for vertex_count vertices
+size_t vertex_layout_stream_size(const VertexLayout* layout, uint32_t stream, uint32_t vertex_count);
+
+// Bytes of all streams back to back
+size_t vertex_layout_size(const VertexLayout* layout, uint32_t vertex_count);
+
+// True when the layout is exactly the Vertex struct, so mesh vertices can
+// be handed to the GPU without conversion
+int vertex_layout_matches_vertex(const VertexLayout* layout);
+
+// Check attributes fit their stream, do not overlap and are 4-byte aligned
+int vertex_layout_validate(const VertexLayout* layout);
+
+// Convert vertices into a layout with its generated packer. streams[s]
+// receives vertex_layout_stream_size(layout, s, count) bytes. Returns 1 on
+// success.
+int vertex_layout_pack(uint32_t layout_id, const Vertex* vertices, uint32_t count, void* const* streams);
+
+// Inverse of vertex_layout_pack (lossy for reduced-precision formats)
+int vertex_layout_unpack(uint32_t layout_id, const void* const* streams, uint32_t count, Vertex* vertices);
+
+// Encode/decode one attribute; missing components are written as 0
+void vertex_format_encode(uint32_t format, const float* values, uint32_t components, void* dst);
+void vertex_format_decode(uint32_t format, const void* src, float* values, uint32_t components);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print streams, strides and attributes
+void vertex_layout_print(const char* name, const VertexLayout* layout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_VERTEX_LAYOUT_H
@@ -0,0 +1,381 @@
+#include "engine_vertex_layout.h"
+#include "engine_asset_fbx.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* assets_dir = "assets";
+
+// ============================================================================
+// TEST DATA
+// ============================================================================
+
+// Deterministic vertices with unit normals and texcoords in [0, 1]
+static void make_vertices(Vertex* vertices, uint32_t count) {
+    uint32_t state = 12345;
+    for (uint32_t i = 0; i < count; i++) {
+        float r[8];
+        for (int k = 0; k < 8; k++) {
+            state = state * 1664525u + 1013904223u;
+            r[k] = (float)(state >> 8) / 16777216.0f;
+        }
+        vec3_t n = vec3(r[5] * 2.0f - 1.0f, r[6] * 2.0f - 1.0f, r[7] * 2.0f - 1.0f);
+        float length = sqrtf(n.x * n.x + n.y * n.y + n.z * n.z);
+        n = length > 1e-3f ? vec3(n.x / length, n.y / length, n.z / length) : vec3_unit_z();
+        vertices[i] = vertex_create(vec3(r[0] * 20.0f - 10.0f, r[1] * 20.0f - 10.0f, r[2] * 20.0f - 10.0f),
+                                    vec2(r[3], r[4]), n);
+    }
+}
+
+// Largest per-component differences after a round trip
+static void round_trip_error(const Vertex* a, const Vertex* b, uint32_t count, float* position, float* texcoord,
+                             float* normal) {
+    *position = *texcoord = *normal = 0.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        const float* pa = &a[i].position.x;
+        const float* pb = &b[i].position.x;
+        for (int c = 0; c < 3; c++) *position = fmaxf(*position, fabsf(pa[c] - pb[c]));
+        *texcoord = fmaxf(*texcoord, fabsf(a[i].texcoord.x - b[i].texcoord.x));
+        *texcoord = fmaxf(*texcoord, fabsf(a[i].texcoord.y - b[i].texcoord.y));
+        const float* na = &a[i].normal.x;
+        const float* nb = &b[i].normal.x;
+        for (int c = 0; c < 3; c++) *normal = fmaxf(*normal, fabsf(na[c] - nb[c]));
+    }
+}
+
+// ============================================================================
+// LAYOUT TESTS
+// ============================================================================
+
+static void test_layouts(void) {
+    printf("\n--- Layout Tests ---\n");
+
+    int all_valid = 1;
+    for (uint32_t id = 0; id < VERTEX_LAYOUT_COUNT; id++) {
+        const VertexLayout* layout = vertex_layout_get(id);
+        vertex_layout_print("Layout", layout);
+        all_valid &= layout && vertex_layout_validate(layout);
+    }
+    TEST_ASSERT(all_valid, "Every declared layout should validate");
+    TEST_ASSERT(vertex_layout_get(VERTEX_LAYOUT_COUNT) == NULL, "Unknown layout ids should return NULL");
+
+    const VertexLayout* standard = vertex_layout_get(VERTEX_LAYOUT_STANDARD);
+    TEST_ASSERT(vertex_layout_matches_vertex(standard), "The standard layout should be the Vertex struct");
+    TEST_ASSERT_EQUAL((uint32_t)sizeof(Vertex), standard->strides[0], "Standard stride should be sizeof(Vertex)");
+
+    // The offsets engine_metal_shaders.h mirrors must be the CPU struct's
+    int offsets_ok = 1;
+    for (uint32_t a = 0; a < standard->attribute_count; a++) {
+        const VertexAttributeDesc* attribute = &standard->attributes[a];
+        if (attribute->semantic == VERTEX_SEMANTIC_POSITION) offsets_ok &= attribute->offset == offsetof(Vertex, position);
+        if (attribute->semantic == VERTEX_SEMANTIC_TEXCOORD) offsets_ok &= attribute->offset == offsetof(Vertex, texcoord);
+        if (attribute->semantic == VERTEX_SEMANTIC_NORMAL) offsets_ok &= attribute->offset == offsetof(Vertex, normal);
+    }
+    TEST_ASSERT(offsets_ok && standard->attributes[1].offset == 12 && standard->attributes[2].offset == 20,
+                "Standard offsets should be 0/12/20 like Vertex");
+
+    TEST_ASSERT(!vertex_layout_matches_vertex(vertex_layout_get(VERTEX_LAYOUT_COMPACT)),
+                "The compact layout needs conversion");
+    TEST_ASSERT_EQUAL((size_t)20 * 100, vertex_layout_size(vertex_layout_get(VERTEX_LAYOUT_COMPACT), 100),
+                      "Compact vertices should take 20 bytes");
+    const VertexLayout* split = vertex_layout_get(VERTEX_LAYOUT_SPLIT);
+    TEST_ASSERT(split->stream_count == 2 && vertex_layout_stream_size(split, 0, 10) == 120 &&
+                vertex_layout_stream_size(split, 1, 10) == 80 && vertex_layout_stream_size(split, 2, 10) == 0,
+                "The split layout should have a 12-byte position stream and an 8-byte attribute stream");
+
+    Mesh mesh = mesh_create();
+    TEST_ASSERT(mesh_vertex_layout(&mesh) == standard, "Meshes should default to the standard layout");
+    mesh.vertex_layout = VERTEX_LAYOUT_COMPACT;
+    TEST_ASSERT(mesh_vertex_layout(&mesh) == vertex_layout_get(VERTEX_LAYOUT_COMPACT),
+                "Meshes should report the layout they declare");
+
+    // Hand-made layouts that must be rejected
+    VertexLayout overlap = *standard;
+    overlap.attributes[1].offset = 8;
+    TEST_ASSERT(!vertex_layout_validate(&overlap), "Overlapping attributes should be rejected");
+    VertexLayout overflow = *standard;
+    overflow.strides[0] = 28;
+    TEST_ASSERT(!vertex_layout_validate(&overflow), "Attributes past the stride should be rejected");
+    VertexLayout bad_stream = *standard;
+    bad_stream.attributes[2].stream = 1;
+    TEST_ASSERT(!vertex_layout_validate(&bad_stream), "Attributes in a missing stream should be rejected");
+    VertexLayout duplicate = *standard;
+    duplicate.attributes[2].semantic = VERTEX_SEMANTIC_POSITION;
+    TEST_ASSERT(!vertex_layout_validate(&duplicate), "Repeated semantics should be rejected");
+}
+
+// ============================================================================
+// FORMAT TESTS
+// ============================================================================
+
+static void test_formats(void) {
+    printf("\n--- Format Tests ---\n");
+
+    int sizes_ok = 1;
+    for (uint32_t f = 0; f < VERTEX_FORMAT_COUNT; f++) {
+        sizes_ok &= vertex_format_size(f) > 0 && vertex_format_size(f) % 4 == 0 && vertex_format_components(f) >= 2;
+    }
+    TEST_ASSERT(sizes_ok && vertex_format_size(VERTEX_FORMAT_COUNT) == 0, "Format sizes should be known and aligned");
+
+    // Halves: exact for small integers and powers of two, RNE otherwise
+    const float exact[6] = { 0.0f, 1.0f, -2.0f, 0.5f, 1024.0f, 65504.0f };
+    int halves_ok = 1;
+    for (int i = 0; i < 6; i += 2) {
+        uint8_t bytes[4];
+        float back[2];
+        vertex_format_encode(VERTEX_FORMAT_HALF2, exact + i, 2, bytes);
+        vertex_format_decode(VERTEX_FORMAT_HALF2, bytes, back, 2);
+        halves_ok &= back[0] == exact[i] && back[1] == exact[i + 1];
+    }
+    TEST_ASSERT(halves_ok, "Exactly representable values should survive half conversion");
+
+    float fine[2] = { 0.1f, 1.0f / 3.0f };
+    float back[2];
+    uint8_t bytes[16];
+    vertex_format_encode(VERTEX_FORMAT_HALF2, fine, 2, bytes);
+    vertex_format_decode(VERTEX_FORMAT_HALF2, bytes, back, 2);
+    TEST_ASSERT(fabsf(back[0] - fine[0]) <= 0.1f / 2048.0f && fabsf(back[1] - fine[1]) <= 0.34f / 2048.0f,
+                "Half conversion should round to within half an ulp");
+
+    float tiny[2] = { 1.0e-6f, -3.0e-5f };
+    vertex_format_encode(VERTEX_FORMAT_HALF2, tiny, 2, bytes);
+    vertex_format_decode(VERTEX_FORMAT_HALF2, bytes, back, 2);
+    TEST_ASSERT(fabsf(back[0] - tiny[0]) < 6.0e-8f && fabsf(back[1] - tiny[1]) < 6.0e-8f,
+                "Values below the normal range should become subnormal halves");
+
+    float huge[2] = { 70000.0f, -1.0e9f };
+    vertex_format_encode(VERTEX_FORMAT_HALF2, huge, 2, bytes);
+    uint16_t encoded[2];
+    memcpy(encoded, bytes, sizeof(encoded));
+    TEST_ASSERT(encoded[0] == 0x7C00 && encoded[1] == 0xFC00, "Out-of-range values should become infinities");
+
+    float normal[3] = { 1.0f, -1.0f, 0.3f };
+    float decoded[3];
+    vertex_format_encode(VERTEX_FORMAT_SNORM8X4, normal, 3, bytes);
+    vertex_format_decode(VERTEX_FORMAT_SNORM8X4, bytes, decoded, 3);
+    TEST_ASSERT(decoded[0] == 1.0f && decoded[1] == -1.0f && fabsf(decoded[2] - 0.3f) < 0.5f / 127.0f &&
+                bytes[3] == 0, "SNORM8 should hit the end points and pad missing components with 0");
+
+    float color[4] = { 0.0f, 1.0f, 2.0f, 0.5f };
+    vertex_format_encode(VERTEX_FORMAT_UNORM8X4, color, 4, bytes);
+    TEST_ASSERT(bytes[0] == 0 && bytes[1] == 255 && bytes[2] == 255 && (bytes[3] == 127 || bytes[3] == 128),
+                "UNORM8 should clamp to [0, 1]");
+
+    float wide[4];
+    vertex_format_encode(VERTEX_FORMAT_FLOAT4, normal, 3, bytes);
+    vertex_format_decode(VERTEX_FORMAT_FLOAT4, bytes, wide, 4);
+    TEST_ASSERT(wide[0] == 1.0f && wide[2] == 0.3f && wide[3] == 0.0f, "Widened floats should zero the extra component");
+}
+
+// ============================================================================
+// PACKING TESTS
+// ============================================================================
+
+static void test_packing(void) {
+    printf("\n--- Packing Tests ---\n");
+
+    const uint32_t count = 1000;
+    Vertex* source = (Vertex*)malloc(count * sizeof(Vertex));
+    Vertex* result = (Vertex*)malloc(count * sizeof(Vertex));
+    uint8_t* packed = (uint8_t*)malloc(count * sizeof(Vertex));
+    uint8_t* second = (uint8_t*)malloc(count * sizeof(Vertex));
+    make_vertices(source, count);
+
+    void* streams[VERTEX_LAYOUT_MAX_STREAMS] = { packed, NULL };
+    TEST_ASSERT(vertex_layout_pack(VERTEX_LAYOUT_STANDARD, source, count, streams), "Standard packing should succeed");
+    TEST_ASSERT(memcmp(packed, source, count * sizeof(Vertex)) == 0, "Standard packing should be a straight copy");
+    const void* const_streams[VERTEX_LAYOUT_MAX_STREAMS] = { packed, NULL };
+    vertex_layout_unpack(VERTEX_LAYOUT_STANDARD, const_streams, count, result);
+    TEST_ASSERT(memcmp(result, source, count * sizeof(Vertex)) == 0, "Standard unpacking should be lossless");
+
+    float position_error, texcoord_error, normal_error;
+    TEST_ASSERT(vertex_layout_pack(VERTEX_LAYOUT_COMPACT, source, count, streams), "Compact packing should succeed");
+    vertex_layout_unpack(VERTEX_LAYOUT_COMPACT, const_streams, count, result);
+    round_trip_error(source, result, count, &position_error, &texcoord_error, &normal_error);
+    printf("  Compact round trip: position %.2g, texcoord %.2g, normal %.2g\n", position_error, texcoord_error,
+           normal_error);
+    TEST_ASSERT(position_error == 0.0f, "Compact positions should stay exact");
+    TEST_ASSERT(texcoord_error <= 1.0f / 4096.0f, "Compact texcoords should keep half precision");
+    TEST_ASSERT(normal_error <= 0.5f / 127.0f + 1e-6f, "Compact normals should keep 8-bit precision");
+
+    // The generated packer must agree with encoding each attribute by hand
+    const VertexLayout* compact = vertex_layout_get(VERTEX_LAYOUT_COMPACT);
+    for (uint32_t i = 0; i < count; i++) {
+        for (uint32_t a = 0; a < compact->attribute_count; a++) {
+            const VertexAttributeDesc* attribute = &compact->attributes[a];
+            const float* values = attribute->semantic == VERTEX_SEMANTIC_POSITION ? &source[i].position.x :
+                                  attribute->semantic == VERTEX_SEMANTIC_TEXCOORD ? &source[i].texcoord.x :
+                                  &source[i].normal.x;
+            uint32_t components = attribute->semantic == VERTEX_SEMANTIC_TEXCOORD ? 2 : 3;
+            vertex_format_encode(attribute->format, values, components, second + i * compact->strides[0] + attribute->offset);
+        }
+    }
+    TEST_ASSERT(memcmp(packed, second, count * compact->strides[0]) == 0,
+                "Generated packers should match attribute-by-attribute encoding");
+
+    const VertexLayout* split = vertex_layout_get(VERTEX_LAYOUT_SPLIT);
+    void* split_streams[VERTEX_LAYOUT_MAX_STREAMS] = { packed, packed + vertex_layout_stream_size(split, 0, count) };
+    TEST_ASSERT(vertex_layout_pack(VERTEX_LAYOUT_SPLIT, source, count, split_streams), "Split packing should succeed");
+    int positions_ok = 1;
+    for (uint32_t i = 0; i < count; i++) {
+        positions_ok &= memcmp(packed + i * 12, &source[i].position, 12) == 0;
+    }
+    TEST_ASSERT(positions_ok, "The split position stream should hold tightly packed positions");
+    const void* const_split[VERTEX_LAYOUT_MAX_STREAMS] = { split_streams[0], split_streams[1] };
+    vertex_layout_unpack(VERTEX_LAYOUT_SPLIT, const_split, count, result);
+    round_trip_error(source, result, count, &position_error, &texcoord_error, &normal_error);
+    TEST_ASSERT(position_error == 0.0f && texcoord_error <= 1.0f / 4096.0f && normal_error <= 0.5f / 127.0f + 1e-6f,
+                "Split streams should round-trip like the compact layout");
+
+    void* missing[VERTEX_LAYOUT_MAX_STREAMS] = { packed, NULL };
+    TEST_ASSERT(!vertex_layout_pack(VERTEX_LAYOUT_SPLIT, source, count, missing), "Missing streams should be rejected");
+    TEST_ASSERT(!vertex_layout_pack(VERTEX_LAYOUT_COUNT, source, count, streams), "Unknown layouts should be rejected");
+    TEST_ASSERT(vertex_layout_pack(VERTEX_LAYOUT_COMPACT, NULL, 0, NULL), "Empty packs should succeed");
+
+    free(source);
+    free(result);
+    free(packed);
+    free(second);
+}
+
+static void test_assets(void) {
+    printf("\n--- Asset Tests ---\n");
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", assets_dir, "UnitSphere.fbx");
+    char* err = NULL;
+    Model3D* model = fbx_load_model(path, &err);
+    if (!model) {
+        printf("  UnitSphere.fbx unavailable: %s\n", err ? err : "(no error)");
+        fbx_free_error(err);
+        TEST_ASSERT(0, "Sample asset should load");
+        return;
+    }
+
+    int ok = 1;
+    for (uint32_t m = 0; m < model->mesh_count; m++) {
+        const Mesh* mesh = &model->meshes[m];
+        const VertexLayout* layout = mesh_vertex_layout(mesh);
+        uint8_t* buffer = (uint8_t*)malloc(vertex_layout_size(layout, mesh->vertex_count));
+        void* streams[VERTEX_LAYOUT_MAX_STREAMS] = { buffer, NULL };
+        ok &= buffer && vertex_layout_matches_vertex(layout) &&
+              vertex_layout_pack(mesh->vertex_layout, mesh->vertices, mesh->vertex_count, streams) &&
+              memcmp(buffer, mesh->vertices, mesh->vertex_count * sizeof(Vertex)) == 0;
+        free(buffer);
+    }
+    TEST_ASSERT(ok, "Loaded meshes should upload as a straight copy of their vertices");
+    model3d_free(model);
+    free(model);
+}
+
+// ============================================================================
+// PERFORMANCE TESTS
+// ============================================================================
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t count = 1 << 20;
+    Vertex* source = (Vertex*)malloc(count * sizeof(Vertex));
+    uint8_t* packed = (uint8_t*)malloc(count * sizeof(Vertex));
+    make_vertices(source, count);
+    memset(packed, 0, count * sizeof(Vertex));
+
+    void* streams[VERTEX_LAYOUT_MAX_STREAMS] = { packed, NULL };
+    double copy_ms = 1.0e9, pack_ms = 1.0e9, generic_ms = 1.0e9;
+    for (int r = 0; r < 3; r++) {
+        double start = now_ms();
+        vertex_layout_pack(VERTEX_LAYOUT_STANDARD, source, count, streams);
+        double t = now_ms() - start;
+        copy_ms = t < copy_ms ? t : copy_ms;
+
+        start = now_ms();
+        vertex_layout_pack(VERTEX_LAYOUT_COMPACT, source, count, streams);
+        t = now_ms() - start;
+        pack_ms = t < pack_ms ? t : pack_ms;
+
+        // Table-driven conversion, what a packer without specialisation does
+        const VertexLayout* compact = vertex_layout_get(VERTEX_LAYOUT_COMPACT);
+        start = now_ms();
+        for (uint32_t i = 0; i < count; i++) {
+            for (uint32_t a = 0; a < compact->attribute_count; a++) {
+                const VertexAttributeDesc* attribute = &compact->attributes[a];
+                const float* values = attribute->semantic == VERTEX_SEMANTIC_POSITION ? &source[i].position.x :
+                                      attribute->semantic == VERTEX_SEMANTIC_TEXCOORD ? &source[i].texcoord.x :
+                                      &source[i].normal.x;
+                uint32_t components = attribute->semantic == VERTEX_SEMANTIC_TEXCOORD ? 2 : 3;
+                vertex_format_encode(attribute->format, values, components,
+                                     packed + (size_t)i * compact->strides[0] + attribute->offset);
+            }
+        }
+        t = now_ms() - start;
+        generic_ms = t < generic_ms ? t : generic_ms;
+    }
+
+    double megabytes = count * sizeof(Vertex) / 1.0e6;
+    printf("  %u vertices: standard copy %.2f ms (%.1f GB/s), compact packer %.2f ms, table-driven %.2f ms\n", count,
+           copy_ms, megabytes / copy_ms, pack_ms, generic_ms);
+
+    TEST_ASSERT(pack_ms < generic_ms, "Generated packers should beat table-driven conversion");
+    TEST_ASSERT(copy_ms < pack_ms, "Standard upload should be cheaper than any conversion");
+
+    free(source);
+    free(packed);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting Vertex Layout Unit Tests\n");
+    printf("===================================\n");
+
+    test_layouts();
+    test_formats();
+    test_packing();
+    test_assets();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -99,6 +99,8 @@ WorldEntity* world_create_entity(World* world, const char* name) {
     entity->position = vec3_zero();
     entity->orientation = quat_identity();
     entity->metal_model = NULL;
+    entity->bounds_min = vec3(-0.5f, -0.5f, -0.5f);
+    entity->bounds_max = vec3(0.5f, 0.5f, 0.5f);
     entity->is_active = 1;
     
     // Set name
@@ -242,6 +244,37 @@ MetalModelHandle entity_get_model(const WorldEntity* entity) {
     return entity ? entity->metal_model : NULL;
 }
 
+void entity_set_bounds(WorldEntity* entity, vec3_t bounds_min, vec3_t bounds_max) {
+    if (entity) {
+        entity->bounds_min = bounds_min;
+        entity->bounds_max = bounds_max;
+    }
+}
+
+void entity_get_world_bounds(const WorldEntity* entity, vec3_t* out_min, vec3_t* out_max) {
+    if (!entity) {
+        if (out_min) *out_min = vec3_zero();
+        if (out_max) *out_max = vec3_zero();
+        return;
+    }
+
+    // Rotate the box center, and grow the extent by the absolute rotation
+    vec3_t center = vec3_scale(vec3_add(entity->bounds_min, entity->bounds_max), 0.5f);
+    vec3_t extent = vec3_scale(vec3_sub(entity->bounds_max, entity->bounds_min), 0.5f);
+    mat4_t r = quat_to_mat4(entity->orientation);
+    vec3_t world_center = vec3_add(entity->position,
+        vec3(center.x * r.x.x + center.y * r.y.x + center.z * r.z.x,
+             center.x * r.x.y + center.y * r.y.y + center.z * r.z.y,
+             center.x * r.x.z + center.y * r.y.z + center.z * r.z.z));
+    vec3_t world_extent = vec3(
+        extent.x * fabsf(r.x.x) + extent.y * fabsf(r.y.x) + extent.z * fabsf(r.z.x),
+        extent.x * fabsf(r.x.y) + extent.y * fabsf(r.y.y) + extent.z * fabsf(r.z.y),
+        extent.x * fabsf(r.x.z) + extent.y * fabsf(r.y.z) + extent.z * fabsf(r.z.z));
+
+    if (out_min) *out_min = vec3_sub(world_center, world_extent);
+    if (out_max) *out_max = vec3_add(world_center, world_extent);
+}
+
 void entity_set_name(WorldEntity* entity, const char* name) {
     if (!entity) {
         return;
@@ -317,11 +350,16 @@ mat4_t entity_get_transform_matrix(const WorldEntity* entity) {
         return mat4_identity();
     }
     
-    // Create transformation matrix: T * R (translate then rotate)
-    mat4_t translation = mat4_translation(entity->position);
-    mat4_t rotation = quat_to_mat4(entity->orientation);
+    return mat34_to_mat4(entity_get_affine_transform(entity));
+}
+
+mat34_t entity_get_affine_transform(const WorldEntity* entity) {
+    if (!entity) {
+        return mat34_identity();
+    }
     
-    return mat4_mul_mat4(rotation,translation);
+    // Rotate, then translate
+    return mat34_from_trs(entity->position, entity->orientation, vec3_one());
 }
 
 int entity_is_valid(const WorldEntity* entity) {
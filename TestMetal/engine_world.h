@@ -24,6 +24,8 @@ typedef struct {
     vec3_t position;                // World position
     quat_t orientation;             // Quaternion rotation
     MetalModelHandle metal_model;   // Metal model to render
+    vec3_t bounds_min;              // Local-space bounding box (for culling)
+    vec3_t bounds_max;
     char* name;                     // Entity name/identifier
     int is_active;                  // Active/inactive flag
 } WorldEntity;
@@ -99,6 +101,12 @@ void entity_set_model(WorldEntity* entity, MetalModelHandle model);
 // Get the Metal model for an entity
 MetalModelHandle entity_get_model(const WorldEntity* entity);
 
+// Set the entity's local-space bounding box (defaults to a unit cube)
+void entity_set_bounds(WorldEntity* entity, vec3_t bounds_min, vec3_t bounds_max);
+
+// Get the entity's world-space bounding box (encloses the rotated local box)
+void entity_get_world_bounds(const WorldEntity* entity, vec3_t* out_min, vec3_t* out_max);
+
 // Set entity name
 void entity_set_name(WorldEntity* entity, const char* name);
 
@@ -131,6 +139,9 @@ void entity_render(WorldEntity* entity, MetalEngine* metal_engine, void* engine_
 // Calculate the transformation matrix for an entity (position + orientation)
 mat4_t entity_get_transform_matrix(const WorldEntity* entity);
 
+// Same transform as a 3x4 affine matrix (for hierarchies and instance data)
+mat34_t entity_get_affine_transform(const WorldEntity* entity);
+
 // Check if an entity is valid (not NULL and has valid ID)
 int entity_is_valid(const WorldEntity* entity);
 
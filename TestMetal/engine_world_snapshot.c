@@ -0,0 +1,235 @@
+#include "engine_world_snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// ============================================================================
+// WORLD SNAPSHOT FUNCTIONS
+// ============================================================================
+
+static int compare_ids(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Returns 1 when no two records share an id
+static int snapshot_ids_unique(const WorldSnapshotEntity* records, uint32_t count) {
+    if (count < 2) return 1;
+    uint32_t* ids = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!ids) {
+        fprintf(stderr, "Error: Failed to allocate memory for world snapshot ids\n");
+        return 0;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        ids[i] = records[i].id;
+    }
+    qsort(ids, count, sizeof(uint32_t), compare_ids);
+    int unique = 1;
+    for (uint32_t i = 1; unique && i < count; i++) {
+        unique = ids[i] != ids[i - 1];
+    }
+    free(ids);
+    return unique;
+}
+
+int world_snapshot_save(const World* world, const char* path,
+                        WorldSnapshotModelToAsset model_to_asset, void* user_data) {
+    if (!world || !path) {
+        fprintf(stderr, "Error: Invalid world snapshot save parameters\n");
+        return 0;
+    }
+
+    // Records and strings are built in memory and written in three calls
+    WorldSnapshotEntity* records = (WorldSnapshotEntity*)malloc(
+        (world->entity_count ? world->entity_count : 1) * sizeof(WorldSnapshotEntity));
+    uint32_t string_capacity = 4096, string_bytes = 0;
+    char* strings = (char*)malloc(string_capacity);
+    if (!records || !strings) {
+        fprintf(stderr, "Error: Failed to allocate memory for world snapshot\n");
+        free(records);
+        free(strings);
+        return 0;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < world->max_entities && count < world->entity_count; i++) {
+        const WorldEntity* entity = &world->entities[i];
+        if (entity->id == 0) {
+            continue;
+        }
+
+        WorldSnapshotEntity* record = &records[count++];
+        record->id = entity->id;
+        record->name_offset = WORLD_SNAPSHOT_NO_NAME;
+        if (entity->name) {
+            uint32_t length = (uint32_t)strlen(entity->name) + 1;
+            if (string_bytes + length > string_capacity) {
+                while (string_bytes + length > string_capacity) string_capacity *= 2;
+                char* grown = (char*)realloc(strings, string_capacity);
+                if (!grown) {
+                    fprintf(stderr, "Error: Failed to allocate memory for world snapshot\n");
+                    free(records);
+                    free(strings);
+                    return 0;
+                }
+                strings = grown;
+            }
+            memcpy(strings + string_bytes, entity->name, length);
+            record->name_offset = string_bytes;
+            string_bytes += length;
+        }
+        record->model_asset = (entity->metal_model && model_to_asset) ?
+                              model_to_asset(user_data, entity->metal_model) : 0;
+        record->is_active = entity->is_active ? 1 : 0;
+        record->position[0] = entity->position.x;
+        record->position[1] = entity->position.y;
+        record->position[2] = entity->position.z;
+        record->orientation[0] = entity->orientation.x;
+        record->orientation[1] = entity->orientation.y;
+        record->orientation[2] = entity->orientation.z;
+        record->orientation[3] = entity->orientation.w;
+        record->bounds_min[0] = entity->bounds_min.x;
+        record->bounds_min[1] = entity->bounds_min.y;
+        record->bounds_min[2] = entity->bounds_min.z;
+        record->bounds_max[0] = entity->bounds_max.x;
+        record->bounds_max[1] = entity->bounds_max.y;
+        record->bounds_max[2] = entity->bounds_max.z;
+        record->reserved = 0;
+    }
+
+    WorldSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WORLD_SNAPSHOT_MAGIC;
+    header.version = WORLD_SNAPSHOT_VERSION;
+    header.header_size = sizeof(WorldSnapshotHeader);
+    header.entity_count = count;
+    header.max_entities = world->max_entities;
+    header.next_id = world->next_id;
+    header.string_bytes = string_bytes;
+    header.record_size = sizeof(WorldSnapshotEntity);
+    header.entities_offset = sizeof(WorldSnapshotHeader);
+    header.strings_offset = header.entities_offset + (uint64_t)count * sizeof(WorldSnapshotEntity);
+
+    FILE* file = fopen(path, "wb");
+    int ok = file != NULL;
+    if (ok) {
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(records, sizeof(WorldSnapshotEntity), count, file) == count &&
+             fwrite(strings, 1, string_bytes, file) == string_bytes;
+        ok = (fclose(file) == 0) && ok;
+    }
+    free(records);
+    free(strings);
+
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write world snapshot %s\n", path);
+        return 0;
+    }
+    fprintf(stderr, "Saved world snapshot %s: %u entities, %u string bytes\n", path, count, string_bytes);
+    return 1;
+}
+
+World* world_snapshot_load(const char* path, uint32_t min_capacity,
+                           WorldSnapshotAssetToModel asset_to_model, void* user_data) {
+    if (!path) {
+        fprintf(stderr, "Error: Invalid world snapshot load parameters\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open world snapshot %s\n", path);
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(WorldSnapshotHeader)) {
+        fprintf(stderr, "Error: World snapshot %s is too small\n", path);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    const uint8_t* mapping = (const uint8_t*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map world snapshot %s\n", path);
+        return NULL;
+    }
+    madvise((void*)mapping, size, MADV_SEQUENTIAL);
+
+    // Validate the whole layout before touching the World. Offsets are
+    // checked against the size before lengths so the sums can't wrap.
+    const WorldSnapshotHeader* header = (const WorldSnapshotHeader*)mapping;
+    int valid = header->magic == WORLD_SNAPSHOT_MAGIC && header->version == WORLD_SNAPSHOT_VERSION &&
+                header->header_size == sizeof(WorldSnapshotHeader) &&
+                header->record_size == sizeof(WorldSnapshotEntity) &&
+                header->entities_offset >= sizeof(WorldSnapshotHeader) &&
+                header->entities_offset % sizeof(uint32_t) == 0 &&
+                header->entities_offset <= size &&
+                (uint64_t)header->entity_count * sizeof(WorldSnapshotEntity) <= size - header->entities_offset &&
+                header->strings_offset <= size &&
+                header->string_bytes <= size - header->strings_offset &&
+                (header->string_bytes == 0 || mapping[header->strings_offset + header->string_bytes - 1] == '\0');
+    const WorldSnapshotEntity* records = (const WorldSnapshotEntity*)(mapping + header->entities_offset);
+    const char* strings = (const char*)(mapping + header->strings_offset);
+    for (uint32_t i = 0; valid && i < header->entity_count; i++) {
+        const WorldSnapshotEntity* record = &records[i];
+        if (record->id == 0 || record->id >= header->next_id ||
+            (record->name_offset != WORLD_SNAPSHOT_NO_NAME && record->name_offset >= header->string_bytes)) {
+            valid = 0;
+        }
+    }
+    valid = valid && snapshot_ids_unique(records, header->entity_count);
+    if (!valid) {
+        fprintf(stderr, "Error: %s is not a valid world snapshot\n", path);
+        munmap((void*)mapping, size);
+        return NULL;
+    }
+
+    // The saved capacity is only a hint; don't let a header reserve gigabytes
+    uint32_t capacity = header->max_entities;
+    if (capacity > WORLD_SNAPSHOT_MAX_CAPACITY) capacity = WORLD_SNAPSHOT_MAX_CAPACITY;
+    if (capacity < header->entity_count) capacity = header->entity_count;
+    if (capacity < min_capacity) capacity = min_capacity;
+    if (capacity == 0) capacity = 1;
+    World* world = world_create(capacity);
+    if (!world) {
+        munmap((void*)mapping, size);
+        return NULL;
+    }
+
+    // Bulk insert: records fill slots [0, entity_count) directly
+    for (uint32_t i = 0; i < header->entity_count; i++) {
+        const WorldSnapshotEntity* record = &records[i];
+        WorldEntity* entity = &world->entities[i];
+        entity->id = record->id;
+        entity->position = vec3(record->position[0], record->position[1], record->position[2]);
+        entity->orientation = quat(record->orientation[0], record->orientation[1],
+                                   record->orientation[2], record->orientation[3]);
+        entity->bounds_min = vec3(record->bounds_min[0], record->bounds_min[1], record->bounds_min[2]);
+        entity->bounds_max = vec3(record->bounds_max[0], record->bounds_max[1], record->bounds_max[2]);
+        entity->metal_model = (record->model_asset && asset_to_model) ?
+                              asset_to_model(user_data, record->model_asset) : NULL;
+        entity->is_active = record->is_active ? 1 : 0;
+        entity->name = NULL;
+        if (record->name_offset != WORLD_SNAPSHOT_NO_NAME) {
+            const char* name = strings + record->name_offset;
+            size_t length = strlen(name) + 1;
+            entity->name = (char*)malloc(length);
+            if (entity->name) {
+                memcpy(entity->name, name, length);
+            } else {
+                fprintf(stderr, "Warning: Failed to allocate memory for entity name\n");
+            }
+        }
+    }
+    world->entity_count = header->entity_count;
+    world->next_id = header->next_id;
+
+    fprintf(stderr, "Loaded world snapshot %s: %u entities\n", path, header->entity_count);
+    munmap((void*)mapping, size);
+    return world;
+}
@@ -0,0 +1,77 @@
+#ifndef ENGINE_WORLD_SNAPSHOT_H
+#define ENGINE_WORLD_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_world.h"
+#include <stdint.h>
+
+// ============================================================================
+// WORLD SNAPSHOT CONFIGURATION
+// ============================================================================
+
+#define WORLD_SNAPSHOT_MAGIC 0x504E5357u        // "WSNP"
+#define WORLD_SNAPSHOT_VERSION 1
+#define WORLD_SNAPSHOT_NO_NAME 0xFFFFFFFFu
+#define WORLD_SNAPSHOT_MAX_CAPACITY (1u << 20)  // Largest saved capacity honoured on load
+
+// ============================================================================
+// WORLD SNAPSHOT FILE FORMAT
+// ============================================================================
+
+// A snapshot is this header, entity_count WorldSnapshotEntity records in
+// slot order and a string table of NUL-terminated names. Offsets are from
+// the start of the file; all fields are little-endian.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;       // sizeof(WorldSnapshotHeader) of the writer
+    uint32_t entity_count;
+    uint32_t max_entities;      // Capacity of the saved World
+    uint32_t next_id;
+    uint32_t string_bytes;
+    uint32_t record_size;       // sizeof(WorldSnapshotEntity) of the writer
+    uint64_t entities_offset;
+    uint64_t strings_offset;
+} WorldSnapshotHeader;
+
+typedef struct {
+    uint32_t id;
+    uint32_t name_offset;       // WORLD_SNAPSHOT_NO_NAME for unnamed entities
+    uint32_t model_asset;       // 0 for no model
+    uint32_t is_active;
+    float position[3];
+    float orientation[4];       // Quaternion (x, y, z, w)
+    float bounds_min[3];
+    float bounds_max[3];
+    uint32_t reserved;          // Pads the record to 72 bytes
+} WorldSnapshotEntity;
+
+// Model references are stored as asset ids: the writer maps each model to
+// an id (0 = none) and the loader maps ids back to models
+typedef uint32_t (*WorldSnapshotModelToAsset)(void* user_data, MetalModelHandle model);
+typedef MetalModelHandle (*WorldSnapshotAssetToModel)(void* user_data, uint32_t asset_id);
+
+// ============================================================================
+// WORLD SNAPSHOT FUNCTIONS
+// ============================================================================
+
+// Write every entity of a World. model_to_asset may be NULL (no models).
+// Returns 1 on success.
+int world_snapshot_save(const World* world, const char* path,
+                        WorldSnapshotModelToAsset model_to_asset, void* user_data);
+
+// Map a snapshot and bulk-load it into a new World with at least
+// min_capacity slots. Entity ids, names, transforms and active flags are
+// restored; the next created entity continues after the saved ids.
+// asset_to_model may be NULL (models stay unset).
+World* world_snapshot_load(const char* path, uint32_t min_capacity,
+                           WorldSnapshotAssetToModel asset_to_model, void* user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_WORLD_SNAPSHOT_H
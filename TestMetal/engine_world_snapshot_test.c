@@ -0,0 +1,291 @@
+#include "engine_world_snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* SNAPSHOT_PATH = "/tmp/engine_world_snapshot_test.wsnp";
+static const char* CORRUPT_PATH = "/tmp/engine_world_snapshot_corrupt.wsnp";
+
+// Fake model table: models are addresses inside this array, assets are
+// their index + 1
+static char model_table[8];
+
+static uint32_t model_to_asset(void* user_data, MetalModelHandle model) {
+    (void)user_data;
+    return (uint32_t)((char*)model - model_table) + 1;
+}
+
+static MetalModelHandle asset_to_model(void* user_data, uint32_t asset_id) {
+    (void)user_data;
+    return asset_id <= sizeof(model_table) ? (MetalModelHandle)&model_table[asset_id - 1] : NULL;
+}
+
+static int write_bytes(const char* path, const void* data, size_t size) {
+    FILE* file = fopen(path, "wb");
+    if (!file) return 0;
+    int ok = fwrite(data, 1, size, file) == size;
+    fclose(file);
+    return ok;
+}
+
+static uint8_t* read_bytes(const char* path, size_t* out_size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return NULL;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t* data = (uint8_t*)malloc((size_t)size);
+    if (data && fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *out_size = (size_t)size;
+    return data;
+}
+
+// ============================================================================
+// WORLD SNAPSHOT TESTS
+// ============================================================================
+
+static void test_round_trip(void) {
+    printf("\n--- Round Trip Tests ---\n");
+
+    World* world = world_create(16);
+    WorldEntity* ship = world_create_entity(world, "ship");
+    WorldEntity* doomed = world_create_entity(world, "doomed");
+    WorldEntity* unnamed = world_create_entity(world, NULL);
+    WorldEntity* crate = world_create_entity(world, "crate");
+    entity_set_position(ship, vec3(1.0f, 2.0f, 3.0f));
+    entity_set_orientation_axis_angle(ship, vec3(0.0f, 1.0f, 0.0f), 0.7f);
+    entity_set_model(ship, (MetalModelHandle)&model_table[2]);
+    entity_set_bounds(ship, vec3(-2.0f, -1.0f, -3.0f), vec3(2.0f, 1.0f, 3.0f));
+    entity_set_position(unnamed, vec3(-5.0f, 0.0f, 9.0f));
+    entity_set_active(crate, 0);
+    uint32_t ship_id = ship->id, unnamed_id = unnamed->id, crate_id = crate->id;
+    world_destroy_entity(world, doomed->id);
+
+    TEST_ASSERT(world_snapshot_save(world, SNAPSHOT_PATH, model_to_asset, NULL), "World snapshot should save");
+
+    World* loaded = world_snapshot_load(SNAPSHOT_PATH, 0, asset_to_model, NULL);
+    TEST_ASSERT_NOT_NULL(loaded, "World snapshot should load");
+    if (!loaded) {
+        world_destroy(world);
+        return;
+    }
+
+    TEST_ASSERT_EQUAL(3u, world_get_entity_count(loaded), "Loaded world should hold the live entities");
+    TEST_ASSERT_EQUAL(16u, world_get_max_entities(loaded), "Loaded world should keep the saved capacity");
+
+    WorldEntity* a = world_get_entity(loaded, ship_id);
+    TEST_ASSERT(a && a->name && strcmp(a->name, "ship") == 0, "Entity ids and names should round trip");
+    TEST_ASSERT(a && vec3_distance(a->position, ship->position) == 0.0f &&
+                a->orientation.y == ship->orientation.y && a->orientation.w == ship->orientation.w,
+                "Transforms should round trip exactly");
+    TEST_ASSERT(a && a->bounds_min.z == -3.0f && a->bounds_max.x == 2.0f, "Bounds should round trip");
+    TEST_ASSERT(a && a->metal_model == (MetalModelHandle)&model_table[2], "Models should resolve through asset ids");
+
+    WorldEntity* b = world_get_entity(loaded, unnamed_id);
+    TEST_ASSERT(b && b->name == NULL && b->metal_model == NULL && b->position.z == 9.0f,
+                "Unnamed entities without models should round trip");
+    WorldEntity* c = world_get_entity(loaded, crate_id);
+    TEST_ASSERT(c && !entity_is_active(c), "Inactive flags should round trip");
+    TEST_ASSERT(world_get_entity_by_name(loaded, "doomed") == NULL, "Destroyed entities should not be saved");
+
+    WorldEntity* fresh = world_create_entity(loaded, "fresh");
+    TEST_ASSERT(fresh && fresh->id == world->next_id, "New entities should continue after the saved ids");
+
+    world_destroy(loaded);
+    loaded = world_snapshot_load(SNAPSHOT_PATH, 1000, NULL, NULL);
+    TEST_ASSERT(loaded && world_get_max_entities(loaded) == 1000 && world_get_entity(loaded, ship_id)->metal_model == NULL,
+                "Loading should honour a larger capacity and work without a model resolver");
+    world_destroy(loaded);
+
+    World* empty = world_create(4);
+    TEST_ASSERT(world_snapshot_save(empty, SNAPSHOT_PATH, NULL, NULL), "Empty worlds should save");
+    loaded = world_snapshot_load(SNAPSHOT_PATH, 0, NULL, NULL);
+    TEST_ASSERT(loaded && world_get_entity_count(loaded) == 0, "Empty worlds should load");
+    world_destroy(loaded);
+    world_destroy(empty);
+    world_destroy(world);
+}
+
+static void test_validation(void) {
+    printf("\n--- Validation Tests ---\n");
+
+    World* world = world_create(8);
+    world_create_entity(world, "a");
+    world_create_entity(world, "b");
+    world_snapshot_save(world, SNAPSHOT_PATH, NULL, NULL);
+    world_destroy(world);
+
+    size_t size = 0;
+    uint8_t* data = read_bytes(SNAPSHOT_PATH, &size);
+    if (!data) return;
+    WorldSnapshotHeader* header = (WorldSnapshotHeader*)data;
+
+    TEST_ASSERT(world_snapshot_load("/tmp/engine_world_snapshot_missing.wsnp", 0, NULL, NULL) == NULL,
+                "Missing snapshots should fail to load");
+
+    header->magic ^= 1;
+    write_bytes(CORRUPT_PATH, data, size);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Bad magic should be rejected");
+    header->magic ^= 1;
+
+    header->version = WORLD_SNAPSHOT_VERSION + 1;
+    write_bytes(CORRUPT_PATH, data, size);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Unknown versions should be rejected");
+    header->version = WORLD_SNAPSHOT_VERSION;
+
+    write_bytes(CORRUPT_PATH, data, size - 3);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Truncated snapshots should be rejected");
+
+    // Offsets chosen so offset + length wraps back inside the file
+    uint64_t strings_offset = header->strings_offset;
+    header->strings_offset = UINT64_MAX - 1;
+    write_bytes(CORRUPT_PATH, data, size);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Wrapping string offsets should be rejected");
+    header->strings_offset = strings_offset;
+
+    uint64_t entities_offset = header->entities_offset;
+    header->entities_offset = UINT64_MAX - 3;
+    write_bytes(CORRUPT_PATH, data, size);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Wrapping entity offsets should be rejected");
+    header->entities_offset = entities_offset;
+
+    WorldSnapshotEntity* records = (WorldSnapshotEntity*)(data + header->entities_offset);
+    uint32_t second_id = records[1].id;
+    records[1].id = records[0].id;
+    write_bytes(CORRUPT_PATH, data, size);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Duplicate ids should be rejected");
+    records[1].id = second_id;
+
+    header->max_entities = UINT32_MAX;
+    write_bytes(CORRUPT_PATH, data, size);
+    World* capped = world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL);
+    TEST_ASSERT(capped && world_get_max_entities(capped) == WORLD_SNAPSHOT_MAX_CAPACITY,
+                "Saved capacities should be capped");
+    world_destroy(capped);
+    header->max_entities = 8;
+
+    records[1].name_offset = 1000;
+    write_bytes(CORRUPT_PATH, data, size);
+    TEST_ASSERT(world_snapshot_load(CORRUPT_PATH, 0, NULL, NULL) == NULL, "Out of range names should be rejected");
+
+    free(data);
+    unlink(CORRUPT_PATH);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    const uint32_t count = 100000;
+    World* world = world_create(count);
+    char name[32];
+    for (uint32_t i = 0; i < count; i++) {
+        snprintf(name, sizeof(name), "entity_%u", i);
+        WorldEntity* entity = &world->entities[i];
+        entity->id = world->next_id++;
+        entity->name = strdup(name);
+        entity->position = vec3((float)(i % 317), (float)(i % 13), (float)(i / 317));
+        entity->orientation = quat_identity();
+        entity->bounds_min = vec3(-0.5f, -0.5f, -0.5f);
+        entity->bounds_max = vec3(0.5f, 0.5f, 0.5f);
+        entity->metal_model = (MetalModelHandle)&model_table[i % 8];
+        entity->is_active = 1;
+    }
+    world->entity_count = count;
+
+    double start = now_ms();
+    int saved = world_snapshot_save(world, SNAPSHOT_PATH, model_to_asset, NULL);
+    double save_ms = now_ms() - start;
+
+    // Warm and cold-ish loads: the first read may fault the file in
+    const int runs = 5;
+    double best_ms = 1.0e9, total_ms = 0.0;
+    World* loaded = NULL;
+    for (int run = 0; run < runs; run++) {
+        if (loaded) world_destroy(loaded);
+        start = now_ms();
+        loaded = world_snapshot_load(SNAPSHOT_PATH, 0, asset_to_model, NULL);
+        double elapsed = now_ms() - start;
+        total_ms += elapsed;
+        if (elapsed < best_ms) best_ms = elapsed;
+    }
+
+    size_t size = 0;
+    uint8_t* data = read_bytes(SNAPSHOT_PATH, &size);
+    free(data);
+    printf("  100k entities: %.2f MB snapshot, save %.2f ms, load %.2f ms best / %.2f ms average\n",
+           (double)size / (1024.0 * 1024.0), save_ms, best_ms, total_ms / runs);
+
+    TEST_ASSERT(saved && loaded, "100k-entity snapshot should round trip");
+    int identical = loaded && loaded->entity_count == count;
+    for (uint32_t i = 0; identical && i < count; i += 997) {
+        const WorldEntity* a = &world->entities[i];
+        const WorldEntity* b = &loaded->entities[i];
+        identical = a->id == b->id && strcmp(a->name, b->name) == 0 && a->metal_model == b->metal_model &&
+                    a->position.x == b->position.x && a->position.z == b->position.z;
+    }
+    TEST_ASSERT(identical, "100k-entity snapshot should load identically");
+    TEST_ASSERT(best_ms < 50.0, "100k entities should load in milliseconds");
+
+    world_destroy(loaded);
+    world_destroy(world);
+    unlink(SNAPSHOT_PATH);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting World Snapshot Unit Tests\n");
+    printf("===================================\n");
+
+    test_round_trip();
+    test_validation();
+    test_performance();
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,851 @@
+#include "engine_world_stream.h"
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+// ============================================================================
+// WORLD STREAMER STATE
+// ============================================================================
+
+#define NO_CELL 0xFFFFFFFFu
+
+// A cell blob read by the loader thread
+typedef struct WorldCellLoad {
+    uint32_t cell;
+    int failed;
+    uint8_t* blob;                      // Freed once the cell is integrated
+    const WorldPackEntity* entities;
+    const char* strings;
+    void** resources;                   // Kept until the cell unloads
+    uint32_t resource_count;
+    struct WorldCellLoad* next;
+} WorldCellLoad;
+
+typedef struct {
+    WorldCellState state;
+    float distance;                     // XZ distance to the camera at the last update
+    uint64_t bytes;                     // Blob + resource bytes
+    uint32_t* entity_ids;               // World entities added so far
+    uint32_t entity_count;
+    WorldCellLoad* load;                // Integrating or resident data
+    uint32_t active_index;              // Slot in the active list, NO_CELL if inactive
+    int cancelled;                      // Left range while the loader held it
+} StreamCell;
+
+typedef struct {
+    float distance;
+    uint32_t cell;
+} StreamCandidate;
+
+struct WorldStreamer {
+    World* world;
+    WorldStreamDesc desc;
+    int fd;
+    WorldPackHeader header;
+    WorldPackCell* table;
+    StreamCell* cells;
+    uint32_t cell_count;
+
+    // Main thread bookkeeping
+    uint32_t* active;                   // Cells that are not UNLOADED or FAILED
+    uint32_t active_count;
+    uint32_t* integrating;              // FIFO of INTEGRATING cells
+    uint32_t integrating_count;
+    StreamCandidate* candidates;
+    uint32_t queued_count;              // QUEUED cells, including the one being read
+    uint64_t bytes_unloading;
+    WorldStreamStats stats;
+
+    // Shared with the loader thread (guarded by mutex)
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t work_cond;           // Signalled when cells are queued
+    pthread_cond_t idle_cond;           // Signalled when the queue drains
+    uint32_t* queue;
+    uint32_t queue_count;
+    uint32_t loading;                   // Cell being read, NO_CELL if none
+    WorldCellLoad* completed_head;
+    WorldCellLoad* completed_tail;
+    int shutdown;
+};
+
+// ============================================================================
+// WORLD PACK FUNCTIONS
+// ============================================================================
+
+int world_pack_write(const char* path, float origin_x, float origin_z, float cell_size,
+                     uint32_t cells_x, uint32_t cells_z, const WorldCellDesc* cells) {
+    if (!path || !cells || cells_x == 0 || cells_z == 0 || cell_size <= 0.0f) {
+        fprintf(stderr, "Error: Invalid world pack parameters\n");
+        return 0;
+    }
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot create world pack %s\n", path);
+        return 0;
+    }
+
+    uint32_t cell_count = cells_x * cells_z;
+    WorldPackCell* table = (WorldPackCell*)calloc(cell_count, sizeof(WorldPackCell));
+    if (!table) {
+        fprintf(stderr, "Error: Failed to allocate memory for world pack table\n");
+        fclose(file);
+        return 0;
+    }
+
+    WorldPackHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = WORLD_PACK_MAGIC;
+    header.version = WORLD_PACK_VERSION;
+    header.origin_x = origin_x;
+    header.origin_z = origin_z;
+    header.cell_size = cell_size;
+    header.cells_x = cells_x;
+    header.cells_z = cells_z;
+
+    // Blobs follow the table; the table is rewritten once offsets are known
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(table, sizeof(WorldPackCell), cell_count, file) == cell_count;
+    uint64_t offset = sizeof(header) + (uint64_t)cell_count * sizeof(WorldPackCell);
+
+    for (uint32_t c = 0; ok && c < cell_count; c++) {
+        const WorldCellDesc* cell = &cells[c];
+        if (cell->entity_count == 0 && cell->resource_count == 0) {
+            continue;
+        }
+
+        uint32_t string_bytes = 0;
+        for (uint32_t i = 0; i < cell->entity_count; i++) {
+            const char* name = cell->entities[i].name ? cell->entities[i].name : "";
+            string_bytes += (uint32_t)strlen(name) + 1;
+        }
+        for (uint32_t i = 0; i < cell->resource_count; i++) {
+            const char* name = cell->resources[i].name ? cell->resources[i].name : "";
+            string_bytes += (uint32_t)strlen(name) + 1;
+        }
+
+        WorldPackCellHeader cell_header;
+        memset(&cell_header, 0, sizeof(cell_header));
+        cell_header.entity_count = cell->entity_count;
+        cell_header.resource_count = cell->resource_count;
+        cell_header.string_bytes = string_bytes;
+        ok = fwrite(&cell_header, sizeof(cell_header), 1, file) == 1;
+
+        uint32_t string_offset = 0;
+        for (uint32_t i = 0; ok && i < cell->entity_count; i++) {
+            const WorldCellEntityDesc* src = &cell->entities[i];
+            if (src->resource >= (int32_t)cell->resource_count) {
+                fprintf(stderr, "Error: Entity %u of cell %u uses missing resource %d\n", i, c, src->resource);
+                ok = 0;
+                break;
+            }
+            WorldPackEntity record;
+            record.position[0] = src->position.x;
+            record.position[1] = src->position.y;
+            record.position[2] = src->position.z;
+            record.orientation[0] = src->orientation.x;
+            record.orientation[1] = src->orientation.y;
+            record.orientation[2] = src->orientation.z;
+            record.orientation[3] = src->orientation.w;
+            record.bounds_min[0] = src->bounds_min.x;
+            record.bounds_min[1] = src->bounds_min.y;
+            record.bounds_min[2] = src->bounds_min.z;
+            record.bounds_max[0] = src->bounds_max.x;
+            record.bounds_max[1] = src->bounds_max.y;
+            record.bounds_max[2] = src->bounds_max.z;
+            record.name_offset = string_offset;
+            record.resource = src->resource < 0 ? -1 : src->resource;
+            record.reserved = 0;
+            string_offset += (uint32_t)strlen(src->name ? src->name : "") + 1;
+            ok = fwrite(&record, sizeof(record), 1, file) == 1;
+        }
+
+        uint64_t resource_bytes = 0;
+        for (uint32_t i = 0; ok && i < cell->resource_count; i++) {
+            WorldPackResource record;
+            memset(&record, 0, sizeof(record));
+            record.name_offset = string_offset;
+            record.bytes = cell->resources[i].bytes;
+            resource_bytes += record.bytes;
+            string_offset += (uint32_t)strlen(cell->resources[i].name ? cell->resources[i].name : "") + 1;
+            ok = fwrite(&record, sizeof(record), 1, file) == 1;
+        }
+
+        for (uint32_t i = 0; ok && i < cell->entity_count; i++) {
+            const char* name = cell->entities[i].name ? cell->entities[i].name : "";
+            ok = fwrite(name, strlen(name) + 1, 1, file) == 1;
+        }
+        for (uint32_t i = 0; ok && i < cell->resource_count; i++) {
+            const char* name = cell->resources[i].name ? cell->resources[i].name : "";
+            ok = fwrite(name, strlen(name) + 1, 1, file) == 1;
+        }
+
+        uint32_t size = (uint32_t)(sizeof(WorldPackCellHeader) + cell->entity_count * sizeof(WorldPackEntity) +
+                                   cell->resource_count * sizeof(WorldPackResource) + string_bytes);
+        table[c].offset = offset;
+        table[c].size = size;
+        table[c].entity_count = cell->entity_count;
+        table[c].resource_bytes = resource_bytes;
+        offset += size;
+    }
+
+    if (ok) {
+        ok = fseek(file, (long)sizeof(header), SEEK_SET) == 0 &&
+             fwrite(table, sizeof(WorldPackCell), cell_count, file) == cell_count;
+    }
+    ok = (fclose(file) == 0) && ok;
+    free(table);
+
+    if (!ok) {
+        fprintf(stderr, "Error: Failed to write world pack %s\n", path);
+    }
+    return ok;
+}
+
+// ============================================================================
+// INTERNAL HELPERS
+// ============================================================================
+
+static void free_cell_load(WorldStreamerHandle streamer, WorldCellLoad* load) {
+    if (!load) {
+        return;
+    }
+    if (streamer->desc.release_resource) {
+        for (uint32_t i = 0; i < load->resource_count; i++) {
+            if (load->resources[i]) {
+                streamer->desc.release_resource(streamer->desc.user_data, load->resources[i]);
+            }
+        }
+    }
+    free(load->resources);
+    free(load->blob);
+    free(load);
+}
+
+// Read and validate one cell blob, then load its resources (loader thread)
+static WorldCellLoad* read_cell(WorldStreamerHandle streamer, uint32_t cell) {
+    const WorldPackCell* entry = &streamer->table[cell];
+    WorldCellLoad* load = (WorldCellLoad*)calloc(1, sizeof(WorldCellLoad));
+    if (!load) {
+        return NULL;
+    }
+    load->cell = cell;
+    load->failed = 1;
+
+    load->blob = (uint8_t*)malloc(entry->size);
+    if (!load->blob) {
+        return load;
+    }
+    size_t done = 0;
+    while (done < entry->size) {
+        ssize_t n = pread(streamer->fd, load->blob + done, entry->size - done, (off_t)(entry->offset + done));
+        if (n <= 0) {
+            return load;
+        }
+        done += (size_t)n;
+    }
+
+    if (entry->size < sizeof(WorldPackCellHeader)) {
+        return load;
+    }
+    const WorldPackCellHeader* header = (const WorldPackCellHeader*)load->blob;
+    uint64_t expected = sizeof(WorldPackCellHeader) + (uint64_t)header->entity_count * sizeof(WorldPackEntity) +
+                        (uint64_t)header->resource_count * sizeof(WorldPackResource) + header->string_bytes;
+    if (expected != entry->size || header->entity_count != entry->entity_count ||
+        (header->string_bytes > 0 && load->blob[entry->size - 1] != '\0')) {
+        return load;
+    }
+
+    load->entities = (const WorldPackEntity*)(load->blob + sizeof(WorldPackCellHeader));
+    const WorldPackResource* resources = (const WorldPackResource*)(load->entities + header->entity_count);
+    load->strings = (const char*)(resources + header->resource_count);
+    for (uint32_t i = 0; i < header->entity_count; i++) {
+        if (load->entities[i].name_offset >= header->string_bytes ||
+            load->entities[i].resource >= (int32_t)header->resource_count) {
+            return load;
+        }
+    }
+    for (uint32_t i = 0; i < header->resource_count; i++) {
+        if (resources[i].name_offset >= header->string_bytes) {
+            return load;
+        }
+    }
+
+    if (header->resource_count > 0) {
+        load->resources = (void**)calloc(header->resource_count, sizeof(void*));
+        if (!load->resources) {
+            return load;
+        }
+        load->resource_count = header->resource_count;
+        if (streamer->desc.load_resource) {
+            for (uint32_t i = 0; i < header->resource_count; i++) {
+                load->resources[i] = streamer->desc.load_resource(streamer->desc.user_data,
+                                                                  load->strings + resources[i].name_offset,
+                                                                  resources[i].bytes);
+            }
+        }
+    }
+    load->failed = 0;
+    return load;
+}
+
+static void* loader_main(void* arg) {
+    WorldStreamerHandle streamer = (WorldStreamerHandle)arg;
+
+    pthread_mutex_lock(&streamer->mutex);
+    for (;;) {
+        while (!streamer->shutdown && streamer->queue_count == 0) {
+            pthread_cond_wait(&streamer->work_cond, &streamer->mutex);
+        }
+        if (streamer->shutdown) {
+            break;
+        }
+
+        // Nearest queued cell first; distances are refreshed every update
+        uint32_t best = 0;
+        for (uint32_t i = 1; i < streamer->queue_count; i++) {
+            if (streamer->cells[streamer->queue[i]].distance < streamer->cells[streamer->queue[best]].distance) {
+                best = i;
+            }
+        }
+        uint32_t cell = streamer->queue[best];
+        streamer->queue[best] = streamer->queue[--streamer->queue_count];
+        streamer->loading = cell;
+        pthread_mutex_unlock(&streamer->mutex);
+
+        WorldCellLoad* load = read_cell(streamer, cell);
+
+        pthread_mutex_lock(&streamer->mutex);
+        if (!load) {
+            // Out of memory: requeue and let the next update retry
+            streamer->queue[streamer->queue_count++] = cell;
+        } else {
+            if (streamer->completed_tail) {
+                streamer->completed_tail->next = load;
+            } else {
+                streamer->completed_head = load;
+            }
+            streamer->completed_tail = load;
+        }
+        streamer->loading = NO_CELL;
+        if (streamer->queue_count == 0 || !load) {
+            pthread_cond_broadcast(&streamer->idle_cond);
+        }
+    }
+    pthread_mutex_unlock(&streamer->mutex);
+    return NULL;
+}
+
+static void add_active(WorldStreamerHandle streamer, uint32_t cell) {
+    streamer->cells[cell].active_index = streamer->active_count;
+    streamer->active[streamer->active_count++] = cell;
+}
+
+static void remove_active(WorldStreamerHandle streamer, uint32_t cell) {
+    uint32_t index = streamer->cells[cell].active_index;
+    uint32_t last = streamer->active[--streamer->active_count];
+    streamer->active[index] = last;
+    streamer->cells[last].active_index = index;
+    streamer->cells[cell].active_index = NO_CELL;
+}
+
+static float cell_distance(const WorldStreamerHandle streamer, uint32_t cell, vec3_t camera) {
+    const WorldPackHeader* header = &streamer->header;
+    float min_x = header->origin_x + (float)(cell % header->cells_x) * header->cell_size;
+    float min_z = header->origin_z + (float)(cell / header->cells_x) * header->cell_size;
+    float dx = fmaxf(fmaxf(min_x - camera.x, camera.x - min_x - header->cell_size), 0.0f);
+    float dz = fmaxf(fmaxf(min_z - camera.z, camera.z - min_z - header->cell_size), 0.0f);
+    return sqrtf(dx * dx + dz * dz);
+}
+
+static void remove_integrating(WorldStreamerHandle streamer, uint32_t cell) {
+    for (uint32_t i = 0; i < streamer->integrating_count; i++) {
+        if (streamer->integrating[i] == cell) {
+            memmove(&streamer->integrating[i], &streamer->integrating[i + 1],
+                    (streamer->integrating_count - i - 1) * sizeof(uint32_t));
+            streamer->integrating_count--;
+            return;
+        }
+    }
+}
+
+// Drop a cell's bookkeeping once its entities are gone
+static void finish_unload(WorldStreamerHandle streamer, uint32_t cell) {
+    StreamCell* c = &streamer->cells[cell];
+    free_cell_load(streamer, c->load);
+    c->load = NULL;
+    free(c->entity_ids);
+    c->entity_ids = NULL;
+    c->entity_count = 0;
+    streamer->stats.bytes_committed -= c->bytes;
+    c->state = WORLD_CELL_UNLOADED;
+    remove_active(streamer, cell);
+}
+
+static int compare_candidates(const void* a, const void* b) {
+    float da = ((const StreamCandidate*)a)->distance;
+    float db = ((const StreamCandidate*)b)->distance;
+    return (da > db) - (da < db);
+}
+
+// ============================================================================
+// WORLD STREAMING FUNCTIONS
+// ============================================================================
+
+WorldStreamDesc world_stream_desc_default(float cell_size) {
+    WorldStreamDesc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.load_radius = cell_size * 2.0f;
+    desc.unload_radius = cell_size * 2.5f;
+    desc.byte_budget = 256ull * 1024 * 1024;
+    desc.max_entity_ops = 256;
+    desc.max_pending_loads = 8;
+    return desc;
+}
+
+WorldStreamerHandle world_stream_create(const char* path, World* world, const WorldStreamDesc* desc) {
+    if (!path || !world || !desc || desc->max_entity_ops == 0 || desc->max_pending_loads == 0) {
+        fprintf(stderr, "Error: Invalid world streamer parameters\n");
+        return NULL;
+    }
+    if (desc->unload_radius <= desc->load_radius) {
+        fprintf(stderr, "Error: World stream unload radius must exceed the load radius\n");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open world pack %s\n", path);
+        return NULL;
+    }
+    WorldPackHeader header;
+    if (pread(fd, &header, sizeof(header), 0) != (ssize_t)sizeof(header) ||
+        header.magic != WORLD_PACK_MAGIC || header.version != WORLD_PACK_VERSION ||
+        header.cells_x == 0 || header.cells_z == 0 || header.cell_size <= 0.0f) {
+        fprintf(stderr, "Error: %s is not a valid world pack\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    WorldStreamerHandle streamer = (WorldStreamerHandle)calloc(1, sizeof(struct WorldStreamer));
+    if (!streamer) {
+        fprintf(stderr, "Error: Failed to allocate memory for world streamer\n");
+        close(fd);
+        return NULL;
+    }
+    streamer->world = world;
+    streamer->desc = *desc;
+    streamer->fd = fd;
+    streamer->header = header;
+    streamer->cell_count = header.cells_x * header.cells_z;
+    streamer->loading = NO_CELL;
+
+    uint32_t count = streamer->cell_count;
+    streamer->table = (WorldPackCell*)malloc(count * sizeof(WorldPackCell));
+    streamer->cells = (StreamCell*)calloc(count, sizeof(StreamCell));
+    streamer->active = (uint32_t*)malloc(count * sizeof(uint32_t));
+    streamer->integrating = (uint32_t*)malloc(count * sizeof(uint32_t));
+    streamer->candidates = (StreamCandidate*)malloc(count * sizeof(StreamCandidate));
+    streamer->queue = (uint32_t*)malloc(count * sizeof(uint32_t));
+    if (!streamer->table || !streamer->cells || !streamer->active || !streamer->integrating ||
+        !streamer->candidates || !streamer->queue) {
+        fprintf(stderr, "Error: Failed to allocate memory for world streamer\n");
+        free(streamer->table);
+        free(streamer->cells);
+        free(streamer->active);
+        free(streamer->integrating);
+        free(streamer->candidates);
+        free(streamer->queue);
+        free(streamer);
+        close(fd);
+        return NULL;
+    }
+
+    ssize_t table_bytes = (ssize_t)(count * sizeof(WorldPackCell));
+    int valid = pread(fd, streamer->table, (size_t)table_bytes, sizeof(header)) == table_bytes;
+    for (uint32_t i = 0; i < count; i++) {
+        streamer->cells[i].active_index = NO_CELL;
+        streamer->cells[i].bytes = streamer->table[i].size + streamer->table[i].resource_bytes;
+    }
+
+    pthread_mutex_init(&streamer->mutex, NULL);
+    pthread_cond_init(&streamer->work_cond, NULL);
+    pthread_cond_init(&streamer->idle_cond, NULL);
+    if (!valid || pthread_create(&streamer->thread, NULL, loader_main, streamer) != 0) {
+        fprintf(stderr, "Error: Failed to start world streamer for %s\n", path);
+        pthread_mutex_destroy(&streamer->mutex);
+        pthread_cond_destroy(&streamer->work_cond);
+        pthread_cond_destroy(&streamer->idle_cond);
+        free(streamer->table);
+        free(streamer->cells);
+        free(streamer->active);
+        free(streamer->integrating);
+        free(streamer->candidates);
+        free(streamer->queue);
+        free(streamer);
+        close(fd);
+        return NULL;
+    }
+
+    fprintf(stderr, "Created world streamer for %s: %ux%u cells of %.1f units\n",
+            path, header.cells_x, header.cells_z, header.cell_size);
+    return streamer;
+}
+
+void world_stream_destroy(WorldStreamerHandle streamer) {
+    if (!streamer) {
+        return;
+    }
+
+    pthread_mutex_lock(&streamer->mutex);
+    streamer->shutdown = 1;
+    pthread_cond_broadcast(&streamer->work_cond);
+    pthread_mutex_unlock(&streamer->mutex);
+    pthread_join(streamer->thread, NULL);
+
+    WorldCellLoad* load = streamer->completed_head;
+    while (load) {
+        WorldCellLoad* next = load->next;
+        free_cell_load(streamer, load);
+        load = next;
+    }
+    for (uint32_t i = 0; i < streamer->cell_count; i++) {
+        StreamCell* cell = &streamer->cells[i];
+        for (uint32_t e = 0; e < cell->entity_count; e++) {
+            world_destroy_entity(streamer->world, cell->entity_ids[e]);
+        }
+        free(cell->entity_ids);
+        free_cell_load(streamer, cell->load);
+    }
+
+    pthread_mutex_destroy(&streamer->mutex);
+    pthread_cond_destroy(&streamer->work_cond);
+    pthread_cond_destroy(&streamer->idle_cond);
+    close(streamer->fd);
+    free(streamer->table);
+    free(streamer->cells);
+    free(streamer->active);
+    free(streamer->integrating);
+    free(streamer->candidates);
+    free(streamer->queue);
+    free(streamer);
+
+    fprintf(stderr, "Destroyed world streamer\n");
+}
+
+void world_stream_update(WorldStreamerHandle streamer, vec3_t camera_position) {
+    if (!streamer) {
+        return;
+    }
+
+    WorldStreamStats* stats = &streamer->stats;
+    stats->cells_requested = 0;
+    stats->cells_integrated = 0;
+    stats->cells_unloaded = 0;
+    stats->cells_cancelled = 0;
+    stats->cells_over_budget = 0;
+    stats->entities_created = 0;
+    stats->entities_destroyed = 0;
+    uint32_t ops = streamer->desc.max_entity_ops;
+
+    // 1. Take the loads the loader thread finished since the last update
+    pthread_mutex_lock(&streamer->mutex);
+    WorldCellLoad* load = streamer->completed_head;
+    streamer->completed_head = NULL;
+    streamer->completed_tail = NULL;
+    pthread_mutex_unlock(&streamer->mutex);
+
+    while (load) {
+        WorldCellLoad* next = load->next;
+        load->next = NULL;
+        uint32_t index = load->cell;
+        StreamCell* cell = &streamer->cells[index];
+        streamer->queued_count--;
+        uint32_t* entity_ids = NULL;
+        if (!load->failed && !cell->cancelled) {
+            entity_ids = (uint32_t*)malloc((streamer->table[index].entity_count + 1) * sizeof(uint32_t));
+            load->failed = entity_ids == NULL;
+        }
+        if (load->failed || cell->cancelled) {
+            if (load->failed) {
+                fprintf(stderr, "Error: Failed to load world cell %u\n", index);
+                stats->total_failures++;
+                cell->state = WORLD_CELL_FAILED;
+            } else {
+                stats->cells_cancelled++;
+                cell->state = WORLD_CELL_UNLOADED;
+            }
+            free_cell_load(streamer, load);
+            cell->cancelled = 0;
+            stats->bytes_committed -= cell->bytes;
+            remove_active(streamer, index);
+        } else {
+            cell->load = load;
+            cell->entity_ids = entity_ids;
+            cell->entity_count = 0;
+            cell->state = WORLD_CELL_INTEGRATING;
+            streamer->integrating[streamer->integrating_count++] = index;
+            stats->total_loads++;
+        }
+        load = next;
+    }
+
+    // 2. Refresh distances (the loader reads them to pick its next cell) and
+    //    start unloading cells that left the hysteresis band
+    pthread_mutex_lock(&streamer->mutex);
+    for (uint32_t i = 0; i < streamer->active_count; i++) {
+        uint32_t cell = streamer->active[i];
+        streamer->cells[cell].distance = cell_distance(streamer, cell, camera_position);
+    }
+    for (uint32_t i = streamer->active_count; i-- > 0;) {
+        uint32_t index = streamer->active[i];
+        StreamCell* cell = &streamer->cells[index];
+        if (cell->distance <= streamer->desc.unload_radius) {
+            continue;
+        }
+        if (cell->state == WORLD_CELL_QUEUED) {
+            if (cell->cancelled) {
+                continue;
+            }
+            uint32_t q = 0;
+            while (q < streamer->queue_count && streamer->queue[q] != index) q++;
+            if (q < streamer->queue_count) {
+                streamer->queue[q] = streamer->queue[--streamer->queue_count];
+                streamer->queued_count--;
+                stats->bytes_committed -= cell->bytes;
+                cell->state = WORLD_CELL_UNLOADED;
+                remove_active(streamer, index);
+                stats->cells_cancelled++;
+            } else {
+                cell->cancelled = 1;    // Being read; dropped when it completes
+            }
+        } else if (cell->state == WORLD_CELL_INTEGRATING || cell->state == WORLD_CELL_RESIDENT) {
+            if (cell->state == WORLD_CELL_INTEGRATING) {
+                remove_integrating(streamer, index);
+            }
+            cell->state = WORLD_CELL_UNLOADING;
+            streamer->bytes_unloading += cell->bytes;
+        }
+    }
+    if (streamer->queue_count == 0 && streamer->loading == NO_CELL) {
+        pthread_cond_broadcast(&streamer->idle_cond);
+    }
+    pthread_mutex_unlock(&streamer->mutex);
+
+    // 3. Remove unloading cells' entities first to make room in the World
+    for (uint32_t i = streamer->active_count; i-- > 0 && ops > 0;) {
+        uint32_t index = streamer->active[i];
+        StreamCell* cell = &streamer->cells[index];
+        if (cell->state != WORLD_CELL_UNLOADING) {
+            continue;
+        }
+        while (cell->entity_count > 0 && ops > 0) {
+            world_destroy_entity(streamer->world, cell->entity_ids[--cell->entity_count]);
+            stats->entities_destroyed++;
+            ops--;
+        }
+        if (cell->entity_count == 0) {
+            streamer->bytes_unloading -= cell->bytes;
+            finish_unload(streamer, index);
+            stats->cells_unloaded++;
+        }
+    }
+
+    // 4. Integrate loaded cells in completion order, a slice per update
+    while (streamer->integrating_count > 0 && ops > 0) {
+        uint32_t index = streamer->integrating[0];
+        StreamCell* cell = &streamer->cells[index];
+        WorldCellLoad* data = cell->load;
+        uint32_t total = streamer->table[index].entity_count;
+        while (cell->entity_count < total && ops > 0) {
+            const WorldPackEntity* record = &data->entities[cell->entity_count];
+            WorldEntity* entity = world_create_entity(streamer->world, data->strings + record->name_offset);
+            if (!entity) {
+                ops = 0;                // World is full; retry next update
+                break;
+            }
+            entity_set_position(entity, vec3(record->position[0], record->position[1], record->position[2]));
+            entity_set_orientation(entity, quat(record->orientation[0], record->orientation[1],
+                                                record->orientation[2], record->orientation[3]));
+            entity_set_bounds(entity, vec3(record->bounds_min[0], record->bounds_min[1], record->bounds_min[2]),
+                              vec3(record->bounds_max[0], record->bounds_max[1], record->bounds_max[2]));
+            if (record->resource >= 0) {
+                entity_set_model(entity, (MetalModelHandle)data->resources[record->resource]);
+            }
+            cell->entity_ids[cell->entity_count++] = entity->id;
+            stats->entities_created++;
+            ops--;
+        }
+        if (cell->entity_count < total) {
+            break;
+        }
+        free(data->blob);
+        data->blob = NULL;
+        data->entities = NULL;
+        data->strings = NULL;
+        cell->state = WORLD_CELL_RESIDENT;
+        remove_integrating(streamer, index);
+        stats->cells_integrated++;
+    }
+
+    // 5. Queue unloaded cells inside the load radius, nearest first
+    const WorldPackHeader* header = &streamer->header;
+    float radius = streamer->desc.load_radius;
+    int x0 = (int)floorf((camera_position.x - radius - header->origin_x) / header->cell_size);
+    int x1 = (int)floorf((camera_position.x + radius - header->origin_x) / header->cell_size);
+    int z0 = (int)floorf((camera_position.z - radius - header->origin_z) / header->cell_size);
+    int z1 = (int)floorf((camera_position.z + radius - header->origin_z) / header->cell_size);
+    if (x0 < 0) x0 = 0;
+    if (z0 < 0) z0 = 0;
+    if (x1 >= (int)header->cells_x) x1 = (int)header->cells_x - 1;
+    if (z1 >= (int)header->cells_z) z1 = (int)header->cells_z - 1;
+
+    uint32_t candidate_count = 0;
+    for (int z = z0; z <= z1; z++) {
+        for (int x = x0; x <= x1; x++) {
+            uint32_t index = (uint32_t)z * header->cells_x + (uint32_t)x;
+            StreamCell* cell = &streamer->cells[index];
+            if (cell->state != WORLD_CELL_UNLOADED) {
+                continue;
+            }
+            float distance = cell_distance(streamer, index, camera_position);
+            if (distance > radius) {
+                continue;
+            }
+            cell->distance = distance;
+            if (streamer->table[index].size == 0) {
+                cell->state = WORLD_CELL_RESIDENT;   // Empty cell: nothing to read
+                add_active(streamer, index);
+                continue;
+            }
+            streamer->candidates[candidate_count].distance = distance;
+            streamer->candidates[candidate_count].cell = index;
+            candidate_count++;
+        }
+    }
+    qsort(streamer->candidates, candidate_count, sizeof(StreamCandidate), compare_candidates);
+
+    pthread_mutex_lock(&streamer->mutex);
+    uint32_t queued = 0;
+    for (uint32_t i = 0; i < candidate_count; i++) {
+        if (streamer->queued_count >= streamer->desc.max_pending_loads) {
+            break;
+        }
+        uint32_t index = streamer->candidates[i].cell;
+        StreamCell* cell = &streamer->cells[index];
+
+        // Over budget: evict the farthest resident cell in the hysteresis band
+        while (stats->bytes_committed - streamer->bytes_unloading + cell->bytes > streamer->desc.byte_budget) {
+            uint32_t victim = NO_CELL;
+            for (uint32_t a = 0; a < streamer->active_count; a++) {
+                uint32_t other = streamer->active[a];
+                const StreamCell* c = &streamer->cells[other];
+                if (c->state == WORLD_CELL_RESIDENT && c->distance > radius &&
+                    (victim == NO_CELL || c->distance > streamer->cells[victim].distance)) {
+                    victim = other;
+                }
+            }
+            if (victim == NO_CELL) {
+                break;
+            }
+            streamer->cells[victim].state = WORLD_CELL_UNLOADING;
+            streamer->bytes_unloading += streamer->cells[victim].bytes;
+        }
+        if (stats->bytes_committed + cell->bytes > streamer->desc.byte_budget) {
+            stats->cells_over_budget = candidate_count - i;
+            break;
+        }
+
+        cell->state = WORLD_CELL_QUEUED;
+        add_active(streamer, index);
+        stats->bytes_committed += cell->bytes;
+        streamer->queue[streamer->queue_count++] = index;
+        streamer->queued_count++;
+        queued++;
+    }
+    if (queued > 0) {
+        pthread_cond_signal(&streamer->work_cond);
+    }
+    pthread_mutex_unlock(&streamer->mutex);
+    stats->cells_requested = queued;
+
+    stats->cells_resident = 0;
+    for (uint32_t i = 0; i < streamer->active_count; i++) {
+        if (streamer->cells[streamer->active[i]].state == WORLD_CELL_RESIDENT) {
+            stats->cells_resident++;
+        }
+    }
+    stats->cells_pending = streamer->queued_count + streamer->integrating_count;
+}
+
+void world_stream_wait_idle(WorldStreamerHandle streamer) {
+    if (!streamer) {
+        return;
+    }
+    pthread_mutex_lock(&streamer->mutex);
+    while (streamer->queue_count > 0 || streamer->loading != NO_CELL) {
+        pthread_cond_wait(&streamer->idle_cond, &streamer->mutex);
+    }
+    pthread_mutex_unlock(&streamer->mutex);
+}
+
+uint32_t world_stream_get_cells_x(WorldStreamerHandle streamer) {
+    return streamer ? streamer->header.cells_x : 0;
+}
+
+uint32_t world_stream_get_cells_z(WorldStreamerHandle streamer) {
+    return streamer ? streamer->header.cells_z : 0;
+}
+
+WorldCellState world_stream_get_cell_state(WorldStreamerHandle streamer, uint32_t cell_x, uint32_t cell_z) {
+    if (!streamer || cell_x >= streamer->header.cells_x || cell_z >= streamer->header.cells_z) {
+        return WORLD_CELL_UNLOADED;
+    }
+    return streamer->cells[cell_z * streamer->header.cells_x + cell_x].state;
+}
+
+const uint32_t* world_stream_get_cell_entities(WorldStreamerHandle streamer, uint32_t cell_x, uint32_t cell_z,
+                                               uint32_t* out_count) {
+    if (out_count) *out_count = 0;
+    if (!streamer || cell_x >= streamer->header.cells_x || cell_z >= streamer->header.cells_z) {
+        return NULL;
+    }
+    const StreamCell* cell = &streamer->cells[cell_z * streamer->header.cells_x + cell_x];
+    if (out_count) *out_count = cell->entity_count;
+    return cell->entity_ids;
+}
+
+WorldStreamStats world_stream_get_stats(WorldStreamerHandle streamer) {
+    WorldStreamStats stats;
+    if (!streamer) {
+        memset(&stats, 0, sizeof(stats));
+        return stats;
+    }
+    return streamer->stats;
+}
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+void world_stream_print(const char* name, WorldStreamerHandle streamer) {
+    if (!streamer) {
+        printf("%s: NULL\n", name);
+        return;
+    }
+
+    const WorldStreamStats* stats = &streamer->stats;
+    printf("%s: %ux%u cells, %u resident, %u pending, %.1f / %.1f MB committed\n", name,
+           streamer->header.cells_x, streamer->header.cells_z, stats->cells_resident, stats->cells_pending,
+           (double)stats->bytes_committed / (1024.0 * 1024.0),
+           (double)streamer->desc.byte_budget / (1024.0 * 1024.0));
+    printf("  Last update: %u requested, %u integrated, %u unloaded, %u cancelled, %u over budget\n",
+           stats->cells_requested, stats->cells_integrated, stats->cells_unloaded,
+           stats->cells_cancelled, stats->cells_over_budget);
+    printf("  Entities: %u created, %u destroyed; %u loads, %u failures in total\n",
+           stats->entities_created, stats->entities_destroyed, stats->total_loads, stats->total_failures);
+}
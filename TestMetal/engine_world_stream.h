@@ -0,0 +1,193 @@
+#ifndef ENGINE_WORLD_STREAM_H
+#define ENGINE_WORLD_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "engine_math.h"
+#include "engine_world.h"
+#include <stdint.h>
+
+// ============================================================================
+// WORLD STREAMING CONFIGURATION
+// ============================================================================
+
+#define WORLD_PACK_MAGIC 0x4B504C57u            // "WLPK"
+#define WORLD_PACK_VERSION 1
+
+// ============================================================================
+// WORLD PACK FILE FORMAT
+// ============================================================================
+
+// A world pack partitions the XZ plane into a grid of square cells. The
+// file is this header, one WorldPackCell per cell (row-major, x fastest)
+// and the cell blobs. A blob is a WorldPackCellHeader followed by its
+// entity records, resource records and a string table.
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float origin_x;             // World position of cell (0, 0)'s min corner
+    float origin_z;
+    float cell_size;
+    uint32_t cells_x;
+    uint32_t cells_z;
+    uint32_t reserved;
+} WorldPackHeader;
+
+typedef struct {
+    uint64_t offset;            // Blob position in the file (0 = empty cell)
+    uint32_t size;              // Blob bytes
+    uint32_t entity_count;
+    uint64_t resource_bytes;    // Declared size of the cell's resources
+} WorldPackCell;
+
+typedef struct {
+    uint32_t entity_count;
+    uint32_t resource_count;
+    uint32_t string_bytes;
+    uint32_t reserved;
+} WorldPackCellHeader;
+
+typedef struct {
+    float position[3];
+    float orientation[4];       // Quaternion (x, y, z, w)
+    float bounds_min[3];        // Local-space bounds
+    float bounds_max[3];
+    uint32_t name_offset;       // Into the string table
+    int32_t resource;           // Index into the cell's resources, -1 for none
+    uint32_t reserved;          // Pads the record to 64 bytes
+} WorldPackEntity;
+
+typedef struct {
+    uint32_t name_offset;
+    uint32_t reserved;
+    uint64_t bytes;
+} WorldPackResource;
+
+// Pack builder input for one cell
+typedef struct {
+    const char* name;
+    vec3_t position;
+    quat_t orientation;
+    vec3_t bounds_min;
+    vec3_t bounds_max;
+    int32_t resource;
+} WorldCellEntityDesc;
+
+typedef struct {
+    const char* name;           // Passed to the resource load callback
+    uint64_t bytes;             // Counted against the streaming budget
+} WorldCellResourceDesc;
+
+typedef struct {
+    const WorldCellEntityDesc* entities;
+    uint32_t entity_count;
+    const WorldCellResourceDesc* resources;
+    uint32_t resource_count;
+} WorldCellDesc;
+
+// ============================================================================
+// WORLD STREAMING TYPES
+// ============================================================================
+
+// Cell lifecycle, owned by the thread calling world_stream_update
+typedef enum {
+    WORLD_CELL_UNLOADED = 0,
+    WORLD_CELL_QUEUED,          // Waiting for or being read by the loader thread
+    WORLD_CELL_INTEGRATING,     // Loaded; entities are being added to the World
+    WORLD_CELL_RESIDENT,
+    WORLD_CELL_UNLOADING,       // Entities are being removed from the World
+    WORLD_CELL_FAILED           // Unreadable blob; never retried
+} WorldCellState;
+
+// Resource callbacks. load runs on the loader thread and returns the
+// resource (assigned as the entity's model), release runs in
+// world_stream_update when the cell unloads.
+typedef void* (*WorldStreamLoadFunc)(void* user_data, const char* name, uint64_t bytes);
+typedef void (*WorldStreamReleaseFunc)(void* user_data, void* resource);
+
+typedef struct {
+    float load_radius;              // Cells closer than this stream in
+    float unload_radius;            // Cells farther than this stream out (> load_radius)
+    uint64_t byte_budget;           // Blob + resource bytes resident or in flight
+    uint32_t max_entity_ops;        // Entities created/destroyed per update
+    uint32_t max_pending_loads;     // Cells queued or loading at once
+    WorldStreamLoadFunc load_resource;
+    WorldStreamReleaseFunc release_resource;
+    void* user_data;
+} WorldStreamDesc;
+
+// Statistics; counters are per update, totals accumulate
+typedef struct {
+    uint32_t cells_resident;
+    uint32_t cells_pending;         // Queued, loading or integrating
+    uint64_t bytes_committed;       // Resident plus in flight
+    uint32_t cells_requested;
+    uint32_t cells_integrated;
+    uint32_t cells_unloaded;
+    uint32_t cells_cancelled;
+    uint32_t cells_over_budget;     // In range but deferred by the byte budget
+    uint32_t entities_created;
+    uint32_t entities_destroyed;
+    uint32_t total_loads;
+    uint32_t total_failures;
+} WorldStreamStats;
+
+// Opaque streamer handle (owns the loader thread)
+typedef struct WorldStreamer* WorldStreamerHandle;
+
+// ============================================================================
+// WORLD PACK FUNCTIONS
+// ============================================================================
+
+// Write a pack of cells_x * cells_z cells (row-major). Returns 1 on success.
+int world_pack_write(const char* path, float origin_x, float origin_z, float cell_size,
+                     uint32_t cells_x, uint32_t cells_z, const WorldCellDesc* cells);
+
+// ============================================================================
+// WORLD STREAMING FUNCTIONS
+// ============================================================================
+
+// Default: 2-cell load radius with a half-cell hysteresis band, 256 MB,
+// 256 entity operations per update, 8 pending loads, no resource callbacks
+WorldStreamDesc world_stream_desc_default(float cell_size);
+
+// Open a pack and start its loader thread; streamed entities go into `world`
+WorldStreamerHandle world_stream_create(const char* path, World* world, const WorldStreamDesc* desc);
+
+// Stop the loader thread, remove every streamed entity and free the streamer
+void world_stream_destroy(WorldStreamerHandle streamer);
+
+// Sync point, once per frame: integrate finished loads into the World,
+// unload cells beyond the unload radius and queue cells within the load
+// radius, nearest first, within the byte budget
+void world_stream_update(WorldStreamerHandle streamer, vec3_t camera_position);
+
+// Block until the loader thread has nothing queued (loading screens, tests)
+void world_stream_wait_idle(WorldStreamerHandle streamer);
+
+// Cell grid queries
+uint32_t world_stream_get_cells_x(WorldStreamerHandle streamer);
+uint32_t world_stream_get_cells_z(WorldStreamerHandle streamer);
+WorldCellState world_stream_get_cell_state(WorldStreamerHandle streamer, uint32_t cell_x, uint32_t cell_z);
+
+// Entity ids a cell has added to the World so far
+const uint32_t* world_stream_get_cell_entities(WorldStreamerHandle streamer, uint32_t cell_x, uint32_t cell_z,
+                                               uint32_t* out_count);
+
+// Statistics of the last update
+WorldStreamStats world_stream_get_stats(WorldStreamerHandle streamer);
+
+// ============================================================================
+// DEBUG/PRINTING FUNCTIONS
+// ============================================================================
+
+// Print streamer statistics
+void world_stream_print(const char* name, WorldStreamerHandle streamer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ENGINE_WORLD_STREAM_H
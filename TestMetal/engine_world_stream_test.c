@@ -0,0 +1,435 @@
+#include "engine_world_stream.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// ============================================================================
+// TEST UTILITIES
+// ============================================================================
+
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(condition, message) \
+    do { \
+        tests_run++; \
+        if (condition) { \
+            tests_passed++; \
+            printf("✓ %s\n", message); \
+        } else { \
+            tests_failed++; \
+            printf("✗ %s\n", message); \
+        } \
+    } while(0)
+
+#define TEST_ASSERT_EQUAL(expected, actual, message) \
+    TEST_ASSERT((expected) == (actual), message)
+
+#define TEST_ASSERT_NOT_NULL(ptr, message) \
+    TEST_ASSERT((ptr) != NULL, message)
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static const char* PACK_PATH = "/tmp/engine_world_stream_test.pack";
+static const char* LARGE_PACK_PATH = "/tmp/engine_world_stream_test_large.pack";
+
+#define GRID 16
+#define CELL_SIZE 50.0f
+#define ORIGIN -400.0f
+#define RESOURCE_BYTES (1024u * 1024u)
+
+// Resource callbacks: a heap-allocated cell index, so tests can see which
+// cell a resource came from and in which order cells were read
+typedef struct {
+    uint32_t load_order[GRID * GRID * 2];
+    uint32_t load_count;
+    int live;
+    int slow;
+} ResourceLog;
+
+static ResourceLog resource_log;
+
+static void* load_resource(void* user_data, const char* name, uint64_t bytes) {
+    ResourceLog* log = (ResourceLog*)user_data;
+    unsigned x = 0, z = 0, k = 0;
+    sscanf(name, "res_%u_%u_%u", &x, &z, &k);
+    if (k == 0 && log->load_count < GRID * GRID * 2) {
+        log->load_order[log->load_count++] = z * GRID + x;
+    }
+    if (log->slow) {
+        usleep(2000);
+    }
+    uint32_t* resource = (uint32_t*)malloc(sizeof(uint32_t));
+    *resource = z * GRID + x;
+    __sync_fetch_and_add(&log->live, 1);
+    (void)bytes;
+    return resource;
+}
+
+static void release_resource(void* user_data, void* resource) {
+    ResourceLog* log = (ResourceLog*)user_data;
+    __sync_fetch_and_sub(&log->live, 1);
+    free(resource);
+}
+
+static uint32_t cell_entity_count(uint32_t x, uint32_t z) {
+    return (x == 0 && z == 0) ? 0 : (x + z) % 5 + 3;
+}
+
+static float cell_distance(uint32_t cell, vec3_t camera) {
+    float min_x = ORIGIN + (float)(cell % GRID) * CELL_SIZE;
+    float min_z = ORIGIN + (float)(cell / GRID) * CELL_SIZE;
+    float dx = fmaxf(fmaxf(min_x - camera.x, camera.x - min_x - CELL_SIZE), 0.0f);
+    float dz = fmaxf(fmaxf(min_z - camera.z, camera.z - min_z - CELL_SIZE), 0.0f);
+    return sqrtf(dx * dx + dz * dz);
+}
+
+static vec3_t cell_center(uint32_t x, uint32_t z) {
+    return vec3(ORIGIN + ((float)x + 0.5f) * CELL_SIZE, 0.0f, ORIGIN + ((float)z + 0.5f) * CELL_SIZE);
+}
+
+static int write_test_pack(void) {
+    static WorldCellEntityDesc entities[GRID * GRID][8];
+    static WorldCellResourceDesc resources[GRID * GRID][2];
+    static char names[GRID * GRID][10][32];
+    WorldCellDesc cells[GRID * GRID];
+
+    for (uint32_t z = 0; z < GRID; z++) {
+        for (uint32_t x = 0; x < GRID; x++) {
+            uint32_t c = z * GRID + x;
+            uint32_t count = cell_entity_count(x, z);
+            for (uint32_t k = 0; k < 2; k++) {
+                snprintf(names[c][8 + k], 32, "res_%u_%u_%u", x, z, k);
+                resources[c][k].name = names[c][8 + k];
+                resources[c][k].bytes = RESOURCE_BYTES;
+            }
+            for (uint32_t i = 0; i < count; i++) {
+                snprintf(names[c][i], 32, "cell_%u_%u_%u", x, z, i);
+                WorldCellEntityDesc* e = &entities[c][i];
+                e->name = names[c][i];
+                e->position = vec3_add(cell_center(x, z), vec3((float)i, 1.0f, -(float)i));
+                e->orientation = quat_identity();
+                e->bounds_min = vec3(-1.0f, -1.0f, -1.0f);
+                e->bounds_max = vec3(1.0f, 2.0f, 1.0f);
+                e->resource = (int32_t)(i % 3) - 1;
+            }
+            cells[c].entities = entities[c];
+            cells[c].entity_count = count;
+            cells[c].resources = count ? resources[c] : NULL;
+            cells[c].resource_count = count ? 2 : 0;
+        }
+    }
+    return world_pack_write(PACK_PATH, ORIGIN, ORIGIN, CELL_SIZE, GRID, GRID, cells);
+}
+
+static WorldStreamDesc test_desc(void) {
+    WorldStreamDesc desc = world_stream_desc_default(CELL_SIZE);
+    desc.load_resource = load_resource;
+    desc.release_resource = release_resource;
+    desc.user_data = &resource_log;
+    return desc;
+}
+
+// Update until nothing is queued, loading or integrating
+static uint32_t settle(WorldStreamerHandle streamer, vec3_t camera) {
+    uint32_t updates = 0;
+    for (; updates < 1000; updates++) {
+        world_stream_update(streamer, camera);
+        WorldStreamStats stats = world_stream_get_stats(streamer);
+        if (stats.cells_pending == 0 && stats.cells_requested == 0 && stats.cells_unloaded == 0 &&
+            stats.entities_destroyed == 0) {
+            break;
+        }
+        world_stream_wait_idle(streamer);
+    }
+    return updates;
+}
+
+// Sum of entities the streamer reports, which must equal the World's count
+static uint32_t streamed_entity_count(WorldStreamerHandle streamer) {
+    uint32_t total = 0;
+    for (uint32_t z = 0; z < GRID; z++) {
+        for (uint32_t x = 0; x < GRID; x++) {
+            uint32_t count = 0;
+            world_stream_get_cell_entities(streamer, x, z, &count);
+            total += count;
+        }
+    }
+    return total;
+}
+
+// ============================================================================
+// WORLD STREAMING TESTS
+// ============================================================================
+
+static void test_pack(void) {
+    printf("\n--- Pack Tests ---\n");
+
+    TEST_ASSERT(write_test_pack(), "World pack should be written");
+
+    World* world = world_create(1024);
+    WorldStreamDesc desc = test_desc();
+    WorldStreamerHandle streamer = world_stream_create(PACK_PATH, world, &desc);
+    TEST_ASSERT_NOT_NULL(streamer, "World pack should open");
+    TEST_ASSERT(world_stream_get_cells_x(streamer) == GRID && world_stream_get_cells_z(streamer) == GRID,
+                "Streamer should report the pack's cell grid");
+    TEST_ASSERT_EQUAL(WORLD_CELL_UNLOADED, world_stream_get_cell_state(streamer, 3, 4),
+                      "Cells should start unloaded");
+    world_stream_destroy(streamer);
+
+    TEST_ASSERT(world_stream_create("/tmp/engine_world_stream_missing.pack", world, &desc) == NULL,
+                "Missing packs should fail to open");
+    desc.unload_radius = desc.load_radius;
+    TEST_ASSERT(world_stream_create(PACK_PATH, world, &desc) == NULL,
+                "Streaming without a hysteresis band should be rejected");
+
+    world_destroy(world);
+}
+
+static void test_stream_in_out(void) {
+    printf("\n--- Streaming Tests ---\n");
+
+    memset(&resource_log, 0, sizeof(resource_log));
+    World* world = world_create(1024);
+    WorldStreamDesc desc = test_desc();
+    WorldStreamerHandle streamer = world_stream_create(PACK_PATH, world, &desc);
+    if (!streamer) return;
+
+    vec3_t camera = cell_center(8, 8);
+    settle(streamer, camera);
+    world_stream_print("Streamer (settled)", streamer);
+
+    int states_ok = 1;
+    uint32_t expected_entities = 0, expected_resident = 0;
+    for (uint32_t c = 0; c < GRID * GRID; c++) {
+        int in_range = cell_distance(c, camera) <= desc.load_radius;
+        WorldCellState state = world_stream_get_cell_state(streamer, c % GRID, c / GRID);
+        if (in_range != (state == WORLD_CELL_RESIDENT)) states_ok = 0;
+        if (in_range) {
+            expected_entities += cell_entity_count(c % GRID, c / GRID);
+            expected_resident++;
+        }
+    }
+    TEST_ASSERT(states_ok, "Exactly the cells inside the load radius should be resident");
+    TEST_ASSERT_EQUAL(expected_entities, world_get_entity_count(world), "World should hold the resident cells' entities");
+    TEST_ASSERT_EQUAL(expected_entities, streamed_entity_count(streamer), "Cell entity lists should match the World");
+    TEST_ASSERT_EQUAL((int)(expected_resident * 2), resource_log.live, "Each resident cell should hold its resources");
+
+    WorldEntity* entity = world_get_entity_by_name(world, "cell_8_9_2");
+    vec3_t expected = vec3_add(cell_center(8, 9), vec3(2.0f, 1.0f, -2.0f));
+    TEST_ASSERT(entity && vec3_distance(entity->position, expected) < 1e-4f && entity->bounds_max.y == 2.0f,
+                "Streamed entities should carry their serialized transform and bounds");
+    TEST_ASSERT(entity && entity->metal_model && *(uint32_t*)entity->metal_model == 9 * GRID + 8,
+                "Streamed entities should reference their cell's resources");
+
+    int ordered = resource_log.load_count == expected_resident;
+    for (uint32_t i = 1; i < resource_log.load_count; i++) {
+        if (cell_distance(resource_log.load_order[i], camera) < cell_distance(resource_log.load_order[i - 1], camera)) {
+            ordered = 0;
+        }
+    }
+    TEST_ASSERT(ordered && resource_log.load_order[0] == 8 * GRID + 8, "Cells should load nearest first");
+
+    // Inside the hysteresis band nothing unloads
+    vec3_t nudged = vec3_add(camera, vec3(CELL_SIZE * 0.6f, 0.0f, 0.0f));
+    int in_band = 0;
+    for (uint32_t c = 0; c < GRID * GRID; c++) {
+        float d = cell_distance(c, nudged);
+        if (world_stream_get_cell_state(streamer, c % GRID, c / GRID) == WORLD_CELL_RESIDENT &&
+            d > desc.load_radius && d <= desc.unload_radius) in_band++;
+    }
+    world_stream_update(streamer, nudged);
+    WorldStreamStats stats = world_stream_get_stats(streamer);
+    TEST_ASSERT(in_band > 0 && stats.cells_unloaded == 0 && stats.entities_destroyed == 0,
+                "Cells in the hysteresis band should stay resident");
+    settle(streamer, nudged);
+
+    // Far away everything unloads and the new neighbourhood loads
+    vec3_t far_camera = cell_center(2, 2);
+    settle(streamer, far_camera);
+    TEST_ASSERT_EQUAL(WORLD_CELL_UNLOADED, world_stream_get_cell_state(streamer, 8, 8), "Left cells should unload");
+    TEST_ASSERT_EQUAL(WORLD_CELL_RESIDENT, world_stream_get_cell_state(streamer, 2, 2), "New cells should load");
+    TEST_ASSERT_EQUAL(world_get_entity_count(world), streamed_entity_count(streamer),
+                      "World should hold only the resident cells' entities");
+    TEST_ASSERT(world_get_entity_by_name(world, "cell_8_9_2") == NULL, "Unloaded entities should leave the World");
+
+    world_stream_destroy(streamer);
+    TEST_ASSERT_EQUAL(0u, world_get_entity_count(world), "Destroying the streamer should remove its entities");
+    TEST_ASSERT_EQUAL(0, resource_log.live, "Destroying the streamer should release its resources");
+    world_destroy(world);
+}
+
+static void test_budgets(void) {
+    printf("\n--- Budget Tests ---\n");
+
+    memset(&resource_log, 0, sizeof(resource_log));
+    World* world = world_create(1024);
+    WorldStreamDesc desc = test_desc();
+    desc.max_entity_ops = 4;
+    WorldStreamerHandle streamer = world_stream_create(PACK_PATH, world, &desc);
+    if (!streamer) return;
+
+    vec3_t camera = cell_center(5, 5);
+    uint32_t max_created = 0, updates = 0;
+    for (; updates < 1000; updates++) {
+        world_stream_update(streamer, camera);
+        WorldStreamStats stats = world_stream_get_stats(streamer);
+        if (stats.entities_created > max_created) max_created = stats.entities_created;
+        if (stats.cells_pending == 0 && stats.cells_requested == 0) break;
+        world_stream_wait_idle(streamer);
+    }
+    TEST_ASSERT(max_created <= 4, "Integration should respect the per-update entity budget");
+    TEST_ASSERT(updates > 20, "Integration should be spread over many updates");
+    world_stream_destroy(streamer);
+
+    // Byte budget: five cells' worth
+    desc = test_desc();
+    desc.byte_budget = 5ull * (2 * RESOURCE_BYTES + 1024);
+    streamer = world_stream_create(PACK_PATH, world, &desc);
+    uint32_t over_budget = 0;
+    for (updates = 0; updates < 50; updates++) {
+        world_stream_update(streamer, camera);
+        over_budget += world_stream_get_stats(streamer).cells_over_budget;
+        world_stream_wait_idle(streamer);
+    }
+    WorldStreamStats stats = world_stream_get_stats(streamer);
+    world_stream_print("Streamer (5-cell budget)", streamer);
+    TEST_ASSERT(stats.bytes_committed <= desc.byte_budget, "Committed bytes should stay within the budget");
+    TEST_ASSERT(stats.cells_resident == 5 && over_budget > 0, "The budget should defer the remaining cells");
+    int nearest = 1;
+    for (uint32_t c = 0; c < GRID * GRID; c++) {
+        if (world_stream_get_cell_state(streamer, c % GRID, c / GRID) == WORLD_CELL_RESIDENT &&
+            cell_distance(c, camera) > CELL_SIZE) nearest = 0;
+    }
+    TEST_ASSERT(nearest && world_stream_get_cell_state(streamer, 5, 5) == WORLD_CELL_RESIDENT,
+                "The budget should go to the nearest cells");
+
+    // Moving on evicts the old cells to make room
+    camera = cell_center(5, 9);
+    settle(streamer, camera);
+    stats = world_stream_get_stats(streamer);
+    TEST_ASSERT(world_stream_get_cell_state(streamer, 5, 9) == WORLD_CELL_RESIDENT &&
+                world_stream_get_cell_state(streamer, 5, 5) == WORLD_CELL_UNLOADED &&
+                stats.bytes_committed <= desc.byte_budget, "Budgeted cells should follow the camera");
+    world_stream_destroy(streamer);
+
+    // Cancellation: leave before the slow loader finishes
+    memset(&resource_log, 0, sizeof(resource_log));
+    resource_log.slow = 1;
+    desc = test_desc();
+    streamer = world_stream_create(PACK_PATH, world, &desc);
+    world_stream_update(streamer, cell_center(12, 12));
+    world_stream_update(streamer, cell_center(1, 12));
+    stats = world_stream_get_stats(streamer);
+    TEST_ASSERT(stats.cells_cancelled > 0, "Queued cells should be cancelled when the camera leaves");
+    settle(streamer, cell_center(1, 12));
+    TEST_ASSERT_EQUAL(WORLD_CELL_UNLOADED, world_stream_get_cell_state(streamer, 12, 12),
+                      "Cancelled cells should end unloaded");
+    TEST_ASSERT_EQUAL(world_get_entity_count(world), streamed_entity_count(streamer),
+                      "Cancelled loads should not add entities");
+    world_stream_destroy(streamer);
+    TEST_ASSERT_EQUAL(0, resource_log.live, "Cancelled loads should release their resources");
+
+    world_destroy(world);
+}
+
+static void test_performance(void) {
+    printf("\n--- Performance Tests ---\n");
+
+    // 64 x 64 cells of 32 units with 24 entities each
+    const uint32_t grid = 64, per_cell = 24;
+    const float cell_size = 32.0f;
+    WorldCellDesc* cells = (WorldCellDesc*)calloc(grid * grid, sizeof(WorldCellDesc));
+    WorldCellEntityDesc* entities = (WorldCellEntityDesc*)calloc(per_cell, sizeof(WorldCellEntityDesc));
+    WorldCellResourceDesc resource = {"shared_mesh", 64 * 1024};
+    for (uint32_t i = 0; i < per_cell; i++) {
+        entities[i].name = "prop";
+        entities[i].position = vec3((float)i, 0.0f, 0.0f);
+        entities[i].orientation = quat_identity();
+        entities[i].bounds_min = vec3(-0.5f, -0.5f, -0.5f);
+        entities[i].bounds_max = vec3(0.5f, 0.5f, 0.5f);
+        entities[i].resource = 0;
+    }
+    for (uint32_t c = 0; c < grid * grid; c++) {
+        cells[c].entities = entities;
+        cells[c].entity_count = per_cell;
+        cells[c].resources = &resource;
+        cells[c].resource_count = 1;
+    }
+    int written = world_pack_write(LARGE_PACK_PATH, 0.0f, 0.0f, cell_size, grid, grid, cells);
+    free(cells);
+    free(entities);
+    TEST_ASSERT(written, "Large world pack should be written");
+
+    World* world = world_create(4096);
+    WorldStreamDesc desc = world_stream_desc_default(cell_size);
+    desc.load_radius = cell_size * 3.0f;
+    desc.unload_radius = cell_size * 3.5f;
+    desc.max_entity_ops = 128;
+    WorldStreamerHandle streamer = world_stream_create(LARGE_PACK_PATH, world, &desc);
+    if (!streamer) {
+        world_destroy(world);
+        return;
+    }
+
+    // Fly diagonally across the map at 4 units per frame
+    const uint32_t frames = 400;
+    double total_ms = 0.0, max_ms = 0.0;
+    uint32_t peak_entities = 0, created = 0, destroyed = 0;
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        vec3_t camera = vec3(100.0f + 4.0f * frame, 10.0f, 100.0f + 3.0f * frame);
+        double start = now_ms();
+        world_stream_update(streamer, camera);
+        double elapsed = now_ms() - start;
+        total_ms += elapsed;
+        if (elapsed > max_ms) max_ms = elapsed;
+        WorldStreamStats stats = world_stream_get_stats(streamer);
+        created += stats.entities_created;
+        destroyed += stats.entities_destroyed;
+        if (world_get_entity_count(world) > peak_entities) peak_entities = world_get_entity_count(world);
+        usleep(2000);   // Rest of the frame; the loader thread runs meanwhile
+    }
+    WorldStreamStats stats = world_stream_get_stats(streamer);
+    world_stream_print("Streamer (flythrough)", streamer);
+    printf("  Update: %.3f ms/frame average, %.3f ms worst\n", total_ms / frames, max_ms);
+    printf("  %u loads, %u entities created, %u destroyed, peak %u resident (world capacity 4096)\n",
+           stats.total_loads, created, destroyed, peak_entities);
+
+    TEST_ASSERT(stats.total_loads > 100 && stats.total_failures == 0, "Flythrough should stream many cells");
+    TEST_ASSERT(peak_entities < 4096, "A world smaller than the map should suffice");
+
+    world_stream_destroy(streamer);
+    world_destroy(world);
+    unlink(LARGE_PACK_PATH);
+}
+
+// ============================================================================
+// MAIN TEST RUNNER
+// ============================================================================
+
+int main(void) {
+    printf("Starting World Streaming Unit Tests\n");
+    printf("===================================\n");
+
+    test_pack();
+    test_stream_in_out();
+    test_budgets();
+    test_performance();
+
+    unlink(PACK_PATH);
+
+    printf("\n===================================\n");
+    printf("Test Results:\n");
+    printf("Total tests: %d\n", tests_run);
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return tests_failed > 0 ? 1 : 0;
+}